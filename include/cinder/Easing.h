@@ -668,4 +668,27 @@ struct EaseInOutAtan {
 	float mA, mInv2M;
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch evaluation
+
+//! Evaluates \a ease at each of the \a count values of \a t, writing the results to \a result, which may be \a t itself.
+//! \a ease may be any of the functors above or a plain function, and is called directly rather than through a std::function.
+//! findEaseBatchFn() in Tween.h provides SIMD versions of the polynomial and circular curves.
+template<typename EaseT>
+inline void easeBatch( EaseT ease, const float *t, float *result, size_t count )
+{
+	for( size_t i = 0; i < count; ++i )
+		result[i] = ease( t[i] );
+}
+
+//! Evaluates a fixed easing curve over arrays, with the arguments of easeBatch().
+typedef void (*EaseBatchFn)( const float *t, float *result, size_t count );
+
+//! Returns an EaseBatchFn for the stateless functor \a EaseT, such as EaseInOutQuad.
+template<typename EaseT>
+EaseBatchFn getEaseBatchFn()
+{
+	return []( const float *t, float *result, size_t count ) { easeBatch( EaseT(), t, result, count ); };
+}
+
 } // namespace cinder
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include "cinder/Signals.h"
 
 #include <list>
+#include <set>
 #include <vector>
 #include <atomic>
 #include <mutex>
@@ -65,11 +66,25 @@ class WatchEvent {
 //! the resulting signals::Connection with with some sort of scope controlling to ensure that your callbacks are disconnected
 //! when your object is destroyed. \see signals::ScopedConnection, signals::ConnectionList.
 //!
+//! On Linux, changes are detected with inotify watches on the directories of watched files, so the cost is proportional to the
+//! number of watched directories, and modifications arriving in a burst are coalesced into a single WatchEvent. Elsewhere, or
+//! when inotify is unavailable, every watched file's write time is polled instead. \see setBackend().
+//!
 //! \note any argument that takes an `fs::path` considers that operation to be global, that is any and all watches in place that
 //! include that file with be affected (examples are unwatch() and disable()). If you want to disable a single instance of a watch
 //! on a specific file, you can use the returned Connection's disable() or disconnect() methods.
 class CI_API FileWatcher : private Noncopyable {
   public:
+	//! Methods of detecting file modifications
+	enum Backend {
+		//! Uses BACKEND_NATIVE where available, BACKEND_POLLING otherwise (default)
+		BACKEND_AUTO,
+		//! Compares the write time of every watched file each thread update interval
+		BACKEND_POLLING,
+		//! Waits for change notifications on the watched files' directories. Currently inotify, on Linux.
+		BACKEND_NATIVE
+	};
+
 	FileWatcher();
 	~FileWatcher();
 
@@ -129,18 +144,42 @@ class CI_API FileWatcher : private Noncopyable {
 	//! Returns the update time interval in seconds for the polling thread. \default is 0.02 seconds.
 	double		getThreadUpdateInterval() const				{ return mThreadUpdateInterval; }
 
+	//! Sets the method of detecting modifications, restarting the watching thread if necessary. \default is BACKEND_AUTO.
+	void		setBackend( Backend backend );
+	//! Returns the requested method of detecting modifications.
+	Backend		getBackend() const							{ return mBackend; }
+	//! Returns the method of detecting modifications in use, which is BACKEND_POLLING if BACKEND_NATIVE is unsupported or failed.
+	Backend		getActiveBackend() const					{ return mActiveBackend; }
+
+	//! Sets how long in seconds the native backend waits for a burst of modifications to end before reporting them together. \default is 0.05 seconds.
+	void		setDebounceInterval( double seconds )		{ mDebounceInterval = seconds; }
+	//! Returns how long in seconds the native backend waits for a burst of modifications to end before reporting them together.
+	double		getDebounceInterval() const					{ return mDebounceInterval; }
+
   private:
+	//! Receives directory change notifications from the operating system
+	class Notifier;
 
 	void	configureWatchPolling();
 	void	connectAppUpdate();
 	void	stopWatchPolling();
 	void	threadEntry();
+	void	pollWatches();
+	void	waitForNotifications();
+	//! Makes the native backend watch the directories of the files in mWatchList.
+	void	updateWatchedDirectories();
+	//! Checks the watches for modifications of \a filePaths, or of all files if null, and erases discarded watches. Requires mMutex.
+	void	checkWatches( const std::set<fs::path> *filePaths );
 
 	std::list<std::unique_ptr<Watch>>	mWatchList;
 	mutable std::recursive_mutex		mMutex;
 	std::thread							mThread;
 	std::atomic<bool>					mThreadShouldQuit;
 	std::atomic<double>					mThreadUpdateInterval		= { 0.02 };
+	std::atomic<double>					mDebounceInterval			= { 0.05 };
+	Backend								mBackend					= BACKEND_AUTO;
+	std::atomic<Backend>				mActiveBackend				= { BACKEND_POLLING };
+	std::unique_ptr<Notifier>			mNotifier;					// exists while the native backend is active
 	std::atomic<bool>					mWatchingEnabled			= { true };
 	std::atomic<bool>					mConnectToAppUpdateEnabled	= { true };
 	signals::Connection					mConnectionAppUpdate;
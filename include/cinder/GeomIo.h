@@ -31,12 +31,15 @@
 #include "cinder/Shape2d.h"
 #include "cinder/Color.h"
 #include "cinder/AxisAlignedBox.h"
+#include "cinder/Noncopyable.h"
 
 #include <set>
 #include <vector>
 #include <map>
 #include <algorithm>
 #include <array>
+#include <list>
+#include <mutex>
 
 // Forward declarations in cinder::
 namespace cinder {
@@ -77,6 +80,9 @@ CI_API void copyData( uint8_t srcDimensions, size_t srcStrideBytes, const float
 CI_API void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec2 *texCoords, std::vector<vec3> *resultTangents, std::vector<vec3> *resultBitangents );
 //! Utility function for calculating tangents and bitangents from indexed geometry and 3D texture coordinates. \a resultBitangents may be NULL if not needed.
 CI_API void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec3 *texCoords, std::vector<vec3> *resultTangents, std::vector<vec3> *resultBitangents );
+/*! Utility function for building the triangles adjacent to each vertex of indexed triangles in compressed form. The triangles sharing vertex \c v
+	are \a resultTriangles[ \a resultOffsets[v] ] up to (but excluding) \a resultTriangles[ \a resultOffsets[v + 1] ], in ascending order. */
+CI_API void calculateVertexTriangleAdjacency( size_t numIndices, const uint32_t *indices, size_t numVertices, std::vector<uint32_t> *resultOffsets, std::vector<uint32_t> *resultTriangles );
 
 struct CI_API AttribInfo {
 	AttribInfo( const Attrib &attrib, uint8_t dims, size_t stride, size_t offset, uint32_t instanceDivisor = 0 )
@@ -147,6 +153,9 @@ class CI_API Source {
 	
 	virtual void		loadInto( Target *target, const AttribSet &requestedAttribs ) const = 0;
 	virtual Source*		clone() const = 0;
+	//! Stores every parameter which determines the output of loadInto() in \a key and returns \c true, or returns \c false if the Source can't be cached by SourceCache.
+	//! Built-in Sources only provide a key for their exact type, so subclasses are not cached unless they override this.
+	virtual bool		calcCacheKey( std::string * /*key*/ ) const { return false; }
 
   protected:
 	//! Builds a sequential list of vertices to simulate an indexed geometry when Source is non-indexed. Assumes \a dest contains storage for getNumVertices() entries
@@ -297,6 +306,7 @@ class CI_API Cube : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Cube*		clone() const override { return new Cube( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	ivec3					mSubdivisions;
@@ -381,6 +391,7 @@ class CI_API Icosphere : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Icosphere*	clone() const override { return new Icosphere( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	void	calculate() const;
@@ -408,6 +419,7 @@ class CI_API Teapot : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Teapot*		clone() const override { return new Teapot( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	void			calculate( std::vector<float> *positions, std::vector<float> *normals, std::vector<float> *texCoords, std::vector<uint32_t> *indices ) const;
@@ -500,6 +512,7 @@ class CI_API Sphere : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Sphere*		clone() const override { return new Sphere( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	void		numRingsAndSegments( int *numRings, int *numSegments ) const;
@@ -534,6 +547,7 @@ class CI_API Capsule : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Capsule*	clone() const override { return new Capsule( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   private:
 	void	updateCounts();
@@ -572,6 +586,7 @@ class CI_API Torus : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Torus*		clone() const override { return new Torus( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	void		updateCounts();
@@ -699,6 +714,7 @@ class CI_API Cylinder : public Source {
 	AttribSet	getAvailableAttribs() const override;
 	void		loadInto( Target *target, const AttribSet &requestedAttribs ) const override;
 	Cylinder*	clone() const override { return new Cylinder( *this ); }
+	bool		calcCacheKey( std::string *key ) const override;
 
   protected:
 	void	updateCounts();
@@ -1497,6 +1513,11 @@ class CI_API SourceModsContext : public Target {
 	const float*	getAttribData( Attrib attr ) const { return const_cast<SourceModsContext*>( this )->getAttribData( attr ); }
 	uint32_t*		getIndicesData();
 	const uint32_t*	getIndicesData() const { return const_cast<SourceModsContext*>( this )->getIndicesData(); }
+
+	//! Replaces the storage for \a attr with uninitialized storage for \a count elements of \a dims, and returns it. The previous storage is moved into \a previousData if supplied, allowing Modifiers to write results in place without an intermediate buffer.
+	float*			reallocAttrib( Attrib attr, uint8_t dims, size_t count, std::unique_ptr<float[]> *previousData = nullptr );
+	//! Replaces the index storage with uninitialized storage for \a numIndices, and returns it. The previous storage is moved into \a previousIndices if supplied.
+	uint32_t*		reallocIndices( Primitive primitive, size_t numIndices, std::unique_ptr<uint32_t[]> *previousIndices = nullptr );
 	
 	void			preload( const AttribSet &requestedAttribs );
 	void			combine( const SourceModsContext &rhs );
@@ -1601,6 +1622,44 @@ class CI_API SourceMods : public Source {
 };
 
 
+//! Retains the output of cacheable Sources (those for which Source::calcCacheKey() succeeds), keyed by the Source's parameters and the requested attributes.
+//! SourceMods chains rebuilt with identical Source parameters then skip regeneration. Entries are evicted least-recently-used once getMaxBytes() is exceeded. Thread-safe.
+class CI_API SourceCache : private Noncopyable {
+  public:
+	//! Returns the global SourceCache used by SourceMods
+	static SourceCache*	get();
+
+	//! Enables or disables caching. Enabled by default.
+	void	setEnabled( bool enable );
+	bool	isEnabled() const;
+	//! Sets the maximum number of bytes retained by the cache. Defaults to 64MB.
+	void	setMaxBytes( size_t maxBytes );
+	size_t	getMaxBytes() const;
+	//! Returns the number of bytes currently retained by the cache
+	size_t	getNumBytes() const;
+	//! Returns the number of cached entries
+	size_t	getNumEntries() const;
+	//! Removes all cached entries
+	void	clear();
+
+	//! Loads \a source into \a target, replaying a cached result when available. Falls back to Source::loadInto() for Sources that are not cacheable.
+	void	loadInto( const Source *source, Target *target, const AttribSet &requestedAttribs );
+
+  private:
+	SourceCache();
+
+	struct Entry;
+	typedef std::pair<std::string, uint32_t>	Key; // Source::calcCacheKey() and the mask of requested attributes
+
+	void	evict();
+
+	mutable std::mutex								mMutex;
+	bool											mEnabled;
+	size_t											mMaxBytes, mNumBytes;
+	std::list<std::pair<Key, std::shared_ptr<const Entry>>>	mEntries; // most recently used at the front
+	std::map<Key, decltype(mEntries)::iterator>		mEntryMap;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Source
 inline SourceMods operator>>( const SourceMods &sourceMods, const Modifier &modifier )
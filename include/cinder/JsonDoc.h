@@ -0,0 +1,260 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/DataSource.h"
+#include "cinder/Exception.h"
+#include "cinder/StringRef.h"
+
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace cinder {
+
+typedef std::shared_ptr<class JsonDoc>	JsonDocRef;
+
+//! Read-only JSON document for large inputs, parsed on demand.
+//! Parsing first builds an index of the document's structural characters, scanning 64 bytes at a time with SIMD, and then a compact
+//! array of values whose children are stored contiguously. Numbers and strings are only converted when read, and string contents
+//! are available as StringRefs into the source buffer. Child access by index is O(1). Objects with many members build a hash of
+//! their keys on first lookup; smaller ones are searched linearly. Unlike loadJson(), comments are never allowed.
+//! JsonDoc::Value refers into its JsonDoc, which must outlive it. A JsonDoc may be read from several threads at once.
+class CI_API JsonDoc {
+  public:
+	enum Type : uint8_t { TYPE_NULL, TYPE_BOOL, TYPE_NUMBER, TYPE_STRING, TYPE_ARRAY, TYPE_OBJECT };
+
+  private:
+	struct Impl;
+
+  public:
+	class Iter;
+
+	//! A lightweight reference to a value within a JsonDoc.
+	class CI_API Value {
+	  public:
+		//! Creates an invalid Value, as returned by findChild() when there is no match.
+		Value() : mImpl( nullptr ), mIndex( 0 ) {}
+
+		//! Returns whether the Value refers to a value of a JsonDoc.
+		bool		isValid() const		{ return mImpl != nullptr; }
+		Type		getType() const;
+		bool		isNull() const		{ return getType() == TYPE_NULL; }
+		bool		isBool() const		{ return getType() == TYPE_BOOL; }
+		bool		isNumber() const	{ return getType() == TYPE_NUMBER; }
+		bool		isString() const	{ return getType() == TYPE_STRING; }
+		bool		isArray() const		{ return getType() == TYPE_ARRAY; }
+		bool		isObject() const	{ return getType() == TYPE_OBJECT; }
+
+		//! Returns the number of elements of an array or members of an object, or \c 0 for other values.
+		size_t		getNumChildren() const;
+		Iter		begin() const;
+		Iter		end() const;
+
+		//! Returns the child at \a index. Throws ExcChildNotFound if there is none.
+		Value		operator[]( size_t index ) const		{ return getChild( index ); }
+		//! Returns the child at \a index. Throws ExcChildNotFound if there is none.
+		Value		operator[]( int index ) const			{ return getChild( (size_t)index ); }
+		//! Returns the member with key \a key. Throws ExcChildNotFound if there is none.
+		Value		operator[]( const StringRef &key ) const;
+		//! Returns the member with key \a key. Throws ExcChildNotFound if there is none.
+		Value		operator[]( const char *key ) const		{ return operator[]( StringRef( key ) ); }
+		//! Returns the child at \a index. Throws ExcChildNotFound if there is none.
+		Value		getChild( size_t index ) const;
+		/**! Returns the descendant at \a relativePath, whose components are member keys or, for arrays, indices. Throws ExcChildNotFound if there is none.
+			<br><tt>JsonDoc::Value node = doc.getRoot().getChild( "path.to.3.child" );</tt> **/
+		Value		getChild( const StringRef &relativePath, char separator = '.' ) const;
+		//! Returns the member with key \a key, or an invalid Value if there is none.
+		Value		findChild( const StringRef &key ) const;
+		//! Returns whether the descendant at \a relativePath exists.
+		bool		hasChild( const StringRef &relativePath, char separator = '.' ) const;
+
+		//! Returns the key of an object member as it appears in the source, with escape sequences left undecoded. Empty for other values.
+		StringRef	getKey() const;
+		//! Returns the characters of a string as they appear in the source, with escape sequences left undecoded. For numbers, \c true, \c false and \c null returns their text.
+		StringRef	getRaw() const;
+		//! Returns whether a string contains escape sequences, so that getRaw() differs from getString().
+		bool		hasEscapes() const;
+
+		//! Returns a boolean. Throws ExcNonConvertible for other types.
+		bool			getBool() const;
+		//! Returns a number which must be an integer fitting in 64 bits. Throws ExcNonConvertible otherwise.
+		int64_t			getInt() const;
+		//! Returns a number which must be a non-negative integer fitting in 64 bits. Throws ExcNonConvertible otherwise.
+		uint64_t		getUint() const;
+		//! Returns a number. Throws ExcNonConvertible for other types.
+		double			getDouble() const;
+		//! Returns a string with its escape sequences decoded, or the text of a number, \c true, \c false or \c null. Throws ExcNonConvertible for arrays and objects.
+		std::string		getString() const;
+
+		/**! Returns the value converted to \a T, which may be \c bool, an arithmetic type or std::string. Throws ExcNonConvertible when the value does not fit.
+			<br><tt>float value = node.getValue<float>();</tt> **/
+		template<typename T>
+		T				getValue() const	{ T result; read( &result ); return result; }
+		//! Returns the value of the descendant at \a relativePath converted to \a T. Shortcut for \code getChild( relativePath ).getValue<T>() \endcode
+		template<typename T>
+		T				getValueForKey( const StringRef &relativePath, char separator = '.' ) const	{ return getChild( relativePath, separator ).getValue<T>(); }
+
+	  private:
+		Value( const Impl *impl, uint32_t index ) : mImpl( impl ), mIndex( index ) {}
+
+		// returns the descendant at 'relativePath', or an invalid Value
+		Value	findDescendant( const StringRef &relativePath, char separator ) const;
+
+		void	read( bool *result ) const			{ *result = getBool(); }
+		void	read( double *result ) const		{ *result = getDouble(); }
+		void	read( float *result ) const			{ *result = (float)getDouble(); }
+		void	read( long double *result ) const	{ *result = getDouble(); }
+		void	read( std::string *result ) const	{ *result = getString(); }
+		template<typename T>
+		typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type read( T *result ) const
+		{
+			int64_t v = getInt();
+			if( v < (int64_t)std::numeric_limits<T>::min() || v > (int64_t)std::numeric_limits<T>::max() )
+				throwNonConvertible();
+			*result = (T)v;
+		}
+		template<typename T>
+		typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type read( T *result ) const
+		{
+			uint64_t v = getUint();
+			if( v > (uint64_t)std::numeric_limits<T>::max() )
+				throwNonConvertible();
+			*result = (T)v;
+		}
+		[[noreturn]] void	throwNonConvertible() const;
+
+		const Impl	*mImpl;
+		uint32_t	mIndex;
+
+		friend class JsonDoc;
+		friend class JsonDoc::Iter;
+	};
+
+	//! Iterates the children of an array or object.
+	class Iter {
+	  public:
+		typedef std::random_access_iterator_tag	iterator_category;
+		typedef Value							value_type;
+		typedef std::ptrdiff_t					difference_type;
+		typedef const Value*					pointer;
+		typedef Value							reference;
+
+		Iter() : mImpl( nullptr ), mChild( nullptr ) {}
+
+		Value		operator*() const						{ return Value( mImpl, *mChild ); }
+		Value		operator[]( std::ptrdiff_t n ) const	{ return Value( mImpl, mChild[n] ); }
+		Iter&		operator++()							{ ++mChild; return *this; }
+		Iter		operator++( int )						{ Iter result( *this ); ++mChild; return result; }
+		Iter&		operator--()							{ --mChild; return *this; }
+		Iter		operator--( int )						{ Iter result( *this ); --mChild; return result; }
+		Iter&		operator+=( std::ptrdiff_t n )			{ mChild += n; return *this; }
+		Iter		operator+( std::ptrdiff_t n ) const		{ return Iter( mImpl, mChild + n ); }
+		std::ptrdiff_t	operator-( const Iter &rhs ) const	{ return mChild - rhs.mChild; }
+		bool		operator==( const Iter &rhs ) const		{ return mChild == rhs.mChild; }
+		bool		operator!=( const Iter &rhs ) const		{ return mChild != rhs.mChild; }
+		bool		operator<( const Iter &rhs ) const		{ return mChild < rhs.mChild; }
+
+	  private:
+		Iter( const Impl *impl, const uint32_t *child ) : mImpl( impl ), mChild( child ) {}
+
+		const Impl		*mImpl;
+		const uint32_t	*mChild;
+
+		friend class Value;
+	};
+
+	//! Parses the JSON in \a dataSource, keeping its Buffer rather than copying it.
+	explicit JsonDoc( const DataSourceRef &dataSource );
+	//! Parses the JSON in \a jsonString, which is moved into the JsonDoc.
+	explicit JsonDoc( std::string jsonString );
+	JsonDoc( JsonDoc &&rhs );
+	JsonDoc& operator=( JsonDoc &&rhs );
+	~JsonDoc();
+
+	//! Returns the document's top-level value.
+	Value		getRoot() const;
+	//! Returns the number of values in the document, including the root and all of its descendants.
+	size_t		getNumValues() const;
+	//! Returns the source the JsonDoc was parsed from.
+	StringRef	getSource() const;
+
+	//! Base class for JsonDoc exceptions.
+	class CI_API Exception : public cinder::Exception {
+	  public:
+		Exception( const std::string &description ) : cinder::Exception( description ) {}
+	};
+
+	//! Exception thrown for malformed JSON, when parsing or when a string with an invalid escape sequence is read.
+	class CI_API ExcParseError : public JsonDoc::Exception {
+	  public:
+		ExcParseError( const std::string &description, size_t offset ) : JsonDoc::Exception( description ), mOffset( offset ) {}
+		//! Returns the offset in bytes of the error from the start of the source.
+		size_t	getOffset() const	{ return mOffset; }
+
+	  private:
+		size_t	mOffset;
+	};
+
+	//! Exception expressing the absence of an expected child value.
+	class CI_API ExcChildNotFound : public JsonDoc::Exception {
+	  public:
+		ExcChildNotFound( const std::string &description ) : JsonDoc::Exception( description ) {}
+	};
+
+	//! Exception expressing the inability to convert a value to a requested type.
+	class CI_API ExcNonConvertible : public JsonDoc::Exception {
+	  public:
+		ExcNonConvertible( const std::string &description ) : JsonDoc::Exception( description ) {}
+	};
+
+  private:
+	JsonDoc( const JsonDoc & ) = delete;
+	JsonDoc& operator=( const JsonDoc & ) = delete;
+
+	std::unique_ptr<Impl>	mImpl;
+};
+
+namespace detail {
+
+// Conversions shared by JsonDoc and JsonReader
+
+//! Sets \a result to the type of \a token, which must be a JSON number, \c true, \c false or \c null. Returns \c false when it is none of these.
+CI_API bool		parseJsonScalarType( const StringRef &token, JsonDoc::Type *result );
+//! Converts the valid JSON number \a number to a double.
+CI_API double	parseJsonDouble( const StringRef &number );
+//! Converts the valid JSON number \a number to an integer. Returns \c false when it is not an integer or does not fit.
+CI_API bool		parseJsonInt( const StringRef &number, int64_t *result );
+//! Converts the valid JSON number \a number to an unsigned integer. Returns \c false when it is not a non-negative integer or does not fit.
+CI_API bool		parseJsonUint( const StringRef &number, uint64_t *result );
+//! Appends the characters of a JSON string, excluding its quotes, to \a result with escape sequences decoded. Returns the offset of the first invalid escape sequence, or std::string::npos.
+CI_API size_t	decodeJsonString( const StringRef &str, std::string *result );
+
+} // namespace detail
+
+} // namespace cinder
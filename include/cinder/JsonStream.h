@@ -0,0 +1,221 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/ConcurrentCircularBuffer.h"
+#include "cinder/DataSource.h"
+#include "cinder/DataTarget.h"
+#include "cinder/Json.h"
+#include "cinder/JsonDoc.h"
+#include "cinder/Stream.h"
+
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace cinder {
+
+//! Writes JSON to an OStream incrementally, so that documents of any size can be written in bounded memory.
+//! Output is staged in a fixed-size buffer and written to the stream whenever it fills. Calls must form a valid document:
+//! within objects key() precedes every value. When \a multipleValues is enabled, any number of top-level values may be
+//! written, each followed by a newline, which with no indentation produces NDJSON.
+//! <br><tt>writer.beginObject().key( "id" ).value( 7 ).key( "tags" ).beginArray().value( "a" ).endArray().endObject();</tt>
+class CI_API JsonWriter {
+  public:
+	//! Writes to \a stream, indenting nested values by \a indent spaces, or writing compactly when \a indent is negative.
+	explicit JsonWriter( const OStreamRef &stream, int indent = -1, bool multipleValues = false, size_t bufferSize = 65536 );
+	//! Writes to the stream of \a dataTarget, indenting nested values by \a indent spaces, or writing compactly when \a indent is negative.
+	explicit JsonWriter( const DataTargetRef &dataTarget, int indent = -1, bool multipleValues = false, size_t bufferSize = 65536 );
+	//! Flushes buffered output. Unterminated arrays and objects are left unterminated.
+	~JsonWriter();
+
+	JsonWriter&	beginObject();
+	JsonWriter&	endObject();
+	JsonWriter&	beginArray();
+	JsonWriter&	endArray();
+	//! Writes the key of the next member of the current object.
+	JsonWriter&	key( const StringRef &key );
+
+	JsonWriter&	value( std::nullptr_t );
+	JsonWriter&	value( bool value );
+	JsonWriter&	value( int value )					{ return writeInt( value ); }
+	JsonWriter&	value( unsigned int value )			{ return writeUint( value ); }
+	JsonWriter&	value( long value )					{ return writeInt( value ); }
+	JsonWriter&	value( unsigned long value )		{ return writeUint( value ); }
+	JsonWriter&	value( long long value )			{ return writeInt( value ); }
+	JsonWriter&	value( unsigned long long value )	{ return writeUint( value ); }
+	//! Writes \a value with the fewest digits which convert back to it exactly. Infinities and NaNs are written as \c null.
+	JsonWriter&	value( double value );
+	JsonWriter&	value( float value )				{ return this->value( (double)value ); }
+	JsonWriter&	value( const StringRef &value );
+	JsonWriter&	value( const char *value )			{ return this->value( StringRef( value ) ); }
+	JsonWriter&	value( const std::string &value )	{ return this->value( StringRef( value ) ); }
+	//! Writes \a json and its descendants.
+	JsonWriter&	value( const Json &json );
+	//! Writes \a json, which must be a valid JSON value, without validating or reformatting it.
+	JsonWriter&	rawValue( const StringRef &json );
+
+	//! Writes all buffered output to the stream.
+	void		flush();
+	//! Returns the depth of the arrays and objects currently open.
+	size_t		getDepth() const	{ return mStack.size(); }
+
+  private:
+	JsonWriter&	writeInt( int64_t value );
+	JsonWriter&	writeUint( uint64_t value );
+
+	// validates that a value may be written now, and writes the separator and indentation before it
+	void	beginValue();
+	// marks the end of a value, ending the document when it was at the top level
+	void	endValue();
+	void	endContainer( uint8_t container );
+	void	writeNewline();
+	void	writeString( const StringRef &str );
+	void	write( const char *data, size_t size );
+	void	write( char c )		{ if( mBufferPos == mBuffer.size() ) flush(); mBuffer[mBufferPos++] = c; }
+
+	OStreamRef				mStream;
+	std::vector<char>		mBuffer;
+	size_t					mBufferPos;
+	int						mIndent;
+	bool					mMultipleValues;
+	std::vector<uint8_t>	mStack; // open containers, innermost last
+	bool					mFirstInContainer, mHasKey, mDocumentDone;
+};
+
+//! Reads JSON from an IStreamCinder as a sequence of events, one per call to next(), so that documents of any size can be read in
+//! bounded memory. Only a fixed-size buffer is held, growing only for a single string or number which exceeds it. Strings are
+//! returned as StringRefs, which are valid until the next call to next(). When \a multipleValues is enabled, a sequence of
+//! top-level values separated by whitespace is accepted, such as NDJSON.
+class CI_API JsonReader {
+  public:
+	enum Event : uint8_t { BEGIN_OBJECT, END_OBJECT, BEGIN_ARRAY, END_ARRAY, KEY, NULL_VALUE, BOOL, NUMBER, STRING, END_DOCUMENT };
+
+	//! Reads from \a stream.
+	explicit JsonReader( const IStreamRef &stream, bool multipleValues = false, size_t bufferSize = 65536 );
+	//! Reads from a stream created from \a dataSource.
+	explicit JsonReader( const DataSourceRef &dataSource, bool multipleValues = false, size_t bufferSize = 65536 );
+
+	//! Reads the next event. Returns END_DOCUMENT at the end of the stream, and on every call after. Throws JsonDoc::ExcParseError for malformed JSON.
+	Event		next();
+	//! Returns the most recent event.
+	Event		getEvent() const	{ return mEvent; }
+	//! Returns the depth of the arrays and objects currently open.
+	size_t		getDepth() const	{ return mStack.size(); }
+	//! Returns the offset in bytes from the start of the stream of the most recent event.
+	uint64_t	getOffset() const	{ return mEventOffset; }
+
+	//! Returns the decoded characters of a KEY or STRING, or the text of a NUMBER, BOOL or NULL_VALUE. Valid until the next call to next().
+	StringRef	getString() const;
+	//! Returns the value of a BOOL. Throws JsonDoc::ExcNonConvertible for other events.
+	bool		getBool() const;
+	//! Returns the value of a NUMBER which must be an integer fitting in 64 bits. Throws JsonDoc::ExcNonConvertible otherwise.
+	int64_t		getInt() const;
+	//! Returns the value of a NUMBER which must be a non-negative integer fitting in 64 bits. Throws JsonDoc::ExcNonConvertible otherwise.
+	uint64_t	getUint() const;
+	//! Returns the value of a NUMBER. Throws JsonDoc::ExcNonConvertible for other events.
+	double		getDouble() const;
+
+	//! Skips the value that the most recent event began: after a KEY skips the member's value, and after BEGIN_OBJECT or BEGIN_ARRAY skips to its end.
+	void		skipValue();
+	//! Reads the value that the most recent event began into a Json: after a KEY the member's value, after BEGIN_OBJECT or BEGIN_ARRAY the whole container, and otherwise the scalar just read.
+	Json		readValue();
+
+  private:
+	enum State : uint8_t { VALUE, FIRST_KEY_OR_END, FIRST_VALUE_OR_END, KEY_STATE, COLON, COMMA_OR_END, DOCUMENT_END, DONE };
+
+	// skips whitespace, returning the next character without consuming it, or -1 at the end of the stream
+	int		peek();
+	// moves the unconsumed characters from 'keep' onward to the start of the buffer and reads more, returning whether any were read
+	bool	fill( size_t *keep );
+	void	readString();
+	void	readScalar();
+	Event	endContainer();
+	void	afterValue()		{ mState = mStack.empty() ? DOCUMENT_END : COMMA_OR_END; }
+	Json	readScalarValue() const;
+	[[noreturn]] void	throwParseError( uint64_t offset, const std::string &message ) const;
+	[[noreturn]] void	throwNonConvertible() const;
+
+	IStreamRef				mStream;
+	bool					mMultipleValues;
+	std::vector<char>		mBuffer;
+	size_t					mPos, mEnd; // the next unconsumed character and the end of the buffered characters
+	uint64_t				mBufferOffset; // the stream offset of mBuffer[0]
+	bool					mStreamEnd;
+
+	std::vector<uint8_t>	mStack; // open containers, innermost last
+	State					mState;
+	Event					mEvent;
+	uint64_t				mEventOffset;
+	size_t					mTokenBegin, mTokenLength; // the undecoded characters of the current string or scalar, within mBuffer
+	bool					mTokenDecoded;
+	std::string				mDecoded; // the current string, when it contains escape sequences
+};
+
+//! Reads newline-delimited JSON (NDJSON) one record at a time. Records are read and parsed into JsonDocs on a background thread,
+//! which stays at most about \a maxQueuedRecords ahead of readNext(). Records are handed over in batches of those already
+//! buffered, so that each costs no synchronization. Blank lines are skipped.
+class CI_API NdjsonReader {
+  public:
+	//! Reads from \a stream.
+	explicit NdjsonReader( const IStreamRef &stream, size_t maxQueuedRecords = 1024 );
+	//! Reads from a stream created from \a dataSource.
+	explicit NdjsonReader( const DataSourceRef &dataSource, size_t maxQueuedRecords = 1024 );
+	//! Stops the background thread, discarding any queued records.
+	~NdjsonReader();
+
+	//! Returns the next record, waiting for it to be parsed if needed, or null after the last record. Rethrows errors from reading
+	//! or parsing; JsonDoc::ExcParseError describes the line of the record.
+	JsonDocRef	readNext();
+
+  private:
+	typedef std::shared_ptr<std::vector<JsonDocRef>>	BatchRef;
+
+	NdjsonReader( const NdjsonReader & ) = delete;
+	NdjsonReader& operator=( const NdjsonReader & ) = delete;
+
+	void	threadEntry();
+
+	enum { NUM_QUEUED_BATCHES = 4 };
+
+	IStreamRef							mStream;
+	size_t								mMaxBatchSize;
+	ConcurrentCircularBuffer<BatchRef>	mBatches; // null marks the end of the stream
+	BatchRef							mBatch; // the batch being read
+	size_t								mBatchPos;
+	std::thread							mThread;
+	std::atomic<bool>					mCanceled;
+	std::exception_ptr					mException; // written before the null batch is queued
+	bool								mDone;
+};
+
+//! Exception thrown by JsonWriter when calls do not form a valid document.
+class CI_API JsonWriterExc : public Exception {
+  public:
+	JsonWriterExc( const std::string &description ) : Exception( description ) {}
+};
+
+} // namespace cinder
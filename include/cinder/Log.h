@@ -29,6 +29,7 @@
 #include "cinder/CinderAssert.h"
 #include "cinder/Noncopyable.h"
 #include "cinder/System.h"
+#include "cinder/Exception.h"
 
 #include <sstream>
 #include <fstream>
@@ -36,6 +37,16 @@
 #include <memory>
 #include <mutex>
 #include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#if defined( __cplusplus ) && __cplusplus >= 201703L
+	#include <string_view>
+#endif
 
 // CI_MIN_LOG_LEVEL is designed so that if you set it to 7 : nothing logs, 6 : only fatal, 5 : fatal + error, ..., 1 : everything
 
@@ -80,8 +91,27 @@ struct CI_API Metadata {
 
 	Level		mLevel;
 	Location	mLocation;
+	//! The time the record was logged
+	std::chrono::system_clock::time_point	mTimestamp = std::chrono::system_clock::now();
+	//! The thread that logged the record
+	std::thread::id							mThreadId = std::this_thread::get_id();
+};
+
+namespace detail {
+
+//! An argument of a deferred log record: \a mSize bytes at \a mData, which \a mStream writes to a std::ostream
+struct DeferredArg {
+	//! Identifies arguments which Loggers may store without formatting them. Integers and floats are stored in \a mSize bytes, strings are null-terminated.
+	enum Type : uint8_t { OTHER, SIGNED, UNSIGNED, FLOAT, BOOL, CHAR, STRING };
+
+	void		(*mStream)( std::ostream &os, const void *data );
+	const void	*mData;
+	size_t		mSize;
+	Type		mType;
 };
 
+} // namespace detail
+
 CI_API extern std::ostream& operator<<( std::ostream &os, const Location &rhs );
 CI_API extern std::ostream& operator<<( std::ostream &lhs, const Level &rhs );
 
@@ -93,6 +123,9 @@ class CI_API Logger : private Noncopyable {
 	virtual ~Logger()	{}
 
 	virtual void write( const Metadata &meta, const std::string &text ) = 0;
+	//! Writes a record logged with the CI_LOG_DEFERRED_* macros from its \a numArgs unformatted \a args. Returns \c false when
+	//! the Logger only handles formatted text, in which case write() is called instead, which is the default.
+	virtual bool writeArgs( const Metadata & /*meta*/, const detail::DeferredArg * /*args*/, size_t /*numArgs*/ )	{ return false; }
 
 	void setTimestampEnabled( bool enable = true )	{ mTimeStampEnabled = enable; }
 	bool isTimestampEnabled() const					{ return mTimeStampEnabled; }
@@ -157,14 +190,84 @@ public:
 
 protected:
 	void setFilePath( const fs::path& filepath );
+	//! Switches to the next day's file after midnight, closing the current one. Returns whether the file changed.
+	bool rotate();
 
 	std::function<void( const fs::path& )> mFileChangeFn;
 
 	fs::path		mFolderPath;
 	std::string		mDailyFormatStr;
 	int				mYearDay;
+	time_t			mLastRotateTime;
 };
 	
+//! Thrown when a LoggerBinary file cannot be read
+class CI_API LogBinaryExc : public Exception {
+  public:
+	LogBinaryExc( const std::string &description ) : Exception( description ) {}
+};
+
+//! \brief LoggerBinary writes compact binary records rather than text, rotating files like LoggerFileRotating.
+//!
+//! Each record stores its level, timestamp, thread and an id for its source location, which is only spelled out the first time it appears in a file.
+//! Records logged with the CI_LOG_DEFERRED_* macros store numbers and strings unformatted. Files are decoded with LoggerBinary::Reader or the LogDecoder tool.
+//! The file is flushed after records at or above getFlushLevel(), so a crash may lose buffered records of lower levels.
+class CI_API LoggerBinary : public LoggerFileRotating {
+  public:
+	//! A decoded record
+	struct Record {
+		Level									mLevel;
+		std::chrono::system_clock::time_point	mTimestamp;
+		//! The std::hash of the logging thread's std::thread::id
+		uint64_t								mThreadId;
+		Location								mLocation;
+		std::string								mText;
+	};
+
+	//! Reads the records of a file written by LoggerBinary. Throws LogBinaryExc if the file is not a LoggerBinary file.
+	class CI_API Reader {
+	  public:
+		Reader( const fs::path &filePath );
+
+		//! Reads the next record into \a record, returning \c false at the end of the file. Throws LogBinaryExc on malformed records.
+		bool	readNext( Record *record );
+
+	  private:
+		// each returns false if the file ends first
+		bool	read( void *data, size_t size );
+		template<typename T>
+		bool	read( T *value )	{ return read( value, sizeof( T ) ); }
+		bool	readString( std::string *result );
+
+		std::ifstream			mStream;
+		fs::path				mFilePath;
+		std::vector<Location>	mLocations;
+	};
+
+	//! Creates a LoggerBinary writing to a file in \a folder named by passing \a formatStr to strftime, rotating at midnight. A \a formatStr without
+	//! conversion specifiers writes a single file. \a fileChangeFn is called with each new file path, for instance to call limitDirectoryFileCount().
+	LoggerBinary( const fs::path &folder, const std::string &formatStr, bool appendToExisting = true, std::function<void( const fs::path& )> fileChangeFn = nullptr );
+
+	void write( const Metadata &meta, const std::string &text ) override;
+	bool writeArgs( const Metadata &meta, const detail::DeferredArg *args, size_t numArgs ) override;
+
+	//! Sets the level at and above which the file is flushed after every record. Defaults to LEVEL_ERROR.
+	void	setFlushLevel( Level level )	{ mFlushLevel = level; }
+	Level	getFlushLevel() const			{ return mFlushLevel; }
+
+  protected:
+	// opens the current file if needed and appends the header of a record of 'type' to mBuffer
+	void		beginRecord( uint8_t type, const Metadata &meta );
+	// writes mBuffer to the file
+	void		endRecord( const Metadata &meta );
+	uint32_t	getLocationId( const Location &location );
+
+	Level										mFlushLevel;
+	std::string									mBuffer;
+	std::vector<Location>						mLocations;
+	std::unordered_multimap<size_t, uint32_t>	mLocationIds;
+};
+
 //! LoggerBreakpoint doesn't actually print anything, but triggers a breakpoint on log events above a specified threshold.
 class CI_API LoggerBreakpoint : public Logger {
   public:
@@ -197,9 +300,87 @@ protected:
 #endif
 };
 
+namespace detail {
+
+template<typename T>
+void streamDeferredValue( std::ostream &os, const void *data )
+{
+	typename std::aligned_storage<sizeof( T ), alignof( T )>::type value;
+	std::memcpy( &value, data, sizeof( T ) );
+	os << *reinterpret_cast<const T*>( &value );
+}
+
+inline void streamDeferredString( std::ostream &os, const void *data )
+{
+	os << static_cast<const char*>( data );
+}
+
+template<typename T>
+constexpr DeferredArg::Type getDeferredArgType()
+{
+	return std::is_same<T, bool>::value ? DeferredArg::BOOL
+		: ( std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value ) ? DeferredArg::CHAR
+		: ( std::is_integral<T>::value && std::is_signed<T>::value ) ? DeferredArg::SIGNED
+		: std::is_integral<T>::value ? DeferredArg::UNSIGNED
+		: ( std::is_same<T, float>::value || std::is_same<T, double>::value ) ? DeferredArg::FLOAT
+		: DeferredArg::OTHER;
+}
+
+template<typename T>
+struct IsStringView : std::false_type {};
+#if defined( __cplusplus ) && __cplusplus >= 201703L
+template<typename CharT, typename Traits>
+struct IsStringView<std::basic_string_view<CharT, Traits>> : std::true_type {};
+#endif
+
+template<typename T>
+DeferredArg makeDeferredArg( const T &value )
+{
+	static_assert( std::is_trivially_copyable<T>::value, "deferred log arguments must be trivially copyable, C strings or std::strings" );
+	// only the pointer or view would be copied, and the characters may be gone by the time the record is written
+	static_assert( ! std::is_pointer<T>::value && ! IsStringView<T>::value, "deferred log arguments must not be pointers or views other than C strings and std::string_view" );
+	return DeferredArg{ &streamDeferredValue<T>, &value, sizeof( T ), getDeferredArgType<T>() };
+}
+
+//! C strings are copied rather than their pointers
+inline DeferredArg makeDeferredArg( const char *str )
+{
+	return DeferredArg{ &streamDeferredString, str, std::strlen( str ) + 1, DeferredArg::STRING };
+}
+
+inline DeferredArg makeDeferredArg( char *str )
+{
+	return makeDeferredArg( const_cast<const char*>( str ) );
+}
+
+inline DeferredArg makeDeferredArg( const std::string &str )
+{
+	return DeferredArg{ &streamDeferredString, str.c_str(), str.size() + 1, DeferredArg::STRING };
+}
+
+//! Returns \a value, or a null-terminated copy of a std::string_view which lives until the record is written
+template<typename T>
+const T& toDeferredValue( const T &value )
+{
+	return value;
+}
+
+#if defined( __cplusplus ) && __cplusplus >= 201703L
+inline std::string toDeferredValue( std::string_view str )
+{
+	return std::string( str );
+}
+#endif
+
+} // namespace detail
+
 //! \brief LogManager manages a stack of all active Loggers.
 //!
 //! LogManager's default state contains a single LoggerConsole.  LogManager allows for adding and removing Loggers via their pointer values.
+//!
+//! By default every log record is written by the thread logging it, while holding the mutex returned by getMutex(). With setAsync(), records are instead
+//! copied into a lock-free ring buffer owned by the logging thread and written by a single background thread, so that logging never blocks on I/O or on other threads.
+//! Each thread's buffer is bounded; records which do not fit are dropped and counted by getNumDropped().
 class CI_API LogManager {
 public:
 	// Returns a pointer to the shared instance. To enable logging during shutdown, this instance is leaked at shutdown.
@@ -228,7 +409,18 @@ public:
 	void	setLevel( Level level );
 	
 	void write( const Metadata &meta, const std::string &text );
-	
+	//! Writes a record whose \a numArgs arguments are formatted by the background thread when logging asynchronously, or immediately otherwise. \a function and \a file must outlive the LogManager, as string literals do.
+	void writeDeferred( Level level, const char *function, const char *file, size_t line, const detail::DeferredArg *args, size_t numArgs );
+
+	//! Enables or disables asynchronous logging. Each thread that logs receives a ring buffer of \a threadBufferSize bytes, rounded up to a power of two. Disabling writes every pending record first.
+	void		setAsync( bool enable = true, size_t threadBufferSize = 64 * 1024 );
+	//! Returns whether records are written asynchronously by a background thread.
+	bool		isAsync() const		{ return mAsync.load( std::memory_order_acquire ); }
+	//! Blocks until every record logged asynchronously before the call has been written. Returns immediately when logging synchronously.
+	void		flush();
+	//! Returns the number of records dropped so far because the logging thread's ring buffer was full.
+	uint64_t	getNumDropped() const	{ return mNumDropped.load( std::memory_order_relaxed ); }
+
 	template<typename LoggerT, typename... Args>
 	std::shared_ptr<LoggerT> makeLogger( Args&&... args );
 
@@ -237,10 +429,22 @@ public:
 	
 protected:
 	LogManager();
+	~LogManager();
+
+	// writes a record to every Logger, taking mMutex
+	void writeToLoggers( const Metadata &meta, const std::string &text );
 
 	std::vector<LoggerRef>			mLoggers;
 	
 	mutable std::mutex				mMutex;
+
+	// asynchronous logging; the writer is created the first time it is enabled and lives until the LogManager is destroyed
+	class AsyncWriter;
+	friend class AsyncWriter;
+	std::atomic<bool>				mAsync;
+	std::atomic<uint64_t>			mNumDropped;
+	std::unique_ptr<AsyncWriter>	mAsyncWriter;
+	std::mutex						mAsyncMutex;
 	
 	static LogManager 				*sInstance;
 };
@@ -281,6 +485,26 @@ std::shared_ptr<LoggerT> makeLogger( Args&&... args )
 	return manager()->makeLogger<LoggerT>( std::forward<Args>( args )... );
 }
 
+namespace detail {
+
+template<typename... Args>
+void writeDeferredValues( Level level, const char *function, const char *file, size_t line, const Args&... args )
+{
+	const DeferredArg deferredArgs[] = { makeDeferredArg( args )... };
+	manager()->writeDeferred( level, function, file, line, deferredArgs, sizeof...( Args ) );
+}
+
+} // namespace detail
+
+//! Writes a record at \a level whose \a args are copied and formatted later by the background thread when logging asynchronously.
+//! Arguments must be trivially copyable, C strings, std::strings or std::string_views. Used by the CI_LOG_DEFERRED_* macros.
+template<typename... Args>
+void writeDeferred( Level level, const char *function, const char *file, size_t line, const Args&... args )
+{
+	// copies of std::string_views live until writeDeferredValues() returns
+	detail::writeDeferredValues( level, function, file, line, detail::toDeferredValue( args )... );
+}
+
 //! If a logger of type LoggerT exists, it will return that logger.  Otherwise creates and
 //! returns a new logger of type LoggerT, adding it to the current Logger stack.
 template<typename LoggerT, typename... Args>
@@ -377,6 +601,47 @@ std::vector<std::shared_ptr<LoggerT>> LogManager::getLoggers()
 	#define CI_LOG_F( stream )	((void)0)
 #endif
 
+// Deferred logging macros, which take comma separated arguments rather than a stream expression, e.g. CI_LOG_DEFERRED_I( "frame ", frameCount, " took ", ms, " ms" ).
+// When LogManager::setAsync() is enabled, the arguments are copied as raw bytes and only formatted by the background thread.
+
+#define CINDER_LOG_DEFERRED( level, ... ) ::cinder::log::writeDeferred( level, CINDER_CURRENT_FUNCTION, __FILE__, __LINE__, __VA_ARGS__ )
+
+#if( CI_MIN_LOG_LEVEL <= 0 )
+	#define CI_LOG_DEFERRED_V( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_VERBOSE, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_V( ... )	((void)0)
+#endif
+
+#if( CI_MIN_LOG_LEVEL <= 1 )
+	#define CI_LOG_DEFERRED_D( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_DEBUG, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_D( ... )	((void)0)
+#endif
+
+#if( CI_MIN_LOG_LEVEL <= 2 )
+	#define CI_LOG_DEFERRED_I( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_INFO, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_I( ... )	((void)0)
+#endif
+
+#if( CI_MIN_LOG_LEVEL <= 3 )
+	#define CI_LOG_DEFERRED_W( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_WARNING, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_W( ... )	((void)0)
+#endif
+
+#if( CI_MIN_LOG_LEVEL <= 4 )
+	#define CI_LOG_DEFERRED_E( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_ERROR, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_E( ... )	((void)0)
+#endif
+
+#if( CI_MIN_LOG_LEVEL <= 5 )
+	#define CI_LOG_DEFERRED_F( ... )	CINDER_LOG_DEFERRED( ::cinder::log::LEVEL_FATAL, __VA_ARGS__ )
+#else
+	#define CI_LOG_DEFERRED_F( ... )	((void)0)
+#endif
+
 //! Debug macro to simplify logging an exception, which also prints the exception type
 #define CI_LOG_EXCEPTION( str, exc )	\
 {										\
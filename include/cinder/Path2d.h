@@ -267,24 +267,50 @@ CI_API inline std::ostream& operator<<( std::ostream &out, const Path2d &p )
 }
 
 //! Accelerates the calculation of various operations on Path2d. Useful if doing repeated calculations, otherwise just use Path2d member functions.
+//! An arc-length table is built once at construction, so that queries by distance are O(log n) in the number of segments.
 class CI_API Path2dCalcCache {
   public:
-	Path2dCalcCache( const Path2d &path );
+	//! Constructs a cache for \a path. \a samplesPerCurve sets the resolution of the arc-length table for each quadratic and cubic segment.
+	Path2dCalcCache( const Path2d &path, int samplesPerCurve = 16 );
 	
 	const Path2d&	getPath2d() const { return mPath; }
 	float			getLength() const { return mLength; }
+	//! Returns the arc length of segment \a segment
+	float			getSegmentLength( size_t segment ) const { return mSegmentLengths[segment]; }
 
 	//! Calculates the t-value corresponding to \a relativeTime in the range [0,1) within epsilon of \a tolerance. For example, \a relativeTime of 0.5f returns the t-value corresponding to half the length. \a maxIterations dictates the number of refinement loop iterations allowed, setting an upper bound for worst-case performance.
 	float			calcNormalizedTime( float relativeTime, bool wrap = false, float tolerance = 1.0e-03f, int maxIterations = 16 ) const;
 	//! Calculates a t-value corresponding to arc length \a distance. If \a wrap then the t-value loops inside the 0-1 range as \a distance exceeds the arc length.
 	float			calcTimeForDistance( float distance, bool wrap = false, float tolerance = 1.0e-03f, int maxIterations = 16 ) const;
 	//! Returns the point on the curve at parameter \a t, which lies in the range <tt>[0,1]</tt>
-	vec2			getPosition( float t ) const { return mPath.getPosition( t ); }
+	vec2			getPosition( float t ) const;
+	//! Returns the tangent on the curve at parameter \a t, which lies in the range <tt>[0,1]</tt>
+	vec2			getTangent( float t ) const;
+
+	//! Returns the point on the curve at arc length \a distance. If \a wrap then \a distance loops around the path, otherwise it is clamped to <tt>[0,getLength()]</tt>.
+	vec2			getPositionAtDistance( float distance, bool wrap = false ) const;
+	//! Returns the un-normalized tangent on the curve at arc length \a distance. If \a wrap then \a distance loops around the path, otherwise it is clamped to <tt>[0,getLength()]</tt>.
+	vec2			getTangentAtDistance( float distance, bool wrap = false ) const;
+	//! Samples the curve at each of the \a count arc lengths in \a distances. Positions are written to \a resultPositions and, if not null, un-normalized tangents to \a resultTangents. Both must hold \a count elements. Large batches are sampled in parallel.
+	void			calcPositionsAtDistances( const float *distances, size_t count, vec2 *resultPositions, vec2 *resultTangents = nullptr, bool wrap = false ) const;
 
   private:
-	Path2d				mPath;
-	float				mLength;
-	std::vector<float>	mSegmentLengths;
+	//! Stores into \a segment and \a segmentT the location of arc length \a distance, which must lie in <tt>[0,getLength()]</tt>
+	void			solveDistance( float distance, float tolerance, int maxIterations, size_t *segment, float *segmentT ) const;
+	float			wrapDistance( float distance, bool wrap ) const;
+	vec2			calcSegmentPosition( size_t segment, float t ) const;
+	vec2			calcSegmentTangent( size_t segment, float t ) const;
+
+	Path2d					mPath;
+	float					mLength;
+	int						mSamplesPerCurve;
+	std::vector<float>		mSegmentLengths;
+	//! Arc length at the start of each segment, plus the total length
+	std::vector<float>		mSegmentDistances;
+	std::vector<size_t>		mSegmentFirstPoints;
+	//! Offset of each segment's samples in mArcLengthTable. Curve segments store the arc length at t = i / mSamplesPerCurve for i in <tt>[0,mSamplesPerCurve]</tt>, lines store nothing.
+	std::vector<size_t>		mTableOffsets;
+	std::vector<float>		mArcLengthTable;
 };
 
 class CI_API Path2dExc : public Exception {
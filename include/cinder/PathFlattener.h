@@ -0,0 +1,86 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Path2d.h"
+#include "cinder/Shape2d.h"
+
+#include <vector>
+
+namespace cinder {
+
+//! Flattens Path2d and Shape2d curves into polylines whose distance from the true curve never exceeds a tolerance.
+//! Each curve segment is divided uniformly in t into the fewest pieces its second derivative allows, so flat
+//! curves produce few points and tight ones many. Output accumulates in buffers owned by the PathFlattener, which
+//! keep their capacity across clear(), so re-flattening every frame does not allocate once warmed up.
+//! To flatten for display at a given zoom factor, divide the screen-space tolerance by the zoom.
+class CI_API PathFlattener {
+  public:
+	//! Constructs a PathFlattener with a maximum deviation of \a tolerance between the curve and its polyline.
+	PathFlattener( float tolerance = 0.25f );
+
+	void	setTolerance( float tolerance )		{ mTolerance = tolerance; }
+	float	getTolerance() const				{ return mTolerance; }
+
+	//! Removes all contours, retaining allocated memory.
+	void	clear();
+
+	//! Appends \a path as a single contour.
+	void	flatten( const Path2d &path );
+	//! Appends each contour of \a shape. Contours are flattened in parallel.
+	void	flatten( const Shape2d &shape );
+	//! Appends \a numPaths paths as individual contours. Paths are flattened in parallel.
+	void	flatten( const Path2d *paths, size_t numPaths );
+
+	size_t		getNumContours() const						{ return mContourEnds.size(); }
+	//! Returns a pointer to the first point of contour \a contour
+	const vec2*	getContourPoints( size_t contour ) const	{ return mPoints.data() + getContourBegin( contour ); }
+	size_t		getContourNumPoints( size_t contour ) const	{ return mContourEnds[contour] - getContourBegin( contour ); }
+	//! Returns whether contour \a contour was closed. The closing point is not repeated in the output.
+	bool		isContourClosed( size_t contour ) const		{ return mContourClosed[contour] != 0; }
+
+	//! Returns the points of all contours, stored consecutively.
+	const std::vector<vec2>&		getPoints() const		{ return mPoints; }
+	//! Returns the end offset of each contour into getPoints().
+	const std::vector<uint32_t>&	getContourEnds() const	{ return mContourEnds; }
+
+	//! Returns the number of points flatten() produces for \a path with \a tolerance.
+	static size_t	calcNumPoints( const Path2d &path, float tolerance );
+	//! Writes the flattened \a path into \a result, which must hold calcNumPoints( path, tolerance ) elements. Returns the number of points written.
+	static size_t	flatten( const Path2d &path, float tolerance, vec2 *result );
+	//! Returns the tolerance equivalent to the \a approximationScale of Path2d::subdivide().
+	static float	calcTolerance( float approximationScale )	{ return 0.5f / approximationScale; }
+
+  private:
+	size_t		getContourBegin( size_t contour ) const		{ return contour ? mContourEnds[contour - 1] : 0; }
+
+	float					mTolerance;
+	std::vector<vec2>		mPoints;
+	std::vector<uint32_t>	mContourEnds;
+	std::vector<uint8_t>	mContourClosed;
+	std::vector<size_t>		mScratchOffsets;
+};
+
+} // namespace cinder
@@ -28,6 +28,8 @@
 
 namespace cinder {
 
+class Shape2d;
+
 template<typename T>
 class CI_API PolyLineT {
   public:
@@ -76,6 +78,44 @@ class CI_API PolyLineT {
 	//! Returns the centroid or "center of mass" of the polygon. Assumes closed and no self-intersections.
 	T		calcCentroid() const;
 
+	//! Determines which regions are inside a set of polygons, based on their winding number
+	enum FillRule { FILL_EVEN_ODD, FILL_NONZERO, FILL_POSITIVE, FILL_NEGATIVE };
+	enum BooleanOp { BOOLEAN_UNION, BOOLEAN_INTERSECTION, BOOLEAN_DIFFERENCE, BOOLEAN_XOR };
+	enum JoinType { JOIN_MITER, JOIN_ROUND, JOIN_SQUARE };
+
+	//! Calculates the boolean \a op of the polygons \a a and \a b, which are treated as closed. The resulting outer contours are counterclockwise and holes are clockwise.
+	static std::vector<PolyLineT>	calcBoolean( BooleanOp op, const std::vector<PolyLineT> &a, const std::vector<PolyLineT> &b, FillRule fillRule = FILL_NONZERO );
+	//! Calculates the boolean \a op of each polygon set in \a subjects with \a clip, in parallel. Element \a i of the result corresponds to \a subjects[i].
+	static std::vector<std::vector<PolyLineT>>	calcBoolean( BooleanOp op, const std::vector<std::vector<PolyLineT>> &subjects, const std::vector<PolyLineT> &clip, FillRule fillRule = FILL_NONZERO );
+	//! Calculates the boolean union of \a a and \a b.
+	static std::vector<PolyLineT>	calcUnion( const std::vector<PolyLineT> &a, const std::vector<PolyLineT> &b, FillRule fillRule = FILL_NONZERO ) { return calcBoolean( BOOLEAN_UNION, a, b, fillRule ); }
+	//! Resolves the overlaps and self-intersections of \a polygons into non-intersecting contours.
+	static std::vector<PolyLineT>	calcUnion( const std::vector<PolyLineT> &polygons, FillRule fillRule = FILL_NONZERO ) { return calcBoolean( BOOLEAN_UNION, polygons, std::vector<PolyLineT>(), fillRule ); }
+	//! Calculates the boolean intersection of \a a and \a b.
+	static std::vector<PolyLineT>	calcIntersection( const std::vector<PolyLineT> &a, const std::vector<PolyLineT> &b, FillRule fillRule = FILL_NONZERO ) { return calcBoolean( BOOLEAN_INTERSECTION, a, b, fillRule ); }
+	//! Calculates the boolean difference of \a subject and \a clip.
+	static std::vector<PolyLineT>	calcDifference( const std::vector<PolyLineT> &subject, const std::vector<PolyLineT> &clip, FillRule fillRule = FILL_NONZERO ) { return calcBoolean( BOOLEAN_DIFFERENCE, subject, clip, fillRule ); }
+	//! Calculates the boolean XOR of \a a and \a b.
+	static std::vector<PolyLineT>	calcXor( const std::vector<PolyLineT> &a, const std::vector<PolyLineT> &b, FillRule fillRule = FILL_NONZERO ) { return calcBoolean( BOOLEAN_XOR, a, b, fillRule ); }
+	//! Calculates the outline of \a polygons grown by \a delta, or shrunk for negative \a delta. Outer contours and holes must have opposite orientations, as returned by calcBoolean(); if the outers are clockwise, so is the result.
+	//! Corners are joined according to \a joinType. Miters longer than \a miterLimit times \a delta are squared off, and round joins deviate from a true arc by at most \a arcTolerance.
+	static std::vector<PolyLineT>	calcOffset( const std::vector<PolyLineT> &polygons, double delta, JoinType joinType = JOIN_ROUND, double miterLimit = 2, double arcTolerance = 0.25 );
+
+	//! Calculates the boolean \a op of the shapes \a a and \a b, whose curves are first flattened into polygons deviating from them by at most \a tolerance.
+	static std::vector<PolyLineT>	calcBoolean( BooleanOp op, const Shape2d &a, const Shape2d &b, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f );
+	//! Calculates the boolean union of the shapes \a a and \a b, flattened to within \a tolerance.
+	static std::vector<PolyLineT>	calcUnion( const Shape2d &a, const Shape2d &b, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f ) { return calcBoolean( BOOLEAN_UNION, a, b, fillRule, tolerance ); }
+	//! Resolves the overlaps and self-intersections of the contours of \a shape, flattened to within \a tolerance, into non-intersecting contours.
+	static std::vector<PolyLineT>	calcUnion( const Shape2d &shape, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f );
+	//! Calculates the boolean intersection of the shapes \a a and \a b, flattened to within \a tolerance.
+	static std::vector<PolyLineT>	calcIntersection( const Shape2d &a, const Shape2d &b, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f ) { return calcBoolean( BOOLEAN_INTERSECTION, a, b, fillRule, tolerance ); }
+	//! Calculates the boolean difference of the shapes \a subject and \a clip, flattened to within \a tolerance.
+	static std::vector<PolyLineT>	calcDifference( const Shape2d &subject, const Shape2d &clip, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f ) { return calcBoolean( BOOLEAN_DIFFERENCE, subject, clip, fillRule, tolerance ); }
+	//! Calculates the boolean XOR of the shapes \a a and \a b, flattened to within \a tolerance.
+	static std::vector<PolyLineT>	calcXor( const Shape2d &a, const Shape2d &b, FillRule fillRule = FILL_NONZERO, float tolerance = 0.25f ) { return calcBoolean( BOOLEAN_XOR, a, b, fillRule, tolerance ); }
+	//! Calculates the outline of \a shape grown by \a delta, after flattening its curves to within \a tolerance. Parameters otherwise match the polygon variant.
+	static std::vector<PolyLineT>	calcOffset( const Shape2d &shape, double delta, JoinType joinType = JOIN_ROUND, double miterLimit = 2, double arcTolerance = 0.25, float tolerance = 0.25f );
+
 	friend CI_API std::ostream& operator<<( std::ostream& lhs, const PolyLineT& rhs )
 	{
 		lhs << "(";
@@ -30,16 +30,23 @@
 #include "cinder/Noncopyable.h"
 #include "cinder/Export.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
-#include <map>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace cinder { namespace signals {
 
 namespace detail {
 
-//! Base class for signal links, which manages reference counting and provides a concrete type to be passed to Connection
+//! Signal link, which manages reference counting and the enabled state, and provides a concrete type to be passed to Connection
 struct SignalLinkBase {
   public:
 	SignalLinkBase()
@@ -50,8 +57,6 @@ struct SignalLinkBase {
 		CI_ASSERT( mRefCount == 0 );
 	}
 
-	virtual bool removeSibling( SignalLinkBase *link ) = 0;
-
 	void incrRef()
 	{
 		mRefCount++;
@@ -74,22 +79,22 @@ struct SignalLinkBase {
 
 	void enable()
 	{
-		mEnabled = true;
+		mEnabled.store( true, std::memory_order_relaxed );
 	}
 
 	void disable()
 	{
-		mEnabled = false;
+		mEnabled.store( false, std::memory_order_relaxed );
 	}
 
 	bool isEnabled() const
 	{
-		return mEnabled;
+		return mEnabled.load( std::memory_order_relaxed );
 	}
 
   private:
-	int		mRefCount;
-	bool	mEnabled;
+	int					mRefCount;
+	std::atomic<bool>	mEnabled; // atomic as ConcurrentSignal's connections may be toggled from any thread
 };
 
 //! Base Signal class, which provides a concrete type that can be stored by the Disconnector
@@ -217,9 +222,10 @@ struct CollectorDefault<void> {
 
 //! CollectorInvocation specialisation for regular signals.
 template<class Collector, class R, class... Args>
-struct CollectorInvocation<Collector, R ( Args... )> : public SignalBase {
+struct CollectorInvocation<Collector, R ( Args... )> {
 
-	bool invoke( Collector &collector, const std::function<R ( Args... )> &callback, Args... args )
+	template<typename Callback>
+	static bool invoke( Collector &collector, const Callback &callback, Args... args )
 	{
 		return collector( callback( args... ) );
 	}
@@ -227,22 +233,142 @@ struct CollectorInvocation<Collector, R ( Args... )> : public SignalBase {
 
 //! CollectorInvocation specialisation for signals with void return type.
 template<class Collector, class... Args>
-struct CollectorInvocation<Collector, void( Args... )> : public SignalBase {
+struct CollectorInvocation<Collector, void( Args... )> {
 
-	bool invoke( Collector &collector, const std::function<void( Args... )> &callback, Args... args )
+	template<typename Callback>
+	static bool invoke( Collector &collector, const Callback &callback, Args... args )
 	{
 		callback( args... );
 		return collector();
 	}
 };
 
+// ----------------------------------------------------------------------------------------------------
+// SlotCallback
+// ----------------------------------------------------------------------------------------------------
+
+//! Move-only type-erased callable, which stores callables of up to INLINE_SIZE bytes without allocating.
+template<typename> class	SlotCallback;   // undefined
+
+template<class R, class... Args>
+class SlotCallback<R ( Args... )> {
+  public:
+	//! Callables up to this size, which are nothrow movable, are stored inline. Large enough for a std::function or a lambda with a few captures.
+	static const size_t INLINE_SIZE = 4 * sizeof( void* );
+
+	template<typename F>
+	explicit SlotCallback( F &&callable )
+	{
+		typedef typename std::decay<F>::type Callable;
+		construct<Callable>( std::forward<F>( callable ), std::integral_constant<bool, isStoredInline<Callable>()>() );
+	}
+
+	SlotCallback( SlotCallback &&other ) noexcept
+		: mInvoke( other.mInvoke ), mManage( other.mManage )
+	{
+		mManage( MOVE, &other.mStorage, &mStorage );
+		other.mManage = nullptr;
+	}
+
+	SlotCallback& operator=( SlotCallback &&rhs ) noexcept
+	{
+		if( this != &rhs ) {
+			reset();
+			mInvoke = rhs.mInvoke;
+			mManage = rhs.mManage;
+			mManage( MOVE, &rhs.mStorage, &mStorage );
+			rhs.mManage = nullptr;
+		}
+		return *this;
+	}
+
+	~SlotCallback()
+	{
+		reset();
+	}
+
+	R operator()( Args... args ) const
+	{
+		return mInvoke( &mStorage, std::forward<Args>( args )... );
+	}
+
+	//! Returns whether \a callable is an empty std::function or a null function pointer, which SlotCallback does not store.
+	template<typename F>
+	static bool isEmpty( const F &/*callable*/ )					{ return false; }
+	template<typename Signature>
+	static bool isEmpty( const std::function<Signature> &callable )	{ return ! callable; }
+	template<typename T>
+	static bool isEmpty( T *callable )							{ return ! callable; }
+
+  private:
+	enum Operation { MOVE, DESTROY };
+
+	template<typename Callable>
+	static constexpr bool isStoredInline()
+	{
+		return sizeof( Callable ) <= INLINE_SIZE && alignof( std::max_align_t ) % alignof( Callable ) == 0 && std::is_nothrow_move_constructible<Callable>::value;
+	}
+
+	template<typename Callable, typename F>
+	void construct( F &&callable, std::true_type /*inline*/ )
+	{
+		new( &mStorage ) Callable( std::forward<F>( callable ) );
+		mInvoke = []( void *storage, Args... args ) -> R {
+			return static_cast<R>( ( *static_cast<Callable*>( storage ) )( std::forward<Args>( args )... ) );
+		};
+		mManage = []( Operation operation, void *storage, void *destination ) {
+			Callable *callable = static_cast<Callable*>( storage );
+			if( operation == MOVE )
+				new( destination ) Callable( std::move( *callable ) );
+			callable->~Callable();
+		};
+	}
+
+	template<typename Callable, typename F>
+	void construct( F &&callable, std::false_type /*inline*/ )
+	{
+		*reinterpret_cast<Callable**>( &mStorage ) = new Callable( std::forward<F>( callable ) );
+		mInvoke = []( void *storage, Args... args ) -> R {
+			return static_cast<R>( ( **static_cast<Callable**>( storage ) )( std::forward<Args>( args )... ) );
+		};
+		mManage = []( Operation operation, void *storage, void *destination ) {
+			Callable **callable = static_cast<Callable**>( storage );
+			if( operation == MOVE )
+				*static_cast<Callable**>( destination ) = *callable;
+			else
+				delete *callable;
+		};
+	}
+
+	void reset()
+	{
+		if( mManage ) {
+			mManage( DESTROY, &mStorage, nullptr );
+			mManage = nullptr;
+		}
+	}
+
+	typedef R	(*InvokeFn)( void *storage, Args... args );
+	typedef void	(*ManageFn)( Operation operation, void *storage, void *destination );
+
+	alignas( std::max_align_t ) mutable unsigned char	mStorage[INLINE_SIZE];
+	InvokeFn	mInvoke;
+	ManageFn	mManage; // null once moved from
+};
+
 // ----------------------------------------------------------------------------------------------------
 // SignalProto
 // ----------------------------------------------------------------------------------------------------
 
 //! SignalProto template, the parent class of Signal, specialised for the callback signature and collector.
+//!
+//! Slots are stored in a single vector sorted by descending priority, and in order of connection within a priority, so emission
+//! neither allocates nor follows links. Each Slot is allocated separately, so the callable being invoked never moves. A connection
+//! made during an emission is inserted right away and shifts the position of every running emission past it when it lands before
+//! them, so it is invoked by the same emission only when it sorts after the current slot. Disconnections during an emission only
+//! mark their slot, which is removed once the outermost emission returns.
 template<class Collector, class R, class... Args>
-class SignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collector, R ( Args... )> {
+class SignalProto<R ( Args... ), Collector> : public SignalBase {
   protected:
 	typedef std::function<R ( Args... )>		CallbackFn;
 	typedef typename CallbackFn::result_type	Result;
@@ -251,37 +377,33 @@ class SignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collec
   public:
 	//! Constructs an empty SignalProto
 	SignalProto()
-		: mDisconnector( new Disconnector( this ) )
+		: mNumSlots( 0 ), mEmitScopes( nullptr ), mCompactionNeeded( false ), mDisconnector( new Disconnector( this ) )
 	{}
 
 	//! Destructor releases all resources associated with this signal.
 	~SignalProto()
 	{
-		for( auto &lp : mLinks ) {
-			SignalLink *link = lp.second;
-			if( link ) {
-				while( link->mNext != link )
-					link->mNext->unlink();
-
-				CI_ASSERT( link->getRefCount() >= 2 );
-
-				link->decrRef();
-				link->decrRef();
-			}
-		}
+		for( auto &slot : mSlots )
+			slot->mLink->decrRef();
 	}
 
 	//! Connects \a callback to the signal, assigned to the default priority group (priority = 0). \return a Connection, which can be used to disconnect this callback slot.
-	Connection connect( const CallbackFn &callback )
+	template<typename F>
+	Connection connect( F &&callback )
 	{
-		return connect( 0, callback );
+		return connect( 0, std::forward<F>( callback ) );
 	}
 
 	//! Connects \a callback to the signal, assigned to the priority group \a priority. \return a Connection, which can be used to disconnect this callback slot.
-	Connection connect( int priority, const CallbackFn &callback )
+	template<typename F>
+	Connection connect( int priority, F &&callback )
 	{
-		auto head = ensureLinkGroup( priority );
-		auto link = head->addBefore( callback );
+		if( Callback::isEmpty( callback ) )
+			return Connection();
+
+		SignalLinkBase *link = new SignalLinkBase;
+		insertSlot( std::unique_ptr<Slot>( new Slot( std::forward<F>( callback ), link, priority ) ) );
+		++mNumSlots;
 		return Connection( mDisconnector, link, priority );
 	}
 
@@ -296,145 +418,363 @@ class SignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collec
 	//! Emit a signal, i.e. invoke all its callbacks and collect return types with \a collector.
 	void emit( Collector &collector, Args... args )
 	{
-		bool continueEmission = true;
-		for( auto &lp : mLinks ) {
-			SignalLink *link = lp.second;
-			link->incrRef();
-			do {
-				if( link->mCallbackFn && link->isEnabled() ) {
-					continueEmission = this->invoke( collector, link->mCallbackFn, args... );
-					if( ! continueEmission ) {
-						break;
-					}
-				}
-
-				SignalLink *old = link;
-				link = old->mNext;
-
-				link->incrRef();
-				old->decrRef();
+		// slots may be inserted by the callbacks, which keep scope.mIndex pointing at the current slot
+		for( EmitScope scope( this ); scope.mIndex < mSlots.size(); ++scope.mIndex ) {
+			const Slot &slot = *mSlots[scope.mIndex];
+			if( slot.mConnected && slot.mLink->isEnabled() ) {
+				if( ! CollectorInvocation<Collector, R ( Args... )>::invoke( collector, slot.mCallback, args... ) )
+					break;
 			}
-			while( link != lp.second );
-			
-			link->decrRef();
-
-			if( ! continueEmission )
-				break;
 		}
 	}
 
 	//! Returns the number of connected slots.
 	size_t getNumSlots() const
 	{
-		size_t count = 0;
-
-		for( auto &lp : mLinks ) {
-			SignalLink *link = lp.second;
-			do {
-				if( link->mCallbackFn )
-					count++;
-
-				SignalLink *old = link;
-				link = old->mNext;
-			}
-			while( link != lp.second );
-		}
-
-		return count;
+		return mNumSlots;
 	}
 
   private:
+	typedef SlotCallback<R ( Args... )>	Callback;
 
-	//! implements a doubly-linked ring with ref-counted nodes containing the signal handlers.
-	struct SignalLink : public SignalLinkBase {
-		explicit SignalLink( const CallbackFn &callback )
-			: mNext( nullptr ), mPrev( nullptr ), mCallbackFn( callback )
+	struct Slot {
+		template<typename F>
+		Slot( F &&callback, SignalLinkBase *link, int priority )
+			: mCallback( std::forward<F>( callback ) ), mLink( link ), mPriority( priority ), mConnected( true )
 		{}
 
-		void unlink()
+		Callback		mCallback;
+		SignalLinkBase	*mLink; // owned, holds the enabled state toggled through Connection
+		int				mPriority;
+		bool			mConnected; // false once disconnected during an emission, until the slot is removed
+	};
+
+	//! A running emission, linked to the emissions it is nested in
+	struct EmitScope {
+		EmitScope( SignalProto *signal )
+			: mSignal( signal ), mIndex( 0 ), mOuter( signal->mEmitScopes )
 		{
-			mCallbackFn = nullptr;
-			if( mNext )
-				mNext->mPrev = mPrev;
-			if( mPrev )
-				mPrev->mNext = mNext;
-
-			decrRef();
-			// leave intact ->mNext, ->mPrev for stale iterators
+			mSignal->mEmitScopes = this;
 		}
 
-		SignalLink* addBefore( const CallbackFn &callback )
+		~EmitScope()
 		{
-			SignalLink *link = new SignalLink( callback );
+			mSignal->mEmitScopes = mOuter;
+			if( ! mOuter && mSignal->mCompactionNeeded )
+				mSignal->compact();
+		}
 
-			link->mPrev = mPrev; // link to last
-			link->mNext = this;
-			mPrev->mNext = link; // link from last
-			mPrev = link;
+		SignalProto	*mSignal;
+		size_t		mIndex; // of the slot being invoked
+		EmitScope	*mOuter;
+	};
 
-			return link;
+	//! inserts \a slot after every slot of the same or greater priority
+	void insertSlot( std::unique_ptr<Slot> &&slot )
+	{
+		const int priority = slot->mPriority;
+		auto position = std::find_if( mSlots.begin(), mSlots.end(), [priority]( const std::unique_ptr<Slot> &other ) { return other->mPriority < priority; } );
+		const size_t index = position - mSlots.begin();
+		mSlots.insert( position, std::move( slot ) );
+		for( EmitScope *scope = mEmitScopes; scope; scope = scope->mOuter ) {
+			if( scope->mIndex >= index )
+				++scope->mIndex;
 		}
+	}
 
-		bool deactivate( const CallbackFn &callback )
-		{
-			if( callback == mCallbackFn ) {
-				mCallbackFn = nullptr;	// deactivate static head
+	//! removes slots disconnected during emissions
+	void compact()
+	{
+		mCompactionNeeded = false;
+		auto end = std::remove_if( mSlots.begin(), mSlots.end(), []( const std::unique_ptr<Slot> &slot ) {
+			if( slot->mConnected )
+				return false;
+			slot->mLink->decrRef();
+			return true;
+		} );
+		mSlots.erase( end, mSlots.end() );
+	}
+
+	bool disconnect( SignalLinkBase *link, int /*priority*/ ) override
+	{
+		for( auto it = mSlots.begin(); it != mSlots.end(); ++it ) {
+			if( (*it)->mLink == link ) {
+				if( ! (*it)->mConnected )
+					return false;
+
+				if( mEmitScopes ) {
+					(*it)->mConnected = false;
+					mCompactionNeeded = true;
+				}
+				else {
+					link->decrRef();
+					mSlots.erase( it );
+				}
+				--mNumSlots;
 				return true;
 			}
+		}
 
-			for( SignalLink *link = this->mNext ? this->mNext : this; link != this; link = link->mNext ) {
-				if( callback == link->function ) {
-					link->unlink();		// deactivate and unlink sibling
-					return true;
-				}
+		return false;
+	}
+
+	std::vector<std::unique_ptr<Slot>>	mSlots;
+	size_t							mNumSlots;			// slots in mSlots which are still connected
+	EmitScope						*mEmitScopes;		// innermost running emission, or null
+	bool							mCompactionNeeded;
+	std::shared_ptr<Disconnector>	mDisconnector;		// Connection holds a weak_ptr to this to make disconnections.
+};
+
+// ----------------------------------------------------------------------------------------------------
+// ConcurrentSignalProto
+// ----------------------------------------------------------------------------------------------------
+
+//! The non-template part of ConcurrentSignal: reclamation of slot lists once no emission can be reading them, and scheduling of deferred emissions.
+//!
+//! Emissions register in one of two reader groups, chosen by the parity of an epoch. A writer replacing the slot list retires the old
+//! list tagged with the current epoch, and advances the epoch whenever the previous epoch's group has no readers left. Once the
+//! epoch has advanced twice past a retired list, every emission which could have been reading it has finished.
+class CI_API ConcurrentSignalBase : public SignalBase {
+  public:
+	//! Emits every queued deferred emission of every ConcurrentSignal. Returns the number of emissions.
+	static size_t	emitDeferred();
+
+  protected:
+	//! An immutable, published list of slots
+	struct Snapshot {
+		virtual ~Snapshot() {}
+	};
+
+	ConcurrentSignalBase();
+	~ConcurrentSignalBase();
+
+	//! Registers an emission as a reader, returning the group to pass to endRead()
+	size_t beginRead()
+	{
+		while( true ) {
+			const size_t epoch = mEpoch.load();
+			mReaders[epoch & 1].fetch_add( 1 );
+			// the epoch only changes when a concurrent writer advances it
+			if( mEpoch.load() == epoch )
+				return epoch & 1;
+			mReaders[epoch & 1].fetch_sub( 1 );
+		}
+	}
+
+	void endRead( size_t group )
+	{
+		mReaders[group].fetch_sub( 1 );
+	}
+
+	//! Takes ownership of \a snapshot, which has just been replaced, and frees it once no emission can be reading it. Requires mWriteMutex.
+	void	retire( Snapshot *snapshot );
+	//! Frees every retired snapshot. Only valid once no emission can be running.
+	void	freeRetired();
+
+	//! Queues this signal to be emitted by the next call to emitDeferred()
+	void	scheduleDeferred();
+	//! Removes this signal from the deferred queue, waiting for an emitDeferred() which is emitting it on another thread. Called by subclass destructors.
+	void	cancelDeferred();
+	//! Emits this signal's queued deferred emissions, returning their number
+	virtual size_t	emitQueued() = 0;
+
+	std::mutex		mWriteMutex; // serializes modifications of the slot list
+
+  private:
+	std::atomic<size_t>		mEpoch;
+	std::atomic<size_t>		mReaders[2];
+	std::vector<std::pair<Snapshot*, size_t>>	mRetired; // with the epoch during which each was replaced
+	bool					mDeferredScheduled; // guarded by the deferred queue's mutex
+};
+
+//! The template implementation of ConcurrentSignal.
+template<typename, typename> class	ConcurrentSignalProto;   // undefined
+
+template<class Collector, class R, class... Args>
+class ConcurrentSignalProto<R ( Args... ), Collector> : public ConcurrentSignalBase {
+  protected:
+	typedef std::function<R ( Args... )>		CallbackFn;
+	typedef typename Collector::CollectorResult	CollectorResult;
+
+  public:
+	//! Constructs an empty ConcurrentSignalProto
+	ConcurrentSignalProto()
+		: mSlots( new Slots ), mDisconnector( new Disconnector( this ) )
+	{}
+
+	//! Destructor releases all resources associated with this signal. Must not run concurrently with any other method.
+	~ConcurrentSignalProto()
+	{
+		cancelDeferred();
+
+		Slots *slots = mSlots.load();
+		for( Slot *slot : slots->mSlots ) {
+			slot->mConnected.store( false );
+			slot->decrRef();
+		}
+		delete slots;
+		freeRetired();
+	}
+
+	//! Connects \a callback to the signal, assigned to the default priority group (priority = 0). \return a Connection, which can be used to disconnect this callback slot.
+	template<typename F>
+	Connection connect( F &&callback )
+	{
+		return connect( 0, std::forward<F>( callback ) );
+	}
+
+	//! Connects \a callback to the signal, assigned to the priority group \a priority. \return a Connection, which can be used to disconnect this callback slot.
+	template<typename F>
+	Connection connect( int priority, F &&callback )
+	{
+		if( Callback::isEmpty( callback ) )
+			return Connection();
+
+		Slot *slot = new Slot( std::forward<F>( callback ), priority );
+
+		std::lock_guard<std::mutex> lock( mWriteMutex );
+		const Slots *oldSlots = mSlots.load();
+		// slots are sorted by descending priority, and in order of connection within a priority
+		auto position = std::find_if( oldSlots->mSlots.begin(), oldSlots->mSlots.end(), [priority]( const Slot *other ) { return other->mPriority < priority; } );
+		Slots *slots = new Slots;
+		slots->mSlots.reserve( oldSlots->mSlots.size() + 1 );
+		slots->mSlots.insert( slots->mSlots.end(), oldSlots->mSlots.begin(), position );
+		slots->mSlots.push_back( slot );
+		slots->mSlots.insert( slots->mSlots.end(), position, oldSlots->mSlots.end() );
+		publish( slots );
+
+		return Connection( mDisconnector, slot, priority );
+	}
+
+	//! Emit a signal, i.e. invoke all its callbacks and collect return types with Collector. \return the CollectorResult from the collector.
+	CollectorResult	emit( Args... args )
+	{
+		Collector collector;
+		emit( collector, args... );
+		return collector.getResult();
+	}
+
+	//! Emit a signal, i.e. invoke all its callbacks and collect return types with \a collector. Never blocks, and may run on several threads at once.
+	void emit( Collector &collector, Args... args )
+	{
+		ReadScope scope( this );
+		for( const Slot *slot : mSlots.load()->mSlots ) {
+			// slots disconnected during the emission are skipped, although they are still in the snapshot
+			if( slot->mConnected.load( std::memory_order_relaxed ) && slot->isEnabled() ) {
+				if( ! CollectorInvocation<Collector, R ( Args... )>::invoke( collector, slot->mCallback, args... ) )
+					break;
 			}
-			return false;
 		}
+	}
 
-		bool removeSibling( SignalLinkBase *sibling ) override
+	//! Queues an emission with copies of \a args, which happens on the thread calling signals::emitDeferred(). Apps call it on the main thread before each update.
+	void emitDeferred( Args... args )
+	{
 		{
-			for( SignalLink *link = this->mNext ? this->mNext : this; link != this; link = link->mNext ) {
-				if( sibling == link ) {
-					link->unlink();		// deactivate and unlink sibling
-					return true;
-				}
-			}
-			return false;
+			std::lock_guard<std::mutex> lock( mDeferredMutex );
+			mDeferred.emplace_back( args... );
+		}
+		scheduleDeferred();
+	}
+
+	//! Returns the number of connected slots.
+	size_t getNumSlots() const
+	{
+		ReadScope scope( const_cast<ConcurrentSignalProto*>( this ) );
+		return mSlots.load()->mSlots.size();
+	}
+
+  private:
+	typedef SlotCallback<R ( Args... )>	Callback;
+
+	struct Slot : public SignalLinkBase {
+		template<typename F>
+		Slot( F &&callback, int priority )
+			: mCallback( std::forward<F>( callback ) ), mPriority( priority ), mConnected( true )
+		{}
+
+		Callback			mCallback;
+		int					mPriority;
+		std::atomic<bool>	mConnected;
+	};
+
+	// Each Slots holds a reference to its slots, in addition to the reference held while a slot is connected. References are only
+	// changed while holding mWriteMutex, or by the destructor.
+	struct Slots : public Snapshot {
+		~Slots()
+		{
+			for( Slot *slot : mSlots )
+				slot->decrRef();
 		}
 
-		SignalLink*		mNext;
-		SignalLink*		mPrev;
-		CallbackFn		mCallbackFn;
+		std::vector<Slot*>	mSlots;
+	};
+
+	struct ReadScope {
+		ReadScope( ConcurrentSignalProto *signal )
+			: mSignal( signal ), mGroup( signal->beginRead() )
+		{}
+		~ReadScope()	{ mSignal->endRead( mGroup ); }
+
+		ConcurrentSignalProto	*mSignal;
+		size_t					mGroup;
 	};
 
-	bool disconnect( SignalLinkBase *link, int priority ) override
+	typedef std::tuple<typename std::decay<Args>::type...>	ArgsTuple;
+
+	// publishes 'slots' in place of the current list; requires mWriteMutex
+	void publish( Slots *slots )
 	{
-		auto it = mLinks.find( priority );
-		if( it == mLinks.end() )
+		for( Slot *slot : slots->mSlots )
+			slot->incrRef();
+		retire( mSlots.exchange( slots ) );
+	}
+
+	bool disconnect( SignalLinkBase *link, int /*priority*/ ) override
+	{
+		std::lock_guard<std::mutex> lock( mWriteMutex );
+		const Slots *oldSlots = mSlots.load();
+		auto it = std::find( oldSlots->mSlots.begin(), oldSlots->mSlots.end(), link );
+		if( it == oldSlots->mSlots.end() )
 			return false;
 
-		return it->second->removeSibling( link );
+		Slot *slot = *it;
+		slot->mConnected.store( false );
+
+		Slots *slots = new Slots;
+		slots->mSlots.reserve( oldSlots->mSlots.size() - 1 );
+		slots->mSlots.insert( slots->mSlots.end(), oldSlots->mSlots.begin(), it );
+		slots->mSlots.insert( slots->mSlots.end(), it + 1, oldSlots->mSlots.end() );
+		publish( slots );
+		slot->decrRef();
+
+		return true;
 	}
 
-	//! returns the head link for this priority group
-	SignalLink* ensureLinkGroup( int priority )
+	size_t emitQueued() override
 	{
-		auto it = mLinks.find( priority );
-		if( it != mLinks.end() )
-			return it->second;
-		else {
-			auto head = new SignalLink( CallbackFn() ); // ref count = 1
-			head->incrRef(); // ref count = 2, head of ring, can be deactivated but not removed
-			head->mNext = head; // ring head initialization
-			head->mPrev = head; // ring tail initialization
-
-			mLinks.insert( { priority, head } );
-			return head;
+		std::vector<ArgsTuple> queued;
+		{
+			std::lock_guard<std::mutex> lock( mDeferredMutex );
+			queued.swap( mDeferred );
 		}
+
+		for( auto &args : queued )
+			emitTuple( args, std::index_sequence_for<Args...>() );
+
+		return queued.size();
 	}
 
-	std::map<int, SignalLink*, std::greater<int> >	mLinks;			// groups of callback nodes, which are stored in a reference counted linked list. Each group represents priority, greater int means fires first.
-	std::shared_ptr<Disconnector>					mDisconnector;	// Connection holds a weak_ptr to this to make disconnections.
+	template<size_t... Indices>
+	void emitTuple( ArgsTuple &args, std::index_sequence<Indices...> )
+	{
+		emit( std::get<Indices>( args )... );
+	}
+
+	std::atomic<Slots*>				mSlots;
+	std::shared_ptr<Disconnector>	mDisconnector;	// Connection holds a weak_ptr to this to make disconnections.
+	std::vector<ArgsTuple>			mDeferred;		// queued by emitDeferred()
+	std::mutex						mDeferredMutex;
 };
 
 } // cinder::detail
@@ -467,7 +807,11 @@ class SignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collec
 //! of scope.
 //!
 //! The signal implementation is safe against recursion, so callbacks may be connected and disconnected
-//! during a signal emission. Recursive emit() calls are also safe.
+//! during a signal emission. Recursive emit() calls are also safe. Callbacks connected during an emission
+//! are first called by the next emission.
+//!
+//! Callables of up to detail::SlotCallback::INLINE_SIZE bytes are stored without allocating, and emission
+//! itself never allocates.
 //!
 //! \note Signals are non-copyable.
 template <typename Signature, class Collector = detail::CollectorDefault<typename std::function<Signature>::result_type> >
@@ -477,6 +821,34 @@ struct Signal : detail::SignalProto<Signature, Collector> {
 	typedef typename SignalProto::CallbackFn			CallbackFn;
 };
 
+// ----------------------------------------------------------------------------------------------------
+// ConcurrentSignal
+// ----------------------------------------------------------------------------------------------------
+
+//! \brief ConcurrentSignal is a Signal which may be emitted, connected to and disconnected from on any thread.
+//!
+//! Connecting and disconnecting publish a new, immutable list of slots, while emit() iterates whichever list was current when it
+//! began, without locking or allocating. Lists are freed once no emission can still be reading them. As a consequence, a callback
+//! may still be called by an emission that began on another thread before disconnect() returned, and callbacks must be thread-safe.
+//!
+//! emitDeferred() instead queues an emission, which signals::emitDeferred() performs later on the thread calling it. Apps call
+//! signals::emitDeferred() on the main thread before each update, so worker threads can notify the main thread without queues of their own.
+//!
+//! Priority groups, Connections and collectors work as with Signal. Destroying a ConcurrentSignal must not race with its other methods.
+template <typename Signature, class Collector = detail::CollectorDefault<typename std::function<Signature>::result_type> >
+struct ConcurrentSignal : detail::ConcurrentSignalProto<Signature, Collector> {
+
+	typedef detail::ConcurrentSignalProto<Signature, Collector>	SignalProto;
+	typedef typename SignalProto::CallbackFn					CallbackFn;
+};
+
+//! Performs every emission queued with ConcurrentSignal::emitDeferred(), on the calling thread. Returns the number of emissions.
+//! Apps call this on the main thread before each update. Must not be called from several threads at once.
+inline size_t emitDeferred()
+{
+	return detail::ConcurrentSignalBase::emitDeferred();
+}
+
 // ----------------------------------------------------------------------------------------------------
 // slot
 // ----------------------------------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Area.h"
+
+#include <vector>
+
+namespace cinder {
+
+//! Packs rectangles one at a time into a fixed-size area, as when adding glyphs to a texture atlas.
+//! The packer tracks only the skyline, the top edge of the packed region, and places each rectangle where it
+//! leaves the skyline lowest. Space is reclaimed only by clear(), so caches typically recycle whole packers.
+class CI_API SkylinePacker {
+  public:
+	//! Constructs an empty packer of \a size.
+	SkylinePacker( const ivec2 &size = ivec2( 0 ) );
+
+	//! Finds room for a rectangle of \a size. Returns the Area it occupies, or an empty Area if it does not fit.
+	Area	insert( const ivec2 &size );
+	//! Removes all rectangles.
+	void	clear();
+
+	const ivec2&	getSize() const		{ return mSize; }
+	//! Returns the fraction of the packer's area occupied by rectangles, in the range [0,1].
+	float			getOccupancy() const;
+
+  private:
+	// a horizontal segment of the skyline; segments are sorted by mX and span the packer's width
+	struct Segment {
+		int32_t		mX, mY, mWidth;
+	};
+
+	// returns the y at which a rectangle of 'size' rests when its left edge is at segment 'index', or -1 if it does not fit there
+	int32_t		calcFit( size_t index, const ivec2 &size ) const;
+
+	ivec2					mSize;
+	std::vector<Segment>	mSkyline;
+	int64_t					mUsedArea;
+};
+
+} // namespace cinder
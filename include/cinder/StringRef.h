@@ -0,0 +1,82 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+
+#include <cstring>
+#include <ostream>
+#include <string>
+#if defined( __cplusplus ) && __cplusplus >= 201703L
+	#include <string_view>
+#endif
+
+namespace cinder {
+
+//! Refers to a range of characters owned by something else, such as a substring of a parsed document, without copying them.
+//! The characters are not null-terminated, and the StringRef is only valid while its owner is.
+class StringRef {
+  public:
+	StringRef() : mData( nullptr ), mSize( 0 ) {}
+	StringRef( const char *data, size_t size ) : mData( data ), mSize( size ) {}
+	StringRef( const char *str ) : mData( str ), mSize( str ? strlen( str ) : 0 ) {}
+	StringRef( const std::string &str ) : mData( str.data() ), mSize( str.size() ) {}
+#if defined( __cplusplus ) && __cplusplus >= 201703L
+	StringRef( std::string_view str ) : mData( str.data() ), mSize( str.size() ) {}
+	operator std::string_view() const		{ return std::string_view( mData, mSize ); }
+#endif
+
+	const char*	data() const				{ return mData; }
+	size_t		size() const				{ return mSize; }
+	bool		empty() const				{ return mSize == 0; }
+	const char*	begin() const				{ return mData; }
+	const char*	end() const					{ return mData + mSize; }
+	char		operator[]( size_t i ) const	{ return mData[i]; }
+
+	//! Returns a copy of the characters as a std::string.
+	std::string	str() const					{ return std::string( mData, mSize ); }
+
+	//! Returns a negative value, zero or a positive value when this sorts before, equal to or after \a rhs, comparing bytes.
+	int compare( const StringRef &rhs ) const
+	{
+		int result = ( mSize && rhs.mSize ) ? memcmp( mData, rhs.mData, mSize < rhs.mSize ? mSize : rhs.mSize ) : 0;
+		return result ? result : ( mSize < rhs.mSize ? -1 : ( mSize > rhs.mSize ? 1 : 0 ) );
+	}
+
+  private:
+	const char	*mData;
+	size_t		mSize;
+};
+
+inline bool operator==( const StringRef &lhs, const StringRef &rhs )	{ return lhs.size() == rhs.size() && ( lhs.empty() || memcmp( lhs.data(), rhs.data(), lhs.size() ) == 0 ); }
+inline bool operator!=( const StringRef &lhs, const StringRef &rhs )	{ return ! ( lhs == rhs ); }
+inline bool operator<( const StringRef &lhs, const StringRef &rhs )		{ return lhs.compare( rhs ) < 0; }
+
+inline std::ostream& operator<<( std::ostream &out, const StringRef &str )
+{
+	return out.write( str.data(), (std::streamsize)str.size() );
+}
+
+} // namespace cinder
@@ -76,6 +76,7 @@ class CI_API TextLayout {
 	void	setBorder( int horizontal, int vertical );
 
 	//! Returns a Surface into which the TextLayout is rendered. If \a useAlpha the Surface will contain an alpha channel. If \a premultiplied the alpha will be premulitplied.
+	//! Rendering an unchanged TextLayout again returns a copy of the previous result rather than rasterizing every line.
 	Surface		render( bool useAlpha = false, bool premultiplied = false );
 	
  private:
@@ -86,6 +87,10 @@ class CI_API TextLayout {
 	int		mHorizontalBorder, mVerticalBorder;
   
 	std::deque<std::shared_ptr<class Line> >		mLines;
+
+	// the last result of render(), valid until the lines, background or border change
+	Surface	mRendered;
+	bool	mRenderedUseAlpha, mRenderedPremultiplied;
 };
 
 class CI_API TextBox {
@@ -140,6 +145,13 @@ class CI_API TextBox {
 
 	Surface				render( vec2 offset = vec2() );
 
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	//! Sets the number of layouts kept by the cache shared between all TextBoxes, which stores the line breaks and glyphs of recently laid out text keyed by font, width and text. Default is \c 64.
+	static void			setLayoutCacheCapacity( size_t numLayouts );
+	//! Discards every layout held by the cache shared between all TextBoxes.
+	static void			clearLayoutCache();
+#endif
+
   protected:
 	Alignment		mAlign;
 	ivec2			mSize;
@@ -164,6 +176,12 @@ class CI_API TextBox {
 	std::vector<std::string>	calculateLineBreaks( const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics = nullptr ) const;
 	void 						calculate() const;
 #endif
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	// Returns the line breaks and glyphs of the current text, reusing a cached layout when one matches and re-laying out only the last line after appendText()
+	const class TextBoxLayout&	getLayout( const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics = nullptr ) const;
+
+	mutable std::shared_ptr<const TextBoxLayout>	mLayout;
+#endif
 };
 
 /** \brief Renders a single string and returns it as a Surface.
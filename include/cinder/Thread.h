@@ -34,6 +34,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <functional>
 
 namespace cinder {
 //! Create an instance of this class at the beginning of any multithreaded code that makes use of Cinder functionality
@@ -51,4 +52,11 @@ class CI_API ThreadSetup {
 #endif
 };
 
+//! Invokes \a fn( rangeBegin, rangeEnd ) over sub-ranges of [\a begin, \a end) containing at least \a grainSize elements, distributed across a shared pool of worker threads.
+//! The calling thread participates and the call returns once every sub-range has completed. Runs \a fn serially on the calling thread when the range holds fewer than two grains.
+//! The first exception thrown by \a fn is rethrown on the calling thread.
+CI_API void parallelFor( size_t begin, size_t end, size_t grainSize, const std::function<void( size_t, size_t )> &fn );
+//! Returns the number of threads (including the calling thread) which parallelFor() distributes work across.
+CI_API size_t getNumParallelThreads();
+
 } // namespace cinder
@@ -38,11 +38,17 @@ namespace cinder {
 
 typedef std::shared_ptr<class Cue>			CueRef;
 typedef std::shared_ptr<class Timeline>		TimelineRef;
-	
+
+//! Schedules TimelineItems such as Tweens and Cues against a current time.
+//! Items which start after the current time wait in a queue ordered by start time, so stepping forward only visits items which have started.
+//! Started Tweens of \c float, \c vec2, \c vec3, \c vec4, Color and ColorA which use the default lerp function and no update function
+//! are updated together from contiguous arrays, as long as they are the only item with their target. They are grouped by easing function,
+//! so that the stateless easing functions of Easing.h are evaluated with easeBatch().
 class CI_API Timeline : public TimelineItem {		
   public:
 	//! Creates a new timeline, defaulted to infinite
 	static TimelineRef	create() { TimelineRef result( new Timeline() ); result->setInfinite( true ); return result; }
+	~Timeline();
 
 	//! Advances time a specified amount and evaluates items
 	void	step( float timestep );
@@ -88,7 +94,7 @@ class CI_API Timeline : public TimelineItem {
 	template<typename T>
 	typename Tween<T>::Options applyPtr( T *target, T endValue, float duration, EaseFn easeFunction = easeNone, typename Tween<T>::LerpFn lerpFunction = &tweenLerp<T> )
 	{
-		TweenRef<T> newTween( new Tween<T>( target, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
+		TweenRef<T> newTween( std::make_shared<Tween<T>>( target, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
 		newTween->setAutoRemove( mDefaultAutoRemove );
 		apply( newTween );
 		return typename Tween<T>::Options( newTween, thisRef() );
@@ -98,7 +104,7 @@ class CI_API Timeline : public TimelineItem {
 	template<typename T>
 	typename Tween<T>::Options applyPtr( T *target, T startValue, T endValue, float duration, EaseFn easeFunction = easeNone, typename Tween<T>::LerpFn lerpFunction = &tweenLerp<T> )
 	{
-		TweenRef<T> newTween( new Tween<T>( target, startValue, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
+		TweenRef<T> newTween( std::make_shared<Tween<T>>( target, startValue, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
 		newTween->setAutoRemove( mDefaultAutoRemove );
 		apply( newTween );
 		return typename Tween<T>::Options( newTween, thisRef() );
@@ -109,7 +115,7 @@ class CI_API Timeline : public TimelineItem {
 	typename Tween<T>::Options appendToPtr( T *target, T endValue, float duration, EaseFn easeFunction = easeNone, typename Tween<T>::LerpFn lerpFunction = &tweenLerp<T> )
 	{
 		float startTime = findEndTimeOf( target );
-		TweenRef<T> newTween( new Tween<T>( target, endValue, std::max( mCurrentTime, startTime ), duration, easeFunction, lerpFunction ) );
+		TweenRef<T> newTween( std::make_shared<Tween<T>>( target, endValue, std::max( mCurrentTime, startTime ), duration, easeFunction, lerpFunction ) );
 		newTween->setAutoRemove( mDefaultAutoRemove );
 		insert( newTween );
 		return typename Tween<T>::Options( newTween, thisRef() );
@@ -120,7 +126,7 @@ class CI_API Timeline : public TimelineItem {
 	typename Tween<T>::Options appendToPtr( T *target, T startValue, T endValue, float duration, EaseFn easeFunction = easeNone, typename Tween<T>::LerpFn lerpFunction = &tweenLerp<T> )
 	{
 		float startTime = findEndTimeOf( target );
-		TweenRef<T> newTween( new Tween<T>( target, startValue, endValue, std::max( mCurrentTime, startTime ), duration, easeFunction, lerpFunction ) );
+		TweenRef<T> newTween( std::make_shared<Tween<T>>( target, startValue, endValue, std::max( mCurrentTime, startTime ), duration, easeFunction, lerpFunction ) );
 		newTween->setAutoRemove( mDefaultAutoRemove );
 		insert( newTween );
 		return typename Tween<T>::Options( newTween, thisRef() );
@@ -132,7 +138,7 @@ class CI_API Timeline : public TimelineItem {
 	template<typename T>
 	FnTweenRef<T> applyFn( const std::function<void (T)> &fn, T startValue, T endValue, float duration, const EaseFn &easeFunction = easeNone, const typename Tween<T>::LerpFn &lerpFunction = &tweenLerp<T> )
 	{
-		FnTweenRef<T> newTween( new FnTween<T>( fn, startValue, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
+		FnTweenRef<T> newTween( std::make_shared<FnTween<T>>( fn, startValue, endValue, mCurrentTime, duration, easeFunction, lerpFunction ) );
 		newTween->setAutoRemove( mDefaultAutoRemove );
 		apply( newTween );
 		return newTween;
@@ -218,6 +224,53 @@ class CI_API Timeline : public TimelineItem {
   private:
 	Timeline( const Timeline &rhs ); // private to prevent copying; use clone() method instead
 	Timeline& operator=( const Timeline &rhs ); // not defined to prevent copying
+
+	// an item which has started, ordered like mItems by target and then sequence
+	struct ActiveItem {
+		void			*mTarget;
+		uint64_t		mSequence;
+		TimelineItemRef	mItem;
+	};
+	// an item which starts after the current time. Entries left behind when an item is rescheduled are skipped
+	struct PendingItem {
+		float			mStartTime;
+		uint64_t		mSequence;
+		TimelineItemRef	mItem;
+	};
+
+	void	insertItem( const TimelineItemRef &item );
+	void	eraseItem( std::multimap<void*,TimelineItemRef>::iterator iter );
+	void	markForRemoval( TimelineItem *item );
+	void	itemMarkedForRemoval( TimelineItem *item ) { mMarkedItems.push_back( std::make_pair( item->mTarget, item ) ); }
+	void	itemChanged( TimelineItem *item );
+	void	setScheduleState( TimelineItem *item, Schedule::State state );
+	void	unbatch( TimelineItem *item );
+	void	schedule( const TimelineItemRef &item );
+	void	scheduleAll();
+	void	pushPending( const TimelineItemRef &item );
+	bool	isValid( const ActiveItem &active ) const;
+	bool	isValid( const PendingItem &pending ) const;
+	void	stepActive();
+	void	tryBatching( const TimelineItemRef &item );
+	void	unbatchAll();
+	void	mergeStartedItems( size_t numSorted );
+	void	stepAll( bool reverse );
+
+	std::vector<ActiveItem>		mActiveItems;
+	std::vector<ActiveItem>		mStartedItems; // started since the last step, not yet merged into mActiveItems
+	std::vector<PendingItem>	mPendingItems; // min-heap on start time
+	size_t						mNumPending;
+	uint64_t					mNextSequence;
+	// items marked for removal since the last step, with the target they were marked under
+	std::vector<std::pair<void*,TimelineItem*>>	mMarkedItems;
+
+	// started Tweens of a single type, updated together; defined in Timeline.cpp
+	class TweenBatchBase;
+	template<typename T>
+	class TweenBatch;
+	std::vector<std::unique_ptr<TweenBatchBase>>	mTweenBatches;
+
+	friend class TimelineItem;
 };
 
 class CI_API Cue : public TimelineItem {
@@ -54,12 +54,12 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	//! Returns whether the item starts over when it is complete
 	bool			getLoop() const { return mLoop; }
 	//! Sets whether the item starts over when it is complete
-	void			setLoop( bool doLoop = true ) { mLoop = doLoop; }
+	void			setLoop( bool doLoop = true ) { mLoop = doLoop; markChanged(); }
 
 	//! Returns whether the item alternates between forward and reverse. Overrides loop when true.
 	bool			getPingPong() const { return mPingPong; }
 	//! Sets whether the item alternates between forward and reverse. Overrides loop when true.
-	void			setPingPong( bool pingPong = true ) { mPingPong = pingPong; }
+	void			setPingPong( bool pingPong = true ) { mPingPong = pingPong; markChanged(); }
 
 	//! Returns whether the item ever is marked as complete
 	bool			getInfinite() const { return mLoop; }
@@ -74,7 +74,7 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	//! Removes the item from its parent Timeline
 	void removeSelf();
 	//! Marks the item as not completed, and if \a unsetStarted, marks the item as not started
-	virtual void reset( bool unsetStarted = false ) { if( unsetStarted ) mHasStarted = false; mComplete = false; }
+	virtual void reset( bool unsetStarted = false ) { if( unsetStarted ) mHasStarted = false; mComplete = false; markChanged(); }
 	
 	//! Returns whether the item has started
 	bool hasStarted() const { return mHasStarted; }			
@@ -105,6 +105,8 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	
   protected:
 	void	setDurationDirty() { mDirtyDuration = true; }
+	//! Notifies the parent Timeline of a change to how the item is stepped, other than its start time or duration
+	void	markChanged();
 	void	updateDuration() const;
 	//! Converts time from absolute to absolute based on item's looping attributes
 	float	loopTime( float absTime );
@@ -125,8 +127,27 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	
 	friend class Timeline;
   private:
+
 	mutable float	mDuration, mInvDuration;
 	mutable bool	mDirtyDuration; // marked if the virtual calcDuration() needs to be calculated
+
+	// maintained by the parent Timeline, which only steps items that have started. Copies of an item start out unscheduled
+	struct Schedule {
+		enum State : uint8_t { UNSCHEDULED, PENDING, ACTIVE, BATCHED };
+
+		Schedule() : mState( UNSCHEDULED ), mCheckBatchable( true ), mBatch( 0 ), mBatchGroup( 0 ), mBatchIndex( 0 ), mSequence( 0 ) {}
+		Schedule( const Schedule & ) : Schedule() {}
+		Schedule& operator=( const Schedule & ) { return *this; }
+
+		State		mState;
+		bool		mCheckBatchable; // whether the parent should try batching the item after its next step
+		uint8_t		mBatch; // BATCHED only
+		uint8_t		mBatchGroup; // BATCHED only
+		uint32_t	mBatchIndex; // BATCHED only
+		uint64_t	mSequence; // order of insertion into the parent, breaking ties between items sharing a target
+	};
+
+	Schedule		mSchedule;
 };
 
 } // namespace cinder
@@ -338,6 +338,16 @@ class CI_API TriMesh : public geom::Source {
 		nor will it affect texture mapping. If \a weighted is TRUE, larger polygons contribute more to
 		the calculated normal. Renormalization requires 3D vertices. */
 	bool		recalculateNormals( bool smooth = false, bool weighted = false );
+	//! Determines how the normals of the faces around a vertex are weighted by recalculateNormals()
+	enum class NormalWeighting {
+		EQUAL,	//!< every face contributes equally
+		AREA,	//!< faces contribute in proportion to their area
+		ANGLE	//!< faces contribute in proportion to their interior angle at the vertex
+	};
+	/*! Adds or replaces normals by calculating them from the vertices and faces. Faces sharing a vertex position are smoothed
+		together when the angle between them is less than \a creaseAngle (in radians). Vertices on sharper creases are duplicated
+		so that each smoothing group keeps its own normal, which changes the vertex count and indices. Requires 3D vertices. */
+	bool		recalculateNormals( NormalWeighting weighting, float creaseAngle );
 	//! Adds or replaces tangents by calculating them from the normals and texture coordinates. Requires 3D normals and 2D texture coordinates.
 	bool		recalculateTangents();
 	//! Adds or replaces bitangents by calculating them from the normals and tangents. Requires 3D normals and tangents.
@@ -347,6 +357,76 @@ class CI_API TriMesh : public geom::Source {
 		Optionally, vertices are normalized if \a normalize is TRUE. */
 	void		subdivide( int division = 2, bool normalize = false );
 
+	//! Options for simplified() and calcLods()
+	class CI_API SimplifyOptions {
+	  public:
+		SimplifyOptions()
+			: mNormalWeight( 0.01f ), mTexCoordWeight( 0.01f ), mColorWeight( 0.01f ), mMaxError( 1.0f ), mLockBorder( false ), mClusterSize( 65536 )
+		{}
+
+		//! Sets the weight of normal deviation relative to geometric error. Defaults to \c 0.01.
+		SimplifyOptions&	normalWeight( float weight ) { mNormalWeight = weight; return *this; }
+		//! Sets the weight of texture coordinate (unit 0) deviation relative to geometric error. Defaults to \c 0.01.
+		SimplifyOptions&	texCoordWeight( float weight ) { mTexCoordWeight = weight; return *this; }
+		//! Sets the weight of color deviation relative to geometric error. Defaults to \c 0.01.
+		SimplifyOptions&	colorWeight( float weight ) { mColorWeight = weight; return *this; }
+		//! Sets the maximum error, relative to the largest extent of the mesh's bounding box, that a single collapse may introduce. Simplification stops early once no cheaper collapse remains. Defaults to \c 1 (unbounded).
+		SimplifyOptions&	maxError( float error ) { mMaxError = error; return *this; }
+		//! If \c true, vertices on open borders are never moved. Otherwise borders are simplified only along themselves. Defaults to \c false.
+		SimplifyOptions&	lockBorder( bool lock = true ) { mLockBorder = lock; return *this; }
+		//! Meshes with more than twice \a numTriangles triangles are first simplified as independent spatial clusters of this size in parallel. \c 0 disables clustering. Defaults to \c 65536.
+		SimplifyOptions&	clusterSize( size_t numTriangles ) { mClusterSize = numTriangles; return *this; }
+
+		float	getNormalWeight() const { return mNormalWeight; }
+		float	getTexCoordWeight() const { return mTexCoordWeight; }
+		float	getColorWeight() const { return mColorWeight; }
+		float	getMaxError() const { return mMaxError; }
+		bool	isBorderLocked() const { return mLockBorder; }
+		size_t	getClusterSize() const { return mClusterSize; }
+
+	  protected:
+		float	mNormalWeight, mTexCoordWeight, mColorWeight, mMaxError;
+		bool	mLockBorder;
+		size_t	mClusterSize;
+	};
+
+	//! A single level of detail generated by calcLods()
+	struct CI_API Lod {
+		TriMeshRef	mMesh;
+		//! The largest error introduced to reach this level, relative to the largest extent of the source mesh's bounding box
+		float		mError;
+	};
+
+	/*! Returns a copy of this TriMesh reduced to approximately \a targetRatio of its triangles, using quadric error metric edge collapses
+		which account for deviation of normals, texture coordinates and colors. Attribute seams are preserved. Requires 3D positions.
+		If \a resultError is supplied it receives the largest introduced error, relative to the largest extent of the bounding box. */
+	TriMesh				simplified( float targetRatio, const SimplifyOptions &options = SimplifyOptions(), float *resultError = nullptr ) const;
+	/*! Generates a chain of progressively simplified meshes in a single pass, one per entry in \a targetRatios (for example { 0.5f, 0.25f, 0.125f }).
+		Ratios are relative to this TriMesh's triangle count and are processed from largest to smallest. Requires 3D positions. */
+	std::vector<Lod>	calcLods( const std::vector<float> &targetRatios, const SimplifyOptions &options = SimplifyOptions() ) const;
+	//! Returns a TriMesh containing the triangles described by \a indices, which refer to this TriMesh's vertices. Only referenced vertices are kept, renumbered in order of first use.
+	TriMesh				extract( const std::vector<uint32_t> &indices ) const;
+
+	//! Post-transform vertex cache statistics reported by calcVertexCacheStats()
+	struct CI_API VertexCacheStats {
+		//! Average Cache Miss Ratio: vertices transformed per triangle. Ranges from 3 (no reuse) down to roughly 0.5 for large regular meshes.
+		float	mAcmr;
+		//! Average Transform to Vertex Ratio: transforms per referenced vertex. 1 is optimal.
+		float	mAtvr;
+		//! Total number of vertices transformed
+		size_t	mNumTransformed;
+	};
+
+	//! Simulates a FIFO post-transform vertex cache with \a cacheSize entries over this TriMesh's indices.
+	VertexCacheStats	calcVertexCacheStats( uint32_t cacheSize = 16 ) const;
+	//! Reorders triangles to improve post-transform vertex cache reuse using Tipsify (Sander et al. 2007). Vertex order is unchanged.
+	void				optimizeVertexCache( uint32_t cacheSize = 16 );
+	/*! Reorders triangles as optimizeVertexCache() does, then sorts the resulting clusters so that outward-facing ones are drawn first, reducing overdraw.
+		\a threshold bounds how much the ACMR of each cluster may degrade to allow finer sorting (1.05 allows 5%). Requires 3D positions. */
+	void				optimizeOverdraw( float threshold = 1.05f, uint32_t cacheSize = 16 );
+	//! Reorders vertices by first use in the indices, improving vertex fetch locality. Call after reordering triangles. Unreferenced vertices are removed.
+	void				optimizeVertexFetch();
+
 	//! Create TriMesh from vectors of vertex data.
 /*	static TriMesh		create( std::vector<uint32_t> &indices, const std::vector<ColorAf> &colors,
 							   const std::vector<vec3> &normals, const std::vector<vec3> &positions,
@@ -364,8 +444,14 @@ class CI_API TriMesh : public geom::Source {
 	void		getAttribPointer( geom::Attrib attr, const float **resultPtr, size_t *resultStrideBytes, uint8_t *resultDims ) const;
 	void		copyAttrib( geom::Attrib attr, uint8_t dims, size_t stride, const float *srcData, size_t count );
 
+	bool		recalculateNormalsImpl( NormalWeighting weighting, bool smooth, float creaseAngle );
+	//! Appends a copy of every attribute of each vertex in \a sourceVertices.
+	void		appendVertexCopies( const std::vector<uint32_t> &sourceVertices );
+
 	//! Returns whether or not the vertex, color etc. at both indices is the same.
 	bool		verticesEqual( uint32_t indexA, uint32_t indexB ) const;
+	//! Returns mIndices with each group of vertices sharing a position and (nearly) identical attributes, other than tangents and bitangents, replaced by a single representative. Requires 3D positions.
+	std::vector<uint32_t>	calcWeldedIndices() const;
 
 	void		readImplV2( const IStreamRef &in );
 	void		readImplV1( const IStreamRef &in );
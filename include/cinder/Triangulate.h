@@ -36,6 +36,10 @@ namespace cinder {
 class CI_API Triangulator {
   public:
 	typedef enum Winding { WINDING_ODD, WINDING_NONZERO, WINDING_POSITIVE, WINDING_NEGATIVE, WINDING_ABS_GEQ_TWO } Winding;
+	/*! Selects the triangulation algorithm. BACKEND_LIBTESS handles arbitrary self-intersecting and overlapping contours. BACKEND_EARCUT is a much
+		faster ear clipping triangulator for the common case of non-intersecting contours, where holes and islands are determined by nesting
+		and, for WINDING_NONZERO, by contour orientation. BACKEND_EARCUT supports WINDING_ODD and WINDING_NONZERO and falls back to libtess2 for the others. */
+	typedef enum Backend { BACKEND_LIBTESS, BACKEND_EARCUT } Backend;
 
 	//! Default constructor
 	Triangulator();
@@ -55,19 +59,32 @@ class CI_API Triangulator {
 	//! Adds a PolyLine defined as a series of vec2's
 	void		addPolyLine( const vec2 *points, size_t numPoints );
 
-	//! Performs the tesselation, returning a TriMesh2d
-	TriMesh		calcMesh( Winding winding = WINDING_ODD );
-	//! Performs the tesselation, returning a TriMesh2d
-	TriMeshRef	createMesh( Winding winding = WINDING_ODD );
+	//! Removes all contours, keeping allocated memory so that the Triangulator can be reused efficiently for another shape
+	void		clear();
+
+	//! Performs the tesselation, returning a TriMesh2d. The contours are consumed, so any added afterwards form a new shape.
+	TriMesh		calcMesh( Winding winding = WINDING_ODD, Backend backend = BACKEND_LIBTESS );
+	//! Performs the tesselation, returning a TriMesh2d. The contours are consumed, so any added afterwards form a new shape.
+	TriMeshRef	createMesh( Winding winding = WINDING_ODD, Backend backend = BACKEND_LIBTESS );
 	
 	class CI_API Exception : public cinder::Exception {
 	};
 	
   protected:	
+	class EarcutArena;
+
 	void			allocate();
+	void			addContour( const vec2 *points, size_t numPoints );
+	void			calcMeshImpl( Winding winding, Backend backend, TriMesh *result );
+	void			calcMeshLibtess( Winding winding, TriMesh *result );
 	
 	int									mAllocated;
 	std::shared_ptr<TESStesselator>		mTess;
+	std::shared_ptr<EarcutArena>		mEarcut;
+	//! Points of all contours, stored contiguously until the tesselation is performed
+	std::vector<vec2>					mPoints;
+	//! One past the last point of each contour in mPoints
+	std::vector<uint32_t>				mContourEnds;
 };
 
 } // namespace cinder
\ No newline at end of file
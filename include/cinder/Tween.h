@@ -41,6 +41,9 @@ template<typename T>
 class Tween;
 typedef std::function<float (float)> EaseFn;
 
+//! Returns the EaseBatchFn equivalent to \a ease when it holds one of the stateless easing functions or functors of Easing.h, such as easeInQuad or EaseInQuad(). Otherwise returns \c nullptr.
+CI_API EaseBatchFn findEaseBatchFn( const EaseFn &ease );
+
 template<typename T>
 class Anim;
 
@@ -84,7 +87,7 @@ class CI_API TweenBase : public TimelineItem {
 	virtual ~TweenBase() {}
 
 	//! change how the tween moves through time
-	void	setEaseFn( EaseFn easeFunction ) { mEaseFunction = easeFunction; }
+	void	setEaseFn( EaseFn easeFunction ) { mEaseFunction = easeFunction; markChanged(); }
 	EaseFn	getEaseFn() const { return mEaseFunction; }
 
 	void			setStartFn( StartFn startFunction ) { mStartFunction = startFunction; }
@@ -93,7 +96,7 @@ class CI_API TweenBase : public TimelineItem {
 	void			setReverseStartFn( StartFn reverseStartFunction ) { mReverseStartFunction = reverseStartFunction; }
 	StartFn			getReverseStartFn() const { return mReverseStartFunction; }
 	
-	void			setUpdateFn( UpdateFn updateFunction ) { mUpdateFunction = updateFunction; }									
+	void			setUpdateFn( UpdateFn updateFunction ) { mUpdateFunction = updateFunction; markChanged(); }									
 	UpdateFn		getUpdateFn() const { return mUpdateFunction; }
 																																					
 	void			setFinishFn( FinishFn finishFn ) { mFinishFunction = finishFn; }
@@ -180,7 +183,7 @@ class Tween : public TweenBase {
 	//! Returns whether the tween will copy its target's value upon starting
 	bool	isCopyStartValue() { return mCopyStartValue; }
 
-	void	setLerpFn( const LerpFn &lerpFn ) { mLerpFunction = lerpFn; }
+	void	setLerpFn( const LerpFn &lerpFn ) { mLerpFunction = lerpFn; markChanged(); }
 
 	//! Returns a TweenRef<T> to \a this
 	TweenRef<T>		getThisRef(){ return TweenRef<T>( std::static_pointer_cast<Tween<T> >( shared_from_this() ) ); }
@@ -261,6 +264,8 @@ class Tween : public TweenBase {
 	T	mStartValue, mEndValue;	
 	
 	LerpFn				mLerpFunction;
+
+	friend class Timeline;
 };
 
 template<typename T>
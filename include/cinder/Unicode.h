@@ -46,6 +46,11 @@ CI_API std::string		toUtf8( const std::u32string &utf32Str );
 CI_API std::u16string	toUtf16( const std::u32string &utf32str );
 CI_API std::u32string	toUtf32( const std::u16string &utf16str );
 
+//! Returns whether \a str is well-formed UTF-8, free of overlong sequences, surrogates and code points beyond U+10FFFF. Optimize operation by supplying a non-default \a lengthInBytes of \a str.
+CI_API bool		isValidUtf8( const char *str, size_t lengthInBytes = 0 );
+//! Returns whether \a str is well-formed UTF-8, free of overlong sequences, surrogates and code points beyond U+10FFFF.
+CI_API bool		isValidUtf8( const std::string &str );
+
 //! Returns the number of characters (not bytes) in the the UTF-8 string \a str. Optimize operation by supplying a non-default \a lengthInBytes of \a str.
 CI_API size_t	stringLengthUtf8( const char *str, size_t lengthInBytes = 0 );
 //!  Returns the UTF-32 code point of the next character in \a str, relative to the byte \a inOutByte. Increments \a inOutByte to be the first byte of the next character. Optimize operation by supplying a non-default \a lengthInBytes of \a str.
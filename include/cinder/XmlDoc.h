@@ -0,0 +1,318 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Xml.h"
+#include "cinder/StringRef.h"
+
+#include <iterator>
+#include <memory>
+#include <string>
+
+//! \cond
+namespace rapidxml {
+	template<class Ch> class xml_attribute;
+};
+//! \endcond
+
+namespace cinder {
+
+typedef std::shared_ptr<class XmlDoc>	XmlDocRef;
+
+//! Read-only XML document which keeps its RapidXML parse alive rather than copying it into XmlTree nodes.
+//! The source is parsed in place, so tags, values and attributes are StringRefs into it, and all nodes come from RapidXML's
+//! memory pool. Child lookups by tag scan the first few children and then, for nodes with many children, build a hash of
+//! their tags on first use; attributes are looked up the same way. Queries match those of XmlTree, including case-insensitive
+//! tag matching by default. XmlDoc::Node refers into its XmlDoc, which must outlive it. An XmlDoc may be read from several threads at once.
+class CI_API XmlDoc {
+	struct Impl;
+
+  public:
+	class Iter;
+	class AttrIter;
+	class AttrRange;
+
+	//! A lightweight reference to an attribute within an XmlDoc.
+	class CI_API Attr {
+	  public:
+		//! Creates an invalid Attr, as returned by XmlDoc::Node::findAttribute() when there is no match. Its name and value are empty.
+		Attr() : mAttr( nullptr ) {}
+
+		//! Returns whether the Attr refers to an attribute of an XmlDoc.
+		bool		isValid() const		{ return mAttr != nullptr; }
+		StringRef	getName() const;
+		StringRef	getValue() const;
+		//! Returns the value of the attribute parsed as a T using ci::fromString().
+		template<typename T>
+		T			getValue() const	{ return fromString<T>( getValue().str() ); }
+		//! Returns the value of the attribute parsed as a T using ci::fromString().
+		template<typename T>
+		T			as() const			{ return getValue<T>(); }
+		//! Returns whether the value is empty, which is always the case for an invalid Attr.
+		bool		empty() const		{ return getValue().empty(); }
+
+		//! Returns a copy of the value.
+		operator std::string() const	{ return getValue().str(); }
+
+		bool	operator==( const StringRef &rhs ) const	{ return getValue() == rhs; }
+		bool	operator!=( const StringRef &rhs ) const	{ return getValue() != rhs; }
+
+	  private:
+		Attr( const rapidxml::xml_attribute<char> *attr ) : mAttr( attr ) {}
+
+		const rapidxml::xml_attribute<char>	*mAttr;
+
+		friend class XmlDoc;
+		friend class XmlDoc::AttrIter;
+	};
+
+	//! A lightweight reference to a node within an XmlDoc.
+	class CI_API Node {
+	  public:
+		//! Creates an invalid Node, as returned by findChild() when there is no match.
+		Node() : mImpl( nullptr ), mNode( nullptr ) {}
+
+		//! Returns whether the Node refers to a node of an XmlDoc.
+		bool				isValid() const		{ return mNode != nullptr; }
+		XmlTree::NodeType	getNodeType() const;
+		bool				isDocument() const	{ return getNodeType() == XmlTree::NODE_DOCUMENT; }
+		bool				isElement() const	{ return getNodeType() == XmlTree::NODE_ELEMENT; }
+		//! Returns whether this node represents CDATA. Only possible when the document's ParseOptions disabled collapsing CDATA.
+		bool				isCData() const		{ return getNodeType() == XmlTree::NODE_CDATA; }
+		//! Returns whether this node represents a comment. Only possible when the document's ParseOptions enabled parsing comments.
+		bool				isComment() const	{ return getNodeType() == XmlTree::NODE_COMMENT; }
+		//! Returns whether this node represents text. Only possible when the document's ParseOptions disabled ignoring data children.
+		bool				isData() const		{ return getNodeType() == XmlTree::NODE_DATA; }
+
+		//! Returns the tag or name of the node. Empty for the document, data, CDATA and comments.
+		StringRef	getTag() const;
+		//! Returns the value of the node, which for an element is its first text, followed by its CDATA when ParseOptions collapse CDATA.
+		StringRef	getValue() const;
+		//! Returns the value of the node parsed as a T using ci::fromString().
+		template<typename T>
+		T			getValue() const	{ return fromString<T>( getValue().str() ); }
+		//! Returns the value of the node parsed as a T using ci::fromString(). If the value fails to parse \a defaultValue is returned.
+		template<typename T>
+		T			getValue( const T &defaultValue ) const	{ try { return fromString<T>( getValue().str() ); } catch( ... ) { return defaultValue; } }
+
+		//! Returns whether this node has a parent node, which is true for all but the document.
+		bool		hasParent() const;
+		//! Returns the parent of this node, or an invalid Node for the document.
+		Node		getParent() const;
+
+		//! Returns an Iter to the first child of this node.
+		Iter		begin() const;
+		//! Returns an Iter to the first child of this node whose tag is \a tag.
+		Iter		begin( const StringRef &tag, bool caseSensitive = false ) const;
+		//! Returns an Iter which marks the end of the children of this node.
+		Iter		end() const;
+
+		//! Returns the first child that matches \a relativePath. Throws ExcChildNotFound if none matches.
+		Node		getChild( const StringRef &relativePath, bool caseSensitive = false, char separator = '/' ) const;
+		//! Returns the first child that matches \a relativePath, or an invalid Node if none matches.
+		Node		findChild( const StringRef &relativePath, bool caseSensitive = false, char separator = '/' ) const;
+		//! Returns whether at least one child matches \a relativePath.
+		bool		hasChild( const StringRef &relativePath, bool caseSensitive = false, char separator = '/' ) const	{ return findChild( relativePath, caseSensitive, separator ).isValid(); }
+		//! Returns the first child that matches \a childName. Throws ExcChildNotFound if none matches.
+		Node		operator/( const StringRef &childName ) const	{ return getChild( childName ); }
+
+		//! Returns the attributes of the node, for use with range-based for loops.
+		AttrRange	getAttributes() const;
+		//! Returns the attribute named \a attrName. Throws ExcAttrNotFound if no attribute exists with that name.
+		Attr		getAttribute( const StringRef &attrName ) const;
+		//! Returns the attribute named \a attrName, or an invalid Attr if no attribute exists with that name.
+		Attr		findAttribute( const StringRef &attrName ) const;
+		//! Returns whether the node has an attribute named \a attrName.
+		bool		hasAttribute( const StringRef &attrName ) const	{ return findAttribute( attrName ).isValid(); }
+		//! Returns the attribute named \a attrName. If the attribute does not exist the Attr is invalid and its value is empty.
+		Attr		operator[]( const StringRef &attrName ) const	{ return findAttribute( attrName ); }
+
+		//! Returns the value of the attribute \a attrName parsed as a T. Throws ExcAttrNotFound if no attribute exists with that name.
+		template<typename T>
+		T			getAttributeValue( const StringRef &attrName ) const	{ return getAttribute( attrName ).getValue<T>(); }
+		//! Returns the value of the attribute \a attrName parsed as a T. Returns \a defaultValue if no attribute exists with that name or it fails to parse.
+		template<typename T>
+		T			getAttributeValue( const StringRef &attrName, const T &defaultValue ) const
+		{
+			const Attr attr = findAttribute( attrName );
+			if( ! attr.isValid() )
+				return defaultValue;
+			try {
+				return attr.getValue<T>();
+			}
+			catch( ... ) {
+				return defaultValue;
+			}
+		}
+
+		//! Returns a path to this node, separated by the character \a separator.
+		std::string	getPath( char separator = '/' ) const;
+		//! Returns the DOCTYPE of the document. Empty for other nodes.
+		StringRef	getDocType() const;
+
+		bool	operator==( const Node &rhs ) const		{ return mNode == rhs.mNode; }
+		bool	operator!=( const Node &rhs ) const		{ return mNode != rhs.mNode; }
+
+	  private:
+		Node( const Impl *impl, const rapidxml::xml_node<char> *node ) : mImpl( impl ), mNode( node ) {}
+
+		// returns the first child whose tag is 'tag', or an invalid Node
+		Node	findChildNamed( const StringRef &tag, bool caseSensitive ) const;
+
+		const Impl							*mImpl;
+		const rapidxml::xml_node<char>		*mNode;
+
+		friend class XmlDoc;
+		friend class XmlDoc::Iter;
+	};
+
+	//! Iterates the children of a Node, optionally only those with a given tag.
+	class CI_API Iter {
+	  public:
+		typedef std::forward_iterator_tag	iterator_category;
+		typedef Node						value_type;
+		typedef std::ptrdiff_t				difference_type;
+		typedef const Node*					pointer;
+		typedef const Node&					reference;
+
+		Iter() : mFiltered( false ), mCaseSensitive( false ) {}
+
+		const Node&	operator*() const		{ return mNode; }
+		const Node*	operator->() const		{ return &mNode; }
+		Iter&		operator++()			{ increment(); return *this; }
+		Iter		operator++( int )		{ Iter result( *this ); increment(); return result; }
+		bool		operator==( const Iter &rhs ) const	{ return mNode == rhs.mNode; }
+		bool		operator!=( const Iter &rhs ) const	{ return mNode != rhs.mNode; }
+
+	  private:
+		Iter( const Node &node, const StringRef &tag, bool filtered, bool caseSensitive );
+
+		// advances mNode to the first child at or after it which is visible and matches the filter
+		void	skip();
+		void	increment();
+
+		Node		mNode;
+		StringRef	mTag;
+		bool		mFiltered, mCaseSensitive;
+
+		friend class Node;
+	};
+
+	//! Iterates the attributes of a Node.
+	class CI_API AttrIter {
+	  public:
+		typedef std::forward_iterator_tag	iterator_category;
+		typedef Attr						value_type;
+		typedef std::ptrdiff_t				difference_type;
+		typedef const Attr*					pointer;
+		typedef const Attr&					reference;
+
+		AttrIter() {}
+
+		const Attr&	operator*() const		{ return mAttr; }
+		const Attr*	operator->() const		{ return &mAttr; }
+		AttrIter&	operator++()			{ increment(); return *this; }
+		AttrIter	operator++( int )		{ AttrIter result( *this ); increment(); return result; }
+		bool		operator==( const AttrIter &rhs ) const	{ return mAttr.mAttr == rhs.mAttr.mAttr; }
+		bool		operator!=( const AttrIter &rhs ) const	{ return mAttr.mAttr != rhs.mAttr.mAttr; }
+
+	  private:
+		AttrIter( const Attr &attr ) : mAttr( attr ) {}
+
+		void	increment();
+
+		Attr	mAttr;
+
+		friend class Node;
+		friend class AttrRange;
+	};
+
+	//! The attributes of a Node, as returned by Node::getAttributes().
+	class AttrRange {
+	  public:
+		AttrIter	begin() const	{ return mBegin; }
+		AttrIter	end() const		{ return AttrIter(); }
+		bool		empty() const	{ return ! mBegin->isValid(); }
+
+	  private:
+		AttrRange( const AttrIter &begin ) : mBegin( begin ) {}
+
+		AttrIter	mBegin;
+
+		friend class Node;
+	};
+
+	//! Parses the XML in \a dataSource using the options \a parseOptions.
+	explicit XmlDoc( const DataSourceRef &dataSource, const XmlTree::ParseOptions &parseOptions = XmlTree::ParseOptions() );
+	//! Parses the XML in \a xmlString using the options \a parseOptions. The string is moved into the XmlDoc and parsed in place.
+	explicit XmlDoc( std::string xmlString, const XmlTree::ParseOptions &parseOptions = XmlTree::ParseOptions() );
+	XmlDoc( XmlDoc &&rhs );
+	XmlDoc& operator=( XmlDoc &&rhs );
+	~XmlDoc();
+
+	//! Returns the document node, whose children are the top-level nodes.
+	Node	getRoot() const;
+	//! Returns the first node that matches \a relativePath. Throws ExcChildNotFound if none matches. Shortcut for \code getRoot().getChild( relativePath ) \endcode
+	Node	getChild( const StringRef &relativePath, bool caseSensitive = false, char separator = '/' ) const	{ return getRoot().getChild( relativePath, caseSensitive, separator ); }
+	//! Returns whether at least one node matches \a relativePath.
+	bool	hasChild( const StringRef &relativePath, bool caseSensitive = false, char separator = '/' ) const	{ return getRoot().hasChild( relativePath, caseSensitive, separator ); }
+
+	//! Base class for XmlDoc exceptions.
+	class CI_API Exception : public cinder::Exception {
+	  public:
+		Exception( const std::string &description ) : cinder::Exception( description ) {}
+	};
+
+	//! Exception thrown for malformed XML.
+	class CI_API ExcParseError : public XmlDoc::Exception {
+	  public:
+		ExcParseError( const std::string &description, size_t offset ) : XmlDoc::Exception( description ), mOffset( offset ) {}
+		//! Returns the offset in bytes of the error from the start of the source.
+		size_t	getOffset() const	{ return mOffset; }
+
+	  private:
+		size_t	mOffset;
+	};
+
+	//! Exception expressing the absence of an expected child node.
+	class CI_API ExcChildNotFound : public XmlDoc::Exception {
+	  public:
+		ExcChildNotFound( const std::string &description ) : XmlDoc::Exception( description ) {}
+	};
+
+	//! Exception expressing the absence of an expected attribute.
+	class CI_API ExcAttrNotFound : public XmlDoc::Exception {
+	  public:
+		ExcAttrNotFound( const std::string &description ) : XmlDoc::Exception( description ) {}
+	};
+
+  private:
+	XmlDoc( const XmlDoc & ) = delete;
+	XmlDoc& operator=( const XmlDoc & ) = delete;
+
+	std::unique_ptr<Impl>	mImpl;
+};
+
+} // namespace cinder
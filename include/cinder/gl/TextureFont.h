@@ -26,9 +26,13 @@
 #include "cinder/Text.h"
 #include "cinder/Font.h"
 #include "cinder/gl/Texture.h"
+#include "cinder/SkylinePacker.h"
+#include "cinder/Noncopyable.h"
 
 #include <map>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace cinder { namespace gl {
 
@@ -37,9 +41,13 @@ typedef std::shared_ptr<class GlslProg>		GlslProgRef;
 
 class CI_API TextureFont {
   public:
+	class Atlas;
+	typedef std::shared_ptr<Atlas>	AtlasRef;
+
 	class CI_API Format {
 	  public:
-		Format() : mTextureWidth( 1024 ), mTextureHeight( 1024 ), mPremultiply( false ), mMipmapping( false )
+		Format() : mTextureWidth( 1024 ), mTextureHeight( 1024 ), mPremultiply( false ), mMipmapping( false ),
+			mDynamicAtlas( false ), mMaxTextures( 4 ), mAsyncRasterization( false ), mSignedDistanceField( false ), mDistanceRange( 4 )
 		{}
 		
 		//! Sets the width of the textures created internally for glyphs. Default \c 1024
@@ -60,11 +68,43 @@ class CI_API TextureFont {
 		Format&		enableMipmapping( bool enable = true ) { mMipmapping = enable; return *this; }
 		//! Returns whether the TextureFont texture has mipmapping enabled
 		bool		hasMipmapping() const { return mMipmapping; }
-		
+
+		//! Enables a dynamic atlas, which rasterizes glyphs the first time they are drawn rather than only those of \a supportedChars at construction. Linux & Android only. Default is disabled.
+		Format&		dynamicAtlas( bool enable = true ) { mDynamicAtlas = enable; return *this; }
+		//! Returns whether the TextureFont uses a dynamic atlas, either its own or one set with atlas()
+		bool		isDynamicAtlas() const { return mDynamicAtlas || mAtlas; }
+		//! Sets the number of textures a dynamic atlas may allocate. Once they are full, the least recently drawn texture is cleared and reused. Default \c 4
+		Format&		maxTextures( size_t maxTextures ) { mMaxTextures = maxTextures; return *this; }
+		//! Returns the number of textures a dynamic atlas may allocate. Default \c 4
+		size_t		getMaxTextures() const { return mMaxTextures; }
+		//! Sets whether a dynamic atlas rasterizes glyphs on a worker thread. A glyph is then drawn starting with the first draw after it completes. Default \c false
+		Format&		asyncRasterization( bool async = true ) { mAsyncRasterization = async; return *this; }
+		//! Returns whether a dynamic atlas rasterizes glyphs on a worker thread. Default \c false
+		bool		isAsyncRasterization() const { return mAsyncRasterization; }
+		//! Shares \a atlas with other TextureFonts, such as other sizes of the same typeface, rather than creating one. Implies dynamicAtlas(). The texture and rasterization settings of the Format \a atlas was created with apply.
+		Format&		atlas( const AtlasRef &atlas ) { mAtlas = atlas; return *this; }
+		//! Returns the shared atlas set with atlas(), or \c nullptr
+		const AtlasRef&	getAtlas() const { return mAtlas; }
+
+		//! Stores each glyph as a signed distance field rather than coverage, so that a single TextureFont draws crisply at any DrawOptions::scale(). Glyphs are held in a dynamic atlas. Linux & Android only; ignored on other platforms, which store coverage. Default is disabled.
+		Format&		signedDistanceField( bool enable = true ) { mSignedDistanceField = enable; return *this; }
+		//! Returns whether signed distance fields were requested. Default is disabled.
+		bool		isSignedDistanceField() const { return mSignedDistanceField; }
+		//! Sets the distance in pixels over which a signed distance field falls off on either side of the outline. Larger ranges minify better and leave room for effects such as outlines. Default \c 4
+		Format&		distanceRange( float pixels ) { mDistanceRange = pixels; return *this; }
+		//! Returns the distance in pixels over which a signed distance field falls off on either side of the outline. Default \c 4
+		float		getDistanceRange() const { return mDistanceRange; }
+
 	  protected:
 		int32_t		mTextureWidth, mTextureHeight;
 		bool		mPremultiply;
 		bool		mMipmapping;
+		bool		mDynamicAtlas;
+		size_t		mMaxTextures;
+		bool		mAsyncRasterization;
+		AtlasRef	mAtlas;
+		bool		mSignedDistanceField;
+		float		mDistanceRange;
 	};
 
 	struct CI_API DrawOptions {
@@ -109,6 +149,7 @@ class CI_API TextureFont {
 	//! Creates a new TextureFontRef with font \a font, ensuring that glyphs necessary to render \a supportedChars are renderable, and format \a format
 	static TextureFontRef		create( const Font &font, const Format &format = Format(), const std::string &supportedChars = TextureFont::defaultChars() )
 	{ return TextureFontRef( new TextureFont( font, supportedChars, format ) ); }
+	~TextureFont();
 	
 	//! Draws string \a str at baseline \a baseline with DrawOptions \a options
 	void	drawString( const std::string &str, const vec2 &baseline, const DrawOptions &options = DrawOptions() );
@@ -143,6 +184,11 @@ class CI_API TextureFont {
 	float	getDescent() const { return mFont.getDescent(); }
 	//! Returns whether the TextureFont output premultipled output. Default is \c false.
 	bool	isPremultiplied() const { return mFormat.getPremultiply(); }
+	//! Returns whether glyphs are stored as signed distance fields, which requires Format::signedDistanceField() on Linux or Android.
+	bool	isSignedDistanceField() const { return mSignedDistanceField; }
+
+	//! Returns the GlslProg used to draw signed distance field glyphs, which reads the distance from the texture's alpha and antialiases over one pixel at any scale. The uniform \c uTex0 names the glyph texture.
+	static GlslProgRef	getSignedDistanceFieldGlslProg();
 
 	//! Returns the default set of characters for a TextureFont, suitable for most English text, including some common ligatures and accented vowels.
 	//! \c "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz1234567890().?!,:;'\"&*=+-/\\@#_[]<>%^llflfiphrids"
@@ -154,18 +200,109 @@ class CI_API TextureFont {
 		vec2		mOriginOffset;
 	};
 
+	//! Glyph cache whose textures grow as glyphs are first drawn, and which may be shared by several TextureFonts.
+	//! Glyphs are placed with a SkylinePacker. When every texture is full, the one least recently drawn from is cleared
+	//! and refilled, and the glyphs it held are rasterized again when next needed. Must be used from the thread owning
+	//! the GL context; only the optional asynchronous rasterization runs elsewhere.
+	class CI_API Atlas : private Noncopyable {
+	  public:
+		//! Creates an Atlas using the texture size, mipmapping, maximum textures and asynchronous rasterization of \a format
+		static AtlasRef		create( const Format &format = Format() ) { return AtlasRef( new Atlas( format ) ); }
+		~Atlas();
+
+		//! Returns the textures allocated so far
+		const std::vector<gl::TextureRef>&	getTextures() const { return mTextures; }
+		//! Returns the number of textures the Atlas may allocate
+		size_t		getMaxTextures() const { return mMaxTextures; }
+		//! Returns the number of glyphs resident across all of the Atlas's TextureFonts
+		size_t		getNumGlyphs() const;
+		//! Returns the number of times a full texture was cleared for reuse
+		size_t		getNumEvictions() const { return mNumEvictions; }
+		//! Returns the number of glyphs queued for asynchronous rasterization
+		size_t		getNumPendingGlyphs() const;
+		//! Blocks until every queued glyph is rasterized, then adds them to the Atlas. Useful behind a loading screen.
+		void		finish();
+
+	  private:
+		Atlas( const Format &format );
+
+		struct Page {
+			gl::TextureRef		mTexture;
+			SkylinePacker		mPacker;
+			uint64_t			mLastUsed;
+			std::vector<std::pair<uint32_t, Font::Glyph>>	mGlyphs; // client and glyph of each occupant
+			bool				mDirty; // needs its mipmaps regenerated
+		};
+
+		struct Client {
+			std::unordered_map<Font::Glyph, GlyphInfo>	mGlyphMap;
+			std::unordered_set<Font::Glyph>				mPending, mFailed;
+		};
+
+		// coverage of a single glyph, rows top-down, with its upper-left relative to the pen position on the baseline
+		struct GlyphBitmap {
+			uint32_t				mClient;
+			Font::Glyph				mGlyph;
+			bool					mPremultiply;
+			ivec2					mSize, mOffset;
+			std::vector<uint8_t>	mCoverage;
+		};
+
+		// rasterizes queued glyphs on a worker thread; defined in TextureFont.cpp
+		class Rasterizer;
+
+		uint32_t	addClient();
+		void		removeClient( uint32_t client );
+		const std::unordered_map<Font::Glyph, GlyphInfo>&	getGlyphMap( uint32_t client ) const { return mClients.at( client ).mGlyphMap; }
+		// starts a draw: adds glyphs completed by the Rasterizer and advances the LRU clock
+		void		beginUse();
+		// releases the textures marked by use() and insert() during the current draw, so that insert() may recycle them
+		void		releaseUse() { ++mUseCount; }
+		// marks the texture holding 'glyph' as used by the current draw; returns false if the glyph must be rasterized
+		bool		use( uint32_t client, Font::Glyph glyph );
+		// packs and uploads 'bitmap'; returns false if every texture is full and holds glyphs used by the current draw
+		bool		insert( const GlyphBitmap &bitmap );
+		void		addCompleted();
+		void		regenerateMipmaps();
+		void		clearPage( size_t pageIndex );
+
+		ivec2							mTextureSize;
+		size_t							mMaxTextures;
+		bool							mMipmapping;
+		int32_t							mPadding;
+		uint64_t						mUseCount;
+		size_t							mNumEvictions;
+		uint32_t						mNextClient;
+		std::vector<Page>				mPages;
+		std::vector<gl::TextureRef>		mTextures;
+		std::unordered_map<uint32_t, Client>	mClients;
+		std::unique_ptr<Rasterizer>		mRasterizer;
+		std::vector<uint8_t>			mUploadBuffer;
+
+		friend class TextureFont;
+	};
+
 	//! Returns the current set of characters along with its location into the set of textures
-	const std::unordered_map<Font::Glyph, GlyphInfo>& getGlyphMap() const { return mGlyphMap; }
+	const std::unordered_map<Font::Glyph, GlyphInfo>& getGlyphMap() const { return mAtlas ? mAtlas->getGlyphMap( mAtlasClient ) : mGlyphMap; }
 	//! Returns the vector of gl::TextureRef corresponding to each page of the atlas
-	const std::vector<gl::TextureRef>& getTextures() const { return mTextures; }
+	const std::vector<gl::TextureRef>& getTextures() const { return mAtlas ? mAtlas->getTextures() : mTextures; }
+	//! Returns the dynamic atlas holding the glyphs, or \c nullptr unless Format::dynamicAtlas() or Format::atlas() was set
+	const AtlasRef&	getAtlas() const { return mAtlas; }
 
   protected:
 	TextureFont( const Font &font, const std::string &supportedChars, const Format &format );
 
+	//! Ensures the glyphs of \a glyphMeasures starting at \a begin are in the dynamic atlas, rasterizing or queueing those that are missing.
+	//! Returns the end of the glyphs the atlas could make room for at once.
+	size_t	cacheGlyphs( const std::vector<std::pair<Font::Glyph,vec2> > &glyphMeasures, size_t begin );
+
 	std::unordered_map<Font::Glyph, GlyphInfo>		mGlyphMap;
 	std::vector<gl::TextureRef>						mTextures;
 	Font											mFont;
 	Format											mFormat;
+	AtlasRef										mAtlas;
+	uint32_t										mAtlasClient;
+	bool											mSignedDistanceField; // only the FreeType backend rasterizes distance fields
 
 #if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	std::map<Font::Glyph, Font::GlyphMetrics>  mCachedGlyphMetrics;
@@ -25,7 +25,7 @@
 #pragma once
 
 #include "cinder/Cinder.h"
-#include "cinder/Xml.h"
+#include "cinder/XmlDoc.h"
 #include "cinder/Vector.h"
 #include "cinder/Matrix.h"
 #include "cinder/Color.h"
@@ -37,6 +37,7 @@
 #include "cinder/Noncopyable.h"
 
 #include <functional>
+#include <limits>
 #include <map>
 
 namespace cinder { namespace svg {
@@ -58,7 +59,9 @@ class Ellipse;
 class Polyline;
 class Polygon;
 class Image;
+class ClipPath;
 class ExcChildNotFound;
+class DocSpatialIndex;
 
 typedef std::function<bool(const Node&, svg::Style *)> RenderVisitor;
 
@@ -181,7 +184,7 @@ class CI_API Paint {
 class CI_API Style {
   public:
 	Style();
-	Style( const XmlTree &xml, const Node *parent );
+	Style( const XmlDoc::Node &xml, const Node *parent );
 
 	//! Returns a Style set appropriately for global defaults
 	static Style	makeGlobalDefaults();
@@ -321,7 +324,7 @@ class CI_API Node {
 	//! Returns the style elements defined on this Node but not inherited from ancestors.
 	const Style&		getStyle() const { return mStyle; }
 	//! Sets the style defined on this Node but not inherited from ancestors.
-	void				setStyle( const Style &style ) { mStyle = style; }
+	void				setStyle( const Style &style );
 	//! Returns the node's Style, including attributes inherited from its ancestors for attributes it does not specify
 	Style				calcInheritedStyle() const;
 
@@ -341,9 +344,9 @@ class CI_API Node {
 	//! Returns the local transformation of this node. Returns identity if the Node's transform isn't specified.
 	mat3				getTransform() const { return mTransform; }
 	//! Sets the local transformation of this node.
-	void				setTransform( const mat3 &transform ) { mTransform = transform; mSpecifiesTransform = true; }
+	void				setTransform( const mat3 &transform );
 	//! Removes the local transformation of this node, effectively making it the identity matrix.
-	void				unspecifyTransform() { mSpecifiesTransform = false; }
+	void				unspecifyTransform();
 	//! Returns the inverse of the local transformation of this node. Returns identity if the Node's transform isn't specified.
 	mat3				getTransformInverse() const { return ( mSpecifiesTransform ) ? inverse( mTransform ) : mat3(); }
 	//! Returns the absolute transformation of this node, which includes inherited transformations.
@@ -388,9 +391,16 @@ class CI_API Node {
 	//! Returns whether the Display property of this Node is set to 'None', preventing rendering of the node and its children
 	bool			isDisplayNone() const { return mStyle.isDisplayNone(); }
 
+	//! Returns the ID of the clipPath referenced by this Node's clip-path property, or an empty string when it has none
+	const std::string&	getClipPathId() const { return mClipPathId; }
+	//! Returns the ClipPath referenced by this Node's clip-path property. Returns NULL when it has none or the reference can't be resolved.
+	const ClipPath*		findClipPath() const;
+
 
   protected:
-	Node( Node *parent, const XmlTree &xml );
+	Node( Node *parent, const XmlDoc::Node &xml );
+	// marks the spatial index of the Doc this Node belongs to as stale
+	void			invalidateDocSpatialIndex();
 	// returns whether this type of node directly renders anything. Everything but groups.
 	virtual bool	isDrawable() const { return true; }
 
@@ -415,6 +425,7 @@ class CI_API Node {
 	mat3			mTransform;
 	mutable bool	mBoundingBoxCached;
 	mutable Rectf	mBoundingBox;
+	std::string		mClipPathId;
 	
   private:
   	void			firstStartRender( Renderer &renderer ) const;
@@ -426,11 +437,11 @@ class CI_API Node {
 //! Base class for SVG Gradients. See SVG Gradients: http://www.w3.org/TR/SVG/pservers.html#Gradients
 class CI_API Gradient : public Node {
   public:
-  	Gradient( Node *parent, const XmlTree &xml );
+  	Gradient( Node *parent, const XmlDoc::Node &xml );
 	
 	class CI_API Stop {
 	  public:
-	  	Stop( const Node *parent, const XmlTree &xml );
+	  	Stop( const Node *parent, const XmlDoc::Node &xml );
 		
 		float		mOffset; // normalized 0-1
 		ColorA8u	mColor;
@@ -444,7 +455,7 @@ class CI_API Gradient : public Node {
   protected:
 	virtual void	renderSelf( Renderer & /*renderer*/ ) const {}
 
-	void 		parse( const Node *parent, const XmlTree &xml );
+	void 		parse( const Node *parent, const XmlDoc::Node &xml );
 	void		copyAttributesFrom( const Gradient &rhs );
 	Paint		asPaint() const;
 
@@ -458,12 +469,12 @@ class CI_API Gradient : public Node {
 //! SVG Linear gradient
 class CI_API LinearGradient : public Gradient {
   public:
-	LinearGradient( Node *parent, const XmlTree &xml );
+	LinearGradient( Node *parent, const XmlDoc::Node &xml );
 	
 	Paint		asPaint() const;
 	
   protected:
-	void 		parse( const XmlTree &xml );
+	void 		parse( const XmlDoc::Node &xml );
 	
   	virtual bool	isDrawable() const { return false; }
 };
@@ -471,12 +482,12 @@ class CI_API LinearGradient : public Gradient {
 //! SVG Radial gradient
 class CI_API RadialGradient : public Gradient {
   public:
-	RadialGradient( Node *parent, const XmlTree &xml );
+	RadialGradient( Node *parent, const XmlDoc::Node &xml );
 	
 	Paint		asPaint() const;
 	
   protected:
-	void 		parse( const XmlTree &xml );
+	void 		parse( const XmlDoc::Node &xml );
 
 	virtual bool	isDrawable() const { return false; }
 	float			mRadius;
@@ -486,7 +497,7 @@ class CI_API RadialGradient : public Gradient {
 class CI_API Circle : public Node {
   public:
 	Circle( Node *parent ) : Node( parent ) {}
-	Circle( Node *parent, const XmlTree &xml );
+	Circle( Node *parent, const XmlDoc::Node &xml );
 	
 	vec2		getCenter() const { return mCenter; }
 	void		setCenter( const vec2 &center ) { mCenter = center; }
@@ -509,7 +520,7 @@ class CI_API Circle : public Node {
 class CI_API Ellipse : public Node {
   public:
 	Ellipse( Node *parent ) : Node( parent ) {}
-	Ellipse( Node *parent, const XmlTree &xml );
+	Ellipse( Node *parent, const XmlDoc::Node &xml );
 	
 	vec2		getCenter() const { return mCenter; }
 	void		setCenter( const vec2 &center ) { mCenter = center; }
@@ -534,28 +545,34 @@ class CI_API Ellipse : public Node {
 class CI_API Path : public Node {
   public:
 	Path( Node *parent ) : Node( parent ) {}
-	Path( Node *parent, const XmlTree &xml );
+	Path( Node *parent, const XmlDoc::Node &xml );
 	
-	const Shape2d&		getShape2d() const { return mPath; }
+	//! Returns the path's geometry. If the Doc was loaded with Doc::ParseOptions::lazyPaths(), the path data is parsed by the first call, which must not race with other calls on the same Path.
+	const Shape2d&		getShape2d() const { parseDeferredData(); return mPath; }
 	void				appendShape2d( Shape2d *appendTo ) const;
 
-	bool		containsPoint( const vec2 &pt ) const override { return mPath.contains( pt ); }
+	bool		containsPoint( const vec2 &pt ) const override { return getShape2d().contains( pt ); }
 
-	Shape2d		getShape() const override { return mPath; }
-	void		setShape( const Shape2d &shape ) { mPath = shape; }
+	Shape2d		getShape() const override { return getShape2d(); }
+	void		setShape( const Shape2d &shape ) { mPath = shape; mDeferredData.clear(); }
 
   protected:
 	void	renderSelf( Renderer &renderer ) const override;
-	Rectf	calcBoundingBox() const override { return mPath.calcPreciseBoundingBox(); }
-		
-	Shape2d		mPath;
+	Rectf	calcBoundingBox() const override { return getShape2d().calcPreciseBoundingBox(); }
+
+	void	parseDeferredData() const { if( ! mDeferredData.empty() ) parseData(); }
+	void	parseData() const;
+
+	mutable Shape2d		mPath;
+	//! Unparsed path data, when parsing is deferred to first use
+	mutable std::string	mDeferredData;
 };
 
 //! SVG Line element: http://www.w3.org/TR/SVG/shapes.html#LineElement
 class CI_API Line : public Node {
   public:
 	Line( Node *parent ) : Node( parent ) {}
-	Line( Node *parent, const XmlTree &xml );
+	Line( Node *parent, const XmlDoc::Node &xml );
 	
 	const vec2&	getPoint1() const { return mPoint1; }
 	const vec2&	getPoint2() const { return mPoint2; }
@@ -573,7 +590,7 @@ class CI_API Line : public Node {
 class CI_API Rect : public Node {
   public:
 	Rect( Node *parent ) : Node( parent ) {}
-	Rect( Node *parent, const XmlTree &xml );
+	Rect( Node *parent, const XmlDoc::Node &xml );
 	
 	const Rectf&	getRect() const { return mRect; }
 	void			setRect( const Rectf &rect ) { mRect = rect; }
@@ -595,7 +612,7 @@ class CI_API Rect : public Node {
 class CI_API Polygon : public Node {
   public:
 	Polygon( Node *parent ) : Node( parent ) {}
-	Polygon( Node *parent, const XmlTree &xml );
+	Polygon( Node *parent, const XmlDoc::Node &xml );
 
 	const PolyLine2f&	getPolyLine() const { return mPolyLine; }
 	PolyLine2f&			getPolyLine() { return mPolyLine; }
@@ -615,7 +632,7 @@ class CI_API Polygon : public Node {
 class CI_API Polyline : public Node {
   public:
 	Polyline( Node *parent ) : Node( parent ) {}
-	Polyline( Node *parent, const XmlTree &xml );
+	Polyline( Node *parent, const XmlDoc::Node &xml );
 
 	const PolyLine2f&	getPolyLine() const { return mPolyLine; }
 	PolyLine2f&			getPolyLine() { return mPolyLine; }
@@ -634,17 +651,18 @@ class CI_API Polyline : public Node {
 //! SVG Use Element, which instantiates a different element: http://www.w3.org/TR/SVG/struct.html#UseElement
 class CI_API Use : public Node {
   public:
-	Use( Node *parent, const XmlTree &xml );
+	Use( Node *parent, const XmlDoc::Node &xml );
 	
 	virtual bool	isDrawable() const { return false; }
 	
+	virtual bool	containsPoint( const vec2 &pt ) const { return mReferenced && mReferenced->containsPoint( pt ); }
 	virtual Shape2d	getShape() const{ if( mReferenced ) return mReferenced->getShape(); else return Shape2d(); }
 
   protected:
 	virtual void	renderSelf( Renderer &renderer ) const;  
 	virtual Rectf	calcBoundingBox() const { if( mReferenced ) return mReferenced->getBoundingBox(); else return Rectf(0,0,0,0); }
 	
-	void parse( const XmlTree &xml );
+	void parse( const XmlDoc::Node &xml );
 	
 	const Node		*mReferenced;
 };
@@ -652,7 +670,7 @@ class CI_API Use : public Node {
 //! SVG Image Element. Represents an unpremultiplied bitmap. http://www.w3.org/TR/SVG/struct.html#ImageElement
 class CI_API Image : public Node {
   public:
-	Image( Node *parent, const XmlTree &xml );
+	Image( Node *parent, const XmlDoc::Node &xml );
 
 	const Rectf&						getRect() const { return mRect; }
 	const std::shared_ptr<Surface8u>	getSurface() const { return mImage; }
@@ -678,7 +696,7 @@ class CI_API TextSpan : public Node {
 	class CI_API Attributes {
 	  public:
 		Attributes() {}
-		Attributes( const XmlTree &xml );
+		Attributes( const XmlDoc::Node &xml );
 
 		void 	startRender( Renderer &renderer ) const;
 		void 	finishRender( Renderer &renderer ) const;
@@ -693,7 +711,7 @@ class CI_API TextSpan : public Node {
 		std::vector<Value>	mLetterSpacing;
 	};
 
-	TextSpan( Node *parent, const XmlTree &xml );
+	TextSpan( Node *parent, const XmlDoc::Node &xml );
 	TextSpan( Node *parent, const std::string &spanString );
 	
 	const std::string&						getString() const { return mString; }
@@ -727,7 +745,7 @@ class CI_API TextSpan : public Node {
 //! SVG Text element. http://www.w3.org/TR/SVG/text.html#TextElement
 class CI_API Text : public Node {
   public:
-  	Text( Node *parent, const XmlTree &xml );
+  	Text( Node *parent, const XmlDoc::Node &xml );
 
 	vec2 	getTextPen() const;
 	void	setTextPen( const vec2 &textPen ) { mAttributes.setTextPen( textPen ); }  
@@ -749,7 +767,7 @@ class CI_API Text : public Node {
 class CI_API Group : public Node, private Noncopyable {
   public:
 	Group( Node *parent ) : Node( parent ) {}
-	Group( Node *parent, const XmlTree &xml );
+	Group( Node *parent, const XmlDoc::Node &xml );
 	~Group();
 
 	//! Recursively searches for a child element of type <tt>svg::T</tt> named \a id. Returns NULL on failure to find the object or if it is not of type T.
@@ -794,6 +812,8 @@ class CI_API Group : public Node, private Noncopyable {
 	virtual void		iterate( const std::function<void(Node*)> &fn );
 
   protected:
+	// adds \a node to mDefs, creating it if necessary
+	void		addDef( Node *node );
 	Node*		nodeUnderPoint( const vec2 &absolutePoint, const mat3 &parentInverseMatrix ) const;
 	Shape2d		getMergedShape2d() const;
 
@@ -801,24 +821,66 @@ class CI_API Group : public Node, private Noncopyable {
 	virtual Rectf	calcBoundingBox() const;
 
 	virtual bool	isDrawable() const { return false; }
-	void 			parse( const XmlTree &xml );
+	void 			parse( const XmlDoc::Node &xml );
 
 	std::list<Node*>		mChildren;
 	std::shared_ptr<Group>	mDefs;
 };
 
+//! SVG clipPath element, which is never rendered but restricts the region drawn by the Nodes referencing it through their clip-path property. http://www.w3.org/TR/SVG/masking.html#EstablishingANewClippingPath
+class CI_API ClipPath : public Group {
+  public:
+	ClipPath( Node *parent, const XmlDoc::Node &xml );
+
+	//! Returns whether the clip path's contents are expressed in fractions of the clipped Node's bounding box (clipPathUnits="objectBoundingBox")
+	bool			isObjectBoundingBoxUnits() const { return mObjectBoundingBoxUnits; }
+	//! Returns the transformation from the clip path's contents to the local coordinates of \a clipped
+	mat3			calcTransformTo( const Node &clipped ) const;
+
+	//! Returns whether \a pt, in the clip path's local coordinates, is inside any of its children
+	bool			containsPoint( const vec2 &pt ) const override;
+
+  protected:
+	void			renderSelf( Renderer & /*renderer*/ ) const override {}
+	//! Returns the bounds of the children in the clip path's local coordinates
+	Rectf			calcBoundingBox() const override;
+
+	bool			mObjectBoundingBoxUnits;
+};
+
 
 typedef std::shared_ptr<Doc>	DocRef;
 //! Represents an SVG Document. See SVG Document Structure http://www.w3.org/TR/SVG/struct.html
 class CI_API Doc : public Group {
   public:
+	//! Options for loading a Doc. Passed to the Doc constructor.
+	class CI_API ParseOptions {
+	  public:
+		//! Default options. Parses path data while loading.
+		ParseOptions() : mLazyPaths( false ) {}
+
+		//! Sets whether path data is parsed on first use instead of while loading, which speeds up loading documents whose geometry isn't all needed. Malformed path data then yields an empty path rather than an exception.
+		ParseOptions& lazyPaths( bool lazy = true ) { mLazyPaths = lazy; return *this; }
+
+		//! Returns whether path data is parsed on first use instead of while loading.
+		bool	getLazyPaths() const { return mLazyPaths; }
+		//! Sets whether path data is parsed on first use instead of while loading.
+		void	setLazyPaths( bool lazy = true ) { mLazyPaths = lazy; }
+
+	  private:
+		bool	mLazyPaths;
+	};
+
 	Doc() : Group( 0 ), mWidth( 0 ), mHeight( 0 ) {}
-	Doc( const fs::path &filePath );
-	Doc( DataSourceRef dataSource, const fs::path &filePath = fs::path() );
+	Doc( const fs::path &filePath, const ParseOptions &options = ParseOptions() );
+	Doc( DataSourceRef dataSource, const fs::path &filePath = fs::path(), const ParseOptions &options = ParseOptions() );
+
+	static DocRef	create( const fs::path &filePath, const ParseOptions &options = ParseOptions() );
+	static DocRef	create( DataSourceRef dataSource, const fs::path &filePath = fs::path(), const ParseOptions &options = ParseOptions() );
+	static DocRef	createFromSvgz( DataSourceRef dataSource, const fs::path &filePath = fs::path(), const ParseOptions &options = ParseOptions() );
 
-	static DocRef	create( const fs::path &filePath );
-	static DocRef	create( DataSourceRef dataSource, const fs::path &filePath = fs::path() );
-	static DocRef	createFromSvgz( DataSourceRef dataSource, const fs::path &filePath = fs::path() );
+	//! Returns the options the Doc was loaded with
+	const ParseOptions&	getParseOptions() const { return mParseOptions; }
 
 	//! Returns the width of the document in pixels
 	int32_t		getWidth() const { return mWidth; }
@@ -836,6 +898,16 @@ class CI_API Doc : public Group {
 	
 	//! Returns the top-most Node which contains \a pt. Returns NULL if no Node contains the point.
 	Node*		nodeUnderPoint( const vec2 &pt );
+
+	//! Returns the innermost Node drawn at \a pt: the last in paint order whose shape and clip paths contain it, skipping hidden and display:none Nodes. Returns NULL if there is none.
+	//! Like the other spatial queries, this uses an index of the Doc's absolute Node bounds which is built on first use.
+	Node*				findInnermostNode( const vec2 &pt );
+	//! Returns every drawn Node whose absolute bounding box, restricted by its clip paths, intersects \a rect. Results are in paint order.
+	std::vector<Node*>	findNodesInRect( const Rectf &rect );
+	//! Returns the drawn Node whose outline is nearest to \a pt, or NULL if none is within \a maxDistance. Nodes containing \a pt are at distance 0. Writes the distance to \a resultDistance if it is non-NULL.
+	Node*				findNearestNode( const vec2 &pt, float maxDistance = std::numeric_limits<float>::max(), float *resultDistance = nullptr );
+	//! Discards the spatial index so that it is rebuilt on the next query. Node::setTransform() and Node::setStyle() call this automatically, but it must be called after adding or removing children.
+	void				invalidateSpatialIndex() { mSpatialIndex.reset(); }
 	
 	//! Utility function to load an image relative to the document. Caches results.
 	std::shared_ptr<Surface8u>	loadImage( fs::path relativePath );
@@ -844,12 +916,14 @@ class CI_API Doc : public Group {
 
 	virtual void		renderSelf( Renderer &renderer ) const;
   
-	std::shared_ptr<XmlTree>	mXmlTree;
+	ParseOptions		mParseOptions;
 	std::map<fs::path,std::shared_ptr<Surface8u> >	mImageCache;
 	
 	fs::path		mFilePath;
 	Area			mViewBox;
 	int32_t			mWidth, mHeight;
+
+	std::shared_ptr<DocSpatialIndex>	mSpatialIndex;
 };
 
 //! SVG Exception base-class
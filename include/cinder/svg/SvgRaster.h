@@ -0,0 +1,166 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/svg/Svg.h"
+#include "cinder/PathFlattener.h"
+#include "cinder/Surface.h"
+
+#include <vector>
+
+namespace cinder {
+
+//! svg::Renderer which rasterizes on the CPU, requiring neither Cairo nor OpenGL.
+//! Rendering records fills, with strokes already expanded to outlines, in device coordinates. rasterize() then composites them
+//! over a Surface tile by tile, in parallel, with analytic anti-aliasing: the exact area each edge covers is accumulated per pixel.
+//! Supports solid, linear and radial gradient paints, nonzero and evenodd fill rules, stroke joins and caps, and group opacity.
+//! Images and text are not drawn.
+class CI_API SvgRendererRaster : public svg::Renderer {
+  public:
+	//! Constructs a renderer whose output is transformed by \a transform, which maps document coordinates to pixels.
+	SvgRendererRaster( const mat3 &transform = mat3() );
+
+	//! Composites everything rendered so far over \a surface. Unless \a surface is premultiplied, colors are stored unpremultiplied.
+	void	rasterize( Surface8u *surface ) const;
+	//! Composites everything rendered so far over \a surface. Unless \a surface is premultiplied, colors are stored unpremultiplied.
+	void	rasterize( Surface32f *surface ) const;
+	//! Discards everything rendered so far.
+	void	clear();
+
+	//! Sets the width and height of the square tiles rasterized in parallel. Defaults to \c 64.
+	void	setTileSize( int32_t tileSize )	{ mTileSize = std::max( 8, tileSize ); }
+	int32_t	getTileSize() const				{ return mTileSize; }
+
+	void	pushGroup( const svg::Group &group, float opacity ) override;
+	void	popGroup() override;
+	void	drawPath( const svg::Path &path ) override;
+	void	drawPolyline( const svg::Polyline &polyline ) override;
+	void	drawPolygon( const svg::Polygon &polygon ) override;
+	void	drawLine( const svg::Line &line ) override;
+	void	drawRect( const svg::Rect &rect ) override;
+	void	drawCircle( const svg::Circle &circle ) override;
+	void	drawEllipse( const svg::Ellipse &ellipse ) override;
+
+	void	pushMatrix( const mat3 &m ) override		{ mMatrixStack.push_back( mMatrixStack.back() * m ); }
+	void	popMatrix() override						{ mMatrixStack.pop_back(); }
+	void	pushFill( const svg::Paint &paint ) override	{ mFillStack.push_back( paint ); }
+	void	popFill() override							{ mFillStack.pop_back(); }
+	void	pushStroke( const svg::Paint &paint ) override	{ mStrokeStack.push_back( paint ); }
+	void	popStroke() override						{ mStrokeStack.pop_back(); }
+	void	pushFillOpacity( float opacity ) override	{ mFillOpacityStack.push_back( opacity ); }
+	void	popFillOpacity() override					{ mFillOpacityStack.pop_back(); }
+	void	pushStrokeOpacity( float opacity ) override	{ mStrokeOpacityStack.push_back( opacity ); }
+	void	popStrokeOpacity() override					{ mStrokeOpacityStack.pop_back(); }
+	void	pushStrokeWidth( float width ) override		{ mStrokeWidthStack.push_back( width ); }
+	void	popStrokeWidth() override					{ mStrokeWidthStack.pop_back(); }
+	void	pushFillRule( svg::FillRule rule ) override	{ mFillRuleStack.push_back( rule ); }
+	void	popFillRule() override						{ mFillRuleStack.pop_back(); }
+	void	pushLineCap( svg::LineCap lineCap ) override	{ mLineCapStack.push_back( lineCap ); }
+	void	popLineCap() override						{ mLineCapStack.pop_back(); }
+	void	pushLineJoin( svg::LineJoin lineJoin ) override	{ mLineJoinStack.push_back( lineJoin ); }
+	void	popLineJoin() override						{ mLineJoinStack.pop_back(); }
+
+  private:
+	enum { RAMP_SIZE = 256 };
+
+	// an edge in device coordinates, oriented so that mY0 < mY1; mWinding is +1 when the original edge pointed down and -1 otherwise
+	struct Edge {
+		float	mX0, mY0, mX1, mY1;
+		float	mWinding;
+	};
+
+	// a paint resolved to device coordinates, with gradients expanded into a ramp of premultiplied colors
+	struct RasterPaint {
+		enum Type { SOLID, LINEAR_GRADIENT, RADIAL_GRADIENT };
+
+		Type				mType;
+		ColorAf				mColor; // premultiplied, SOLID only
+		mat3				mDeviceToGradient;
+		vec2				mStart, mEnd; // LINEAR_GRADIENT only
+		vec2				mCenter, mFocus; // RADIAL_GRADIENT only
+		float				mRadius;
+		std::vector<ColorAf>	mRamp;
+	};
+
+	// a recorded drawing command; group commands bracket everything drawn within a group whose opacity is below 1
+	struct Command {
+		enum Type { FILL, PUSH_GROUP, POP_GROUP };
+
+		Type		mType;
+		Rectf		mBounds; // device coordinates
+		uint32_t	mFirstEdge, mNumEdges; // FILL only; edges are sorted by mY0
+		bool		mEvenOdd; // FILL only
+		uint32_t	mPaint; // FILL only
+		float		mOpacity; // PUSH_GROUP only
+	};
+
+	// rasterizes the commands overlapping a single tile; defined in SvgRaster.cpp
+	class Tile;
+
+	// fills and strokes 'shape' according to the current style
+	void	drawShape( const svg::Node &node, const Shape2d &shape, bool fillable = true );
+	// expands the stroke of the first mNumContours of mContours into outlines, replacing them
+	void	expandStroke( const std::vector<uint8_t> &closed, float halfWidth, float tolerance );
+	// records the first mNumContours of mContours, transformed by the current matrix, as a single fill
+	void	addFill( const svg::Node &node, bool evenOdd, const svg::Paint &paint, float opacity );
+	bool	resolvePaint( const svg::Node &node, const svg::Paint &paint, float opacity, RasterPaint *result ) const;
+	float	calcTolerance() const;
+
+	template<typename T>
+	void	rasterizeImpl( SurfaceT<T> *surface ) const;
+
+	int32_t						mTileSize;
+
+	std::vector<mat3>			mMatrixStack;
+	std::vector<svg::Paint>		mFillStack, mStrokeStack;
+	std::vector<float>			mFillOpacityStack, mStrokeOpacityStack;
+	std::vector<float>			mStrokeWidthStack;
+	std::vector<svg::FillRule>	mFillRuleStack;
+	std::vector<svg::LineCap>	mLineCapStack;
+	std::vector<svg::LineJoin>	mLineJoinStack;
+	std::vector<int32_t>		mGroupStack; // index of each open PUSH_GROUP command, or -1 for groups that needed none
+
+	std::vector<Command>		mCommands;
+	std::vector<Edge>			mEdges;
+	std::vector<RasterPaint>	mPaints;
+
+	// scratch space reused between shapes
+	PathFlattener					mFlattener;
+	std::vector<std::vector<vec2>>	mContours;
+	size_t							mNumContours;
+};
+
+namespace svg {
+
+//! Rasterizes \a doc on the CPU into a new transparent Surface8u of \a size, scaling the document to fill it. A \a size of zero uses the document's size.
+CI_API Surface8u	rasterize( const Doc &doc, const ivec2 &size = ivec2( 0 ) );
+//! Rasterizes \a doc on the CPU over the contents of \a surface. \a transform maps document coordinates to pixels.
+CI_API void			rasterize( const Doc &doc, Surface8u *surface, const mat3 &transform = mat3() );
+//! Rasterizes \a doc on the CPU over the contents of \a surface. \a transform maps document coordinates to pixels.
+CI_API void			rasterize( const Doc &doc, Surface32f *surface, const mat3 &transform = mat3() );
+
+} // namespace svg
+
+} // namespace cinder
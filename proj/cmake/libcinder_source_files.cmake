@@ -34,6 +34,8 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/ImageSourceFileStbImage.cpp
 	${CINDER_SRC_DIR}/cinder/ImageTargetFileStbImage.cpp
 	${CINDER_SRC_DIR}/cinder/Json.cpp
+	${CINDER_SRC_DIR}/cinder/JsonDoc.cpp
+	${CINDER_SRC_DIR}/cinder/JsonStream.cpp
 	${CINDER_SRC_DIR}/cinder/Log.cpp
 	${CINDER_SRC_DIR}/cinder/Matrix.cpp
 	${CINDER_SRC_DIR}/cinder/MediaTime.cpp
@@ -42,26 +44,33 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Perlin.cpp
 	${CINDER_SRC_DIR}/cinder/Plane.cpp
 	${CINDER_SRC_DIR}/cinder/PolyLine.cpp
+	${CINDER_SRC_DIR}/cinder/PolyLineBoolean.cpp
 	${CINDER_SRC_DIR}/cinder/Rand.cpp
 	${CINDER_SRC_DIR}/cinder/Ray.cpp
 	${CINDER_SRC_DIR}/cinder/Rect.cpp
 	${CINDER_SRC_DIR}/cinder/Shape2d.cpp
+	${CINDER_SRC_DIR}/cinder/SkylinePacker.cpp
+	${CINDER_SRC_DIR}/cinder/PathFlattener.cpp
 	${CINDER_SRC_DIR}/cinder/Signals.cpp
 	${CINDER_SRC_DIR}/cinder/Sphere.cpp
 	${CINDER_SRC_DIR}/cinder/Stream.cpp
 	${CINDER_SRC_DIR}/cinder/Surface.cpp
 	${CINDER_SRC_DIR}/cinder/System.cpp
 	${CINDER_SRC_DIR}/cinder/Text.cpp
+	${CINDER_SRC_DIR}/cinder/Thread.cpp
 	${CINDER_SRC_DIR}/cinder/Timeline.cpp
 	${CINDER_SRC_DIR}/cinder/TimelineItem.cpp
 	${CINDER_SRC_DIR}/cinder/Timer.cpp
 	${CINDER_SRC_DIR}/cinder/Triangulate.cpp
 	${CINDER_SRC_DIR}/cinder/TriMesh.cpp
+	${CINDER_SRC_DIR}/cinder/TriMeshSimplify.cpp
+	${CINDER_SRC_DIR}/cinder/TriMeshOptimize.cpp
 	${CINDER_SRC_DIR}/cinder/Tween.cpp
 	${CINDER_SRC_DIR}/cinder/Unicode.cpp
 	${CINDER_SRC_DIR}/cinder/Url.cpp
 	${CINDER_SRC_DIR}/cinder/Utilities.cpp
 	${CINDER_SRC_DIR}/cinder/Xml.cpp
+	${CINDER_SRC_DIR}/cinder/XmlDoc.cpp
 )
 
 if( ( NOT CINDER_LINUX ) AND ( NOT CINDER_ANDROID ) )
@@ -206,6 +215,7 @@ source_group( "cinder\\ip" FILES    ${SRC_SET_CINDER_IP} )
 
 list( APPEND SRC_SET_CINDER_SVG
 	${CINDER_SRC_DIR}/cinder/svg/Svg.cpp
+	${CINDER_SRC_DIR}/cinder/svg/SvgRaster.cpp
 )
 
 list( APPEND CINDER_SRC_FILES       ${SRC_SET_CINDER_SVG} )
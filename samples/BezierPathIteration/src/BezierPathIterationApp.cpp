@@ -25,7 +25,7 @@ class BezierPathIterationApp : public App {
 		PathIter( const Path2dCalcCache& pathCache, float initialDistance )
 			: mPathCache( pathCache ), mCurrentDistance( initialDistance )
 		{
-			mLastPos = mPathCache.getPosition( mPathCache.calcTimeForDistance( mCurrentDistance ) );
+			mLastPos = mPathCache.getPositionAtDistance( mCurrentDistance );
 		}
 		
 		const Path2dCalcCache&	mPathCache;
@@ -89,8 +89,7 @@ void BezierPathIterationApp::draw()
 	gl::color( Color( 1.0f, 0.5f, 0.25f ) );
 	for( auto &pathIt : mPathIters ) {
 		pathIt.mCurrentDistance += 3.0f; // move 3 units along the path
-		float newTime = pathIt.mPathCache.calcTimeForDistance( pathIt.mCurrentDistance );
-		vec2 pos = pathIt.mPathCache.getPosition( newTime );
+		vec2 pos = pathIt.mPathCache.getPositionAtDistance( pathIt.mCurrentDistance );
 		
 		gl::drawLine( pathIt.mLastPos, pos );
 		pathIt.mLastPos = pos;
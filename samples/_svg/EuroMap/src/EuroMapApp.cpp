@@ -56,7 +56,7 @@ void EuroMapApp::setup()
 
 void EuroMapApp::mouseMove( MouseEvent event )
 {
-	svg::Node *newNode = mMapDoc->nodeUnderPoint( event.getPos() );
+	svg::Node *newNode = mMapDoc->findInnermostNode( event.getPos() );
 	if( newNode != mCurrentCountry )
 		timeline().apply( &mCurrentCountryAlpha, 0.0f, 1.0f, 0.35f );
 	mCurrentCountry = newNode;
@@ -27,6 +27,16 @@
 #include "cinder/Log.h"
 #include "cinder/Utilities.h"
 
+#if defined( CINDER_LINUX )
+	#include <sys/eventfd.h>
+	#include <sys/inotify.h>
+	#include <cerrno>
+	#include <cmath>
+	#include <map>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
 //#define LOG_UPDATE( stream )	CI_LOG_I( stream )
 #define LOG_UPDATE( stream )	( (void)( 0 ) )
 
@@ -42,8 +52,8 @@ class Watch : public std::enable_shared_from_this<Watch>, private Noncopyable {
 
 	signals::Connection	connect( const function<void ( const WatchEvent& )> &callback )	{ return mSignalChanged.connect( callback ); }
 
-	//! Checks if the asset file is up-to-date. Also may discard the Watch if there are no more connected slots.
-	void checkCurrent();
+	//! Checks if the asset files in \a filePaths, or all of them if null, are up-to-date. Also may discard the Watch if there are no more connected slots.
+	void checkCurrent( const std::set<fs::path> *filePaths = nullptr );
 	//! Remove any watches for \a filePath. If it is the last file associated with this Watch, discard
 	void unwatch( const fs::path &filePath );
 	//! Emit the signal callback. 
@@ -157,7 +167,7 @@ Watch::Watch( const vector<fs::path> &filePaths, bool needsCallback )
 
 }
 
-void Watch::checkCurrent()
+void Watch::checkCurrent( const set<fs::path> *filePaths )
 {
 	// Discard when there are no more connected slots
 	if( mSignalChanged.getNumSlots() == 0 ) {
@@ -165,14 +175,21 @@ void Watch::checkCurrent()
 		return;
 	}
 
-	mModifiedFilePaths.clear();
+	// a Watch still waiting for its callback accumulates further modifications
+	if( ! needsCallback() )
+		mModifiedFilePaths.clear();
+
 	for( auto &item : mWatchItems ) {
+		if( filePaths && ! filePaths->count( item.mFilePath ) )
+			continue;
+
 		try {
 			if( item.mEnabled && fs::exists( item.mFilePath ) ) {
 				auto timeLastWrite = fs::last_write_time( item.mFilePath );
 				if( item.mTimeStamp < timeLastWrite ) {
 					item.mTimeStamp = timeLastWrite;
-					mModifiedFilePaths.emplace_back( item.mFilePath );
+					if( find( mModifiedFilePaths.begin(), mModifiedFilePaths.end(), item.mFilePath ) == mModifiedFilePaths.end() )
+						mModifiedFilePaths.emplace_back( item.mFilePath );
 					setNeedsCallback( true );
 				}
 			}
@@ -223,6 +240,183 @@ void Watch::emitCallback()
 	setNeedsCallback( false );
 } 
 
+// ----------------------------------------------------------------------------------------------------
+// FileWatcher::Notifier
+// ----------------------------------------------------------------------------------------------------
+
+#if defined( CINDER_LINUX )
+
+//! Watches directories with inotify. A file's changes are reported by its directory's watch, so the number of kernel watches
+//! is the number of distinct directories. setDirectories() may be called from any thread while another one waits.
+class FileWatcher::Notifier : private Noncopyable {
+  public:
+	Notifier()
+		: mInotifyFd( -1 ), mWakeFd( -1 ), mNeedsUpdate( false )
+	{}
+
+	~Notifier()
+	{
+		if( mInotifyFd >= 0 )
+			::close( mInotifyFd );
+		if( mWakeFd >= 0 )
+			::close( mWakeFd );
+	}
+
+	//! Returns false if inotify is unavailable
+	bool open()
+	{
+		mInotifyFd = ::inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+		mWakeFd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+		return mInotifyFd >= 0 && mWakeFd >= 0;
+	}
+
+	//! Interrupts wait(). May be called from any thread.
+	void wake()
+	{
+		uint64_t value = 1;
+		if( ::write( mWakeFd, &value, sizeof( value ) ) < 0 ) {
+			// the counter is already non-zero, so the thread wakes anyway
+		}
+	}
+
+	//! Returns whether a watched directory was removed or moved, so setDirectories() should be called again
+	bool needsUpdate() const	{ return mNeedsUpdate; }
+
+	//! Returns the directories which could not be watched by the last setDirectories()
+	set<fs::path> getFailedDirectories() const
+	{
+		lock_guard<mutex> lock( mMutex );
+		return mFailedDirectories;
+	}
+
+	//! Watches exactly \a directories. Returns false if the system limit of watches was reached.
+	bool setDirectories( const set<fs::path> &directories )
+	{
+		lock_guard<mutex> lock( mMutex );
+		mNeedsUpdate = false;
+		mFailedDirectories.clear();
+		for( auto it = mDirectories.begin(); it != mDirectories.end(); /* */ ) {
+			if( directories.count( it->first ) )
+				++it;
+			else
+				it = removeDirectory( it );
+		}
+
+		for( const auto &directory : directories ) {
+			if( mDirectories.count( directory ) )
+				continue;
+
+			// the same directory reached through different paths shares its watch descriptor
+			const int wd = ::inotify_add_watch( mInotifyFd, directory.c_str(), IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_MODIFY | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR );
+			if( wd < 0 ) {
+				if( errno == ENOSPC || errno == ENOMEM )
+					return false;
+				mFailedDirectories.insert( directory );
+				continue;
+			}
+
+			mDirectories[directory] = wd;
+			mWatchDescriptors[wd].push_back( directory );
+		}
+
+		return true;
+	}
+
+	//! Waits up to \a timeoutSeconds for changes, adding the paths of changed files to \a changedFiles. Sets \a overflowed if changes
+	//! were lost, in which case any file may have changed. Returns the number of changes.
+	size_t wait( double timeoutSeconds, set<fs::path> *changedFiles, bool *overflowed )
+	{
+		pollfd fds[2] = { { mInotifyFd, POLLIN, 0 }, { mWakeFd, POLLIN, 0 } };
+		const int timeoutMilliseconds = (int)std::ceil( std::max( timeoutSeconds, 0.0 ) * 1000 );
+		if( ::poll( fds, 2, timeoutMilliseconds ) <= 0 )
+			return 0;
+
+		if( fds[1].revents & POLLIN ) {
+			uint64_t value;
+			if( ::read( mWakeFd, &value, sizeof( value ) ) < 0 ) {
+				// another read already reset the counter
+			}
+		}
+
+		lock_guard<mutex> lock( mMutex );
+		size_t result = 0;
+		alignas( inotify_event ) char buffer[16 * 1024];
+		while( true ) {
+			const ssize_t length = ::read( mInotifyFd, buffer, sizeof( buffer ) );
+			if( length <= 0 )
+				break;
+
+			for( const char *ptr = buffer; ptr < buffer + length; ) {
+				const inotify_event *event = reinterpret_cast<const inotify_event*>( ptr );
+				ptr += sizeof( inotify_event ) + event->len;
+
+				if( event->mask & IN_Q_OVERFLOW ) {
+					*overflowed = true;
+					++result;
+				}
+				else if( event->mask & ( IN_IGNORED | IN_MOVE_SELF ) ) {
+					// the directory was removed or moved; its path may need a new watch
+					auto it = mWatchDescriptors.find( event->wd );
+					if( it != mWatchDescriptors.end() ) {
+						for( const auto &directory : it->second )
+							mDirectories.erase( directory );
+						if( event->mask & IN_MOVE_SELF )
+							::inotify_rm_watch( mInotifyFd, event->wd );
+						mWatchDescriptors.erase( it );
+					}
+					mNeedsUpdate = true;
+				}
+				else if( event->len ) {
+					auto it = mWatchDescriptors.find( event->wd );
+					if( it != mWatchDescriptors.end() ) {
+						for( const auto &directory : it->second )
+							changedFiles->insert( directory / event->name );
+						++result;
+					}
+				}
+			}
+		}
+
+		return result;
+	}
+
+  private:
+	map<fs::path, int>::iterator removeDirectory( map<fs::path, int>::iterator it )
+	{
+		const int wd = it->second;
+		auto &paths = mWatchDescriptors[wd];
+		paths.erase( remove( paths.begin(), paths.end(), it->first ), paths.end() );
+		if( paths.empty() ) {
+			::inotify_rm_watch( mInotifyFd, wd );
+			mWatchDescriptors.erase( wd );
+		}
+
+		return mDirectories.erase( it );
+	}
+
+	int								mInotifyFd;
+	int								mWakeFd;
+	mutable mutex					mMutex; // guards everything below
+	atomic<bool>					mNeedsUpdate;
+	map<fs::path, int>				mDirectories;
+	map<int, vector<fs::path>>		mWatchDescriptors; // with every watched path of each directory
+	set<fs::path>					mFailedDirectories;
+};
+
+#else
+
+class FileWatcher::Notifier : private Noncopyable {
+  public:
+	bool	open()			{ return false; }
+	void	wake()			{}
+	bool	needsUpdate() const	{ return false; }
+	bool	setDirectories( const set<fs::path> &directories )	{ return false; }
+	set<fs::path>	getFailedDirectories() const		{ return set<fs::path>(); }
+	size_t	wait( double timeoutSeconds, set<fs::path> *changedFiles, bool *overflowed )	{ return 0; }
+};
+
+#endif
+
 // ----------------------------------------------------------------------------------------------------
 // FileWatcher
 // ----------------------------------------------------------------------------------------------------
@@ -299,6 +493,8 @@ signals::Connection FileWatcher::watch( const vector<fs::path> &filePaths, const
 		watch->emitCallback();
 
 	configureWatchPolling();
+	// watch before returning, so that modifications made right after are reported
+	updateWatchedDirectories();
 
 	return conn;
 }
@@ -318,6 +514,8 @@ void FileWatcher::unwatch( const fs::path &filePath )
 		}
 		++it;
 	}
+
+	updateWatchedDirectories();
 }
 
 void FileWatcher::unwatch( const vector<fs::path> &filePaths )
@@ -358,6 +556,19 @@ void FileWatcher::configureWatchPolling()
 		connectAppUpdate();
 
 	if( ! mThread.joinable() ) {
+		mNotifier.reset();
+		mActiveBackend = BACKEND_POLLING;
+		if( mBackend != BACKEND_POLLING ) {
+			unique_ptr<Notifier> notifier( new Notifier );
+			if( notifier->open() ) {
+				mNotifier = move( notifier );
+				mActiveBackend = BACKEND_NATIVE;
+				updateWatchedDirectories();
+			}
+			else if( mBackend == BACKEND_NATIVE )
+				CI_LOG_W( "native file change notifications are unavailable, polling instead" );
+		}
+
 		mThreadShouldQuit = false;
 		mThread = thread( std::bind( &FileWatcher::threadEntry, this ) );
 	}
@@ -368,50 +579,177 @@ void FileWatcher::stopWatchPolling()
 	mConnectionAppUpdate.disconnect();
 
 	mThreadShouldQuit = true;
+	if( mNotifier )
+		mNotifier->wake();
 	if( mThread.joinable() ) {
 		mThread.join();
 	}
 }
 
+void FileWatcher::setBackend( Backend backend )
+{
+	if( mBackend == backend )
+		return;
+
+	const bool running = mThread.joinable();
+	stopWatchPolling();
+	mBackend = backend;
+	if( running )
+		configureWatchPolling();
+}
+
+void FileWatcher::updateWatchedDirectories()
+{
+	if( ! mNotifier || mActiveBackend != BACKEND_NATIVE )
+		return;
+
+	lock_guard<recursive_mutex> lock( mMutex );
+	set<fs::path> directories;
+	for( const auto &watch : mWatchList ) {
+		for( const auto &item : watch->getItems() )
+			directories.insert( item.mFilePath.parent_path() );
+	}
+
+	if( ! mNotifier->setDirectories( directories ) ) {
+		CI_LOG_W( "reached the system limit of inotify watches, polling instead" );
+		mActiveBackend = BACKEND_POLLING;
+		mNotifier->wake();
+	}
+}
+
 void FileWatcher::threadEntry()
 {
 	setThreadName( "cinder::FileWatcher" );
 
+	// the native backend returns early if it fails, after switching mActiveBackend to polling
+	if( mNotifier )
+		waitForNotifications();
+	if( mActiveBackend == BACKEND_POLLING )
+		pollWatches();
+}
+
+void FileWatcher::pollWatches()
+{
 	while( ! mThreadShouldQuit ) {
 		LOG_UPDATE( "epoch seconds: " << getElapsedSeconds() );
 
-        // scope the lock outside of the sleep
-        {
-            lock_guard<recursive_mutex> lock( mMutex );
-
-            LOG_UPDATE( "\t - updating watches, elapsed seconds: " << getElapsedSeconds() );
-
-            for( auto it = mWatchList.begin(); it != mWatchList.end(); /* */ ) {
-                const auto &watch = *it;
-                
-                // erase discarded
-                if( watch->isDiscarded() ) {
-                    it = mWatchList.erase( it );
-                    continue;
-                }
-                // check if Watch's target has been modified and needs a callback, if not already marked.
-                if( ! watch->needsCallback() ) {
-                    watch->checkCurrent();
-                    
-                    // If the Watch needs a callback, move it to the front of the list
-                    if( watch->needsCallback() && it != mWatchList.begin() ) {
-                        mWatchList.splice( mWatchList.begin(), mWatchList, it );
-                    }
-                }
-                
-                ++it;
-            }
-        }
+		// scope the lock outside of the sleep
+		{
+			lock_guard<recursive_mutex> lock( mMutex );
+
+			LOG_UPDATE( "\t - updating watches, elapsed seconds: " << getElapsedSeconds() );
+			checkWatches( nullptr );
+		}
 			
 		this_thread::sleep_for( chrono::duration<double>( mThreadUpdateInterval ) );
 	}
 }
 
+void FileWatcher::waitForNotifications()
+{
+	// Discarded watches, and files whose directory could not be watched, are checked this often
+	const double housekeepingInterval = 1.0;
+
+	set<fs::path> changedFiles;
+	bool overflowed = false;
+	double firstChangeTime = 0, lastChangeTime = 0, nextHousekeepingTime = 0;
+
+	while( ! mThreadShouldQuit ) {
+		if( mNotifier->needsUpdate() )
+			updateWatchedDirectories();
+		// updating the directories falls back to polling if it fails
+		if( mActiveBackend != BACKEND_NATIVE )
+			return;
+
+		// a burst of changes is reported once it has been quiet for the debounce interval, or has lasted ten times as long
+		const double debounceInterval = mDebounceInterval;
+		const bool changesPending = ! changedFiles.empty() || overflowed;
+		double deadline = nextHousekeepingTime;
+		if( changesPending )
+			deadline = std::min( deadline, std::min( lastChangeTime + debounceInterval, firstChangeTime + debounceInterval * 10 ) );
+
+		const size_t numChanges = mNotifier->wait( deadline - getElapsedSeconds(), &changedFiles, &overflowed );
+		const double time = getElapsedSeconds();
+		if( numChanges ) {
+			if( ! changesPending )
+				firstChangeTime = time;
+			lastChangeTime = time;
+		}
+
+		const bool housekeeping = time >= nextHousekeepingTime;
+		const bool settled = ( ! changedFiles.empty() || overflowed ) && ( time >= lastChangeTime + debounceInterval || time >= firstChangeTime + debounceInterval * 10 );
+		if( ! housekeeping && ! settled )
+			continue;
+
+		lock_guard<recursive_mutex> lock( mMutex );
+
+		if( housekeeping ) {
+			const set<fs::path> failedDirectories = mNotifier->getFailedDirectories();
+			set<fs::path> polledFiles;
+			for( const auto &watch : mWatchList ) {
+				for( const auto &item : watch->getItems() ) {
+					if( failedDirectories.count( item.mFilePath.parent_path() ) )
+						polledFiles.insert( item.mFilePath );
+				}
+			}
+
+			checkWatches( &polledFiles );
+			// retry, as the directories may have been created meanwhile
+			if( ! failedDirectories.empty() )
+				updateWatchedDirectories();
+			nextHousekeepingTime = time + housekeepingInterval;
+		}
+
+		if( settled ) {
+			if( overflowed ) {
+				for( const auto &watch : mWatchList ) {
+					for( const auto &item : watch->getItems() )
+						changedFiles.insert( item.mFilePath );
+				}
+			}
+
+			LOG_UPDATE( "\t - " << changedFiles.size() << " files changed, elapsed seconds: " << getElapsedSeconds() );
+			checkWatches( &changedFiles );
+			changedFiles.clear();
+			overflowed = false;
+		}
+	}
+}
+
+void FileWatcher::checkWatches( const set<fs::path> *filePaths )
+{
+	bool erased = false;
+	for( auto it = mWatchList.begin(); it != mWatchList.end(); /* */ ) {
+		const auto &watch = *it;
+
+		// erase discarded
+		if( watch->isDiscarded() ) {
+			it = mWatchList.erase( it );
+			erased = true;
+			continue;
+		}
+
+		// check if Watch's target has been modified and needs a callback. When polling, Watches already marked are checked
+		// again once their callback was emitted, while notifications are only received once.
+		if( filePaths || ! watch->needsCallback() ) {
+			watch->checkCurrent( filePaths );
+
+			// If the Watch needs a callback, move it to the front of the list
+			if( watch->needsCallback() && it != mWatchList.begin() ) {
+				auto next = std::next( it );
+				mWatchList.splice( mWatchList.begin(), mWatchList, it );
+				it = next;
+				continue;
+			}
+		}
+
+		++it;
+	}
+
+	if( erased )
+		updateWatchedDirectories();
+}
+
 void FileWatcher::update()
 {
 	LOG_UPDATE( "elapsed seconds: " << getElapsedSeconds() );
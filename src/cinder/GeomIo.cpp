@@ -31,7 +31,9 @@
 #include "cinder/BSpline.h"
 #include "cinder/Matrix.h"
 #include "cinder/Sphere.h"
+#include "cinder/Thread.h"
 #include <algorithm>
+#include <typeinfo>
 
 #if defined( CINDER_ANDROID )
   #include "cinder/app/App.h"
@@ -51,6 +53,50 @@ std::string sPrimitiveNames[(int)Primitive::NUM_PRIMITIVES] = {
 	"LINES", "LINE_STRIP", "TRIANGLES", "TRIANGLE_STRIP", "TRIANGLE_FAN"
 };
 
+namespace {
+
+// Per-vertex Modifiers split their work across threads in chunks of at least this many vertices
+const size_t PARALLEL_GRAIN_SIZE = 8192;
+
+// Starts the SourceCache key of \a source with its dynamic type, or returns \c false when it isn't exactly one of \a Types. Subclasses
+// defined elsewhere may add parameters that the key doesn't capture, so they aren't cached unless they provide their own key.
+template<typename ...Types>
+bool beginCacheKey( const Source *source, std::string *key )
+{
+	const std::type_info &type = typeid( *source );
+	bool builtIn = false;
+	for( const std::type_info *t : { &typeid( Types )... } )
+		builtIn = builtIn || ( type == *t );
+	if( ! builtIn )
+		return false;
+
+	key->assign( type.name() );
+	key->push_back( '\0' );
+	return true;
+}
+
+// Appends the bytes of \a value to \a key
+template<typename T>
+void appendCacheKey( std::string *key, const T &value )
+{
+	static_assert( std::is_trivially_copyable<T>::value, "cache key parameters must be trivially copyable" );
+	key->append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+template<int L, typename T, glm::qualifier Q>
+void appendCacheKey( std::string *key, const glm::vec<L,T,Q> &value )
+{
+	for( int i = 0; i < L; ++i )
+		appendCacheKey( key, value[i] );
+}
+
+void appendCacheKey( std::string *key, const ColorAf &value )
+{
+	appendCacheKey( key, value.r ); appendCacheKey( key, value.g ); appendCacheKey( key, value.b ); appendCacheKey( key, value.a );
+}
+
+} // anonymous namespace
+
 std::string attribToString( Attrib attrib )
 {
 	if( attrib < Attrib::NUM_ATTRIBS )
@@ -396,60 +442,66 @@ void copyIndexDataForceTrianglesImpl( Primitive primitive, const uint32_t *sourc
 template<typename TEXTYPE>
 void calculateTangentsImpl( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const TEXTYPE *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
 {
-	if( resultTangents )
-		resultTangents->assign( numVertices, vec3( 0 ) );
-
+	// per-triangle tangents are computed first and then gathered per vertex through the adjacency, so no two threads write to the same vertex
 	size_t numTriangles = numIndices / 3;
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		uint32_t index0 = indices[i * 3];
-		uint32_t index1 = indices[i * 3 + 1];
-		uint32_t index2 = indices[i * 3 + 2];
-
-		const vec3 &v0 = positions[index0];
-		const vec3 &v1 = positions[index1];
-		const vec3 &v2 = positions[index2];
-
-		const vec2 &w0 = vec2( texCoords[index0] );
-		const vec2 &w1 = vec2( texCoords[index1] );
-		const vec2 &w2 = vec2( texCoords[index2] );
-
-		float x1 = v1.x - v0.x;
-		float x2 = v2.x - v0.x;
-		float y1 = v1.y - v0.y;
-		float y2 = v2.y - v0.y;
-		float z1 = v1.z - v0.z;
-		float z2 = v2.z - v0.z;
-
-		float s1 = w1.x - w0.x;
-		float s2 = w2.x - w0.x;
-		float t1 = w1.y - w0.y;
-		float t2 = w2.y - w0.y;
-
-		float r = (s1 * t2 - s2 * t1);
-		if( r != 0.0f ) r = 1.0f / r;
-
-		vec3 tangent( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
-
-		(*resultTangents)[index0] += tangent;
-		(*resultTangents)[index1] += tangent;
-		(*resultTangents)[index2] += tangent;
-	}
-
-	for( size_t i = 0; i < numVertices; ++i ) {
-		vec3 normal = normals[i];
-		vec3 tangent = (*resultTangents)[i];
-		(*resultTangents)[i] = ( tangent - normal * dot( normal, tangent ) );
-
-		float len = length2( (*resultTangents)[i] );
-		if( len > 0.0f )
-			(*resultTangents)[i] /= sqrt( len );
-	}
-
-	if( resultBitangents ) {
-		resultBitangents->reserve( numVertices );
-		for( size_t i = 0; i < numVertices; ++i )
-			resultBitangents->emplace_back( normalize( cross( normals[i], (*resultTangents)[i] ) ) );
-	}
+	vector<vec3> triangleTangents( numTriangles );
+	parallelFor( 0, numTriangles, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			uint32_t index0 = indices[i * 3];
+			uint32_t index1 = indices[i * 3 + 1];
+			uint32_t index2 = indices[i * 3 + 2];
+
+			const vec3 &v0 = positions[index0];
+			const vec3 &v1 = positions[index1];
+			const vec3 &v2 = positions[index2];
+
+			const vec2 &w0 = vec2( texCoords[index0] );
+			const vec2 &w1 = vec2( texCoords[index1] );
+			const vec2 &w2 = vec2( texCoords[index2] );
+
+			float x1 = v1.x - v0.x;
+			float x2 = v2.x - v0.x;
+			float y1 = v1.y - v0.y;
+			float y2 = v2.y - v0.y;
+			float z1 = v1.z - v0.z;
+			float z2 = v2.z - v0.z;
+
+			float s1 = w1.x - w0.x;
+			float s2 = w2.x - w0.x;
+			float t1 = w1.y - w0.y;
+			float t2 = w2.y - w0.y;
+
+			float r = (s1 * t2 - s2 * t1);
+			if( r != 0.0f ) r = 1.0f / r;
+
+			triangleTangents[i] = vec3( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
+		}
+	} );
+
+	vector<uint32_t> offsets, triangles;
+	calculateVertexTriangleAdjacency( numTriangles * 3, indices, numVertices, &offsets, &triangles );
+
+	resultTangents->resize( numVertices );
+	if( resultBitangents )
+		resultBitangents->resize( numVertices );
+	parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			vec3 tangent( 0 );
+			for( uint32_t a = offsets[i]; a < offsets[i + 1]; ++a )
+				tangent += triangleTangents[triangles[a]];
+
+			vec3 normal = normals[i];
+			tangent = ( tangent - normal * dot( normal, tangent ) );
+
+			float len = length2( tangent );
+			if( len > 0.0f )
+				tangent /= sqrt( len );
+			(*resultTangents)[i] = tangent;
+
+			if( resultBitangents )
+				(*resultBitangents)[i] = normalize( cross( normal, tangent ) );
+		}
+	} );
 }
 
 } // anonymous namespace
@@ -464,6 +516,20 @@ void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVe
 	calculateTangentsImpl( numIndices, indices, numVertices, positions, normals, texCoords, resultTangents, resultBitangents );
 }
 
+void calculateVertexTriangleAdjacency( size_t numIndices, const uint32_t *indices, size_t numVertices, vector<uint32_t> *resultOffsets, vector<uint32_t> *resultTriangles )
+{
+	resultOffsets->assign( numVertices + 1, 0 );
+	for( size_t i = 0; i < numIndices; ++i )
+		++(*resultOffsets)[indices[i] + 1];
+	for( size_t v = 0; v < numVertices; ++v )
+		(*resultOffsets)[v + 1] += (*resultOffsets)[v];
+
+	resultTriangles->resize( numIndices );
+	vector<uint32_t> fill( resultOffsets->begin(), resultOffsets->end() - 1 );
+	for( size_t i = 0; i < numIndices; ++i )
+		(*resultTriangles)[fill[indices[i]]++] = uint32_t( i / 3 );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Target
 void Target::copyIndexDataForceTriangles( Primitive primitive, const uint32_t *source, size_t numIndices, uint32_t indexOffset, uint32_t *target )
@@ -972,6 +1038,19 @@ AttribSet Cube::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Cube::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Cube>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mSubdivisions );
+	appendCacheKey( key, mSize );
+	appendCacheKey( key, mHasColors );
+	for( const auto &color : mColors )
+		appendCacheKey( key, color );
+	return true;
+}
+
 void generateFace( const vec3 &faceCenter, const vec3 &uAxis, const vec3 &vAxis, int subdivU, int subdivV,
 					vector<vec3> *positions, vector<vec3> *normals,
 					const ColorA &color, vector<ColorA> *colors, vector<vec2> *texCoords,
@@ -1501,6 +1580,16 @@ AttribSet Icosphere::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Icosphere::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Icosphere>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mSubdivision );
+	appendCacheKey( key, mHasColors );
+	return true;
+}
+
 void Icosphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	calculate();
@@ -1607,6 +1696,15 @@ AttribSet Teapot::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::TANGENT };
 }
 
+bool Teapot::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Teapot>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mSubdivision );
+	return true;
+}
+
 void Teapot::updateVertexCounts()
 {
 	int numFaces = mSubdivision * mSubdivision * 32;
@@ -2043,6 +2141,18 @@ AttribSet Sphere::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Sphere::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Sphere>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mCenter );
+	appendCacheKey( key, mRadius );
+	appendCacheKey( key, mSubdivisions );
+	appendCacheKey( key, mHasColors );
+	return true;
+}
+
 void Sphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	int numRings, numSegments;
@@ -2234,6 +2344,21 @@ AttribSet Capsule::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Capsule::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Capsule>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mDirection );
+	appendCacheKey( key, mCenter );
+	appendCacheKey( key, mLength );
+	appendCacheKey( key, mRadius );
+	appendCacheKey( key, mSubdivisionsHeight );
+	appendCacheKey( key, mSubdivisionsAxis );
+	appendCacheKey( key, mHasColors );
+	return true;
+}
+
 void Capsule::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	std::vector<vec3> positions, normals;
@@ -2372,6 +2497,24 @@ AttribSet Torus::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Torus::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Torus, Helix>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mCenter );
+	appendCacheKey( key, mRadiusMajor );
+	appendCacheKey( key, mRadiusMinor );
+	appendCacheKey( key, mSubdivisionsAxis );
+	appendCacheKey( key, mSubdivisionsHeight );
+	appendCacheKey( key, mHeight );
+	appendCacheKey( key, mCoils );
+	appendCacheKey( key, mTwist );
+	appendCacheKey( key, mTwistOffset );
+	appendCacheKey( key, mHasColors );
+	return true;
+}
+
 void Torus::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	std::vector<vec3> positions, normals;
@@ -2702,6 +2845,23 @@ AttribSet Cylinder::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0, Attrib::COLOR, Attrib::TANGENT };
 }
 
+bool Cylinder::calcCacheKey( std::string *key ) const
+{
+	if( ! beginCacheKey<Cylinder, Cone>( this, key ) )
+		return false;
+
+	appendCacheKey( key, mOrigin );
+	appendCacheKey( key, mHeight );
+	appendCacheKey( key, mDirection );
+	appendCacheKey( key, mRadiusBase );
+	appendCacheKey( key, mRadiusApex );
+	appendCacheKey( key, mSubdivisionsAxis );
+	appendCacheKey( key, mSubdivisionsHeight );
+	appendCacheKey( key, mSubdivisionsCap );
+	appendCacheKey( key, mHasColors );
+	return true;
+}
+
 void Cylinder::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	vector<vec3> positions, normals, colors;
@@ -2854,49 +3014,49 @@ void Transform::process( SourceModsContext *ctx, const AttribSet &requestedAttri
 	ctx->processUpstream( requestedAttribs );
 	
 	const size_t numVertices = ctx->getNumVertices();
+	const mat4 &transform = mTransform;
 
 	if( ctx->getAttribDims( POSITION ) == 2 ) {
-		const vec2* inPositions = reinterpret_cast<vec2*>( ctx->getAttribData( POSITION ) );
-		vector<vec3> outPositions;
-		outPositions.reserve( numVertices );
-		for( size_t v = 0; v < numVertices; ++v )
-			outPositions.push_back( vec3( mTransform * vec4( inPositions[v], 0, 1 ) ) );
-		ctx->copyAttrib( POSITION, 3, 0, (const float*)outPositions.data(), numVertices );
+		// promote to 3D, writing straight from the previous 2D storage into the new 3D storage
+		unique_ptr<float[]> inData;
+		vec3* outPositions = reinterpret_cast<vec3*>( ctx->reallocAttrib( POSITION, 3, numVertices, &inData ) );
+		const vec2* inPositions = reinterpret_cast<const vec2*>( inData.get() );
+		parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v )
+				outPositions[v] = vec3( transform * vec4( inPositions[v], 0, 1 ) );
+		} );
 	}
 	else if( ctx->getAttribDims( POSITION ) == 3 ) {
 		vec3* positions = reinterpret_cast<vec3*>( ctx->getAttribData( POSITION ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			positions[v] = vec3( mTransform * vec4( positions[v], 1 ) );
+		parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v )
+				positions[v] = vec3( transform * vec4( positions[v], 1 ) );
+		} );
 	}
 	else if( ctx->getAttribDims( POSITION ) == 4 ) {
 		vec4* positions = reinterpret_cast<vec4*>( ctx->getAttribData( POSITION ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			positions[v] = mTransform * positions[v];
+		parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v )
+				positions[v] = transform * positions[v];
+		} );
 	}
 	else if( ctx->getAttribDims( POSITION ) != 0 )
 		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Transform" );
 	
-	// we'll make the sort of modification to our normals (if they're present)
-	// using the inverse transpose of 'mTransform'
-	if( ctx->getAttribDims( NORMAL ) == 3 ) {
-		vec3* normals = reinterpret_cast<vec3*>( ctx->getAttribData( NORMAL ) );
-		mat3 normalsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			normals[v] = normalize( normalsTransform * normals[v] );
-	}
-	else if( ctx->getAttribDims( NORMAL ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::NORMAL passed to geom::Transform" );
-
-	// and finally, we'll make the sort of modification to our tangents (if they're present)
+	// we'll make the sort of modification to our normals and tangents (if they're present)
 	// using the inverse transpose of 'mTransform'
-	if( ctx->getAttribDims( TANGENT ) == 3 ) {
-		vec3* tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
-		mat3 tangentsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			tangents[v] = normalize( tangentsTransform * tangents[v] );
+	const mat3 normalsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
+	for( Attrib attrib : { NORMAL, TANGENT } ) {
+		if( ctx->getAttribDims( attrib ) == 3 ) {
+			vec3* data = reinterpret_cast<vec3*>( ctx->getAttribData( attrib ) );
+			parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+				for( size_t v = begin; v < end; ++v )
+					data[v] = normalize( normalsTransform * data[v] );
+			} );
+		}
+		else if( ctx->getAttribDims( attrib ) != 0 )
+			CI_LOG_W( "Unsupported dimension for geom::" << attribToString( attrib ) << " passed to geom::Transform" );
 	}
-	else if( ctx->getAttribDims( TANGENT ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::TANGENT passed to geom::Transform" );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -2917,25 +3077,27 @@ void Twist::process( SourceModsContext *ctx, const AttribSet &requestedAttribs )
 		if( ctx->getAttribDims( TANGENT ) == 3 )
 			tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
 		
-		for( size_t v = 0; v < numVertices; ++v ) {
-			// find the 't' value of the point on the axis that inPosition is closest to
-			float closestDist = dot( positions[v] - mAxisStart, axisDir );
-			float tVal = glm::clamp<float>( closestDist * invAxisLength, 0, 1 );
-			// 'pointOnAxis' is the actual point on the axis inPosition is closest to
-			vec3 pointOnAxis = mAxisStart + axisDir * closestDist;
-			// our rotation is around the axis, and the angle is a lerp between 'mStartAngle' and 'mEndAngle' based on 't'
-			mat4 rotation = rotate( glm::mix( mStartAngle, mEndAngle, tVal ), axisDir );
-			// now transform the point by rotating around 'pointOnAxis'
-			mat4 transform = translate( pointOnAxis ) * rotation * translate( -pointOnAxis );
-			vec3 outPos = vec3( transform * vec4( positions[v], 1 ) );
-			positions[v] = outPos;
-			// we need to transform the normal by rotating it by the same angle (but not around the point) we did the position
-			if( normals )
-				normals[v] = vec3( rotation * vec4( normals[v], 0 ) );
-			// we need to transform the tangent by rotating it by the same angle (but not around the point) we did the position
-			if( tangents )
-				tangents[v] = vec3( rotation * vec4( tangents[v], 0 ) );
-		}
+		parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v ) {
+				// find the 't' value of the point on the axis that inPosition is closest to
+				float closestDist = dot( positions[v] - mAxisStart, axisDir );
+				float tVal = glm::clamp<float>( closestDist * invAxisLength, 0, 1 );
+				// 'pointOnAxis' is the actual point on the axis inPosition is closest to
+				vec3 pointOnAxis = mAxisStart + axisDir * closestDist;
+				// our rotation is around the axis, and the angle is a lerp between 'mStartAngle' and 'mEndAngle' based on 't'
+				mat4 rotation = rotate( glm::mix( mStartAngle, mEndAngle, tVal ), axisDir );
+				// now transform the point by rotating around 'pointOnAxis'
+				mat4 transform = translate( pointOnAxis ) * rotation * translate( -pointOnAxis );
+				vec3 outPos = vec3( transform * vec4( positions[v], 1 ) );
+				positions[v] = outPos;
+				// we need to transform the normal by rotating it by the same angle (but not around the point) we did the position
+				if( normals )
+					normals[v] = vec3( rotation * vec4( normals[v], 0 ) );
+				// we need to transform the tangent by rotating it by the same angle (but not around the point) we did the position
+				if( tangents )
+					tangents[v] = vec3( rotation * vec4( tangents[v], 0 ) );
+			}
+		} );
 	}
 	else if( ctx->getAttribDims( POSITION ) != 0 )
 		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Twist" );
@@ -3178,40 +3340,21 @@ void Constant::process( SourceModsContext *ctx, const AttribSet &requestedAttrib
 {
 	ctx->processUpstream( requestedAttribs );
 
-	const size_t numVertices = ctx->getNumVertices();
-	
-	switch( mDims ) {
-		case 1: {
-			unique_ptr<float[]> mColorData( new float[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = mValue.x;
-			ctx->copyAttrib( mAttrib, 1, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 2: {
-			unique_ptr<vec2[]> mColorData( new vec2[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = vec2( mValue.x, mValue.y );
-			ctx->copyAttrib( mAttrib, 2, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 3: {
-			unique_ptr<vec3[]> mColorData( new vec3[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = vec3( mValue.x, mValue.y, mValue.z );
-			ctx->copyAttrib( mAttrib, 3, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 4: {
-			unique_ptr<vec4[]> mColorData( new vec4[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = mValue;
-			ctx->copyAttrib( mAttrib, 4, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		default:
-			CI_LOG_E( "Illegal dimensions." );
+	if( mDims < 1 || mDims > 4 ) {
+		CI_LOG_E( "Illegal dimensions." );
+		return;
 	}
+
+	// fill the attribute's storage directly rather than copying from a temporary
+	const size_t numVertices = ctx->getNumVertices();
+	const uint8_t dims = mDims;
+	const vec4 value = mValue;
+	float *data = ctx->reallocAttrib( mAttrib, dims, numVertices );
+	parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+		for( size_t v = begin; v < end; ++v )
+			for( uint8_t d = 0; d < dims; ++d )
+				data[v * dims + d] = value[d];
+	} );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -4554,8 +4697,10 @@ void Invert::process( SourceModsContext *ctx, const AttribSet &requestedAttribs
 	
 	float *d = ctx->getAttribData( mAttrib );
 	size_t maxIdx = ctx->getAttribDims( mAttrib ) * ctx->getNumVertices();
-	for( size_t i = 0; i < maxIdx; ++i )
-		d[i] = -d[i];
+	parallelFor( 0, maxIdx, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			d[i] = -d[i];
+	} );
 	
 	// we don't need to copyAttrib() because we processed in place
 }
@@ -4707,59 +4852,48 @@ void Subdivide::process( SourceModsContext *ctx, const AttribSet &requestedAttri
 	}
 	
 	const size_t numInVertices = ctx->getNumVertices();
-	const size_t numInIndices = ctx->getNumIndices();
-	
-	const uint32_t *inIndices = ctx->getIndicesData();
-	const vec3 *inPositions = reinterpret_cast<const vec3*>( ctx->getAttribData( POSITION ) );
-	
-	vector<vec3> outPositions;
-	vector<uint32_t> outIndices;
+	const size_t numTriangles = ctx->getNumIndices() / 3;
+	const size_t numOutVertices = numInVertices + numTriangles;
 	
-	for( size_t idx = 0; idx < numInIndices; idx += 3 ) {
-		vec3 sumPos = inPositions[inIndices[idx+0]] + inPositions[inIndices[idx+1]] +
-						inPositions[inIndices[idx+2]];
-		outPositions.push_back( sumPos / 3.0f );
-		
-		uint32_t newIdx = (uint32_t)(outPositions.size() + numInVertices - 1);
-		// 0-new-2
-		outIndices.push_back( inIndices[idx+0] ); outIndices.push_back( newIdx ); outIndices.push_back( inIndices[idx+2] );
-		// 0-1-new
-		outIndices.push_back( inIndices[idx+0] ); outIndices.push_back( inIndices[idx+1] ); outIndices.push_back( newIdx );
-		// new-1-2
-		outIndices.push_back( newIdx ); outIndices.push_back( inIndices[idx+1] ); outIndices.push_back( inIndices[idx+2] );
-	}
+	// every input triangle gets a new vertex at its center and is replaced by 3 triangles
+	unique_ptr<uint32_t[]> inIndicesStorage;
+	uint32_t *outIndices = ctx->reallocIndices( Primitive::TRIANGLES, numTriangles * 9, &inIndicesStorage );
+	const uint32_t *inIndices = inIndicesStorage.get();
+	parallelFor( 0, numTriangles, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+		for( size_t tri = begin; tri < end; ++tri ) {
+			const uint32_t *in = &inIndices[tri * 3];
+			uint32_t *out = &outIndices[tri * 9];
+			uint32_t newIdx = (uint32_t)( numInVertices + tri );
+			// 0-new-2
+			out[0] = in[0]; out[1] = newIdx; out[2] = in[2];
+			// 0-1-new
+			out[3] = in[0]; out[4] = in[1]; out[5] = newIdx;
+			// new-1-2
+			out[6] = newIdx; out[7] = in[1]; out[8] = in[2];
+		}
+	} );
 	
-	// iterate the attributes and lerp
+	// iterate the attributes and lerp, writing the new vertices directly after the existing ones
 	for( const auto &attr : ctx->getAvailableAttribs() ) {
-		// we processed POSITION in the previous loop
-		if( attr == POSITION )
-			continue;
-	
-		vector<float> outData;
-		const float *inData = ctx->getAttribData( attr );
-		uint8_t dims = ctx->getAttribDims( attr );
-		outData.reserve( numInIndices / 3 * dims );
-		for( size_t idx = 0; idx < numInIndices; idx += 3 ) {
-			for( uint8_t dim = 0; dim < dims; ++dim )
-				outData.push_back( (inData[inIndices[idx+0]*dims + dim] +
-									inData[inIndices[idx+1]*dims + dim] +
-									inData[inIndices[idx+2]*dims + dim]) / 3.0f );
-		}
-		
+		const uint8_t dims = ctx->getAttribDims( attr );
+		unique_ptr<float[]> inDataStorage;
+		float *outData = ctx->reallocAttrib( attr, dims, numOutVertices, &inDataStorage );
+		const float *inData = inDataStorage.get();
+		memcpy( outData, inData, numInVertices * dims * sizeof(float) );
+
 		// normalize 3D NORMAL, TANGENT or BITANGENT
-		if( ( (attr == NORMAL) || (attr == TANGENT) || (attr == BITANGENT) ) && ( dims == 3 ) ) {
-			size_t numVerts = outData.size() / 3;
-			for( size_t v = 0; v < numVerts; ++v ) {
-				vec3 *d = reinterpret_cast<vec3*>( &outData[v * 3] );
-				*d = normalize( *d );
+		const bool normalizeResult = ( (attr == NORMAL) || (attr == TANGENT) || (attr == BITANGENT) ) && ( dims == 3 );
+		parallelFor( 0, numTriangles, PARALLEL_GRAIN_SIZE, [=]( size_t begin, size_t end ) {
+			for( size_t tri = begin; tri < end; ++tri ) {
+				const uint32_t *in = &inIndices[tri * 3];
+				float *out = &outData[( numInVertices + tri ) * dims];
+				for( uint8_t dim = 0; dim < dims; ++dim )
+					out[dim] = ( inData[in[0]*dims + dim] + inData[in[1]*dims + dim] + inData[in[2]*dims + dim] ) / 3.0f;
+				if( normalizeResult )
+					*reinterpret_cast<vec3*>( out ) = normalize( *reinterpret_cast<vec3*>( out ) );
 			}
-		}
-
-		ctx->appendAttrib( attr, dims, outData.data(), outData.size() / dims );
+		} );
 	}
-	
-	ctx->appendAttrib( POSITION, 3, (const float*)outPositions.data(), outPositions.size() );
-	ctx->copyIndices( ctx->getPrimitive(), outIndices.data(), outIndices.size(), 4 );
 }
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -4900,7 +5034,7 @@ void SourceMods::loadInto( Target *target, const AttribSet &requestedAttribs ) c
 {
 	if( mSourcePtr ) { // normal, no children
 		if( mModifiers.empty() ) {
-			mSourcePtr->loadInto( target, requestedAttribs );
+			SourceCache::get()->loadInto( mSourcePtr, target, requestedAttribs );
 		}
 		else {
 			SourceModsContext context( this );
@@ -4983,7 +5117,7 @@ void SourceModsContext::preload( const AttribSet &requestedAttribs )
 		modifier->process( this, requestedAttribs );
 	}
 	else { // no modifiers; just loadInto on the soucre directly
-		mSource->loadInto( this, requestedAttribs );
+		SourceCache::get()->loadInto( mSource, this, requestedAttribs );
 	}
 }
 
@@ -5124,7 +5258,7 @@ void SourceModsContext::loadInto( Target *target, const AttribSet &requestedAttr
 	}
 	else {
 		// no modifiers; in this case just call loadInto()
-		mSource->loadInto( target, requestedAttribs );
+		SourceCache::get()->loadInto( mSource, target, requestedAttribs );
 	}
 }
 
@@ -5134,7 +5268,7 @@ void SourceModsContext::processUpstream( const AttribSet &requestedAttribs )
 	if( mModiferStack.empty() ) {
 		mAttribMask = &requestedAttribs;
 		if( mSource )
-			mSource->loadInto( this, requestedAttribs );
+			SourceCache::get()->loadInto( mSource, this, requestedAttribs );
 		mAttribMask = nullptr;
 	}
 	else {
@@ -5279,6 +5413,41 @@ void SourceModsContext::appendIndices( Primitive primitive, const uint32_t *sour
 	mIndices = std::move( newIndices );
 }
 
+float* SourceModsContext::reallocAttrib( Attrib attr, uint8_t dims, size_t count, unique_ptr<float[]> *previousData )
+{
+	mNumVertices = count;
+
+	auto &data = mAttribData[attr];
+	auto infoIt = mAttribInfo.find( attr );
+	// without a request for the previous data, existing storage of the right size can simply be reused
+	if( ( ! previousData ) && data && ( infoIt != mAttribInfo.end() ) && ( infoIt->second.getDims() == dims ) && ( mAttribCount[attr] == count ) )
+		return data.get();
+
+	if( previousData )
+		*previousData = std::move( data );
+	data = unique_ptr<float[]>( new float[dims * count] );
+	mAttribCount[attr] = count;
+	if( infoIt != mAttribInfo.end() )
+		infoIt->second = AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 );
+	else
+		mAttribInfo.insert( make_pair( attr, AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 ) ) );
+
+	return data.get();
+}
+
+uint32_t* SourceModsContext::reallocIndices( Primitive primitive, size_t numIndices, unique_ptr<uint32_t[]> *previousIndices )
+{
+	mPrimitive = primitive;
+	mIndicesRequiredBytes = 4;
+	if( previousIndices )
+		*previousIndices = std::move( mIndices );
+	if( ( ! mIndices ) || ( mNumIndices != numIndices ) )
+		mIndices = unique_ptr<uint32_t[]>( new uint32_t[numIndices] );
+	mNumIndices = numIndices;
+
+	return mIndices.get();
+}
+
 void SourceModsContext::clearAttrib( Attrib attr )
 {
 	mAttribInfo.erase( attr );
@@ -5292,6 +5461,192 @@ void SourceModsContext::clearIndices()
 	mIndices.reset();
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SourceCache
+
+// An Entry captures the output of a Source as a Target, and later replays it into other Targets
+struct SourceCache::Entry : public Target {
+	struct AttribData {
+		Attrib				mAttrib;
+		uint8_t				mDims;
+		size_t				mCount;
+		std::vector<float>	mData;
+	};
+
+	Entry( const Source *source, const AttribSet &requestedAttribs )
+		: mSource( source ), mRequestedAttribs( requestedAttribs ), mHasIndices( false ), mPrimitive( source->getPrimitive() ), mIndicesRequiredBytes( 4 )
+	{}
+
+	uint8_t	getAttribDims( Attrib attr ) const override
+	{
+		return mSource ? mSource->getAttribDims( attr ) : 0;
+	}
+
+	void copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override
+	{
+		// Sources may supply attributes which weren't requested; these are dropped by SourceModsContext anyway
+		if( mRequestedAttribs.count( attr ) == 0 )
+			return;
+
+		auto it = find_if( mAttribs.begin(), mAttribs.end(), [attr]( const AttribData &data ) { return data.mAttrib == attr; } );
+		if( it == mAttribs.end() )
+			it = mAttribs.insert( mAttribs.end(), AttribData() );
+		it->mAttrib = attr;
+		it->mDims = dims;
+		it->mCount = count;
+		it->mData.resize( dims * count );
+		copyData( dims, strideBytes, srcData, count, dims, 0, it->mData.data() );
+	}
+
+	void copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override
+	{
+		mHasIndices = true;
+		mPrimitive = primitive;
+		mIndicesRequiredBytes = requiredBytesPerIndex;
+		mIndices.assign( source, source + numIndices );
+	}
+
+	void replay( Target *target ) const
+	{
+		for( const auto &attrib : mAttribs )
+			target->copyAttrib( attrib.mAttrib, attrib.mDims, 0, attrib.mData.data(), attrib.mCount );
+		if( mHasIndices )
+			target->copyIndices( mPrimitive, mIndices.data(), mIndices.size(), mIndicesRequiredBytes );
+	}
+
+	size_t calcNumBytes() const
+	{
+		size_t result = sizeof( Entry ) + mIndices.size() * sizeof(uint32_t);
+		for( const auto &attrib : mAttribs )
+			result += sizeof( AttribData ) + attrib.mData.size() * sizeof(float);
+		return result;
+	}
+
+	const Source			*mSource; // only valid during capture
+	AttribSet				mRequestedAttribs;
+	std::vector<AttribData>	mAttribs;
+	std::vector<uint32_t>	mIndices;
+	bool					mHasIndices;
+	Primitive				mPrimitive;
+	uint8_t					mIndicesRequiredBytes;
+};
+
+SourceCache::SourceCache()
+	: mEnabled( true ), mMaxBytes( 64 * 1024 * 1024 ), mNumBytes( 0 )
+{
+}
+
+SourceCache* SourceCache::get()
+{
+	static SourceCache sInstance;
+	return &sInstance;
+}
+
+void SourceCache::setEnabled( bool enable )
+{
+	lock_guard<mutex> lock( mMutex );
+	mEnabled = enable;
+	if( ! mEnabled ) {
+		mEntries.clear();
+		mEntryMap.clear();
+		mNumBytes = 0;
+	}
+}
+
+bool SourceCache::isEnabled() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mEnabled;
+}
+
+void SourceCache::setMaxBytes( size_t maxBytes )
+{
+	lock_guard<mutex> lock( mMutex );
+	mMaxBytes = maxBytes;
+	evict();
+}
+
+size_t SourceCache::getMaxBytes() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mMaxBytes;
+}
+
+size_t SourceCache::getNumBytes() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mNumBytes;
+}
+
+size_t SourceCache::getNumEntries() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mEntries.size();
+}
+
+void SourceCache::clear()
+{
+	lock_guard<mutex> lock( mMutex );
+	mEntries.clear();
+	mEntryMap.clear();
+	mNumBytes = 0;
+}
+
+// expects mMutex to be locked
+void SourceCache::evict()
+{
+	while( mNumBytes > mMaxBytes && ( ! mEntries.empty() ) ) {
+		mNumBytes -= mEntries.back().second->calcNumBytes() + mEntries.back().first.first.size();
+		mEntryMap.erase( mEntries.back().first );
+		mEntries.pop_back();
+	}
+}
+
+void SourceCache::loadInto( const Source *source, Target *target, const AttribSet &requestedAttribs )
+{
+	// the key holds every parameter rather than a hash of them, so distinct Sources can never share an entry
+	Key key;
+	if( ( ! isEnabled() ) || ( ! source->calcCacheKey( &key.first ) ) ) {
+		source->loadInto( target, requestedAttribs );
+		return;
+	}
+
+	key.second = 0;
+	for( Attrib attr : requestedAttribs ) {
+		if( attr < Attrib::NUM_ATTRIBS )
+			key.second |= 1u << (uint32_t)attr;
+	}
+
+	shared_ptr<const Entry> entry;
+	{
+		lock_guard<mutex> lock( mMutex );
+		auto it = mEntryMap.find( key );
+		if( it != mEntryMap.end() ) {
+			mEntries.splice( mEntries.begin(), mEntries, it->second );
+			entry = it->second->second;
+		}
+	}
+
+	// generate outside of the lock so that other threads aren't blocked on us
+	if( ! entry ) {
+		auto newEntry = make_shared<Entry>( source, requestedAttribs );
+		source->loadInto( newEntry.get(), requestedAttribs );
+		newEntry->mSource = nullptr;
+		entry = newEntry;
+
+		lock_guard<mutex> lock( mMutex );
+		size_t numBytes = entry->calcNumBytes() + key.first.size();
+		if( mEnabled && ( mEntryMap.count( key ) == 0 ) && ( numBytes <= mMaxBytes ) ) {
+			mEntries.emplace_front( key, entry );
+			mEntryMap[key] = mEntries.begin();
+			mNumBytes += numBytes;
+			evict();
+		}
+	}
+
+	entry->replay( target );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Modifier
 
@@ -0,0 +1,935 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/JsonDoc.h"
+#include "cinder/Buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <locale>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define CINDER_JSON_SSE2
+	#include <emmintrin.h>
+#elif defined( __ARM_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+	#define CINDER_JSON_NEON
+	#include <arm_neon.h>
+#endif
+#if defined( _MSC_VER )
+	#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+const uint32_t NO_KEY = 0xFFFFFFFF;
+// objects with fewer members than this are searched linearly rather than hashed
+const uint32_t MIN_HASHED_MEMBERS = 16;
+
+struct Node {
+	uint32_t		mOffset; // strings: the first character after the opening quote; arrays and objects: the opening bracket; others: the first character
+	uint32_t		mLength; // arrays and objects: the position of the first child in mChildIndex; others: the number of characters
+	uint32_t		mNumChildren;
+	uint32_t		mKeyOffset; // object members only: the first character after the key's opening quote; otherwise NO_KEY
+	uint32_t		mKeyLength;
+	JsonDoc::Type	mType;
+};
+
+inline int countTrailingZeros( uint64_t v )
+{
+#if defined( _MSC_VER ) && defined( _WIN64 )
+	unsigned long result;
+	_BitScanForward64( &result, v );
+	return (int)result;
+#elif defined( _MSC_VER )
+	int result = 0;
+	while( ! ( v & 1 ) ) {
+		v >>= 1;
+		++result;
+	}
+	return result;
+#else
+	return __builtin_ctzll( v );
+#endif
+}
+
+// Structural index
+//
+// The source is scanned 64 bytes at a time, classifying each byte into bitmasks. Quotes preceded by an odd number of backslashes
+// are escaped; the remaining quotes toggle whether the following bytes are within a string, which a prefix XOR of the quote mask
+// computes for all 64 bytes at once. Structural positions are the brackets, braces, colons and commas outside strings, both
+// quotes of every string and the first character of every number and literal.
+
+struct BlockMasks {
+	uint64_t	mQuote, mBackslash, mOperator, mWhitespace;
+};
+
+#if defined( CINDER_JSON_SSE2 )
+inline uint64_t toMask( __m128i eq, int shift )
+{
+	return (uint64_t)(uint32_t)_mm_movemask_epi8( eq ) << shift;
+}
+
+inline void classify( const uint8_t *src, BlockMasks *result )
+{
+	*result = BlockMasks{ 0, 0, 0, 0 };
+	for( int i = 0; i < 64; i += 16 ) {
+		__m128i v = _mm_loadu_si128( (const __m128i*)( src + i ) );
+		// setting bit 5 maps '[' and ']' onto '{' and '}', and nothing else onto either
+		__m128i lower = _mm_or_si128( v, _mm_set1_epi8( 0x20 ) );
+		__m128i op = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( lower, _mm_set1_epi8( '{' ) ), _mm_cmpeq_epi8( lower, _mm_set1_epi8( '}' ) ) ),
+			_mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( ':' ) ), _mm_cmpeq_epi8( v, _mm_set1_epi8( ',' ) ) ) );
+		__m128i ws = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( ' ' ) ), _mm_cmpeq_epi8( v, _mm_set1_epi8( '\n' ) ) ),
+			_mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\t' ) ), _mm_cmpeq_epi8( v, _mm_set1_epi8( '\r' ) ) ) );
+		result->mQuote |= toMask( _mm_cmpeq_epi8( v, _mm_set1_epi8( '"' ) ), i );
+		result->mBackslash |= toMask( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\\' ) ), i );
+		result->mOperator |= toMask( op, i );
+		result->mWhitespace |= toMask( ws, i );
+	}
+}
+#elif defined( CINDER_JSON_NEON )
+// gathers the top bit of each byte of 64 comparison results into a mask
+inline uint64_t toMask( uint8x16_t eq0, uint8x16_t eq1, uint8x16_t eq2, uint8x16_t eq3 )
+{
+	const uint8x16_t bits = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t sum0 = vpaddq_u8( vandq_u8( eq0, bits ), vandq_u8( eq1, bits ) );
+	uint8x16_t sum1 = vpaddq_u8( vandq_u8( eq2, bits ), vandq_u8( eq3, bits ) );
+	sum0 = vpaddq_u8( sum0, sum1 );
+	sum0 = vpaddq_u8( sum0, sum0 );
+	return vgetq_lane_u64( vreinterpretq_u64_u8( sum0 ), 0 );
+}
+
+inline void classify( const uint8_t *src, BlockMasks *result )
+{
+	uint8x16_t quote[4], backslash[4], op[4], ws[4];
+	for( int i = 0; i < 4; ++i ) {
+		uint8x16_t v = vld1q_u8( src + i * 16 );
+		// setting bit 5 maps '[' and ']' onto '{' and '}', and nothing else onto either
+		uint8x16_t lower = vorrq_u8( v, vdupq_n_u8( 0x20 ) );
+		quote[i] = vceqq_u8( v, vdupq_n_u8( '"' ) );
+		backslash[i] = vceqq_u8( v, vdupq_n_u8( '\\' ) );
+		op[i] = vorrq_u8( vorrq_u8( vceqq_u8( lower, vdupq_n_u8( '{' ) ), vceqq_u8( lower, vdupq_n_u8( '}' ) ) ),
+			vorrq_u8( vceqq_u8( v, vdupq_n_u8( ':' ) ), vceqq_u8( v, vdupq_n_u8( ',' ) ) ) );
+		ws[i] = vorrq_u8( vorrq_u8( vceqq_u8( v, vdupq_n_u8( ' ' ) ), vceqq_u8( v, vdupq_n_u8( '\n' ) ) ),
+			vorrq_u8( vceqq_u8( v, vdupq_n_u8( '\t' ) ), vceqq_u8( v, vdupq_n_u8( '\r' ) ) ) );
+	}
+	result->mQuote = toMask( quote[0], quote[1], quote[2], quote[3] );
+	result->mBackslash = toMask( backslash[0], backslash[1], backslash[2], backslash[3] );
+	result->mOperator = toMask( op[0], op[1], op[2], op[3] );
+	result->mWhitespace = toMask( ws[0], ws[1], ws[2], ws[3] );
+}
+#else
+inline void classify( const uint8_t *src, BlockMasks *result )
+{
+	*result = BlockMasks{ 0, 0, 0, 0 };
+	for( int i = 0; i < 64; ++i ) {
+		const uint64_t bit = 1ULL << i;
+		switch( src[i] ) {
+			case '"': result->mQuote |= bit; break;
+			case '\\': result->mBackslash |= bit; break;
+			case '{': case '}': case '[': case ']': case ':': case ',': result->mOperator |= bit; break;
+			case ' ': case '\n': case '\t': case '\r': result->mWhitespace |= bit; break;
+		}
+	}
+}
+#endif
+
+// Returns the mask of characters preceded by an unescaped backslash. 'prevEscaped' carries whether the first character of the next block is escaped.
+uint64_t findEscaped( uint64_t backslash, uint64_t *prevEscaped )
+{
+	uint64_t result = 0;
+	int i = 0;
+	if( *prevEscaped ) {
+		result = 1;
+		i = 1;
+	}
+
+	*prevEscaped = 0;
+	while( i < 64 ) {
+		const uint64_t remaining = backslash & ( ~0ULL << i );
+		if( ! remaining )
+			break;
+		const int b = countTrailingZeros( remaining );
+		if( b == 63 ) {
+			*prevEscaped = 1;
+			break;
+		}
+		result |= 1ULL << ( b + 1 );
+		i = b + 2;
+	}
+
+	return result;
+}
+
+// Returns a mask with each bit set when an odd number of bits at or below it are set in 'v'
+inline uint64_t prefixXor( uint64_t v )
+{
+	v ^= v << 1;
+	v ^= v << 2;
+	v ^= v << 4;
+	v ^= v << 8;
+	v ^= v << 16;
+	v ^= v << 32;
+	return v;
+}
+
+// Returns false if the source ends within a string
+bool buildStructuralIndex( const char *data, size_t size, vector<uint32_t> *result )
+{
+	uint64_t prevInString = 0, prevEscaped = 0, prevScalar = 0;
+	size_t count = 0;
+	result->resize( std::max<size_t>( size / 4, 64 ) );
+
+	uint8_t tail[64];
+	for( size_t pos = 0; pos < size; pos += 64 ) {
+		const uint8_t *block = (const uint8_t*)data + pos;
+		// the final partial block is padded with whitespace, which adds nothing to the index
+		if( size - pos < 64 ) {
+			memset( tail, ' ', sizeof( tail ) );
+			memcpy( tail, block, size - pos );
+			block = tail;
+		}
+
+		BlockMasks masks;
+		classify( block, &masks );
+		const uint64_t escaped = ( masks.mBackslash | prevEscaped ) ? findEscaped( masks.mBackslash, &prevEscaped ) : 0;
+		const uint64_t quote = masks.mQuote & ~escaped;
+		// set from each opening quote up to but excluding its closing quote
+		const uint64_t inString = prefixXor( quote ) ^ prevInString;
+		prevInString = (uint64_t)( (int64_t)inString >> 63 );
+
+		const uint64_t scalar = ~( masks.mOperator | masks.mWhitespace | quote | inString );
+		const uint64_t scalarStart = scalar & ~( ( scalar << 1 ) | prevScalar );
+		prevScalar = scalar >> 63;
+		uint64_t structural = ( masks.mOperator & ~inString ) | quote | scalarStart;
+
+		if( result->size() - count < 64 )
+			result->resize( result->size() * 2 );
+		uint32_t *dst = result->data() + count;
+		while( structural ) {
+			*dst++ = (uint32_t)( pos + countTrailingZeros( structural ) );
+			structural &= structural - 1;
+		}
+		count = dst - result->data();
+	}
+
+	result->resize( count );
+	return prevInString == 0;
+}
+
+inline bool isDelimiter( char c )
+{
+	switch( c ) {
+		case ' ': case '\n': case '\t': case '\r': case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+			return true;
+		default:
+			return false;
+	}
+}
+
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
+
+uint64_t hashKey( const char *data, size_t size )
+{
+	uint64_t result = 14695981039346656037ULL;
+	for( size_t i = 0; i < size; ++i )
+		result = ( result ^ (uint8_t)data[i] ) * 1099511628211ULL;
+	return result;
+}
+
+const char* getTypeName( JsonDoc::Type type )
+{
+	switch( type ) {
+		case JsonDoc::TYPE_NULL: return "null";
+		case JsonDoc::TYPE_BOOL: return "bool";
+		case JsonDoc::TYPE_NUMBER: return "number";
+		case JsonDoc::TYPE_STRING: return "string";
+		case JsonDoc::TYPE_ARRAY: return "array";
+		default: return "object";
+	}
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////////////
+// detail
+namespace detail {
+
+bool parseJsonScalarType( const StringRef &token, JsonDoc::Type *result )
+{
+	if( token == "true" || token == "false" ) {
+		*result = JsonDoc::TYPE_BOOL;
+		return true;
+	}
+	else if( token == "null" ) {
+		*result = JsonDoc::TYPE_NULL;
+		return true;
+	}
+
+	// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+	const char *p = token.begin(), *end = token.end();
+	auto skipDigits = [&]() {
+		const char *start = p;
+		while( p < end && isDigit( *p ) )
+			++p;
+		return p > start;
+	};
+
+	if( p < end && *p == '-' )
+		++p;
+	if( p < end && *p == '0' )
+		++p;
+	else if( ! skipDigits() )
+		return false;
+	if( p < end && *p == '.' ) {
+		++p;
+		if( ! skipDigits() )
+			return false;
+	}
+	if( p < end && ( *p == 'e' || *p == 'E' ) ) {
+		++p;
+		if( p < end && ( *p == '+' || *p == '-' ) )
+			++p;
+		if( ! skipDigits() )
+			return false;
+	}
+
+	*result = JsonDoc::TYPE_NUMBER;
+	return p == end;
+}
+
+double parseJsonDouble( const StringRef &number )
+{
+	// Numbers with at most 15 significant digits and a small exponent convert exactly, as their mantissa and power of ten are both exact doubles
+	static const double sPowers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	const char *p = number.begin(), *end = number.end();
+	const bool negative = p < end && *p == '-';
+	if( negative )
+		++p;
+
+	uint64_t mantissa = 0;
+	int numDigits = 0, exponent = 0;
+	for( ; p < end && isDigit( *p ); ++p, ++numDigits )
+		mantissa = mantissa * 10 + ( *p - '0' );
+	if( p < end && *p == '.' ) {
+		for( ++p; p < end && isDigit( *p ); ++p, ++numDigits, --exponent )
+			mantissa = mantissa * 10 + ( *p - '0' );
+	}
+	if( p < end ) {
+		// the exponent; digits beyond what can matter are clamped
+		++p;
+		const bool negativeExponent = p < end && *p == '-';
+		if( p < end && ( *p == '+' || *p == '-' ) )
+			++p;
+		int e = 0;
+		for( ; p < end; ++p )
+			e = std::min( e * 10 + ( *p - '0' ), 100000 );
+		exponent += negativeExponent ? -e : e;
+	}
+
+	if( numDigits <= 15 && exponent >= -22 && exponent <= 22 ) {
+		const double result = ( exponent < 0 ) ? (double)mantissa / sPowers[-exponent] : (double)mantissa * sPowers[exponent];
+		return negative ? -result : result;
+	}
+
+	istringstream stream( number.str() );
+	stream.imbue( std::locale::classic() );
+	double result = 0;
+	stream >> result;
+	return result;
+}
+
+bool parseJsonUint( const StringRef &number, uint64_t *result )
+{
+	uint64_t magnitude = 0;
+	for( char c : number ) {
+		if( ! isDigit( c ) ) {
+			// a fraction or exponent must still give an integer
+			const double d = parseJsonDouble( number );
+			if( d != std::floor( d ) || d < 0 || d >= 18446744073709551616.0 )
+				return false;
+			*result = (uint64_t)d;
+			return true;
+		}
+		const uint64_t digit = c - '0';
+		if( magnitude > ( numeric_limits<uint64_t>::max() - digit ) / 10 )
+			return false;
+		magnitude = magnitude * 10 + digit;
+	}
+
+	*result = magnitude;
+	return true;
+}
+
+bool parseJsonInt( const StringRef &number, int64_t *result )
+{
+	const bool negative = ! number.empty() && number[0] == '-';
+	uint64_t magnitude;
+	if( ! parseJsonUint( negative ? StringRef( number.data() + 1, number.size() - 1 ) : number, &magnitude ) )
+		return false;
+
+	if( negative ) {
+		if( magnitude > (uint64_t)numeric_limits<int64_t>::max() + 1 )
+			return false;
+		*result = (int64_t)( 0 - magnitude );
+	}
+	else {
+		if( magnitude > (uint64_t)numeric_limits<int64_t>::max() )
+			return false;
+		*result = (int64_t)magnitude;
+	}
+	return true;
+}
+
+size_t decodeJsonString( const StringRef &str, std::string *result )
+{
+	const char *p = str.begin(), *end = str.end();
+	result->reserve( result->size() + str.size() );
+
+	auto readHex4 = [&]( uint32_t *value ) {
+		if( end - p < 4 )
+			return false;
+		uint32_t v = 0;
+		for( int i = 0; i < 4; ++i, ++p ) {
+			const char c = *p;
+			v <<= 4;
+			if( c >= '0' && c <= '9' ) v |= c - '0';
+			else if( c >= 'a' && c <= 'f' ) v |= c - 'a' + 10;
+			else if( c >= 'A' && c <= 'F' ) v |= c - 'A' + 10;
+			else return false;
+		}
+		*value = v;
+		return true;
+	};
+
+	while( p < end ) {
+		const char *backslash = (const char*)memchr( p, '\\', end - p );
+		if( ! backslash ) {
+			result->append( p, end );
+			break;
+		}
+		result->append( p, backslash );
+		p = backslash + 1;
+		const size_t escapeOffset = backslash - str.begin();
+		if( p == end )
+			return escapeOffset;
+
+		switch( *p++ ) {
+			case '"': *result += '"'; break;
+			case '\\': *result += '\\'; break;
+			case '/': *result += '/'; break;
+			case 'b': *result += '\b'; break;
+			case 'f': *result += '\f'; break;
+			case 'n': *result += '\n'; break;
+			case 'r': *result += '\r'; break;
+			case 't': *result += '\t'; break;
+			case 'u': {
+				uint32_t c;
+				if( ! readHex4( &c ) )
+					return escapeOffset;
+				if( c >= 0xD800 && c <= 0xDBFF ) {
+					// a high surrogate must be followed by an escaped low surrogate
+					uint32_t low;
+					if( end - p < 2 || p[0] != '\\' || p[1] != 'u' )
+						return escapeOffset;
+					p += 2;
+					if( ! readHex4( &low ) || low < 0xDC00 || low > 0xDFFF )
+						return escapeOffset;
+					c = 0x10000 + ( ( c - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+				}
+				else if( c >= 0xDC00 && c <= 0xDFFF )
+					return escapeOffset;
+
+				if( c < 0x80 )
+					*result += (char)c;
+				else if( c < 0x800 ) {
+					*result += (char)( 0xC0 | ( c >> 6 ) );
+					*result += (char)( 0x80 | ( c & 0x3F ) );
+				}
+				else if( c < 0x10000 ) {
+					*result += (char)( 0xE0 | ( c >> 12 ) );
+					*result += (char)( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+					*result += (char)( 0x80 | ( c & 0x3F ) );
+				}
+				else {
+					*result += (char)( 0xF0 | ( c >> 18 ) );
+					*result += (char)( 0x80 | ( ( c >> 12 ) & 0x3F ) );
+					*result += (char)( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+					*result += (char)( 0x80 | ( c & 0x3F ) );
+				}
+				break;
+			}
+			default:
+				return escapeOffset;
+		}
+	}
+
+	return std::string::npos;
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////
+// JsonDoc::Impl
+struct JsonDoc::Impl {
+	void		parse();
+	// returns the length of the number or literal at 'pos', setting 'type'
+	uint32_t	scanScalar( uint32_t pos, Type *type ) const;
+	[[noreturn]] void	throwParseError( size_t offset, const std::string &message ) const;
+
+	const Node&	getNode( uint32_t index ) const					{ return mNodes[index]; }
+	StringRef	getKey( const Node &node ) const				{ return StringRef( mData + node.mKeyOffset, node.mKeyLength ); }
+	bool		keyMatches( const Node &node, const StringRef &key ) const;
+	// returns the hash table of the members of the object 'index', building it on first use
+	const vector<uint32_t>&	getKeyIndex( uint32_t index ) const;
+	// decodes the escape sequences of the string at 'offset'
+	std::string	decodeString( uint32_t offset, uint32_t length ) const;
+
+	BufferRef			mBuffer;
+	std::string			mString;
+	const char			*mData;
+	size_t				mSize;
+
+	vector<Node>		mNodes; // in document order; the root is first
+	vector<uint32_t>	mChildIndex; // the children of each array and object, stored contiguously
+
+	mutable mutex									mKeyIndexMutex;
+	mutable unordered_map<uint32_t, vector<uint32_t>>	mKeyIndices; // open-addressed tables of member ordinals + 1, by object
+};
+
+void JsonDoc::Impl::parse()
+{
+	// skip a UTF-8 byte order mark
+	if( mSize >= 3 && memcmp( mData, "\xEF\xBB\xBF", 3 ) == 0 ) {
+		mData += 3;
+		mSize -= 3;
+	}
+	if( mSize >= NO_KEY )
+		throwParseError( 0, "documents of 4GB or more are not supported" );
+
+	vector<uint32_t> structurals;
+	if( ! buildStructuralIndex( mData, mSize, &structurals ) )
+		throwParseError( mSize, "unterminated string" );
+
+	// every value but the root is followed by a comma or closing bracket, so values seldom exceed half the structurals
+	mNodes.reserve( structurals.size() / 2 + 1 );
+	mChildIndex.reserve( structurals.size() / 2 );
+
+	const uint32_t *s = structurals.data(), *sEnd = s + structurals.size();
+	auto next = [&]() -> uint32_t {
+		if( s == sEnd )
+			throwParseError( mSize, "unexpected end of document" );
+		return *s++;
+	};
+
+	struct Frame {
+		uint32_t	mNode;
+		uint32_t	mFirstChild; // into 'children'
+	};
+	vector<Frame> stack;
+	// the children of every open array and object, innermost last
+	vector<uint32_t> children;
+	// avoids repeated growth when parsing many small documents
+	stack.reserve( 16 );
+	children.reserve( 64 );
+
+	auto addValue = [&]( uint32_t pos, uint32_t keyOffset, uint32_t keyLength ) {
+		Node node;
+		node.mNumChildren = 0;
+		node.mKeyOffset = keyOffset;
+		node.mKeyLength = keyLength;
+		if( ! stack.empty() )
+			children.push_back( (uint32_t)mNodes.size() );
+
+		const char c = mData[pos];
+		if( c == '{' || c == '[' ) {
+			node.mType = ( c == '{' ) ? TYPE_OBJECT : TYPE_ARRAY;
+			node.mOffset = pos;
+			node.mLength = 0;
+			stack.push_back( Frame{ (uint32_t)mNodes.size(), (uint32_t)children.size() } );
+		}
+		else if( c == '"' ) {
+			// the closing quote always follows, since nothing within a string is structural
+			const uint32_t end = next();
+			node.mType = TYPE_STRING;
+			node.mOffset = pos + 1;
+			node.mLength = end - pos - 1;
+		}
+		else {
+			node.mOffset = pos;
+			node.mLength = scanScalar( pos, &node.mType );
+		}
+		mNodes.push_back( node );
+	};
+
+	addValue( next(), NO_KEY, 0 );
+	while( ! stack.empty() ) {
+		const Frame frame = stack.back();
+		const bool isObject = mNodes[frame.mNode].mType == TYPE_OBJECT;
+		const char closer = isObject ? '}' : ']';
+
+		uint32_t pos = next();
+		if( mData[pos] == closer ) {
+			Node &node = mNodes[frame.mNode];
+			node.mLength = (uint32_t)mChildIndex.size();
+			node.mNumChildren = (uint32_t)( children.size() - frame.mFirstChild );
+			mChildIndex.insert( mChildIndex.end(), children.begin() + frame.mFirstChild, children.end() );
+			children.resize( frame.mFirstChild );
+			stack.pop_back();
+			continue;
+		}
+
+		if( children.size() != frame.mFirstChild ) {
+			if( mData[pos] != ',' )
+				throwParseError( pos, string( "expected ',' or '" ) + closer + "'" );
+			pos = next();
+		}
+
+		if( isObject ) {
+			if( mData[pos] != '"' )
+				throwParseError( pos, "expected a string key" );
+			const uint32_t keyEnd = next();
+			const uint32_t colon = next();
+			if( mData[colon] != ':' )
+				throwParseError( colon, "expected ':'" );
+			addValue( next(), pos + 1, keyEnd - pos - 1 );
+		}
+		else
+			addValue( pos, NO_KEY, 0 );
+	}
+
+	if( s != sEnd )
+		throwParseError( *s, "unexpected content after the document's value" );
+}
+
+uint32_t JsonDoc::Impl::scanScalar( uint32_t pos, Type *type ) const
+{
+	const char *begin = mData + pos, *end = mData + mSize, *p = begin;
+	while( p < end && ! isDelimiter( *p ) )
+		++p;
+
+	const StringRef token( begin, p - begin );
+	if( token.empty() )
+		throwParseError( pos, string( "unexpected character '" ) + *begin + "'" );
+	if( ! detail::parseJsonScalarType( token, type ) )
+		throwParseError( pos, "invalid value '" + token.str() + "'" );
+
+	return (uint32_t)token.size();
+}
+
+void JsonDoc::Impl::throwParseError( size_t offset, const std::string &message ) const
+{
+	size_t line = 1, column = 1;
+	for( size_t i = 0; i < offset && i < mSize; ++i ) {
+		if( mData[i] == '\n' ) {
+			++line;
+			column = 1;
+		}
+		else
+			++column;
+	}
+
+	throw ExcParseError( "JSON parse error at line " + to_string( line ) + ", column " + to_string( column ) + ": " + message, offset );
+}
+
+bool JsonDoc::Impl::keyMatches( const Node &node, const StringRef &key ) const
+{
+	const StringRef raw = getKey( node );
+	if( ! memchr( raw.data(), '\\', raw.size() ) )
+		return raw == key;
+	else
+		return decodeString( node.mKeyOffset, node.mKeyLength ) == key;
+}
+
+const vector<uint32_t>& JsonDoc::Impl::getKeyIndex( uint32_t index ) const
+{
+	// tables are never modified once built, and unordered_map never moves its elements, so the result may be read without the lock
+	lock_guard<mutex> lock( mKeyIndexMutex );
+	auto it = mKeyIndices.find( index );
+	if( it != mKeyIndices.end() )
+		return it->second;
+
+	const Node &object = mNodes[index];
+	size_t numSlots = 1;
+	while( numSlots < object.mNumChildren * 2 )
+		numSlots *= 2;
+
+	vector<uint32_t> slots( numSlots, 0 );
+	for( uint32_t i = 0; i < object.mNumChildren; ++i ) {
+		const Node &member = mNodes[mChildIndex[object.mLength + i]];
+		StringRef key = getKey( member );
+		std::string decoded;
+		if( memchr( key.data(), '\\', key.size() ) ) {
+			decoded = decodeString( member.mKeyOffset, member.mKeyLength );
+			key = decoded;
+		}
+
+		size_t slot = hashKey( key.data(), key.size() ) & ( numSlots - 1 );
+		while( slots[slot] )
+			slot = ( slot + 1 ) & ( numSlots - 1 );
+		slots[slot] = i + 1;
+	}
+
+	return mKeyIndices.emplace( index, std::move( slots ) ).first->second;
+}
+
+std::string JsonDoc::Impl::decodeString( uint32_t offset, uint32_t length ) const
+{
+	std::string result;
+	const size_t errorOffset = detail::decodeJsonString( StringRef( mData + offset, length ), &result );
+	if( errorOffset != std::string::npos )
+		throwParseError( offset + errorOffset, "invalid escape sequence" );
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// JsonDoc
+JsonDoc::JsonDoc( const DataSourceRef &dataSource )
+	: mImpl( new Impl )
+{
+	mImpl->mBuffer = dataSource->getBuffer();
+	mImpl->mData = (const char*)mImpl->mBuffer->getData();
+	mImpl->mSize = mImpl->mBuffer->getSize();
+	mImpl->parse();
+}
+
+JsonDoc::JsonDoc( std::string jsonString )
+	: mImpl( new Impl )
+{
+	mImpl->mString = std::move( jsonString );
+	mImpl->mData = mImpl->mString.data();
+	mImpl->mSize = mImpl->mString.size();
+	mImpl->parse();
+}
+
+JsonDoc::JsonDoc( JsonDoc &&rhs ) = default;
+JsonDoc& JsonDoc::operator=( JsonDoc &&rhs ) = default;
+JsonDoc::~JsonDoc() = default;
+
+JsonDoc::Value JsonDoc::getRoot() const
+{
+	return Value( mImpl.get(), 0 );
+}
+
+size_t JsonDoc::getNumValues() const
+{
+	return mImpl->mNodes.size();
+}
+
+StringRef JsonDoc::getSource() const
+{
+	return StringRef( mImpl->mData, mImpl->mSize );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// JsonDoc::Value
+JsonDoc::Type JsonDoc::Value::getType() const
+{
+	if( ! mImpl )
+		throw JsonDoc::Exception( "invalid JsonDoc::Value" );
+	return mImpl->getNode( mIndex ).mType;
+}
+
+size_t JsonDoc::Value::getNumChildren() const
+{
+	const Type type = getType();
+	return ( type == TYPE_ARRAY || type == TYPE_OBJECT ) ? mImpl->getNode( mIndex ).mNumChildren : 0;
+}
+
+JsonDoc::Iter JsonDoc::Value::begin() const
+{
+	if( ! getNumChildren() )
+		return Iter( mImpl, nullptr );
+	return Iter( mImpl, mImpl->mChildIndex.data() + mImpl->getNode( mIndex ).mLength );
+}
+
+JsonDoc::Iter JsonDoc::Value::end() const
+{
+	const size_t numChildren = getNumChildren();
+	if( ! numChildren )
+		return Iter( mImpl, nullptr );
+	return Iter( mImpl, mImpl->mChildIndex.data() + mImpl->getNode( mIndex ).mLength + numChildren );
+}
+
+JsonDoc::Value JsonDoc::Value::operator[]( const StringRef &key ) const
+{
+	Value result = findChild( key );
+	if( ! result.isValid() )
+		throw ExcChildNotFound( "No JSON member with key '" + key.str() + "'" );
+	return result;
+}
+
+JsonDoc::Value JsonDoc::Value::getChild( size_t index ) const
+{
+	if( index >= getNumChildren() )
+		throw ExcChildNotFound( "No JSON child at index " + to_string( index ) );
+	return Value( mImpl, mImpl->mChildIndex[mImpl->getNode( mIndex ).mLength + index] );
+}
+
+JsonDoc::Value JsonDoc::Value::getChild( const StringRef &relativePath, char separator ) const
+{
+	Value result = findDescendant( relativePath, separator );
+	if( ! result.isValid() )
+		throw ExcChildNotFound( "No JSON child at path '" + relativePath.str() + "'" );
+	return result;
+}
+
+JsonDoc::Value JsonDoc::Value::findChild( const StringRef &key ) const
+{
+	if( getType() != TYPE_OBJECT )
+		return Value();
+
+	const Node &object = mImpl->getNode( mIndex );
+	const uint32_t *members = mImpl->mChildIndex.data() + object.mLength;
+	if( object.mNumChildren < MIN_HASHED_MEMBERS ) {
+		for( uint32_t i = 0; i < object.mNumChildren; ++i ) {
+			if( mImpl->keyMatches( mImpl->getNode( members[i] ), key ) )
+				return Value( mImpl, members[i] );
+		}
+		return Value();
+	}
+
+	const vector<uint32_t> &slots = mImpl->getKeyIndex( mIndex );
+	const size_t mask = slots.size() - 1;
+	for( size_t slot = hashKey( key.data(), key.size() ) & mask; slots[slot]; slot = ( slot + 1 ) & mask ) {
+		const uint32_t member = members[slots[slot] - 1];
+		if( mImpl->keyMatches( mImpl->getNode( member ), key ) )
+			return Value( mImpl, member );
+	}
+	return Value();
+}
+
+bool JsonDoc::Value::hasChild( const StringRef &relativePath, char separator ) const
+{
+	return findDescendant( relativePath, separator ).isValid();
+}
+
+JsonDoc::Value JsonDoc::Value::findDescendant( const StringRef &relativePath, char separator ) const
+{
+	Value result = *this;
+	const char *p = relativePath.begin(), *end = relativePath.end();
+	while( result.isValid() ) {
+		const char *componentEnd = std::find( p, end, separator );
+		const StringRef component( p, componentEnd - p );
+		if( result.getType() == TYPE_ARRAY && ! component.empty() && std::all_of( component.begin(), component.end(), isDigit ) ) {
+			const size_t index = (size_t)strtoull( component.str().c_str(), nullptr, 10 );
+			result = ( index < result.getNumChildren() ) ? result.getChild( index ) : Value();
+		}
+		else
+			result = result.findChild( component );
+
+		if( componentEnd == end )
+			break;
+		p = componentEnd + 1;
+	}
+
+	return result;
+}
+
+StringRef JsonDoc::Value::getKey() const
+{
+	getType();
+	const Node &node = mImpl->getNode( mIndex );
+	return ( node.mKeyOffset == NO_KEY ) ? StringRef() : mImpl->getKey( node );
+}
+
+StringRef JsonDoc::Value::getRaw() const
+{
+	const Type type = getType();
+	if( type == TYPE_ARRAY || type == TYPE_OBJECT )
+		return StringRef();
+	const Node &node = mImpl->getNode( mIndex );
+	return StringRef( mImpl->mData + node.mOffset, node.mLength );
+}
+
+bool JsonDoc::Value::hasEscapes() const
+{
+	const StringRef raw = getRaw();
+	return getType() == TYPE_STRING && memchr( raw.data(), '\\', raw.size() ) != nullptr;
+}
+
+bool JsonDoc::Value::getBool() const
+{
+	if( getType() != TYPE_BOOL )
+		throwNonConvertible();
+	return mImpl->mData[mImpl->getNode( mIndex ).mOffset] == 't';
+}
+
+int64_t JsonDoc::Value::getInt() const
+{
+	int64_t result;
+	if( getType() != TYPE_NUMBER || ! detail::parseJsonInt( getRaw(), &result ) )
+		throwNonConvertible();
+	return result;
+}
+
+uint64_t JsonDoc::Value::getUint() const
+{
+	uint64_t result;
+	if( getType() != TYPE_NUMBER || ! detail::parseJsonUint( getRaw(), &result ) )
+		throwNonConvertible();
+	return result;
+}
+
+double JsonDoc::Value::getDouble() const
+{
+	if( getType() != TYPE_NUMBER )
+		throwNonConvertible();
+	return detail::parseJsonDouble( getRaw() );
+}
+
+std::string JsonDoc::Value::getString() const
+{
+	const Type type = getType();
+	if( type == TYPE_ARRAY || type == TYPE_OBJECT )
+		throwNonConvertible();
+
+	const Node &node = mImpl->getNode( mIndex );
+	if( type == TYPE_STRING && memchr( mImpl->mData + node.mOffset, '\\', node.mLength ) )
+		return mImpl->decodeString( node.mOffset, node.mLength );
+	return std::string( mImpl->mData + node.mOffset, node.mLength );
+}
+
+void JsonDoc::Value::throwNonConvertible() const
+{
+	const Type type = getType();
+	string description = string( "JSON " ) + getTypeName( type );
+	if( type != TYPE_ARRAY && type != TYPE_OBJECT )
+		description += " '" + getRaw().str() + "'";
+	throw ExcNonConvertible( description + " is not convertible to the requested type" );
+}
+
+} // namespace cinder
@@ -0,0 +1,791 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/JsonStream.h"
+#include "cinder/Log.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+enum Container : uint8_t { CONTAINER_OBJECT, CONTAINER_ARRAY };
+
+inline bool isWhitespace( char c )
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDelimiter( char c )
+{
+	switch( c ) {
+		case ' ': case '\n': case '\t': case '\r': case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+			return true;
+		default:
+			return false;
+	}
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////////////
+// JsonWriter
+JsonWriter::JsonWriter( const OStreamRef &stream, int indent, bool multipleValues, size_t bufferSize )
+	: mStream( stream ), mBuffer( std::max<size_t>( bufferSize, 64 ) ), mBufferPos( 0 ), mIndent( indent ), mMultipleValues( multipleValues ),
+		mFirstInContainer( true ), mHasKey( false ), mDocumentDone( false )
+{
+}
+
+JsonWriter::JsonWriter( const DataTargetRef &dataTarget, int indent, bool multipleValues, size_t bufferSize )
+	: JsonWriter( dataTarget->getStream(), indent, multipleValues, bufferSize )
+{
+}
+
+JsonWriter::~JsonWriter()
+{
+	try {
+		flush();
+	}
+	catch( const std::exception &exc ) {
+		CI_LOG_E( "failed to flush JSON output: " << exc.what() );
+	}
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+	beginValue();
+	write( '{' );
+	mStack.push_back( CONTAINER_OBJECT );
+	mFirstInContainer = true;
+	return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+	endContainer( CONTAINER_OBJECT );
+	return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+	beginValue();
+	write( '[' );
+	mStack.push_back( CONTAINER_ARRAY );
+	mFirstInContainer = true;
+	return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+	endContainer( CONTAINER_ARRAY );
+	return *this;
+}
+
+JsonWriter& JsonWriter::key( const StringRef &key )
+{
+	if( mStack.empty() || mStack.back() != CONTAINER_OBJECT || mHasKey )
+		throw JsonWriterExc( "JsonWriter: a key must precede each value within an object, and only there" );
+
+	if( ! mFirstInContainer )
+		write( ',' );
+	mFirstInContainer = false;
+	writeNewline();
+	writeString( key );
+	write( ':' );
+	if( mIndent >= 0 )
+		write( ' ' );
+	mHasKey = true;
+	return *this;
+}
+
+JsonWriter& JsonWriter::value( std::nullptr_t )
+{
+	beginValue();
+	write( "null", 4 );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::value( bool value )
+{
+	beginValue();
+	if( value )
+		write( "true", 4 );
+	else
+		write( "false", 5 );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::writeInt( int64_t value )
+{
+	if( value >= 0 )
+		return writeUint( (uint64_t)value );
+
+	beginValue();
+	char digits[24];
+	char *p = digits + sizeof( digits );
+	uint64_t magnitude = 0 - (uint64_t)value;
+	do {
+		*--p = (char)( '0' + magnitude % 10 );
+		magnitude /= 10;
+	} while( magnitude );
+	*--p = '-';
+	write( p, digits + sizeof( digits ) - p );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::writeUint( uint64_t value )
+{
+	beginValue();
+	char digits[24];
+	char *p = digits + sizeof( digits );
+	do {
+		*--p = (char)( '0' + value % 10 );
+		value /= 10;
+	} while( value );
+	write( p, digits + sizeof( digits ) - p );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::value( double value )
+{
+	if( ! std::isfinite( value ) )
+		return this->value( nullptr );
+
+	beginValue();
+	char digits[64];
+	// shortest round-trip formatting, independent of the C locale
+	char *end = nlohmann::detail::to_chars( digits, digits + sizeof( digits ), value );
+	write( digits, end - digits );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::value( const StringRef &value )
+{
+	beginValue();
+	writeString( value );
+	endValue();
+	return *this;
+}
+
+JsonWriter& JsonWriter::value( const Json &json )
+{
+	switch( json.type() ) {
+		case Json::value_t::null:
+			return value( nullptr );
+		case Json::value_t::boolean:
+			return value( json.get<bool>() );
+		case Json::value_t::number_integer:
+			return writeInt( json.get<int64_t>() );
+		case Json::value_t::number_unsigned:
+			return writeUint( json.get<uint64_t>() );
+		case Json::value_t::number_float:
+			return value( json.get<double>() );
+		case Json::value_t::string:
+			return value( json.get_ref<const std::string&>() );
+		case Json::value_t::array:
+			beginArray();
+			for( const auto &child : json )
+				value( child );
+			return endArray();
+		case Json::value_t::object:
+			beginObject();
+			for( auto it = json.begin(); it != json.end(); ++it ) {
+				key( it.key() );
+				value( it.value() );
+			}
+			return endObject();
+		default:
+			throw JsonWriterExc( "JsonWriter: binary values have no JSON representation" );
+	}
+}
+
+JsonWriter& JsonWriter::rawValue( const StringRef &json )
+{
+	beginValue();
+	write( json.data(), json.size() );
+	endValue();
+	return *this;
+}
+
+void JsonWriter::flush()
+{
+	if( mBufferPos ) {
+		mStream->writeData( mBuffer.data(), mBufferPos );
+		mBufferPos = 0;
+	}
+}
+
+void JsonWriter::beginValue()
+{
+	if( mStack.empty() ) {
+		if( mDocumentDone && ! mMultipleValues )
+			throw JsonWriterExc( "JsonWriter: a document has a single top-level value unless multiple values are enabled" );
+	}
+	else if( mStack.back() == CONTAINER_OBJECT ) {
+		if( ! mHasKey )
+			throw JsonWriterExc( "JsonWriter: values within an object require a key" );
+		// key() wrote the separator
+		mHasKey = false;
+	}
+	else {
+		if( ! mFirstInContainer )
+			write( ',' );
+		mFirstInContainer = false;
+		writeNewline();
+	}
+}
+
+void JsonWriter::endValue()
+{
+	if( mStack.empty() ) {
+		mDocumentDone = true;
+		if( mMultipleValues )
+			write( '\n' );
+	}
+}
+
+void JsonWriter::endContainer( uint8_t container )
+{
+	if( mStack.empty() || mStack.back() != container || mHasKey )
+		throw JsonWriterExc( container == CONTAINER_OBJECT ? "JsonWriter: endObject() does not match an open object" : "JsonWriter: endArray() does not match an open array" );
+
+	mStack.pop_back();
+	if( ! mFirstInContainer )
+		writeNewline();
+	write( container == CONTAINER_OBJECT ? '}' : ']' );
+	mFirstInContainer = false;
+	endValue();
+}
+
+void JsonWriter::writeNewline()
+{
+	if( mIndent < 0 )
+		return;
+
+	write( '\n' );
+	for( size_t i = mIndent * mStack.size(); i > 0; --i )
+		write( ' ' );
+}
+
+void JsonWriter::writeString( const StringRef &str )
+{
+	static const char sHexDigits[] = "0123456789abcdef";
+
+	write( '"' );
+	const char *run = str.begin();
+	for( const char *p = str.begin(); p < str.end(); ++p ) {
+		const uint8_t c = (uint8_t)*p;
+		if( c >= 0x20 && c != '"' && c != '\\' )
+			continue;
+
+		write( run, p - run );
+		run = p + 1;
+		char escape[6] = { '\\', 0 };
+		size_t escapeLength = 2;
+		switch( c ) {
+			case '"': escape[1] = '"'; break;
+			case '\\': escape[1] = '\\'; break;
+			case '\b': escape[1] = 'b'; break;
+			case '\f': escape[1] = 'f'; break;
+			case '\n': escape[1] = 'n'; break;
+			case '\r': escape[1] = 'r'; break;
+			case '\t': escape[1] = 't'; break;
+			default:
+				memcpy( escape + 1, "u00", 3 );
+				escape[4] = sHexDigits[c >> 4];
+				escape[5] = sHexDigits[c & 0xF];
+				escapeLength = 6;
+		}
+		write( escape, escapeLength );
+	}
+	write( run, str.end() - run );
+	write( '"' );
+}
+
+void JsonWriter::write( const char *data, size_t size )
+{
+	if( size > mBuffer.size() - mBufferPos ) {
+		flush();
+		// too large to be worth staging
+		if( size >= mBuffer.size() ) {
+			mStream->writeData( data, size );
+			return;
+		}
+	}
+
+	memcpy( mBuffer.data() + mBufferPos, data, size );
+	mBufferPos += size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// JsonReader
+JsonReader::JsonReader( const IStreamRef &stream, bool multipleValues, size_t bufferSize )
+	: mStream( stream ), mMultipleValues( multipleValues ), mBuffer( std::max<size_t>( bufferSize, 64 ) ), mPos( 0 ), mEnd( 0 ), mBufferOffset( 0 ),
+		mStreamEnd( false ), mState( multipleValues ? DOCUMENT_END : VALUE ), mEvent( END_DOCUMENT ), mEventOffset( 0 ), mTokenBegin( 0 ), mTokenLength( 0 ),
+		mTokenDecoded( false )
+{
+	// skip a UTF-8 byte order mark
+	size_t keep = 0;
+	while( mEnd < 3 && fill( &keep ) )
+		;
+	if( mEnd >= 3 && memcmp( mBuffer.data(), "\xEF\xBB\xBF", 3 ) == 0 )
+		mPos = 3;
+}
+
+JsonReader::JsonReader( const DataSourceRef &dataSource, bool multipleValues, size_t bufferSize )
+	: JsonReader( dataSource->createStream(), multipleValues, bufferSize )
+{
+}
+
+JsonReader::Event JsonReader::next()
+{
+	while( true ) {
+		const int c = peek();
+		mEventOffset = mBufferOffset + mPos;
+		if( c < 0 && mState != DOCUMENT_END && mState != DONE )
+			throwParseError( mEventOffset, "unexpected end of document" );
+
+		switch( mState ) {
+			case DONE:
+				return mEvent = END_DOCUMENT;
+			case DOCUMENT_END:
+				if( c < 0 ) {
+					mState = DONE;
+					return mEvent = END_DOCUMENT;
+				}
+				if( ! mMultipleValues )
+					throwParseError( mEventOffset, "unexpected content after the document's value" );
+				mState = VALUE;
+			break;
+			case FIRST_VALUE_OR_END:
+				if( c == ']' )
+					return endContainer();
+				mState = VALUE;
+			break;
+			case FIRST_KEY_OR_END:
+				if( c == '}' )
+					return endContainer();
+				mState = KEY_STATE;
+			break;
+			case COMMA_OR_END: {
+				const bool isObject = mStack.back() == CONTAINER_OBJECT;
+				const char closer = isObject ? '}' : ']';
+				if( c == closer )
+					return endContainer();
+				if( c != ',' )
+					throwParseError( mEventOffset, string( "expected ',' or '" ) + closer + "'" );
+				++mPos;
+				mState = isObject ? KEY_STATE : VALUE;
+			}
+			break;
+			case KEY_STATE:
+				if( c != '"' )
+					throwParseError( mEventOffset, "expected a string key" );
+				readString();
+				mState = COLON;
+				return mEvent = KEY;
+			case COLON:
+				if( c != ':' )
+					throwParseError( mEventOffset, "expected ':'" );
+				++mPos;
+				mState = VALUE;
+			break;
+			case VALUE:
+				if( c == '{' || c == '[' ) {
+					++mPos;
+					mStack.push_back( c == '{' ? CONTAINER_OBJECT : CONTAINER_ARRAY );
+					mState = ( c == '{' ) ? FIRST_KEY_OR_END : FIRST_VALUE_OR_END;
+					return mEvent = ( c == '{' ) ? BEGIN_OBJECT : BEGIN_ARRAY;
+				}
+				else if( c == '"' ) {
+					readString();
+					mEvent = STRING;
+				}
+				else
+					readScalar();
+				afterValue();
+				return mEvent;
+		}
+	}
+}
+
+StringRef JsonReader::getString() const
+{
+	switch( mEvent ) {
+		case KEY:
+		case STRING:
+			if( mTokenDecoded )
+				return StringRef( mDecoded );
+		// fall through
+		case NUMBER:
+		case BOOL:
+		case NULL_VALUE:
+			return StringRef( mBuffer.data() + mTokenBegin, mTokenLength );
+		default:
+			throwNonConvertible();
+	}
+}
+
+bool JsonReader::getBool() const
+{
+	if( mEvent != BOOL )
+		throwNonConvertible();
+	return mBuffer[mTokenBegin] == 't';
+}
+
+int64_t JsonReader::getInt() const
+{
+	int64_t result;
+	if( mEvent != NUMBER || ! detail::parseJsonInt( getString(), &result ) )
+		throwNonConvertible();
+	return result;
+}
+
+uint64_t JsonReader::getUint() const
+{
+	uint64_t result;
+	if( mEvent != NUMBER || ! detail::parseJsonUint( getString(), &result ) )
+		throwNonConvertible();
+	return result;
+}
+
+double JsonReader::getDouble() const
+{
+	if( mEvent != NUMBER )
+		throwNonConvertible();
+	return detail::parseJsonDouble( getString() );
+}
+
+void JsonReader::skipValue()
+{
+	if( mEvent == KEY )
+		next();
+	if( mEvent == BEGIN_OBJECT || mEvent == BEGIN_ARRAY ) {
+		const size_t depth = mStack.size() - 1;
+		while( mStack.size() > depth )
+			next();
+	}
+}
+
+Json JsonReader::readValue()
+{
+	if( mEvent == KEY )
+		next();
+
+	if( mEvent == BEGIN_OBJECT ) {
+		Json result = Json::object();
+		while( next() == KEY ) {
+			std::string key = getString().str();
+			result[key] = readValue();
+		}
+		return result;
+	}
+	else if( mEvent == BEGIN_ARRAY ) {
+		Json result = Json::array();
+		while( next() != END_ARRAY )
+			result.push_back( readValue() );
+		return result;
+	}
+	else
+		return readScalarValue();
+}
+
+Json JsonReader::readScalarValue() const
+{
+	switch( mEvent ) {
+		case NULL_VALUE:
+			return nullptr;
+		case BOOL:
+			return getBool();
+		case STRING:
+			return getString().str();
+		case NUMBER: {
+			// match nlohmann::json, which keeps integers without a fraction or exponent as integers
+			const StringRef number = getString();
+			if( std::find_if( number.begin(), number.end(), []( char c ) { return c == '.' || c == 'e' || c == 'E'; } ) == number.end() ) {
+				int64_t i;
+				uint64_t u;
+				if( detail::parseJsonInt( number, &i ) )
+					return i;
+				if( detail::parseJsonUint( number, &u ) )
+					return u;
+			}
+			return detail::parseJsonDouble( number );
+		}
+		default:
+			throw JsonDoc::Exception( "JsonReader: readValue() requires an event which begins a value" );
+	}
+}
+
+int JsonReader::peek()
+{
+	while( true ) {
+		while( mPos < mEnd ) {
+			const char c = mBuffer[mPos];
+			if( ! isWhitespace( c ) )
+				return (uint8_t)c;
+			++mPos;
+		}
+
+		size_t keep = mPos;
+		if( ! fill( &keep ) )
+			return -1;
+	}
+}
+
+bool JsonReader::fill( size_t *keep )
+{
+	if( mStreamEnd )
+		return false;
+
+	if( *keep > 0 ) {
+		memmove( mBuffer.data(), mBuffer.data() + *keep, mEnd - *keep );
+		mBufferOffset += *keep;
+		mPos -= *keep;
+		mEnd -= *keep;
+		*keep = 0;
+	}
+	// only a single token longer than the buffer grows it
+	if( mEnd == mBuffer.size() )
+		mBuffer.resize( mBuffer.size() * 2 );
+
+	const size_t numRead = mStream->readDataAvailable( mBuffer.data() + mEnd, mBuffer.size() - mEnd );
+	if( numRead == 0 ) {
+		mStreamEnd = true;
+		return false;
+	}
+
+	mEnd += numRead;
+	return true;
+}
+
+void JsonReader::readString()
+{
+	// 'keep' is the opening quote, and 'scanned' the number of characters from it which are known not to close the string
+	size_t keep = mPos, scanned = 1;
+	bool hasEscapes = false;
+	while( true ) {
+		const char *data = mBuffer.data() + keep;
+		const size_t available = mEnd - keep;
+		if( scanned < available ) {
+			const char *quote = (const char*)memchr( data + scanned, '"', available - scanned );
+			const char *limit = quote ? quote : data + available;
+			const char *backslash = (const char*)memchr( data + scanned, '\\', limit - ( data + scanned ) );
+			if( backslash ) {
+				// skip the escaped character, which may be a quote
+				hasEscapes = true;
+				scanned = backslash - data + 2;
+				continue;
+			}
+			if( quote ) {
+				scanned = quote - data;
+				break;
+			}
+			scanned = available;
+		}
+
+		if( ! fill( &keep ) )
+			throwParseError( mBufferOffset + keep, "unterminated string" );
+	}
+
+	mTokenBegin = keep + 1;
+	mTokenLength = scanned - 1;
+	mPos = keep + scanned + 1;
+	mTokenDecoded = hasEscapes;
+	if( hasEscapes ) {
+		mDecoded.clear();
+		const size_t errorOffset = detail::decodeJsonString( StringRef( mBuffer.data() + mTokenBegin, mTokenLength ), &mDecoded );
+		if( errorOffset != std::string::npos )
+			throwParseError( mBufferOffset + mTokenBegin + errorOffset, "invalid escape sequence" );
+	}
+}
+
+void JsonReader::readScalar()
+{
+	size_t keep = mPos, length = 0;
+	while( true ) {
+		while( keep + length < mEnd && ! isDelimiter( mBuffer[keep + length] ) )
+			++length;
+		if( keep + length < mEnd || ! fill( &keep ) )
+			break;
+	}
+
+	const StringRef token( mBuffer.data() + keep, length );
+	if( token.empty() )
+		throwParseError( mBufferOffset + keep, string( "unexpected character '" ) + mBuffer[keep] + "'" );
+
+	JsonDoc::Type type;
+	if( ! detail::parseJsonScalarType( token, &type ) )
+		throwParseError( mBufferOffset + keep, "invalid value '" + token.str() + "'" );
+
+	mEvent = ( type == JsonDoc::TYPE_NUMBER ) ? NUMBER : ( type == JsonDoc::TYPE_BOOL ) ? BOOL : NULL_VALUE;
+	mTokenBegin = keep;
+	mTokenLength = length;
+	mTokenDecoded = false;
+	mPos = keep + length;
+}
+
+JsonReader::Event JsonReader::endContainer()
+{
+	++mPos;
+	mEvent = ( mStack.back() == CONTAINER_OBJECT ) ? END_OBJECT : END_ARRAY;
+	mStack.pop_back();
+	afterValue();
+	return mEvent;
+}
+
+void JsonReader::throwParseError( uint64_t offset, const std::string &message ) const
+{
+	throw JsonDoc::ExcParseError( "JSON parse error at offset " + to_string( offset ) + ": " + message, (size_t)offset );
+}
+
+void JsonReader::throwNonConvertible() const
+{
+	static const char *sEventNames[] = { "BEGIN_OBJECT", "END_OBJECT", "BEGIN_ARRAY", "END_ARRAY", "KEY", "NULL_VALUE", "BOOL", "NUMBER", "STRING", "END_DOCUMENT" };
+	throw JsonDoc::ExcNonConvertible( string( "JsonReader: event " ) + sEventNames[mEvent] + " is not convertible to the requested type" );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// NdjsonReader
+NdjsonReader::NdjsonReader( const IStreamRef &stream, size_t maxQueuedRecords )
+	: mStream( stream ), mMaxBatchSize( std::max<size_t>( maxQueuedRecords / NUM_QUEUED_BATCHES, 1 ) ), mBatches( NUM_QUEUED_BATCHES ), mBatchPos( 0 ),
+		mCanceled( false ), mDone( false )
+{
+	mThread = thread( &NdjsonReader::threadEntry, this );
+}
+
+NdjsonReader::NdjsonReader( const DataSourceRef &dataSource, size_t maxQueuedRecords )
+	: NdjsonReader( dataSource->createStream(), maxQueuedRecords )
+{
+}
+
+NdjsonReader::~NdjsonReader()
+{
+	mCanceled = true;
+	mBatches.cancel();
+	mThread.join();
+}
+
+JsonDocRef NdjsonReader::readNext()
+{
+	while( ! mDone ) {
+		if( mBatch && mBatchPos < mBatch->size() )
+			return std::move( (*mBatch)[mBatchPos++] );
+
+		mBatch.reset();
+		mBatchPos = 0;
+		mBatches.popBack( &mBatch );
+		if( ! mBatch ) {
+			mDone = true;
+			if( mException )
+				rethrow_exception( mException );
+		}
+	}
+
+	return nullptr;
+}
+
+void NdjsonReader::threadEntry()
+{
+	ThreadSetup threadSetup;
+
+	auto batch = make_shared<vector<JsonDocRef>>();
+	// queues the records parsed so far, returning false when canceled
+	auto pushBatch = [&] {
+		if( ! batch->empty() ) {
+			mBatches.pushFront( batch );
+			batch = make_shared<vector<JsonDocRef>>();
+		}
+		return ! mCanceled;
+	};
+
+	try {
+		vector<char> buffer( 65536 );
+		// the unconsumed characters are [begin, end), of which [begin, searched) contain no newline
+		size_t begin = 0, end = 0, searched = 0, lineNumber = 1;
+		uint64_t bufferOffset = 0;
+		bool streamEnd = false;
+		while( ! mCanceled ) {
+			const char *newline = (const char*)memchr( buffer.data() + searched, '\n', end - searched );
+			if( ! newline && ! streamEnd ) {
+				// hand over what is parsed before waiting on the stream, so that slow streams are not held back
+				if( ! pushBatch() )
+					break;
+
+				if( begin > 0 ) {
+					memmove( buffer.data(), buffer.data() + begin, end - begin );
+					bufferOffset += begin;
+					end -= begin;
+					begin = 0;
+				}
+				searched = end;
+				if( end == buffer.size() )
+					buffer.resize( buffer.size() * 2 );
+				const size_t numRead = mStream->readDataAvailable( buffer.data() + end, buffer.size() - end );
+				streamEnd = numRead == 0;
+				end += numRead;
+				continue;
+			}
+
+			const size_t lineEnd = newline ? newline - buffer.data() : end;
+			const char *line = buffer.data() + begin;
+			const size_t lineLength = lineEnd - begin;
+			if( ! all_of( line, line + lineLength, isWhitespace ) ) {
+				try {
+					batch->push_back( make_shared<JsonDoc>( string( line, lineLength ) ) );
+				}
+				catch( const JsonDoc::ExcParseError &exc ) {
+					throw JsonDoc::ExcParseError( "NDJSON record on line " + to_string( lineNumber ) + ": " + exc.what(), (size_t)( bufferOffset + begin + exc.getOffset() ) );
+				}
+				if( batch->size() >= mMaxBatchSize && ! pushBatch() )
+					break;
+			}
+
+			if( ! newline )
+				break;
+			begin = searched = lineEnd + 1;
+			++lineNumber;
+		}
+
+		pushBatch();
+	}
+	catch( ... ) {
+		// records before the error are still returned
+		pushBatch();
+		mException = current_exception();
+	}
+
+	mBatches.pushFront( nullptr );
+}
+
+} // namespace cinder
@@ -51,6 +51,9 @@
 #include <algorithm>
 #include <time.h>
 #include <cstring>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 
 using namespace std;
 
@@ -59,15 +62,23 @@ namespace cinder { namespace log {
 namespace  {
 
 // output format is YYYY-MM-DD.HH:mm:ss
-const std::string getCurrentDateTimeString()
+const std::string& getDateTimeString( const chrono::system_clock::time_point &timestamp )
 {
-	time_t timeSinceEpoch = time( NULL );
-	struct tm *now = localtime( &timeSinceEpoch );
-
-	char result[100];
-	strftime( result, sizeof( result ), "%Y-%m-%d.%X", now );
+	// localtime() is slow, so reuse the string for records logged within the same second
+	static thread_local time_t sCachedTime = -1;
+	static thread_local std::string sCachedString;
+
+	time_t timeSinceEpoch = chrono::system_clock::to_time_t( timestamp );
+	if( timeSinceEpoch != sCachedTime ) {
+		struct tm *now = localtime( &timeSinceEpoch );
+
+		char result[100];
+		strftime( result, sizeof( result ), "%Y-%m-%d.%X", now );
+		sCachedString = result;
+		sCachedTime = timeSinceEpoch;
+	}
 
-	return result;
+	return sCachedString;
 }
 
 int getCurrentYearDay()
@@ -89,8 +100,386 @@ const std::string getDailyLogString( const std::string& format )
 	return result;
 }
 
+thread_local bool sIsAsyncWriterThread = false;
+
+// writes a deferred record to 'loggers', formatting it at most once for those which do not accept unformatted arguments
+void writeArgsToLoggers( const vector<LoggerRef> &loggers, const Metadata &meta, const detail::DeferredArg *args, size_t numArgs )
+{
+	string text;
+	bool formatted = false;
+	for( auto &logger : loggers ) {
+		if( logger->writeArgs( meta, args, numArgs ) )
+			continue;
+
+		if( ! formatted ) {
+			ostringstream stream;
+			for( size_t i = 0; i < numArgs; ++i )
+				args[i].mStream( stream, args[i].mData );
+			text = stream.str();
+			formatted = true;
+		}
+		logger->write( meta, text );
+	}
+}
+
 } // anonymous namespace
 
+// ----------------------------------------------------------------------------------------------------
+// LogManager::AsyncWriter
+// ----------------------------------------------------------------------------------------------------
+
+// Each logging thread owns a single-producer single-consumer ring of bytes holding its records, which the writer thread drains.
+// A record is a RecordHeader followed by its payload, padded to 8 bytes; a record never wraps around the end of the ring,
+// instead the remainder of the ring is skipped by a PADDING record.
+class LogManager::AsyncWriter {
+  public:
+	AsyncWriter( LogManager *manager )
+		: mManager( manager ), mRingSize( 0 ), mGeneration( 0 ), mStop( false ), mWake( false ), mNumDroppedReported( 0 )
+	{}
+
+	~AsyncWriter()
+	{
+		stop();
+	}
+
+	void start( size_t ringSize )
+	{
+		size_t size = 256;
+		while( size < ringSize )
+			size *= 2;
+		mRingSize = size;
+		// threads replace their rings when the generation changes, so that the new size takes effect
+		mGeneration.fetch_add( 1, memory_order_release );
+
+		mStop = false;
+		mThread = thread( &AsyncWriter::run, this );
+	}
+
+	// writes every pending record and joins the writer thread; mManager->mAsync must already be false
+	void stop()
+	{
+		if( ! mThread.joinable() )
+			return;
+
+		// wait for any push that began before async was disabled
+		for( auto &ring : getRings() ) {
+			while( ring->mWriting.load( memory_order_seq_cst ) )
+				this_thread::yield();
+		}
+
+		{
+			lock_guard<mutex> lock( mWakeMutex );
+			mStop = true;
+		}
+		mWakeCv.notify_one();
+		mThread.join();
+	}
+
+	// blocks until every record pushed before the call has been written
+	void flush()
+	{
+
+		vector<pair<shared_ptr<Ring>, size_t>> targets;
+		for( auto &ring : getRings() )
+			targets.emplace_back( ring, ring->mHead.load( memory_order_acquire ) );
+
+		wake();
+		unique_lock<mutex> lock( mFlushedMutex );
+		mFlushedCv.wait( lock, [&] {
+			for( auto &target : targets ) {
+				if( target.first->mTail.load( memory_order_acquire ) < target.second )
+					return false;
+			}
+			return true;
+		} );
+	}
+
+	bool push( const Metadata &meta, const std::string &text )
+	{
+		const string &function = meta.mLocation.getFunctionName();
+		const string &file = meta.mLocation.getFileName();
+		const size_t payloadSize = function.size() + file.size() + text.size();
+
+		return push( RecordHeader::TEXT, meta.mLevel, meta.mTimestamp, meta.mLocation.getLineNumber(), payloadSize,
+			[&]( RecordHeader *header, uint8_t *payload ) {
+				header->mFunctionLength = (uint32_t)function.size();
+				header->mFileLength = (uint32_t)file.size();
+				header->mTextLength = (uint32_t)text.size();
+				memcpy( payload, function.data(), function.size() );
+				memcpy( payload + function.size(), file.data(), file.size() );
+				memcpy( payload + function.size() + file.size(), text.data(), text.size() );
+			} );
+	}
+
+	bool push( Level level, const char *function, const char *file, size_t line, const detail::DeferredArg *args, size_t numArgs )
+	{
+		size_t payloadSize = 2 * sizeof( const char* );
+		for( size_t i = 0; i < numArgs; ++i )
+			payloadSize += sizeof( DeferredArgHeader ) + alignSize( args[i].mSize );
+
+		return push( RecordHeader::DEFERRED, level, chrono::system_clock::now(), line, payloadSize,
+			[&]( RecordHeader *header, uint8_t *payload ) {
+				header->mFunctionLength = 0;
+				header->mFileLength = (uint32_t)numArgs;
+				header->mTextLength = 0;
+				memcpy( payload, &function, sizeof( const char* ) );
+				memcpy( payload + sizeof( const char* ), &file, sizeof( const char* ) );
+				payload += 2 * sizeof( const char* );
+				for( size_t i = 0; i < numArgs; ++i ) {
+					DeferredArgHeader argHeader = { args[i].mStream, args[i].mSize, args[i].mType };
+					memcpy( payload, &argHeader, sizeof( argHeader ) );
+					memcpy( payload + sizeof( argHeader ), args[i].mData, args[i].mSize );
+					payload += sizeof( argHeader ) + alignSize( args[i].mSize );
+				}
+			} );
+	}
+
+  private:
+	struct RecordHeader {
+		enum Type : uint32_t { PADDING, TEXT, DEFERRED };
+
+		uint32_t	mSize; // including the header and padding
+		Type		mType;
+		int64_t		mTimestamp; // system_clock ticks
+		uint64_t	mLine;
+		uint32_t	mLevel;
+		uint32_t	mFunctionLength; // TEXT only
+		uint32_t	mFileLength; // number of arguments for DEFERRED
+		uint32_t	mTextLength; // TEXT only
+	};
+
+	struct DeferredArgHeader {
+		void					(*mStream)( std::ostream &os, const void *data );
+		size_t					mSize;
+		detail::DeferredArg::Type	mType;
+	};
+
+	struct Ring {
+		Ring( size_t size )
+			: mData( new uint8_t[size] ), mMask( size - 1 ), mHead( 0 ), mWriting( false ), mGeneration( 0 ), mThreadId( this_thread::get_id() ), mTail( 0 )
+		{}
+
+		size_t	getCapacity() const	{ return mMask + 1; }
+
+		unique_ptr<uint8_t[]>	mData;
+		size_t					mMask;
+		// written by the producer, read by the writer thread
+		alignas( 64 ) atomic<size_t>	mHead;
+		atomic<bool>					mWriting;
+		size_t							mGeneration;
+		thread::id						mThreadId; // the producer
+		// written by the writer thread, read by the producer
+		alignas( 64 ) atomic<size_t>	mTail;
+	};
+
+	static size_t alignSize( size_t size )	{ return ( size + 7 ) & ~size_t( 7 ); }
+
+	// returns the calling thread's ring, creating and registering it if needed
+	Ring* getThreadRing()
+	{
+		static thread_local shared_ptr<Ring> sRing;
+
+		const size_t generation = mGeneration.load( memory_order_acquire );
+		if( ! sRing || sRing->mGeneration != generation ) {
+			sRing = make_shared<Ring>( mRingSize );
+			sRing->mGeneration = generation;
+			lock_guard<mutex> lock( mRingsMutex );
+			mRings.push_back( sRing );
+		}
+
+		return sRing.get();
+	}
+
+	vector<shared_ptr<Ring>> getRings()
+	{
+		lock_guard<mutex> lock( mRingsMutex );
+		return mRings;
+	}
+
+	// Reserves a record of 'payloadSize' bytes in the calling thread's ring and fills it with 'writeFn'. Returns false when
+	// async logging was disabled concurrently, in which case the record should be written synchronously.
+	template<typename WriteFn>
+	bool push( RecordHeader::Type type, Level level, const chrono::system_clock::time_point &timestamp, size_t line, size_t payloadSize, const WriteFn &writeFn )
+	{
+		Ring *ring = getThreadRing();
+
+		// pairs with stop(), which clears mAsync before waiting on mWriting
+		ring->mWriting.store( true, memory_order_seq_cst );
+		if( ! mManager->mAsync.load( memory_order_seq_cst ) ) {
+			ring->mWriting.store( false, memory_order_release );
+			return false;
+		}
+
+		const size_t capacity = ring->getCapacity();
+		const size_t size = alignSize( sizeof( RecordHeader ) + payloadSize );
+		const size_t head = ring->mHead.load( memory_order_relaxed );
+		const size_t tail = ring->mTail.load( memory_order_acquire );
+		const size_t offset = head & ring->mMask;
+		const size_t padding = ( capacity - offset < size ) ? capacity - offset : 0;
+
+		if( size > capacity || head + padding + size - tail > capacity ) {
+			ring->mWriting.store( false, memory_order_release );
+			mManager->mNumDropped.fetch_add( 1, memory_order_relaxed );
+			wake();
+			return true;
+		}
+
+		if( padding ) {
+			RecordHeader *paddingHeader = reinterpret_cast<RecordHeader*>( ring->mData.get() + offset );
+			paddingHeader->mSize = (uint32_t)padding;
+			paddingHeader->mType = RecordHeader::PADDING;
+		}
+
+		RecordHeader *header = reinterpret_cast<RecordHeader*>( ring->mData.get() + ( ( head + padding ) & ring->mMask ) );
+		header->mSize = (uint32_t)size;
+		header->mType = type;
+		header->mTimestamp = timestamp.time_since_epoch().count();
+		header->mLine = line;
+		header->mLevel = level;
+		writeFn( header, reinterpret_cast<uint8_t*>( header + 1 ) );
+
+		ring->mHead.store( head + padding + size, memory_order_release );
+		ring->mWriting.store( false, memory_order_release );
+
+		// wake the writer early rather than letting a busy thread's ring fill up, once per crossing of the halfway mark
+		if( head - tail <= capacity / 2 && head + padding + size - tail > capacity / 2 )
+			wake();
+
+		return true;
+	}
+
+	void wake()
+	{
+		{
+			lock_guard<mutex> lock( mWakeMutex );
+			mWake = true;
+		}
+		mWakeCv.notify_one();
+	}
+
+	void run()
+	{
+		sIsAsyncWriterThread = true;
+		while( true ) {
+			bool stopping;
+			{
+				unique_lock<mutex> lock( mWakeMutex );
+				mWakeCv.wait_for( lock, chrono::milliseconds( 5 ), [this] { return mWake || mStop; } );
+				mWake = false;
+				stopping = mStop;
+			}
+
+			drain();
+
+			if( stopping )
+				break;
+		}
+	}
+
+	// writes every record currently in the rings, and forgets the rings of threads which have exited
+	void drain()
+	{
+		auto rings = getRings();
+		bool removeRings = false;
+		for( auto &ring : rings ) {
+			drain( ring.get() );
+			// the ring is referenced by mRings, by 'rings' and, while its thread is alive, by that thread
+			if( ring.use_count() == 2 && ring->mTail.load( memory_order_relaxed ) == ring->mHead.load( memory_order_acquire ) )
+				removeRings = true;
+		}
+
+		if( removeRings ) {
+			lock_guard<mutex> lock( mRingsMutex );
+			mRings.erase( remove_if( mRings.begin(), mRings.end(), []( const shared_ptr<Ring> &ring ) {
+				return ring.use_count() == 1 && ring->mTail.load( memory_order_relaxed ) == ring->mHead.load( memory_order_acquire );
+			} ), mRings.end() );
+		}
+
+		const uint64_t numDropped = mManager->mNumDropped.load( memory_order_relaxed );
+		if( numDropped != mNumDroppedReported ) {
+			Metadata meta;
+			meta.mLevel = LEVEL_WARNING;
+			meta.mLocation = Location( CINDER_CURRENT_FUNCTION, __FILE__, __LINE__ );
+			mManager->writeToLoggers( meta, "dropped " + to_string( numDropped - mNumDroppedReported ) + " log records because a thread's log buffer was full" );
+			mNumDroppedReported = numDropped;
+		}
+
+		{
+			lock_guard<mutex> lock( mFlushedMutex );
+		}
+		mFlushedCv.notify_all();
+	}
+
+	void drain( Ring *ring )
+	{
+		size_t tail = ring->mTail.load( memory_order_relaxed );
+		const size_t head = ring->mHead.load( memory_order_acquire );
+		if( tail == head )
+			return;
+
+		lock_guard<mutex> lock( mManager->mMutex );
+		while( tail != head ) {
+			const RecordHeader *header = reinterpret_cast<const RecordHeader*>( ring->mData.get() + ( tail & ring->mMask ) );
+			if( header->mType != RecordHeader::PADDING )
+				write( header, ring->mThreadId );
+
+			tail += header->mSize;
+			ring->mTail.store( tail, memory_order_release );
+		}
+	}
+
+	// writes a single record to the loggers; mManager->mMutex must be held
+	void write( const RecordHeader *header, thread::id threadId )
+	{
+		const char *payload = reinterpret_cast<const char*>( header + 1 );
+
+		Metadata meta;
+		meta.mLevel = static_cast<Level>( header->mLevel );
+		meta.mTimestamp = chrono::system_clock::time_point( chrono::system_clock::duration( header->mTimestamp ) );
+		meta.mThreadId = threadId;
+		if( header->mType == RecordHeader::TEXT ) {
+			meta.mLocation = Location( string( payload, header->mFunctionLength ), string( payload + header->mFunctionLength, header->mFileLength ), (size_t)header->mLine );
+			const string text( payload + header->mFunctionLength + header->mFileLength, header->mTextLength );
+			for( auto &logger : mManager->mLoggers )
+				logger->write( meta, text );
+		}
+		else {
+			const char *function, *file;
+			memcpy( &function, payload, sizeof( const char* ) );
+			memcpy( &file, payload + sizeof( const char* ), sizeof( const char* ) );
+			meta.mLocation = Location( function, file, (size_t)header->mLine );
+
+			mArgs.clear();
+			payload += 2 * sizeof( const char* );
+			for( uint32_t i = 0; i < header->mFileLength; ++i ) {
+				DeferredArgHeader argHeader;
+				memcpy( &argHeader, payload, sizeof( argHeader ) );
+				mArgs.push_back( detail::DeferredArg{ argHeader.mStream, payload + sizeof( argHeader ), argHeader.mSize, argHeader.mType } );
+				payload += sizeof( argHeader ) + alignSize( argHeader.mSize );
+			}
+			writeArgsToLoggers( mManager->mLoggers, meta, mArgs.data(), mArgs.size() );
+		}
+	}
+
+	LogManager				*mManager;
+	size_t					mRingSize;
+	atomic<size_t>			mGeneration;
+
+	vector<shared_ptr<Ring>>	mRings;
+	mutex						mRingsMutex;
+
+	thread					mThread;
+	mutex					mWakeMutex;
+	condition_variable		mWakeCv;
+	bool					mStop, mWake;
+
+	mutex					mFlushedMutex;
+	condition_variable		mFlushedCv;
+
+	uint64_t				mNumDroppedReported;
+	vector<detail::DeferredArg>	mArgs; // scratch space for write()
+};
+
 // ----------------------------------------------------------------------------------------------------
 // LogManager
 // ----------------------------------------------------------------------------------------------------
@@ -103,10 +492,18 @@ LogManager* manager()
 }
 
 LogManager::LogManager()
+	: mAsync( false ), mNumDropped( 0 )
 {
 	restoreToDefault();
 }
 
+LogManager::~LogManager()
+{
+	setAsync( false );
+	if( sInstance == this )
+		sInstance = nullptr;
+}
+
 void LogManager::clearLoggers()
 {
 	lock_guard<mutex> lock( mMutex );
@@ -162,6 +559,36 @@ void LogManager::setLevel( Level level )
 }
 
 void LogManager::write( const Metadata &meta, const std::string &text )
+{
+	if( mAsync.load( memory_order_acquire ) ) {
+		// fatal records are written immediately, after everything logged before them
+		if( meta.mLevel == LEVEL_FATAL )
+			flush();
+		else if( mAsyncWriter->push( meta, text ) )
+			return;
+	}
+
+	writeToLoggers( meta, text );
+}
+
+void LogManager::writeDeferred( Level level, const char *function, const char *file, size_t line, const detail::DeferredArg *args, size_t numArgs )
+{
+	if( mAsync.load( memory_order_acquire ) ) {
+		if( level == LEVEL_FATAL )
+			flush();
+		else if( mAsyncWriter->push( level, function, file, line, args, numArgs ) )
+			return;
+	}
+
+	Metadata meta;
+	meta.mLevel = level;
+	meta.mLocation = Location( function, file, line );
+
+	lock_guard<mutex> lock( mMutex );
+	writeArgsToLoggers( mLoggers, meta, args, numArgs );
+}
+
+void LogManager::writeToLoggers( const Metadata &meta, const std::string &text )
 {
 	// TODO move this to a shared_lock_timed with c++14 support
 	lock_guard<mutex> lock( mMutex );
@@ -171,6 +598,41 @@ void LogManager::write( const Metadata &meta, const std::string &text )
 	}
 }
 
+void LogManager::setAsync( bool enable, size_t threadBufferSize )
+{
+	lock_guard<mutex> lock( mAsyncMutex );
+	if( enable == mAsync.load( memory_order_relaxed ) )
+		return;
+
+	if( enable ) {
+		if( ! mAsyncWriter ) {
+			mAsyncWriter.reset( new AsyncWriter( this ) );
+			// the LogManager is normally never destroyed, so write any pending records at exit
+			atexit( [] {
+				if( LogManager::instance() )
+					LogManager::instance()->setAsync( false );
+			} );
+		}
+		mAsyncWriter->start( threadBufferSize );
+		mAsync.store( true, memory_order_seq_cst );
+	}
+	else {
+		mAsync.store( false, memory_order_seq_cst );
+		mAsyncWriter->stop();
+	}
+}
+
+void LogManager::flush()
+{
+	// a Logger flushing from the writer thread would wait on itself
+	if( sIsAsyncWriterThread )
+		return;
+
+	lock_guard<mutex> lock( mAsyncMutex );
+	if( mAsync.load( memory_order_acquire ) )
+		mAsyncWriter->flush();
+}
+
 // ----------------------------------------------------------------------------------------------------
 // Entry
 // ----------------------------------------------------------------------------------------------------
@@ -202,7 +664,7 @@ void Logger::writeDefault( std::ostream &stream, const Metadata &meta, const std
 	stream << meta.mLevel << " ";
 
 	if( isTimestampEnabled() )
-		stream << getCurrentDateTimeString() << " ";
+		stream << getDateTimeString( meta.mTimestamp ) << " ";
 
 	stream << meta.mLocation << " " << text << endl;
 }
@@ -277,7 +739,7 @@ void LoggerFile::ensureDirectoryExists()
 // ----------------------------------------------------------------------------------------------------
 
 LoggerFileRotating::LoggerFileRotating( const fs::path &folder, const std::string &formatStr, bool appendToExisting, std::function<void( const fs::path& )> fileChangeFn )
-: LoggerFile{}, mFolderPath( folder ), mDailyFormatStr( formatStr ), mFileChangeFn( fileChangeFn )
+: LoggerFile{}, mFolderPath( folder ), mDailyFormatStr( formatStr ), mFileChangeFn( fileChangeFn ), mLastRotateTime( 0 )
 {
 	CI_ASSERT_MSG( ! formatStr.empty(), "cannot provide empty formatStr" );
 	if( formatStr.empty() ) {
@@ -300,17 +762,30 @@ void LoggerFileRotating::write( const Metadata &meta, const string &text )
 	if( meta.mLevel < mLevel )
 		return;
 
-	if( mYearDay != getCurrentYearDay() ) {
-		setFilePath( mFolderPath / fs::path( getDailyLogString( mDailyFormatStr ) ) );
-		mYearDay = getCurrentYearDay();
-		
-		if( mStream.is_open() )
-			mStream.close();
-	}
-	
+	rotate();
 	LoggerFile::write( meta, text );
 }
 
+bool LoggerFileRotating::rotate()
+{
+	// localtime() is slow, so check for a new day at most once per second
+	const time_t now = time( NULL );
+	if( now == mLastRotateTime )
+		return false;
+
+	mLastRotateTime = now;
+	if( mYearDay == getCurrentYearDay() )
+		return false;
+
+	setFilePath( mFolderPath / fs::path( getDailyLogString( mDailyFormatStr ) ) );
+	mYearDay = getCurrentYearDay();
+
+	if( mStream.is_open() )
+		mStream.close();
+
+	return true;
+}
+
 void LoggerFileRotating::setFilePath( const fs::path& filepath )
 {
 	if( mFilePath != filepath ) {
@@ -321,6 +796,321 @@ void LoggerFileRotating::setFilePath( const fs::path& filepath )
 	}
 }
 
+// ----------------------------------------------------------------------------------------------------
+// LoggerBinary
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+// A file starts with the magic bytes and the format version. It is followed by records, each starting with a BinaryRecordType:
+// LOCATION: uint32 id, uint32 line, string function, string file; defines the location id used by the records after it
+// TEXT: uint8 level, int64 microseconds since epoch, uint64 thread, uint32 location id, string text
+// ARGS: like TEXT, but with uint32 argument count followed by that many arguments in place of the text; each argument is its
+// uint8 DeferredArg::Type followed by an int64 (SIGNED), uint64 (UNSIGNED), double (FLOAT), uint8 (BOOL, CHAR) or string (STRING)
+// Strings are a uint32 length followed by their bytes. Values are little-endian.
+const char		sBinaryMagic[8] = { 'C', 'I', 'L', 'O', 'G', 'B', 'I', 'N' };
+const uint32_t	sBinaryVersion = 1;
+const uint32_t	sBinaryMaxStringLength = 64 * 1024 * 1024;
+
+enum BinaryRecordType : uint8_t { BINARY_LOCATION = 1, BINARY_TEXT, BINARY_ARGS };
+
+template<typename T>
+void appendBinary( string *buffer, T value )
+{
+	buffer->append( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+void appendBinaryString( string *buffer, const char *str, size_t length )
+{
+	appendBinary( buffer, (uint32_t)length );
+	buffer->append( str, length );
+}
+
+template<typename T>
+T readDeferredValue( const void *data )
+{
+	T result;
+	memcpy( &result, data, sizeof( T ) );
+	return result;
+}
+
+} // anonymous namespace
+
+LoggerBinary::LoggerBinary( const fs::path &folder, const std::string &formatStr, bool appendToExisting, std::function<void( const fs::path& )> fileChangeFn )
+	: LoggerFileRotating( folder, formatStr, appendToExisting, fileChangeFn ), mFlushLevel( LEVEL_ERROR )
+{
+}
+
+void LoggerBinary::write( const Metadata &meta, const string &text )
+{
+	if( meta.mLevel < mLevel )
+		return;
+
+	beginRecord( BINARY_TEXT, meta );
+	appendBinaryString( &mBuffer, text.data(), text.size() );
+	endRecord( meta );
+}
+
+bool LoggerBinary::writeArgs( const Metadata &meta, const detail::DeferredArg *args, size_t numArgs )
+{
+	if( meta.mLevel < mLevel )
+		return true;
+
+	beginRecord( BINARY_ARGS, meta );
+	appendBinary( &mBuffer, (uint32_t)numArgs );
+	for( size_t i = 0; i < numArgs; ++i ) {
+		const detail::DeferredArg &arg = args[i];
+		switch( arg.mType ) {
+			case detail::DeferredArg::SIGNED: {
+				int64_t value;
+				switch( arg.mSize ) {
+					case 1: value = readDeferredValue<int8_t>( arg.mData ); break;
+					case 2: value = readDeferredValue<int16_t>( arg.mData ); break;
+					case 4: value = readDeferredValue<int32_t>( arg.mData ); break;
+					default: value = readDeferredValue<int64_t>( arg.mData ); break;
+				}
+				appendBinary( &mBuffer, arg.mType );
+				appendBinary( &mBuffer, value );
+			}
+			break;
+			case detail::DeferredArg::UNSIGNED: {
+				uint64_t value;
+				switch( arg.mSize ) {
+					case 1: value = readDeferredValue<uint8_t>( arg.mData ); break;
+					case 2: value = readDeferredValue<uint16_t>( arg.mData ); break;
+					case 4: value = readDeferredValue<uint32_t>( arg.mData ); break;
+					default: value = readDeferredValue<uint64_t>( arg.mData ); break;
+				}
+				appendBinary( &mBuffer, arg.mType );
+				appendBinary( &mBuffer, value );
+			}
+			break;
+			case detail::DeferredArg::FLOAT:
+				appendBinary( &mBuffer, arg.mType );
+				appendBinary( &mBuffer, ( arg.mSize == sizeof( float ) ) ? (double)readDeferredValue<float>( arg.mData ) : readDeferredValue<double>( arg.mData ) );
+			break;
+			case detail::DeferredArg::BOOL:
+			case detail::DeferredArg::CHAR:
+				appendBinary( &mBuffer, arg.mType );
+				appendBinary( &mBuffer, readDeferredValue<uint8_t>( arg.mData ) );
+			break;
+			case detail::DeferredArg::STRING:
+				appendBinary( &mBuffer, arg.mType );
+				appendBinaryString( &mBuffer, static_cast<const char*>( arg.mData ), arg.mSize - 1 );
+			break;
+			default: {
+				// types only known to the application are stored formatted
+				ostringstream stream;
+				arg.mStream( stream, arg.mData );
+				const string text = stream.str();
+				appendBinary( &mBuffer, detail::DeferredArg::STRING );
+				appendBinaryString( &mBuffer, text.data(), text.size() );
+			}
+		}
+	}
+	endRecord( meta );
+
+	return true;
+}
+
+void LoggerBinary::beginRecord( uint8_t type, const Metadata &meta )
+{
+	rotate();
+
+	if( ! mStream.is_open() ) {
+		ensureDirectoryExists();
+		const bool empty = ! mAppend || ! fs::exists( mFilePath ) || fs::file_size( mFilePath ) == 0;
+		mStream.open( mFilePath.string(), mAppend ? ( ofstream::binary | ofstream::app ) : ofstream::binary );
+		if( empty ) {
+			mStream.write( sBinaryMagic, sizeof( sBinaryMagic ) );
+			mStream.write( reinterpret_cast<const char*>( &sBinaryVersion ), sizeof( sBinaryVersion ) );
+		}
+
+		// location ids are defined per file
+		mLocations.clear();
+		mLocationIds.clear();
+	}
+
+	mBuffer.clear();
+	const uint32_t locationId = getLocationId( meta.mLocation );
+	appendBinary( &mBuffer, type );
+	appendBinary( &mBuffer, (uint8_t)meta.mLevel );
+	appendBinary( &mBuffer, (int64_t)chrono::duration_cast<chrono::microseconds>( meta.mTimestamp.time_since_epoch() ).count() );
+	appendBinary( &mBuffer, (uint64_t)std::hash<std::thread::id>()( meta.mThreadId ) );
+	appendBinary( &mBuffer, locationId );
+}
+
+void LoggerBinary::endRecord( const Metadata &meta )
+{
+	mStream.write( mBuffer.data(), mBuffer.size() );
+	if( meta.mLevel >= mFlushLevel )
+		mStream.flush();
+}
+
+uint32_t LoggerBinary::getLocationId( const Location &location )
+{
+	const string &function = location.getFunctionName();
+	const string &file = location.getFileName();
+	const size_t hash = std::hash<string>()( function ) ^ ( std::hash<string>()( file ) * 31 ) ^ location.getLineNumber();
+
+	auto range = mLocationIds.equal_range( hash );
+	for( auto it = range.first; it != range.second; ++it ) {
+		const Location &candidate = mLocations[it->second];
+		if( candidate.getLineNumber() == location.getLineNumber() && candidate.getFunctionName() == function && candidate.getFileName() == file )
+			return it->second;
+	}
+
+	const uint32_t id = (uint32_t)mLocations.size();
+	mLocations.push_back( location );
+	mLocationIds.emplace( hash, id );
+
+	appendBinary( &mBuffer, BINARY_LOCATION );
+	appendBinary( &mBuffer, id );
+	appendBinary( &mBuffer, (uint32_t)location.getLineNumber() );
+	appendBinaryString( &mBuffer, function.data(), function.size() );
+	appendBinaryString( &mBuffer, file.data(), file.size() );
+
+	return id;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// LoggerBinary::Reader
+// ----------------------------------------------------------------------------------------------------
+
+LoggerBinary::Reader::Reader( const fs::path &filePath )
+	: mStream( filePath.string(), ifstream::binary ), mFilePath( filePath )
+{
+	if( ! mStream.is_open() )
+		throw LogBinaryExc( "Unable to open \"" + filePath.string() + "\"" );
+
+	char magic[sizeof( sBinaryMagic )];
+	uint32_t version;
+	if( ! read( magic, sizeof( magic ) ) || memcmp( magic, sBinaryMagic, sizeof( magic ) ) != 0 || ! read( &version ) )
+		throw LogBinaryExc( "\"" + filePath.string() + "\" is not a LoggerBinary file" );
+	if( version != sBinaryVersion )
+		throw LogBinaryExc( "\"" + filePath.string() + "\" has unsupported version " + to_string( version ) );
+}
+
+bool LoggerBinary::Reader::read( void *data, size_t size )
+{
+	mStream.read( static_cast<char*>( data ), size );
+	return mStream.gcount() == (streamsize)size;
+}
+
+bool LoggerBinary::Reader::readString( std::string *result )
+{
+	uint32_t length;
+	if( ! read( &length ) )
+		return false;
+	if( length > sBinaryMaxStringLength )
+		throw LogBinaryExc( "Malformed record in \"" + mFilePath.string() + "\"" );
+
+	result->resize( length );
+	return read( &(*result)[0], length );
+}
+
+// A record cut short by the end of the file, as happens when the application exits without flushing, ends the file.
+bool LoggerBinary::Reader::readNext( Record *record )
+{
+	while( true ) {
+		uint8_t type;
+		if( ! read( &type ) )
+			return false;
+
+		if( type == BINARY_LOCATION ) {
+			uint32_t id, line;
+			string function, file;
+			if( ! read( &id ) || ! read( &line ) || ! readString( &function ) || ! readString( &file ) )
+				return false;
+			if( id > mLocations.size() )
+				throw LogBinaryExc( "Malformed location in \"" + mFilePath.string() + "\"" );
+
+			if( id == mLocations.size() )
+				mLocations.emplace_back();
+			mLocations[id] = Location( function, file, line );
+			continue;
+		}
+		else if( type != BINARY_TEXT && type != BINARY_ARGS )
+			throw LogBinaryExc( "Malformed record in \"" + mFilePath.string() + "\"" );
+
+		uint8_t level;
+		int64_t timestamp;
+		uint32_t locationId;
+		if( ! read( &level ) || ! read( &timestamp ) || ! read( &record->mThreadId ) || ! read( &locationId ) )
+			return false;
+		if( level > LEVEL_FATAL || locationId >= mLocations.size() )
+			throw LogBinaryExc( "Malformed record in \"" + mFilePath.string() + "\"" );
+
+		record->mLevel = static_cast<Level>( level );
+		record->mTimestamp = chrono::system_clock::time_point( chrono::duration_cast<chrono::system_clock::duration>( chrono::microseconds( timestamp ) ) );
+		record->mLocation = mLocations[locationId];
+
+		if( type == BINARY_TEXT )
+			return readString( &record->mText );
+
+		uint32_t numArgs;
+		if( ! read( &numArgs ) )
+			return false;
+
+		ostringstream stream;
+		for( uint32_t i = 0; i < numArgs; ++i ) {
+			detail::DeferredArg::Type argType;
+			if( ! read( &argType ) )
+				return false;
+
+			switch( argType ) {
+				case detail::DeferredArg::SIGNED: {
+					int64_t value;
+					if( ! read( &value ) )
+						return false;
+					stream << value;
+				}
+				break;
+				case detail::DeferredArg::UNSIGNED: {
+					uint64_t value;
+					if( ! read( &value ) )
+						return false;
+					stream << value;
+				}
+				break;
+				case detail::DeferredArg::FLOAT: {
+					double value;
+					if( ! read( &value ) )
+						return false;
+					stream << value;
+				}
+				break;
+				case detail::DeferredArg::BOOL: {
+					uint8_t value;
+					if( ! read( &value ) )
+						return false;
+					stream << ( value != 0 );
+				}
+				break;
+				case detail::DeferredArg::CHAR: {
+					char value;
+					if( ! read( &value ) )
+						return false;
+					stream << value;
+				}
+				break;
+				case detail::DeferredArg::STRING: {
+					string value;
+					if( ! readString( &value ) )
+						return false;
+					stream << value;
+				}
+				break;
+				default:
+					throw LogBinaryExc( "Malformed argument in \"" + mFilePath.string() + "\"" );
+			}
+		}
+		record->mText = stream.str();
+
+		return true;
+	}
+}
+
 // ----------------------------------------------------------------------------------------------------
 // LoggerBreakpoint
 // ----------------------------------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 
 #include "cinder/CinderMath.h"
 #include "cinder/Path2d.h"
+#include "cinder/Thread.h"
 
 #include <algorithm>
 #include <iterator>
@@ -2179,11 +2180,152 @@ float Path2d::segmentSolveTimeForDistance( size_t segment, float segmentLength,
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Path2dCalcCache
-Path2dCalcCache::Path2dCalcCache( const Path2d &path )
-	: mPath( path ), mLength( path.calcLength() )
+namespace {
+// 5-point Gauss-Legendre integration of the speed of a curve segment over [a,b]. Exact enough for the short intervals of the arc-length table.
+float integrateSegmentSpeed( Path2d::SegmentType type, const vec2 *points, float a, float b )
+{
+	static const float sNodes[5] = { 0.0f, -0.5384693101056831f, 0.5384693101056831f, -0.9061798459386640f, 0.9061798459386640f };
+	static const float sWeights[5] = { 0.5688888888888889f, 0.4786286704993665f, 0.4786286704993665f, 0.2369268850561891f, 0.2369268850561891f };
+
+	const float halfWidth = ( b - a ) * 0.5f, center = ( a + b ) * 0.5f;
+	float result = 0;
+	for( int i = 0; i < 5; ++i ) {
+		float t = center + halfWidth * sNodes[i];
+		result += sWeights[i] * ( type == Path2d::CUBICTO ? calcCubicBezierSpeed( points, t ) : calcQuadraticBezierSpeed( points, t ) );
+	}
+
+	return result * halfWidth;
+}
+} // anonymous namespace
+
+Path2dCalcCache::Path2dCalcCache( const Path2d &path, int samplesPerCurve )
+	: mPath( path ), mLength( 0 ), mSamplesPerCurve( std::max( 1, samplesPerCurve ) )
+{
+	const size_t numSegments = mPath.mSegments.size();
+	mSegmentLengths.reserve( numSegments );
+	mSegmentDistances.reserve( numSegments + 1 );
+	mSegmentFirstPoints.reserve( numSegments );
+	mTableOffsets.reserve( numSegments );
+
+	size_t firstPoint = 0;
+	for( size_t s = 0; s < numSegments; ++s ) {
+		const Path2d::SegmentType type = mPath.mSegments[s];
+		mSegmentFirstPoints.push_back( firstPoint );
+		mTableOffsets.push_back( mArcLengthTable.size() );
+		mSegmentDistances.push_back( mLength );
+
+		float segmentLength = 0;
+		if( type == Path2d::CUBICTO || type == Path2d::QUADTO ) {
+			const vec2 *points = &mPath.mPoints[firstPoint];
+			mArcLengthTable.push_back( 0 );
+			for( int i = 0; i < mSamplesPerCurve; ++i ) {
+				segmentLength += integrateSegmentSpeed( type, points, i / (float)mSamplesPerCurve, ( i + 1 ) / (float)mSamplesPerCurve );
+				mArcLengthTable.push_back( segmentLength );
+			}
+		}
+		else if( type == Path2d::LINETO )
+			segmentLength = distance( mPath.mPoints[firstPoint], mPath.mPoints[firstPoint + 1] );
+		else if( type == Path2d::CLOSE )
+			segmentLength = distance( mPath.mPoints[firstPoint], mPath.mPoints[0] );
+
+		mSegmentLengths.push_back( segmentLength );
+		mLength += segmentLength;
+		firstPoint += Path2d::sSegmentTypePointCounts[type];
+	}
+
+	mSegmentDistances.push_back( mLength );
+}
+
+vec2 Path2dCalcCache::calcSegmentPosition( size_t segment, float t ) const
 {
-	for( size_t i = 0; i < mPath.getNumSegments(); ++i )
-		mSegmentLengths.push_back( mPath.calcSegmentLength( i ) );
+	const vec2 *p = &mPath.mPoints[mSegmentFirstPoints[segment]];
+	switch( mPath.mSegments[segment] ) {
+		case Path2d::CUBICTO:
+			return Path2d::calcCubicBezierPos( p, t );
+		case Path2d::QUADTO:
+			return Path2d::calcQuadraticBezierPos( p, t );
+		case Path2d::LINETO:
+			return p[0] * ( 1 - t ) + p[1] * t;
+		case Path2d::CLOSE:
+			return p[0] * ( 1 - t ) + mPath.mPoints[0] * t;
+		default:
+			throw Path2dExc();
+	}
+}
+
+vec2 Path2dCalcCache::calcSegmentTangent( size_t segment, float t ) const
+{
+	const vec2 *p = &mPath.mPoints[mSegmentFirstPoints[segment]];
+	switch( mPath.mSegments[segment] ) {
+		case Path2d::CUBICTO:
+			return Path2d::calcCubicBezierDerivative( p, t );
+		case Path2d::QUADTO:
+			return Path2d::calcQuadraticBezierDerivative( p, t );
+		case Path2d::LINETO:
+			return p[1] - p[0];
+		case Path2d::CLOSE:
+			return mPath.mPoints[0] - p[0];
+		default:
+			throw Path2dExc();
+	}
+}
+
+float Path2dCalcCache::wrapDistance( float distance, bool wrap ) const
+{
+	if( wrap && mLength > 0 ) {
+		distance = math<float>::fmod( distance, mLength );
+		if( distance < 0 )
+			distance += mLength;
+	}
+
+	return math<float>::clamp( distance, 0, mLength );
+}
+
+void Path2dCalcCache::solveDistance( float distance, float tolerance, int maxIterations, size_t *segment, float *segmentT ) const
+{
+	// find the first segment ending beyond distance; this skips zero-length segments
+	const size_t numSegments = mSegmentLengths.size();
+	size_t seg = std::upper_bound( mSegmentDistances.begin() + 1, mSegmentDistances.end(), distance ) - ( mSegmentDistances.begin() + 1 );
+	seg = std::min( seg, numSegments - 1 );
+	*segment = seg;
+
+	const float segmentLength = mSegmentLengths[seg];
+	const float segmentDistance = distance - mSegmentDistances[seg];
+	if( segmentLength <= 0 ) {
+		*segmentT = 0;
+		return;
+	}
+
+	const Path2d::SegmentType type = mPath.mSegments[seg];
+	if( type != Path2d::CUBICTO && type != Path2d::QUADTO ) {
+		*segmentT = math<float>::clamp( segmentDistance / segmentLength, 0, 1 );
+		return;
+	}
+
+	// locate the table interval containing segmentDistance and interpolate linearly within it
+	const float *table = &mArcLengthTable[mTableOffsets[seg]];
+	size_t interval = std::upper_bound( table, table + mSamplesPerCurve + 1, segmentDistance ) - table;
+	interval = std::min<size_t>( std::max<size_t>( interval, 1 ), mSamplesPerCurve ) - 1;
+	const float intervalWidth = 1.0f / mSamplesPerCurve;
+	const float minT = interval * intervalWidth, maxT = minT + intervalWidth;
+	const float intervalLength = table[interval + 1] - table[interval];
+	float t = minT;
+	if( intervalLength > 0 )
+		t += ( segmentDistance - table[interval] ) / intervalLength * intervalWidth;
+
+	// refine with Newton-Raphson, measuring arc length from the start of the interval
+	const vec2 *points = &mPath.mPoints[mSegmentFirstPoints[seg]];
+	for( int i = 0; i < maxIterations; ++i ) {
+		float delta = table[interval] + integrateSegmentSpeed( type, points, minT, t ) - segmentDistance;
+		if( math<float>::abs( delta ) < tolerance )
+			break;
+		float speed = length( calcSegmentTangent( seg, t ) );
+		if( speed <= 0 )
+			break;
+		t = math<float>::clamp( t - delta / speed, minT, maxT );
+	}
+
+	*segmentT = t;
 }
 
 float Path2dCalcCache::calcNormalizedTime( float relativeTime, bool wrap, float tolerance, int maxIterations ) const
@@ -2205,18 +2347,10 @@ float Path2dCalcCache::calcNormalizedTime( float relativeTime, bool wrap, float
 			return 0.0f;
 	}
 
-	// We're looking for a length that is relativeTime * totalPathLength
-	float targetLength = mLength * math<float>::clamp( relativeTime, 0.0f, 1.0f );
-
-	// Iterate the segments to find the segment defining the range containing our targetLength
-	int currentSegment = 0;
-	float currentSegmentLength = mSegmentLengths[0];
-	while( targetLength > currentSegmentLength ) {
-		targetLength -= currentSegmentLength;
-		currentSegmentLength = mSegmentLengths[++currentSegment];
-	}
-
-	return mPath.segmentSolveTimeForDistance( currentSegment, currentSegmentLength, targetLength, tolerance, maxIterations );
+	size_t segment;
+	float segmentT;
+	solveDistance( mLength * math<float>::clamp( relativeTime, 0.0f, 1.0f ), tolerance, maxIterations, &segment, &segmentT );
+	return ( segment + segmentT ) / (float)mPath.mSegments.size();
 }
 
 float Path2dCalcCache::calcTimeForDistance( float distance, bool wrap, float tolerance, int maxIterations ) const
@@ -2224,23 +2358,78 @@ float Path2dCalcCache::calcTimeForDistance( float distance, bool wrap, float tol
 	if( mPath.mSegments.empty() || mLength == 0 )
 		return 0;
 
-	if( distance > mLength ) {
-		if( wrap )
-			distance = fmodf( distance, mLength );
-		else
-			return 1.0f;
-	}
+	if( distance > mLength && ! wrap )
+		return 1.0f;
 
-	// Iterate the segments to find the segment defining the range containing our targetLength
-	int currentSegment = 0;
-	float currentSegmentLength = mSegmentLengths[0];
-	while( distance > currentSegmentLength ) {
-		distance -= currentSegmentLength;
-		currentSegmentLength = mSegmentLengths[++currentSegment];
-	}
+	size_t segment;
+	float segmentT;
+	solveDistance( wrapDistance( distance, wrap ), tolerance, maxIterations, &segment, &segmentT );
+	return ( segment + segmentT ) / (float)mPath.mSegments.size();
+}
 
-	return mPath.segmentSolveTimeForDistance( currentSegment, currentSegmentLength, distance, tolerance, maxIterations );
+vec2 Path2dCalcCache::getPosition( float t ) const
+{
+	if( mPath.mSegments.empty() )
+		return vec2();
+
+	size_t segment;
+	float segmentT;
+	mPath.getSegmentRelativeT( t, &segment, &segmentT );
+	return calcSegmentPosition( segment, segmentT );
+}
+
+vec2 Path2dCalcCache::getTangent( float t ) const
+{
+	if( mPath.mSegments.empty() )
+		return vec2();
+
+	size_t segment;
+	float segmentT;
+	mPath.getSegmentRelativeT( t, &segment, &segmentT );
+	return calcSegmentTangent( segment, segmentT );
 }
 
+vec2 Path2dCalcCache::getPositionAtDistance( float distance, bool wrap ) const
+{
+	if( mPath.mSegments.empty() )
+		return mPath.mPoints.empty() ? vec2() : mPath.mPoints[0];
+
+	size_t segment;
+	float segmentT;
+	solveDistance( wrapDistance( distance, wrap ), 1.0e-03f, 4, &segment, &segmentT );
+	return calcSegmentPosition( segment, segmentT );
+}
+
+vec2 Path2dCalcCache::getTangentAtDistance( float distance, bool wrap ) const
+{
+	if( mPath.mSegments.empty() )
+		return vec2();
+
+	size_t segment;
+	float segmentT;
+	solveDistance( wrapDistance( distance, wrap ), 1.0e-03f, 4, &segment, &segmentT );
+	return calcSegmentTangent( segment, segmentT );
+}
+
+void Path2dCalcCache::calcPositionsAtDistances( const float *distances, size_t count, vec2 *resultPositions, vec2 *resultTangents, bool wrap ) const
+{
+	if( mPath.mSegments.empty() ) {
+		std::fill( resultPositions, resultPositions + count, mPath.mPoints.empty() ? vec2() : mPath.mPoints[0] );
+		if( resultTangents )
+			std::fill( resultTangents, resultTangents + count, vec2() );
+		return;
+	}
+
+	parallelFor( 0, count, 4096, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			size_t segment;
+			float segmentT;
+			solveDistance( wrapDistance( distances[i], wrap ), 1.0e-03f, 4, &segment, &segmentT );
+			resultPositions[i] = calcSegmentPosition( segment, segmentT );
+			if( resultTangents )
+				resultTangents[i] = calcSegmentTangent( segment, segmentT );
+		}
+	} );
+}
 
 } // namespace cinder
@@ -0,0 +1,185 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/PathFlattener.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+const size_t MAX_SEGMENT_DIVISIONS = 4096;
+
+// Returns the number of uniform pieces needed to keep a curve with second derivative bounded by \a maxSecondDerivative within \a tolerance
+// of its chords. The deviation of a chord spanning h in t is at most maxSecondDerivative * h^2 / 8.
+size_t calcNumDivisions( float maxSecondDerivative, float tolerance )
+{
+	float n = math<float>::ceil( math<float>::sqrt( maxSecondDerivative / ( 8 * tolerance ) ) );
+	if( ! ( n > 1 ) ) // also catches NaN
+		return 1;
+	return std::min( (size_t)n, MAX_SEGMENT_DIVISIONS );
+}
+
+// Flattens path into result, or just counts the points when result is null, so both passes always agree
+size_t flattenImpl( const Path2d &path, float tolerance, vec2 *result )
+{
+	const auto &segments = path.getSegments();
+	const auto &points = path.getPoints();
+	if( segments.empty() )
+		return 0;
+
+	tolerance = std::max( tolerance, 1.0e-6f );
+	size_t numResult = 0;
+	auto emit = [&]( const vec2 &p ) {
+		if( result )
+			result[numResult] = p;
+		++numResult;
+	};
+
+	// a closed contour whose last segment returns to the start doesn't repeat it
+	const bool skipLastPoint = path.isClosed() && points.back() == points.front();
+	size_t lastSegment = segments.size() - 1;
+	while( lastSegment > 0 && segments[lastSegment] == Path2d::CLOSE )
+		--lastSegment;
+
+	emit( points[0] );
+	size_t firstPoint = 0;
+	for( size_t s = 0; s < segments.size(); ++s ) {
+		const auto type = segments[s];
+		const vec2 *p = &points[firstPoint];
+		const bool emitEnd = ! ( skipLastPoint && s == lastSegment );
+		switch( type ) {
+			case Path2d::LINETO:
+				if( emitEnd )
+					emit( p[1] );
+			break;
+			case Path2d::QUADTO: {
+				const vec2 dd = p[0] - 2.0f * p[1] + p[2];
+				const size_t n = calcNumDivisions( 2 * length( dd ), tolerance );
+				if( result ) {
+					// B(t) = dd t^2 + 2 (p1 - p0) t + p0
+					const vec2 b = 2.0f * ( p[1] - p[0] );
+					for( size_t i = 1; i < n; ++i ) {
+						float t = i / (float)n;
+						emit( ( dd * t + b ) * t + p[0] );
+					}
+				}
+				else
+					numResult += n - 1;
+				if( emitEnd )
+					emit( p[2] );
+			}
+			break;
+			case Path2d::CUBICTO: {
+				const vec2 dd0 = p[0] - 2.0f * p[1] + p[2], dd1 = p[1] - 2.0f * p[2] + p[3];
+				const size_t n = calcNumDivisions( 6 * std::max( length( dd0 ), length( dd1 ) ), tolerance );
+				if( result ) {
+					// B(t) = a t^3 + b t^2 + c t + p0
+					const vec2 a = p[3] - p[0] + 3.0f * ( p[1] - p[2] );
+					const vec2 b = 3.0f * dd0;
+					const vec2 c = 3.0f * ( p[1] - p[0] );
+					for( size_t i = 1; i < n; ++i ) {
+						float t = i / (float)n;
+						emit( ( ( a * t + b ) * t + c ) * t + p[0] );
+					}
+				}
+				else
+					numResult += n - 1;
+				if( emitEnd )
+					emit( p[3] );
+			}
+			break;
+			default:
+			break;
+		}
+
+		firstPoint += Path2d::sSegmentTypePointCounts[type];
+	}
+
+	return numResult;
+}
+
+} // anonymous namespace
+
+PathFlattener::PathFlattener( float tolerance )
+	: mTolerance( tolerance )
+{
+}
+
+void PathFlattener::clear()
+{
+	mPoints.clear();
+	mContourEnds.clear();
+	mContourClosed.clear();
+}
+
+size_t PathFlattener::calcNumPoints( const Path2d &path, float tolerance )
+{
+	return flattenImpl( path, tolerance, nullptr );
+}
+
+size_t PathFlattener::flatten( const Path2d &path, float tolerance, vec2 *result )
+{
+	return flattenImpl( path, tolerance, result );
+}
+
+void PathFlattener::flatten( const Path2d &path )
+{
+	flatten( &path, 1 );
+}
+
+void PathFlattener::flatten( const Shape2d &shape )
+{
+	flatten( shape.getContours().data(), shape.getContours().size() );
+}
+
+void PathFlattener::flatten( const Path2d *paths, size_t numPaths )
+{
+	// count every contour, then flatten each directly into its slice of mPoints
+	mScratchOffsets.resize( numPaths + 1 );
+	parallelFor( 0, numPaths, 64, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			mScratchOffsets[i + 1] = flattenImpl( paths[i], mTolerance, nullptr );
+	} );
+
+	mScratchOffsets[0] = mPoints.size();
+	for( size_t i = 0; i < numPaths; ++i ) {
+		mScratchOffsets[i + 1] += mScratchOffsets[i];
+		mContourEnds.push_back( (uint32_t)mScratchOffsets[i + 1] );
+		mContourClosed.push_back( paths[i].isClosed() ? 1 : 0 );
+	}
+	mPoints.resize( mScratchOffsets[numPaths] );
+
+	parallelFor( 0, numPaths, 64, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			flattenImpl( paths[i], mTolerance, mPoints.data() + mScratchOffsets[i] );
+	} );
+}
+
+} // namespace cinder
@@ -0,0 +1,670 @@
+/*
+ Copyright (c) 2010, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/PolyLine.h"
+#include "cinder/CinderMath.h"
+#include "cinder/PathFlattener.h"
+#include "cinder/Shape2d.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// Computes polygon booleans by building the planar arrangement of all input edges. Edge intersections are found with a sweep over x,
+// rejecting pairs whose bounding boxes don't overlap. Splitting every edge at its intersections yields a planar graph, whose faces
+// get their winding numbers by walking across edges from the unbounded face. The result boundary is then traced along the edges that
+// separate faces inside the result from faces outside it.
+class BooleanEngine {
+  public:
+	enum FillRule { FILL_EVEN_ODD, FILL_NONZERO, FILL_POSITIVE, FILL_NEGATIVE };
+	enum BooleanOp { BOOLEAN_UNION, BOOLEAN_INTERSECTION, BOOLEAN_DIFFERENCE, BOOLEAN_XOR };
+
+	//! Adds \a numPoints as a closed contour to polygon set \a set, which is 0 or 1
+	template<typename T>
+	void addContour( const T *points, size_t numPoints, int set );
+	//! Computes the result, with outer contours counterclockwise and holes clockwise
+	vector<vector<dvec2>> calculate( BooleanOp op, FillRule fillRule );
+
+  private:
+	struct Segment {
+		dvec2	mP0, mP1;
+		int		mSet;
+	};
+	struct Split {
+		uint32_t	mSegment;
+		double		mParam;
+		uint32_t	mPoint;
+	};
+	struct HalfEdge {
+		uint32_t	mOrigin;
+		double		mAngle;
+		int			mDelta[2];
+	};
+
+	void		findIntersections();
+	void		intersect( uint32_t i, uint32_t j );
+	void		addSplit( uint32_t segment, const dvec2 &p );
+	void		buildGraph();
+	void		calcWindings();
+
+	uint32_t	dest( uint32_t h ) const	{ return mHalfEdges[h ^ 1].mOrigin; }
+	// Returns the half-edge following h around the face to its left
+	uint32_t	nextAroundFace( uint32_t h ) const;
+
+	vector<Segment>		mSegments;
+	vector<dvec2>		mPoints;	// intersection points, indexed by Split::mPoint
+	vector<Split>		mSplits;
+	double				mEpsilon = 0;
+
+	vector<dvec2>		mVertices;
+	vector<HalfEdge>	mHalfEdges;		// half-edges 2i and 2i+1 are twins
+	vector<uint32_t>	mVertexOffsets;	// CSR of outgoing half-edges per vertex, sorted by angle
+	vector<uint32_t>	mOutgoing;
+	vector<uint32_t>	mOutgoingIndex;	// position of each half-edge within its origin's outgoing list
+	vector<ivec2>		mWindings;		// winding numbers of set 0 and 1 of the face left of each half-edge
+};
+
+template<typename T>
+void BooleanEngine::addContour( const T *points, size_t numPoints, int set )
+{
+	for( size_t i = 0; i < numPoints; ++i ) {
+		dvec2 p0( points[i] ), p1( points[( i + 1 ) % numPoints] );
+		if( p0 != p1 )
+			mSegments.push_back( { p0, p1, set } );
+	}
+}
+
+void BooleanEngine::findIntersections()
+{
+	// sweep over segments sorted by their minimum x, keeping those whose x range still overlaps the sweep position
+	vector<uint32_t> order( mSegments.size() );
+	iota( order.begin(), order.end(), 0 );
+	vector<dvec4> bounds( mSegments.size() ); // minX, maxX, minY, maxY
+	for( size_t i = 0; i < mSegments.size(); ++i ) {
+		const auto &s = mSegments[i];
+		bounds[i] = dvec4( std::min( s.mP0.x, s.mP1.x ), std::max( s.mP0.x, s.mP1.x ), std::min( s.mP0.y, s.mP1.y ), std::max( s.mP0.y, s.mP1.y ) );
+	}
+	sort( order.begin(), order.end(), [&]( uint32_t a, uint32_t b ) { return bounds[a].x < bounds[b].x; } );
+
+	vector<uint32_t> active;
+	for( uint32_t i : order ) {
+		const dvec4 &bi = bounds[i];
+		size_t numActive = 0;
+		for( uint32_t j : active ) {
+			const dvec4 &bj = bounds[j];
+			if( bj.y < bi.x - mEpsilon )
+				continue; // ended before the sweep position; drop it
+			active[numActive++] = j;
+			if( bj.z <= bi.w + mEpsilon && bi.z <= bj.w + mEpsilon )
+				intersect( j, i );
+		}
+		active.resize( numActive );
+		active.push_back( i );
+	}
+}
+
+void BooleanEngine::addSplit( uint32_t segment, const dvec2 &p )
+{
+	const Segment &s = mSegments[segment];
+	const dvec2 d = s.mP1 - s.mP0;
+	mSplits.push_back( { segment, dot( p - s.mP0, d ) / dot( d, d ), (uint32_t)mPoints.size() } );
+	mPoints.push_back( p );
+}
+
+void BooleanEngine::intersect( uint32_t i, uint32_t j )
+{
+	const Segment &a = mSegments[i], &b = mSegments[j];
+	const dvec2 d1 = a.mP1 - a.mP0, d2 = b.mP1 - b.mP0;
+	const double len1 = length( d1 ), len2 = length( d2 );
+	const double denom = d1.x * d2.y - d1.y * d2.x;
+	const dvec2 r = b.mP0 - a.mP0;
+
+	// returns the parameter of p along the segment, snapped to the endpoints within epsilon
+	auto isInterior = []( double t, double eps ) { return t > eps && t < 1 - eps; };
+	const double eps1 = mEpsilon / len1, eps2 = mEpsilon / len2;
+
+	if( math<double>::abs( denom ) <= 1e-12 * len1 * len2 ) {
+		// parallel; only collinear overlaps matter
+		if( math<double>::abs( d1.x * r.y - d1.y * r.x ) > mEpsilon * len1 )
+			return;
+		const double tb0 = dot( b.mP0 - a.mP0, d1 ) / ( len1 * len1 ), tb1 = dot( b.mP1 - a.mP0, d1 ) / ( len1 * len1 );
+		const double ta0 = dot( a.mP0 - b.mP0, d2 ) / ( len2 * len2 ), ta1 = dot( a.mP1 - b.mP0, d2 ) / ( len2 * len2 );
+		if( isInterior( tb0, eps1 ) )
+			addSplit( i, b.mP0 );
+		if( isInterior( tb1, eps1 ) )
+			addSplit( i, b.mP1 );
+		if( isInterior( ta0, eps2 ) )
+			addSplit( j, a.mP0 );
+		if( isInterior( ta1, eps2 ) )
+			addSplit( j, a.mP1 );
+		return;
+	}
+
+	const double t = ( r.x * d2.y - r.y * d2.x ) / denom;
+	const double u = ( r.x * d1.y - r.y * d1.x ) / denom;
+	if( t < -eps1 || t > 1 + eps1 || u < -eps2 || u > 1 + eps2 )
+		return;
+
+	// an intersection at an endpoint reuses the endpoint exactly, so the vertex is shared
+	const bool interior1 = isInterior( t, eps1 ), interior2 = isInterior( u, eps2 );
+	dvec2 p;
+	if( ! interior1 )
+		p = ( t < 0.5 ) ? a.mP0 : a.mP1;
+	else if( ! interior2 )
+		p = ( u < 0.5 ) ? b.mP0 : b.mP1;
+	else
+		p = a.mP0 + d1 * t;
+
+	if( interior1 )
+		addSplit( i, p );
+	if( interior2 )
+		addSplit( j, p );
+}
+
+void BooleanEngine::buildGraph()
+{
+	// gather every endpoint and split point, and merge those within epsilon of each other into vertices
+	const size_t numEndpoints = mSegments.size() * 2;
+	vector<dvec2> points( numEndpoints + mPoints.size() );
+	for( size_t i = 0; i < mSegments.size(); ++i ) {
+		points[i * 2] = mSegments[i].mP0;
+		points[i * 2 + 1] = mSegments[i].mP1;
+	}
+	copy( mPoints.begin(), mPoints.end(), points.begin() + numEndpoints );
+
+	vector<uint32_t> order( points.size() );
+	iota( order.begin(), order.end(), 0 );
+	sort( order.begin(), order.end(), [&]( uint32_t a, uint32_t b ) { return points[a].x < points[b].x || ( points[a].x == points[b].x && points[a].y < points[b].y ); } );
+
+	const uint32_t unassigned = numeric_limits<uint32_t>::max();
+	vector<uint32_t> vertexOfPoint( points.size(), unassigned );
+	mVertices.clear();
+	for( size_t o = 0; o < order.size(); ++o ) {
+		const uint32_t i = order[o];
+		if( vertexOfPoint[i] != unassigned )
+			continue;
+		vertexOfPoint[i] = (uint32_t)mVertices.size();
+		for( size_t n = o + 1; n < order.size() && points[order[n]].x - points[i].x <= mEpsilon; ++n ) {
+			const uint32_t j = order[n];
+			if( vertexOfPoint[j] == unassigned && math<double>::abs( points[j].y - points[i].y ) <= mEpsilon )
+				vertexOfPoint[j] = vertexOfPoint[i];
+		}
+		mVertices.push_back( points[i] );
+	}
+
+	// split each segment into sub-edges, ordered along it
+	sort( mSplits.begin(), mSplits.end(), []( const Split &a, const Split &b ) { return a.mSegment < b.mSegment || ( a.mSegment == b.mSegment && a.mParam < b.mParam ); } );
+	struct SubEdge { uint32_t mV0, mV1; int mDelta[2]; };
+	vector<SubEdge> subEdges;
+	subEdges.reserve( mSegments.size() + mSplits.size() );
+	auto addSubEdge = [&]( uint32_t v0, uint32_t v1, int set ) {
+		if( v0 == v1 )
+			return;
+		// store undirected, lowest vertex first, with the winding change in that direction
+		SubEdge e = { std::min( v0, v1 ), std::max( v0, v1 ), { 0, 0 } };
+		e.mDelta[set] = ( v0 < v1 ) ? 1 : -1;
+		subEdges.push_back( e );
+	};
+	size_t split = 0;
+	for( uint32_t s = 0; s < mSegments.size(); ++s ) {
+		uint32_t prev = vertexOfPoint[s * 2];
+		for( ; split < mSplits.size() && mSplits[split].mSegment == s; ++split ) {
+			uint32_t v = vertexOfPoint[numEndpoints + mSplits[split].mPoint];
+			addSubEdge( prev, v, mSegments[s].mSet );
+			prev = v;
+		}
+		addSubEdge( prev, vertexOfPoint[s * 2 + 1], mSegments[s].mSet );
+	}
+
+	// merge coincident sub-edges, dropping those that don't change either winding number
+	sort( subEdges.begin(), subEdges.end(), []( const SubEdge &a, const SubEdge &b ) { return a.mV0 < b.mV0 || ( a.mV0 == b.mV0 && a.mV1 < b.mV1 ); } );
+	mHalfEdges.clear();
+	for( size_t i = 0; i < subEdges.size(); ) {
+		SubEdge merged = subEdges[i];
+		for( ++i; i < subEdges.size() && subEdges[i].mV0 == merged.mV0 && subEdges[i].mV1 == merged.mV1; ++i ) {
+			merged.mDelta[0] += subEdges[i].mDelta[0];
+			merged.mDelta[1] += subEdges[i].mDelta[1];
+		}
+		if( merged.mDelta[0] == 0 && merged.mDelta[1] == 0 )
+			continue;
+
+		const dvec2 d = mVertices[merged.mV1] - mVertices[merged.mV0];
+		mHalfEdges.push_back( { merged.mV0, math<double>::atan2( d.y, d.x ), { merged.mDelta[0], merged.mDelta[1] } } );
+		mHalfEdges.push_back( { merged.mV1, math<double>::atan2( -d.y, -d.x ), { -merged.mDelta[0], -merged.mDelta[1] } } );
+	}
+
+	// outgoing half-edges of each vertex, sorted counterclockwise
+	mVertexOffsets.assign( mVertices.size() + 1, 0 );
+	for( const auto &h : mHalfEdges )
+		++mVertexOffsets[h.mOrigin + 1];
+	for( size_t v = 0; v < mVertices.size(); ++v )
+		mVertexOffsets[v + 1] += mVertexOffsets[v];
+	mOutgoing.resize( mHalfEdges.size() );
+	vector<uint32_t> cursor( mVertexOffsets.begin(), mVertexOffsets.end() - 1 );
+	for( uint32_t h = 0; h < mHalfEdges.size(); ++h )
+		mOutgoing[cursor[mHalfEdges[h].mOrigin]++] = h;
+	mOutgoingIndex.resize( mHalfEdges.size() );
+	for( size_t v = 0; v < mVertices.size(); ++v ) {
+		auto begin = mOutgoing.begin() + mVertexOffsets[v], end = mOutgoing.begin() + mVertexOffsets[v + 1];
+		sort( begin, end, [&]( uint32_t a, uint32_t b ) { return mHalfEdges[a].mAngle < mHalfEdges[b].mAngle; } );
+		for( auto it = begin; it != end; ++it )
+			mOutgoingIndex[*it] = (uint32_t)( it - mOutgoing.begin() );
+	}
+}
+
+uint32_t BooleanEngine::nextAroundFace( uint32_t h ) const
+{
+	// the next edge around the left face leaves dest(h) immediately clockwise of the twin
+	const uint32_t twin = h ^ 1;
+	const uint32_t v = mHalfEdges[twin].mOrigin;
+	const uint32_t begin = mVertexOffsets[v], count = mVertexOffsets[v + 1] - begin;
+	const uint32_t index = mOutgoingIndex[twin] - begin;
+	return mOutgoing[begin + ( index + count - 1 ) % count];
+}
+
+void BooleanEngine::calcWindings()
+{
+	// find the connected components of the graph; vertices are ordered by x then y, so the first one reached is the leftmost of its component
+	const uint32_t numVertices = (uint32_t)mVertices.size();
+	vector<uint8_t> visited( numVertices, 0 );
+	vector<uint32_t> stack;
+	vector<uint32_t> seeds;
+	for( uint32_t v = 0; v < numVertices; ++v ) {
+		if( visited[v] || mVertexOffsets[v] == mVertexOffsets[v + 1] )
+			continue;
+		seeds.push_back( v );
+		visited[v] = 1;
+		stack.push_back( v );
+		while( ! stack.empty() ) {
+			uint32_t u = stack.back();
+			stack.pop_back();
+			for( uint32_t o = mVertexOffsets[u]; o < mVertexOffsets[u + 1]; ++o ) {
+				uint32_t w = dest( mOutgoing[o] );
+				if( ! visited[w] ) {
+					visited[w] = 1;
+					stack.push_back( w );
+				}
+			}
+		}
+	}
+
+	// The faces left of the leftmost vertices are located with a sweep over x. The winding number at each such vertex counts the edges
+	// crossing below it; its own component never contributes as all of its edges lie to the right.
+	vector<uint32_t> edges( mHalfEdges.size() / 2 );
+	for( uint32_t e = 0; e < edges.size(); ++e )
+		edges[e] = e * 2;
+	auto minX = [this]( uint32_t h ) { return std::min( mVertices[mHalfEdges[h].mOrigin].x, mVertices[dest( h )].x ); };
+	sort( edges.begin(), edges.end(), [&]( uint32_t a, uint32_t b ) { return minX( a ) < minX( b ); } );
+
+	const ivec2 unknown( numeric_limits<int>::min() );
+	mWindings.assign( mHalfEdges.size(), unknown );
+	vector<uint32_t> active;
+	size_t nextEdge = 0;
+	for( uint32_t c = 0; c < seeds.size(); ++c ) {
+		const uint32_t v = seeds[c];
+		const dvec2 &p = mVertices[v];
+		for( ; nextEdge < edges.size() && minX( edges[nextEdge] ) <= p.x; ++nextEdge )
+			active.push_back( edges[nextEdge] );
+
+		ivec2 winding( 0 );
+		size_t numActive = 0;
+		for( uint32_t h : active ) {
+			const dvec2 &a = mVertices[mHalfEdges[h].mOrigin], &b = mVertices[dest( h )];
+			if( std::max( a.x, b.x ) <= p.x )
+				continue; // seeds are visited in increasing x, so this edge is done
+			active[numActive++] = h;
+			const double side = ( b.x - a.x ) * ( p.y - a.y ) - ( p.x - a.x ) * ( b.y - a.y );
+			if( a.x <= p.x && b.x > p.x && side > 0 )
+				winding += ivec2( mHalfEdges[h].mDelta[0], mHalfEdges[h].mDelta[1] );
+			else if( b.x <= p.x && a.x > p.x && side < 0 )
+				winding -= ivec2( mHalfEdges[h].mDelta[0], mHalfEdges[h].mDelta[1] );
+		}
+		active.resize( numActive );
+
+		// all edges leave the leftmost vertex rightward, so the face spanning the left side follows the most counterclockwise one
+		const uint32_t seed = mOutgoing[mVertexOffsets[v + 1] - 1];
+		mWindings[seed] = winding;
+		stack.push_back( seed );
+		while( ! stack.empty() ) {
+			const uint32_t h = stack.back();
+			stack.pop_back();
+			const ivec2 w = mWindings[h];
+			const uint32_t next = nextAroundFace( h );
+			if( mWindings[next] == unknown ) {
+				mWindings[next] = w;
+				stack.push_back( next );
+			}
+			const uint32_t twin = h ^ 1;
+			if( mWindings[twin] == unknown ) {
+				mWindings[twin] = w - ivec2( mHalfEdges[h].mDelta[0], mHalfEdges[h].mDelta[1] );
+				stack.push_back( twin );
+			}
+		}
+	}
+}
+
+vector<vector<dvec2>> BooleanEngine::calculate( BooleanOp op, FillRule fillRule )
+{
+	vector<vector<dvec2>> result;
+	if( mSegments.empty() )
+		return result;
+
+	double extent = 0;
+	dvec4 bounds[2] = { dvec4( numeric_limits<double>::max() ), dvec4( numeric_limits<double>::max() ) }; // minX, -maxX, minY, -maxY
+	for( const auto &s : mSegments ) {
+		extent = std::max( { extent, math<double>::abs( s.mP0.x ), math<double>::abs( s.mP0.y ) } );
+		bounds[s.mSet] = glm::min( bounds[s.mSet], dvec4( s.mP0.x, -s.mP0.x, s.mP0.y, -s.mP0.y ) );
+	}
+
+	// an intersection of sets with disjoint bounds is empty
+	const bool overlapping = bounds[0].x <= -bounds[1].y && bounds[1].x <= -bounds[0].y && bounds[0].z <= -bounds[1].w && bounds[1].z <= -bounds[0].w;
+	if( op == BOOLEAN_INTERSECTION && ! overlapping )
+		return result;
+	mEpsilon = std::max( extent, 1.0 ) * 1e-9;
+
+	findIntersections();
+	buildGraph();
+	if( mHalfEdges.empty() )
+		return result;
+	calcWindings();
+
+	auto isFilled = [fillRule]( int winding ) {
+		switch( fillRule ) {
+			case FILL_EVEN_ODD: return ( winding & 1 ) != 0;
+			case FILL_POSITIVE: return winding > 0;
+			case FILL_NEGATIVE: return winding < 0;
+			default: return winding != 0;
+		}
+	};
+	auto isInside = [&]( const ivec2 &winding ) {
+		const bool a = isFilled( winding.x ), b = isFilled( winding.y );
+		switch( op ) {
+			case BOOLEAN_INTERSECTION: return a && b;
+			case BOOLEAN_DIFFERENCE: return a && ! b;
+			case BOOLEAN_XOR: return a != b;
+			default: return a || b;
+		}
+	};
+
+	auto isStraight = [this]( const dvec2 &prev, const dvec2 &cur, const dvec2 &next ) {
+		const dvec2 d0 = cur - prev, d1 = next - cur;
+		return math<double>::abs( d0.x * d1.y - d0.y * d1.x ) <= mEpsilon * ( length( d0 ) + length( d1 ) ) && dot( d0, d1 ) > 0;
+	};
+
+	// keep the half-edges with the result on their left and not on their right
+	vector<uint8_t> boundary( mHalfEdges.size() );
+	for( uint32_t h = 0; h < mHalfEdges.size(); ++h )
+		boundary[h] = isInside( mWindings[h] ) && ! isInside( mWindings[h ^ 1] );
+
+	for( uint32_t start = 0; start < mHalfEdges.size(); ++start ) {
+		if( ! boundary[start] )
+			continue;
+
+		// walk the boundary, turning as sharply clockwise as possible at each vertex so that touching contours stay separate
+		vector<dvec2> contour;
+		uint32_t h = start;
+		do {
+			boundary[h] = 0;
+			contour.push_back( mVertices[mHalfEdges[h].mOrigin] );
+			uint32_t next = nextAroundFace( h );
+			const uint32_t degree = mVertexOffsets[mHalfEdges[next].mOrigin + 1] - mVertexOffsets[mHalfEdges[next].mOrigin];
+			for( uint32_t i = 0; i < degree && ! boundary[next] && next != start; ++i )
+				next = nextAroundFace( next ^ 1 );
+			h = next;
+		} while( h != start && boundary[h] );
+
+		// remove vertices that continue straight on, left behind by splits of edges that aren't part of the result
+		vector<dvec2> simplified;
+		simplified.reserve( contour.size() );
+		for( size_t i = 0; i < contour.size(); ++i ) {
+			const dvec2 &prev = simplified.empty() ? contour.back() : simplified.back();
+			if( ! isStraight( prev, contour[i], contour[( i + 1 ) % contour.size()] ) )
+				simplified.push_back( contour[i] );
+		}
+		if( simplified.size() >= 3 && isStraight( simplified.back(), simplified[0], simplified[1] ) )
+			simplified.erase( simplified.begin() );
+		contour.swap( simplified );
+
+		if( contour.size() >= 3 )
+			result.push_back( std::move( contour ) );
+	}
+
+	return result;
+}
+
+template<typename T>
+vector<PolyLineT<T>> toPolyLines( const vector<vector<dvec2>> &contours )
+{
+	vector<PolyLineT<T>> result;
+	result.reserve( contours.size() );
+	for( const auto &contour : contours ) {
+		vector<T> points( contour.size() );
+		for( size_t i = 0; i < contour.size(); ++i )
+			points[i] = T( contour[i] );
+		result.emplace_back( std::move( points ), true );
+	}
+
+	return result;
+}
+
+template<typename T>
+void addPolyLines( BooleanEngine *engine, const vector<PolyLineT<T>> &polyLines, int set )
+{
+	for( const auto &polyLine : polyLines ) {
+		const auto &points = polyLine.getPoints();
+		size_t numPoints = points.size();
+		// a repeated closing point would only add a zero-length edge
+		if( numPoints > 1 && points.front() == points.back() )
+			--numPoints;
+		if( numPoints >= 3 )
+			engine->addContour( points.data(), numPoints, set );
+	}
+}
+
+// Appends the points of a polygon offset by delta, including the loops at concave corners that the union in calcOffset() removes.
+void offsetContour( const vector<dvec2> &points, double delta, int joinType, double miterLimit, double arcTolerance, vector<dvec2> *result )
+{
+	const size_t numPoints = points.size();
+	const double absDelta = math<double>::abs( delta ), sign = ( delta < 0 ) ? -1 : 1;
+	// the angle subtended by each step of a round join
+	const double stepAngle = 2 * math<double>::acos( math<double>::clamp( 1 - std::min( arcTolerance, absDelta ) / absDelta, -1, 1 ) );
+
+	vector<dvec2> normals( numPoints );
+	for( size_t i = 0; i < numPoints; ++i ) {
+		dvec2 d = normalize( points[( i + 1 ) % numPoints] - points[i] );
+		normals[i] = dvec2( d.y, -d.x ); // outward for counterclockwise contours
+	}
+
+	for( size_t i = 0; i < numPoints; ++i ) {
+		const dvec2 &p = points[i];
+		// normals of the incoming and outgoing edges, flipped when shrinking so that joins are always added on the outside of m1 -> m2
+		const dvec2 m1 = normals[( i + numPoints - 1 ) % numPoints] * sign, m2 = normals[i] * sign;
+		const double sinAngle = m1.x * m2.y - m1.y * m2.x, cosAngle = dot( m1, m2 );
+		if( sinAngle * sign < 0 && cosAngle < 0.999999 ) {
+			// a concave corner; route through the vertex so the overlapping loop has the winding the union discards
+			result->push_back( p + m1 * absDelta );
+			result->push_back( p );
+			result->push_back( p + m2 * absDelta );
+			continue;
+		}
+		if( sinAngle * sign < 0 || cosAngle >= 0.999999 ) {
+			result->push_back( p + m2 * absDelta );
+			continue;
+		}
+
+		const double angle = math<double>::atan2( sinAngle, cosAngle );
+		if( joinType == PolyLine2d::JOIN_MITER && sqrt( 2 / ( 1 + cosAngle ) ) <= miterLimit ) {
+			result->push_back( p + ( m1 + m2 ) * ( absDelta / ( 1 + cosAngle ) ) );
+		}
+		else if( joinType == PolyLine2d::JOIN_ROUND ) {
+			const int steps = std::max( 1, (int)math<double>::ceil( math<double>::abs( angle ) / std::max( stepAngle, 1e-3 ) ) );
+			for( int s = 0; s <= steps; ++s ) {
+				const double a = angle * s / steps;
+				const double c = math<double>::cos( a ), sn = math<double>::sin( a );
+				result->push_back( p + dvec2( m1.x * c - m1.y * sn, m1.x * sn + m1.y * c ) * absDelta );
+			}
+		}
+		else {
+			// square, also used for miters over the limit: cut the corner at distance delta along the bisector
+			const double k = math<double>::tan( math<double>::abs( angle ) / 4 );
+			const dvec2 dir1( -m1.y, m1.x ), dir2( -m2.y, m2.x );
+			result->push_back( p + ( m1 + dir1 * k * sign ) * absDelta );
+			result->push_back( p + ( m2 - dir2 * k * sign ) * absDelta );
+		}
+	}
+}
+
+template<typename T>
+vector<PolyLineT<T>> flattenShape( const Shape2d &shape, float tolerance )
+{
+	PathFlattener flattener( tolerance );
+	flattener.flatten( shape );
+
+	vector<PolyLineT<T>> result;
+	result.reserve( flattener.getNumContours() );
+	for( size_t c = 0; c < flattener.getNumContours(); ++c ) {
+		const vec2 *points = flattener.getContourPoints( c );
+		result.emplace_back( vector<T>( points, points + flattener.getContourNumPoints( c ) ), true );
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+template<typename T>
+vector<PolyLineT<T>> PolyLineT<T>::calcBoolean( BooleanOp op, const vector<PolyLineT> &a, const vector<PolyLineT> &b, FillRule fillRule )
+{
+	BooleanEngine engine;
+	addPolyLines( &engine, a, 0 );
+	addPolyLines( &engine, b, 1 );
+	return toPolyLines<T>( engine.calculate( (BooleanEngine::BooleanOp)op, (BooleanEngine::FillRule)fillRule ) );
+}
+
+template<typename T>
+vector<vector<PolyLineT<T>>> PolyLineT<T>::calcBoolean( BooleanOp op, const vector<vector<PolyLineT>> &subjects, const vector<PolyLineT> &clip, FillRule fillRule )
+{
+	vector<vector<PolyLineT>> result( subjects.size() );
+	parallelFor( 0, subjects.size(), 16, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			result[i] = calcBoolean( op, subjects[i], clip, fillRule );
+	} );
+
+	return result;
+}
+
+template<typename T>
+vector<PolyLineT<T>> PolyLineT<T>::calcOffset( const vector<PolyLineT> &polygons, double delta, JoinType joinType, double miterLimit, double arcTolerance )
+{
+	if( delta == 0 )
+		return calcUnion( polygons );
+
+	// contours are expected to be counterclockwise outers and clockwise holes; if the leftmost contour, which is necessarily an outer, runs
+	// clockwise then the whole set is assumed to use the opposite convention
+	vector<vector<dvec2>> contours;
+	size_t leftmostContour = 0;
+	double leftmostX = numeric_limits<double>::max();
+	for( const auto &polygon : polygons ) {
+		vector<dvec2> points;
+		for( const auto &p : polygon.getPoints() ) {
+			if( points.empty() || dvec2( p ) != points.back() )
+				points.emplace_back( p );
+		}
+		if( points.size() > 1 && points.front() == points.back() )
+			points.pop_back();
+		if( points.size() < 3 )
+			continue;
+		for( const auto &p : points ) {
+			if( p.x < leftmostX ) {
+				leftmostX = p.x;
+				leftmostContour = contours.size();
+			}
+		}
+		contours.push_back( std::move( points ) );
+	}
+	if( contours.empty() )
+		return vector<PolyLineT>();
+
+	double leftmostArea = 0;
+	const auto &leftmost = contours[leftmostContour];
+	for( size_t i = 0; i < leftmost.size(); ++i ) {
+		const dvec2 &p0 = leftmost[i], &p1 = leftmost[( i + 1 ) % leftmost.size()];
+		leftmostArea += p0.x * p1.y - p1.x * p0.y;
+	}
+	if( leftmostArea < 0 )
+		delta = -delta;
+
+	BooleanEngine engine;
+	vector<dvec2> offset;
+	for( const auto &contour : contours ) {
+		offset.clear();
+		offsetContour( contour, delta, joinType, miterLimit, arcTolerance, &offset );
+		engine.addContour( offset.data(), offset.size(), 0 );
+	}
+
+	auto result = engine.calculate( BooleanEngine::BOOLEAN_UNION, ( leftmostArea < 0 ) ? BooleanEngine::FILL_NEGATIVE : BooleanEngine::FILL_POSITIVE );
+	if( leftmostArea < 0 ) {
+		for( auto &contour : result )
+			std::reverse( contour.begin(), contour.end() );
+	}
+
+	return toPolyLines<T>( result );
+}
+
+template<typename T>
+vector<PolyLineT<T>> PolyLineT<T>::calcBoolean( BooleanOp op, const Shape2d &a, const Shape2d &b, FillRule fillRule, float tolerance )
+{
+	return calcBoolean( op, flattenShape<T>( a, tolerance ), flattenShape<T>( b, tolerance ), fillRule );
+}
+
+template<typename T>
+vector<PolyLineT<T>> PolyLineT<T>::calcUnion( const Shape2d &shape, FillRule fillRule, float tolerance )
+{
+	return calcUnion( flattenShape<T>( shape, tolerance ), fillRule );
+}
+
+template<typename T>
+vector<PolyLineT<T>> PolyLineT<T>::calcOffset( const Shape2d &shape, double delta, JoinType joinType, double miterLimit, double arcTolerance, float tolerance )
+{
+	return calcOffset( flattenShape<T>( shape, tolerance ), delta, joinType, miterLimit, arcTolerance );
+}
+
+#define POLYLINE_BOOLEAN_INSTANTIATE( T ) \
+	template CI_API vector<PolyLineT<T>> PolyLineT<T>::calcBoolean( BooleanOp, const vector<PolyLineT<T>>&, const vector<PolyLineT<T>>&, FillRule ); \
+	template CI_API vector<vector<PolyLineT<T>>> PolyLineT<T>::calcBoolean( BooleanOp, const vector<vector<PolyLineT<T>>>&, const vector<PolyLineT<T>>&, FillRule ); \
+	template CI_API vector<PolyLineT<T>> PolyLineT<T>::calcOffset( const vector<PolyLineT<T>>&, double, JoinType, double, double ); \
+	template CI_API vector<PolyLineT<T>> PolyLineT<T>::calcBoolean( BooleanOp, const Shape2d&, const Shape2d&, FillRule, float ); \
+	template CI_API vector<PolyLineT<T>> PolyLineT<T>::calcUnion( const Shape2d&, FillRule, float ); \
+	template CI_API vector<PolyLineT<T>> PolyLineT<T>::calcOffset( const Shape2d&, double, JoinType, double, double, float );
+
+POLYLINE_BOOLEAN_INSTANTIATE( vec2 )
+POLYLINE_BOOLEAN_INSTANTIATE( dvec2 )
+
+} // namespace cinder
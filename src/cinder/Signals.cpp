@@ -23,6 +23,10 @@
 
 #include "cinder/Signals.h"
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 using namespace std;
 
 namespace cinder { namespace signals {
@@ -164,4 +168,125 @@ bool Disconnector::disconnect( SignalLinkBase *link, int priority )
 	return mSignal->disconnect( link, priority );
 }
 
+namespace {
+
+// Signals with queued deferred emissions. Leaked, so that signals may still be destroyed during static destruction.
+struct DeferredQueue {
+	mutex							mMutex;
+	condition_variable				mEmittedCond;
+	deque<ConcurrentSignalBase*>	mPending;
+	ConcurrentSignalBase			*mEmitting = nullptr;
+	thread::id						mEmittingThread;
+};
+
+DeferredQueue& getDeferredQueue()
+{
+	static DeferredQueue *sQueue = new DeferredQueue;
+	return *sQueue;
+}
+
+} // anonymous namespace
+
+ConcurrentSignalBase::ConcurrentSignalBase()
+	: mEpoch( 0 ), mDeferredScheduled( false )
+{
+	mReaders[0] = 0;
+	mReaders[1] = 0;
+}
+
+ConcurrentSignalBase::~ConcurrentSignalBase()
+{
+	freeRetired();
+}
+
+void ConcurrentSignalBase::retire( Snapshot *snapshot )
+{
+	// the writer holding mWriteMutex is the only one to advance the epoch
+	mRetired.emplace_back( snapshot, mEpoch.load() );
+
+	// The epoch may advance once the previous epoch's readers have finished, which leaves only readers of the current epoch.
+	// Emissions of an epoch confirmed it after registering, so they may have read any list replaced during or after that epoch.
+	for( int i = 0; i < 2; ++i ) {
+		const size_t epoch = mEpoch.load();
+		if( mReaders[( epoch + 1 ) & 1].load() != 0 )
+			break;
+		mEpoch.store( epoch + 1 );
+	}
+
+	// a list replaced during epoch e was visible to readers of epochs e and earlier, all of which are done once the epoch reaches e + 2
+	const size_t epoch = mEpoch.load();
+	auto end = remove_if( mRetired.begin(), mRetired.end(), [epoch]( const pair<Snapshot*, size_t> &retired ) {
+		if( retired.second + 2 > epoch )
+			return false;
+		delete retired.first;
+		return true;
+	} );
+	mRetired.erase( end, mRetired.end() );
+}
+
+void ConcurrentSignalBase::freeRetired()
+{
+	for( auto &retired : mRetired )
+		delete retired.first;
+	mRetired.clear();
+}
+
+void ConcurrentSignalBase::scheduleDeferred()
+{
+	auto &queue = getDeferredQueue();
+	lock_guard<mutex> lock( queue.mMutex );
+	if( ! mDeferredScheduled ) {
+		mDeferredScheduled = true;
+		queue.mPending.push_back( this );
+	}
+}
+
+void ConcurrentSignalBase::cancelDeferred()
+{
+	auto &queue = getDeferredQueue();
+	unique_lock<mutex> lock( queue.mMutex );
+	if( mDeferredScheduled ) {
+		queue.mPending.erase( find( queue.mPending.begin(), queue.mPending.end(), this ) );
+		mDeferredScheduled = false;
+	}
+
+	// a signal destroyed by one of its own deferred callbacks cannot wait for itself
+	while( queue.mEmitting == this && queue.mEmittingThread != this_thread::get_id() )
+		queue.mEmittedCond.wait( lock );
+}
+
+size_t ConcurrentSignalBase::emitDeferred()
+{
+	auto &queue = getDeferredQueue();
+	unique_lock<mutex> lock( queue.mMutex );
+
+	// signals scheduled by the emissions themselves wait for the next call
+	size_t numSignals = queue.mPending.size();
+	size_t result = 0;
+	while( numSignals-- && ! queue.mPending.empty() ) {
+		ConcurrentSignalBase *signal = queue.mPending.front();
+		queue.mPending.pop_front();
+		signal->mDeferredScheduled = false;
+		queue.mEmitting = signal;
+		queue.mEmittingThread = this_thread::get_id();
+		lock.unlock();
+
+		try {
+			result += signal->emitQueued();
+		}
+		catch( ... ) {
+			lock.lock();
+			queue.mEmitting = nullptr;
+			queue.mEmittedCond.notify_all();
+			throw;
+		}
+
+		lock.lock();
+		queue.mEmitting = nullptr;
+		queue.mEmittedCond.notify_all();
+	}
+
+	return result;
+}
+
 } } } // namespace cinder::signals::detail
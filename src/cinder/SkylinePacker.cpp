@@ -0,0 +1,123 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/SkylinePacker.h"
+
+#include <limits>
+
+namespace cinder {
+
+SkylinePacker::SkylinePacker( const ivec2 &size )
+	: mSize( size )
+{
+	clear();
+}
+
+void SkylinePacker::clear()
+{
+	mSkyline.clear();
+	if( mSize.x > 0 )
+		mSkyline.push_back( { 0, 0, mSize.x } );
+	mUsedArea = 0;
+}
+
+float SkylinePacker::getOccupancy() const
+{
+	int64_t area = (int64_t)mSize.x * mSize.y;
+	return ( area > 0 ) ? (float)( (double)mUsedArea / area ) : 0;
+}
+
+int32_t SkylinePacker::calcFit( size_t index, const ivec2 &size ) const
+{
+	if( mSkyline[index].mX + size.x > mSize.x )
+		return -1;
+
+	int32_t y = 0;
+	int32_t widthLeft = size.x;
+	for( size_t i = index; widthLeft > 0; ++i ) {
+		y = std::max( y, mSkyline[i].mY );
+		if( y + size.y > mSize.y )
+			return -1;
+		widthLeft -= mSkyline[i].mWidth;
+	}
+
+	return y;
+}
+
+Area SkylinePacker::insert( const ivec2 &size )
+{
+	if( size.x <= 0 || size.y <= 0 || size.x > mSize.x || size.y > mSize.y )
+		return Area( 0, 0, 0, 0 );
+
+	// bottom-left rule: lowest resulting top edge, ties broken by the narrowest segment
+	size_t bestIndex = 0;
+	int32_t bestX = 0, bestY = -1;
+	int32_t bestTop = std::numeric_limits<int32_t>::max(), bestWidth = std::numeric_limits<int32_t>::max();
+	for( size_t i = 0; i < mSkyline.size(); ++i ) {
+		int32_t y = calcFit( i, size );
+		if( y < 0 )
+			continue;
+		if( y + size.y < bestTop || ( y + size.y == bestTop && mSkyline[i].mWidth < bestWidth ) ) {
+			bestIndex = i;
+			bestX = mSkyline[i].mX;
+			bestY = y;
+			bestTop = y + size.y;
+			bestWidth = mSkyline[i].mWidth;
+		}
+	}
+
+	if( bestY < 0 )
+		return Area( 0, 0, 0, 0 );
+
+	// raise the skyline under the new rectangle, trimming or removing the segments it covers
+	mSkyline.insert( mSkyline.begin() + bestIndex, Segment{ bestX, bestTop, size.x } );
+	for( size_t i = bestIndex + 1; i < mSkyline.size(); ) {
+		Segment &segment = mSkyline[i];
+		int32_t covered = bestX + size.x - segment.mX;
+		if( covered <= 0 )
+			break;
+		if( covered < segment.mWidth ) {
+			segment.mX += covered;
+			segment.mWidth -= covered;
+			break;
+		}
+		mSkyline.erase( mSkyline.begin() + i );
+	}
+
+	// merge neighbors of equal height
+	for( size_t i = 0; i + 1 < mSkyline.size(); ) {
+		if( mSkyline[i].mY == mSkyline[i + 1].mY ) {
+			mSkyline[i].mWidth += mSkyline[i + 1].mWidth;
+			mSkyline.erase( mSkyline.begin() + i + 1 );
+		}
+		else
+			++i;
+	}
+
+	mUsedArea += (int64_t)size.x * size.y;
+	return Area( bestX, bestY, bestX + size.x, bestY + size.y );
+}
+
+} // namespace cinder
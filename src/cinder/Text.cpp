@@ -57,6 +57,8 @@
 	static const float MAX_SIZE = 1000000.0f;
 #elif defined( CINDER_UWP ) || defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	#include "cinder/linux/FreeTypeUtil.h"
+	#include <list>
+	#include <mutex>
 
 	static const float MAX_SIZE = 1000000.0f;
 #endif
@@ -150,7 +152,7 @@ class Line {
 	Line();
 	~Line();
 
-	void addRun( const Run &run ) { mRuns.push_back( run ); }
+	void addRun( const Run &run ) { mRuns.push_back( run ); mCalculated = false; }
 
 	void calcExtents();
 #if defined( CINDER_COCOA )
@@ -166,6 +168,7 @@ class Line {
 	enum { LEFT, RIGHT, CENTERED };
 
 	vector<Run>			mRuns;
+	bool				mCalculated;
 	int8_t				mJustification;
 	float				mHeight, mWidth;
 	float				mLeadingOffset;
@@ -181,6 +184,7 @@ Line::Line()
 	mCTLineRef = 0;
 #endif
 	mLeadingOffset = 0;
+	mCalculated = false;
 }
 
 Line::~Line()
@@ -191,10 +195,17 @@ Line::~Line()
 #endif
 }
 
- // sets the line's mWidth, mHeight, mAscent, mDescent, mLeading
+ // sets the line's mWidth, mHeight, mAscent, mDescent, mLeading; does nothing unless runs were added since the last call
 void Line::calcExtents()
 {
+	if( mCalculated )
+		return;
+	mCalculated = true;
+
 #if defined( CINDER_COCOA )
+	if( mCTLineRef != 0 )
+		::CFRelease( mCTLineRef );
+
 	CFMutableAttributedStringRef attrStr = ::CFAttributedStringCreateMutable( kCFAllocatorDefault, 0 );
 
 	// Defer internal consistency-checking and coalescing until we're done building this thing
@@ -424,16 +435,19 @@ TextLayout::TextLayout()
 	mBackgroundColor = ColorA( 0, 0, 0, 0 );
 	mCurrentLeadingOffset = 0;
 	mHorizontalBorder = mVerticalBorder = 0;
+	mRenderedUseAlpha = mRenderedPremultiplied = false;
 }
 
 void TextLayout::clear( const Color &color )
 {
 	mBackgroundColor = color;
+	mRendered = Surface();
 }
 
 void TextLayout::clear( const ColorA &color )
 {
 	mBackgroundColor = color;
+	mRendered = Surface();
 }
 
 void TextLayout::addLine( const string &line )
@@ -443,6 +457,7 @@ void TextLayout::addLine( const string &line )
 	newLine->mJustification = Line::LEFT;
 	newLine->mLeadingOffset = mCurrentLeadingOffset;	
 	mLines.push_back( newLine );
+	mRendered = Surface();
 }
 
 void TextLayout::addCenteredLine( const string &line )
@@ -452,6 +467,7 @@ void TextLayout::addCenteredLine( const string &line )
 	newLine->mJustification = Line::CENTERED;
 	newLine->mLeadingOffset = mCurrentLeadingOffset;
 	mLines.push_back( newLine );
+	mRendered = Surface();
 }
 
 void TextLayout::addRightLine( const string &line )
@@ -461,14 +477,17 @@ void TextLayout::addRightLine( const string &line )
 	newLine->mJustification = Line::RIGHT;
 	newLine->mLeadingOffset = mCurrentLeadingOffset;
 	mLines.push_back( newLine );
+	mRendered = Surface();
 }
 
 void TextLayout::append( const string &str )
 {
 	if( mLines.empty() )
 		addLine( str );
-	else
+	else {
 		mLines.back()->addRun( Run( str, mCurrentFont, mCurrentColor ) );
+		mRendered = Surface();
+	}
 }
 
 void TextLayout::setFont( const Font &font )
@@ -485,6 +504,7 @@ void TextLayout::setBorder( int horizontal, int vertical )
 {
 	mHorizontalBorder = horizontal;
 	mVerticalBorder = vertical;
+	mRendered = Surface();
 }
 
 void TextLayout::setColor( const Color &color )
@@ -499,6 +519,9 @@ void TextLayout::setColor( const ColorA &color )
 
 Surface	TextLayout::render( bool useAlpha, bool premultiplied )
 {
+	if( mRendered.getData() && ( useAlpha == mRenderedUseAlpha ) && ( premultiplied == mRenderedPremultiplied ) )
+		return mRendered.clone();
+
 	Surface result;
 	
 	// determine the extents for all the lines and the result surface
@@ -620,6 +643,10 @@ Surface	TextLayout::render( bool useAlpha, bool premultiplied )
 	}
 #endif
 
+	mRendered = result.clone();
+	mRenderedUseAlpha = useAlpha;
+	mRenderedPremultiplied = premultiplied;
+
 	return result;
 }
 
@@ -1027,29 +1054,230 @@ Surface	TextBox::render( vec2 offset )
 
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 
-void TextBox::calculate() const
+// The line breaks and glyphs of a TextBox's text for a given font and width. Immutable once built, so that TextBoxes can share it through TextBoxLayoutCache.
+class TextBoxLayout {
+  public:
+	struct Line {
+		Line( size_t begin, size_t end, const ci::linux::ftutil::Measure &measure )
+			: mBegin( begin ), mEnd( end ), mMeasure( measure )
+		{}
+
+		size_t						mBegin, mEnd; // byte range within mText
+		ci::linux::ftutil::Measure	mMeasure;
+		std::vector<uint32_t>		mGlyphs;
+		std::vector<int32_t>		mAdvances; // 26.6 fixed point
+	};
+
+	TextBoxLayout( const Font &font, int width, const std::string &text )
+		: mFontName( font.getName() ), mFontSize( font.getSize() ), mWidth( width ), mText( text ), mSize( 0 )
+	{
+		mHash = calcHash( mFontName, mFontSize, mWidth, mText );
+	}
+
+	bool	matches( size_t hash, const Font &font, int width, const std::string &text ) const
+	{
+		return ( hash == mHash ) && ( width == mWidth ) && ( font.getSize() == mFontSize ) && ( font.getName() == mFontName ) && ( text == mText );
+	}
+
+	// lays out the text from byte 'begin', which must be the start of a line, appending to mLines
+	void	layout( const Font &font, size_t begin, const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics );
+
+	static size_t	calcHash( const std::string &fontName, float fontSize, int width, const std::string &text )
+	{
+		size_t result = std::hash<std::string>()( text );
+		result ^= std::hash<std::string>()( fontName ) + 0x9e3779b9 + ( result << 6 ) + ( result >> 2 );
+		result ^= std::hash<float>()( fontSize ) + 0x9e3779b9 + ( result << 6 ) + ( result >> 2 );
+		result ^= std::hash<int>()( width ) + 0x9e3779b9 + ( result << 6 ) + ( result >> 2 );
+		return result;
+	}
+
+	std::string			mFontName;
+	float				mFontSize;
+	int					mWidth;
+	std::string			mText;
+	size_t				mHash;
+	std::vector<Line>	mLines;
+	vec2				mSize;
+};
+
+void TextBoxLayout::layout( const Font &font, size_t begin, const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics )
 {
-	if( ! mInvalid ) {	
-		return;
+	FT_Face face = font.getFreetypeFace();
+	const char *text = mText.c_str();
+	const size_t textLength = mText.size();
+
+	// find every glyph and its advance once, along with the pen position before each character and the character starting at each byte,
+	// so that line breaking can measure any substring without touching FreeType again
+	std::vector<uint32_t> glyphs;
+	std::vector<int32_t> advances;
+	std::vector<int64_t> penX( 1, 0 );
+	std::vector<uint32_t> byteChars( textLength - begin + 1 );
+	size_t byte = begin;
+	while( byte < textLength ) {
+		size_t charBegin = byte;
+		uint32_t ch = nextCharUtf8( text, &byte, textLength );
+		if( ch == 0xFFFF ) { // malformed UTF-8 ends line breaking too
+			byte = charBegin;
+			break;
+		}
+		for( size_t b = charBegin; b < byte && b < textLength; ++b )
+			byteChars[b - begin] = (uint32_t)glyphs.size();
+
+		FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
+		int32_t advance;
+		auto iter = ( nullptr != cachedGlyphMetrics ) ? cachedGlyphMetrics->find( glyphIndex ) : std::map<Font::Glyph, Font::GlyphMetrics>::const_iterator();
+		if( ( nullptr != cachedGlyphMetrics ) && ( iter != cachedGlyphMetrics->end() ) ) {
+			advance = iter->second.advance.x;
+		}
+		else {
+			FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT );
+			advance = (int32_t)face->glyph->advance.x;
+		}
+
+		glyphs.push_back( glyphIndex );
+		advances.push_back( advance );
+		penX.push_back( penX.back() + advance );
 	}
+	for( ; byte <= textLength; ++byte )
+		byteChars[byte - begin] = (uint32_t)glyphs.size();
+
+	const int maxWidth = mWidth;
+	auto measureFn = [&]( const char *line, size_t len ) -> bool {
+		if( maxWidth >= MAX_SIZE ) {
+			// too big anyway so just return true
+			return true;
+		}
 
-	if( mText.empty() ) {
-		mCalculatedSize = vec2();
-		return;
-	}	
+		// lineBreakUtf8() may probe past the end of the text
+		size_t lineBegin = line - text, lineEnd = std::min( lineBegin + len, textLength );
+		int64_t width = penX[byteChars[lineEnd - begin]] - penX[byteChars[lineBegin - begin]];
+		return ( width >> 6 ) <= maxWidth;
+	};
+	auto lineFn = [&]( const char *line, size_t len ) {
+		size_t lineBegin = line - text;
+		len = std::min( len, textLength - lineBegin );
+		mLines.emplace_back( lineBegin, lineBegin + len, ci::linux::ftutil::MeasureString( std::string( line, len ), face ) );
+		uint32_t firstChar = byteChars[lineBegin - begin], lastChar = byteChars[lineBegin + len - begin];
+		mLines.back().mGlyphs.assign( glyphs.begin() + firstChar, glyphs.begin() + lastChar );
+		mLines.back().mAdvances.assign( advances.begin() + firstChar, advances.begin() + lastChar );
+	};
+	lineBreakUtf8( text + begin, measureFn, lineFn );
 
-	mCalculatedSize = vec2();
-	FT_Face face = mFont.getFreetypeFace();
+	mSize = vec2( 0 );
+	for( const auto &line : mLines ) {
+		float fullWidth = (float)( line.mMeasure.getBaseline().x + line.mMeasure.getWidth() );
+		mSize.x = std::max( mSize.x, fullWidth );
+		mSize.y += line.mMeasure.getHeight();
+	}
+}
+
+namespace {
 
-	vector<string> lines = calculateLineBreaks( nullptr );
-	for( const auto& text : lines ) {
-		auto measure = ci::linux::ftutil::MeasureString( text, face );
-		float fullWidth = measure.getBaseline().x + measure.getWidth();
-		mCalculatedSize.x = std::max( mCalculatedSize.x, fullWidth );
-		mCalculatedSize.y += measure.getHeight();
+// Least recently used TextBoxLayouts, shared between all TextBoxes
+class TextBoxLayoutCache : private Noncopyable {
+  public:
+	static TextBoxLayoutCache*	instance()
+	{
+		static TextBoxLayoutCache sInstance;
+		return &sInstance;
+	}
+
+	std::shared_ptr<const TextBoxLayout>	find( const Font &font, int width, const std::string &text )
+	{
+		size_t hash = TextBoxLayout::calcHash( font.getName(), font.getSize(), width, text );
+
+		std::lock_guard<std::mutex> lock( mMutex );
+		for( auto layoutIt = mLayouts.begin(); layoutIt != mLayouts.end(); ++layoutIt ) {
+			if( (*layoutIt)->matches( hash, font, width, text ) ) {
+				mLayouts.splice( mLayouts.begin(), mLayouts, layoutIt );
+				return mLayouts.front();
+			}
+		}
+
+		return nullptr;
+	}
+
+	void	insert( const std::shared_ptr<const TextBoxLayout> &layout )
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mLayouts.push_front( layout );
+		trim();
+	}
+
+	void	setCapacity( size_t capacity )
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mCapacity = capacity;
+		trim();
+	}
+
+	void	clear()
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mLayouts.clear();
+	}
+
+  private:
+	TextBoxLayoutCache() : mCapacity( 64 ) {}
+
+	void	trim()
+	{
+		while( mLayouts.size() > mCapacity )
+			mLayouts.pop_back();
+	}
+
+	std::mutex										mMutex;
+	std::list<std::shared_ptr<const TextBoxLayout>>	mLayouts; // most recently used first
+	size_t											mCapacity;
+};
+
+} // anonymous namespace
+
+void TextBox::setLayoutCacheCapacity( size_t numLayouts )
+{
+	TextBoxLayoutCache::instance()->setCapacity( numLayouts );
+}
+
+void TextBox::clearLayoutCache()
+{
+	TextBoxLayoutCache::instance()->clear();
+}
+
+const TextBoxLayout& TextBox::getLayout( const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics ) const
+{
+	if( mLayout && ! mInvalid )
+		return *mLayout;
+
+	const int width = ( mSize.x > 0 ) ? mSize.x : (int)MAX_SIZE;
+	auto *cache = TextBoxLayoutCache::instance();
+	auto cached = cache->find( mFont, width, mText );
+	if( cached ) {
+		mLayout = cached;
+	}
+	else {
+		auto layout = make_shared<TextBoxLayout>( mFont, width, mText );
+		// after appendText() every line but the last breaks exactly as before, so only the last line is laid out again
+		const TextBoxLayout *previous = mLayout.get();
+		if( previous && ( ! previous->mLines.empty() ) && ( previous->mWidth == width ) && ( previous->mFontSize == mFont.getSize() ) && ( previous->mFontName == mFont.getName() )
+			&& ( mText.size() > previous->mText.size() ) && ( mText.compare( 0, previous->mText.size(), previous->mText ) == 0 ) ) {
+			layout->mLines.assign( previous->mLines.begin(), previous->mLines.end() - 1 );
+			layout->layout( mFont, previous->mLines.back().mBegin, cachedGlyphMetrics );
+		}
+		else {
+			layout->layout( mFont, 0, cachedGlyphMetrics );
+		}
+
+		cache->insert( layout );
+		mLayout = layout;
 	}
 
 	mInvalid = false;
+	return *mLayout;
+}
+
+void TextBox::calculate() const
+{
+	mCalculatedSize = getLayout().mSize;
 }
 
 vec2 TextBox::measure() const
@@ -1061,54 +1289,9 @@ vec2 TextBox::measure() const
 vector<string> TextBox::calculateLineBreaks( const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics ) const
 {
 	vector<string> result;
-
-	vector<string> strings;
-	struct LineProcessor {
-		LineProcessor( vector<string> *strings ) : mStrings( strings ) {}
-		void operator()( const char *line, size_t len ) const { mStrings->push_back( string( line, len ) ); }
-		mutable vector<string> *mStrings;
-	};
-	struct LineMeasure {
-		LineMeasure( int maxWidth, const Font &font, const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics = nullptr ) 
-			: mMaxWidth( maxWidth ), mFont( font.getFreetypeFace() ), mCachedGlyphMerics( cachedGlyphMetrics ) {}
-		bool operator()( const char *line, size_t len ) const {
-			if( mMaxWidth >= MAX_SIZE ) {
-				// too big anyway so just return true
-				return true;
-			}
-
-			std::u32string utf32Chars = ci::toUtf32( std::string( line, len ) );
-			int measuredWidth = 0;
-			FT_Vector pen = { 0, 0 };
-			for( const auto& ch : utf32Chars ) {
-				ivec2 advance = { 0, 0 };
-				FT_UInt glyphIndex = FT_Get_Char_Index( mFont, ch );
-				if( nullptr != mCachedGlyphMerics ) {
-					auto iter = mCachedGlyphMerics->find( glyphIndex );
-					advance = iter->second.advance;		
-				}
-				else  {
-					FT_Load_Glyph( mFont, glyphIndex, FT_LOAD_DEFAULT );
-					const FT_GlyphSlot& slot = mFont->glyph;
-					advance = ivec2( slot->advance.x, slot->advance.y );
-				}
-
-				pen.x += advance.x;
-				pen.y += advance.y;
-
-				measuredWidth = (pen.x >> 6);
-			}
-
-			bool result = (measuredWidth <= mMaxWidth);
-			return result;
-		}
-
-		int													mMaxWidth;
-		FT_Face												mFont;
-		const std::map<Font::Glyph, Font::GlyphMetrics>* 	mCachedGlyphMerics;
-	};
-	std::function<void(const char *,size_t)> lineFn = LineProcessor( &result );		
-	lineBreakUtf8( mText.c_str(), LineMeasure( ( mSize.x > 0 ) ? mSize.x : MAX_SIZE, mFont, cachedGlyphMetrics ), lineFn );
+	const auto &layout = getLayout( cachedGlyphMetrics );
+	for( const auto &line : layout.mLines )
+		result.push_back( layout.mText.substr( line.mBegin, line.mEnd - line.mBegin ) );
 
 	return result;
 }
@@ -1121,32 +1304,15 @@ vector<pair<uint32_t,vec2>> TextBox::measureGlyphs( const std::map<Font::Glyph,
 		return result;
 	}
 
-	FT_Face face = mFont.getFreetypeFace();
-	vector<string> mLines = calculateLineBreaks( cachedGlyphMetrics );
+	const auto &layout = getLayout( cachedGlyphMetrics );
 
 	float curY = 0;
-	for( vector<string>::const_iterator lineIt = mLines.begin(); lineIt != mLines.end(); ++lineIt ) {
-		std::u32string utf32Chars = ci::toUtf32( *lineIt );
-
-		FT_Vector pen = { 0, 0 };
-		for( const auto& ch : utf32Chars ) {
-			ivec2 advance = { 0, 0 };
-			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			if( nullptr != cachedGlyphMetrics ) {
-				auto iter = cachedGlyphMetrics->find( glyphIndex );
-				advance = iter->second.advance;
-			}
-			else {
-				FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT );
-				const FT_GlyphSlot& slot = face->glyph;
-				advance = ivec2( slot->advance.x, slot->advance.y );
-			}
-
-			float xPos = (pen.x / 64.0f) + 0.5f;
-			result.push_back( std::make_pair( (uint32_t)glyphIndex, vec2( xPos, curY ) ) );
-
-			pen.x += advance.x;
-			pen.y += advance.y;	
+	for( const auto &line : layout.mLines ) {
+		int64_t penX = 0;
+		for( size_t i = 0; i < line.mGlyphs.size(); ++i ) {
+			float xPos = (penX / 64.0f) + 0.5f;
+			result.push_back( std::make_pair( line.mGlyphs[i], vec2( xPos, curY ) ) );
+			penX += line.mAdvances[i];
 		}
 
 		curY += mFont.getAscent() + mFont.getDescent();
@@ -1157,19 +1323,10 @@ vector<pair<uint32_t,vec2>> TextBox::measureGlyphs( const std::map<Font::Glyph,
 
 Surface TextBox::render( vec2 offset )
 {
-	mCalculatedSize = vec2();
 	FT_Face face = mFont.getFreetypeFace();
 
-	std::vector<ci::linux::ftutil::Measure> measures;
-	std::vector<string> lines = calculateLineBreaks( nullptr );
-	for( const auto& text : lines ) {
-		auto measure = ci::linux::ftutil::MeasureString( text, face );
-		measures.push_back( measure );
-
-		float fullWidth = measure.getBaseline().x + measure.getWidth();
-		mCalculatedSize.x = std::max( mCalculatedSize.x, fullWidth );
-		mCalculatedSize.y += measure.getHeight();		
-	}
+	const auto &layout = getLayout();
+	mCalculatedSize = layout.mSize;
 
 	float sizeX = ( mSize.x <= 0 ) ? mCalculatedSize.x : mSize.x;
 	float sizeY = ( mSize.y <= 0 ) ? mCalculatedSize.y : mSize.y;
@@ -1193,9 +1350,8 @@ Surface TextBox::render( vec2 offset )
 	ivec2 		dstSize = result.getSize();
 
 	int curY = 0;
-	for( size_t i = 0; i < lines.size(); ++i ) {
-		const auto& text = lines[i];
-		const auto& measure = measures[i];
+	for( const auto &line : layout.mLines ) {
+		const auto& measure = line.mMeasure;
 
 		vec2 baseline = measure.getBaseline();
 		float penX = baseline.x + offset.x;
@@ -1209,15 +1365,18 @@ Surface TextBox::render( vec2 offset )
 
 		FT_Vector pen = { (int)(penX*64.0f), (int)(penY*64.0f) };
 
-		std::u32string utf32Chars = ci::toUtf32( text );		
-		for( const auto& ch : utf32Chars ) {
+		// a hard break leaves its newline as the line's last glyph, which is advanced over but not drawn
+		size_t numDrawn = line.mGlyphs.size();
+		if( ( line.mEnd > line.mBegin ) && ( '\n' == layout.mText[line.mEnd - 1] ) && ( numDrawn > 0 ) )
+			--numDrawn;
+
+		for( size_t i = 0; i < line.mGlyphs.size(); ++i ) {
 			FT_Set_Transform( face, nullptr, &pen );
 
-			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
+			FT_Load_Glyph( face, line.mGlyphs[i], FT_LOAD_RENDER );
 			const FT_GlyphSlot& slot = face->glyph;
 
-			if( '\n' != (char)ch ) {
+			if( i < numDrawn ) {
 				ivec2 drawOffset = ivec2( slot->bitmap_left, dstSize.y - slot->bitmap_top );
 				ci::linux::ftutil::DrawBitmap( drawOffset, &(slot->bitmap), mColor, dstData, dstPixelInc, dstRowBytes, dstSize );
 			}
@@ -1228,6 +1387,7 @@ Surface TextBox::render( vec2 offset )
 
 		curY += measure.getHeight();
 	}
+	FT_Set_Transform( face, nullptr, nullptr );
 
 	if( ! mPremultiplied ) {
 		ip::unpremultiply( &result );
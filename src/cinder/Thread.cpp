@@ -0,0 +1,202 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// A single parallelFor() invocation. Threads claim chunks by incrementing mNextChunk, so the submitting
+// thread can always finish the job by itself even if every worker is busy (which also makes nesting safe).
+class ParallelJob {
+  public:
+	ParallelJob( size_t begin, size_t end, size_t chunkSize, const function<void( size_t, size_t )> &fn )
+		: mBegin( begin ), mEnd( end ), mChunkSize( chunkSize ), mFn( &fn ), mNextChunk( 0 ), mChunksCompleted( 0 ), mFailed( false )
+	{
+		mNumChunks = ( end - begin + chunkSize - 1 ) / chunkSize;
+	}
+
+	// Runs chunks until none remain unclaimed.
+	void run()
+	{
+		size_t chunk;
+		while( ( chunk = mNextChunk++ ) < mNumChunks ) {
+			size_t rangeBegin = mBegin + chunk * mChunkSize;
+			size_t rangeEnd = std::min( mEnd, rangeBegin + mChunkSize );
+			try {
+				if( ! mFailed )
+					(*mFn)( rangeBegin, rangeEnd );
+			}
+			catch( ... ) {
+				lock_guard<mutex> lock( mMutex );
+				if( ! mException )
+					mException = current_exception();
+				mFailed = true;
+			}
+
+			if( ++mChunksCompleted == mNumChunks ) {
+				lock_guard<mutex> lock( mMutex );
+				mCompletedCond.notify_all();
+			}
+		}
+	}
+
+	bool isExhausted() const	{ return mNextChunk >= mNumChunks; }
+
+	// Blocks until every chunk has completed, including those claimed by other threads.
+	void wait()
+	{
+		unique_lock<mutex> lock( mMutex );
+		mCompletedCond.wait( lock, [this] { return mChunksCompleted >= mNumChunks; } );
+		if( mException )
+			rethrow_exception( mException );
+	}
+
+  private:
+	size_t								mBegin, mEnd, mChunkSize, mNumChunks;
+	const function<void( size_t, size_t )>	*mFn;
+	atomic<size_t>						mNextChunk, mChunksCompleted;
+	atomic<bool>						mFailed;
+	exception_ptr						mException;
+	mutex								mMutex;
+	condition_variable					mCompletedCond;
+};
+
+class WorkerPool {
+  public:
+	static WorkerPool* instance()
+	{
+		static WorkerPool sInstance;
+		return &sInstance;
+	}
+
+	WorkerPool()
+		: mQuit( false )
+	{
+		size_t numThreads = std::max<size_t>( 1, thread::hardware_concurrency() );
+		for( size_t i = 1; i < numThreads; ++i )
+			mWorkers.emplace_back( &WorkerPool::workerEntry, this );
+	}
+
+	~WorkerPool()
+	{
+		{
+			lock_guard<mutex> lock( mMutex );
+			mQuit = true;
+		}
+		mCond.notify_all();
+		for( auto &worker : mWorkers )
+			worker.join();
+	}
+
+	size_t getNumWorkers() const	{ return mWorkers.size(); }
+
+	void submit( const shared_ptr<ParallelJob> &job )
+	{
+		{
+			lock_guard<mutex> lock( mMutex );
+			mJobs.push_back( job );
+		}
+		mCond.notify_all();
+	}
+
+	void retire( const shared_ptr<ParallelJob> &job )
+	{
+		lock_guard<mutex> lock( mMutex );
+		auto it = find( mJobs.begin(), mJobs.end(), job );
+		if( it != mJobs.end() )
+			mJobs.erase( it );
+	}
+
+  private:
+	void workerEntry()
+	{
+		ThreadSetup threadSetup;
+		while( true ) {
+			shared_ptr<ParallelJob> job;
+			{
+				unique_lock<mutex> lock( mMutex );
+				mCond.wait( lock, [this] { return mQuit || ! mJobs.empty(); } );
+				if( mQuit )
+					return;
+
+				job = mJobs.front();
+				if( job->isExhausted() ) {
+					mJobs.pop_front();
+					continue;
+				}
+			}
+
+			job->run();
+			retire( job );
+		}
+	}
+
+	vector<thread>					mWorkers;
+	deque<shared_ptr<ParallelJob>>	mJobs;
+	mutex							mMutex;
+	condition_variable				mCond;
+	bool							mQuit;
+};
+
+} // anonymous namespace
+
+void parallelFor( size_t begin, size_t end, size_t grainSize, const function<void( size_t, size_t )> &fn )
+{
+	if( end <= begin )
+		return;
+
+	grainSize = std::max<size_t>( 1, grainSize );
+	const size_t count = end - begin;
+	auto pool = WorkerPool::instance();
+	if( count < grainSize * 2 || pool->getNumWorkers() == 0 ) {
+		fn( begin, end );
+		return;
+	}
+
+	// split into roughly 4 chunks per thread so that uneven workloads still balance, but never below grainSize
+	const size_t numThreads = pool->getNumWorkers() + 1;
+	const size_t chunkSize = std::max( grainSize, ( count + numThreads * 4 - 1 ) / ( numThreads * 4 ) );
+
+	auto job = make_shared<ParallelJob>( begin, end, chunkSize, fn );
+	pool->submit( job );
+	job->run();
+	pool->retire( job );
+	job->wait();
+}
+
+size_t getNumParallelThreads()
+{
+	return WorkerPool::instance()->getNumWorkers() + 1;
+}
+
+} // namespace cinder
@@ -23,30 +23,209 @@
 */
 
 #include "cinder/Timeline.h"
+#include "cinder/Color.h"
 
 #include <algorithm>
+#include <typeinfo>
 #include <vector>
 
 using namespace std;
 
 namespace cinder {
 
+////////////////////////////////////////////////////////////////////////////////////////
+// Timeline::TweenBatch
+class Timeline::TweenBatchBase {
+  public:
+	virtual ~TweenBatchBase() {}
+
+	//! Adds \a item if it is exactly a Tween of the batch's type which uses the default lerp function and no update function. Returns whether it was added.
+	virtual bool	add( const TimelineItemRef &item, uint8_t batch ) = 0;
+	//! Removes the item at \a index of \a group, moving the group's last item into its place.
+	virtual void	remove( uint8_t group, uint32_t index ) = 0;
+	//! Updates every tween to \a time, first removing into \a unbatched those which need stepping individually.
+	virtual void	step( float time, std::vector<TimelineItemRef> *unbatched ) = 0;
+	virtual const TimelineItemRef&	getItem( uint8_t group, uint32_t index ) const = 0;
+	//! Returns any item of the batch, or \c nullptr when it is empty.
+	virtual TimelineItem*			getAnyItem() const = 0;
+};
+
+// Tweens are grouped by easing function, so that stateless easing functions are evaluated over a whole group at once
+template<typename T>
+class Timeline::TweenBatch : public Timeline::TweenBatchBase {
+  public:
+	bool add( const TimelineItemRef &item, uint8_t batch ) override
+	{
+		if( typeid( *item ) != typeid( Tween<T> ) )
+			return false;
+
+		const Tween<T> *tween = static_cast<const Tween<T>*>( item.get() );
+		typedef T (*LerpFnPtr)( const T&, const T&, float );
+		const LerpFnPtr *lerpFn = tween->mLerpFunction.template target<LerpFnPtr>();
+		if( ( ! lerpFn ) || ( *lerpFn != &tweenLerp<T> ) || tween->mUpdateFunction || ( ! tween->mEaseFunction ) )
+			return false;
+
+		// tweens with other easing functions share the group without an EaseBatchFn and are eased individually
+		const EaseBatchFn easeBatchFn = findEaseBatchFn( tween->mEaseFunction );
+		size_t g = 0;
+		while( g < mGroups.size() && mGroups[g].mEaseBatchFn != easeBatchFn )
+			++g;
+		if( g == mGroups.size() ) {
+			mGroups.emplace_back();
+			mGroups.back().mEaseBatchFn = easeBatchFn;
+		}
+
+		Group &group = mGroups[g];
+		item->mSchedule.mBatch = batch;
+		item->mSchedule.mBatchGroup = (uint8_t)g;
+		item->mSchedule.mBatchIndex = (uint32_t)group.mItems.size();
+		group.mItems.push_back( item );
+		group.mTargets.push_back( tween->getTarget() );
+		group.mStartValues.push_back( tween->mStartValue );
+		group.mEndValues.push_back( tween->mEndValue );
+		group.mStartTimes.push_back( item->mStartTime );
+		group.mEndTimes.push_back( item->mStartTime + item->mDuration );
+		group.mInvDurations.push_back( item->mInvDuration );
+		if( ! easeBatchFn )
+			group.mEaseFns.push_back( tween->mEaseFunction );
+		return true;
+	}
+
+	void remove( uint8_t g, uint32_t index ) override
+	{
+		Group &group = mGroups[g];
+		const uint32_t last = (uint32_t)group.mItems.size() - 1;
+		if( index != last ) {
+			group.mItems[index] = std::move( group.mItems[last] );
+			group.mItems[index]->mSchedule.mBatchIndex = index;
+			group.mTargets[index] = group.mTargets[last];
+			group.mStartValues[index] = group.mStartValues[last];
+			group.mEndValues[index] = group.mEndValues[last];
+			group.mStartTimes[index] = group.mStartTimes[last];
+			group.mEndTimes[index] = group.mEndTimes[last];
+			group.mInvDurations[index] = group.mInvDurations[last];
+			if( ! group.mEaseBatchFn )
+				group.mEaseFns[index] = std::move( group.mEaseFns[last] );
+		}
+
+		group.mItems.pop_back();
+		group.mTargets.pop_back();
+		group.mStartValues.pop_back();
+		group.mEndValues.pop_back();
+		group.mStartTimes.pop_back();
+		group.mEndTimes.pop_back();
+		group.mInvDurations.pop_back();
+		if( ! group.mEaseBatchFn )
+			group.mEaseFns.pop_back();
+	}
+
+	void step( float time, std::vector<TimelineItemRef> *unbatched ) override
+	{
+		for( size_t g = 0; g < mGroups.size(); ++g ) {
+			Group &group = mGroups[g];
+			// completion and anything before the start is left to TimelineItem::stepTo()
+			for( uint32_t i = 0; i < (uint32_t)group.mItems.size(); ) {
+				if( time < group.mStartTimes[i] || time >= group.mEndTimes[i] ) {
+					unbatched->push_back( group.mItems[i] );
+					remove( (uint8_t)g, i );
+				}
+				else
+					++i;
+			}
+
+			// matches TimelineItem::stepTo() and Tween::update(), one pass at a time so that each pass is a simple loop
+			const size_t count = group.mItems.size();
+			mTimes.resize( count );
+			float *times = mTimes.data();
+			const float *startTimes = group.mStartTimes.data(), *invDurations = group.mInvDurations.data();
+			for( size_t i = 0; i < count; ++i )
+				times[i] = std::min( ( time - startTimes[i] ) * invDurations[i], 1.0f );
+
+			if( group.mEaseBatchFn )
+				group.mEaseBatchFn( times, times, count );
+			else {
+				for( size_t i = 0; i < count; ++i )
+					times[i] = group.mEaseFns[i]( times[i] );
+			}
+
+			for( size_t i = 0; i < count; ++i )
+				*group.mTargets[i] = tweenLerp<T>( group.mStartValues[i], group.mEndValues[i], times[i] );
+		}
+	}
+
+	const TimelineItemRef& getItem( uint8_t group, uint32_t index ) const override
+	{
+		return mGroups[group].mItems[index];
+	}
+
+	TimelineItem* getAnyItem() const override
+	{
+		for( const auto &group : mGroups ) {
+			if( ! group.mItems.empty() )
+				return group.mItems.back().get();
+		}
+		return nullptr;
+	}
+
+  private:
+	struct Group {
+		EaseBatchFn						mEaseBatchFn; // nullptr when each tween calls its own EaseFn
+		std::vector<TimelineItemRef>	mItems;
+		std::vector<T*>					mTargets;
+		std::vector<T>					mStartValues, mEndValues;
+		std::vector<float>				mStartTimes, mEndTimes, mInvDurations;
+		std::vector<EaseFn>				mEaseFns; // only without mEaseBatchFn
+	};
+
+	std::vector<Group>	mGroups;
+	std::vector<float>	mTimes; // scratch space for step()
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Timeline
 typedef std::multimap<void*,TimelineItemRef>::iterator s_iter;
 typedef std::multimap<void*,TimelineItemRef>::const_iterator s_const_iter;
 
+namespace {
+
+// orders active items the way mItems does: by target, then by order of insertion
+template<typename T>
+bool activeItemLess( const T &a, const T &b )
+{
+	if( a.mTarget != b.mTarget )
+		return std::less<void*>()( a.mTarget, b.mTarget );
+	return a.mSequence < b.mSequence;
+}
+
+// inverted to make std::push_heap() and friends maintain a min-heap
+template<typename T>
+bool pendingItemGreater( const T &a, const T &b )
+{
+	return a.mStartTime > b.mStartTime;
+}
+
+} // anonymous namespace
+
 Timeline::Timeline()
-	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 )
+	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 ), mNumPending( 0 ), mNextSequence( 0 )
 {
 	mUseAbsoluteTime = true;
 }
 
 Timeline::Timeline( const Timeline &rhs )
-	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime )
+	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime ), mNumPending( 0 ), mNextSequence( 0 )
 {
 	for( s_const_iter iter = rhs.mItems.begin(); iter != rhs.mItems.end(); ++iter ) {
-		mItems.insert( make_pair( iter->first, iter->second->clone() ) );
+		insertItem( iter->second->clone() );
+	}
+}
+
+Timeline::~Timeline()
+{
+	// items may outlive the Timeline, and must no longer report changes to it
+	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
+		if( iter->second->mParent == this )
+			iter->second->mParent = nullptr;
 	}
 }
 
@@ -62,7 +241,86 @@ void Timeline::stepTo( float absoluteTime )
 	mCurrentTime = absoluteTime;
 	
 	eraseMarked();
+
+	// Items only do anything before their start time when time runs backwards, so stepping forward is limited to
+	// the items which have started. Stepping backwards visits everything, after which the items are rescheduled.
+	if( reverse ) {
+		stepAll( true );
+		scheduleAll();
+	}
+	else
+		stepActive();
 	
+	eraseMarked();
+
+	mActiveItems.erase( std::remove_if( mActiveItems.begin(), mActiveItems.end(), [this]( const ActiveItem &active ) { return ! isValid( active ); } ), mActiveItems.end() );
+}
+
+void Timeline::stepActive()
+{
+	while( ( ! mPendingItems.empty() ) && mPendingItems.front().mStartTime <= mCurrentTime ) {
+		std::pop_heap( mPendingItems.begin(), mPendingItems.end(), pendingItemGreater<PendingItem> );
+		PendingItem pending = std::move( mPendingItems.back() );
+		mPendingItems.pop_back();
+		if( isValid( pending ) ) {
+			setScheduleState( pending.mItem.get(), Schedule::ACTIVE );
+			mStartedItems.push_back( ActiveItem{ pending.mItem->mTarget, pending.mItem->mSchedule.mSequence, std::move( pending.mItem ) } );
+		}
+	}
+
+	// Batched tweens have no other item sharing their target, so updating them first leaves each target's updates in order
+	vector<TimelineItemRef> unbatched;
+	for( size_t b = 0; b < mTweenBatches.size(); ++b )
+		mTweenBatches[b]->step( mCurrentTime, &unbatched );
+	for( vector<TimelineItemRef>::iterator itemIt = unbatched.begin(); itemIt != unbatched.end(); ++itemIt ) {
+		(*itemIt)->mSchedule.mState = Schedule::ACTIVE;
+		mStartedItems.push_back( ActiveItem{ (*itemIt)->mTarget, (*itemIt)->mSchedule.mSequence, std::move( *itemIt ) } );
+	}
+	mergeStartedItems( mActiveItems.size() );
+
+	// Items added while stepping which have already started are stepped after the others, as are any they add in turn.
+	// mActiveItems keeps every item alive until the stale entries are erased after stepping.
+	const size_t numSorted = mActiveItems.size();
+	for( size_t i = 0; i < mActiveItems.size() || ( ! mStartedItems.empty() ); ++i ) {
+		if( i == mActiveItems.size() ) {
+			std::sort( mStartedItems.begin(), mStartedItems.end(), activeItemLess<ActiveItem> );
+			mActiveItems.insert( mActiveItems.end(), std::make_move_iterator( mStartedItems.begin() ), std::make_move_iterator( mStartedItems.end() ) );
+			mStartedItems.clear();
+		}
+
+		if( ! isValid( mActiveItems[i] ) )
+			continue;
+		TimelineItem *item = mActiveItems[i].mItem.get();
+		if( item->mStartTime > mCurrentTime ) {
+			// the item's start time was moved past the current time after it started
+			setScheduleState( item, Schedule::PENDING );
+			pushPending( mActiveItems[i].mItem );
+			continue;
+		}
+
+		item->stepTo( mCurrentTime, false );
+		if( item->isComplete() && item->getAutoRemove() )
+			markForRemoval( item );
+		else if( item->mSchedule.mCheckBatchable )
+			tryBatching( mActiveItems[i].mItem );
+	}
+	mergeStartedItems( numSorted );
+}
+
+// sorts mStartedItems together with the unsorted tail of mActiveItems which begins at 'numSorted', and merges them with the rest
+void Timeline::mergeStartedItems( size_t numSorted )
+{
+	if( mStartedItems.empty() && numSorted == mActiveItems.size() )
+		return;
+
+	mActiveItems.insert( mActiveItems.end(), std::make_move_iterator( mStartedItems.begin() ), std::make_move_iterator( mStartedItems.end() ) );
+	mStartedItems.clear();
+	std::sort( mActiveItems.begin() + numSorted, mActiveItems.end(), activeItemLess<ActiveItem> );
+	std::inplace_merge( mActiveItems.begin(), mActiveItems.begin() + numSorted, mActiveItems.end(), activeItemLess<ActiveItem> );
+}
+
+void Timeline::stepAll( bool reverse )
+{
 	// we need to cache the end(). If a tween's update() fn or similar were to manipulate
 	// the list of items by adding new ones, we'll have invalidated our iterator.
 	// Deleted items are never removed immediately, but are marked for deletion.
@@ -70,10 +328,48 @@ void Timeline::stepTo( float absoluteTime )
 	for( s_iter iter = mItems.begin(); iter != endItem; ++iter ) {
 		iter->second->stepTo( mCurrentTime, reverse );
 		if( iter->second->isComplete() && iter->second->getAutoRemove() )
-			iter->second->mMarkedForRemoval = true;
+			markForRemoval( iter->second.get() );
+	}
+}
+
+void Timeline::tryBatching( const TimelineItemRef &item )
+{
+	item->mSchedule.mCheckBatchable = false;
+	if( ( ! item->mHasStarted ) || item->mComplete || item->mMarkedForRemoval || item->mLoop || item->mPingPong || item->mUseAbsoluteTime
+		|| item->mDirtyDuration || item->mInvDuration <= 0 || ( ! item->mTarget ) || mItems.count( item->mTarget ) != 1 )
+		return;
+
+	if( mTweenBatches.empty() ) {
+		mTweenBatches.emplace_back( new TweenBatch<float> );
+		mTweenBatches.emplace_back( new TweenBatch<vec2> );
+		mTweenBatches.emplace_back( new TweenBatch<vec3> );
+		mTweenBatches.emplace_back( new TweenBatch<vec4> );
+		mTweenBatches.emplace_back( new TweenBatch<Color> );
+		mTweenBatches.emplace_back( new TweenBatch<ColorA> );
+	}
+
+	for( size_t b = 0; b < mTweenBatches.size(); ++b ) {
+		if( mTweenBatches[b]->add( item, (uint8_t)b ) ) {
+			item->mSchedule.mState = Schedule::BATCHED;
+			return;
+		}
+	}
+}
+
+// returns a batched item to being stepped individually
+void Timeline::unbatch( TimelineItem *item )
+{
+	TimelineItemRef itemRef = mTweenBatches[item->mSchedule.mBatch]->getItem( item->mSchedule.mBatchGroup, item->mSchedule.mBatchIndex );
+	setScheduleState( item, Schedule::ACTIVE );
+	mStartedItems.push_back( ActiveItem{ item->mTarget, item->mSchedule.mSequence, itemRef } );
+}
+
+void Timeline::unbatchAll()
+{
+	for( size_t b = 0; b < mTweenBatches.size(); ++b ) {
+		while( TimelineItem *item = mTweenBatches[b]->getAnyItem() )
+			unbatch( item );
 	}
-	
-	eraseMarked();	
 }
 
 CueRef Timeline::add( const std::function<void ()> &action, float atTime )
@@ -86,6 +382,19 @@ CueRef Timeline::add( const std::function<void ()> &action, float atTime )
 
 void Timeline::clear()
 {
+	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
+		// items may outlive the Timeline, and must no longer report changes to it
+		if( iter->second->mParent == this ) {
+			iter->second->mSchedule.mState = Schedule::UNSCHEDULED;
+			iter->second->mParent = nullptr;
+		}
+	}
+	mActiveItems.clear();
+	mStartedItems.clear();
+	mPendingItems.clear();
+	mNumPending = 0;
+	mMarkedItems.clear();
+	mTweenBatches.clear();
 	mItems.clear();	
 }
 
@@ -101,7 +410,7 @@ void Timeline::appendPingPong()
 	}
 	
 	for( vector<TimelineItemRef>::const_iterator appIt = toAppend.begin(); appIt != toAppend.end(); ++appIt ) {
-		mItems.insert( make_pair( (*appIt)->mTarget, *appIt ) );
+		insertItem( *appIt );
 	}
 	
 	setDurationDirty();
@@ -116,37 +425,157 @@ void Timeline::apply( TimelineItemRef item )
 
 void Timeline::add( TimelineItemRef item )
 {
-	item->mParent = this;
 	item->mStartTime = mCurrentTime;
-	mItems.insert( make_pair( item->mTarget, item ) );
+	insertItem( item );
 	setDurationDirty();
 }
 
 void Timeline::insert( TimelineItemRef item )
 {
-	item->mParent = this;
-	mItems.insert( make_pair( item->mTarget, item ) );
+	insertItem( item );
 	setDurationDirty();
 }
 
+void Timeline::insertItem( const TimelineItemRef &item )
+{
+	// an item moved from another Timeline is left in its care there
+	if( item->mParent != this )
+		item->mSchedule = Schedule();
+
+	item->mParent = this;
+	item->mSchedule.mSequence = mNextSequence++;
+	s_iter inserted = mItems.insert( make_pair( item->mTarget, item ) );
+	schedule( item );
+
+	// a batched tween sharing the new item's target must be stepped in order with it; the multimap places them just before it
+	for( s_iter iter = inserted; item->mTarget && iter != mItems.begin(); ) {
+		--iter;
+		if( iter->first != item->mTarget )
+			break;
+		if( iter->second->mParent == this && iter->second->mSchedule.mState == Schedule::BATCHED )
+			unbatch( iter->second.get() );
+	}
+	if( item->mMarkedForRemoval )
+		itemMarkedForRemoval( item.get() );
+}
+
+void Timeline::eraseItem( s_iter iter )
+{
+	TimelineItem *item = iter->second.get();
+	if( item->mParent == this ) {
+		setScheduleState( item, Schedule::UNSCHEDULED );
+		item->mParent = nullptr;
+	}
+	mItems.erase( iter );
+}
+
+void Timeline::markForRemoval( TimelineItem *item )
+{
+	if( ! item->mMarkedForRemoval ) {
+		item->mMarkedForRemoval = true;
+		itemMarkedForRemoval( item );
+	}
+}
+
+void Timeline::itemChanged( TimelineItem *item )
+{
+	if( item->mParent != this )
+		return;
+
+	if( item->mSchedule.mState == Schedule::BATCHED )
+		unbatch( item );
+	item->mSchedule.mCheckBatchable = true;
+}
+
+// the caller must hold a reference to 'item' when it leaves a batch
+void Timeline::setScheduleState( TimelineItem *item, Schedule::State state )
+{
+	if( item->mSchedule.mState == Schedule::PENDING )
+		--mNumPending;
+	else if( item->mSchedule.mState == Schedule::BATCHED )
+		mTweenBatches[item->mSchedule.mBatch]->remove( item->mSchedule.mBatchGroup, item->mSchedule.mBatchIndex );
+
+	if( state == Schedule::PENDING )
+		++mNumPending;
+	item->mSchedule.mState = state;
+}
+
+void Timeline::schedule( const TimelineItemRef &item )
+{
+	item->mSchedule.mCheckBatchable = true;
+	if( item->mStartTime > mCurrentTime ) {
+		setScheduleState( item.get(), Schedule::PENDING );
+		pushPending( item );
+	}
+	else {
+		setScheduleState( item.get(), Schedule::ACTIVE );
+		mStartedItems.push_back( ActiveItem{ item->mTarget, item->mSchedule.mSequence, item } );
+	}
+}
+
+void Timeline::scheduleAll()
+{
+	mActiveItems.clear();
+	mStartedItems.clear();
+	mPendingItems.clear();
+	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
+		if( iter->second->mParent == this )
+			schedule( iter->second );
+	}
+}
+
+void Timeline::pushPending( const TimelineItemRef &item )
+{
+	// discard the entries of rescheduled items once they outnumber the valid ones
+	if( mPendingItems.size() >= 64 && mPendingItems.size() >= mNumPending * 2 ) {
+		mPendingItems.erase( std::remove_if( mPendingItems.begin(), mPendingItems.end(), [this]( const PendingItem &pending ) { return ! isValid( pending ); } ), mPendingItems.end() );
+		std::make_heap( mPendingItems.begin(), mPendingItems.end(), pendingItemGreater<PendingItem> );
+	}
+
+	mPendingItems.push_back( PendingItem{ item->mStartTime, item->mSchedule.mSequence, item } );
+	std::push_heap( mPendingItems.begin(), mPendingItems.end(), pendingItemGreater<PendingItem> );
+}
+
+bool Timeline::isValid( const ActiveItem &active ) const
+{
+	const TimelineItem *item = active.mItem.get();
+	return item->mParent == this && item->mSchedule.mState == Schedule::ACTIVE && item->mSchedule.mSequence == active.mSequence;
+}
+
+bool Timeline::isValid( const PendingItem &pending ) const
+{
+	const TimelineItem *item = pending.mItem.get();
+	return item->mParent == this && item->mSchedule.mState == Schedule::PENDING && item->mSchedule.mSequence == pending.mSequence
+		&& item->mStartTime == pending.mStartTime;
+}
+
 // remove all items which have been marked for removal
 void Timeline::eraseMarked()
 {
+	if( mMarkedItems.empty() )
+		return;
+
+	// erasing an item may destroy it, and its destructor mark more items
+	vector<pair<void*,TimelineItem*>> marked;
+	marked.swap( mMarkedItems );
+
 	bool needRecalc = false;
-	for( s_iter iter = mItems.begin(); iter != mItems.end(); ) {
-		if( iter->second->mMarkedForRemoval ) {
-			mItems.erase( iter++ );
-			needRecalc = true;
+	for( vector<pair<void*,TimelineItem*>>::const_iterator markedIt = marked.begin(); markedIt != marked.end(); ++markedIt ) {
+		pair<s_iter,s_iter> range = mItems.equal_range( markedIt->first );
+		for( s_iter iter = range.first; iter != range.second; ) {
+			if( iter->second.get() == markedIt->second && iter->second->mMarkedForRemoval ) {
+				eraseItem( iter++ );
+				needRecalc = true;
+			}
+			else
+				++iter;
 		}
-		else
-			++iter;
 	}
 	
 	if( needRecalc )
 		setDurationDirty();
 }	
 
-
 float Timeline::calcDuration() const
 {
 	float duration = 0;
@@ -232,9 +661,10 @@ float Timeline::findEndTimeOf( void *target, bool *found ) const
 
 void Timeline::remove( TimelineItemRef item )
 {
-	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
+	pair<s_iter,s_iter> range = mItems.equal_range( item->mTarget );
+	for( s_iter iter = range.first; iter != range.second; ++iter ) {
 		if( iter->second == item ) {
-			iter->second->mMarkedForRemoval = true;
+			markForRemoval( item.get() );
 			break;
 		}
 	}
@@ -247,7 +677,7 @@ void Timeline::removeTarget( void *target )
 		
 	pair<s_iter,s_iter> range = mItems.equal_range( target );
 	for( s_iter iter = range.first; iter != range.second; ++iter )
-		iter->second->mMarkedForRemoval = true;
+		markForRemoval( iter->second.get() );
 
 	setDurationDirty();
 }
@@ -267,7 +697,7 @@ void Timeline::cloneAndReplaceTarget( void *target, void *replacementTarget )
 	}
 
 	for( vector<TimelineItemRef>::iterator newItemIt = newItems.begin(); newItemIt != newItems.end(); ++newItemIt )
-		mItems.insert( make_pair( replacementTarget, *newItemIt ) );
+		insertItem( *newItemIt );
 
 	setDurationDirty();
 }
@@ -277,11 +707,16 @@ void Timeline::replaceTarget( void *target, void *replacementTarget )
 	if( target == nullptr )
 		return;
 
-	s_iter iter = mItems.find( target );
-	while( ( iter != mItems.end() ) && ( iter->first == target ) ) {
-		iter->second->setTarget( replacementTarget );
-		mItems.insert( make_pair( replacementTarget, iter->second ) );
-		iter = mItems.erase( iter );
+	pair<s_iter,s_iter> range = mItems.equal_range( target );
+	vector<TimelineItemRef> items;
+	for( s_iter iter = range.first; iter != range.second; ++iter )
+		items.push_back( iter->second );
+	mItems.erase( range.first, range.second );
+
+	// reinserting reschedules each item under its new target
+	for( vector<TimelineItemRef>::iterator itemIt = items.begin(); itemIt != items.end(); ++itemIt ) {
+		(*itemIt)->setTarget( replacementTarget );
+		insertItem( *itemIt );
 	}
 }
 
@@ -301,6 +736,7 @@ void Timeline::loopStart()
 
 void Timeline::reverse()
 {
+	unbatchAll();
 	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter )
 		iter->second->reverse();
 }
@@ -317,6 +753,7 @@ TimelineItemRef Timeline::cloneReverse() const
 		iter->second->reverse();
 		iter->second->mStartTime = mDuration + ( mDuration - ( iter->second->mStartTime + iter->second->mDuration ) );		
 	}
+	result->scheduleAll();
 	return TimelineItemRef( result );
 }
 
@@ -326,12 +763,25 @@ void Timeline::update( float absTime )
 	stepTo( absTime );
 }
 
-void Timeline::itemTimeChanged( TimelineItem * /*item*/ )
+void Timeline::itemTimeChanged( TimelineItem *item )
 {
+	// a pending item gets a new entry in the queue; an active one is moved back if needed when it is next stepped
+	if( item->mParent == this && item->mSchedule.mState == Schedule::PENDING ) {
+		pair<s_iter,s_iter> range = mItems.equal_range( item->mTarget );
+		for( s_iter iter = range.first; iter != range.second; ++iter ) {
+			if( iter->second.get() == item ) {
+				pushPending( iter->second );
+				break;
+			}
+		}
+	}
+	else
+		itemChanged( item );
+
 	setDurationDirty();
 }
 
-////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Cue
 Cue::Cue( const std::function<void ()> &fn, float atTime )
 	: TimelineItem( 0, 0, atTime, 0 ), mFunction( fn )
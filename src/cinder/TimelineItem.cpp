@@ -47,6 +47,8 @@ TimelineItem::TimelineItem( Timeline *parent, void *target, float startTime, flo
 void TimelineItem::removeSelf()
 {
 	mMarkedForRemoval = true;
+	if( mParent )
+		mParent->itemMarkedForRemoval( this );
 }
 
 void TimelineItem::stepTo( float newTime, bool reverse )
@@ -124,6 +126,12 @@ void TimelineItem::stepTo( float newTime, bool reverse )
 	}
 }
 
+void TimelineItem::markChanged()
+{
+	if( mParent )
+		mParent->itemChanged( this );
+}
+
 void TimelineItem::setStartTime( float time )
 {
 	mStartTime = time;
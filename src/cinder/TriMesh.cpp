@@ -26,14 +26,83 @@
 #include "cinder/TriMesh.h"
 #include "cinder/Exception.h"
 #include "cinder/Log.h"
+#include "cinder/Thread.h"
 #if defined( CINDER_ANDROID )
 	#include "cinder/android/CinderAndroid.h"
 #endif 
 
+#include <algorithm>
+#include <array>
+
 using namespace std;
 
 namespace cinder {
 
+namespace {
+
+// Per-vertex and per-triangle work is split across threads in chunks of at least this many elements
+const size_t PARALLEL_GRAIN_SIZE = 8192;
+
+// Returns for each position the lowest index of any position within tolerance of it, following chains of such positions to a single representative
+vector<uint32_t> calcUniquePositions( const vec3 *positions, size_t numPositions, float tolerance )
+{
+	// bucket positions into a grid of tolerance-sized cells, sorted so that each cell's positions are contiguous and in ascending index order
+	typedef std::array<int64_t, 3> Cell;
+	auto calcCell = [tolerance]( const vec3 &p ) {
+		return Cell{ { int64_t( floor( p.x / tolerance ) ), int64_t( floor( p.y / tolerance ) ), int64_t( floor( p.z / tolerance ) ) } };
+	};
+	vector<pair<Cell, uint32_t>> cells( numPositions );
+	parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			cells[i] = make_pair( calcCell( positions[i] ), uint32_t( i ) );
+	} );
+	sort( cells.begin(), cells.end() );
+
+	// the three neighboring cells along z are contiguous in the sorted order, and the start of each of the 9 neighboring columns
+	// only ever moves forward as the sorted cells are visited, so each column is tracked by a cursor rather than searched for
+	const float tolerance2 = tolerance * tolerance;
+	vector<uint32_t> lowest( numPositions );
+	parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		const auto columnStart = []( const Cell &cell, int column ) { return Cell{ { cell[0] + column / 3 - 1, cell[1] + column % 3 - 1, cell[2] - 1 } }; };
+		array<size_t, 9> cursors;
+		for( int c = 0; c < 9; ++c )
+			cursors[c] = lower_bound( cells.begin(), cells.end(), make_pair( columnStart( cells[begin].first, c ), uint32_t( 0 ) ) ) - cells.begin();
+
+		for( size_t j = begin; j < end; ++j ) {
+			const Cell &cell = cells[j].first;
+			const uint32_t i = cells[j].second;
+			uint32_t result = i;
+			for( int c = 0; c < 9; ++c ) {
+				const Cell first = columnStart( cell, c );
+				const Cell last = { { first[0], first[1], cell[2] + 1 } };
+				size_t &cursor = cursors[c];
+				while( cursor < numPositions && cells[cursor].first < first )
+					++cursor;
+				for( size_t k = cursor; k < numPositions && cells[k].first <= last; ++k ) {
+					const uint32_t other = cells[k].second;
+					if( other < result && length2( positions[other] - positions[i] ) < tolerance2 )
+						result = other;
+				}
+			}
+			lowest[i] = result;
+		}
+	} );
+
+	vector<uint32_t> result( numPositions );
+	parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			uint32_t r = uint32_t( i );
+			while( lowest[r] != r )
+				r = lowest[r];
+			result[i] = r;
+		}
+	} );
+
+	return result;
+}
+
+} // anonymous namespace
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // TriMeshGeomTarget
 class TriMeshGeomTarget : public geom::Target {
@@ -695,83 +764,197 @@ void TriMesh::readImplV1( const IStreamRef &in )
 }
 
 bool TriMesh::recalculateNormals( bool smooth, bool weighted )
+{
+	return recalculateNormalsImpl( weighted ? NormalWeighting::AREA : NormalWeighting::EQUAL, smooth, -1 );
+}
+
+bool TriMesh::recalculateNormals( NormalWeighting weighting, float creaseAngle )
+{
+	return recalculateNormalsImpl( weighting, true, std::max( creaseAngle, 0.0f ) );
+}
+
+bool TriMesh::recalculateNormalsImpl( NormalWeighting weighting, bool smooth, float creaseAngle )
 {
 	// requires valid indices and 3D vertices
 	if( mIndices.empty() || mPositions.empty() || mPositionsDims != 3 )
 		return false;
 
-	size_t numPositions = mPositions.size() / 3;
-	mNormals.assign( numPositions, vec3() );
+	const size_t numPositions = mPositions.size() / 3;
+	const size_t numTriangles = getNumTriangles();
+	const vec3 *positions = reinterpret_cast<const vec3*>( mPositions.data() );
 
-	// for smooth renormalization, we first find all unique vertices and keep track of them
+	// for smooth renormalization, every vertex is represented by the lowest vertex within FLT_EPSILON squared distance of it
 	std::vector<uint32_t> uniquePositions;
-	if( smooth ) {
-		uniquePositions.assign( numPositions, 0 );
-
-		for( uint32_t i = 0; i < numPositions; ++i ) {
-			if( uniquePositions[i] == 0 ) {
-				uniquePositions[i] = i + 1;
-				const vec3 &v0 = *(const vec3*)(&mPositions[i * 3]);
-				for( size_t j = i + 1; j < numPositions; ++j ) {
-					const vec3 &v1 = *(const vec3*)(&mPositions[j * 3]);
-					if( length2( v1 - v0 ) < FLT_EPSILON )
-						uniquePositions[j] = uniquePositions[i];
-				}
+	if( smooth )
+		uniquePositions = calcUniquePositions( positions, numPositions, sqrt( FLT_EPSILON ) );
+
+	// unit face normals and interior angles; degenerate triangles are left at zero so that they never contribute
+	std::vector<vec3> faceNormals( numTriangles );
+	std::vector<float> faceAreas( numTriangles );
+	std::vector<vec3> faceAngles( weighting == NormalWeighting::ANGLE ? numTriangles : 0 );
+	parallelFor( 0, numTriangles, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			const vec3 &v0 = positions[mIndices[i * 3 + 0]];
+			const vec3 &v1 = positions[mIndices[i * 3 + 1]];
+			const vec3 &v2 = positions[mIndices[i * 3 + 2]];
+
+			vec3 e0 = v1 - v0;
+			vec3 e1 = v2 - v0;
+			vec3 e2 = v2 - v1;
+
+			faceNormals[i] = vec3( 0 );
+			faceAreas[i] = 0;
+			if( length2( e0 ) < FLT_EPSILON || length2( e1 ) < FLT_EPSILON || length2( e2 ) < FLT_EPSILON )
+				continue;
+
+			vec3 normal = cross( e0, e1 );
+			float len = length( normal );
+			if( len > 0 ) {
+				faceNormals[i] = normal / len;
+				faceAreas[i] = len * 0.5f;
 			}
-		}
-	}
 
-	// perform surface normalization
-	uint32_t index0, index1, index2;
-	size_t numTriangles = getNumTriangles();
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		if( smooth ) {
-			index0 = uniquePositions[mIndices[i * 3 + 0]] - 1;
-			index1 = uniquePositions[mIndices[i * 3 + 1]] - 1;
-			index2 = uniquePositions[mIndices[i * 3 + 2]] - 1;
-		}
-		else {
-			index0 = mIndices[i*3+0];
-			index1 = mIndices[i*3+1];
-			index2 = mIndices[i*3+2];
+			if( ! faceAngles.empty() ) {
+				auto angle = []( const vec3 &a, const vec3 &b ) { return acos( glm::clamp( dot( a, b ) / sqrt( length2( a ) * length2( b ) ), -1.0f, 1.0f ) ); };
+				faceAngles[i].x = angle( e0, e1 );
+				faceAngles[i].y = angle( -e0, e2 );
+				faceAngles[i].z = float( M_PI ) - faceAngles[i].x - faceAngles[i].y;
+			}
 		}
+	} );
 
-		const vec3 &v0 = *(const vec3*)(&mPositions[index0 * 3]);
-		const vec3 &v1 = *(const vec3*)(&mPositions[index1 * 3]);
-		const vec3 &v2 = *(const vec3*)(&mPositions[index2 * 3]);
-
-		vec3 e0 = v1 - v0;
-		vec3 e1 = v2 - v0;
-		vec3 e2 = v2 - v1;
-
-		if( length2( e0 ) < FLT_EPSILON )
-			continue;
-		if( length2( e1 ) < FLT_EPSILON )
-			continue;
-		if( length2( e2 ) < FLT_EPSILON )
-			continue;
-
-		vec3 normal = cross( e0, e1 );
-
-		// if not weighted, every normal has an equal contribution
-		if( ! weighted )
-			normal = normalize( normal );
-
-		mNormals[ index0 ] += normal;
-		mNormals[ index1 ] += normal;
-		mNormals[ index2 ] += normal;
+	// adjacency from each vertex (or unique position) to its triangles
+	std::vector<uint32_t> groupIndices;
+	if( smooth ) {
+		groupIndices.resize( mIndices.size() );
+		parallelFor( 0, mIndices.size(), PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+			for( size_t i = begin; i < end; ++i )
+				groupIndices[i] = uniquePositions[mIndices[i]];
+		} );
 	}
+	const std::vector<uint32_t> &indices = smooth ? groupIndices : mIndices;
+	std::vector<uint32_t> offsets, adjacency;
+	geom::calculateVertexTriangleAdjacency( indices.size(), indices.data(), numPositions, &offsets, &adjacency );
+
+	// the weighted normal that triangle t contributes to its corner at group g
+	auto weightedNormal = [&]( uint32_t t, uint32_t g ) -> vec3 {
+		switch( weighting ) {
+			case NormalWeighting::AREA:
+				return faceNormals[t] * faceAreas[t];
+			case NormalWeighting::ANGLE: {
+				int k = ( indices[t * 3] == g ) ? 0 : ( ( indices[t * 3 + 1] == g ) ? 1 : 2 );
+				return faceNormals[t] * faceAngles[t][k];
+			}
+			default:
+				return faceNormals[t];
+		}
+	};
 
-	// now normalize the summed normals
-	for( auto &normal : mNormals ) {
-		normal = normalize( normal );
+	auto safeNormalize = []( const vec3 &v ) {
+		float len = length( v );
+		return ( len > 0 ) ? v / len : vec3( 0 );
+	};
+
+	if( creaseAngle < 0 ) {
+		// every vertex averages all faces around its group; each vertex writes only its own normal
+		mNormals.resize( numPositions );
+		parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v ) {
+				const uint32_t g = smooth ? uniquePositions[v] : uint32_t( v );
+				vec3 normal( 0 );
+				for( uint32_t a = offsets[g]; a < offsets[g + 1]; ++a ) {
+					if( a == offsets[g] || adjacency[a] != adjacency[a - 1] )
+						normal += weightedNormal( adjacency[a], g );
+				}
+				mNormals[v] = safeNormalize( normal );
+			}
+		} );
 	}
+	else {
+		// each triangle corner averages the faces around its position that lie within the crease angle of its own face
+		const float cosCrease = cos( std::min( creaseAngle, float( M_PI ) ) );
+		std::vector<vec3> cornerNormals( mIndices.size() );
+		parallelFor( 0, numTriangles, PARALLEL_GRAIN_SIZE / 4, [&]( size_t begin, size_t end ) {
+			for( size_t t = begin; t < end; ++t ) {
+				for( int k = 0; k < 3; ++k ) {
+					const uint32_t g = indices[t * 3 + k];
+					vec3 normal( 0 );
+					for( uint32_t a = offsets[g]; a < offsets[g + 1]; ++a ) {
+						const uint32_t s = adjacency[a];
+						if( ( a > offsets[g] && s == adjacency[a - 1] ) )
+							continue;
+						if( s == t || faceAreas[t] == 0 || dot( faceNormals[s], faceNormals[t] ) >= cosCrease )
+							normal += weightedNormal( s, g );
+					}
+					cornerNormals[t * 3 + k] = safeNormalize( normal );
+				}
+			}
+		} );
+
+		// corners of one vertex may have ended up in different smoothing groups; keep the first normal on the vertex and give every other distinct normal a copy of it
+		std::vector<uint32_t> vertexOffsets, vertexTriangles;
+		geom::calculateVertexTriangleAdjacency( mIndices.size(), mIndices.data(), numPositions, &vertexOffsets, &vertexTriangles );
+		auto forEachCorner = [&]( size_t v, const auto &fn ) {
+			for( uint32_t a = vertexOffsets[v]; a < vertexOffsets[v + 1]; ++a ) {
+				const uint32_t t = vertexTriangles[a];
+				if( a > vertexOffsets[v] && t == vertexTriangles[a - 1] )
+					continue;
+				for( int k = 0; k < 3; ++k ) {
+					if( mIndices[t * 3 + k] == v )
+						fn( t * 3 + k );
+				}
+			}
+		};
+		auto sameNormal = []( const vec3 &a, const vec3 &b ) { return length2( a - b ) < 1e-8f; };
+
+		std::vector<uint32_t> numCopies( numPositions + 1, 0 );
+		parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+			std::vector<vec3> distinct;
+			for( size_t v = begin; v < end; ++v ) {
+				distinct.clear();
+				forEachCorner( v, [&]( size_t corner ) {
+					const vec3 &n = cornerNormals[corner];
+					if( std::none_of( distinct.begin(), distinct.end(), [&]( const vec3 &d ) { return sameNormal( d, n ); } ) )
+						distinct.push_back( n );
+				} );
+				numCopies[v + 1] = distinct.empty() ? 0 : uint32_t( distinct.size() - 1 );
+			}
+		} );
+		for( size_t v = 0; v < numPositions; ++v )
+			numCopies[v + 1] += numCopies[v];
+
+		// numCopies now holds the offset of each vertex's first copy
+		const size_t numAdded = numCopies.back();
+		std::vector<uint32_t> sourceVertices( numAdded );
+		std::vector<vec3> copyNormals( numAdded );
+		std::vector<uint32_t> remappedIndices( mIndices );
+		mNormals.resize( numPositions );
+		parallelFor( 0, numPositions, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+			std::vector<vec3> distinct;
+			for( size_t v = begin; v < end; ++v ) {
+				distinct.clear();
+				mNormals[v] = vec3( 0 );
+				forEachCorner( v, [&]( size_t corner ) {
+					const vec3 &n = cornerNormals[corner];
+					auto it = std::find_if( distinct.begin(), distinct.end(), [&]( const vec3 &d ) { return sameNormal( d, n ); } );
+					size_t group = it - distinct.begin();
+					if( it == distinct.end() )
+						distinct.push_back( n );
+					if( group == 0 )
+						mNormals[v] = distinct[0];
+					else {
+						const uint32_t copy = numCopies[v] + uint32_t( group - 1 );
+						sourceVertices[copy] = uint32_t( v );
+						copyNormals[copy] = distinct[group];
+						remappedIndices[corner] = uint32_t( numPositions + copy );
+					}
+				} );
+			}
+		} );
 
-	// copy normals to corresponding non-unique vertices
-	if( smooth ) {
-		for( size_t i = 0; i < numPositions; ++i ) {
-			mNormals[i] = mNormals[uniquePositions[i]-1];
-		}
+		appendVertexCopies( sourceVertices );
+		std::copy( copyNormals.begin(), copyNormals.end(), mNormals.begin() + numPositions );
+		mIndices.swap( remappedIndices );
 	}
 
 	mNormalsDims = 3;
@@ -779,6 +962,30 @@ bool TriMesh::recalculateNormals( bool smooth, bool weighted )
 	return true;
 }
 
+void TriMesh::appendVertexCopies( const std::vector<uint32_t> &sourceVertices )
+{
+	auto append = [&sourceVertices]( auto *buffer, size_t dims ) {
+		if( buffer->empty() || dims == 0 )
+			return;
+		const size_t base = buffer->size();
+		buffer->resize( base + sourceVertices.size() * dims );
+		for( size_t i = 0; i < sourceVertices.size(); ++i )
+			std::copy_n( buffer->begin() + sourceVertices[i] * dims, dims, buffer->begin() + base + i * dims );
+	};
+
+	append( &mPositions, mPositionsDims );
+	append( &mColors, mColorsDims );
+	append( &mTexCoords0, mTexCoords0Dims );
+	append( &mTexCoords1, mTexCoords1Dims );
+	append( &mTexCoords2, mTexCoords2Dims );
+	append( &mTexCoords3, mTexCoords3Dims );
+	append( &mNormals, 1 );
+	append( &mTangents, 1 );
+	append( &mBitangents, 1 );
+	append( &mBoneIndices, 1 );
+	append( &mBoneWeights, 1 );
+}
+
 bool TriMesh::recalculateTangents()
 {
 	// requires valid 2D texture coords and 3D normals
@@ -808,9 +1015,10 @@ bool TriMesh::recalculateBitangents()
 
 	mBitangents.assign( mNormals.size(), vec3() );
 
-	size_t n = getNumVertices();
-	for( size_t i = 0; i < n; ++i )
-		mBitangents[i] = normalize( cross( mNormals[i], mTangents[i] ) );
+	parallelFor( 0, getNumVertices(), PARALLEL_GRAIN_SIZE, [this]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			mBitangents[i] = normalize( cross( mNormals[i], mTangents[i] ) );
+	} );
 
 	mBitangentsDims = 3;
 
@@ -1064,6 +1272,60 @@ void TriMesh::subdivide( int division, bool normalize )
 	}
 }
 
+TriMesh TriMesh::extract( const std::vector<uint32_t> &indices ) const
+{
+	TriMesh result = TriMesh( TriMesh::Format() );
+	result.mPositionsDims = mPositionsDims;
+	result.mNormalsDims = mNormalsDims;
+	result.mTangentsDims = mTangentsDims;
+	result.mBitangentsDims = mBitangentsDims;
+	result.mBoneIndicesDims = mBoneIndicesDims;
+	result.mBoneWeightsDims = mBoneWeightsDims;
+	result.mColorsDims = mColorsDims;
+	result.mTexCoords0Dims = mTexCoords0Dims;
+	result.mTexCoords1Dims = mTexCoords1Dims;
+	result.mTexCoords2Dims = mTexCoords2Dims;
+	result.mTexCoords3Dims = mTexCoords3Dims;
+
+	// renumber referenced vertices in order of first use
+	const size_t numVertices = getNumVertices();
+	std::vector<uint32_t> remap( numVertices, std::numeric_limits<uint32_t>::max() );
+	std::vector<uint32_t> order;
+	result.mIndices.resize( indices.size() );
+	for( size_t i = 0; i < indices.size(); ++i ) {
+		const uint32_t index = indices[i];
+		if( index >= numVertices )
+			throw Exception( "TriMesh::extract: index out of range" );
+		if( remap[index] == std::numeric_limits<uint32_t>::max() ) {
+			remap[index] = (uint32_t)order.size();
+			order.push_back( index );
+		}
+		result.mIndices[i] = remap[index];
+	}
+
+	auto gather = [&order] ( const auto &src, auto *dst, size_t dims ) {
+		if( src.empty() )
+			return;
+		dst->resize( order.size() * dims );
+		for( size_t v = 0; v < order.size(); ++v )
+			std::copy_n( src.begin() + order[v] * dims, dims, dst->begin() + v * dims );
+	};
+
+	gather( mPositions, &result.mPositions, mPositionsDims );
+	gather( mColors, &result.mColors, mColorsDims );
+	gather( mNormals, &result.mNormals, 1 );
+	gather( mTangents, &result.mTangents, 1 );
+	gather( mBitangents, &result.mBitangents, 1 );
+	gather( mBoneIndices, &result.mBoneIndices, 1 );
+	gather( mBoneWeights, &result.mBoneWeights, 1 );
+	gather( mTexCoords0, &result.mTexCoords0, mTexCoords0Dims );
+	gather( mTexCoords1, &result.mTexCoords1, mTexCoords1Dims );
+	gather( mTexCoords2, &result.mTexCoords2, mTexCoords2Dims );
+	gather( mTexCoords3, &result.mTexCoords3, mTexCoords3Dims );
+
+	return result;
+}
+
 uint8_t TriMesh::getAttribDims( geom::Attrib attr ) const
 {
 	switch( attr ) {
@@ -0,0 +1,260 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/TriMesh.h"
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// Orders the triangles of indices for vertex cache reuse with Tipsify, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+// (Sander, Nehab & Barczak 2007). If hardBoundaries is supplied it receives the output triangle positions at which the traversal hit a dead end.
+vector<uint32_t> tipsify( const vector<uint32_t> &indices, size_t numVertices, uint32_t cacheSize, vector<size_t> *hardBoundaries )
+{
+	const size_t numTriangles = indices.size() / 3;
+
+	vector<uint32_t> offsets, adjacency;
+	geom::calculateVertexTriangleAdjacency( indices.size(), indices.data(), numVertices, &offsets, &adjacency );
+	vector<uint32_t> liveTriangles( numVertices );
+	for( size_t v = 0; v < numVertices; ++v )
+		liveTriangles[v] = offsets[v + 1] - offsets[v];
+
+	vector<uint32_t> result;
+	result.reserve( indices.size() );
+	vector<uint32_t> cacheTime( numVertices, 0 );
+	vector<uint8_t> emitted( numTriangles, 0 );
+	vector<uint32_t> deadEnds, candidates;
+	uint32_t time = cacheSize + 1;
+	size_t cursor = 0;
+
+	// returns the next vertex with live triangles from the dead-end stack, or else in input order
+	auto skipDeadEnd = [&]() -> int64_t {
+		while( ! deadEnds.empty() ) {
+			uint32_t v = deadEnds.back();
+			deadEnds.pop_back();
+			if( liveTriangles[v] > 0 )
+				return v;
+		}
+		for( ; cursor < numVertices; ++cursor ) {
+			if( liveTriangles[cursor] > 0 )
+				return int64_t( cursor );
+		}
+		return -1;
+	};
+
+	int64_t fan = skipDeadEnd();
+	while( fan >= 0 ) {
+		candidates.clear();
+		for( uint32_t a = offsets[fan]; a < offsets[fan + 1]; ++a ) {
+			const uint32_t t = adjacency[a];
+			if( emitted[t] )
+				continue;
+			for( int k = 0; k < 3; ++k ) {
+				const uint32_t v = indices[t * 3 + k];
+				result.push_back( v );
+				deadEnds.push_back( v );
+				candidates.push_back( v );
+				--liveTriangles[v];
+				if( time - cacheTime[v] > cacheSize )
+					cacheTime[v] = time++;
+			}
+			emitted[t] = 1;
+		}
+
+		// prefer the candidate that entered the cache longest ago but will remain in it while its remaining triangles are emitted
+		int64_t next = -1, bestPriority = -1;
+		for( uint32_t v : candidates ) {
+			if( liveTriangles[v] == 0 )
+				continue;
+			int64_t priority = 0;
+			if( time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize )
+				priority = time - cacheTime[v];
+			if( priority > bestPriority ) {
+				bestPriority = priority;
+				next = v;
+			}
+		}
+
+		if( next < 0 ) {
+			next = skipDeadEnd();
+			if( hardBoundaries && next >= 0 )
+				hardBoundaries->push_back( result.size() / 3 );
+		}
+		fan = next;
+	}
+
+	return result;
+}
+
+// Simulates a FIFO cache, returning the number of misses for each triangle of indices
+vector<uint8_t> calcCacheMisses( const vector<uint32_t> &indices, size_t numVertices, uint32_t cacheSize, const vector<size_t> &resets )
+{
+	vector<uint8_t> result( indices.size() / 3 );
+	vector<uint32_t> cacheTime( numVertices, 0 );
+	uint32_t time = cacheSize + 1;
+	auto nextReset = resets.begin();
+	for( size_t t = 0; t < result.size(); ++t ) {
+		if( nextReset != resets.end() && *nextReset == t ) {
+			time += cacheSize + 1;
+			++nextReset;
+		}
+		for( int k = 0; k < 3; ++k ) {
+			const uint32_t v = indices[t * 3 + k];
+			if( time - cacheTime[v] > cacheSize ) {
+				cacheTime[v] = time++;
+				++result[t];
+			}
+		}
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+TriMesh::VertexCacheStats TriMesh::calcVertexCacheStats( uint32_t cacheSize ) const
+{
+	VertexCacheStats result = { 0, 0, 0 };
+	auto misses = calcCacheMisses( mIndices, getNumVertices(), std::max<uint32_t>( cacheSize, 1 ), vector<size_t>() );
+	result.mNumTransformed = accumulate( misses.begin(), misses.end(), size_t( 0 ) );
+
+	vector<uint8_t> referenced( getNumVertices(), 0 );
+	for( uint32_t index : mIndices )
+		referenced[index] = 1;
+	const size_t numReferenced = count( referenced.begin(), referenced.end(), 1 );
+
+	if( ! misses.empty() )
+		result.mAcmr = result.mNumTransformed / float( misses.size() );
+	if( numReferenced > 0 )
+		result.mAtvr = result.mNumTransformed / float( numReferenced );
+
+	return result;
+}
+
+void TriMesh::optimizeVertexCache( uint32_t cacheSize )
+{
+	mIndices = tipsify( mIndices, getNumVertices(), std::max<uint32_t>( cacheSize, 3 ), nullptr );
+}
+
+void TriMesh::optimizeOverdraw( float threshold, uint32_t cacheSize )
+{
+	cacheSize = std::max<uint32_t>( cacheSize, 3 );
+	if( mPositionsDims != 3 ) {
+		CI_LOG_E( "TriMesh::optimizeOverdraw requires 3D positions" );
+		optimizeVertexCache( cacheSize );
+		return;
+	}
+
+	const size_t numVertices = getNumVertices();
+	vector<size_t> hardBoundaries( 1, 0 );
+	vector<uint32_t> ordered = tipsify( mIndices, numVertices, cacheSize, &hardBoundaries );
+	const size_t numTriangles = ordered.size() / 3;
+	hardBoundaries.push_back( numTriangles );
+
+	// split each hard cluster into smaller ones wherever the running ACMR first reaches threshold times the cluster's own ACMR
+	vector<size_t> boundaries;
+	{
+		auto misses = calcCacheMisses( ordered, numVertices, cacheSize, hardBoundaries );
+		vector<uint32_t> cacheTime( numVertices, 0 );
+		uint32_t time = cacheSize + 1;
+		for( size_t h = 0; h + 1 < hardBoundaries.size(); ++h ) {
+			const size_t begin = hardBoundaries[h], end = hardBoundaries[h + 1];
+			if( begin == end )
+				continue;
+			const size_t clusterMisses = accumulate( misses.begin() + begin, misses.begin() + end, size_t( 0 ) );
+			const float clusterThreshold = threshold * clusterMisses / float( end - begin );
+
+			boundaries.push_back( begin );
+			time += cacheSize + 1;
+			size_t runningMisses = 0, runningTriangles = 0;
+			for( size_t t = begin; t < end; ++t ) {
+				for( int k = 0; k < 3; ++k ) {
+					const uint32_t v = ordered[t * 3 + k];
+					if( time - cacheTime[v] > cacheSize ) {
+						cacheTime[v] = time++;
+						++runningMisses;
+					}
+				}
+				++runningTriangles;
+				if( t + 1 < end && runningMisses <= clusterThreshold * runningTriangles ) {
+					boundaries.push_back( t + 1 );
+					time += cacheSize + 1;
+					runningMisses = runningTriangles = 0;
+				}
+			}
+		}
+		boundaries.push_back( numTriangles );
+	}
+
+	// sort clusters so that those facing away from the mesh's centroid (which are likely to occlude the others) are drawn first
+	const vec3 *positions = getPositions<3>();
+	vec3 meshCentroid( 0 );
+	float meshArea = 0;
+	const size_t numClusters = boundaries.size() - 1;
+	vector<vec3> clusterCentroids( numClusters, vec3( 0 ) ), clusterNormals( numClusters, vec3( 0 ) );
+	for( size_t c = 0; c < numClusters; ++c ) {
+		float clusterArea = 0;
+		for( size_t t = boundaries[c]; t < boundaries[c + 1]; ++t ) {
+			const vec3 &p0 = positions[ordered[t * 3 + 0]], &p1 = positions[ordered[t * 3 + 1]], &p2 = positions[ordered[t * 3 + 2]];
+			const vec3 n = cross( p1 - p0, p2 - p0 );
+			const float area = length( n );
+			clusterCentroids[c] += ( p0 + p1 + p2 ) * ( area / 3.0f );
+			clusterNormals[c] += n;
+			clusterArea += area;
+		}
+		meshCentroid += clusterCentroids[c];
+		meshArea += clusterArea;
+		if( clusterArea > 0 )
+			clusterCentroids[c] /= clusterArea;
+	}
+	if( meshArea > 0 )
+		meshCentroid /= meshArea;
+
+	vector<float> sortKeys( numClusters );
+	for( size_t c = 0; c < numClusters; ++c ) {
+		const float normalLength = length( clusterNormals[c] );
+		sortKeys[c] = ( normalLength > 0 ) ? dot( clusterCentroids[c] - meshCentroid, clusterNormals[c] / normalLength ) : 0;
+	}
+	vector<size_t> clusterOrder( numClusters );
+	iota( clusterOrder.begin(), clusterOrder.end(), 0 );
+	stable_sort( clusterOrder.begin(), clusterOrder.end(), [&sortKeys]( size_t a, size_t b ) { return sortKeys[a] > sortKeys[b]; } );
+
+	mIndices.clear();
+	for( size_t c : clusterOrder )
+		mIndices.insert( mIndices.end(), ordered.begin() + boundaries[c] * 3, ordered.begin() + boundaries[c + 1] * 3 );
+}
+
+void TriMesh::optimizeVertexFetch()
+{
+	*this = extract( mIndices );
+}
+
+} // namespace cinder
@@ -0,0 +1,621 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/TriMesh.h"
+#include "cinder/Log.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+const size_t	PARALLEL_GRAIN_SIZE = 4096;
+// boundary constraint planes are weighted relative to the area-weighted face planes so that open borders resist sliding inwards
+const double	BORDER_WEIGHT = 10.0;
+// a collapse is rejected if any surviving triangle's normal rotates by more than roughly 90 degrees
+const float		FLIP_THRESHOLD = 1e-2f;
+const uint32_t	INVALID_INDEX = numeric_limits<uint32_t>::max();
+// vertices at the same position whose attributes all differ by less than this are welded before simplification
+const float		WELD_EPSILON = 1e-5f;
+
+enum VertexKind : uint8_t {
+	VERTEX_INTERIOR,	// may collapse onto any neighbor
+	VERTEX_BORDER,		// lies on an open edge; may only collapse along open edges
+	VERTEX_LOCKED		// attribute seam, locked border, isolated vertex or cluster boundary; never removed
+};
+
+// Symmetric 4x4 error quadric (Garland & Heckbert), plus the accumulated area used to normalize it
+struct Quadric {
+	Quadric()
+		: a00( 0 ), a01( 0 ), a02( 0 ), a11( 0 ), a12( 0 ), a22( 0 ), b0( 0 ), b1( 0 ), b2( 0 ), c( 0 ), w( 0 )
+	{}
+
+	// Quadric of the plane dot( n, p ) + d = 0, scaled by weight. Only face planes contribute to the normalization area.
+	Quadric( const glm::dvec3 &n, double d, double weight, bool contributesArea )
+	{
+		a00 = weight * n.x * n.x; a01 = weight * n.x * n.y; a02 = weight * n.x * n.z;
+		a11 = weight * n.y * n.y; a12 = weight * n.y * n.z; a22 = weight * n.z * n.z;
+		b0 = weight * n.x * d; b1 = weight * n.y * d; b2 = weight * n.z * d;
+		c = weight * d * d;
+		w = contributesArea ? weight : 0;
+	}
+
+	Quadric& operator+=( const Quadric &rhs )
+	{
+		a00 += rhs.a00; a01 += rhs.a01; a02 += rhs.a02; a11 += rhs.a11; a12 += rhs.a12; a22 += rhs.a22;
+		b0 += rhs.b0; b1 += rhs.b1; b2 += rhs.b2; c += rhs.c; w += rhs.w;
+		return *this;
+	}
+
+	Quadric& operator-=( const Quadric &rhs )
+	{
+		a00 -= rhs.a00; a01 -= rhs.a01; a02 -= rhs.a02; a11 -= rhs.a11; a12 -= rhs.a12; a22 -= rhs.a22;
+		b0 -= rhs.b0; b1 -= rhs.b1; b2 -= rhs.b2; c -= rhs.c; w -= rhs.w;
+		return *this;
+	}
+
+	// Sum of weighted squared distances from p to every accumulated plane
+	double eval( const vec3 &p ) const
+	{
+		const double x = p.x, y = p.y, z = p.z;
+		double r = a00 * x * x + a11 * y * y + a22 * z * z + 2 * ( a01 * x * y + a02 * x * z + a12 * y * z );
+		r += 2 * ( b0 * x + b1 * y + b2 * z ) + c;
+		return std::max( r, 0.0 );
+	}
+
+	double a00, a01, a02, a11, a12, a22, b0, b1, b2, c, w;
+};
+
+// Compressed vertex -> triangle adjacency
+struct Adjacency {
+	void build( const vector<uint32_t> &indices, size_t numVertices )
+	{
+		geom::calculateVertexTriangleAdjacency( indices.size(), indices.data(), numVertices, &mOffsets, &mTriangles );
+	}
+
+	const uint32_t*	begin( uint32_t v ) const	{ return mTriangles.data() + mOffsets[v]; }
+	const uint32_t*	end( uint32_t v ) const		{ return mTriangles.data() + mOffsets[v + 1]; }
+	bool			empty( uint32_t v ) const	{ return mOffsets[v] == mOffsets[v + 1]; }
+
+	vector<uint32_t>	mOffsets, mTriangles;
+};
+
+// Greedy half-edge collapse simplifier over a self-contained set of vertices and triangles. Each pass selects the cheapest
+// collapse per vertex in parallel, then applies an independent set of them in order of increasing cost.
+class Simplifier {
+  public:
+	Simplifier()
+		: mAttribDims( 0 ), mMaxCost( 0 )
+	{}
+
+	size_t	getNumTriangles() const	{ return mIndices.size() / 3; }
+
+	// Collapses edges until at most targetTriangles remain or every remaining collapse costs more than maxCost.
+	void run( size_t targetTriangles, float maxCost )
+	{
+		struct Candidate {
+			float		mCost;
+			uint32_t	mFrom, mTo;
+			bool operator<( const Candidate &rhs ) const { return mCost < rhs.mCost; }
+		};
+
+		const size_t numVertices = mPositions.size();
+		vector<Candidate> candidates( numVertices );
+		vector<uint8_t> touched( numVertices );
+		vector<uint8_t> deadTriangles;
+
+		size_t numTriangles = getNumTriangles();
+		while( numTriangles > targetTriangles ) {
+			mAdjacency.build( mIndices, numVertices );
+
+			parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+				for( size_t v = begin; v < end; ++v )
+					candidates[v] = { numeric_limits<float>::max(), uint32_t( v ), INVALID_INDEX };
+				for( size_t v = begin; v < end; ++v ) {
+					if( mKinds[v] == VERTEX_LOCKED )
+						continue;
+					const uint32_t from = uint32_t( v );
+					for( auto t = mAdjacency.begin( from ); t != mAdjacency.end( from ); ++t ) {
+						for( int k = 0; k < 3; ++k ) {
+							const uint32_t to = mIndices[*t * 3 + k];
+							if( to == from || ( mKinds[from] == VERTEX_BORDER && ! isOpenEdge( from, to ) ) )
+								continue;
+							float cost = calcCost( from, to );
+							if( cost < candidates[v].mCost )
+								candidates[v] = { cost, from, to };
+						}
+					}
+				}
+			} );
+
+			auto validEnd = remove_if( candidates.begin(), candidates.end(), []( const Candidate &c ) { return c.mTo == INVALID_INDEX; } );
+			candidates.erase( validEnd, candidates.end() );
+			if( candidates.empty() )
+				break;
+			sort( candidates.begin(), candidates.end() );
+
+			// only consider the cheapest third per pass; the rest are re-evaluated against the updated mesh
+			const size_t numConsidered = std::max<size_t>( 1, candidates.size() / 3 );
+			fill( touched.begin(), touched.end(), 0 );
+			deadTriangles.assign( getNumTriangles(), 0 );
+			size_t numCollapsed = 0;
+			for( size_t i = 0; i < numConsidered && numTriangles > targetTriangles; ++i ) {
+				const Candidate &c = candidates[i];
+				if( c.mCost > maxCost )
+					break;
+				if( touched[c.mFrom] || touched[c.mTo] || isFlipped( c.mFrom, c.mTo, deadTriangles ) )
+					continue;
+
+				for( auto t = mAdjacency.begin( c.mFrom ); t != mAdjacency.end( c.mFrom ); ++t ) {
+					if( deadTriangles[*t] )
+						continue;
+					uint32_t *tri = &mIndices[*t * 3];
+					if( tri[0] == c.mTo || tri[1] == c.mTo || tri[2] == c.mTo ) {
+						deadTriangles[*t] = 1;
+						--numTriangles;
+					}
+					else {
+						for( int k = 0; k < 3; ++k )
+							if( tri[k] == c.mFrom )
+								tri[k] = c.mTo;
+					}
+				}
+
+				mQuadrics[c.mTo] += mQuadrics[c.mFrom];
+				mKinds[c.mFrom] = VERTEX_LOCKED;
+				touched[c.mFrom] = touched[c.mTo] = 1;
+				mMaxCost = std::max( mMaxCost, c.mCost );
+				++numCollapsed;
+			}
+
+			// compact surviving triangles
+			size_t write = 0;
+			for( size_t t = 0; t < deadTriangles.size(); ++t ) {
+				if( deadTriangles[t] )
+					continue;
+				if( write != t )
+					copy_n( &mIndices[t * 3], 3, &mIndices[write * 3] );
+				++write;
+			}
+			mIndices.resize( write * 3 );
+
+			if( numCollapsed == 0 )
+				break;
+			candidates.resize( numVertices );
+		}
+	}
+
+	vector<vec3>		mPositions;
+	vector<float>		mAttribs;
+	size_t				mAttribDims;
+	vector<Quadric>		mQuadrics;
+	vector<uint8_t>		mKinds;
+	vector<uint32_t>	mIndices;
+	float				mMaxCost;
+
+  private:
+	// An edge is open if exactly one live triangle contains it
+	bool isOpenEdge( uint32_t a, uint32_t b ) const
+	{
+		int count = 0;
+		for( auto t = mAdjacency.begin( a ); t != mAdjacency.end( a ); ++t ) {
+			const uint32_t *tri = &mIndices[*t * 3];
+			if( tri[0] == b || tri[1] == b || tri[2] == b )
+				++count;
+		}
+		return count == 1;
+	}
+
+	// Mean squared distance to the combined planes at the surviving position, plus the squared attribute change
+	float calcCost( uint32_t from, uint32_t to ) const
+	{
+		Quadric q = mQuadrics[from];
+		q += mQuadrics[to];
+		double cost = q.eval( mPositions[to] ) / ( q.w > 0 ? q.w : 1.0 );
+
+		const float *attribFrom = mAttribs.data() + from * mAttribDims;
+		const float *attribTo = mAttribs.data() + to * mAttribDims;
+		for( size_t i = 0; i < mAttribDims; ++i ) {
+			float delta = attribFrom[i] - attribTo[i];
+			cost += delta * delta;
+		}
+
+		return float( cost );
+	}
+
+	// Returns true if moving 'from' onto 'to' would fold or collapse any triangle that survives the collapse
+	bool isFlipped( uint32_t from, uint32_t to, const vector<uint8_t> &deadTriangles ) const
+	{
+		for( auto t = mAdjacency.begin( from ); t != mAdjacency.end( from ); ++t ) {
+			if( deadTriangles[*t] )
+				continue;
+			const uint32_t *tri = &mIndices[*t * 3];
+			if( tri[0] == to || tri[1] == to || tri[2] == to )
+				continue;
+
+			vec3 p[3], q[3];
+			for( int k = 0; k < 3; ++k ) {
+				p[k] = mPositions[tri[k]];
+				q[k] = ( tri[k] == from ) ? mPositions[to] : p[k];
+			}
+			vec3 n0 = cross( p[1] - p[0], p[2] - p[0] );
+			vec3 n1 = cross( q[1] - q[0], q[2] - q[0] );
+			if( dot( n0, n1 ) < FLIP_THRESHOLD * length( n0 ) * length( n1 ) || length2( n1 ) == 0 )
+				return true;
+		}
+
+		return false;
+	}
+
+	Adjacency			mAdjacency;
+};
+
+// Spreads the low 10 bits of v so that there are two zero bits between each
+uint32_t expandBits( uint32_t v )
+{
+	v = ( v * 0x00010001u ) & 0xFF0000FFu;
+	v = ( v * 0x00000101u ) & 0x0F00F00Fu;
+	v = ( v * 0x00000011u ) & 0xC30C30C3u;
+	v = ( v * 0x00000005u ) & 0x49249249u;
+	return v;
+}
+
+// p is expected to lie within [0,1]^3
+uint32_t calcMortonCode( const vec3 &p )
+{
+	uvec3 cell = uvec3( glm::clamp( p * 1024.0f, vec3( 0 ), vec3( 1023 ) ) );
+	return ( expandBits( cell.x ) << 2 ) | ( expandBits( cell.y ) << 1 ) | expandBits( cell.z );
+}
+
+struct Level {
+	vector<uint32_t>	mIndices;
+	float				mError;
+};
+
+// Simplifies the triangles described by indices to each of targetRatios, which must be sorted in decreasing order. Positions must be 3D.
+vector<Level> simplifyLevels( const TriMesh &mesh, const vector<uint32_t> &indices, const vector<float> &targetRatios, const TriMesh::SimplifyOptions &options )
+{
+	const size_t numVertices = mesh.getNumVertices();
+	const size_t numTriangles = indices.size() / 3;
+	const vec3 *positions = mesh.getPositions<3>();
+
+	Simplifier global;
+
+	// positions are normalized to the unit cube so that errors are relative to the mesh's largest extent
+	AxisAlignedBox bounds = mesh.calcBoundingBox();
+	const vec3 size = bounds.getSize();
+	float extent = std::max( size.x, std::max( size.y, size.z ) );
+	if( extent <= 0 )
+		extent = 1;
+	global.mPositions.resize( numVertices );
+	for( size_t v = 0; v < numVertices; ++v )
+		global.mPositions[v] = ( positions[v] - bounds.getMin() ) / extent;
+
+	// attributes are scaled by the square root of their weights, so that squared differences are weighted linearly
+	struct WeightedAttrib {
+		const float *mData;
+		size_t mDims;
+		float mScale;
+	};
+	vector<WeightedAttrib> attribs;
+	if( ! mesh.getNormals().empty() && options.getNormalWeight() > 0 )
+		attribs.push_back( { (const float*)mesh.getNormals().data(), 3, sqrt( options.getNormalWeight() ) } );
+	if( ! mesh.getBufferTexCoords0().empty() && options.getTexCoordWeight() > 0 )
+		attribs.push_back( { mesh.getBufferTexCoords0().data(), mesh.getAttribDims( geom::Attrib::TEX_COORD_0 ), sqrt( options.getTexCoordWeight() ) } );
+	if( ! mesh.getBufferColors().empty() && options.getColorWeight() > 0 )
+		attribs.push_back( { mesh.getBufferColors().data(), mesh.getAttribDims( geom::Attrib::COLOR ), sqrt( options.getColorWeight() ) } );
+	for( const auto &attrib : attribs )
+		global.mAttribDims += attrib.mDims;
+	global.mAttribs.resize( numVertices * global.mAttribDims );
+	size_t attribOffset = 0;
+	for( const auto &attrib : attribs ) {
+		for( size_t v = 0; v < numVertices; ++v )
+			for( size_t i = 0; i < attrib.mDims; ++i )
+				global.mAttribs[v * global.mAttribDims + attribOffset + i] = attrib.mData[v * attrib.mDims + i] * attrib.mScale;
+		attribOffset += attrib.mDims;
+	}
+
+	Adjacency adjacency;
+	adjacency.build( indices, numVertices );
+
+	// referenced vertices sharing a position with another referenced vertex lie on an attribute seam
+	vector<uint8_t> seams( numVertices, 0 );
+	{
+		vector<uint32_t> sorted;
+		for( uint32_t v = 0; v < numVertices; ++v ) {
+			if( ! adjacency.empty( v ) )
+				sorted.push_back( v );
+		}
+		auto less = [positions]( uint32_t a, uint32_t b ) {
+			const vec3 &pa = positions[a], &pb = positions[b];
+			return pa.x != pb.x ? pa.x < pb.x : ( pa.y != pb.y ? pa.y < pb.y : pa.z < pb.z );
+		};
+		sort( sorted.begin(), sorted.end(), less );
+		for( size_t i = 1; i < sorted.size(); ++i ) {
+			if( positions[sorted[i - 1]] == positions[sorted[i]] )
+				seams[sorted[i - 1]] = seams[sorted[i]] = 1;
+		}
+	}
+
+	// classify vertices and accumulate face and boundary quadrics per vertex
+	global.mKinds.resize( numVertices );
+	global.mQuadrics.resize( numVertices );
+	parallelFor( 0, numVertices, PARALLEL_GRAIN_SIZE, [&]( size_t begin, size_t end ) {
+		for( size_t v = begin; v < end; ++v ) {
+			const uint32_t vertex = uint32_t( v );
+			bool border = false;
+			Quadric q;
+			for( auto t = adjacency.begin( vertex ); t != adjacency.end( vertex ); ++t ) {
+				const uint32_t *tri = &indices[*t * 3];
+				const vec3 &p0 = global.mPositions[tri[0]], &p1 = global.mPositions[tri[1]], &p2 = global.mPositions[tri[2]];
+				glm::dvec3 n = glm::dvec3( cross( p1 - p0, p2 - p0 ) );
+				const double area = glm::length( n ) * 0.5;
+				if( area <= 0 )
+					continue;
+				n /= area * 2;
+				q += Quadric( n, -dot( n, glm::dvec3( p0 ) ), area, true );
+
+				// an edge from this vertex is open if no other triangle around this vertex shares it
+				for( int k = 0; k < 3; ++k ) {
+					const uint32_t other = tri[k];
+					if( other == vertex )
+						continue;
+					int count = 0;
+					for( auto s = adjacency.begin( vertex ); s != adjacency.end( vertex ); ++s ) {
+						const uint32_t *triS = &indices[*s * 3];
+						if( triS[0] == other || triS[1] == other || triS[2] == other )
+							++count;
+					}
+					if( count != 1 )
+						continue;
+
+					border = true;
+					if( seams[vertex] && seams[other] )
+						continue;
+					glm::dvec3 edge = glm::dvec3( global.mPositions[other] - global.mPositions[vertex] );
+					glm::dvec3 m = cross( edge, n );
+					const double edgeLength = glm::length( edge );
+					if( edgeLength <= 0 )
+						continue;
+					m = glm::normalize( m );
+					q += Quadric( m, -dot( m, glm::dvec3( global.mPositions[vertex] ) ), edgeLength * edgeLength * BORDER_WEIGHT, false );
+				}
+			}
+
+			global.mQuadrics[v] = q;
+			if( adjacency.empty( vertex ) || seams[v] || ( border && options.isBorderLocked() ) )
+				global.mKinds[v] = VERTEX_LOCKED;
+			else
+				global.mKinds[v] = border ? VERTEX_BORDER : VERTEX_INTERIOR;
+		}
+	} );
+
+	const float maxCost = options.getMaxError() * options.getMaxError();
+	const size_t clusterSize = options.getClusterSize();
+	if( clusterSize > 0 && numTriangles > clusterSize * 2 && ! targetRatios.empty() ) {
+		// partition triangles into spatially coherent clusters and simplify each independently towards the first level,
+		// keeping the vertices shared between clusters fixed
+		vector<pair<uint32_t, uint32_t>> order( numTriangles );
+		for( size_t t = 0; t < numTriangles; ++t ) {
+			const uint32_t *tri = &indices[t * 3];
+			vec3 centroid = ( global.mPositions[tri[0]] + global.mPositions[tri[1]] + global.mPositions[tri[2]] ) / 3.0f;
+			order[t] = make_pair( calcMortonCode( centroid ), uint32_t( t ) );
+		}
+		sort( order.begin(), order.end() );
+
+		const size_t numClusters = ( numTriangles + clusterSize - 1 ) / clusterSize;
+		const uint32_t SHARED = INVALID_INDEX - 1;
+		vector<uint32_t> vertexCluster( numVertices, INVALID_INDEX );
+		for( size_t i = 0; i < numTriangles; ++i ) {
+			const uint32_t cluster = uint32_t( i / clusterSize );
+			for( int k = 0; k < 3; ++k ) {
+				uint32_t &owner = vertexCluster[indices[order[i].second * 3 + k]];
+				if( owner == INVALID_INDEX )
+					owner = cluster;
+				else if( owner != cluster )
+					owner = SHARED;
+			}
+		}
+
+		// Shared vertices appear in several clusters, so while the clusters run their quadrics and kinds are only read. Each cluster
+		// records what it accumulated into them, which is added on this thread after the join; every other vertex belongs to one cluster.
+		vector<vector<uint32_t>> clusterIndices( numClusters );
+		vector<vector<pair<uint32_t, Quadric>>> clusterSharedDeltas( numClusters );
+		vector<float> clusterMaxCosts( numClusters, 0 );
+		parallelFor( 0, numClusters, 1, [&]( size_t begin, size_t end ) {
+			for( size_t c = begin; c < end; ++c ) {
+				const size_t first = c * clusterSize, last = std::min( numTriangles, first + clusterSize );
+				Simplifier local;
+				local.mAttribDims = global.mAttribDims;
+				unordered_map<uint32_t, uint32_t> toLocal;
+				vector<uint32_t> toGlobal;
+				local.mIndices.reserve( ( last - first ) * 3 );
+				for( size_t i = first; i < last; ++i ) {
+					for( int k = 0; k < 3; ++k ) {
+						const uint32_t g = indices[order[i].second * 3 + k];
+						auto inserted = toLocal.insert( make_pair( g, uint32_t( toGlobal.size() ) ) );
+						if( inserted.second ) {
+							toGlobal.push_back( g );
+							local.mPositions.push_back( global.mPositions[g] );
+							local.mAttribs.insert( local.mAttribs.end(), global.mAttribs.begin() + g * global.mAttribDims, global.mAttribs.begin() + ( g + 1 ) * global.mAttribDims );
+							local.mQuadrics.push_back( global.mQuadrics[g] );
+							local.mKinds.push_back( vertexCluster[g] == SHARED ? VERTEX_LOCKED : global.mKinds[g] );
+						}
+						local.mIndices.push_back( inserted.first->second );
+					}
+				}
+
+				const vector<Quadric> initialQuadrics = local.mQuadrics;
+				local.run( size_t( ( last - first ) * targetRatios.front() ), maxCost );
+
+				for( size_t l = 0; l < toGlobal.size(); ++l ) {
+					const uint32_t g = toGlobal[l];
+					if( vertexCluster[g] != SHARED ) {
+						global.mQuadrics[g] = local.mQuadrics[l];
+						global.mKinds[g] = local.mKinds[l];
+					}
+					else {
+						// shared vertices only ever receive collapses, so forward what this cluster accumulated
+						Quadric delta = local.mQuadrics[l];
+						delta -= initialQuadrics[l];
+						clusterSharedDeltas[c].emplace_back( g, delta );
+					}
+				}
+				for( auto &index : local.mIndices )
+					index = toGlobal[index];
+				clusterIndices[c] = std::move( local.mIndices );
+				clusterMaxCosts[c] = local.mMaxCost;
+			}
+		} );
+
+		for( size_t c = 0; c < numClusters; ++c ) {
+			for( const auto &delta : clusterSharedDeltas[c] )
+				global.mQuadrics[delta.first] += delta.second;
+			global.mMaxCost = std::max( global.mMaxCost, clusterMaxCosts[c] );
+		}
+
+		for( const auto &cluster : clusterIndices )
+			global.mIndices.insert( global.mIndices.end(), cluster.begin(), cluster.end() );
+	}
+	else
+		global.mIndices = indices;
+
+	vector<Level> result;
+	for( float ratio : targetRatios ) {
+		global.run( size_t( numTriangles * ratio ), maxCost );
+		result.push_back( { global.mIndices, sqrt( global.mMaxCost ) } );
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+vector<uint32_t> TriMesh::calcWeldedIndices() const
+{
+	// tangents and bitangents are derived per face by many sources, so they are not considered
+	const geom::Attrib attribs[] = { geom::Attrib::NORMAL, geom::Attrib::BONE_INDEX, geom::Attrib::BONE_WEIGHT, geom::Attrib::COLOR,
+		geom::Attrib::TEX_COORD_0, geom::Attrib::TEX_COORD_1, geom::Attrib::TEX_COORD_2, geom::Attrib::TEX_COORD_3 };
+	vector<pair<const float*, uint8_t>> buffers;
+	for( auto attrib : attribs ) {
+		const float *data;
+		size_t stride;
+		uint8_t dims;
+		getAttribPointer( attrib, &data, &stride, &dims );
+		if( data && dims )
+			buffers.emplace_back( data, dims );
+	}
+
+	auto attribsEqual = [&buffers]( uint32_t a, uint32_t b ) {
+		for( const auto &buffer : buffers ) {
+			const float *pa = buffer.first + a * buffer.second, *pb = buffer.first + b * buffer.second;
+			for( uint8_t i = 0; i < buffer.second; ++i ) {
+				if( std::abs( pa[i] - pb[i] ) > WELD_EPSILON )
+					return false;
+			}
+		}
+		return true;
+	};
+
+	// group vertices by identical position, then merge those within each group whose attributes match
+	const size_t numVertices = getNumVertices();
+	const vec3 *positions = getPositions<3>();
+	vector<uint32_t> sorted( numVertices );
+	iota( sorted.begin(), sorted.end(), 0 );
+	sort( sorted.begin(), sorted.end(), [positions]( uint32_t a, uint32_t b ) {
+		const vec3 &pa = positions[a], &pb = positions[b];
+		return pa.x != pb.x ? pa.x < pb.x : ( pa.y != pb.y ? pa.y < pb.y : ( pa.z != pb.z ? pa.z < pb.z : a < b ) );
+	} );
+
+	vector<uint32_t> remap( numVertices );
+	for( size_t groupBegin = 0, groupEnd; groupBegin < numVertices; groupBegin = groupEnd ) {
+		groupEnd = groupBegin + 1;
+		while( groupEnd < numVertices && positions[sorted[groupEnd]] == positions[sorted[groupBegin]] )
+			++groupEnd;
+
+		for( size_t i = groupBegin; i < groupEnd; ++i ) {
+			remap[sorted[i]] = sorted[i];
+			for( size_t j = groupBegin; j < i; ++j ) {
+				if( remap[sorted[j]] == sorted[j] && attribsEqual( sorted[i], sorted[j] ) ) {
+					remap[sorted[i]] = sorted[j];
+					break;
+				}
+			}
+		}
+	}
+
+	vector<uint32_t> result( mIndices.size() );
+	for( size_t i = 0; i < mIndices.size(); ++i )
+		result[i] = remap[mIndices[i]];
+
+	return result;
+}
+
+TriMesh TriMesh::simplified( float targetRatio, const SimplifyOptions &options, float *resultError ) const
+{
+	if( mPositionsDims != 3 ) {
+		CI_LOG_E( "TriMesh::simplified requires 3D positions" );
+		return *this;
+	}
+
+	auto levels = simplifyLevels( *this, calcWeldedIndices(), { glm::clamp( targetRatio, 0.0f, 1.0f ) }, options );
+	if( resultError )
+		*resultError = levels.front().mError;
+
+	return extract( levels.front().mIndices );
+}
+
+vector<TriMesh::Lod> TriMesh::calcLods( const vector<float> &targetRatios, const SimplifyOptions &options ) const
+{
+	if( mPositionsDims != 3 ) {
+		CI_LOG_E( "TriMesh::calcLods requires 3D positions" );
+		return vector<Lod>();
+	}
+
+	// levels are generated from largest to smallest ratio, then returned in the order requested
+	vector<size_t> order( targetRatios.size() );
+	iota( order.begin(), order.end(), 0 );
+	stable_sort( order.begin(), order.end(), [&targetRatios]( size_t a, size_t b ) { return targetRatios[a] > targetRatios[b]; } );
+	vector<float> sortedRatios;
+	for( size_t i : order )
+		sortedRatios.push_back( glm::clamp( targetRatios[i], 0.0f, 1.0f ) );
+
+	auto levels = simplifyLevels( *this, calcWeldedIndices(), sortedRatios, options );
+
+	vector<Lod> result( targetRatios.size() );
+	for( size_t i = 0; i < order.size(); ++i )
+		result[order[i]] = { make_shared<TriMesh>( extract( levels[i].mIndices ) ), levels[i].mError };
+
+	return result;
+}
+
+} // namespace cinder
@@ -22,8 +22,13 @@
 
 #include "cinder/Triangulate.h"
 #include "cinder/Shape2d.h"
+#include "cinder/PathFlattener.h"
 #include "../libtess2/tesselator.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+
 using namespace std;
 
 namespace cinder {
@@ -40,6 +45,582 @@ void stdFree( void* /*userData*/, void* ptr )
 	free( ptr );
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Triangulator::EarcutArena
+// Ear clipping with hole bridging and z-order accelerated ear tests, following Mapbox's earcut (ISC license).
+// Nodes are allocated from blocks that are kept between calls, so repeated triangulation does not touch the heap.
+class Triangulator::EarcutArena {
+  public:
+	EarcutArena()
+		: mNumUsed( 0 )
+	{}
+
+	void					clearIndices()				{ mIndices.clear(); }
+	const vector<uint32_t>&	getIndices() const			{ return mIndices; }
+
+	// Appends triangles for the polygon formed by the outer contour [outerBegin,outerEnd) and the given holes, as indices into points.
+	void triangulate( const vec2 *points, uint32_t outerBegin, uint32_t outerEnd, const vector<pair<uint32_t, uint32_t>> &holes )
+	{
+		mNumUsed = 0;
+
+		Node *outerNode = linkedList( points, outerBegin, outerEnd, true );
+		if( ! outerNode || outerNode->next == outerNode->prev )
+			return;
+
+		if( ! holes.empty() )
+			outerNode = eliminateHoles( points, holes, outerNode );
+
+		// large polygons use a z-order curve hash to limit ear tests to nearby points
+		mInvSize = 0;
+		if( outerEnd - outerBegin > 80 ) {
+			vec2 minPt = points[outerBegin], maxPt = points[outerBegin];
+			for( uint32_t i = outerBegin + 1; i < outerEnd; ++i ) {
+				minPt = glm::min( minPt, points[i] );
+				maxPt = glm::max( maxPt, points[i] );
+			}
+			mMin = minPt;
+			float size = std::max( maxPt.x - minPt.x, maxPt.y - minPt.y );
+			mInvSize = ( size != 0 ) ? 32767.0f / size : 0;
+		}
+
+		earcutLinked( outerNode, 0 );
+	}
+
+  private:
+	struct Node {
+		uint32_t	i;
+		float		x, y;
+		Node		*prev, *next;
+		int32_t		z;
+		Node		*prevZ, *nextZ;
+		bool		steiner;
+	};
+
+	static const size_t BLOCK_SIZE = 1024;
+
+	Node* createNode( uint32_t i, const vec2 &p )
+	{
+		if( mNumUsed == mBlocks.size() * BLOCK_SIZE )
+			mBlocks.emplace_back( new Node[BLOCK_SIZE] );
+		Node *result = &mBlocks[mNumUsed / BLOCK_SIZE][mNumUsed % BLOCK_SIZE];
+		++mNumUsed;
+		*result = { i, p.x, p.y, nullptr, nullptr, 0, nullptr, nullptr, false };
+		return result;
+	}
+
+	Node* insertNode( uint32_t i, const vec2 &p, Node *last )
+	{
+		Node *node = createNode( i, p );
+		if( ! last ) {
+			node->prev = node;
+			node->next = node;
+		}
+		else {
+			node->next = last->next;
+			node->prev = last;
+			last->next->prev = node;
+			last->next = node;
+		}
+		return node;
+	}
+
+	static void removeNode( Node *p )
+	{
+		p->next->prev = p->prev;
+		p->prev->next = p->next;
+		if( p->prevZ ) p->prevZ->nextZ = p->nextZ;
+		if( p->nextZ ) p->nextZ->prevZ = p->prevZ;
+	}
+
+	// Creates a circular doubly linked list from the contour, in the requested orientation
+	Node* linkedList( const vec2 *points, uint32_t begin, uint32_t end, bool clockwise )
+	{
+		float area = 0;
+		for( uint32_t i = begin, j = end - 1; i < end; j = i++ )
+			area += ( points[j].x - points[i].x ) * ( points[i].y + points[j].y );
+
+		Node *last = nullptr;
+		if( clockwise == ( area > 0 ) ) {
+			for( uint32_t i = begin; i < end; ++i )
+				last = insertNode( i, points[i], last );
+		}
+		else {
+			for( uint32_t i = end; i-- > begin; )
+				last = insertNode( i, points[i], last );
+		}
+
+		if( last && equals( last, last->next ) ) {
+			removeNode( last );
+			last = last->next;
+		}
+
+		return last;
+	}
+
+	// Removes duplicate and collinear points
+	Node* filterPoints( Node *start, Node *end = nullptr )
+	{
+		if( ! start )
+			return start;
+		if( ! end )
+			end = start;
+
+		Node *p = start;
+		bool again;
+		do {
+			again = false;
+			if( ! p->steiner && ( equals( p, p->next ) || area( p->prev, p, p->next ) == 0 ) ) {
+				removeNode( p );
+				p = end = p->prev;
+				if( p == p->next )
+					break;
+				again = true;
+			}
+			else
+				p = p->next;
+		} while( again || p != end );
+
+		return end;
+	}
+
+	void emitTriangle( const Node *a, const Node *b, const Node *c )
+	{
+		mIndices.push_back( a->i );
+		mIndices.push_back( b->i );
+		mIndices.push_back( c->i );
+	}
+
+	// Main ear slicing loop. Each pass after the first applies a more expensive fix-up for degenerate input.
+	void earcutLinked( Node *ear, int pass )
+	{
+		if( ! ear )
+			return;
+
+		if( ! pass && mInvSize )
+			indexCurve( ear );
+
+		Node *stop = ear;
+		while( ear->prev != ear->next ) {
+			Node *prev = ear->prev;
+			Node *next = ear->next;
+
+			if( mInvSize ? isEarHashed( ear ) : isEar( ear ) ) {
+				emitTriangle( prev, ear, next );
+				removeNode( ear );
+				// skipping the next vertex leads to less sliver triangles
+				ear = next->next;
+				stop = next->next;
+				continue;
+			}
+
+			ear = next;
+			if( ear == stop ) {
+				if( pass == 0 )
+					earcutLinked( filterPoints( ear ), 1 );
+				else if( pass == 1 ) {
+					ear = cureLocalIntersections( filterPoints( ear ) );
+					earcutLinked( ear, 2 );
+				}
+				else if( pass == 2 )
+					splitEarcut( ear );
+				break;
+			}
+		}
+	}
+
+	bool isEar( const Node *ear ) const
+	{
+		const Node *a = ear->prev, *b = ear, *c = ear->next;
+		if( area( a, b, c ) >= 0 )
+			return false; // reflex
+
+		const float x0 = std::min( a->x, std::min( b->x, c->x ) ), y0 = std::min( a->y, std::min( b->y, c->y ) );
+		const float x1 = std::max( a->x, std::max( b->x, c->x ) ), y1 = std::max( a->y, std::max( b->y, c->y ) );
+
+		for( const Node *p = c->next; p != a; p = p->next ) {
+			if( p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && pointInTriangle( a, b, c, p ) && area( p->prev, p, p->next ) >= 0 )
+				return false;
+		}
+
+		return true;
+	}
+
+	bool isEarHashed( const Node *ear ) const
+	{
+		const Node *a = ear->prev, *b = ear, *c = ear->next;
+		if( area( a, b, c ) >= 0 )
+			return false;
+
+		const float x0 = std::min( a->x, std::min( b->x, c->x ) ), y0 = std::min( a->y, std::min( b->y, c->y ) );
+		const float x1 = std::max( a->x, std::max( b->x, c->x ) ), y1 = std::max( a->y, std::max( b->y, c->y ) );
+		const int32_t minZ = zOrder( x0, y0 ), maxZ = zOrder( x1, y1 );
+
+		auto blocks = [&]( const Node *p ) {
+			return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c && pointInTriangle( a, b, c, p ) && area( p->prev, p, p->next ) >= 0;
+		};
+
+		// look for points inside the triangle in both directions along the z-order curve
+		const Node *p = ear->prevZ, *n = ear->nextZ;
+		while( p && p->z >= minZ && n && n->z <= maxZ ) {
+			if( blocks( p ) ) return false;
+			p = p->prevZ;
+			if( blocks( n ) ) return false;
+			n = n->nextZ;
+		}
+		for( ; p && p->z >= minZ; p = p->prevZ ) {
+			if( blocks( p ) ) return false;
+		}
+		for( ; n && n->z <= maxZ; n = n->nextZ ) {
+			if( blocks( n ) ) return false;
+		}
+
+		return true;
+	}
+
+	// Clips local self-intersections of the form a-b-c-d where b-c crosses a-d
+	Node* cureLocalIntersections( Node *start )
+	{
+		Node *p = start;
+		do {
+			Node *a = p->prev, *b = p->next->next;
+			if( ! equals( a, b ) && intersects( a, p, p->next, b ) && locallyInside( a, b ) && locallyInside( b, a ) ) {
+				emitTriangle( a, p, b );
+				removeNode( p );
+				removeNode( p->next );
+				p = start = b;
+			}
+			p = p->next;
+		} while( p != start );
+
+		return filterPoints( p );
+	}
+
+	// Last resort: splits the polygon along a valid diagonal and triangulates both halves
+	void splitEarcut( Node *start )
+	{
+		Node *a = start;
+		do {
+			for( Node *b = a->next->next; b != a->prev; b = b->next ) {
+				if( a->i != b->i && isValidDiagonal( a, b ) ) {
+					Node *c = splitPolygon( a, b );
+					a = filterPoints( a, a->next );
+					c = filterPoints( c, c->next );
+					earcutLinked( a, 0 );
+					earcutLinked( c, 0 );
+					return;
+				}
+			}
+			a = a->next;
+		} while( a != start );
+	}
+
+	// Links every hole into the outer loop, left to right, producing a single weakly simple polygon
+	Node* eliminateHoles( const vec2 *points, const vector<pair<uint32_t, uint32_t>> &holes, Node *outerNode )
+	{
+		mQueue.clear();
+		for( const auto &hole : holes ) {
+			Node *list = linkedList( points, hole.first, hole.second, false );
+			if( ! list )
+				continue;
+			if( list == list->next )
+				list->steiner = true;
+			mQueue.push_back( getLeftmost( list ) );
+		}
+		sort( mQueue.begin(), mQueue.end(), []( const Node *a, const Node *b ) { return a->x < b->x; } );
+
+		for( Node *hole : mQueue )
+			outerNode = eliminateHole( hole, outerNode );
+
+		return outerNode;
+	}
+
+	Node* eliminateHole( Node *hole, Node *outerNode )
+	{
+		Node *bridge = findHoleBridge( hole, outerNode );
+		if( ! bridge )
+			return outerNode;
+
+		Node *bridgeReverse = splitPolygon( bridge, hole );
+		filterPoints( bridgeReverse, bridgeReverse->next );
+		return filterPoints( bridge, bridge->next );
+	}
+
+	// David Eberly's algorithm for finding a bridge between a hole and the outer polygon
+	Node* findHoleBridge( const Node *hole, Node *outerNode ) const
+	{
+		Node *p = outerNode;
+		const float hx = hole->x, hy = hole->y;
+		float qx = -numeric_limits<float>::infinity();
+		Node *m = nullptr;
+
+		// find a segment intersected by a ray from the hole's leftmost point to the left; segment's endpoint with lesser x will be the potential connection point
+		do {
+			if( hy <= p->y && hy >= p->next->y && p->next->y != p->y ) {
+				float x = p->x + ( hy - p->y ) * ( p->next->x - p->x ) / ( p->next->y - p->y );
+				if( x <= hx && x > qx ) {
+					qx = x;
+					m = p->x < p->next->x ? p : p->next;
+					if( x == hx )
+						return m; // hole touches outer segment; pick leftmost endpoint
+				}
+			}
+			p = p->next;
+		} while( p != outerNode );
+
+		if( ! m )
+			return nullptr;
+
+		// look for points inside the triangle of hole point, segment intersection and endpoint; if there are none, m is the connection point.
+		// Otherwise choose the point of the minimum angle with the ray as the connection point
+		const Node *stop = m;
+		const float mx = m->x, my = m->y;
+		float tanMin = numeric_limits<float>::infinity();
+		p = m;
+		do {
+			if( hx >= p->x && p->x >= mx && hx != p->x &&
+				pointInTriangle( hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y ) ) {
+				float tan = std::abs( hy - p->y ) / ( hx - p->x );
+				if( locallyInside( p, hole ) && ( tan < tanMin || ( tan == tanMin && ( p->x > m->x || ( p->x == m->x && sectorContainsSector( m, p ) ) ) ) ) ) {
+					m = p;
+					tanMin = tan;
+				}
+			}
+			p = p->next;
+		} while( p != stop );
+
+		return m;
+	}
+
+	static bool sectorContainsSector( const Node *m, const Node *p )
+	{
+		return area( m->prev, m, p->prev ) < 0 && area( p->next, m, m->next ) < 0;
+	}
+
+	// Interlinks polygon nodes in z-order
+	void indexCurve( Node *start ) const
+	{
+		Node *p = start;
+		do {
+			if( p->z == 0 )
+				p->z = zOrder( p->x, p->y );
+			p->prevZ = p->prev;
+			p->nextZ = p->next;
+			p = p->next;
+		} while( p != start );
+
+		p->prevZ->nextZ = nullptr;
+		p->prevZ = nullptr;
+
+		sortLinked( p );
+	}
+
+	// Simon Tatham's linked list merge sort
+	static Node* sortLinked( Node *list )
+	{
+		int inSize = 1;
+		int numMerges;
+		do {
+			Node *p = list, *tail = nullptr;
+			list = nullptr;
+			numMerges = 0;
+
+			while( p ) {
+				++numMerges;
+				Node *q = p;
+				int pSize = 0;
+				for( int i = 0; i < inSize; ++i ) {
+					++pSize;
+					q = q->nextZ;
+					if( ! q )
+						break;
+				}
+				int qSize = inSize;
+
+				while( pSize > 0 || ( qSize > 0 && q ) ) {
+					Node *e;
+					if( pSize != 0 && ( qSize == 0 || ! q || p->z <= q->z ) ) {
+						e = p;
+						p = p->nextZ;
+						--pSize;
+					}
+					else {
+						e = q;
+						q = q->nextZ;
+						--qSize;
+					}
+
+					if( tail )
+						tail->nextZ = e;
+					else
+						list = e;
+					e->prevZ = tail;
+					tail = e;
+				}
+
+				p = q;
+			}
+
+			tail->nextZ = nullptr;
+			inSize *= 2;
+		} while( numMerges > 1 );
+
+		return list;
+	}
+
+	// z-order of a point given coords and inverse of the longer side of data bbox
+	int32_t zOrder( float fx, float fy ) const
+	{
+		int32_t x = int32_t( ( fx - mMin.x ) * mInvSize );
+		int32_t y = int32_t( ( fy - mMin.y ) * mInvSize );
+
+		x = ( x | ( x << 8 ) ) & 0x00FF00FF;
+		x = ( x | ( x << 4 ) ) & 0x0F0F0F0F;
+		x = ( x | ( x << 2 ) ) & 0x33333333;
+		x = ( x | ( x << 1 ) ) & 0x55555555;
+
+		y = ( y | ( y << 8 ) ) & 0x00FF00FF;
+		y = ( y | ( y << 4 ) ) & 0x0F0F0F0F;
+		y = ( y | ( y << 2 ) ) & 0x33333333;
+		y = ( y | ( y << 1 ) ) & 0x55555555;
+
+		return x | ( y << 1 );
+	}
+
+	static Node* getLeftmost( Node *start )
+	{
+		Node *p = start, *leftmost = start;
+		do {
+			if( p->x < leftmost->x || ( p->x == leftmost->x && p->y < leftmost->y ) )
+				leftmost = p;
+			p = p->next;
+		} while( p != start );
+
+		return leftmost;
+	}
+
+	static bool pointInTriangle( float ax, float ay, float bx, float by, float cx, float cy, float px, float py )
+	{
+		return ( cx - px ) * ( ay - py ) >= ( ax - px ) * ( cy - py ) &&
+			   ( ax - px ) * ( by - py ) >= ( bx - px ) * ( ay - py ) &&
+			   ( bx - px ) * ( cy - py ) >= ( cx - px ) * ( by - py );
+	}
+
+	static bool pointInTriangle( const Node *a, const Node *b, const Node *c, const Node *p )
+	{
+		return pointInTriangle( a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y );
+	}
+
+	// Returns whether a diagonal between a and b lies inside the polygon without intersecting it
+	bool isValidDiagonal( const Node *a, const Node *b ) const
+	{
+		return a->next->i != b->i && a->prev->i != b->i && ! intersectsPolygon( a, b ) &&
+			( ( locallyInside( a, b ) && locallyInside( b, a ) && middleInside( a, b ) &&
+				( area( a->prev, a, b->prev ) != 0 || area( a, b->prev, b ) != 0 ) ) ||
+			  ( equals( a, b ) && area( a->prev, a, a->next ) > 0 && area( b->prev, b, b->next ) > 0 ) );
+	}
+
+	static float area( const Node *p, const Node *q, const Node *r )
+	{
+		return ( q->y - p->y ) * ( r->x - q->x ) - ( q->x - p->x ) * ( r->y - q->y );
+	}
+
+	static bool equals( const Node *p1, const Node *p2 )
+	{
+		return p1->x == p2->x && p1->y == p2->y;
+	}
+
+	static int sign( float v )
+	{
+		return ( v > 0 ) - ( v < 0 );
+	}
+
+	static bool onSegment( const Node *p, const Node *q, const Node *r )
+	{
+		return q->x <= std::max( p->x, r->x ) && q->x >= std::min( p->x, r->x ) && q->y <= std::max( p->y, r->y ) && q->y >= std::min( p->y, r->y );
+	}
+
+	static bool intersects( const Node *p1, const Node *q1, const Node *p2, const Node *q2 )
+	{
+		const int o1 = sign( area( p1, q1, p2 ) );
+		const int o2 = sign( area( p1, q1, q2 ) );
+		const int o3 = sign( area( p2, q2, p1 ) );
+		const int o4 = sign( area( p2, q2, q1 ) );
+
+		if( o1 != o2 && o3 != o4 ) return true; // general case
+		if( o1 == 0 && onSegment( p1, p2, q1 ) ) return true; // p1, q1 and p2 are collinear and p2 lies on p1q1
+		if( o2 == 0 && onSegment( p1, q2, q1 ) ) return true; // p1, q1 and q2 are collinear and q2 lies on p1q1
+		if( o3 == 0 && onSegment( p2, p1, q2 ) ) return true; // p2, q2 and p1 are collinear and p1 lies on p2q2
+		if( o4 == 0 && onSegment( p2, q1, q2 ) ) return true; // p2, q2 and q1 are collinear and q1 lies on p2q2
+
+		return false;
+	}
+
+	static bool intersectsPolygon( const Node *a, const Node *b )
+	{
+		const Node *p = a;
+		do {
+			if( p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && intersects( p, p->next, a, b ) )
+				return true;
+			p = p->next;
+		} while( p != a );
+
+		return false;
+	}
+
+	static bool locallyInside( const Node *a, const Node *b )
+	{
+		return area( a->prev, a, a->next ) < 0 ?
+			area( a, b, a->next ) >= 0 && area( a, a->prev, b ) >= 0 :
+			area( a, b, a->prev ) < 0 || area( a, a->next, b ) < 0;
+	}
+
+	static bool middleInside( const Node *a, const Node *b )
+	{
+		const Node *p = a;
+		bool inside = false;
+		const float px = ( a->x + b->x ) / 2, py = ( a->y + b->y ) / 2;
+		do {
+			if( ( ( p->y > py ) != ( p->next->y > py ) ) && p->next->y != p->y && ( px < ( p->next->x - p->x ) * ( py - p->y ) / ( p->next->y - p->y ) + p->x ) )
+				inside = ! inside;
+			p = p->next;
+		} while( p != a );
+
+		return inside;
+	}
+
+	// Links a and b with a bridge, splitting the polygon in two; if they belong to the same ring, or a single ring if they are in different rings
+	Node* splitPolygon( Node *a, Node *b )
+	{
+		Node *a2 = createNode( a->i, vec2( a->x, a->y ) );
+		Node *b2 = createNode( b->i, vec2( b->x, b->y ) );
+		Node *an = a->next;
+		Node *bp = b->prev;
+
+		a->next = b;
+		b->prev = a;
+
+		a2->next = an;
+		an->prev = a2;
+
+		b2->next = a2;
+		a2->prev = b2;
+
+		bp->next = b2;
+		b2->prev = bp;
+
+		return b2;
+	}
+
+	vector<unique_ptr<Node[]>>	mBlocks;
+	size_t						mNumUsed;
+	vector<Node*>				mQueue;
+	vector<uint32_t>			mIndices;
+	vec2						mMin;
+	float						mInvSize;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Triangulator
 Triangulator::Triangulator( const Path2d &path, float approximationScale )
 {	
 	allocate();
@@ -77,6 +658,8 @@ void Triangulator::allocate()
 	mTess = shared_ptr<TESStesselator>( tessNewTess( &ma ), tessDeleteTess );
 	if( ! mTess )
 		throw Triangulator::Exception();
+
+	mEarcut = make_shared<EarcutArena>();
 }
 
 void Triangulator::addShape( const Shape2d &shape, float approximationScale )
@@ -89,42 +672,154 @@ void Triangulator::addShape( const Shape2d &shape, float approximationScale )
 
 void Triangulator::addPath( const Path2d &path, float approximationScale )
 {
-	vector<vec2> subdivided = path.subdivide( approximationScale );
-	tessAddContour( mTess.get(), 2, &subdivided[0], sizeof(float) * 2, (int)subdivided.size() );
+	// flatten straight into the contour storage
+	const float tolerance = PathFlattener::calcTolerance( approximationScale );
+	const size_t begin = mPoints.size();
+	mPoints.resize( begin + PathFlattener::calcNumPoints( path, tolerance ) );
+	PathFlattener::flatten( path, tolerance, mPoints.data() + begin );
+	if( mPoints.size() > begin )
+		mContourEnds.push_back( (uint32_t)mPoints.size() );
 }
 
 void Triangulator::addPolyLine( const PolyLine2f &polyLine )
 {
-	if( polyLine.size() > 0 )
-		tessAddContour( mTess.get(), 2, &polyLine.getPoints()[0], sizeof(float) * 2, (int)polyLine.size() );
+	addContour( polyLine.getPoints().data(), polyLine.size() );
 }
 
 void Triangulator::addPolyLine( const vec2 *points, size_t numPoints )
 {
-	if( numPoints > 0 )
-		tessAddContour( mTess.get(), 2, &points, sizeof(vec2), (int)numPoints );
+	addContour( points, numPoints );
+}
+
+void Triangulator::addContour( const vec2 *points, size_t numPoints )
+{
+	if( numPoints == 0 )
+		return;
+
+	mPoints.insert( mPoints.end(), points, points + numPoints );
+	mContourEnds.push_back( (uint32_t)mPoints.size() );
+}
+
+void Triangulator::clear()
+{
+	mPoints.clear();
+	mContourEnds.clear();
 }
 
-TriMesh Triangulator::calcMesh( Winding winding )
+TriMesh Triangulator::calcMesh( Winding winding, Backend backend )
 {
 	TriMesh result( TriMesh::Format().positions( 2 ) );
-	
-	tessTesselate( mTess.get(), (int)winding, TESS_POLYGONS, 3, 2, 0 );
-	result.appendPositions( (vec2*)tessGetVertices( mTess.get() ), tessGetVertexCount( mTess.get() ) );
-	result.appendIndices( (uint32_t*)( tessGetElements( mTess.get() ) ), tessGetElementCount( mTess.get() ) * 3 );
+	calcMeshImpl( winding, backend, &result );
 	
 	return result;
 }
 
-TriMeshRef Triangulator::createMesh( Winding winding )
+TriMeshRef Triangulator::createMesh( Winding winding, Backend backend )
 {
 	TriMeshRef result = make_shared<TriMesh>( TriMesh::Format().positions( 2 ) );
+	calcMeshImpl( winding, backend, result.get() );
 	
+	return result;
+}
+
+void Triangulator::calcMeshLibtess( Winding winding, TriMesh *result )
+{
+	uint32_t begin = 0;
+	for( uint32_t end : mContourEnds ) {
+		tessAddContour( mTess.get(), 2, &mPoints[begin], sizeof(vec2), (int)( end - begin ) );
+		begin = end;
+	}
+
 	tessTesselate( mTess.get(), (int)winding, TESS_POLYGONS, 3, 2, 0 );
 	result->appendPositions( (vec2*)tessGetVertices( mTess.get() ), tessGetVertexCount( mTess.get() ) );
 	result->appendIndices( (uint32_t*)( tessGetElements( mTess.get() ) ), tessGetElementCount( mTess.get() ) * 3 );
-	
-	return result;
+	clear();
+}
+
+void Triangulator::calcMeshImpl( Winding winding, Backend backend, TriMesh *result )
+{
+	// libtess2 produces no output at all without contours
+	if( mContourEnds.empty() )
+		return;
+
+	if( backend == BACKEND_LIBTESS || ( winding != WINDING_ODD && winding != WINDING_NONZERO ) ) {
+		calcMeshLibtess( winding, result );
+		return;
+	}
+
+	// Contours are nested by testing each contour's first point for containment, after rejecting by bounding box. The winding number just inside
+	// a contour is its parent's plus its own orientation, so that under WINDING_NONZERO a contour with the same orientation as its parent stays filled.
+	const size_t numContours = mContourEnds.size();
+	vector<Rectf> bounds( numContours );
+	vector<int> orientations( numContours );
+	for( size_t c = 0; c < numContours; ++c ) {
+		uint32_t begin = c ? mContourEnds[c - 1] : 0, end = mContourEnds[c];
+		bounds[c] = Rectf( mPoints[begin], mPoints[begin] );
+		float area = 0;
+		for( uint32_t i = begin, j = end - 1; i < end; j = i++ ) {
+			bounds[c].include( mPoints[i] );
+			area += ( mPoints[j].x - mPoints[i].x ) * ( mPoints[i].y + mPoints[j].y );
+		}
+		orientations[c] = ( area > 0 ) - ( area < 0 );
+	}
+
+	auto contains = [&]( size_t outer, const vec2 &pt ) {
+		if( ! bounds[outer].contains( pt ) )
+			return false;
+		uint32_t begin = outer ? mContourEnds[outer - 1] : 0, end = mContourEnds[outer];
+		bool inside = false;
+		for( uint32_t i = begin, j = end - 1; i < end; j = i++ ) {
+			const vec2 &a = mPoints[i], &b = mPoints[j];
+			if( ( ( a.y > pt.y ) != ( b.y > pt.y ) ) && ( pt.x < ( b.x - a.x ) * ( pt.y - a.y ) / ( b.y - a.y ) + a.x ) )
+				inside = ! inside;
+		}
+		return inside;
+	};
+
+	vector<int> depths( numContours, 0 );
+	vector<size_t> parents( numContours, numContours );
+	for( size_t c = 0; c < numContours; ++c ) {
+		const vec2 &pt = mPoints[c ? mContourEnds[c - 1] : 0];
+		for( size_t o = 0; o < numContours; ++o ) {
+			if( o == c || ! contains( o, pt ) )
+				continue;
+			++depths[c];
+			if( parents[c] == numContours || bounds[o].calcArea() < bounds[parents[c]].calcArea() )
+				parents[c] = o;
+		}
+	}
+
+	// parents are always shallower than their children, so visiting by depth resolves the parent's winding number first
+	vector<size_t> order( numContours );
+	for( size_t c = 0; c < numContours; ++c )
+		order[c] = c;
+	sort( order.begin(), order.end(), [&]( size_t a, size_t b ) { return depths[a] < depths[b]; } );
+	vector<int> windings( numContours, 0 );
+	for( size_t c : order )
+		windings[c] = ( parents[c] == numContours ? 0 : windings[parents[c]] ) + orientations[c];
+
+	auto isFilled = [winding]( int windingNumber ) {
+		return ( winding == WINDING_ODD ) ? ( windingNumber % 2 != 0 ) : ( windingNumber != 0 );
+	};
+
+	mEarcut->clearIndices();
+	vector<pair<uint32_t, uint32_t>> holes;
+	for( size_t c = 0; c < numContours; ++c ) {
+		if( ! isFilled( windings[c] ) )
+			continue;
+
+		// every child is cut out; filled children are triangulated on their own
+		holes.clear();
+		for( size_t h = 0; h < numContours; ++h ) {
+			if( parents[h] == c )
+				holes.emplace_back( h ? mContourEnds[h - 1] : 0, mContourEnds[h] );
+		}
+		mEarcut->triangulate( mPoints.data(), c ? mContourEnds[c - 1] : 0, mContourEnds[c], holes );
+	}
+
+	result->appendPositions( mPoints.data(), mPoints.size() );
+	result->appendIndices( mEarcut->getIndices().data(), mEarcut->getIndices().size() );
+	clear();
 }
 
 } // namespace cinder
@@ -26,11 +26,204 @@
 #include "cinder/Timeline.h"
 
 #include <algorithm>
+#include <typeinfo>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define CINDER_EASING_SSE2
+	#include <emmintrin.h>
+#elif defined( __ARM_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+	#define CINDER_EASING_NEON
+	#include <arm_neon.h>
+#endif
 
 using namespace std;
 
 namespace cinder {
 
+namespace {
+
+// The polynomial and circular easing curves are evaluated 4 values at a time. Each kernel below repeats the arithmetic of its
+// function in Easing.h, in the same order, but computes both halves of the piecewise curves and selects between them.
+#if defined( CINDER_EASING_SSE2 )
+struct Float4 {
+	static Float4	load( const float *src )			{ return Float4{ _mm_loadu_ps( src ) }; }
+	void			store( float *dst ) const			{ _mm_storeu_ps( dst, mV ); }
+
+	__m128	mV;
+};
+
+inline Float4 splat( float f )							{ return Float4{ _mm_set1_ps( f ) }; }
+inline Float4 operator+( Float4 a, Float4 b )			{ return Float4{ _mm_add_ps( a.mV, b.mV ) }; }
+inline Float4 operator-( Float4 a, Float4 b )			{ return Float4{ _mm_sub_ps( a.mV, b.mV ) }; }
+inline Float4 operator*( Float4 a, Float4 b )			{ return Float4{ _mm_mul_ps( a.mV, b.mV ) }; }
+inline Float4 operator-( Float4 a )						{ return Float4{ _mm_xor_ps( a.mV, _mm_set1_ps( -0.0f ) ) }; }
+inline Float4 sqrt( Float4 a )							{ return Float4{ _mm_sqrt_ps( a.mV ) }; }
+inline __m128 operator<( Float4 a, float b )			{ return _mm_cmplt_ps( a.mV, _mm_set1_ps( b ) ); }
+inline Float4 select( __m128 mask, Float4 a, Float4 b )	{ return Float4{ _mm_or_ps( _mm_and_ps( mask, a.mV ), _mm_andnot_ps( mask, b.mV ) ) }; }
+#elif defined( CINDER_EASING_NEON )
+struct Float4 {
+	static Float4	load( const float *src )			{ return Float4{ vld1q_f32( src ) }; }
+	void			store( float *dst ) const			{ vst1q_f32( dst, mV ); }
+
+	float32x4_t	mV;
+};
+
+inline Float4 splat( float f )								{ return Float4{ vdupq_n_f32( f ) }; }
+inline Float4 operator+( Float4 a, Float4 b )				{ return Float4{ vaddq_f32( a.mV, b.mV ) }; }
+inline Float4 operator-( Float4 a, Float4 b )				{ return Float4{ vsubq_f32( a.mV, b.mV ) }; }
+inline Float4 operator*( Float4 a, Float4 b )				{ return Float4{ vmulq_f32( a.mV, b.mV ) }; }
+inline Float4 operator-( Float4 a )							{ return Float4{ vnegq_f32( a.mV ) }; }
+inline Float4 sqrt( Float4 a )								{ return Float4{ vsqrtq_f32( a.mV ) }; }
+inline uint32x4_t operator<( Float4 a, float b )			{ return vcltq_f32( a.mV, vdupq_n_f32( b ) ); }
+inline Float4 select( uint32x4_t mask, Float4 a, Float4 b )	{ return Float4{ vbslq_f32( mask, a.mV, b.mV ) }; }
+#endif
+
+#if defined( CINDER_EASING_SSE2 ) || defined( CINDER_EASING_NEON )
+inline Float4 operator+( Float4 a, float b )	{ return a + splat( b ); }
+inline Float4 operator-( Float4 a, float b )	{ return a - splat( b ); }
+inline Float4 operator-( float a, Float4 b )	{ return splat( a ) - b; }
+inline Float4 operator*( Float4 a, float b )	{ return a * splat( b ); }
+inline Float4 operator*( float a, Float4 b )	{ return splat( a ) * b; }
+#endif
+
+// the scalar editions, used for the values left over after the last group of 4
+inline float sqrt( float a )						{ return math<float>::sqrt( a ); }
+inline float select( bool mask, float a, float b )	{ return mask ? a : b; }
+
+struct InQuadKernel { template<typename V> static V apply( V t ) { return t*t; } };
+struct OutQuadKernel { template<typename V> static V apply( V t ) { return -t * ( t - 2 ); } };
+struct InOutQuadKernel {
+	template<typename V> static V apply( V t )
+	{
+		t = t * 2;
+		V u = t - 1;
+		return select( t < 1, 0.5f * t * t, -0.5f * ((u)*(u-2) - 1) );
+	}
+};
+
+struct InCubicKernel { template<typename V> static V apply( V t ) { return t*t*t; } };
+struct OutCubicKernel { template<typename V> static V apply( V t ) { t = t - 1; return t*t*t + 1; } };
+struct InOutCubicKernel {
+	template<typename V> static V apply( V t )
+	{
+		t = t * 2;
+		V u = t - 2;
+		return select( t < 1, 0.5f * t*t*t, 0.5f*(u*u*u + 2) );
+	}
+};
+
+struct InQuartKernel { template<typename V> static V apply( V t ) { return t*t*t*t; } };
+struct OutQuartKernel { template<typename V> static V apply( V t ) { t = t - 1; return -(t*t*t*t - 1); } };
+struct InOutQuartKernel {
+	template<typename V> static V apply( V t )
+	{
+		t = t * 2;
+		V u = t - 2;
+		return select( t < 1, 0.5f*t*t*t*t, -0.5f * (u*u*u*u - 2) );
+	}
+};
+
+struct InQuintKernel { template<typename V> static V apply( V t ) { return t*t*t*t*t; } };
+struct OutQuintKernel { template<typename V> static V apply( V t ) { t = t - 1; return t*t*t*t*t + 1; } };
+struct InOutQuintKernel {
+	template<typename V> static V apply( V t )
+	{
+		t = t * 2;
+		V u = t - 2;
+		return select( t < 1, 0.5f*t*t*t*t*t, 0.5f*(u*u*u*u*u + 2) );
+	}
+};
+
+struct InCircKernel { template<typename V> static V apply( V t ) { return -( sqrt( 1 - t*t ) - 1); } };
+struct OutCircKernel { template<typename V> static V apply( V t ) { t = t - 1; return sqrt( 1 - t*t ); } };
+struct InOutCircKernel {
+	template<typename V> static V apply( V t )
+	{
+		t = t * 2;
+		V u = t - 2;
+		return select( t < 1, -0.5f * (sqrt( 1 - t*t ) - 1), 0.5f * (sqrt( 1 - u*u ) + 1) );
+	}
+};
+
+// the ease-out/in curves of Easing.h join the ease-out curve, scaled into the first half, to the ease-in curve in the second half
+template<typename OutKernel, typename InKernel>
+struct OutInKernel {
+	template<typename V> static V apply( V t )
+	{
+		return select( t < 0.5f, OutKernel::apply( t * 2 ) * 0.5f, InKernel::apply( 2*t - 1 ) * 0.5f + 0.5f );
+	}
+};
+
+template<typename Kernel>
+void easeBatchKernel( const float *t, float *result, size_t count )
+{
+	size_t i = 0;
+#if defined( CINDER_EASING_SSE2 ) || defined( CINDER_EASING_NEON )
+	for( ; i + 4 <= count; i += 4 )
+		Kernel::apply( Float4::load( t + i ) ).store( result + i );
+#endif
+	for( ; i < count; ++i )
+		result[i] = Kernel::apply( t[i] );
+}
+
+struct EaseBatchEntry {
+	float				(*mFn)( float );
+	const type_info		*mFunctorType;
+	EaseBatchFn			mBatchFn;
+};
+
+template<typename EaseT>
+EaseBatchEntry makeEaseBatchEntry( float (*fn)( float ) )
+{
+	return EaseBatchEntry{ fn, &typeid( EaseT ), getEaseBatchFn<EaseT>() };
+}
+
+template<typename EaseT, typename Kernel>
+EaseBatchEntry makeEaseBatchEntry( float (*fn)( float ) )
+{
+	return EaseBatchEntry{ fn, &typeid( EaseT ), &easeBatchKernel<Kernel> };
+}
+
+const vector<EaseBatchEntry>& getEaseBatchEntries()
+{
+	static const vector<EaseBatchEntry> sEntries = {
+		makeEaseBatchEntry<EaseNone>( &easeNone ),
+		makeEaseBatchEntry<EaseInQuad, InQuadKernel>( &easeInQuad ), makeEaseBatchEntry<EaseOutQuad, OutQuadKernel>( &easeOutQuad ),
+		makeEaseBatchEntry<EaseInOutQuad, InOutQuadKernel>( &easeInOutQuad ), makeEaseBatchEntry<EaseOutInQuad, OutInKernel<OutQuadKernel, InQuadKernel>>( &easeOutInQuad ),
+		makeEaseBatchEntry<EaseInCubic, InCubicKernel>( &easeInCubic ), makeEaseBatchEntry<EaseOutCubic, OutCubicKernel>( &easeOutCubic ),
+		makeEaseBatchEntry<EaseInOutCubic, InOutCubicKernel>( &easeInOutCubic ), makeEaseBatchEntry<EaseOutInCubic, OutInKernel<OutCubicKernel, InCubicKernel>>( &easeOutInCubic ),
+		makeEaseBatchEntry<EaseInQuart, InQuartKernel>( &easeInQuart ), makeEaseBatchEntry<EaseOutQuart, OutQuartKernel>( &easeOutQuart ),
+		makeEaseBatchEntry<EaseInOutQuart, InOutQuartKernel>( &easeInOutQuart ), makeEaseBatchEntry<EaseOutInQuart, OutInKernel<OutQuartKernel, InQuartKernel>>( &easeOutInQuart ),
+		makeEaseBatchEntry<EaseInQuint, InQuintKernel>( &easeInQuint ), makeEaseBatchEntry<EaseOutQuint, OutQuintKernel>( &easeOutQuint ),
+		makeEaseBatchEntry<EaseInOutQuint, InOutQuintKernel>( &easeInOutQuint ), makeEaseBatchEntry<EaseOutInQuint, OutInKernel<OutQuintKernel, InQuintKernel>>( &easeOutInQuint ),
+		makeEaseBatchEntry<EaseInSine>( &easeInSine ), makeEaseBatchEntry<EaseOutSine>( &easeOutSine ),
+		makeEaseBatchEntry<EaseInOutSine>( &easeInOutSine ), makeEaseBatchEntry<EaseOutInSine>( &easeOutInSine ),
+		makeEaseBatchEntry<EaseInExpo>( &easeInExpo ), makeEaseBatchEntry<EaseOutExpo>( &easeOutExpo ),
+		makeEaseBatchEntry<EaseInOutExpo>( &easeInOutExpo ), makeEaseBatchEntry<EaseOutInExpo>( &easeOutInExpo ),
+		makeEaseBatchEntry<EaseInCirc, InCircKernel>( &easeInCirc ), makeEaseBatchEntry<EaseOutCirc, OutCircKernel>( &easeOutCirc ),
+		makeEaseBatchEntry<EaseInOutCirc, InOutCircKernel>( &easeInOutCirc ), makeEaseBatchEntry<EaseOutInCirc, OutInKernel<OutCircKernel, InCircKernel>>( &easeOutInCirc )
+	};
+	return sEntries;
+}
+
+} // anonymous namespace
+
+EaseBatchFn findEaseBatchFn( const EaseFn &ease )
+{
+	if( ! ease )
+		return nullptr;
+
+	typedef float (*EaseFnPtr)( float );
+	const EaseFnPtr *fn = ease.target<EaseFnPtr>();
+	for( const auto &entry : getEaseBatchEntries() ) {
+		if( fn ? ( *fn == entry.mFn ) : ( ease.target_type() == *entry.mFunctorType ) )
+			return entry.mBatchFn;
+	}
+
+	return nullptr;
+}
+
 TweenBase::TweenBase( void *target, bool copyStartValue, float startTime, float duration, EaseFn easeFunction )
 	: TimelineItem( 0, target, startTime, duration ), mCopyStartValue( copyStartValue ), mEaseFunction( easeFunction )
 {
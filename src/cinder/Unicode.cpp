@@ -45,9 +45,19 @@
  */
 
 #include "cinder/Unicode.h"
+#include <algorithm>
+#include <bitset>
 #include <cstring>
 #include <string>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define CINDER_UNICODE_SSE2
+	#include <emmintrin.h>
+#elif defined( __ARM_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+	#define CINDER_UNICODE_NEON
+	#include <arm_neon.h>
+#endif
+
 #include "utf8cpp/checked.h"
 extern "C" {
 #include "linebreak.h"
@@ -72,21 +82,428 @@ static const int halfShift = 10; // shift by 10 bits
 #define UNI_MAX_UTF32			(char32_t)0x7FFFFFFF
 #define UNI_MAX_LEGAL_UTF32		(char32_t)0x0010FFFF
 
+namespace {
+
+const uint32_t INVALID_CODE_POINT = 0xFFFFFFFF;
+
+// The routines below transcode 16 bytes or 8 code units at a time while the text is ASCII, and one code point at a time otherwise.
+// They only accept well-formed input; whenever they meet anything else the public functions fall back to utf8cpp, which reports the error.
+
+// Returns whether the 16 bytes at 'src' are all ASCII
+inline bool isAscii16( const uint8_t *src )
+{
+#if defined( CINDER_UNICODE_SSE2 )
+	return _mm_movemask_epi8( _mm_loadu_si128( (const __m128i*)src ) ) == 0;
+#elif defined( CINDER_UNICODE_NEON )
+	return vmaxvq_u8( vld1q_u8( src ) ) < 0x80;
+#else
+	uint64_t a, b;
+	memcpy( &a, src, 8 );
+	memcpy( &b, src + 8, 8 );
+	return ( ( a | b ) & 0x8080808080808080ULL ) == 0;
+#endif
+}
+
+// Widens the 16 ASCII bytes at 'src' into 'dst'
+inline void widen16( const uint8_t *src, char16_t *dst )
+{
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_loadu_si128( (const __m128i*)src ), zero = _mm_setzero_si128();
+	_mm_storeu_si128( (__m128i*)dst, _mm_unpacklo_epi8( v, zero ) );
+	_mm_storeu_si128( (__m128i*)( dst + 8 ), _mm_unpackhi_epi8( v, zero ) );
+#elif defined( CINDER_UNICODE_NEON )
+	uint8x16_t v = vld1q_u8( src );
+	vst1q_u16( (uint16_t*)dst, vmovl_u8( vget_low_u8( v ) ) );
+	vst1q_u16( (uint16_t*)( dst + 8 ), vmovl_high_u8( v ) );
+#else
+	for( int i = 0; i < 16; ++i )
+		dst[i] = src[i];
+#endif
+}
+
+// Widens the 16 ASCII bytes at 'src' into 'dst'
+inline void widen16( const uint8_t *src, char32_t *dst )
+{
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_loadu_si128( (const __m128i*)src ), zero = _mm_setzero_si128();
+	__m128i lo = _mm_unpacklo_epi8( v, zero ), hi = _mm_unpackhi_epi8( v, zero );
+	_mm_storeu_si128( (__m128i*)dst, _mm_unpacklo_epi16( lo, zero ) );
+	_mm_storeu_si128( (__m128i*)( dst + 4 ), _mm_unpackhi_epi16( lo, zero ) );
+	_mm_storeu_si128( (__m128i*)( dst + 8 ), _mm_unpacklo_epi16( hi, zero ) );
+	_mm_storeu_si128( (__m128i*)( dst + 12 ), _mm_unpackhi_epi16( hi, zero ) );
+#elif defined( CINDER_UNICODE_NEON )
+	uint8x16_t v = vld1q_u8( src );
+	uint16x8_t lo = vmovl_u8( vget_low_u8( v ) ), hi = vmovl_high_u8( v );
+	vst1q_u32( (uint32_t*)dst, vmovl_u16( vget_low_u16( lo ) ) );
+	vst1q_u32( (uint32_t*)( dst + 4 ), vmovl_high_u16( lo ) );
+	vst1q_u32( (uint32_t*)( dst + 8 ), vmovl_u16( vget_low_u16( hi ) ) );
+	vst1q_u32( (uint32_t*)( dst + 12 ), vmovl_high_u16( hi ) );
+#else
+	for( int i = 0; i < 16; ++i )
+		dst[i] = src[i];
+#endif
+}
+
+// Returns whether the 8 code units at 'src' are all ASCII
+inline bool isAscii8( const char16_t *src )
+{
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_loadu_si128( (const __m128i*)src );
+	return _mm_movemask_epi8( _mm_cmpeq_epi16( _mm_and_si128( v, _mm_set1_epi16( (short)0xFF80 ) ), _mm_setzero_si128() ) ) == 0xFFFF;
+#elif defined( CINDER_UNICODE_NEON )
+	return vmaxvq_u16( vld1q_u16( (const uint16_t*)src ) ) < 0x80;
+#else
+	uint16_t bits = 0;
+	for( int i = 0; i < 8; ++i )
+		bits |= src[i];
+	return bits < 0x80;
+#endif
+}
+
+// Returns whether the 8 code points at 'src' are all ASCII
+inline bool isAscii8( const char32_t *src )
+{
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_or_si128( _mm_loadu_si128( (const __m128i*)src ), _mm_loadu_si128( (const __m128i*)( src + 4 ) ) );
+	return _mm_movemask_epi8( _mm_cmpeq_epi32( _mm_and_si128( v, _mm_set1_epi32( (int)0xFFFFFF80 ) ), _mm_setzero_si128() ) ) == 0xFFFF;
+#elif defined( CINDER_UNICODE_NEON )
+	return vmaxvq_u32( vorrq_u32( vld1q_u32( (const uint32_t*)src ), vld1q_u32( (const uint32_t*)( src + 4 ) ) ) ) < 0x80;
+#else
+	char32_t bits = 0;
+	for( int i = 0; i < 8; ++i )
+		bits |= src[i];
+	return bits < 0x80;
+#endif
+}
+
+// Narrows the 8 code units at 'src' into 'dst' if they are all ASCII, returning whether they were
+inline bool narrow8( const char16_t *src, uint8_t *dst )
+{
+	if( ! isAscii8( src ) )
+		return false;
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_loadu_si128( (const __m128i*)src );
+	_mm_storel_epi64( (__m128i*)dst, _mm_packus_epi16( v, v ) );
+#elif defined( CINDER_UNICODE_NEON )
+	vst1_u8( dst, vmovn_u16( vld1q_u16( (const uint16_t*)src ) ) );
+#else
+	for( int i = 0; i < 8; ++i )
+		dst[i] = (uint8_t)src[i];
+#endif
+	return true;
+}
+
+// Narrows the 8 code points at 'src' into 'dst' if they are all ASCII, returning whether they were
+inline bool narrow8( const char32_t *src, uint8_t *dst )
+{
+	if( ! isAscii8( src ) )
+		return false;
+#if defined( CINDER_UNICODE_SSE2 )
+	__m128i v = _mm_packs_epi32( _mm_loadu_si128( (const __m128i*)src ), _mm_loadu_si128( (const __m128i*)( src + 4 ) ) );
+	_mm_storel_epi64( (__m128i*)dst, _mm_packus_epi16( v, v ) );
+#elif defined( CINDER_UNICODE_NEON )
+	uint32x4_t a = vld1q_u32( (const uint32_t*)src ), b = vld1q_u32( (const uint32_t*)( src + 4 ) );
+	vst1_u8( dst, vmovn_u16( vcombine_u16( vmovn_u32( a ), vmovn_u32( b ) ) ) );
+#else
+	for( int i = 0; i < 8; ++i )
+		dst[i] = (uint8_t)src[i];
+#endif
+	return true;
+}
+
+// Counts the code points and the UTF-16 code units needed by well-formed UTF-8 text; the result is meaningless for malformed text
+void countUtf8( const uint8_t *src, size_t length, size_t *numCodePoints, size_t *numUtf16 )
+{
+	size_t continuations = 0, fourByteLeads = 0;
+	size_t i = 0;
+	for( ; i + 16 <= length; i += 16 ) {
+#if defined( CINDER_UNICODE_SSE2 )
+		__m128i v = _mm_loadu_si128( (const __m128i*)( src + i ) );
+		if( _mm_movemask_epi8( v ) == 0 )
+			continue;
+		// continuation bytes are 0x80-0xBF, signed -128 to -65; four byte leads are 0xF0 and above, signed -16 to -1
+		__m128i continuation = _mm_cmplt_epi8( v, _mm_set1_epi8( -64 ) );
+		__m128i fourByteLead = _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( -17 ) ), _mm_cmplt_epi8( v, _mm_setzero_si128() ) );
+		continuations += std::bitset<16>( _mm_movemask_epi8( continuation ) ).count();
+		fourByteLeads += std::bitset<16>( _mm_movemask_epi8( fourByteLead ) ).count();
+#elif defined( CINDER_UNICODE_NEON )
+		uint8x16_t v = vld1q_u8( src + i );
+		if( vmaxvq_u8( v ) < 0x80 )
+			continue;
+		uint8x16_t continuation = vcltq_s8( vreinterpretq_s8_u8( v ), vdupq_n_s8( -64 ) );
+		uint8x16_t fourByteLead = vcgeq_u8( v, vdupq_n_u8( 0xF0 ) );
+		continuations += vaddvq_u8( vshrq_n_u8( continuation, 7 ) );
+		fourByteLeads += vaddvq_u8( vshrq_n_u8( fourByteLead, 7 ) );
+#else
+		if( isAscii16( src + i ) )
+			continue;
+		for( size_t j = i; j < i + 16; ++j ) {
+			continuations += ( src[j] & 0xC0 ) == 0x80;
+			fourByteLeads += src[j] >= 0xF0;
+		}
+#endif
+	}
+	for( ; i < length; ++i ) {
+		continuations += ( src[i] & 0xC0 ) == 0x80;
+		fourByteLeads += src[i] >= 0xF0;
+	}
+
+	*numCodePoints = length - continuations;
+	*numUtf16 = *numCodePoints + fourByteLeads;
+}
+
+// Decodes the well-formed UTF-8 sequence at 'src' and advances past it, or returns INVALID_CODE_POINT leaving 'src' unchanged
+inline uint32_t decodeUtf8( const uint8_t *&src, const uint8_t *end )
+{
+	uint32_t c = src[0];
+	if( c < 0x80 ) {
+		++src;
+		return c;
+	}
+	else if( c < 0xC2 ) {
+		return INVALID_CODE_POINT; // continuation byte, or an overlong two byte sequence
+	}
+	else if( c < 0xE0 ) {
+		if( ( end - src < 2 ) || ( ( src[1] & 0xC0 ) != 0x80 ) )
+			return INVALID_CODE_POINT;
+		c = ( ( c & 0x1F ) << 6 ) | ( src[1] & 0x3F );
+		src += 2;
+		return c;
+	}
+	else if( c < 0xF0 ) {
+		if( ( end - src < 3 ) || ( ( src[1] & 0xC0 ) != 0x80 ) || ( ( src[2] & 0xC0 ) != 0x80 ) )
+			return INVALID_CODE_POINT;
+		c = ( ( c & 0x0F ) << 12 ) | ( ( src[1] & 0x3F ) << 6 ) | ( src[2] & 0x3F );
+		if( ( c < 0x800 ) || ( c >= UNI_SUR_HIGH_START && c <= UNI_SUR_LOW_END ) )
+			return INVALID_CODE_POINT;
+		src += 3;
+		return c;
+	}
+	else if( c < 0xF5 ) {
+		if( ( end - src < 4 ) || ( ( src[1] & 0xC0 ) != 0x80 ) || ( ( src[2] & 0xC0 ) != 0x80 ) || ( ( src[3] & 0xC0 ) != 0x80 ) )
+			return INVALID_CODE_POINT;
+		c = ( ( c & 0x07 ) << 18 ) | ( ( src[1] & 0x3F ) << 12 ) | ( ( src[2] & 0x3F ) << 6 ) | ( src[3] & 0x3F );
+		if( ( c < 0x10000 ) || ( c > UNI_MAX_LEGAL_UTF32 ) )
+			return INVALID_CODE_POINT;
+		src += 4;
+		return c;
+	}
+
+	return INVALID_CODE_POINT;
+}
+
+// Writes 'c', which must be a valid code point, as UTF-8 and advances 'dst'
+inline void encodeUtf8( char32_t c, uint8_t *&dst )
+{
+	if( c < 0x80 ) {
+		*dst++ = (uint8_t)c;
+	}
+	else if( c < 0x800 ) {
+		*dst++ = (uint8_t)( 0xC0 | ( c >> 6 ) );
+		*dst++ = (uint8_t)( 0x80 | ( c & 0x3F ) );
+	}
+	else if( c < 0x10000 ) {
+		*dst++ = (uint8_t)( 0xE0 | ( c >> 12 ) );
+		*dst++ = (uint8_t)( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+		*dst++ = (uint8_t)( 0x80 | ( c & 0x3F ) );
+	}
+	else {
+		*dst++ = (uint8_t)( 0xF0 | ( c >> 18 ) );
+		*dst++ = (uint8_t)( 0x80 | ( ( c >> 12 ) & 0x3F ) );
+		*dst++ = (uint8_t)( 0x80 | ( ( c >> 6 ) & 0x3F ) );
+		*dst++ = (uint8_t)( 0x80 | ( c & 0x3F ) );
+	}
+}
+
+// Transcodes well-formed UTF-8 into 'result', which must already be sized by countUtf8(). Returns false for malformed input.
+template<typename StringT>
+bool utf8ToUtf( const uint8_t *src, size_t length, StringT *result )
+{
+	const uint8_t *end = src + length;
+	auto *dst = &(*result)[0];
+	auto *dstEnd = dst + result->size();
+	while( src < end ) {
+		if( end - src >= 16 && isAscii16( src ) ) {
+			widen16( src, dst );
+			src += 16;
+			dst += 16;
+			continue;
+		}
+
+		// decode at least the remainder of this block one code point at a time
+		const uint8_t *blockEnd = std::min( src + 16, end );
+		while( src < blockEnd ) {
+			uint32_t c = decodeUtf8( src, end );
+			if( c == INVALID_CODE_POINT )
+				return false;
+			if( sizeof( *dst ) == 2 && c > UNI_MAX_BMP ) {
+				c -= halfBase;
+				*dst++ = (char16_t)( ( c >> halfShift ) + UNI_SUR_HIGH_START );
+				*dst++ = (char16_t)( ( c & halfMask ) + UNI_SUR_LOW_START );
+			}
+			else
+				*dst++ = c;
+		}
+	}
+
+	return dst == dstEnd;
+}
+
+// Returns the UTF-8 length of well-formed UTF-16 text; each half of a surrogate pair counts two bytes
+size_t countUtf8Bytes( const char16_t *src, size_t length )
+{
+	size_t result = 0;
+	size_t i = 0;
+	while( i < length ) {
+		if( i + 8 <= length && isAscii8( src + i ) ) {
+			result += 8;
+			i += 8;
+			continue;
+		}
+		for( size_t blockEnd = std::min( i + 8, length ); i < blockEnd; ++i ) {
+			char16_t c = src[i];
+			result += 1 + ( c >= 0x80 ) + ( c >= 0x800 ) - ( c >= UNI_SUR_HIGH_START && c <= UNI_SUR_LOW_END );
+		}
+	}
+
+	return result;
+}
+
+// Returns the UTF-8 length of UTF-32 text, which must only contain valid code points
+size_t countUtf8Bytes( const char32_t *src, size_t length )
+{
+	size_t result = 0;
+	size_t i = 0;
+	while( i < length ) {
+		if( i + 8 <= length && isAscii8( src + i ) ) {
+			result += 8;
+			i += 8;
+			continue;
+		}
+		for( size_t blockEnd = std::min( i + 8, length ); i < blockEnd; ++i ) {
+			char32_t c = src[i];
+			result += 1 + ( c >= 0x80 ) + ( c >= 0x800 ) + ( c >= 0x10000 );
+		}
+	}
+
+	return result;
+}
+
+// Transcodes well-formed UTF-16 into 'result', which must already be sized by countUtf8Bytes(). Returns false for unpaired surrogates.
+bool utf16ToUtf8( const char16_t *src, size_t length, std::string *result )
+{
+	const char16_t *end = src + length;
+	uint8_t *dst = (uint8_t*)&(*result)[0];
+	while( src < end ) {
+		if( end - src >= 8 && narrow8( src, dst ) ) {
+			src += 8;
+			dst += 8;
+			continue;
+		}
+
+		const char16_t *blockEnd = std::min( src + 8, end );
+		while( src < blockEnd ) {
+			char32_t c = *src++;
+			if( c >= UNI_SUR_HIGH_START && c <= UNI_SUR_LOW_END ) {
+				if( c > UNI_SUR_HIGH_END || src == end || *src < UNI_SUR_LOW_START || *src > UNI_SUR_LOW_END )
+					return false;
+				c = ( ( c - UNI_SUR_HIGH_START ) << halfShift ) + ( *src++ - UNI_SUR_LOW_START ) + halfBase;
+			}
+			encodeUtf8( c, dst );
+		}
+	}
+
+	return true;
+}
+
+// Transcodes UTF-32 validated by isValidUtf32() into 'result', which must already be sized by countUtf8Bytes()
+void utf32ToUtf8( const char32_t *src, size_t length, std::string *result )
+{
+	const char32_t *end = src + length;
+	uint8_t *dst = (uint8_t*)&(*result)[0];
+	while( src < end ) {
+		if( end - src >= 8 && narrow8( src, dst ) ) {
+			src += 8;
+			dst += 8;
+			continue;
+		}
+
+		const char32_t *blockEnd = std::min( src + 8, end );
+		while( src < blockEnd )
+			encodeUtf8( *src++, dst );
+	}
+}
+
+bool isValidUtf32( const char32_t *src, size_t length )
+{
+	for( size_t i = 0; i < length; ++i ) {
+		if( ( src[i] > UNI_MAX_LEGAL_UTF32 ) || ( src[i] >= UNI_SUR_HIGH_START && src[i] <= UNI_SUR_LOW_END ) )
+			return false;
+	}
+	return true;
+}
+
+std::u16string utf8ToUtf16( const char *utf8Str, size_t lengthInBytes )
+{
+	size_t numCodePoints, numUtf16;
+	countUtf8( (const uint8_t*)utf8Str, lengthInBytes, &numCodePoints, &numUtf16 );
+	std::u16string result( numUtf16, 0 );
+	if( ! utf8ToUtf( (const uint8_t*)utf8Str, lengthInBytes, &result ) ) {
+		// malformed; let utf8cpp throw the appropriate utf8::exception
+		result.clear();
+		utf8::utf8to16( utf8Str, utf8Str + lengthInBytes, back_inserter( result ) );
+	}
+	return result;
+}
+
+std::u32string utf8ToUtf32( const char *utf8Str, size_t lengthInBytes )
+{
+	size_t numCodePoints, numUtf16;
+	countUtf8( (const uint8_t*)utf8Str, lengthInBytes, &numCodePoints, &numUtf16 );
+	std::u32string result( numCodePoints, 0 );
+	if( ! utf8ToUtf( (const uint8_t*)utf8Str, lengthInBytes, &result ) ) {
+		result.clear();
+		utf8::utf8to32( utf8Str, utf8Str + lengthInBytes, back_inserter( result ) );
+	}
+	return result;
+}
+
+std::string utf16ToUtf8( const char16_t *utf16Str, size_t length )
+{
+	std::string result( countUtf8Bytes( utf16Str, length ), 0 );
+	if( ! utf16ToUtf8( utf16Str, length, &result ) ) {
+		result.clear();
+		utf8::utf16to8( utf16Str, utf16Str + length, back_inserter( result ) );
+	}
+	return result;
+}
+
+std::string utf32ToUtf8( const char32_t *utf32Str, size_t length )
+{
+	if( ! isValidUtf32( utf32Str, length ) ) {
+		std::string result;
+		utf8::utf32to8( utf32Str, utf32Str + length, back_inserter( result ) );
+		return result;
+	}
+
+	std::string result( countUtf8Bytes( utf32Str, length ), 0 );
+	utf32ToUtf8( utf32Str, length, &result );
+	return result;
+}
+
+} // anonymous namespace
+
 std::u16string toUtf16( const char *utf8Str, size_t lengthInBytes )
 {
 	if( lengthInBytes == 0 )
 		lengthInBytes = strlen( utf8Str );
 	
-	std::u16string result;
-	utf8::utf8to16( utf8Str, utf8Str + lengthInBytes, back_inserter( result ));
-	return result;
+	return utf8ToUtf16( utf8Str, lengthInBytes );
 }
 
 std::u16string toUtf16( const std::string &utf8Str )
 {
-	std::u16string result;
-	utf8::utf8to16( utf8Str.begin(), utf8Str.end(), back_inserter( result ));
-	return result;
+	return utf8ToUtf16( utf8Str.data(), utf8Str.size() );
 }
 
 std::u32string toUtf32( const char *utf8Str, size_t lengthInBytes )
@@ -94,16 +511,12 @@ std::u32string toUtf32( const char *utf8Str, size_t lengthInBytes )
 	if( lengthInBytes == 0 )
 		lengthInBytes = strlen( utf8Str );
 	
-	std::u32string result;
-	utf8::utf8to32( utf8Str, utf8Str + lengthInBytes, back_inserter( result ));
-	return result;
+	return utf8ToUtf32( utf8Str, lengthInBytes );
 }
 
 std::u32string toUtf32( const std::string &utf8Str )
 {
-	std::u32string result;
-	utf8::utf8to32( utf8Str.begin(), utf8Str.end(), back_inserter( result ));
-	return result;
+	return utf8ToUtf32( utf8Str.data(), utf8Str.size() );
 }
 
 std::string toUtf8( const char16_t *utf16Str, size_t lengthInBytes )
@@ -114,16 +527,12 @@ std::string toUtf8( const char16_t *utf16Str, size_t lengthInBytes )
 	else
 		lengthInBytes /= 2;
 
-	std::string result;
-	utf8::utf16to8( utf16Str, utf16Str + lengthInBytes, back_inserter( result ));
-	return result;	
+	return utf16ToUtf8( utf16Str, lengthInBytes );
 }
 
 std::string	toUtf8( const std::u16string &utf16Str )
 {
-	std::string result;
-	utf8::utf16to8( utf16Str.begin(), utf16Str.end(), back_inserter( result ));
-	return result;
+	return utf16ToUtf8( utf16Str.data(), utf16Str.size() );
 }
 
 std::string toUtf8( const char32_t *utf32Str, size_t lengthInBytes )
@@ -134,26 +543,62 @@ std::string toUtf8( const char32_t *utf32Str, size_t lengthInBytes )
 	else
 		lengthInBytes /= 4;
 
-	std::string result;
-	utf8::utf32to8( utf32Str, utf32Str + lengthInBytes, back_inserter( result ));
-	return result;
+	return utf32ToUtf8( utf32Str, lengthInBytes );
 }
 
-std::string	toUtf8( const std::u32string &utf32Str )
+std::string toUtf8( const std::u32string &utf32Str )
 {
-	std::string result;
-	utf8::utf32to8( utf32Str.begin(), utf32Str.end(), back_inserter( result ));
-	return result;
+	return utf32ToUtf8( utf32Str.data(), utf32Str.size() );
+}
+
+bool isValidUtf8( const char *str, size_t lengthInBytes )
+{
+	if( lengthInBytes == 0 )
+		lengthInBytes = strlen( str );
+
+	const uint8_t *src = (const uint8_t*)str, *end = src + lengthInBytes;
+	while( src < end ) {
+		if( end - src >= 16 && isAscii16( src ) ) {
+			src += 16;
+			continue;
+		}
+		const uint8_t *blockEnd = std::min( src + 16, end );
+		while( src < blockEnd ) {
+			if( decodeUtf8( src, end ) == INVALID_CODE_POINT )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool isValidUtf8( const std::string &str )
+{
+	return str.empty() || isValidUtf8( str.data(), str.size() );
 }
 
 size_t stringLengthUtf8( const char *str, size_t lengthInBytes )
 {
-	size_t result = 0;
-	size_t nextByte = 0;
 	if( lengthInBytes == 0 )
 		lengthInBytes = strlen( str );
-	while( nextCharUtf8( (const char*)str, &nextByte, lengthInBytes ) != 0xFFFF )
+
+	// steps exactly like nextCharUtf8(), which stops at a truncated sequence or a decoded U+FFFF, but skips ASCII 16 bytes at a time
+	const uint8_t *src = (const uint8_t*)str;
+	size_t result = 0;
+	size_t i = 0;
+	while( i < lengthInBytes ) {
+		if( i + 16 <= lengthInBytes && isAscii16( src + i ) ) {
+			i += 16;
+			result += 16;
+			continue;
+		}
+		size_t next = i;
+		if( lb_get_next_char_utf8( src, lengthInBytes, &next ) == EOS )
+			break;
+		i = next;
 		++result;
+	}
+
 	return result;	
 }
 
@@ -161,6 +606,8 @@ uint32_t nextCharUtf8( const char *str, size_t *inOutByte, size_t lengthInBytes
 {
 	if( lengthInBytes == 0 )
 		lengthInBytes = strlen( str );
+	if( ( *inOutByte < lengthInBytes ) && ( (uint8_t)str[*inOutByte] < 0x80 ) )
+		return (uint8_t)str[(*inOutByte)++];
 	return lb_get_next_char_utf8( (const utf8_t*)str, lengthInBytes, inOutByte );
 }
 
@@ -168,10 +615,18 @@ size_t advanceCharUtf8( const char *str, size_t numChars, size_t lengthInBytes )
 {
 	if( lengthInBytes == 0 )
 		lengthInBytes = strlen( str );
+	const uint8_t *src = (const uint8_t*)str;
 	size_t nextByte = 0;
-	for( size_t curChar = 0; curChar < numChars; ++curChar ) {
-		if( lb_get_next_char_utf8( (const utf8_t*)str, lengthInBytes, &nextByte ) == 0xFFFF )
+	size_t curChar = 0;
+	while( curChar < numChars ) {
+		if( ( numChars - curChar >= 16 ) && ( nextByte + 16 <= lengthInBytes ) && isAscii16( src + nextByte ) ) {
+			nextByte += 16;
+			curChar += 16;
+			continue;
+		}
+		if( lb_get_next_char_utf8( src, lengthInBytes, &nextByte ) == EOS )
 			break;
+		++curChar;
 	}
 	
 	return nextByte;
@@ -180,6 +635,7 @@ size_t advanceCharUtf8( const char *str, size_t numChars, size_t lengthInBytes )
 std::u16string toUtf16( const std::u32string &utf32str )
 {
 	std::u16string result;
+	result.reserve( utf32str.size() );
 	auto sourceIt = utf32str.cbegin();
 	while( sourceIt != utf32str.cend() ) {
 		char32_t ch = *sourceIt++;
@@ -206,6 +662,7 @@ std::u16string toUtf16( const std::u32string &utf32str )
 std::u32string toUtf32( const std::u16string &utf16str )
 {
 	std::u32string result;
+	result.reserve( utf16str.size() );
 	auto sourceIt = utf16str.cbegin();
 	while( sourceIt != utf16str.cend() ) {
 		char32_t ch = *sourceIt++;
@@ -0,0 +1,480 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/XmlDoc.h"
+
+#include "rapidxml/rapidxml.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// nodes with no more children or attributes than this are searched linearly rather than indexed
+const size_t MIN_INDEXED_CHILDREN = 16;
+
+inline char toLowerAscii( char c )
+{
+	return ( c >= 'A' && c <= 'Z' ) ? (char)( c + ( 'a' - 'A' ) ) : c;
+}
+
+// case-insensitive, so that a single index serves both kinds of lookup
+uint64_t hashTag( const StringRef &tag )
+{
+	uint64_t result = 14695981039346656037ULL;
+	for( char c : tag )
+		result = ( result ^ (uint8_t)toLowerAscii( c ) ) * 1099511628211ULL;
+	return result;
+}
+
+bool tagsMatch( const StringRef &tag1, const StringRef &tag2, bool caseSensitive )
+{
+	if( caseSensitive || tag1.size() != tag2.size() )
+		return tag1 == tag2;
+	for( size_t i = 0; i < tag1.size(); ++i ) {
+		if( toLowerAscii( tag1[i] ) != toLowerAscii( tag2[i] ) )
+			return false;
+	}
+	return true;
+}
+
+inline StringRef getName( const rapidxml::xml_base<> *base )
+{
+	return StringRef( base->name(), base->name_size() );
+}
+
+template<int Flags>
+void parseDoc( rapidxml::xml_document<> *doc, char *text, bool parseComments )
+{
+	if( parseComments )
+		doc->parse<Flags | rapidxml::parse_doctype_node | rapidxml::parse_comment_nodes>( text );
+	else
+		doc->parse<Flags | rapidxml::parse_doctype_node>( text );
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc::Impl
+struct XmlDoc::Impl {
+	// an open-addressed hash table holding the first child or attribute with each name, allocated from mDoc's memory pool
+	struct Index {
+		struct Entry {
+			const rapidxml::xml_base<>	*mItem;
+			size_t						mOrder; // position among its siblings
+		};
+
+		Entry	*mSlots;
+		size_t	mMask;
+	};
+
+	void	parse();
+	// appends the CDATA children of 'node' and its descendants to their values
+	void	collapseCData( rapidxml::xml_node<> *node );
+	// returns whether 'node' is visited as a child under mOptions
+	bool	isVisible( const rapidxml::xml_node<> *node ) const;
+
+	// return the index of the children or attributes of 'node', building it on first use
+	Index	getChildIndex( const rapidxml::xml_node<> *node ) const;
+	Index	getAttrIndex( const rapidxml::xml_node<> *node ) const;
+	Index	buildIndex( const vector<const rapidxml::xml_base<>*> &items ) const;
+	Index	allocateIndex( size_t numSlots ) const;
+	// returns the first item in 'index' named 'name', or null
+	static const rapidxml::xml_base<>*	find( const Index &index, const StringRef &name, bool caseSensitive );
+
+	std::string				mText;
+	XmlTree::ParseOptions	mOptions;
+	// the pool of the document holds its nodes and attributes, values of collapsed CDATA and the indices, so it is mutable for the latter
+	mutable rapidxml::xml_document<>	mDoc;
+
+	mutable mutex									mIndexMutex;
+	mutable unordered_map<const void*, Index>		mChildIndices, mAttrIndices;
+};
+
+void XmlDoc::Impl::parse()
+{
+	// RapidXML drops CDATA along with data nodes, so these are only skipped when there is no CDATA
+	const bool hasCData = mText.find( "<![CDATA[" ) != std::string::npos;
+	const bool skipDataNodes = mOptions.getIgnoreDataChildren() && ! hasCData;
+	try {
+		if( skipDataNodes )
+			parseDoc<rapidxml::parse_no_data_nodes>( &mDoc, &mText[0], mOptions.getParseComments() );
+		else
+			parseDoc<rapidxml::parse_default>( &mDoc, &mText[0], mOptions.getParseComments() );
+	}
+	catch( rapidxml::parse_error &exc ) {
+		const size_t offset = exc.where<char>() - mText.data();
+		throw ExcParseError( "XML parse error at offset " + to_string( offset ) + ": " + exc.what(), offset );
+	}
+
+	if( hasCData && mOptions.getCollapseCData() )
+		collapseCData( &mDoc );
+}
+
+void XmlDoc::Impl::collapseCData( rapidxml::xml_node<> *node )
+{
+	size_t size = node->value_size();
+	bool hasCData = false;
+	for( rapidxml::xml_node<> *child = node->first_node(); child; child = child->next_sibling() ) {
+		if( child->type() == rapidxml::node_cdata ) {
+			size += child->value_size();
+			hasCData = true;
+		}
+		else if( child->type() == rapidxml::node_element )
+			collapseCData( child );
+	}
+	if( ! hasCData )
+		return;
+
+	char *value = mDoc.allocate_string( nullptr, size + 1 );
+	char *end = std::copy( node->value(), node->value() + node->value_size(), value );
+	for( const rapidxml::xml_node<> *child = node->first_node(); child; child = child->next_sibling() ) {
+		if( child->type() == rapidxml::node_cdata )
+			end = std::copy( child->value(), child->value() + child->value_size(), end );
+	}
+	*end = 0;
+	node->value( value, size );
+}
+
+bool XmlDoc::Impl::isVisible( const rapidxml::xml_node<> *node ) const
+{
+	switch( node->type() ) {
+		case rapidxml::node_element:
+		case rapidxml::node_comment:
+			return true;
+		case rapidxml::node_data:
+			return ! mOptions.getIgnoreDataChildren();
+		case rapidxml::node_cdata:
+			return ! mOptions.getCollapseCData();
+		default:
+			return false;
+	}
+}
+
+XmlDoc::Impl::Index XmlDoc::Impl::allocateIndex( size_t numSlots ) const
+{
+	// the pool aligns every allocation to a pointer
+	Index result;
+	result.mSlots = reinterpret_cast<Index::Entry*>( mDoc.allocate_string( nullptr, numSlots * sizeof( Index::Entry ) ) );
+	result.mMask = numSlots - 1;
+	std::fill( result.mSlots, result.mSlots + numSlots, Index::Entry{ nullptr, 0 } );
+	return result;
+}
+
+XmlDoc::Impl::Index XmlDoc::Impl::buildIndex( const vector<const rapidxml::xml_base<>*> &items ) const
+{
+	// children often repeat a few tags many times, so only the first with each name is stored and the table grows with the
+	// number of distinct names; tables outgrown stay in the pool, which at most doubles the memory used
+	Index result = allocateIndex( 16 );
+	size_t size = 0;
+	for( size_t order = 0; order < items.size(); ++order ) {
+		const StringRef name = getName( items[order] );
+		size_t slot = hashTag( name ) & result.mMask;
+		while( result.mSlots[slot].mItem && getName( result.mSlots[slot].mItem ) != name )
+			slot = ( slot + 1 ) & result.mMask;
+		if( result.mSlots[slot].mItem )
+			continue;
+		result.mSlots[slot] = Index::Entry{ items[order], order };
+
+		if( ++size * 2 > result.mMask ) {
+			const Index previous = result;
+			result = allocateIndex( ( previous.mMask + 1 ) * 2 );
+			for( size_t i = 0; i <= previous.mMask; ++i ) {
+				if( ! previous.mSlots[i].mItem )
+					continue;
+				slot = hashTag( getName( previous.mSlots[i].mItem ) ) & result.mMask;
+				while( result.mSlots[slot].mItem )
+					slot = ( slot + 1 ) & result.mMask;
+				result.mSlots[slot] = previous.mSlots[i];
+			}
+		}
+	}
+
+	return result;
+}
+
+const rapidxml::xml_base<>* XmlDoc::Impl::find( const Index &index, const StringRef &name, bool caseSensitive )
+{
+	// names differing only in case share a chain; a case-insensitive lookup returns the earliest of them
+	const Index::Entry *result = nullptr;
+	for( size_t slot = hashTag( name ) & index.mMask; index.mSlots[slot].mItem; slot = ( slot + 1 ) & index.mMask ) {
+		const Index::Entry &entry = index.mSlots[slot];
+		if( tagsMatch( getName( entry.mItem ), name, caseSensitive ) && ( ! result || entry.mOrder < result->mOrder ) ) {
+			result = &entry;
+			if( caseSensitive )
+				break;
+		}
+	}
+
+	return result ? result->mItem : nullptr;
+}
+
+XmlDoc::Impl::Index XmlDoc::Impl::getChildIndex( const rapidxml::xml_node<> *node ) const
+{
+	// indices are never modified once built, so the result may be read without the lock
+	lock_guard<mutex> lock( mIndexMutex );
+	auto it = mChildIndices.find( node );
+	if( it != mChildIndices.end() )
+		return it->second;
+
+	vector<const rapidxml::xml_base<>*> children;
+	for( const rapidxml::xml_node<> *child = node->first_node(); child; child = child->next_sibling() ) {
+		if( isVisible( child ) )
+			children.push_back( child );
+	}
+
+	return mChildIndices.emplace( node, buildIndex( children ) ).first->second;
+}
+
+XmlDoc::Impl::Index XmlDoc::Impl::getAttrIndex( const rapidxml::xml_node<> *node ) const
+{
+	lock_guard<mutex> lock( mIndexMutex );
+	auto it = mAttrIndices.find( node );
+	if( it != mAttrIndices.end() )
+		return it->second;
+
+	vector<const rapidxml::xml_base<>*> attrs;
+	for( const rapidxml::xml_attribute<> *attr = node->first_attribute(); attr; attr = attr->next_attribute() )
+		attrs.push_back( attr );
+
+	return mAttrIndices.emplace( node, buildIndex( attrs ) ).first->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc
+XmlDoc::XmlDoc( const DataSourceRef &dataSource, const XmlTree::ParseOptions &parseOptions )
+	: mImpl( new Impl )
+{
+	BufferRef buffer = dataSource->getBuffer();
+	mImpl->mText.assign( (const char*)buffer->getData(), buffer->getSize() );
+	mImpl->mOptions = parseOptions;
+	mImpl->parse();
+}
+
+XmlDoc::XmlDoc( std::string xmlString, const XmlTree::ParseOptions &parseOptions )
+	: mImpl( new Impl )
+{
+	mImpl->mText = std::move( xmlString );
+	mImpl->mOptions = parseOptions;
+	mImpl->parse();
+}
+
+XmlDoc::XmlDoc( XmlDoc &&rhs ) = default;
+XmlDoc& XmlDoc::operator=( XmlDoc &&rhs ) = default;
+XmlDoc::~XmlDoc() = default;
+
+XmlDoc::Node XmlDoc::getRoot() const
+{
+	return Node( mImpl.get(), &mImpl->mDoc );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc::Attr
+StringRef XmlDoc::Attr::getName() const
+{
+	return mAttr ? cinder::getName( mAttr ) : StringRef();
+}
+
+StringRef XmlDoc::Attr::getValue() const
+{
+	return mAttr ? StringRef( mAttr->value(), mAttr->value_size() ) : StringRef();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc::Node
+XmlTree::NodeType XmlDoc::Node::getNodeType() const
+{
+	switch( mNode->type() ) {
+		case rapidxml::node_document: return XmlTree::NODE_DOCUMENT;
+		case rapidxml::node_element: return XmlTree::NODE_ELEMENT;
+		case rapidxml::node_cdata: return XmlTree::NODE_CDATA;
+		case rapidxml::node_comment: return XmlTree::NODE_COMMENT;
+		case rapidxml::node_data: return XmlTree::NODE_DATA;
+		default: return XmlTree::NODE_UNKNOWN;
+	}
+}
+
+StringRef XmlDoc::Node::getTag() const
+{
+	return cinder::getName( mNode );
+}
+
+StringRef XmlDoc::Node::getValue() const
+{
+	return StringRef( mNode->value(), mNode->value_size() );
+}
+
+bool XmlDoc::Node::hasParent() const
+{
+	return mNode->parent() != nullptr;
+}
+
+XmlDoc::Node XmlDoc::Node::getParent() const
+{
+	return mNode->parent() ? Node( mImpl, mNode->parent() ) : Node();
+}
+
+XmlDoc::Iter XmlDoc::Node::begin() const
+{
+	return Iter( Node( mImpl, mNode->first_node() ), StringRef(), false, false );
+}
+
+XmlDoc::Iter XmlDoc::Node::begin( const StringRef &tag, bool caseSensitive ) const
+{
+	return Iter( Node( mImpl, mNode->first_node() ), tag, true, caseSensitive );
+}
+
+XmlDoc::Iter XmlDoc::Node::end() const
+{
+	return Iter( Node( mImpl, nullptr ), StringRef(), false, false );
+}
+
+XmlDoc::Node XmlDoc::Node::getChild( const StringRef &relativePath, bool caseSensitive, char separator ) const
+{
+	Node result = findChild( relativePath, caseSensitive, separator );
+	if( ! result.isValid() )
+		throw ExcChildNotFound( "Could not find child: " + relativePath.str() + " for node: " + getPath() );
+	return result;
+}
+
+XmlDoc::Node XmlDoc::Node::findChild( const StringRef &relativePath, bool caseSensitive, char separator ) const
+{
+	// empty components are ignored, so that "/one/two" is equivalent to "one/two"
+	Node result = *this;
+	const char *p = relativePath.begin(), *end = relativePath.end();
+	while( result.isValid() && p != end ) {
+		const char *componentEnd = std::find( p, end, separator );
+		if( componentEnd != p )
+			result = result.findChildNamed( StringRef( p, componentEnd - p ), caseSensitive );
+		p = ( componentEnd == end ) ? end : componentEnd + 1;
+	}
+
+	return result;
+}
+
+XmlDoc::Node XmlDoc::Node::findChildNamed( const StringRef &tag, bool caseSensitive ) const
+{
+	// most nodes have few children, which are faster to scan than to index
+	const rapidxml::xml_node<> *child = mNode->first_node();
+	for( size_t numScanned = 0; child && numScanned < MIN_INDEXED_CHILDREN; child = child->next_sibling() ) {
+		if( ! mImpl->isVisible( child ) )
+			continue;
+		if( tagsMatch( cinder::getName( child ), tag, caseSensitive ) )
+			return Node( mImpl, child );
+		++numScanned;
+	}
+	if( ! child )
+		return Node();
+
+	auto result = static_cast<const rapidxml::xml_node<>*>( Impl::find( mImpl->getChildIndex( mNode ), tag, caseSensitive ) );
+	return result ? Node( mImpl, result ) : Node();
+}
+
+XmlDoc::AttrRange XmlDoc::Node::getAttributes() const
+{
+	return AttrRange( AttrIter( Attr( mNode->first_attribute() ) ) );
+}
+
+XmlDoc::Attr XmlDoc::Node::getAttribute( const StringRef &attrName ) const
+{
+	Attr result = findAttribute( attrName );
+	if( ! result.isValid() )
+		throw ExcAttrNotFound( "Could not find attribute: " + attrName.str() + " for node: " + getPath() );
+	return result;
+}
+
+XmlDoc::Attr XmlDoc::Node::findAttribute( const StringRef &attrName ) const
+{
+	const rapidxml::xml_attribute<> *attr = mNode->first_attribute();
+	for( size_t numScanned = 0; attr && numScanned < MIN_INDEXED_CHILDREN; attr = attr->next_attribute(), ++numScanned ) {
+		if( cinder::getName( attr ) == attrName )
+			return Attr( attr );
+	}
+	if( ! attr )
+		return Attr();
+
+	auto result = static_cast<const rapidxml::xml_attribute<>*>( Impl::find( mImpl->getAttrIndex( mNode ), attrName, true ) );
+	return result ? Attr( result ) : Attr();
+}
+
+std::string XmlDoc::Node::getPath( char separator ) const
+{
+	std::string result;
+	for( const rapidxml::xml_node<> *node = mNode; node; node = node->parent() ) {
+		std::string nodeName = cinder::getName( node ).str();
+		if( node != mNode )
+			nodeName += separator;
+		result = nodeName + result;
+	}
+
+	return result;
+}
+
+StringRef XmlDoc::Node::getDocType() const
+{
+	if( mNode->type() == rapidxml::node_document ) {
+		for( const rapidxml::xml_node<> *child = mNode->first_node(); child; child = child->next_sibling() ) {
+			if( child->type() == rapidxml::node_doctype )
+				return StringRef( child->value(), child->value_size() );
+		}
+	}
+
+	return StringRef();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc::Iter
+XmlDoc::Iter::Iter( const Node &node, const StringRef &tag, bool filtered, bool caseSensitive )
+	: mNode( node ), mTag( tag ), mFiltered( filtered ), mCaseSensitive( caseSensitive )
+{
+	skip();
+}
+
+void XmlDoc::Iter::skip()
+{
+	while( mNode.mNode && ! ( mNode.mImpl->isVisible( mNode.mNode ) && ( ! mFiltered || tagsMatch( getName( mNode.mNode ), mTag, mCaseSensitive ) ) ) )
+		mNode.mNode = mNode.mNode->next_sibling();
+}
+
+void XmlDoc::Iter::increment()
+{
+	mNode.mNode = mNode.mNode->next_sibling();
+	skip();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// XmlDoc::AttrIter
+void XmlDoc::AttrIter::increment()
+{
+	mAttr.mAttr = mAttr.mAttr->next_attribute();
+}
+
+} // namespace cinder
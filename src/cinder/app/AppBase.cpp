@@ -234,6 +234,9 @@ void AppBase::privateUpdate__()
 	// service asio::io_context
 	mIo->poll();
 
+	// emissions queued with ConcurrentSignal::emitDeferred() from any thread
+	signals::emitDeferred();
+
 	if( getNumWindows() > 0 ) {
 		WindowRef mainWin = getWindowIndex( 0 );
 		if( mainWin )
@@ -27,6 +27,9 @@
 #include "cinder/gl/scoped.h"
 
 #include "cinder/Text.h"
+#include "cinder/Log.h"
+#include "cinder/PathFlattener.h"
+#include "cinder/Thread.h"
 #include "cinder/ip/Fill.h"
 #include "cinder/ip/Premultiply.h"
 	#include "cinder/ImageIo.h"
@@ -45,10 +48,16 @@
 	#undef max
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	#include "cinder/linux/FreeTypeUtil.h" 
+	#include FT_OUTLINE_H
 #endif
 #include "cinder/Unicode.h"
 
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <set>
+#include <thread>
 
 using std::unordered_map;
 
@@ -58,7 +67,7 @@ namespace cinder { namespace gl {
 
 #if defined( CINDER_COCOA )
 TextureFont::TextureFont( const Font &font, const string &supportedChars, const TextureFont::Format &format )
-	: mFont( font ), mFormat( format )
+	: mFont( font ), mFormat( format ), mAtlasClient( 0 ), mSignedDistanceField( false )
 {
 	// get the glyph indices we'll need
 	vector<Font::Glyph>	tempGlyphs = font.getGlyphs( supportedChars );
@@ -209,7 +218,7 @@ set<Font::Glyph> getNecessaryGlyphs( const Font &font, const string &supportedCh
 }
 
 TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Format &format )
-	: mFont( font ), mFormat( format )
+	: mFont( font ), mFormat( format ), mAtlasClient( 0 ), mSignedDistanceField( false )
 {
 	// get the glyph indices we'll need
 	set<Font::Glyph> glyphs = getNecessaryGlyphs( font, utf8Chars );
@@ -330,7 +339,7 @@ TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Forma
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 
 TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Format &format )
-	: mFont( font ), mFormat( format )
+	: mFont( font ), mFormat( format ), mAtlasClient( 0 ), mSignedDistanceField( false )
 {
 	FT_Face face = font.getFreetypeFace();
 	std::u32string utf32Chars = ci::toUtf32( utf8Chars );
@@ -346,6 +355,20 @@ TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Forma
 		glyphs.insert( glyphIndex );
 	}
 
+	// a dynamic atlas only warms up with the supported glyphs; others are added as they are drawn
+	if( mFormat.isDynamicAtlas() || mFormat.isSignedDistanceField() ) {
+		mSignedDistanceField = mFormat.isSignedDistanceField();
+		mAtlas = mFormat.getAtlas() ? mFormat.getAtlas() : Atlas::create( mFormat );
+		mAtlasClient = mAtlas->addClient();
+		vector<pair<Font::Glyph,vec2> > glyphMeasures;
+		for( Font::Glyph glyph : glyphs )
+			glyphMeasures.push_back( make_pair( glyph, vec2() ) );
+		for( size_t begin = 0; begin < glyphMeasures.size(); )
+			begin = cacheGlyphs( glyphMeasures, begin );
+		mAtlas->finish();
+		return;
+	}
+
 	// determine the max glyph extents
 	vec2 glyphExtents;
 	for( set<Font::Glyph>::const_iterator glyphIt = glyphs.begin(); glyphIt != glyphs.end(); ++glyphIt ) {
@@ -453,261 +476,902 @@ TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Forma
 
 #endif
 
+TextureFont::~TextureFont()
+{
+	if( mAtlas )
+		mAtlas->removeClient( mAtlasClient );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TextureFont::Atlas::Rasterizer
+
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+
+namespace {
+
+// Shape2d decomposition callbacks; outlines are converted from 26.6 fixed point to pixels, y up
+int ftShapeMoveTo( const FT_Vector *to, void *user )
+{
+	reinterpret_cast<Shape2d*>( user )->moveTo( to->x / 64.0f, to->y / 64.0f );
+	return 0;
+}
+
+int ftShapeLineTo( const FT_Vector *to, void *user )
+{
+	reinterpret_cast<Shape2d*>( user )->lineTo( to->x / 64.0f, to->y / 64.0f );
+	return 0;
+}
+
+int ftShapeConicTo( const FT_Vector *control, const FT_Vector *to, void *user )
+{
+	reinterpret_cast<Shape2d*>( user )->quadTo( control->x / 64.0f, control->y / 64.0f, to->x / 64.0f, to->y / 64.0f );
+	return 0;
+}
+
+int ftShapeCubicTo( const FT_Vector *control1, const FT_Vector *control2, const FT_Vector *to, void *user )
+{
+	reinterpret_cast<Shape2d*>( user )->curveTo( control1->x / 64.0f, control1->y / 64.0f, control2->x / 64.0f, control2->y / 64.0f, to->x / 64.0f, to->y / 64.0f );
+	return 0;
+}
+
+// Writes the signed distance from the center of each pixel of 'bounds' (y up) to the nearest edge of 'flattener',
+// positive inside, mapped so that 0.5 lies on the outline and 0 and 1 lie 'range' pixels outside and inside. Rows are top-down.
+void renderDistanceField( const PathFlattener &flattener, bool evenOdd, const Area &bounds, float range, uint8_t *result )
+{
+	const auto &points = flattener.getPoints();
+	const auto &contourEnds = flattener.getContourEnds();
+	const float scale = 0.5f / range;
+
+	for( int32_t y = 0; y < bounds.getHeight(); ++y ) {
+		const float py = bounds.y2 - y - 0.5f;
+		for( int32_t x = 0; x < bounds.getWidth(); ++x ) {
+			const vec2 p( bounds.x1 + x + 0.5f, py );
+			float minDistance2 = range * range;
+			int winding = 0;
+			uint32_t contourBegin = 0;
+			for( uint32_t contourEnd : contourEnds ) {
+				// every contour is closed, its last point connecting back to its first
+				for( uint32_t i = contourBegin, prev = contourEnd - 1; i < contourEnd; prev = i++ ) {
+					const vec2 &a = points[prev], &b = points[i];
+					const vec2 ab = b - a, ap = p - a;
+					const float lengthSquared = dot( ab, ab );
+					const float t = ( lengthSquared > 0 ) ? glm::clamp( dot( ap, ab ) / lengthSquared, 0.0f, 1.0f ) : 0;
+					const vec2 d = ap - ab * t;
+					minDistance2 = std::min( minDistance2, dot( d, d ) );
+					if( ( a.y <= p.y ) != ( b.y <= p.y ) && a.x + ( p.y - a.y ) / ab.y * ab.x > p.x )
+						winding += ( b.y > a.y ) ? 1 : -1;
+				}
+				contourBegin = contourEnd;
+			}
+
+			const bool inside = evenOdd ? ( winding & 1 ) : ( winding != 0 );
+			const float distance = inside ? std::sqrt( minDistance2 ) : -std::sqrt( minDistance2 );
+			result[y * bounds.getWidth() + x] = (uint8_t)( glm::clamp( 0.5f + distance * scale, 0.0f, 1.0f ) * 255 + 0.5f );
+		}
+	}
+}
+
+} // anonymous namespace
+
+class TextureFont::Atlas::Rasterizer {
+  public:
+	// a glyph outline copied out of its FT_Face, so that it can be rendered without the face
+	struct Job {
+		uint32_t						mClient;
+		Font::Glyph						mGlyph;
+		bool							mPremultiply;
+		float							mDistanceRange; // positive for a signed distance field rather than coverage
+		std::vector<FT_Vector>			mPoints;
+		std::vector<char>				mTags;
+		std::vector<std::remove_pointer<decltype( FT_Outline::contours )>::type>	mContours;
+		int								mFlags;
+		Shape2d							mShape; // distance fields only
+		Area							mBounds; // pixels, y up
+	};
+
+	Rasterizer()
+		: mNumBusy( 0 ), mQuit( false )
+	{
+		mThread = std::thread( &Rasterizer::threadFn, this );
+	}
+
+	~Rasterizer()
+	{
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mQuit = true;
+		}
+		mWorkCondition.notify_all();
+		mThread.join();
+	}
+
+	//! Copies the outline loaded into \a slot into \a job. Returns false if the glyph has no outline, as with bitmap fonts.
+	static bool prepare( FT_GlyphSlot slot, float distanceRange, Job *job )
+	{
+		if( slot->format != FT_GLYPH_FORMAT_OUTLINE )
+			return false;
+
+		const FT_Outline &outline = slot->outline;
+		job->mDistanceRange = distanceRange;
+		job->mFlags = outline.flags;
+		if( distanceRange > 0 ) {
+			FT_Outline_Funcs funcs = { ftShapeMoveTo, ftShapeLineTo, ftShapeConicTo, ftShapeCubicTo, 0, 0 };
+			job->mShape.clear();
+			FT_Outline_Decompose( const_cast<FT_Outline*>( &outline ), &funcs, &job->mShape );
+		}
+		else {
+			job->mPoints.assign( outline.points, outline.points + outline.n_points );
+			job->mTags.assign( outline.tags, outline.tags + outline.n_points );
+			job->mContours.assign( outline.contours, outline.contours + outline.n_contours );
+		}
+
+		// whole pixels covering the control box, as FreeType's own renderer allocates, plus room for the distance field to fall off
+		FT_BBox cbox;
+		FT_Outline_Get_CBox( &outline, &cbox );
+		const int32_t margin = (int32_t)std::ceil( std::max( distanceRange, 0.0f ) );
+		job->mBounds = Area( (int32_t)std::floor( cbox.xMin / 64.0 ) - margin, (int32_t)std::floor( cbox.yMin / 64.0 ) - margin,
+							(int32_t)std::ceil( cbox.xMax / 64.0 ) + margin, (int32_t)std::ceil( cbox.yMax / 64.0 ) + margin );
+		return true;
+	}
+
+	//! Renders \a job into \a result. Coverage is rendered using \a library, which must not be in use by another thread.
+	static void render( FT_Library library, Job &job, GlyphBitmap *result )
+	{
+		result->mClient = job.mClient;
+		result->mGlyph = job.mGlyph;
+		result->mPremultiply = job.mPremultiply;
+		result->mSize = job.mBounds.getSize();
+		result->mOffset = ivec2( job.mBounds.x1, job.mBounds.y2 );
+		result->mCoverage.assign( result->mSize.x * result->mSize.y, 0 );
+		if( result->mCoverage.empty() )
+			return;
+
+		if( job.mDistanceRange > 0 ) {
+			PathFlattener flattener( 0.05f );
+			flattener.flatten( job.mShape );
+			renderDistanceField( flattener, ( job.mFlags & FT_OUTLINE_EVEN_ODD_FILL ) != 0, job.mBounds, job.mDistanceRange, result->mCoverage.data() );
+			return;
+		}
+		if( job.mPoints.empty() )
+			return;
+
+		FT_Outline outline;
+		outline.n_contours = static_cast<decltype( outline.n_contours )>( job.mContours.size() );
+		outline.n_points = static_cast<decltype( outline.n_points )>( job.mPoints.size() );
+		outline.points = job.mPoints.data();
+		outline.tags = job.mTags.data();
+		outline.contours = job.mContours.data();
+		outline.flags = job.mFlags;
+		FT_Outline_Translate( &outline, -job.mBounds.x1 * 64, -job.mBounds.y1 * 64 );
+
+		// a positive pitch stores the top row first
+		FT_Bitmap bitmap;
+		memset( &bitmap, 0, sizeof( bitmap ) );
+		bitmap.rows = result->mSize.y;
+		bitmap.width = result->mSize.x;
+		bitmap.pitch = result->mSize.x;
+		bitmap.buffer = result->mCoverage.data();
+		bitmap.num_grays = 256;
+		bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+		FT_Outline_Get_Bitmap( library, &outline, &bitmap );
+	}
+
+	//! Renders \a jobs into \a results. Distance fields, which need no FT_Library, are computed in parallel.
+	static void render( FT_Library library, std::vector<Job> &jobs, std::vector<GlyphBitmap> *results )
+	{
+		results->resize( jobs.size() );
+		parallelFor( 0, jobs.size(), 1, [&]( size_t begin, size_t end ) {
+			for( size_t j = begin; j < end; ++j ) {
+				if( jobs[j].mDistanceRange > 0 )
+					render( nullptr, jobs[j], &(*results)[j] );
+			}
+		} );
+		for( size_t j = 0; j < jobs.size(); ++j ) {
+			if( jobs[j].mDistanceRange <= 0 )
+				render( library, jobs[j], &(*results)[j] );
+		}
+	}
+
+	void push( Job &&job )
+	{
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			mQueue.push_back( std::move( job ) );
+		}
+		mWorkCondition.notify_one();
+	}
+
+	//! Moves the glyphs rendered so far into \a result
+	void popCompleted( std::vector<GlyphBitmap> *result )
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		result->swap( mCompleted );
+		mCompleted.clear();
+	}
+
+	void waitUntilIdle()
+	{
+		std::unique_lock<std::mutex> lock( mMutex );
+		mIdleCondition.wait( lock, [this] { return mQueue.empty() && mNumBusy == 0; } );
+	}
+
+  private:
+	void threadFn()
+	{
+		ThreadSetup threadSetup;
+
+		// FreeType libraries are not thread-safe, so the worker keeps its own
+		FT_Library library = nullptr;
+		if( FT_Init_FreeType( &library ) )
+			CI_LOG_E( "failed to initialize FreeType for glyph rasterization" );
+
+		std::vector<Job> jobs;
+		std::vector<GlyphBitmap> bitmaps;
+		std::unique_lock<std::mutex> lock( mMutex );
+		while( true ) {
+			mWorkCondition.wait( lock, [this] { return mQuit || ! mQueue.empty(); } );
+			if( mQuit )
+				break;
+
+			// take everything queued so that distance fields can be computed in parallel
+			jobs.assign( std::make_move_iterator( mQueue.begin() ), std::make_move_iterator( mQueue.end() ) );
+			mQueue.clear();
+			mNumBusy = jobs.size();
+			lock.unlock();
+
+			if( library )
+				render( library, jobs, &bitmaps );
+
+			lock.lock();
+			if( library )
+				std::move( bitmaps.begin(), bitmaps.end(), std::back_inserter( mCompleted ) );
+			mNumBusy = 0;
+			if( mQueue.empty() )
+				mIdleCondition.notify_all();
+		}
+		lock.unlock();
+
+		if( library )
+			FT_Done_FreeType( library );
+	}
+
+	std::thread					mThread;
+	std::mutex					mMutex;
+	std::condition_variable		mWorkCondition, mIdleCondition;
+	std::deque<Job>				mQueue;
+	std::vector<GlyphBitmap>	mCompleted;
+	size_t						mNumBusy;
+	bool						mQuit;
+};
+
+#else
+
+class TextureFont::Atlas::Rasterizer {
+  public:
+	void popCompleted( std::vector<GlyphBitmap> *result )	{}
+	void waitUntilIdle()									{}
+};
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// TextureFont::Atlas
+
+TextureFont::Atlas::Atlas( const Format &format )
+	: mTextureSize( format.getTextureWidth(), format.getTextureHeight() ), mMaxTextures( std::max<size_t>( 1, std::min<size_t>( format.getMaxTextures(), 256 ) ) ),
+	mMipmapping( format.hasMipmapping() ), mPadding( format.hasMipmapping() ? 4 : 1 ), mUseCount( 0 ), mNumEvictions( 0 ), mNextClient( 0 )
+{
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	if( format.isAsyncRasterization() )
+		mRasterizer.reset( new Rasterizer );
+#endif
+}
+
+TextureFont::Atlas::~Atlas()
+{
+}
+
+size_t TextureFont::Atlas::getNumGlyphs() const
+{
+	size_t result = 0;
+	for( const auto &client : mClients )
+		result += client.second.mGlyphMap.size();
+	return result;
+}
+
+size_t TextureFont::Atlas::getNumPendingGlyphs() const
+{
+	size_t result = 0;
+	for( const auto &client : mClients )
+		result += client.second.mPending.size();
+	return result;
+}
+
+void TextureFont::Atlas::finish()
+{
+	if( mRasterizer ) {
+		mRasterizer->waitUntilIdle();
+		addCompleted();
+		regenerateMipmaps();
+	}
+}
+
+uint32_t TextureFont::Atlas::addClient()
+{
+	mClients[mNextClient];
+	return mNextClient++;
+}
+
+void TextureFont::Atlas::removeClient( uint32_t client )
+{
+	// the client's glyphs keep their space until their page is cleared
+	mClients.erase( client );
+}
+
+void TextureFont::Atlas::beginUse()
+{
+	++mUseCount;
+	addCompleted();
+}
+
+bool TextureFont::Atlas::use( uint32_t client, Font::Glyph glyph )
+{
+	const auto &glyphMap = mClients.at( client ).mGlyphMap;
+	auto glyphIt = glyphMap.find( glyph );
+	if( glyphIt == glyphMap.end() )
+		return false;
+
+	mPages[glyphIt->second.mTextureIndex].mLastUsed = mUseCount;
+	return true;
+}
+
+void TextureFont::Atlas::addCompleted()
+{
+	if( ! mRasterizer )
+		return;
+
+	vector<GlyphBitmap> completed;
+	mRasterizer->popCompleted( &completed );
+	for( const auto &bitmap : completed ) {
+		auto clientIt = mClients.find( bitmap.mClient );
+		if( clientIt == mClients.end() )
+			continue;
+		clientIt->second.mPending.erase( bitmap.mGlyph );
+		// a glyph which does not fit now is requested again by its next draw
+		insert( bitmap );
+	}
+}
+
+void TextureFont::Atlas::regenerateMipmaps()
+{
+	for( auto &page : mPages ) {
+		if( page.mDirty && mMipmapping )
+			page.mTexture->regenerateMipmap();
+		page.mDirty = false;
+	}
+}
+
+void TextureFont::Atlas::clearPage( size_t pageIndex )
+{
+	Page &page = mPages[pageIndex];
+	for( const auto &occupant : page.mGlyphs ) {
+		auto clientIt = mClients.find( occupant.first );
+		if( clientIt != mClients.end() )
+			clientIt->second.mGlyphMap.erase( occupant.second );
+	}
+
+	page.mGlyphs.clear();
+	page.mPacker.clear();
+	++mNumEvictions;
+}
+
+bool TextureFont::Atlas::insert( const GlyphBitmap &bitmap )
+{
+	auto clientIt = mClients.find( bitmap.mClient );
+	if( clientIt == mClients.end() )
+		return true;
+	Client &client = clientIt->second;
+
+	const ivec2 size = bitmap.mSize + ivec2( 2 * mPadding );
+	if( size.x > mTextureSize.x || size.y > mTextureSize.y ) {
+		CI_LOG_W( "glyph " << bitmap.mGlyph << " of size " << bitmap.mSize << " does not fit in a texture of size " << mTextureSize );
+		client.mFailed.insert( bitmap.mGlyph );
+		return true;
+	}
+
+	Area area;
+	size_t pageIndex = 0;
+	for( ; pageIndex < mPages.size(); ++pageIndex ) {
+		area = mPages[pageIndex].mPacker.insert( size );
+		if( area.getWidth() > 0 )
+			break;
+	}
+
+	if( pageIndex == mPages.size() ) {
+		if( mPages.size() < mMaxTextures ) {
+			gl::Texture::Format textureFormat = gl::Texture::Format();
+			textureFormat.enableMipmapping( mMipmapping );
+#if defined( CINDER_GL_ES )
+			textureFormat.setInternalFormat( GL_LUMINANCE_ALPHA );
+#else
+			textureFormat.setInternalFormat( GL_RG );
+			textureFormat.setSwizzleMask( { GL_RED, GL_RED, GL_RED, GL_GREEN } );
+#endif
+			if( mMipmapping )
+				textureFormat.setMinFilter( GL_LINEAR_MIPMAP_LINEAR );
+
+			std::vector<uint8_t> clearData( mTextureSize.x * mTextureSize.y * 2, 0 );
+			Page page;
+			page.mTexture = gl::Texture::create( clearData.data(), textureFormat.getInternalFormat(), mTextureSize.x, mTextureSize.y, textureFormat );
+			page.mTexture->setTopDown( true );
+			page.mPacker = SkylinePacker( mTextureSize );
+			page.mDirty = false;
+			mPages.push_back( page );
+			mTextures.push_back( page.mTexture );
+		}
+		else {
+			// recycle the least recently used page, though never one drawn from by the current draw
+			size_t lruIndex = mPages.size();
+			for( size_t p = 0; p < mPages.size(); ++p ) {
+				if( mPages[p].mLastUsed < mUseCount && ( lruIndex == mPages.size() || mPages[p].mLastUsed < mPages[lruIndex].mLastUsed ) )
+					lruIndex = p;
+			}
+			if( lruIndex == mPages.size() )
+				return false;
+			clearPage( lruIndex );
+			pageIndex = lruIndex;
+		}
+
+		area = mPages[pageIndex].mPacker.insert( size );
+	}
+
+	Page &page = mPages[pageIndex];
+	page.mLastUsed = mUseCount;
+	page.mGlyphs.push_back( make_pair( bitmap.mClient, bitmap.mGlyph ) );
+	page.mDirty = true;
+
+	// luminance and alpha, with the padding cleared so that filtering never reaches a previous occupant
+	mUploadBuffer.assign( size.x * size.y * 2, 0 );
+	for( int32_t y = 0; y < bitmap.mSize.y; ++y ) {
+		const uint8_t *src = &bitmap.mCoverage[y * bitmap.mSize.x];
+		uint8_t *dst = &mUploadBuffer[( ( y + mPadding ) * size.x + mPadding ) * 2];
+		for( int32_t x = 0; x < bitmap.mSize.x; ++x, dst += 2 ) {
+			dst[0] = bitmap.mPremultiply ? src[x] : ( src[x] ? 255 : 0 );
+			dst[1] = src[x];
+		}
+	}
+	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+	page.mTexture->update( mUploadBuffer.data(), page.mTexture->getInternalFormat(), GL_UNSIGNED_BYTE, 0, size.x, size.y, area.getUL() );
+
+	// placed to match the glyphs of a static atlas
+	GlyphInfo &info = client.mGlyphMap[bitmap.mGlyph];
+	info.mTextureIndex = static_cast<uint8_t>( pageIndex );
+	info.mTexCoords = area;
+	info.mOriginOffset = vec2( bitmap.mOffset.x - mPadding, 1 - bitmap.mOffset.y - mPadding );
+	return true;
+}
+
+size_t TextureFont::cacheGlyphs( const std::vector<std::pair<Font::Glyph,vec2> > &glyphMeasures, size_t begin )
+{
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	mAtlas->beginUse();
+
+	Atlas::Client &client = mAtlas->mClients.at( mAtlasClient );
+	FT_Face face = mFont.getFreetypeFace();
+	// layout leaves a pen offset behind in the face's transform
+	FT_Set_Transform( face, nullptr, nullptr );
+	const float distanceRange = mSignedDistanceField ? mFormat.getDistanceRange() : 0;
+
+	// missing glyphs are loaded here but rendered together, so that distance fields are computed in parallel
+	vector<Atlas::Rasterizer::Job> jobs;
+	vector<Atlas::GlyphBitmap> bitmaps;
+	vector<size_t> jobMeasures, bitmapMeasures;
+	unordered_set<Font::Glyph> batched;
+	for( size_t i = begin; i < glyphMeasures.size(); ++i ) {
+		const Font::Glyph glyph = glyphMeasures[i].first;
+		if( mAtlas->use( mAtlasClient, glyph ) || client.mPending.count( glyph ) || client.mFailed.count( glyph ) || ! batched.insert( glyph ).second )
+			continue;
+
+		if( FT_Load_Glyph( face, glyph, FT_LOAD_DEFAULT ) ) {
+			client.mFailed.insert( glyph );
+			continue;
+		}
+		FT_GlyphSlot slot = face->glyph;
+		Font::GlyphMetrics glyphMetrics;
+		glyphMetrics.advance = ivec2( slot->advance.x, slot->advance.y );
+		mCachedGlyphMetrics[glyph] = glyphMetrics;
+
+		Atlas::Rasterizer::Job job;
+		if( Atlas::Rasterizer::prepare( slot, distanceRange, &job ) ) {
+			job.mClient = mAtlasClient;
+			job.mGlyph = glyph;
+			job.mPremultiply = mFormat.getPremultiply();
+			if( mAtlas->mRasterizer ) {
+				client.mPending.insert( glyph );
+				mAtlas->mRasterizer->push( std::move( job ) );
+			}
+			else {
+				jobs.push_back( std::move( job ) );
+				jobMeasures.push_back( i );
+			}
+		}
+		else {
+			// glyphs without outlines, such as those of bitmap fonts, are rendered by FreeType
+			if( FT_Render_Glyph( slot, FT_RENDER_MODE_NORMAL ) || slot->bitmap.pixel_mode != FT_PIXEL_MODE_GRAY ) {
+				client.mFailed.insert( glyph );
+				continue;
+			}
+			const FT_Bitmap &ftBitmap = slot->bitmap;
+			Atlas::GlyphBitmap bitmap;
+			bitmap.mClient = mAtlasClient;
+			bitmap.mGlyph = glyph;
+			bitmap.mPremultiply = mFormat.getPremultiply();
+			bitmap.mSize = ivec2( ftBitmap.width, ftBitmap.rows );
+			bitmap.mOffset = ivec2( slot->bitmap_left, slot->bitmap_top );
+			bitmap.mCoverage.resize( ftBitmap.width * ftBitmap.rows );
+			for( unsigned int y = 0; y < ftBitmap.rows; ++y ) {
+				const uint8_t *row = ( ftBitmap.pitch >= 0 ) ? ftBitmap.buffer + y * ftBitmap.pitch : ftBitmap.buffer + ( ftBitmap.rows - 1 - y ) * -ftBitmap.pitch;
+				std::copy( row, row + ftBitmap.width, &bitmap.mCoverage[y * ftBitmap.width] );
+			}
+			bitmaps.push_back( std::move( bitmap ) );
+			bitmapMeasures.push_back( i );
+		}
+	}
+
+	vector<Atlas::GlyphBitmap> rendered;
+	Atlas::Rasterizer::render( face->glyph->library, jobs, &rendered );
+
+	// insert in the order drawn. If every texture holds glyphs needed by this pass, the pass ends and the next one may recycle
+	// them. When that happens to the first glyph of the pass, its textures are pinned only by glyphs drawn after it, so they
+	// are released and the glyph is drawn in a pass of its own.
+	size_t end = glyphMeasures.size();
+	for( size_t j = 0, b = 0; j < rendered.size() || b < bitmaps.size(); ) {
+		const bool nextIsJob = ( b == bitmaps.size() ) || ( j < rendered.size() && jobMeasures[j] < bitmapMeasures[b] );
+		const size_t measure = nextIsJob ? jobMeasures[j] : bitmapMeasures[b];
+		const Atlas::GlyphBitmap &bitmap = nextIsJob ? rendered[j++] : bitmaps[b++];
+		if( ! mAtlas->insert( bitmap ) ) {
+			if( measure == begin ) {
+				mAtlas->releaseUse();
+				mAtlas->insert( bitmap );
+				end = begin + 1;
+			}
+			else
+				end = measure;
+			break;
+		}
+	}
+
+	mAtlas->regenerateMipmaps();
+	return end;
+#else
+	return glyphMeasures.size();
+#endif
+}
+
 void TextureFont::drawGlyphs( const vector<pair<Font::Glyph,vec2> > &glyphMeasures, const vec2 &baselineIn, const DrawOptions &options, const std::vector<ColorA8u> &colors )
 {
-	if( mTextures.empty() )
+	// a dynamic atlas may only have room for part of the glyphs at a time, in which case they are drawn in several passes
+	size_t begin = 0, end = mAtlas ? cacheGlyphs( glyphMeasures, 0 ) : glyphMeasures.size();
+	const auto &textures = getTextures();
+	const auto &glyphMap = getGlyphMap();
+	if( textures.empty() )
 		return;
 
 	if( ! colors.empty() )
 		assert( glyphMeasures.size() == colors.size() );
 
 	auto shader = options.getGlslProg();
-	if( ! shader ) {
-		auto shaderDef = ShaderDef().texture( mTextures[0] ).color();
+	if( ! shader && mSignedDistanceField )
+		shader = getSignedDistanceFieldGlslProg();
+	else if( ! shader ) {
+		auto shaderDef = ShaderDef().texture( textures[0] ).color();
 		shader = gl::getStockShader( shaderDef );
 	}
-	ScopedTextureBind texBindScp( mTextures[0] );
+	ScopedTextureBind texBindScp( textures[0] );
 	ScopedGlslProg glslScp( shader );
 
 	vec2 baseline = baselineIn;
 
 	const float scale = options.getScale();
-	for( size_t texIdx = 0; texIdx < mTextures.size(); ++texIdx ) {
-		vector<float> verts, texCoords;
-		vector<ColorA8u> vertColors;
-		const gl::TextureRef &curTex = mTextures[texIdx];
-#if defined( CINDER_GL_ES )
-		vector<uint16_t> indices;
-		uint16_t curIdx = 0;
-		GLenum indexType = GL_UNSIGNED_SHORT;
-#else
-		vector<uint32_t> indices;
-		uint32_t curIdx = 0;
-		GLenum indexType = GL_UNSIGNED_INT;
-#endif
-		if( options.getPixelSnap() )
-			baseline = vec2( floor( baseline.x ), floor( baseline.y ) );
-			
-		for( vector<pair<Font::Glyph,vec2> >::const_iterator glyphIt = glyphMeasures.begin(); glyphIt != glyphMeasures.end(); ++glyphIt ) {
-			unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = mGlyphMap.find( glyphIt->first );
-			if( (glyphInfoIt == mGlyphMap.end()) || (mGlyphMap[glyphIt->first].mTextureIndex != texIdx) )
-				continue;
-				
-			const GlyphInfo &glyphInfo = glyphInfoIt->second;
-			
-			Rectf destRect( glyphInfo.mTexCoords );
-			Rectf srcCoords = curTex->getAreaTexCoords( glyphInfo.mTexCoords );
-			destRect -= destRect.getUpperLeft();
-			destRect.scale( scale );
-			destRect += glyphIt->second * scale;
-			destRect += vec2( floor( glyphInfo.mOriginOffset.x + 0.5f ), floor( glyphInfo.mOriginOffset.y ) ) * scale;
-			destRect += vec2( baseline.x, baseline.y - mFont.getAscent() * scale );
+	while( begin < end ) {
+		for( size_t texIdx = 0; texIdx < textures.size(); ++texIdx ) {
+			vector<float> verts, texCoords;
+			vector<ColorA8u> vertColors;
+			const gl::TextureRef &curTex = textures[texIdx];
+	#if defined( CINDER_GL_ES )
+			vector<uint16_t> indices;
+			uint16_t curIdx = 0;
+			GLenum indexType = GL_UNSIGNED_SHORT;
+	#else
+			vector<uint32_t> indices;
+			uint32_t curIdx = 0;
+			GLenum indexType = GL_UNSIGNED_INT;
+	#endif
 			if( options.getPixelSnap() )
-				destRect -= vec2( destRect.x1 - floor( destRect.x1 ), destRect.y1 - floor( destRect.y1 ) );				
+				baseline = vec2( floor( baseline.x ), floor( baseline.y ) );
+				
+			for( vector<pair<Font::Glyph,vec2> >::const_iterator glyphIt = glyphMeasures.begin() + begin; glyphIt != glyphMeasures.begin() + end; ++glyphIt ) {
+				unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = glyphMap.find( glyphIt->first );
+				if( (glyphInfoIt == glyphMap.end()) || (glyphInfoIt->second.mTextureIndex != texIdx) )
+					continue;
+					
+				const GlyphInfo &glyphInfo = glyphInfoIt->second;
+				
+				Rectf destRect( glyphInfo.mTexCoords );
+				Rectf srcCoords = curTex->getAreaTexCoords( glyphInfo.mTexCoords );
+				destRect -= destRect.getUpperLeft();
+				destRect.scale( scale );
+				destRect += glyphIt->second * scale;
+				destRect += vec2( floor( glyphInfo.mOriginOffset.x + 0.5f ), floor( glyphInfo.mOriginOffset.y ) ) * scale;
+				destRect += vec2( baseline.x, baseline.y - mFont.getAscent() * scale );
+				if( options.getPixelSnap() )
+					destRect -= vec2( destRect.x1 - floor( destRect.x1 ), destRect.y1 - floor( destRect.y1 ) );				
+				
+				verts.push_back( destRect.getX2() ); verts.push_back( destRect.getY1() );
+				verts.push_back( destRect.getX1() ); verts.push_back( destRect.getY1() );
+				verts.push_back( destRect.getX2() ); verts.push_back( destRect.getY2() );
+				verts.push_back( destRect.getX1() ); verts.push_back( destRect.getY2() );
+
+				texCoords.push_back( srcCoords.getX2() ); texCoords.push_back( srcCoords.getY1() );
+				texCoords.push_back( srcCoords.getX1() ); texCoords.push_back( srcCoords.getY1() );
+				texCoords.push_back( srcCoords.getX2() ); texCoords.push_back( srcCoords.getY2() );
+				texCoords.push_back( srcCoords.getX1() ); texCoords.push_back( srcCoords.getY2() );
+				
+				if( ! colors.empty() ) {
+					for( int i = 0; i < 4; ++i )
+						vertColors.push_back( colors[glyphIt-glyphMeasures.begin()] );
+				}
+
+				indices.push_back( curIdx + 0 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 2 );
+				indices.push_back( curIdx + 2 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 3 );
+				curIdx += 4;
+			}
 			
-			verts.push_back( destRect.getX2() ); verts.push_back( destRect.getY1() );
-			verts.push_back( destRect.getX1() ); verts.push_back( destRect.getY1() );
-			verts.push_back( destRect.getX2() ); verts.push_back( destRect.getY2() );
-			verts.push_back( destRect.getX1() ); verts.push_back( destRect.getY2() );
-
-			texCoords.push_back( srcCoords.getX2() ); texCoords.push_back( srcCoords.getY1() );
-			texCoords.push_back( srcCoords.getX1() ); texCoords.push_back( srcCoords.getY1() );
-			texCoords.push_back( srcCoords.getX2() ); texCoords.push_back( srcCoords.getY2() );
-			texCoords.push_back( srcCoords.getX1() ); texCoords.push_back( srcCoords.getY2() );
+			if( curIdx == 0 )
+				continue;
 			
-			if( ! colors.empty() ) {
-				for( int i = 0; i < 4; ++i )
-					vertColors.push_back( colors[glyphIt-glyphMeasures.begin()] );
+			curTex->bind();
+			auto ctx = gl::context();
+			size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
+			gl::ScopedVao vaoScp( ctx->getDefaultVao() );
+			ctx->getDefaultVao()->replacementBindBegin();
+			VboRef defaultElementVbo = ctx->getDefaultElementVbo( indices.size() * sizeof(curIdx) );
+			VboRef defaultArrayVbo = ctx->getDefaultArrayVbo( dataSize );
+
+			ScopedBuffer vboArrayScp( defaultArrayVbo );
+			ScopedBuffer vboElScp( defaultElementVbo );
+
+			size_t dataOffset = 0;
+			int posLoc = shader->getAttribSemanticLocation( geom::Attrib::POSITION );
+			if( posLoc >= 0 ) {
+				enableVertexAttribArray( posLoc );
+				vertexAttribPointer( posLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 );
+				defaultArrayVbo->bufferSubData( dataOffset, verts.size() * sizeof(float), verts.data() );
+				dataOffset += verts.size() * sizeof(float);
 			}
-
-			indices.push_back( curIdx + 0 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 2 );
-			indices.push_back( curIdx + 2 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 3 );
-			curIdx += 4;
-		}
-		
-		if( curIdx == 0 )
-			continue;
-		
-		curTex->bind();
-		auto ctx = gl::context();
-		size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
-		gl::ScopedVao vaoScp( ctx->getDefaultVao() );
-		ctx->getDefaultVao()->replacementBindBegin();
-		VboRef defaultElementVbo = ctx->getDefaultElementVbo( indices.size() * sizeof(curIdx) );
-		VboRef defaultArrayVbo = ctx->getDefaultArrayVbo( dataSize );
-
-		ScopedBuffer vboArrayScp( defaultArrayVbo );
-		ScopedBuffer vboElScp( defaultElementVbo );
-
-		size_t dataOffset = 0;
-		int posLoc = shader->getAttribSemanticLocation( geom::Attrib::POSITION );
-		if( posLoc >= 0 ) {
-			enableVertexAttribArray( posLoc );
-			vertexAttribPointer( posLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 );
-			defaultArrayVbo->bufferSubData( dataOffset, verts.size() * sizeof(float), verts.data() );
-			dataOffset += verts.size() * sizeof(float);
-		}
-		int texLoc = shader->getAttribSemanticLocation( geom::Attrib::TEX_COORD_0 );
-		if( texLoc >= 0 ) {
-			enableVertexAttribArray( texLoc );
-			vertexAttribPointer( texLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)dataOffset );
-			defaultArrayVbo->bufferSubData( dataOffset, texCoords.size() * sizeof(float), texCoords.data() );
-			dataOffset += texCoords.size() * sizeof(float);
-		}
-		if( ! vertColors.empty() ) {
-			int colorLoc = shader->getAttribSemanticLocation( geom::Attrib::COLOR );
-			if( colorLoc >= 0 ) {
-				enableVertexAttribArray( colorLoc );
-				vertexAttribPointer( colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)dataOffset );
-				defaultArrayVbo->bufferSubData( dataOffset, vertColors.size() * sizeof(ColorA8u), vertColors.data() );
-				dataOffset += vertColors.size() * sizeof(ColorA8u);				
+			int texLoc = shader->getAttribSemanticLocation( geom::Attrib::TEX_COORD_0 );
+			if( texLoc >= 0 ) {
+				enableVertexAttribArray( texLoc );
+				vertexAttribPointer( texLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)dataOffset );
+				defaultArrayVbo->bufferSubData( dataOffset, texCoords.size() * sizeof(float), texCoords.data() );
+				dataOffset += texCoords.size() * sizeof(float);
 			}
+			if( ! vertColors.empty() ) {
+				int colorLoc = shader->getAttribSemanticLocation( geom::Attrib::COLOR );
+				if( colorLoc >= 0 ) {
+					enableVertexAttribArray( colorLoc );
+					vertexAttribPointer( colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)dataOffset );
+					defaultArrayVbo->bufferSubData( dataOffset, vertColors.size() * sizeof(ColorA8u), vertColors.data() );
+					dataOffset += vertColors.size() * sizeof(ColorA8u);				
+				}
+			}
+
+			defaultElementVbo->bufferSubData( 0, indices.size() * sizeof(curIdx), indices.data() );
+			ctx->getDefaultVao()->replacementBindEnd();
+			gl::setDefaultShaderVars();
+			ctx->drawElements( GL_TRIANGLES, (GLsizei)indices.size(), indexType, 0 );
 		}
 
-		defaultElementVbo->bufferSubData( 0, indices.size() * sizeof(curIdx), indices.data() );
-		ctx->getDefaultVao()->replacementBindEnd();
-		gl::setDefaultShaderVars();
-		ctx->drawElements( GL_TRIANGLES, (GLsizei)indices.size(), indexType, 0 );
+		begin = end;
+		if( begin < glyphMeasures.size() )
+			end = cacheGlyphs( glyphMeasures, begin );
 	}
 }
 
 void TextureFont::drawGlyphs( const std::vector<std::pair<Font::Glyph,vec2> > &glyphMeasures, const Rectf &clip, vec2 offset, const DrawOptions &options, const std::vector<ColorA8u> &colors )
 {
-	if( mTextures.empty() )
+	// a dynamic atlas may only have room for part of the glyphs at a time, in which case they are drawn in several passes
+	size_t begin = 0, end = mAtlas ? cacheGlyphs( glyphMeasures, 0 ) : glyphMeasures.size();
+	const auto &textures = getTextures();
+	const auto &glyphMap = getGlyphMap();
+	if( textures.empty() )
 		return;
 
 	if( ! colors.empty() )
 		assert( glyphMeasures.size() == colors.size() );
 
 	auto shader = options.getGlslProg();
-	if( ! shader ) {
-		auto shaderDef = ShaderDef().texture( mTextures[0] ).color();
+	if( ! shader && mSignedDistanceField )
+		shader = getSignedDistanceFieldGlslProg();
+	else if( ! shader ) {
+		auto shaderDef = ShaderDef().texture( textures[0] ).color();
 		shader = gl::getStockShader( shaderDef );
 	}
-	ScopedTextureBind texBindScp( mTextures[0] );
+	ScopedTextureBind texBindScp( textures[0] );
 	ScopedGlslProg glslScp( shader );
 
 	const float scale = options.getScale();
 
-	for( size_t texIdx = 0; texIdx < mTextures.size(); ++texIdx ) {
-		vector<float> verts, texCoords;
-		vector<ColorA8u> vertColors;
-		const gl::TextureRef &curTex = mTextures[texIdx];
-#if defined( CINDER_GL_ES )
-		vector<uint16_t> indices;
-		uint16_t curIdx = 0;
-		GLenum indexType = GL_UNSIGNED_SHORT;
-#else
-		vector<uint32_t> indices;
-		uint32_t curIdx = 0;
-		GLenum indexType = GL_UNSIGNED_INT;
-#endif
-		if( options.getPixelSnap() )
-			offset = vec2( floor( offset.x ), floor( offset.y ) );
-
-		for( vector<pair<Font::Glyph,vec2> >::const_iterator glyphIt = glyphMeasures.begin(); glyphIt != glyphMeasures.end(); ++glyphIt ) {
-			unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = mGlyphMap.find( glyphIt->first );
-			if( (glyphInfoIt == mGlyphMap.end()) || (mGlyphMap[glyphIt->first].mTextureIndex != texIdx) )
-				continue;
-				
-			const GlyphInfo &glyphInfo = glyphInfoIt->second;
-			Rectf srcTexCoords = curTex->getAreaTexCoords( glyphInfo.mTexCoords );
-			Rectf destRect( glyphInfo.mTexCoords );
-			destRect -= destRect.getUpperLeft();
-			destRect.scale( scale );
-			destRect += glyphIt->second * scale;
-			destRect += vec2( floor( glyphInfo.mOriginOffset.x + 0.5f ), floor( glyphInfo.mOriginOffset.y ) ) * scale;
-			destRect += vec2( offset.x, offset.y );
+	while( begin < end ) {
+		for( size_t texIdx = 0; texIdx < textures.size(); ++texIdx ) {
+			vector<float> verts, texCoords;
+			vector<ColorA8u> vertColors;
+			const gl::TextureRef &curTex = textures[texIdx];
+	#if defined( CINDER_GL_ES )
+			vector<uint16_t> indices;
+			uint16_t curIdx = 0;
+			GLenum indexType = GL_UNSIGNED_SHORT;
+	#else
+			vector<uint32_t> indices;
+			uint32_t curIdx = 0;
+			GLenum indexType = GL_UNSIGNED_INT;
+	#endif
 			if( options.getPixelSnap() )
-				destRect -= vec2( destRect.x1 - floor( destRect.x1 ), destRect.y1 - floor( destRect.y1 ) );				
-
-			// clip
-			Rectf clipped( destRect );
-			if( options.getClipHorizontal() ) {
-				clipped.x1 = std::max( destRect.x1, clip.x1 );
-				clipped.x2 = std::min( destRect.x2, clip.x2 );
-			}
-			if( options.getClipVertical() ) {
-				clipped.y1 = std::max( destRect.y1, clip.y1 );
-				clipped.y2 = std::min( destRect.y2, clip.y2 );
+				offset = vec2( floor( offset.x ), floor( offset.y ) );
+
+			for( vector<pair<Font::Glyph,vec2> >::const_iterator glyphIt = glyphMeasures.begin() + begin; glyphIt != glyphMeasures.begin() + end; ++glyphIt ) {
+				unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = glyphMap.find( glyphIt->first );
+				if( (glyphInfoIt == glyphMap.end()) || (glyphInfoIt->second.mTextureIndex != texIdx) )
+					continue;
+					
+				const GlyphInfo &glyphInfo = glyphInfoIt->second;
+				Rectf srcTexCoords = curTex->getAreaTexCoords( glyphInfo.mTexCoords );
+				Rectf destRect( glyphInfo.mTexCoords );
+				destRect -= destRect.getUpperLeft();
+				destRect.scale( scale );
+				destRect += glyphIt->second * scale;
+				destRect += vec2( floor( glyphInfo.mOriginOffset.x + 0.5f ), floor( glyphInfo.mOriginOffset.y ) ) * scale;
+				destRect += vec2( offset.x, offset.y );
+				if( options.getPixelSnap() )
+					destRect -= vec2( destRect.x1 - floor( destRect.x1 ), destRect.y1 - floor( destRect.y1 ) );				
+
+				// clip
+				Rectf clipped( destRect );
+				if( options.getClipHorizontal() ) {
+					clipped.x1 = std::max( destRect.x1, clip.x1 );
+					clipped.x2 = std::min( destRect.x2, clip.x2 );
+				}
+				if( options.getClipVertical() ) {
+					clipped.y1 = std::max( destRect.y1, clip.y1 );
+					clipped.y2 = std::min( destRect.y2, clip.y2 );
+				}
+				
+				if( clipped.x1 >= clipped.x2 || clipped.y1 >= clipped.y2 )
+					continue;
+				
+				vec2 coordScale( 1 / (float)destRect.getWidth() / curTex->getWidth() * glyphInfo.mTexCoords.getWidth(),
+					1 / (float)destRect.getHeight() / curTex->getHeight() * glyphInfo.mTexCoords.getHeight() );
+				srcTexCoords.x1 = srcTexCoords.x1 + ( clipped.x1 - destRect.x1 ) * coordScale.x;
+				srcTexCoords.x2 = srcTexCoords.x1 + ( clipped.x2 - clipped.x1 ) * coordScale.x;
+				srcTexCoords.y1 = srcTexCoords.y1 + ( clipped.y1 - destRect.y1 ) * coordScale.y;
+				srcTexCoords.y2 = srcTexCoords.y1 + ( clipped.y2 - clipped.y1 ) * coordScale.y;
+
+				verts.push_back( clipped.getX2() ); verts.push_back( clipped.getY1() );
+				verts.push_back( clipped.getX1() ); verts.push_back( clipped.getY1() );
+				verts.push_back( clipped.getX2() ); verts.push_back( clipped.getY2() );
+				verts.push_back( clipped.getX1() ); verts.push_back( clipped.getY2() );
+
+				texCoords.push_back( srcTexCoords.getX2() ); texCoords.push_back( srcTexCoords.getY1() );
+				texCoords.push_back( srcTexCoords.getX1() ); texCoords.push_back( srcTexCoords.getY1() );
+				texCoords.push_back( srcTexCoords.getX2() ); texCoords.push_back( srcTexCoords.getY2() );
+				texCoords.push_back( srcTexCoords.getX1() ); texCoords.push_back( srcTexCoords.getY2() );
+
+				if( ! colors.empty() ) {
+					for( int i = 0; i < 4; ++i )
+						vertColors.push_back( colors[glyphIt-glyphMeasures.begin()] );
+				}
+				
+				indices.push_back( curIdx + 0 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 2 );
+				indices.push_back( curIdx + 2 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 3 );
+				curIdx += 4;
 			}
 			
-			if( clipped.x1 >= clipped.x2 || clipped.y1 >= clipped.y2 )
+			if( curIdx == 0 )
 				continue;
 			
-			vec2 coordScale( 1 / (float)destRect.getWidth() / curTex->getWidth() * glyphInfo.mTexCoords.getWidth(),
-				1 / (float)destRect.getHeight() / curTex->getHeight() * glyphInfo.mTexCoords.getHeight() );
-			srcTexCoords.x1 = srcTexCoords.x1 + ( clipped.x1 - destRect.x1 ) * coordScale.x;
-			srcTexCoords.x2 = srcTexCoords.x1 + ( clipped.x2 - clipped.x1 ) * coordScale.x;
-			srcTexCoords.y1 = srcTexCoords.y1 + ( clipped.y1 - destRect.y1 ) * coordScale.y;
-			srcTexCoords.y2 = srcTexCoords.y1 + ( clipped.y2 - clipped.y1 ) * coordScale.y;
-
-			verts.push_back( clipped.getX2() ); verts.push_back( clipped.getY1() );
-			verts.push_back( clipped.getX1() ); verts.push_back( clipped.getY1() );
-			verts.push_back( clipped.getX2() ); verts.push_back( clipped.getY2() );
-			verts.push_back( clipped.getX1() ); verts.push_back( clipped.getY2() );
-
-			texCoords.push_back( srcTexCoords.getX2() ); texCoords.push_back( srcTexCoords.getY1() );
-			texCoords.push_back( srcTexCoords.getX1() ); texCoords.push_back( srcTexCoords.getY1() );
-			texCoords.push_back( srcTexCoords.getX2() ); texCoords.push_back( srcTexCoords.getY2() );
-			texCoords.push_back( srcTexCoords.getX1() ); texCoords.push_back( srcTexCoords.getY2() );
-
-			if( ! colors.empty() ) {
-				for( int i = 0; i < 4; ++i )
-					vertColors.push_back( colors[glyphIt-glyphMeasures.begin()] );
+			curTex->bind();
+			auto ctx = gl::context();
+			size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
+			gl::ScopedVao vaoScp( ctx->getDefaultVao() );
+			ctx->getDefaultVao()->replacementBindBegin();
+			VboRef defaultElementVbo = ctx->getDefaultElementVbo( indices.size() * sizeof(curIdx) );
+			VboRef defaultArrayVbo = ctx->getDefaultArrayVbo( dataSize );
+
+			ScopedBuffer vboArrayScp( defaultArrayVbo );
+			ScopedBuffer vboElScp( defaultElementVbo );
+
+			size_t dataOffset = 0;
+			int posLoc = shader->getAttribSemanticLocation( geom::Attrib::POSITION );
+			if( posLoc >= 0 ) {
+				enableVertexAttribArray( posLoc );
+				vertexAttribPointer( posLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 );
+				defaultArrayVbo->bufferSubData( dataOffset, verts.size() * sizeof(float), verts.data() );
+				dataOffset += verts.size() * sizeof(float);
 			}
-			
-			indices.push_back( curIdx + 0 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 2 );
-			indices.push_back( curIdx + 2 ); indices.push_back( curIdx + 1 ); indices.push_back( curIdx + 3 );
-			curIdx += 4;
-		}
-		
-		if( curIdx == 0 )
-			continue;
-		
-		curTex->bind();
-		auto ctx = gl::context();
-		size_t dataSize = (verts.size() + texCoords.size()) * sizeof(float) + vertColors.size() * sizeof(ColorA8u);
-		gl::ScopedVao vaoScp( ctx->getDefaultVao() );
-		ctx->getDefaultVao()->replacementBindBegin();
-		VboRef defaultElementVbo = ctx->getDefaultElementVbo( indices.size() * sizeof(curIdx) );
-		VboRef defaultArrayVbo = ctx->getDefaultArrayVbo( dataSize );
-
-		ScopedBuffer vboArrayScp( defaultArrayVbo );
-		ScopedBuffer vboElScp( defaultElementVbo );
-
-		size_t dataOffset = 0;
-		int posLoc = shader->getAttribSemanticLocation( geom::Attrib::POSITION );
-		if( posLoc >= 0 ) {
-			enableVertexAttribArray( posLoc );
-			vertexAttribPointer( posLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)0 );
-			defaultArrayVbo->bufferSubData( dataOffset, verts.size() * sizeof(float), verts.data() );
-			dataOffset += verts.size() * sizeof(float);
-		}
-		int texLoc = shader->getAttribSemanticLocation( geom::Attrib::TEX_COORD_0 );
-		if( texLoc >= 0 ) {
-			enableVertexAttribArray( texLoc );
-			vertexAttribPointer( texLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)dataOffset );
-			defaultArrayVbo->bufferSubData( dataOffset, texCoords.size() * sizeof(float), texCoords.data() );
-			dataOffset += texCoords.size() * sizeof(float);
-		}
-		if( ! vertColors.empty() ) {
-			int colorLoc = shader->getAttribSemanticLocation( geom::Attrib::COLOR );
-			if( colorLoc >= 0 ) {
-				enableVertexAttribArray( colorLoc );
-				vertexAttribPointer( colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)dataOffset );
-				defaultArrayVbo->bufferSubData( dataOffset, vertColors.size() * sizeof(ColorA8u), vertColors.data() );
-				dataOffset += vertColors.size() * sizeof(ColorA8u);				
+			int texLoc = shader->getAttribSemanticLocation( geom::Attrib::TEX_COORD_0 );
+			if( texLoc >= 0 ) {
+				enableVertexAttribArray( texLoc );
+				vertexAttribPointer( texLoc, 2, GL_FLOAT, GL_FALSE, 0, (void*)dataOffset );
+				defaultArrayVbo->bufferSubData( dataOffset, texCoords.size() * sizeof(float), texCoords.data() );
+				dataOffset += texCoords.size() * sizeof(float);
+			}
+			if( ! vertColors.empty() ) {
+				int colorLoc = shader->getAttribSemanticLocation( geom::Attrib::COLOR );
+				if( colorLoc >= 0 ) {
+					enableVertexAttribArray( colorLoc );
+					vertexAttribPointer( colorLoc, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)dataOffset );
+					defaultArrayVbo->bufferSubData( dataOffset, vertColors.size() * sizeof(ColorA8u), vertColors.data() );
+					dataOffset += vertColors.size() * sizeof(ColorA8u);				
+				}
 			}
+
+			defaultElementVbo->bufferSubData( 0, indices.size() * sizeof(curIdx), indices.data() );
+			ctx->getDefaultVao()->replacementBindEnd();
+			gl::setDefaultShaderVars();
+			ctx->drawElements( GL_TRIANGLES, (GLsizei)indices.size(), indexType, 0 );
 		}
 
-		defaultElementVbo->bufferSubData( 0, indices.size() * sizeof(curIdx), indices.data() );
-		ctx->getDefaultVao()->replacementBindEnd();
-		gl::setDefaultShaderVars();
-		ctx->drawElements( GL_TRIANGLES, (GLsizei)indices.size(), indexType, 0 );
+		begin = end;
+		if( begin < glyphMeasures.size() )
+			end = cacheGlyphs( glyphMeasures, begin );
 	}
 }
 
+GlslProgRef TextureFont::getSignedDistanceFieldGlslProg()
+{
+	static GlslProgRef glsl = GlslProg::create( GlslProg::Format()
+		.vertex(
+			"uniform mat4 ciModelViewProjection;\n"
+#if defined( CINDER_GL_ES_2 )
+			"attribute vec4 ciPosition; attribute vec2 ciTexCoord0; attribute vec4 ciColor;\n"
+			"varying highp vec2 TexCoord; varying lowp vec4 Color;\n"
+#else
+			"in vec4 ciPosition; in vec2 ciTexCoord0; in vec4 ciColor;\n"
+			"out highp vec2 TexCoord; out lowp vec4 Color;\n"
+#endif
+			"void main() {\n"
+			"	gl_Position = ciModelViewProjection * ciPosition;\n"
+			"	TexCoord = ciTexCoord0;\n"
+			"	Color = ciColor;\n"
+			"}\n" )
+		.fragment(
+#if defined( CINDER_GL_ES_2 )
+			"#extension GL_OES_standard_derivatives : enable\n"
+			"uniform sampler2D uTex0;\n"
+			"varying highp vec2 TexCoord; varying lowp vec4 Color;\n"
+			"#define texture texture2D\n"
+			"#define oColor gl_FragColor\n"
+#else
+			"uniform sampler2D uTex0;\n"
+			"in highp vec2 TexCoord; in lowp vec4 Color;\n"
+			"out lowp vec4 oColor;\n"
+#endif
+			"void main() {\n"
+			"	highp float distance = texture( uTex0, TexCoord ).a;\n"
+			// half a pixel of screen space either side of the outline, whatever the scale
+			"	highp float width = 0.7071 * length( vec2( dFdx( distance ), dFdy( distance ) ) );\n"
+			"	oColor = vec4( Color.rgb, Color.a * smoothstep( 0.5 - width, 0.5 + width, distance ) );\n"
+			"}\n" )
+#if defined( CINDER_GL_ES_3 )
+		.version( 300 )
+#elif ! defined( CINDER_GL_ES )
+		.version( 150 )
+#endif
+	);
+
+	return glsl;
+}
+
 void TextureFont::drawString( const std::string &str, const vec2 &baseline, const DrawOptions &options )
 {
 	TextBox tbox = TextBox().font( mFont ).text( str ).size( TextBox::GROW, TextBox::GROW ).ligate( options.getLigate() );
@@ -756,8 +1420,9 @@ vec2 TextureFont::measureString( const std::string &str, const DrawOptions &opti
 #endif	
 	if( ! glyphMeasures.empty() ) {
 		vec2 result = glyphMeasures.back().second;
-		unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = mGlyphMap.find( glyphMeasures.back().first );
-		if( glyphInfoIt != mGlyphMap.end() )
+		const auto &glyphMap = getGlyphMap();
+		unordered_map<Font::Glyph, GlyphInfo>::const_iterator glyphInfoIt = glyphMap.find( glyphMeasures.back().first );
+		if( glyphInfoIt != glyphMap.end() )
 			result += glyphInfoIt->second.mOriginOffset + vec2( glyphInfoIt->second.mTexCoords.getSize() );
 		return result;
 	}
@@ -792,12 +1457,13 @@ vec2 TextureFont::measureStringWrapped( const std::string &str, const Rectf &fit
 				result.y = gm.second.y;
 			}
 		}
-		auto glyphInfoIt = mGlyphMap.find( glyphIndices.x );
-		if( glyphInfoIt != mGlyphMap.end() ) {
+		const auto &glyphMap = getGlyphMap();
+		auto glyphInfoIt = glyphMap.find( glyphIndices.x );
+		if( glyphInfoIt != glyphMap.end() ) {
 			result.x += glyphInfoIt->second.mOriginOffset.x + float( glyphInfoIt->second.mTexCoords.getWidth() );
 		}
-		glyphInfoIt = mGlyphMap.find( glyphIndices.y );
-		if( glyphInfoIt != mGlyphMap.end() ) {
+		glyphInfoIt = glyphMap.find( glyphIndices.y );
+		if( glyphInfoIt != glyphMap.end() ) {
 			result.y += glyphInfoIt->second.mOriginOffset.y + float( glyphInfoIt->second.mTexCoords.getHeight() );
 		}
 
@@ -28,6 +28,7 @@
 #include "cinder/gl/scoped.h"
 #include "cinder/gl/Environment.h"
 #include "cinder/Log.h"
+#include "cinder/PathFlattener.h"
 #include "cinder/Text.h"
 #include "cinder/Triangulate.h"
 
@@ -338,7 +339,12 @@ void draw( const Path2d &path, float approximationScale )
 		return;
 	}
 
-	vector<vec2> points = path.subdivide( approximationScale );
+	// the flattened points are reused across calls; a Context is only ever current on one thread
+	static thread_local vector<vec2> points;
+	const float tolerance = PathFlattener::calcTolerance( approximationScale );
+	points.resize( PathFlattener::calcNumPoints( path, tolerance ) );
+	PathFlattener::flatten( path, tolerance, points.data() );
+
 	VboRef arrayVbo = ctx->getDefaultArrayVbo( sizeof(vec2) * points.size() );
 	arrayVbo->bufferSubData( 0, sizeof(vec2) * points.size(), points.data() );
 
@@ -353,7 +359,7 @@ void draw( const Path2d &path, float approximationScale )
 
 	ctx->getDefaultVao()->replacementBindEnd();
 	ctx->setDefaultShaderVars();
-	ctx->drawArrays( GL_LINE_STRIP, 0, (GLsizei)points.size() );
+	ctx->drawArrays( path.isClosed() ? GL_LINE_LOOP : GL_LINE_STRIP, 0, (GLsizei)points.size() );
 	ctx->popVao();
 }
 
@@ -32,6 +32,9 @@
 #include "cinder/Log.h"
 #include "cinder/Unicode.h"
 
+#include <algorithm>
+#include <queue>
+
 using namespace std;
 
 namespace cinder { namespace svg {
@@ -45,50 +48,100 @@ bool isNumeric( char c )
 	return ( c >= '0' && c <= '9' ) || c == '.' || c == '-' || c == 'e' || c == 'E' || c == '+';
 }
 
+bool isWhitespace( char c )
+{
+	return c == ' ' || ( c >= '\t' && c <= '\r' );
+}
+
+// Returns mantissa * 10^exponent rounded to a float. Exact for mantissas below 2^53 and exponents within +/-22.
+float scaleByPowerOf10( uint64_t mantissa, int exponent )
+{
+	static const double sPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	if( mantissa == 0 )
+		return 0;
+	double result = (double)mantissa;
+	if( exponent >= 0 )
+		result *= ( exponent <= 22 ) ? sPowersOf10[exponent] : std::pow( 10.0, exponent );
+	else
+		result /= ( exponent >= -22 ) ? sPowersOf10[-exponent] : std::pow( 10.0, -exponent );
+	return (float)result;
+}
+
+// Parses a number in a single pass, without copying it or going through the locale. Up to 19 significant digits
+// are accumulated exactly. A second decimal point starts the next number, as in "0.5.5", and an 'e' not followed by
+// an exponent is left in place, as in the unit "em".
 float parseFloat( const char **sInOut )
 {
-	char temp[256];
-	size_t i = 0;
 	const char *s = *sInOut;
-	while( *s && (isspace(*s) || *s == ',') )
+	while( isWhitespace( *s ) || *s == ',' )
 		s++;
-	if( ! s )
-		throw PathParseExc();
-	if( isNumeric( *s ) ) {
-		while( *s == '-' || *s == '+' ) {
-			if( i < sizeof(temp) )
-				temp[i++] = *s;
-			s++;
-		}
-		bool parsingExponent = false, startingExponent;
-		bool seenDecimal = false;
-		while( *s && ( parsingExponent || (*s != '-' && *s != '+')) && isNumeric(*s) ) {
-			startingExponent = false;
-			if( *s == '.' && seenDecimal )
-				break;
-			else if( *s == '.' )
-				seenDecimal = true;
-			if( i < sizeof(temp) )
-				temp[i++] = *s;
-			if( *s == 'e' || *s == 'E' ) {
-				parsingExponent = true;
-				startingExponent = true;
+	if( ! isNumeric( *s ) )
+		throw FloatParseExc();
+
+	int numSigns = 0;
+	bool negative = false;
+	while( *s == '-' || *s == '+' ) {
+		negative = ( *s++ == '-' );
+		++numSigns;
+	}
+
+	uint64_t mantissa = 0;
+	int numDigits = 0, exponent = 0;
+	bool seenDecimal = false;
+	for( ; ; ++s ) {
+		if( *s >= '0' && *s <= '9' ) {
+			if( mantissa == 0 && *s == '0' ) { // leading zeros aren't significant
+				if( seenDecimal )
+					--exponent;
 			}
-			else
-				parsingExponent = false;
-			s++;
-		}
-		if( startingExponent ) { // if we got a false positive on an exponent, for example due to "ex" or "em" unit, back up one
-			--i;
-			--s;
+			else if( numDigits < 19 ) {
+				mantissa = mantissa * 10 + ( *s - '0' );
+				++numDigits;
+				if( seenDecimal )
+					--exponent;
+			}
+			else if( ! seenDecimal )
+				++exponent;
 		}
-		temp[i] = 0;
-		float result = (float)atof( temp );
-		*sInOut = s;
-		return result;
+		else if( *s == '.' && ! seenDecimal )
+			seenDecimal = true;
+		else
+			break;
+	}
+
+	if( ( *s == 'e' || *s == 'E' ) && ( ( s[1] >= '0' && s[1] <= '9' ) || s[1] == '-' || s[1] == '+' ) ) {
+		s++;
+		bool negativeExponent = false;
+		if( *s == '-' || *s == '+' )
+			negativeExponent = ( *s++ == '-' );
+		int value = 0;
+		for( ; *s >= '0' && *s <= '9'; ++s )
+			value = std::min( value * 10 + ( *s - '0' ), 100000 );
+		exponent += negativeExponent ? -value : value;
+	}
+
+	*sInOut = s;
+	if( numSigns > 1 ) // repeated signs, as in "+-1", don't form a number
+		return 0;
+	float result = scaleByPowerOf10( mantissa, exponent );
+	return negative ? -result : result;
+}
+
+// Returns the value of attribute \a name parsed as a float, ignoring any trailing units, or \a defaultValue if there is no such attribute or it isn't numeric
+float parseFloatAttribute( const XmlDoc::Node &xml, const char *name, float defaultValue )
+{
+	if( ! xml.hasAttribute( name ) )
+		return defaultValue;
+	const string value = xml.getAttributeValue<string>( name );
+	const char *s = value.c_str();
+	try {
+		return parseFloat( &s );
+	}
+	catch( FloatParseExc & ) {
+		return defaultValue;
 	}
-	else
-		throw FloatParseExc();
 }
 
 // parses float from comma-separated parenthetical list
@@ -281,15 +334,15 @@ Style::Style()
 	clear();
 }
 
-Style::Style( const XmlTree &xml, const Node *parent )
+Style::Style( const XmlDoc::Node &xml, const Node *parent )
 {
 	clear();
 
-	for( list<XmlTree::Attr>::const_iterator attIt = xml.getAttributes().begin(); attIt != xml.getAttributes().end(); ++attIt ) {
-		if( attIt->getName() == "style" )
-			parseStyleAttribute( attIt->getValue(), parent );
+	for( const XmlDoc::Attr &attr : xml.getAttributes() ) {
+		if( attr.getName() == "style" )
+			parseStyleAttribute( attr.getValue().str(), parent );
 		else
-			parseProperty( attIt->getName(), attIt->getValue(), parent );
+			parseProperty( attr.getName().str(), attr.getValue().str(), parent );
 	}
 }
 
@@ -615,7 +668,7 @@ Value Value::parse( const std::string &s )
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Node
-Node::Node( Node *parent, const XmlTree &xml )
+Node::Node( Node *parent, const XmlDoc::Node &xml )
 	: mParent( parent ), mStyle( xml, this ), mBoundingBoxCached( false )
 {
 	mSpecifiesTransform = false;
@@ -626,6 +679,49 @@ Node::Node( Node *parent, const XmlTree &xml )
 	}
 	else
 		mTransform = mat3();
+
+	// clip-path may be given as either an attribute or a style property, in the form "url(#id)"
+	string clipPath = xml.hasAttribute( "clip-path" ) ? xml["clip-path"] : findStyleValue( xml["style"], "clip-path" );
+	size_t idBegin = clipPath.find( "url(#" );
+	if( idBegin != string::npos ) {
+		idBegin += 5;
+		size_t idEnd = clipPath.find( ')', idBegin );
+		if( idEnd != string::npos )
+			mClipPathId = ci::trim( clipPath.substr( idBegin, idEnd - idBegin ) );
+	}
+}
+
+void Node::setStyle( const Style &style )
+{
+	mStyle = style;
+	invalidateDocSpatialIndex();
+}
+
+void Node::setTransform( const mat3 &transform )
+{
+	mTransform = transform;
+	mSpecifiesTransform = true;
+	invalidateDocSpatialIndex();
+}
+
+void Node::unspecifyTransform()
+{
+	mSpecifiesTransform = false;
+	invalidateDocSpatialIndex();
+}
+
+void Node::invalidateDocSpatialIndex()
+{
+	Doc *doc = getDoc();
+	if( doc )
+		doc->invalidateSpatialIndex();
+}
+
+const ClipPath* Node::findClipPath() const
+{
+	if( mClipPathId.empty() )
+		return nullptr;
+	return dynamic_cast<const ClipPath*>( findInAncestors( mClipPathId ) );
 }
 
 Doc* Node::getDoc() const
@@ -1009,13 +1105,13 @@ mat3 Node::getTransformAbsolute() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Gradient
-Gradient::Gradient( Node *parent, const XmlTree &xml )
+Gradient::Gradient( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml ), mUseObjectBoundingBox( true ), mSpecifiesTransform( false )
 {
 	parse( parent, xml );
 }
 
-void Gradient::parse( const Node *parent, const XmlTree &xml )
+void Gradient::parse( const Node *parent, const XmlDoc::Node &xml )
 {
 	if( xml.hasAttribute( "xlink:href" ) ) {
 		string ref = xml.getAttributeValue<string>( "xlink:href" );
@@ -1029,7 +1125,7 @@ void Gradient::parse( const Node *parent, const XmlTree &xml )
 			}
 		}
 	}
-	for( XmlTree::ConstIter stopsIt = xml.begin( "stop" ); stopsIt != xml.end(); ++stopsIt ) {
+	for( XmlDoc::Iter stopsIt = xml.begin( "stop" ); stopsIt != xml.end(); ++stopsIt ) {
 		mStops.push_back( Stop( parent, *stopsIt ) );
 	}
 	if( xml.hasAttribute( "gradientUnits" ) )
@@ -1052,7 +1148,7 @@ void Gradient::copyAttributesFrom( const Gradient &rhs )
 	}
 }
 
-Gradient::Stop::Stop( const Node *parent, const XmlTree &xml )
+Gradient::Stop::Stop( const Node *parent, const XmlDoc::Node &xml )
 	: mOffset( 0 ), mSpecifiesColor( false ), mSpecifiesOpacity( false )
 {
 	if( xml.hasAttribute( "offset" ) )
@@ -1095,18 +1191,18 @@ Paint Gradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // LinearGradient
-LinearGradient::LinearGradient( Node *parent, const XmlTree &xml )
+LinearGradient::LinearGradient( Node *parent, const XmlDoc::Node &xml )
 	: Gradient( parent, xml )
 {
 	parse( xml );
 }
 
-void LinearGradient::parse( const XmlTree &xml )
+void LinearGradient::parse( const XmlDoc::Node &xml )
 {
-	mCoords0.x = xml.getAttributeValue( "x1", 0.0f );
-	mCoords0.y = xml.getAttributeValue( "y1", 0.0f );
-	mCoords1.x = xml.getAttributeValue( "x2", 1.0f );
-	mCoords1.y = xml.getAttributeValue( "y2", 0.0f );
+	mCoords0.x = parseFloatAttribute( xml, "x1", 0.0f );
+	mCoords0.y = parseFloatAttribute( xml, "y1", 0.0f );
+	mCoords1.x = parseFloatAttribute( xml, "x2", 1.0f );
+	mCoords1.y = parseFloatAttribute( xml, "y2", 0.0f );
 }
 
 Paint LinearGradient::asPaint() const
@@ -1118,19 +1214,19 @@ Paint LinearGradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // RadialGradient
-RadialGradient::RadialGradient( Node *parent, const XmlTree &xml )
+RadialGradient::RadialGradient( Node *parent, const XmlDoc::Node &xml )
 	: Gradient( parent, xml )
 {
 	parse( xml );
 }
 
-void RadialGradient::parse( const XmlTree &xml )
+void RadialGradient::parse( const XmlDoc::Node &xml )
 {
-	mCoords0.x = xml.getAttributeValue( "cx", 0.5f );
-	mCoords0.y = xml.getAttributeValue( "cy", 0.5f );
-	mCoords1.x = xml.getAttributeValue( "fx", mCoords0.x );
-	mCoords1.y = xml.getAttributeValue( "fy", mCoords0.y );
-	mRadius = xml.getAttributeValue( "r", 0.5f );
+	mCoords0.x = parseFloatAttribute( xml, "cx", 0.5f );
+	mCoords0.y = parseFloatAttribute( xml, "cy", 0.5f );
+	mCoords1.x = parseFloatAttribute( xml, "fx", mCoords0.x );
+	mCoords1.y = parseFloatAttribute( xml, "fy", mCoords0.y );
+	mRadius = parseFloatAttribute( xml, "r", 0.5f );
 }
 
 Paint RadialGradient::asPaint() const
@@ -1143,12 +1239,12 @@ Paint RadialGradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Circle
-Circle::Circle( Node *parent, const XmlTree &xml )
+Circle::Circle( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
-	mCenter.x = xml.getAttributeValue( "cx", 0.0f );
-	mCenter.y = xml.getAttributeValue( "cy", 0.0f );
-	mRadius = xml.getAttributeValue( "r", 0.0f );	
+	mCenter.x = parseFloatAttribute( xml, "cx", 0.0f );
+	mCenter.y = parseFloatAttribute( xml, "cy", 0.0f );
+	mRadius = parseFloatAttribute( xml, "r", 0.0f );	
 }
 
 void Circle::renderSelf( Renderer &renderer ) const
@@ -1165,13 +1261,13 @@ Shape2d Circle::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Ellipse
-Ellipse::Ellipse( Node *parent, const XmlTree &xml )
+Ellipse::Ellipse( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
-	mCenter.x = xml.getAttributeValue( "cx", 0.0f );
-	mCenter.y = xml.getAttributeValue( "cy", 0.0f );
-	mRadiusX = xml.getAttributeValue( "rx", 0.0f );
-	mRadiusY = xml.getAttributeValue( "ry", 0.0f );
+	mCenter.x = parseFloatAttribute( xml, "cx", 0.0f );
+	mCenter.y = parseFloatAttribute( xml, "cy", 0.0f );
+	mRadiusX = parseFloatAttribute( xml, "rx", 0.0f );
+	mRadiusY = parseFloatAttribute( xml, "ry", 0.0f );
 }
 
 void Ellipse::renderSelf( Renderer &renderer ) const
@@ -1268,46 +1364,10 @@ void ellipticalArc( Shape2d &path, float x1, float y1, float x2, float y2, float
     }
 }
 
-static const char* getNextPathItem(const char* s, char it[64] )
-{
-	int i = 0;
-	it[0] = '\0';
-	// Skip white spaces and commas
-	while( *s && (isspace(*s) || *s == ',') )
-		s++;
-	if( ! *s )
-		return s;
-	if( isNumeric(*s) ) {
-		while( *s == '-' || *s == '+' ) {
-			if( i < 63 )
-				it[i++] = *s;
-			s++;
-		}
-		bool parsingExponent = false;
-		while( *s && ( parsingExponent || (*s != '-' && *s != '+')) && isNumeric(*s) ) {
-			if( i < 63 )
-				it[i++] = *s;
-			if( *s == 'e' || *s == 'E' )
-				parsingExponent = true;
-			else
-				parsingExponent = false;
-			s++;
-		}
-		it[i] = '\0';
-	}
-	else {
-		it[0] = *s++;
-		it[1] = '\0';
-		return s;
-	}
-
-	return s;
-}
-
 char readNextCommand( const char **sInOut )
 {
 	const char *s = *sInOut;
-	while( *s && (isspace(*s) || *s == ',') )
+	while( isWhitespace( *s ) || *s == ',' )
 		s++;
 	*sInOut = s + 1;
 	return *s;
@@ -1324,14 +1384,13 @@ bool readFlag( const char **sInOut )
 
 bool nextItemIsFloat( const char *s )
 {
-	while( *s && (isspace(*s) || *s == ',') )
+	while( isWhitespace( *s ) || *s == ',' )
 		s++;
 	return isNumeric( *s );
 }
 
-Shape2d parsePath( const std::string &p )
+Shape2d parsePath( const char *s )
 {
-	const char* s = p.c_str();
 	vec2 v0, v1, v2;
 	vec2 lastPoint, lastPoint2;
 
@@ -1490,18 +1549,35 @@ Shape2d parsePath( const std::string &p )
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Path
-Path::Path( Node *parent, const XmlTree &xml )
+Path::Path( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
-	std::string p = xml.getAttributeValue<string>( "d", "" );
-	if( ! p.empty() ) {
-		mPath = parsePath( p );
+	if( xml.hasAttribute( "d" ) ) {
+		const Doc *doc = getDoc();
+		if( doc && doc->getParseOptions().getLazyPaths() )
+			mDeferredData = xml.getAttributeValue<string>( "d" );
+		else
+			mPath = parsePath( xml.getAttributeValue<string>( "d" ).c_str() );
+	}
+}
+
+void Path::parseData() const
+{
+	try {
+		mPath = parsePath( mDeferredData.c_str() );
+	}
+	catch( Exc & ) {
+		CI_LOG_E( "failed to parse path data of '" << getDomPath() << "'" );
+		mPath.clear();
 	}
+	mDeferredData.clear();
+	mDeferredData.shrink_to_fit();
 }
 
 void Path::appendShape2d( Shape2d *appendTo ) const
 {
-	for( vector<Path2d>::const_iterator pathIt = mPath.getContours().begin(); pathIt != mPath.getContours().end(); ++pathIt ) {
+	const Shape2d &shape = getShape2d();
+	for( vector<Path2d>::const_iterator pathIt = shape.getContours().begin(); pathIt != shape.getContours().end(); ++pathIt ) {
 		appendTo->appendContour( *pathIt );
 	}
 }
@@ -1513,13 +1589,13 @@ void Path::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Line
-Line::Line( Node *parent, const XmlTree &xml )
+Line::Line( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
-	mPoint1.x = xml.getAttributeValue<float>( "x1", 0 );
-	mPoint1.y = xml.getAttributeValue<float>( "y1", 0 );	
-	mPoint2.x = xml.getAttributeValue<float>( "x2", 0 );
-	mPoint2.y = xml.getAttributeValue<float>( "y2", 0 );	
+	mPoint1.x = parseFloatAttribute( xml, "x1", 0.0f );
+	mPoint1.y = parseFloatAttribute( xml, "y1", 0.0f );	
+	mPoint2.x = parseFloatAttribute( xml, "x2", 0.0f );
+	mPoint2.y = parseFloatAttribute( xml, "y2", 0.0f );	
 }
 
 void Line::renderSelf( Renderer &renderer ) const
@@ -1537,7 +1613,7 @@ Shape2d	Line::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Rect
-Rect::Rect( Node *parent, const XmlTree &xml )
+Rect::Rect( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
 	float width = 0, height = 0;
@@ -1580,26 +1656,22 @@ Shape2d	Rect::getShape() const
 vector<vec2> parsePointList( const std::string &p )
 {
 	vector<vec2> result;
-	
-	if( ! p.empty() ) {
-		char item[64];
-		const char *s = p.c_str();
-		bool odd = false;
-		float lastVal;
-		while( *s ) {
-			s = getNextPathItem( s, item );
-			if( ! odd )
-				lastVal = (float)atof( item );
-			else
-				result.push_back( vec2( lastVal, (float)atof( item ) ) );
-			odd = ! odd;
-		}
+
+	// an odd coordinate or anything non-numeric ends the list
+	const char *s = p.c_str();
+	while( nextItemIsFloat( s ) ) {
+		vec2 v;
+		v.x = parseFloat( &s );
+		if( ! nextItemIsFloat( s ) )
+			break;
+		v.y = parseFloat( &s );
+		result.push_back( v );
 	}
 
 	return result;
 }
 
-Polygon::Polygon( Node *parent, const XmlTree &xml )
+Polygon::Polygon( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
 	mPolyLine = PolyLine2f( parsePointList( xml.getAttributeValue<string>( "points", "" ) ) );
@@ -1629,7 +1701,7 @@ Shape2d	Polygon::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Polyline
-Polyline::Polyline( Node *parent, const XmlTree &xml )
+Polyline::Polyline( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
 	mPolyLine = PolyLine2f( parsePointList( xml.getAttributeValue<string>( "points", "" ) ) );
@@ -1657,7 +1729,7 @@ Shape2d	Polyline::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Group
-Group::Group( Node *parent, const XmlTree &xml )
+Group::Group( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
 	parse( xml );
@@ -1669,9 +1741,9 @@ Group::~Group()
 		delete *childIt;
 }
 
-void Group::parse( const XmlTree &xml )
+void Group::parse( const XmlDoc::Node &xml )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+	for( XmlDoc::Iter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
 		if( treeIt->getTag() == "g" )
 			mChildren.push_back( new Group( this, *treeIt ) );
 		else if( treeIt->getTag() == "path" )
@@ -1690,8 +1762,14 @@ void Group::parse( const XmlTree &xml )
 			mChildren.push_back( new Ellipse( this, *treeIt ) );
 		else if( treeIt->getTag() == "use" )
 			mChildren.push_back( new Use( this, *treeIt ) );
-		else if( treeIt->getTag() == "defs" )
-			mDefs = shared_ptr<Group>( new Group( this, *treeIt ) );
+		else if( treeIt->getTag() == "defs" ) {
+			if( mDefs )
+				mDefs->parse( *treeIt );
+			else
+				mDefs = shared_ptr<Group>( new Group( this, *treeIt ) );
+		}
+		else if( treeIt->getTag() == "clipPath" )
+			addDef( new ClipPath( this, *treeIt ) );
 		else if( treeIt->getTag() == "image" )
 			mChildren.push_back( new Image( this, *treeIt ) );
 		else if( treeIt->getTag() == "linearGradient" )
@@ -1703,6 +1781,13 @@ void Group::parse( const XmlTree &xml )
 	}
 }
 
+void Group::addDef( Node *node )
+{
+	if( ! mDefs )
+		mDefs = shared_ptr<Group>( new Group( this ) );
+	mDefs->mChildren.push_back( node );
+}
+
 const Node* Group::findNodeByIdContains( const std::string &idPartial, bool recurse ) const
 {
 	for( list<Node*>::const_iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt ) {
@@ -1894,15 +1979,68 @@ void Group::iterate( const std::function<void(Node*)> &fn )
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+// ClipPath
+ClipPath::ClipPath( Node *parent, const XmlDoc::Node &xml )
+	: Group( parent, xml )
+{
+	mObjectBoundingBoxUnits = xml.getAttributeValue<string>( "clipPathUnits", "" ) == "objectBoundingBox";
+}
+
+mat3 ClipPath::calcTransformTo( const Node &clipped ) const
+{
+	mat3 result = mSpecifiesTransform ? mTransform : mat3();
+	if( mObjectBoundingBoxUnits ) {
+		Rectf bounds = clipped.getBoundingBox();
+		mat3 unitToBounds;
+		unitToBounds[0][0] = bounds.getWidth();
+		unitToBounds[1][1] = bounds.getHeight();
+		unitToBounds[2][0] = bounds.x1;
+		unitToBounds[2][1] = bounds.y1;
+		result = unitToBounds * result;
+	}
+	return result;
+}
+
+bool ClipPath::containsPoint( const vec2 &pt ) const
+{
+	for( list<Node*>::const_iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt ) {
+		if( (*childIt)->isDisplayNone() )
+			continue;
+		vec2 childPt = (*childIt)->specifiesTransform() ? vec2( (*childIt)->getTransformInverse() * vec3( pt, 1 ) ) : pt;
+		if( (*childIt)->containsPoint( childPt ) )
+			return true;
+	}
+	return false;
+}
+
+Rectf ClipPath::calcBoundingBox() const
+{
+	bool empty = true;
+	Rectf result( 0, 0, 0, 0 );
+	for( list<Node*>::const_iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt ) {
+		Rectf childBounds = (*childIt)->getBoundingBox();
+		if( (*childIt)->specifiesTransform() )
+			childBounds = childBounds.transformed( (*childIt)->getTransform() );
+		if( empty ) {
+			result = childBounds;
+			empty = false;
+		}
+		else
+			result.include( childBounds );
+	}
+	return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Use
-Use::Use( Node *parent, const XmlTree &xml )
+Use::Use( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml ), mReferenced( 0 )
 {
 	parse( xml );
 }
 
-void Use::parse( const XmlTree &xml )
+void Use::parse( const XmlDoc::Node &xml )
 {
 	if( xml.hasAttribute( "xlink:href" ) ) {
 		string ref = xml.getAttributeValue<string>( "xlink:href" );
@@ -1929,13 +2067,13 @@ void Use::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Image
-Image::Image( Node *parent, const XmlTree &xml )
+Image::Image( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml )
 {
-	mRect.x1 = xml.getAttributeValue<float>( "x", 0 );
-	mRect.y1 = xml.getAttributeValue<float>( "y", 0 );
-	float width = xml.getAttributeValue<float>( "width", 0 );
-	float height = xml.getAttributeValue<float>( "height", 0 );	
+	mRect.x1 = parseFloatAttribute( xml, "x", 0.0f );
+	mRect.y1 = parseFloatAttribute( xml, "y", 0.0f );
+	float width = parseFloatAttribute( xml, "width", 0.0f );
+	float height = parseFloatAttribute( xml, "height", 0.0f );	
 	mRect.x2 = mRect.x1 + width;
 	mRect.y2 = mRect.y1 + height;
 
@@ -1981,12 +2119,12 @@ void Image::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Text
-Text::Text( Node *parent, const XmlTree &xml )
+Text::Text( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml ), mAttributes( xml )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+	for( XmlDoc::Iter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
 		if( treeIt->getTag() == "" ) { // data!
-			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue() ) ) );
+			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue().str() ) ) );
 		}
 		else if( treeIt->getTag() == "tspan" ) { // tspan!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, *treeIt ) ) );
@@ -2045,12 +2183,12 @@ void Text::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // TextSpan
-TextSpan::TextSpan( Node *parent, const XmlTree &xml )
+TextSpan::TextSpan( Node *parent, const XmlDoc::Node &xml )
 	: Node( parent, xml ), mAttributes( xml ), mIgnoreAttributes( false )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+	for( XmlDoc::Iter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
 		if( treeIt->getTag() == "" ) { // data!
-			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue() ) ) );
+			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue().str() ) ) );
 		}
 		else if( treeIt->getTag() == "tspan" ) { // tspan!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, *treeIt ) ) );
@@ -2150,7 +2288,7 @@ Shape2d TextSpan::getShape() const
 #endif
 
 // TextSpan::Atributes
-TextSpan::Attributes::Attributes( const XmlTree &xml )
+TextSpan::Attributes::Attributes( const XmlDoc::Node &xml )
 {
 	if( xml.hasAttribute( "x" ) )
 		mX = readValueList( xml["x"], false );
@@ -2258,16 +2396,303 @@ void TextSpan::Attributes::setTextPen( const vec2 &textPen )
 		mY[0] = Value( textPen.y );
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+// DocSpatialIndex
+// A bounding volume hierarchy over the absolute bounds of every drawn leaf Node, built by median splits along the longest axis.
+// Entries are stored in paint order, so for overlapping hits the highest index is the top-most Node.
+class DocSpatialIndex {
+  public:
+	DocSpatialIndex( const Doc &doc );
+
+	Node*			findInnermost( const vec2 &pt ) const;
+	vector<Node*>	findInRect( const Rectf &rect ) const;
+	Node*			findNearest( const vec2 &pt, float maxDistance, float *resultDistance ) const;
+
+  private:
+	struct Entry {
+		Node		*mNode;
+		mat3		mTransform; // absolute
+		Rectf		mBounds; // absolute, restricted to the bounds of mClip
+		int32_t		mClip;
+	};
+
+	struct Clip {
+		const ClipPath	*mClipPath;
+		mat3			mInverseTransform; // from absolute coordinates to the clip path's contents
+		Rectf			mBounds; // absolute, restricted to the bounds of mParent
+		int32_t			mParent;
+	};
+
+	struct BvhNode {
+		Rectf		mBounds;
+		uint32_t	mFirst; // first entry for leaves, second child for interior nodes; the first child immediately follows its parent
+		uint32_t	mCount; // 0 for interior nodes
+	};
+
+	static const uint32_t MAX_LEAF_ENTRIES = 4;
+
+	void	addChildren( const Group &group, const mat3 &transform, bool visible, int32_t clip );
+	int32_t	addClip( const Node &node, const mat3 &transform, int32_t clip );
+	void	buildBvh( uint32_t begin, uint32_t end );
+	bool	entryContains( const Entry &entry, const vec2 &pt ) const;
+	float	calcEntryDistance( const Entry &entry, const vec2 &pt ) const;
+
+	static bool		intersect( const Rectf &a, const Rectf &b, Rectf *result );
+
+	vector<Entry>		mEntries;
+	vector<Clip>		mClips;
+	vector<BvhNode>		mBvh;
+	vector<uint32_t>	mOrder; // entry indices, reordered by buildBvh()
+};
+
+DocSpatialIndex::DocSpatialIndex( const Doc &doc )
+{
+	addChildren( doc, doc.specifiesTransform() ? doc.getTransform() : mat3(), true, -1 );
+
+	mOrder.resize( mEntries.size() );
+	for( uint32_t i = 0; i < mOrder.size(); ++i )
+		mOrder[i] = i;
+	mBvh.reserve( mEntries.size() / MAX_LEAF_ENTRIES * 2 + 1 );
+	if( ! mEntries.empty() )
+		buildBvh( 0, (uint32_t)mEntries.size() );
+}
+
+bool DocSpatialIndex::intersect( const Rectf &a, const Rectf &b, Rectf *result )
+{
+	*result = Rectf( std::max( a.x1, b.x1 ), std::max( a.y1, b.y1 ), std::min( a.x2, b.x2 ), std::min( a.y2, b.y2 ) );
+	return result->x1 <= result->x2 && result->y1 <= result->y2;
+}
+
+void DocSpatialIndex::addChildren( const Group &group, const mat3 &transform, bool visible, int32_t clip )
+{
+	for( list<Node*>::const_iterator childIt = group.getChildren().begin(); childIt != group.getChildren().end(); ++childIt ) {
+		Node *child = *childIt;
+		if( child->isDisplayNone() ) // like rendering, display: none hides the whole subtree
+			continue;
+
+		mat3 childTransform = child->specifiesTransform() ? transform * child->getTransform() : transform;
+		bool childVisible = child->getStyle().specifiesVisible() ? child->getStyle().isVisible() : visible;
+		int32_t childClip = addClip( *child, childTransform, clip );
+		if( childClip == -2 ) // clipped away entirely
+			continue;
+
+		if( typeid(*child) == typeid(svg::Group) ) {
+			addChildren( *static_cast<Group*>( child ), childTransform, childVisible, childClip );
+			continue;
+		}
+
+		Rectf bounds = child->getBoundingBox();
+		if( ! childVisible || ( bounds.getWidth() <= 0 && bounds.getHeight() <= 0 ) ) // skips gradients and empty text
+			continue;
+		bounds = bounds.transformed( childTransform );
+		if( childClip >= 0 && ! intersect( bounds, mClips[childClip].mBounds, &bounds ) )
+			continue;
+
+		mEntries.push_back( Entry{ child, childTransform, bounds, childClip } );
+	}
+}
+
+// Returns the clip for 'node' and its descendants: 'clip' when 'node' isn't clipped itself, or -2 if nothing of 'node' can be drawn
+int32_t DocSpatialIndex::addClip( const Node &node, const mat3 &transform, int32_t clip )
+{
+	const ClipPath *clipPath = node.findClipPath();
+	if( ! clipPath )
+		return clip;
+
+	mat3 clipTransform = transform * clipPath->calcTransformTo( node );
+	Rectf bounds = clipPath->getBoundingBox().transformed( clipTransform );
+	if( clip >= 0 && ! intersect( bounds, mClips[clip].mBounds, &bounds ) )
+		return -2;
+
+	mClips.push_back( Clip{ clipPath, inverse( clipTransform ), bounds, clip } );
+	return (int32_t)mClips.size() - 1;
+}
+
+void DocSpatialIndex::buildBvh( uint32_t begin, uint32_t end )
+{
+	uint32_t nodeIndex = (uint32_t)mBvh.size();
+	mBvh.emplace_back();
+
+	Rectf bounds = mEntries[mOrder[begin]].mBounds;
+	Rectf centers( bounds.getCenter(), bounds.getCenter() );
+	for( uint32_t i = begin + 1; i < end; ++i ) {
+		bounds.include( mEntries[mOrder[i]].mBounds );
+		centers.include( mEntries[mOrder[i]].mBounds.getCenter() );
+	}
+	mBvh[nodeIndex].mBounds = bounds;
+
+	if( end - begin <= MAX_LEAF_ENTRIES || ( centers.getWidth() <= 0 && centers.getHeight() <= 0 ) ) {
+		mBvh[nodeIndex].mFirst = begin;
+		mBvh[nodeIndex].mCount = end - begin;
+		return;
+	}
+
+	// split at the median center along the longest axis
+	const int axis = ( centers.getWidth() >= centers.getHeight() ) ? 0 : 1;
+	const uint32_t middle = begin + ( end - begin ) / 2;
+	nth_element( mOrder.begin() + begin, mOrder.begin() + middle, mOrder.begin() + end, [this, axis]( uint32_t a, uint32_t b ) {
+		return mEntries[a].mBounds.getCenter()[axis] < mEntries[b].mBounds.getCenter()[axis];
+	} );
+
+	buildBvh( begin, middle );
+	mBvh[nodeIndex].mFirst = (uint32_t)mBvh.size();
+	mBvh[nodeIndex].mCount = 0;
+	buildBvh( middle, end );
+}
+
+bool DocSpatialIndex::entryContains( const Entry &entry, const vec2 &pt ) const
+{
+	if( ! entry.mNode->containsPoint( vec2( inverse( entry.mTransform ) * vec3( pt, 1 ) ) ) )
+		return false;
+
+	for( int32_t clip = entry.mClip; clip >= 0; clip = mClips[clip].mParent ) {
+		if( ! mClips[clip].mBounds.contains( pt ) )
+			return false;
+		if( ! mClips[clip].mClipPath->containsPoint( vec2( mClips[clip].mInverseTransform * vec3( pt, 1 ) ) ) )
+			return false;
+	}
+
+	return true;
+}
+
+// Returns the distance from 'pt' to the Node's outline, or to its bounds when it has no outline. Exact for unclipped
+// Nodes; for clipped Nodes the distance to the unclipped outline is raised to the distance to the clipped bounds.
+float DocSpatialIndex::calcEntryDistance( const Entry &entry, const vec2 &pt ) const
+{
+	float boundsDistance = entry.mBounds.distance( pt );
+	Shape2d shape = entry.mNode->getShape();
+	if( shape.getNumContours() == 0 )
+		return boundsDistance;
+
+	shape.transform( entry.mTransform );
+	return std::max( shape.calcDistance( pt ), boundsDistance );
+}
+
+Node* DocSpatialIndex::findInnermost( const vec2 &pt ) const
+{
+	if( mBvh.empty() )
+		return nullptr;
+
+	vector<uint32_t> candidates;
+	uint32_t stack[64];
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while( stackSize ) {
+		const BvhNode &bvhNode = mBvh[stack[--stackSize]];
+		if( ! bvhNode.mBounds.contains( pt ) )
+			continue;
+		if( bvhNode.mCount ) {
+			for( uint32_t i = bvhNode.mFirst; i < bvhNode.mFirst + bvhNode.mCount; ++i )
+				if( mEntries[mOrder[i]].mBounds.contains( pt ) )
+					candidates.push_back( mOrder[i] );
+		}
+		else {
+			stack[stackSize++] = uint32_t( &bvhNode - mBvh.data() ) + 1;
+			stack[stackSize++] = bvhNode.mFirst;
+		}
+	}
+
+	// test the exact shapes front to back
+	sort( candidates.begin(), candidates.end(), greater<uint32_t>() );
+	for( uint32_t candidate : candidates )
+		if( entryContains( mEntries[candidate], pt ) )
+			return mEntries[candidate].mNode;
+
+	return nullptr;
+}
+
+vector<Node*> DocSpatialIndex::findInRect( const Rectf &rect ) const
+{
+	vector<uint32_t> hits;
+	if( ! mBvh.empty() ) {
+		uint32_t stack[64];
+		size_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while( stackSize ) {
+			const BvhNode &bvhNode = mBvh[stack[--stackSize]];
+			if( ! bvhNode.mBounds.intersects( rect ) )
+				continue;
+			if( bvhNode.mCount ) {
+				for( uint32_t i = bvhNode.mFirst; i < bvhNode.mFirst + bvhNode.mCount; ++i )
+					if( mEntries[mOrder[i]].mBounds.intersects( rect ) )
+						hits.push_back( mOrder[i] );
+			}
+			else {
+				stack[stackSize++] = uint32_t( &bvhNode - mBvh.data() ) + 1;
+				stack[stackSize++] = bvhNode.mFirst;
+			}
+		}
+	}
+
+	sort( hits.begin(), hits.end() );
+	vector<Node*> result;
+	result.reserve( hits.size() );
+	for( uint32_t hit : hits )
+		result.push_back( mEntries[hit].mNode );
+	return result;
+}
+
+Node* DocSpatialIndex::findNearest( const vec2 &pt, float maxDistance, float *resultDistance ) const
+{
+	Node *result = findInnermost( pt );
+	if( result || mBvh.empty() ) {
+		if( result && resultDistance )
+			*resultDistance = 0;
+		return result;
+	}
+
+	// best-first search: BVH nodes and entries are visited in order of the distance to their bounds, which never exceeds the
+	// distance to their outlines. Once an entry's outline distance is known it is queued again, and when it is dequeued
+	// nothing left can be any closer.
+	enum Kind : uint32_t { BVH_NODE, ENTRY_BOUNDS, ENTRY_OUTLINE };
+	struct Item {
+		float		mDistance;
+		uint32_t	mIndex;
+		Kind		mKind;
+		bool operator<( const Item &rhs ) const { return mDistance > rhs.mDistance; }
+	};
+
+	priority_queue<Item> queue;
+	queue.push( Item{ mBvh[0].mBounds.distance( pt ), 0, BVH_NODE } );
+	while( ! queue.empty() ) {
+		Item item = queue.top();
+		queue.pop();
+		if( item.mDistance > maxDistance )
+			break;
+
+		if( item.mKind == ENTRY_OUTLINE ) {
+			if( resultDistance )
+				*resultDistance = item.mDistance;
+			return mEntries[item.mIndex].mNode;
+		}
+		else if( item.mKind == ENTRY_BOUNDS )
+			queue.push( Item{ calcEntryDistance( mEntries[item.mIndex], pt ), item.mIndex, ENTRY_OUTLINE } );
+		else {
+			const BvhNode &bvhNode = mBvh[item.mIndex];
+			if( bvhNode.mCount ) {
+				for( uint32_t i = bvhNode.mFirst; i < bvhNode.mFirst + bvhNode.mCount; ++i )
+					queue.push( Item{ mEntries[mOrder[i]].mBounds.distance( pt ), mOrder[i], ENTRY_BOUNDS } );
+			}
+			else {
+				queue.push( Item{ mBvh[item.mIndex + 1].mBounds.distance( pt ), item.mIndex + 1, BVH_NODE } );
+				queue.push( Item{ mBvh[bvhNode.mFirst].mBounds.distance( pt ), bvhNode.mFirst, BVH_NODE } );
+			}
+		}
+	}
+
+	return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Doc
-Doc::Doc( const fs::path &filePath )
-	: Group( 0 )
+Doc::Doc( const fs::path &filePath, const ParseOptions &options )
+	: Group( 0 ), mParseOptions( options )
 {
 	loadDoc( loadFile( filePath ), filePath );
 }
 
-Doc::Doc( DataSourceRef dataSource, const fs::path &filePath )
-	: Group( 0 )
+Doc::Doc( DataSourceRef dataSource, const fs::path &filePath, const ParseOptions &options )
+	: Group( 0 ), mParseOptions( options )
 {
 	fs::path relativePath = filePath;
 	if( filePath.empty() )
@@ -2275,17 +2700,17 @@ Doc::Doc( DataSourceRef dataSource, const fs::path &filePath )
 	loadDoc( dataSource, relativePath );
 }
 
-DocRef Doc::create( const fs::path &filePath )
+DocRef Doc::create( const fs::path &filePath, const ParseOptions &options )
 {
-	return DocRef( new svg::Doc( filePath ) );
+	return DocRef( new svg::Doc( filePath, options ) );
 }
 
-DocRef Doc::create( DataSourceRef dataSource, const fs::path &filePath )
+DocRef Doc::create( DataSourceRef dataSource, const fs::path &filePath, const ParseOptions &options )
 {
-	return DocRef( new svg::Doc( dataSource, filePath ) );
+	return DocRef( new svg::Doc( dataSource, filePath, options ) );
 }
 
-DocRef Doc::createFromSvgz( DataSourceRef dataSource, const fs::path &filePath )
+DocRef Doc::createFromSvgz( DataSourceRef dataSource, const fs::path &filePath, const ParseOptions &options )
 {
 	fs::path relativePath = filePath;
 	if( filePath.empty() )
@@ -2294,16 +2719,16 @@ DocRef Doc::createFromSvgz( DataSourceRef dataSource, const fs::path &filePath )
 	Buffer compressed( dataSource );
 	BufferRef decompressed = make_shared<Buffer>( decompressBuffer( compressed, false, true ) );
 	
-	return DocRef( new svg::Doc( DataSourceBuffer::create( decompressed, relativePath ) ) );
+	return DocRef( new svg::Doc( DataSourceBuffer::create( decompressed, relativePath ), fs::path(), options ) );
 }
 
 void Doc::loadDoc( DataSourceRef source, fs::path filePath )
 {
 	if( ! filePath.empty() )
 		mFilePath = filePath.parent_path();
-	mXmlTree = shared_ptr<XmlTree>( new XmlTree( source, XmlTree::ParseOptions().ignoreDataChildren( false ) ) );
-
-	const XmlTree &xml( mXmlTree->getChild( "svg" ) );
+	// the XmlDoc only lives while the Nodes are built from it
+	const XmlDoc xmlDoc( source, XmlTree::ParseOptions().ignoreDataChildren( false ) );
+	const XmlDoc::Node xml = xmlDoc.getChild( "svg" );
 
 	if( xml.hasAttribute( "viewBox" ) ) {
 		string vbox = xml.getAttributeValue<string>( "viewBox" );
@@ -2381,6 +2806,27 @@ Node* Doc::nodeUnderPoint( const vec2 &pt )
 	return Group::nodeUnderPoint( pt, mat3() );
 }
 
+Node* Doc::findInnermostNode( const vec2 &pt )
+{
+	if( ! mSpatialIndex )
+		mSpatialIndex = make_shared<DocSpatialIndex>( *this );
+	return mSpatialIndex->findInnermost( pt );
+}
+
+vector<Node*> Doc::findNodesInRect( const Rectf &rect )
+{
+	if( ! mSpatialIndex )
+		mSpatialIndex = make_shared<DocSpatialIndex>( *this );
+	return mSpatialIndex->findInRect( rect );
+}
+
+Node* Doc::findNearestNode( const vec2 &pt, float maxDistance, float *resultDistance )
+{
+	if( ! mSpatialIndex )
+		mSpatialIndex = make_shared<DocSpatialIndex>( *this );
+	return mSpatialIndex->findNearest( pt, maxDistance, resultDistance );
+}
+
 void Doc::renderSelf( Renderer &renderer ) const
 {
 	Group::renderSelf( renderer );
@@ -0,0 +1,801 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/svg/SvgRaster.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// the miter limit SVG uses when stroke-miterlimit is unspecified, which svg::Style doesn't parse
+const float MITER_LIMIT = 4;
+// maximum distance in pixels between curves and the polylines that approximate them
+const float DEVICE_TOLERANCE = 0.2f;
+
+struct StrokeParams {
+	float			mHalfWidth;
+	svg::LineJoin	mJoin;
+	svg::LineCap	mCap;
+	float			mTolerance;
+};
+
+vec2 leftNormal( const vec2 &dir )
+{
+	return vec2( -dir.y, dir.x );
+}
+
+// Appends the points of an arc around 'center', excluding its start and including its end
+void appendArc( vector<vec2> *out, const vec2 &center, float startAngle, float sweep, float radius, float tolerance )
+{
+	float step = 2 * math<float>::acos( std::max( -1.0f, 1 - tolerance / radius ) );
+	int numSteps = std::max( 1, (int)math<float>::ceil( math<float>::abs( sweep ) / std::max( step, 0.01f ) ) );
+	for( int i = 1; i <= numSteps; ++i ) {
+		float angle = startAngle + sweep * i / numSteps;
+		out->push_back( center + vec2( math<float>::cos( angle ), math<float>::sin( angle ) ) * radius );
+	}
+}
+
+// Appends the offset outline at vertex 'p' on the left of travel, between segments with directions 'dirIn' and 'dirOut'
+void appendJoin( vector<vec2> *out, const vec2 &p, const vec2 &dirIn, const vec2 &dirOut, const StrokeParams &params )
+{
+	vec2 offsetIn = leftNormal( dirIn ) * params.mHalfWidth;
+	vec2 offsetOut = leftNormal( dirOut ) * params.mHalfWidth;
+	float cross = dirIn.x * dirOut.y - dirIn.y * dirOut.x;
+	float dot = glm::dot( dirIn, dirOut );
+
+	out->push_back( p + offsetIn );
+	if( math<float>::abs( cross ) < 1e-6f && dot > 0 ) // straight on
+		return;
+
+	if( cross > 0 ) {
+		// inner side of the turn: route through the vertex, so the overlap is covered under the nonzero rule
+		out->push_back( p );
+	}
+	else if( params.mJoin == svg::LINE_JOIN_ROUND ) {
+		float startAngle = math<float>::atan2( offsetIn.y, offsetIn.x );
+		float sweep = math<float>::atan2( offsetIn.x * offsetOut.y - offsetIn.y * offsetOut.x, glm::dot( offsetIn, offsetOut ) );
+		appendArc( out, p, startAngle, sweep, params.mHalfWidth, params.mTolerance );
+		return;
+	}
+	else if( params.mJoin == svg::LINE_JOIN_MITER ) {
+		float cosHalfAngle = math<float>::sqrt( std::max( 0.0f, ( 1 + dot ) / 2 ) );
+		if( cosHalfAngle * MITER_LIMIT >= 1 )
+			out->push_back( p + normalize( offsetIn + offsetOut ) * ( params.mHalfWidth / cosHalfAngle ) );
+	}
+
+	out->push_back( p + offsetOut );
+}
+
+// Appends the cap at endpoint 'p' of a segment traveling in 'dir', from the left offset point to the right one
+void appendCap( vector<vec2> *out, const vec2 &p, const vec2 &dir, const StrokeParams &params )
+{
+	vec2 offset = leftNormal( dir ) * params.mHalfWidth;
+	if( params.mCap == svg::LINE_CAP_ROUND )
+		appendArc( out, p, math<float>::atan2( offset.y, offset.x ), -(float)M_PI, params.mHalfWidth, params.mTolerance );
+	else {
+		if( params.mCap == svg::LINE_CAP_SQUARE ) {
+			vec2 extension = dir * params.mHalfWidth;
+			out->push_back( p + offset + extension );
+			out->push_back( p - offset + extension );
+		}
+		out->push_back( p - offset );
+	}
+}
+
+// Appends the outlines of the stroke of 'points' to 'outlines', as closed polygons to be filled with the nonzero rule
+void strokeContour( vector<vec2> points, bool closed, const StrokeParams &params, vector<vector<vec2>> *outlines )
+{
+	// drop repeated points, which have no direction
+	points.erase( unique( points.begin(), points.end(), []( const vec2 &a, const vec2 &b ) { return distance2( a, b ) < 1e-12f; } ), points.end() );
+	if( closed && points.size() > 1 && distance2( points.front(), points.back() ) < 1e-12f )
+		points.pop_back();
+	if( closed && points.size() < 3 )
+		closed = false;
+
+	const size_t n = points.size();
+	if( n == 0 )
+		return;
+
+	if( n == 1 ) { // a zero length subpath only draws its caps
+		if( params.mCap == svg::LINE_CAP_BUTT )
+			return;
+		outlines->emplace_back();
+		if( params.mCap == svg::LINE_CAP_ROUND )
+			appendArc( &outlines->back(), points[0], 0, 2 * (float)M_PI, params.mHalfWidth, params.mTolerance );
+		else {
+			vec2 p = points[0];
+			float h = params.mHalfWidth;
+			outlines->back() = { p + vec2( -h, -h ), p + vec2( h, -h ), p + vec2( h, h ), p + vec2( -h, h ) };
+		}
+		return;
+	}
+
+	const size_t numSegments = closed ? n : n - 1;
+	vector<vec2> dirs( numSegments );
+	for( size_t i = 0; i < numSegments; ++i )
+		dirs[i] = normalize( points[( i + 1 ) % n] - points[i] );
+
+	if( closed ) {
+		// one loop along each side, traveling in opposite directions
+		outlines->emplace_back();
+		for( size_t i = 0; i < n; ++i )
+			appendJoin( &outlines->back(), points[i], dirs[( i + n - 1 ) % n], dirs[i], params );
+		outlines->emplace_back();
+		for( size_t i = n; i-- > 0; )
+			appendJoin( &outlines->back(), points[i], -dirs[i], -dirs[( i + n - 1 ) % n], params );
+	}
+	else {
+		// a single loop: out along the left side, around the end cap, back along the right side and around the start cap
+		outlines->emplace_back();
+		vector<vec2> &out = outlines->back();
+		out.push_back( points[0] + leftNormal( dirs[0] ) * params.mHalfWidth );
+		for( size_t i = 1; i + 1 < n; ++i )
+			appendJoin( &out, points[i], dirs[i - 1], dirs[i], params );
+		out.push_back( points[n - 1] + leftNormal( dirs[n - 2] ) * params.mHalfWidth );
+		appendCap( &out, points[n - 1], dirs[n - 2], params );
+		for( size_t i = n - 2; i > 0; --i )
+			appendJoin( &out, points[i], -dirs[i], -dirs[i - 1], params );
+		out.push_back( points[0] - leftNormal( dirs[0] ) * params.mHalfWidth );
+		appendCap( &out, points[0], -dirs[0], params );
+		out.pop_back(); // the start cap returns to the first point
+	}
+}
+
+inline float toFloat( uint8_t value )		{ return value * ( 1 / 255.0f ); }
+inline float toFloat( float value )			{ return value; }
+inline void fromFloat( float value, uint8_t *result )	{ *result = (uint8_t)( std::min( std::max( value, 0.0f ), 1.0f ) * 255 + 0.5f ); }
+inline void fromFloat( float value, float *result )		{ *result = value; }
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////////
+// SvgRendererRaster::Tile
+// Coverage is computed as in font-rs: every edge adds the signed area it covers to the cells of the rows it crosses, and
+// a prefix sum along each row yields the accumulated winding of every pixel, with fractional values along the edges.
+// Only the span of cells each row touched is visited and cleared, and the pixels past it share the final sum.
+class SvgRendererRaster::Tile {
+  public:
+	Tile( const SvgRendererRaster &renderer, int32_t size )
+		: mRenderer( renderer ), mSize( size ), mCells( ( size + 2 ) * size, 0.0f ), mRowMin( size, INT32_MAX ), mRowMax( size, -1 )
+	{
+		mLayers.emplace_back( size * size );
+	}
+
+	// the pixels of the bottom layer, premultiplied; rows are mSize apart
+	ColorAf*	getPixels()	{ return mLayers[0].data(); }
+
+	void render( const vector<uint32_t> &commands, int32_t x, int32_t y, int32_t width, int32_t height )
+	{
+		mX = x;
+		mY = y;
+		mWidth = width;
+		mHeight = height;
+		for( uint32_t commandIndex : commands ) {
+			const Command &command = mRenderer.mCommands[commandIndex];
+			if( command.mType == Command::FILL )
+				fill( command );
+			else if( command.mType == Command::PUSH_GROUP ) {
+				mLayers.emplace_back( mSize * mSize, ColorAf( 0, 0, 0, 0 ) );
+				mGroupOpacities.push_back( command.mOpacity );
+			}
+			else {
+				float opacity = mGroupOpacities.back();
+				mGroupOpacities.pop_back();
+				vector<ColorAf> layer = std::move( mLayers.back() );
+				mLayers.pop_back();
+				ColorAf *dst = mLayers.back().data();
+				for( size_t i = 0; i < layer.size(); ++i )
+					dst[i] = layer[i] * opacity + dst[i] * ( 1 - layer[i].a * opacity );
+			}
+		}
+	}
+
+  private:
+	void fill( const Command &command )
+	{
+		const float tileY1 = float( mY + mHeight );
+		const Edge *edges = mRenderer.mEdges.data() + command.mFirstEdge;
+		for( uint32_t i = 0; i < command.mNumEdges; ++i ) {
+			const Edge &edge = edges[i];
+			if( edge.mY0 >= tileY1 ) // edges are sorted by mY0
+				break;
+			if( edge.mY1 > mY )
+				addEdge( edge );
+		}
+
+		const RasterPaint &paint = mRenderer.mPaints[command.mPaint];
+		for( int32_t row = mMinRow; row <= mMaxRow; ++row ) {
+			if( mRowMax[row] >= 0 )
+				compositeRow( row, paint, command.mEvenOdd );
+		}
+		mMinRow = INT32_MAX;
+		mMaxRow = -1;
+	}
+
+	void addEdge( const Edge &edge )
+	{
+		float x0 = edge.mX0 - mX, y0 = edge.mY0 - mY, x1 = edge.mX1 - mX, y1 = edge.mY1 - mY;
+		const float dxdy = ( x1 - x0 ) / ( y1 - y0 );
+		if( y0 < 0 ) {
+			x0 -= y0 * dxdy;
+			y0 = 0;
+		}
+		if( y1 > mHeight ) {
+			x1 -= ( y1 - mHeight ) * dxdy;
+			y1 = (float)mHeight;
+		}
+
+		// the parts left of the tile cover every pixel of their rows and the parts right of it none, so they're
+		// clamped to vertical lines along the sides of the tile
+		const float width = (float)mWidth;
+		float splits[4] = { y0, y1, y1, y1 };
+		int numSplits = 1;
+		for( float side : { 0.0f, width } ) {
+			if( ( x0 - side ) * ( x1 - side ) < 0 )
+				splits[numSplits++] = y0 + ( side - x0 ) / dxdy;
+		}
+		splits[numSplits++] = y1;
+		sort( splits, splits + numSplits );
+		for( int i = 0; i + 1 < numSplits; ++i ) {
+			float ya = splits[i], yb = splits[i + 1];
+			float xa = glm::clamp( x0 + ( ya - y0 ) * dxdy, 0.0f, width );
+			float xb = glm::clamp( x0 + ( yb - y0 ) * dxdy, 0.0f, width );
+			if( yb > ya )
+				accumulateLine( xa, ya, xb, yb, edge.mWinding );
+		}
+	}
+
+	// Adds the signed area of the line from (x0,y0) to (x1,y1), with y0 < y1, to the cells it crosses
+	void accumulateLine( float x0, float y0, float x1, float y1, float winding )
+	{
+		const float dxdy = ( x1 - x0 ) / ( y1 - y0 );
+		const int32_t rowBegin = (int32_t)y0;
+		const int32_t rowEnd = std::min( mHeight, (int32_t)math<float>::ceil( y1 ) );
+		const int32_t stride = mSize + 2;
+		mMinRow = std::min( mMinRow, rowBegin );
+		mMaxRow = std::max( mMaxRow, rowEnd - 1 );
+
+		float x = x0;
+		for( int32_t row = rowBegin; row < rowEnd; ++row ) {
+			float *cells = mCells.data() + row * stride;
+			const float dy = std::min( float( row + 1 ), y1 ) - std::max( float( row ), y0 );
+			const float xNext = glm::clamp( x + dxdy * dy, 0.0f, (float)mWidth ); // rounding mustn't leave the tile
+			const float d = dy * winding;
+			const float xMin = std::min( x, xNext ), xMax = std::max( x, xNext );
+			const float xMinFloor = math<float>::floor( xMin );
+			const int32_t xMinIndex = (int32_t)xMinFloor;
+			const float xMaxCeil = math<float>::ceil( xMax );
+			const int32_t xMaxIndex = (int32_t)xMaxCeil;
+
+			if( xMaxIndex <= xMinIndex + 1 ) { // within a single cell
+				const float xMid = 0.5f * ( x + xNext ) - xMinFloor;
+				cells[xMinIndex] += d - d * xMid;
+				cells[xMinIndex + 1] += d * xMid;
+				mRowMax[row] = std::max( mRowMax[row], xMinIndex + 1 );
+			}
+			else {
+				const float s = 1 / ( xMax - xMin );
+				const float xMinFract = xMin - xMinFloor;
+				const float a0 = 0.5f * s * ( 1 - xMinFract ) * ( 1 - xMinFract );
+				const float xMaxFract = xMax - xMaxCeil + 1;
+				const float am = 0.5f * s * xMaxFract * xMaxFract;
+				cells[xMinIndex] += d * a0;
+				if( xMaxIndex == xMinIndex + 2 )
+					cells[xMinIndex + 1] += d * ( 1 - a0 - am );
+				else {
+					const float a1 = s * ( 1.5f - xMinFract );
+					cells[xMinIndex + 1] += d * ( a1 - a0 );
+					for( int32_t i = xMinIndex + 2; i < xMaxIndex - 1; ++i )
+						cells[i] += d * s;
+					const float a2 = a1 + ( xMaxIndex - xMinIndex - 3 ) * s;
+					cells[xMaxIndex - 1] += d * ( 1 - a2 - am );
+				}
+				cells[xMaxIndex] += d * am;
+				mRowMax[row] = std::max( mRowMax[row], xMaxIndex );
+			}
+			mRowMin[row] = std::min( mRowMin[row], xMinIndex );
+			x = xNext;
+		}
+	}
+
+	void compositeRow( int32_t row, const RasterPaint &paint, bool evenOdd )
+	{
+		float *cells = mCells.data() + row * ( mSize + 2 );
+		ColorAf *pixels = mLayers.back().data() + row * mSize;
+		const int32_t begin = mRowMin[row], touchedEnd = mRowMax[row] + 1;
+
+		auto calcCoverage = [evenOdd]( float winding ) {
+			float w = math<float>::abs( winding );
+			if( evenOdd ) {
+				w = math<float>::fmod( w, 2.0f );
+				return ( w > 1 ) ? 2 - w : w;
+			}
+			return std::min( w, 1.0f );
+		};
+
+		// sum the touched cells into coverage, clearing them for the next fill
+		float winding = 0;
+		const int32_t end = std::min( touchedEnd, mWidth );
+		for( int32_t x = begin; x < end; ++x ) {
+			winding += cells[x];
+			cells[x] = 0;
+			mCoverage[x] = calcCoverage( winding );
+		}
+		for( int32_t x = end; x < touchedEnd; ++x )
+			cells[x] = 0;
+		mRowMin[row] = INT32_MAX;
+		mRowMax[row] = -1;
+
+		// every pixel past the touched cells shares the final coverage
+		const float restCoverage = calcCoverage( winding );
+		const int32_t coverageEnd = ( restCoverage > 1e-4f ) ? mWidth : end;
+		for( int32_t x = end; x < coverageEnd; ++x )
+			mCoverage[x] = restCoverage;
+
+		if( paint.mType == RasterPaint::SOLID ) {
+			const ColorAf &color = paint.mColor;
+			for( int32_t x = begin; x < coverageEnd; ++x ) {
+				float coverage = mCoverage[x];
+				if( coverage >= 1 && color.a >= 1 )
+					pixels[x] = color;
+				else if( coverage > 0 )
+					pixels[x] = color * coverage + pixels[x] * ( 1 - color.a * coverage );
+			}
+			return;
+		}
+
+		// gradients are sampled at pixel centers, stepping through gradient space one pixel at a time
+		const mat3 &m = paint.mDeviceToGradient;
+		vec2 p = vec2( m * vec3( mX + begin + 0.5f, mY + row + 0.5f, 1 ) );
+		const vec2 step = vec2( m[0] );
+		const float rampMax = float( paint.mRamp.size() - 1 );
+		for( int32_t x = begin; x < coverageEnd; ++x, p += step ) {
+			float coverage = mCoverage[x];
+			if( coverage <= 0 )
+				continue;
+			float t;
+			if( paint.mType == RasterPaint::LINEAR_GRADIENT ) {
+				vec2 axis = paint.mEnd - paint.mStart;
+				t = glm::dot( p - paint.mStart, axis ) / std::max( glm::dot( axis, axis ), 1e-12f );
+			}
+			else {
+				// the t whose circle, interpolated from the focus (t = 0) to the outer circle (t = 1), passes through p
+				vec2 e = paint.mCenter - paint.mFocus, q = p - paint.mFocus;
+				float a = glm::dot( e, e ) - paint.mRadius * paint.mRadius; // negative, since the focus is inside
+				float b = glm::dot( q, e ), c = glm::dot( q, q );
+				t = ( b - math<float>::sqrt( std::max( 0.0f, b * b - a * c ) ) ) / a;
+			}
+			const ColorAf &color = paint.mRamp[(size_t)( glm::clamp( t, 0.0f, 1.0f ) * rampMax + 0.5f )];
+			pixels[x] = color * coverage + pixels[x] * ( 1 - color.a * coverage );
+		}
+	}
+
+	const SvgRendererRaster		&mRenderer;
+	const int32_t				mSize;
+	int32_t						mX = 0, mY = 0, mWidth = 0, mHeight = 0;
+	vector<vector<ColorAf>>		mLayers;
+	vector<float>				mGroupOpacities;
+	vector<float>				mCells;
+	vector<int32_t>				mRowMin, mRowMax;
+	int32_t						mMinRow = INT32_MAX, mMaxRow = -1;
+	float						mCoverage[1024];
+};
+
+////////////////////////////////////////////////////////////////////////////////////
+// SvgRendererRaster
+SvgRendererRaster::SvgRendererRaster( const mat3 &transform )
+	: svg::Renderer(), mTileSize( 64 ), mNumContours( 0 )
+{
+	mMatrixStack.push_back( transform );
+	mFillStack.push_back( svg::Paint( Color::black() ) );
+	mStrokeStack.push_back( svg::Paint() );
+	mFillOpacityStack.push_back( 1.0f );
+	mStrokeOpacityStack.push_back( 1.0f );
+	mStrokeWidthStack.push_back( 1.0f );
+	mFillRuleStack.push_back( svg::FILL_RULE_NONZERO );
+	mLineCapStack.push_back( svg::LINE_CAP_BUTT );
+	mLineJoinStack.push_back( svg::LINE_JOIN_MITER );
+}
+
+void SvgRendererRaster::clear()
+{
+	mCommands.clear();
+	mEdges.clear();
+	mPaints.clear();
+	mGroupStack.clear();
+}
+
+void SvgRendererRaster::pushGroup( const svg::Group & /*group*/, float opacity )
+{
+	if( opacity < 1 ) {
+		Command command;
+		command.mType = Command::PUSH_GROUP;
+		command.mOpacity = std::max( opacity, 0.0f );
+		mGroupStack.push_back( (int32_t)mCommands.size() );
+		mCommands.push_back( command );
+	}
+	else
+		mGroupStack.push_back( -1 );
+}
+
+void SvgRendererRaster::popGroup()
+{
+	int32_t pushIndex = mGroupStack.back();
+	mGroupStack.pop_back();
+	if( pushIndex < 0 )
+		return;
+
+	if( pushIndex + 1 == (int32_t)mCommands.size() ) { // nothing was drawn
+		mCommands.pop_back();
+		return;
+	}
+
+	// the group's bounds enclose everything drawn within it, so that tiles it overlaps see both the push and the pop
+	Rectf bounds = mCommands[pushIndex + 1].mBounds;
+	for( size_t i = pushIndex + 2; i < mCommands.size(); ++i )
+		bounds.include( mCommands[i].mBounds );
+	mCommands[pushIndex].mBounds = bounds;
+
+	Command command;
+	command.mType = Command::POP_GROUP;
+	command.mBounds = bounds;
+	mCommands.push_back( command );
+}
+
+void SvgRendererRaster::drawPath( const svg::Path &path )
+{
+	drawShape( path, path.getShape2d() );
+}
+
+void SvgRendererRaster::drawPolyline( const svg::Polyline &polyline )
+{
+	drawShape( polyline, polyline.getShape() );
+}
+
+void SvgRendererRaster::drawPolygon( const svg::Polygon &polygon )
+{
+	drawShape( polygon, polygon.getShape() );
+}
+
+void SvgRendererRaster::drawLine( const svg::Line &line )
+{
+	drawShape( line, line.getShape(), false );
+}
+
+void SvgRendererRaster::drawRect( const svg::Rect &rect )
+{
+	drawShape( rect, rect.getShape() );
+}
+
+void SvgRendererRaster::drawCircle( const svg::Circle &circle )
+{
+	if( circle.getRadius() > 0 )
+		drawShape( circle, circle.getShape() );
+}
+
+void SvgRendererRaster::drawEllipse( const svg::Ellipse &ellipse )
+{
+	if( ellipse.getRadiusX() > 0 && ellipse.getRadiusY() > 0 )
+		drawShape( ellipse, ellipse.getShape() );
+}
+
+float SvgRendererRaster::calcTolerance() const
+{
+	const mat3 &m = mMatrixStack.back();
+	float scale = std::max( length( vec2( m[0] ) ), length( vec2( m[1] ) ) );
+	return DEVICE_TOLERANCE / std::max( scale, 1e-6f );
+}
+
+void SvgRendererRaster::drawShape( const svg::Node &node, const Shape2d &shape, bool fillable )
+{
+	const bool fill = fillable && ! mFillStack.back().isNone();
+	const bool stroke = ! mStrokeStack.back().isNone() && mStrokeWidthStack.back() > 0;
+	if( ! fill && ! stroke )
+		return;
+
+	const float tolerance = calcTolerance();
+	mFlattener.setTolerance( tolerance );
+	mFlattener.clear();
+	mFlattener.flatten( shape );
+
+	auto loadContours = [this] {
+		mNumContours = mFlattener.getNumContours();
+		if( mContours.size() < mNumContours )
+			mContours.resize( mNumContours );
+		for( size_t c = 0; c < mNumContours; ++c )
+			mContours[c].assign( mFlattener.getContourPoints( c ), mFlattener.getContourPoints( c ) + mFlattener.getContourNumPoints( c ) );
+	};
+
+	if( fill ) {
+		loadContours();
+		addFill( node, mFillRuleStack.back() == svg::FILL_RULE_EVENODD, mFillStack.back(), mFillOpacityStack.back() );
+	}
+
+	if( stroke ) {
+		loadContours();
+		vector<uint8_t> closed( mNumContours );
+		for( size_t c = 0; c < mNumContours; ++c )
+			closed[c] = mFlattener.isContourClosed( c ) ? 1 : 0;
+		expandStroke( closed, mStrokeWidthStack.back() / 2, tolerance );
+		addFill( node, false, mStrokeStack.back(), mStrokeOpacityStack.back() );
+	}
+}
+
+void SvgRendererRaster::expandStroke( const vector<uint8_t> &closed, float halfWidth, float tolerance )
+{
+	StrokeParams params;
+	params.mHalfWidth = halfWidth;
+	params.mJoin = mLineJoinStack.back();
+	params.mCap = mLineCapStack.back();
+	params.mTolerance = tolerance;
+
+	vector<vector<vec2>> outlines;
+	for( size_t c = 0; c < mNumContours; ++c )
+		strokeContour( std::move( mContours[c] ), closed[c] != 0, params, &outlines );
+
+	mNumContours = outlines.size();
+	mContours = std::move( outlines );
+}
+
+void SvgRendererRaster::addFill( const svg::Node &node, bool evenOdd, const svg::Paint &paint, float opacity )
+{
+	RasterPaint rasterPaint;
+	if( ! resolvePaint( node, paint, opacity, &rasterPaint ) )
+		return;
+
+	const mat3 &m = mMatrixStack.back();
+	const uint32_t firstEdge = (uint32_t)mEdges.size();
+	Rectf bounds( vec2( numeric_limits<float>::max() ), vec2( -numeric_limits<float>::max() ) );
+	for( size_t c = 0; c < mNumContours; ++c ) {
+		const vector<vec2> &contour = mContours[c];
+		if( contour.size() < 2 )
+			continue;
+		vec2 prev = vec2( m * vec3( contour.back(), 1 ) );
+		for( const vec2 &point : contour ) {
+			vec2 p = vec2( m * vec3( point, 1 ) );
+			if( p.y != prev.y ) {
+				if( prev.y < p.y )
+					mEdges.push_back( Edge{ prev.x, prev.y, p.x, p.y, 1 } );
+				else
+					mEdges.push_back( Edge{ p.x, p.y, prev.x, prev.y, -1 } );
+			}
+			bounds.include( p );
+			prev = p;
+		}
+	}
+
+	const uint32_t numEdges = (uint32_t)mEdges.size() - firstEdge;
+	if( numEdges == 0 )
+		return;
+	sort( mEdges.begin() + firstEdge, mEdges.end(), []( const Edge &a, const Edge &b ) { return a.mY0 < b.mY0; } );
+
+	Command command;
+	command.mType = Command::FILL;
+	command.mBounds = bounds;
+	command.mFirstEdge = firstEdge;
+	command.mNumEdges = numEdges;
+	command.mEvenOdd = evenOdd;
+	command.mPaint = (uint32_t)mPaints.size();
+	mCommands.push_back( command );
+	mPaints.push_back( std::move( rasterPaint ) );
+}
+
+bool SvgRendererRaster::resolvePaint( const svg::Node &node, const svg::Paint &paint, float opacity, RasterPaint *result ) const
+{
+	if( paint.isNone() || opacity <= 0 || paint.getNumColors() == 0 )
+		return false;
+
+	auto premultiplied = [opacity]( const ColorA8u &color ) {
+		ColorAf result( color );
+		result.a *= opacity;
+		return ColorAf( result.r * result.a, result.g * result.a, result.b * result.a, result.a );
+	};
+
+	if( ( ! paint.isLinearGradient() && ! paint.isRadialGradient() ) || paint.getNumColors() == 1 ) {
+		result->mType = RasterPaint::SOLID;
+		result->mColor = premultiplied( paint.getColor( 0 ) );
+		return result->mColor.a > 0;
+	}
+
+	// maps gradient space to the node's user space
+	mat3 gradientToUser = paint.specifiesTransform() ? paint.getTransform() : mat3();
+	if( paint.useObjectBoundingBox() ) {
+		Rectf bounds = node.getBoundingBox();
+		if( bounds.getWidth() <= 0 || bounds.getHeight() <= 0 )
+			return false;
+		mat3 unitToBounds;
+		unitToBounds[0][0] = bounds.getWidth();
+		unitToBounds[1][1] = bounds.getHeight();
+		unitToBounds[2][0] = bounds.x1;
+		unitToBounds[2][1] = bounds.y1;
+		gradientToUser = unitToBounds * gradientToUser;
+	}
+	result->mDeviceToGradient = inverse( mMatrixStack.back() * gradientToUser );
+
+	if( paint.isLinearGradient() ) {
+		result->mType = RasterPaint::LINEAR_GRADIENT;
+		result->mStart = paint.getCoords0();
+		result->mEnd = paint.getCoords1();
+	}
+	else {
+		result->mType = RasterPaint::RADIAL_GRADIENT;
+		result->mCenter = paint.getCoords0();
+		result->mRadius = paint.getRadius();
+		if( result->mRadius <= 0 )
+			return false;
+		// SVG moves a focus outside of the circle onto its edge; keep it just inside to leave the gradient defined everywhere
+		vec2 focusOffset = paint.getCoords1() - result->mCenter;
+		float maxFocusDistance = result->mRadius * 0.99f;
+		if( length( focusOffset ) > maxFocusDistance )
+			focusOffset = normalize( focusOffset ) * maxFocusDistance;
+		result->mFocus = result->mCenter + focusOffset;
+	}
+
+	// interpolate the stops unpremultiplied, then premultiply each entry of the ramp
+	result->mRamp.resize( RAMP_SIZE );
+	size_t stop = 0;
+	const size_t numStops = paint.getNumColors();
+	for( size_t i = 0; i < RAMP_SIZE; ++i ) {
+		float t = i / float( RAMP_SIZE - 1 );
+		while( stop + 1 < numStops && paint.getOffset( stop + 1 ) < t )
+			++stop;
+		ColorA8u color;
+		if( t <= paint.getOffset( 0 ) )
+			color = paint.getColor( 0 );
+		else if( stop + 1 >= numStops )
+			color = paint.getColor( numStops - 1 );
+		else {
+			float span = paint.getOffset( stop + 1 ) - paint.getOffset( stop );
+			float alpha = ( span > 0 ) ? ( t - paint.getOffset( stop ) ) / span : 1;
+			color = ColorA8u( lerp( ColorAf( paint.getColor( stop ) ), ColorAf( paint.getColor( stop + 1 ) ), glm::clamp( alpha, 0.0f, 1.0f ) ) );
+		}
+		result->mRamp[i] = premultiplied( color );
+	}
+
+	return true;
+}
+
+template<typename T>
+void SvgRendererRaster::rasterizeImpl( SurfaceT<T> *surface ) const
+{
+	const int32_t width = surface->getWidth(), height = surface->getHeight();
+	const int32_t tileSize = std::min( mTileSize, 1024 );
+	if( width <= 0 || height <= 0 || mCommands.empty() )
+		return;
+
+	// bin the commands into the tiles their bounds overlap, preserving their order
+	const int32_t tilesX = ( width + tileSize - 1 ) / tileSize, tilesY = ( height + tileSize - 1 ) / tileSize;
+	vector<vector<uint32_t>> bins( tilesX * tilesY );
+	for( uint32_t c = 0; c < mCommands.size(); ++c ) {
+		const Rectf &bounds = mCommands[c].mBounds;
+		if( bounds.x2 < 0 || bounds.y2 < 0 || bounds.x1 >= width || bounds.y1 >= height )
+			continue;
+		int32_t tx0 = std::max( 0, (int32_t)( bounds.x1 / tileSize ) ), tx1 = std::min( tilesX - 1, (int32_t)( bounds.x2 / tileSize ) );
+		int32_t ty0 = std::max( 0, (int32_t)( bounds.y1 / tileSize ) ), ty1 = std::min( tilesY - 1, (int32_t)( bounds.y2 / tileSize ) );
+		for( int32_t ty = ty0; ty <= ty1; ++ty )
+			for( int32_t tx = tx0; tx <= tx1; ++tx )
+				bins[ty * tilesX + tx].push_back( c );
+	}
+
+	const bool hasAlpha = surface->hasAlpha();
+	const bool premultiplied = surface->isPremultiplied();
+	const uint8_t red = surface->getRedOffset(), green = surface->getGreenOffset(), blue = surface->getBlueOffset();
+	const uint8_t alpha = hasAlpha ? surface->getAlphaOffset() : 0;
+	const uint8_t pixelInc = surface->getPixelInc();
+
+	parallelFor( 0, bins.size(), 1, [&]( size_t begin, size_t end ) {
+		Tile tile( *this, tileSize );
+		for( size_t t = begin; t < end; ++t ) {
+			if( bins[t].empty() )
+				continue;
+			const int32_t x0 = int32_t( t % tilesX ) * tileSize, y0 = int32_t( t / tilesX ) * tileSize;
+			const int32_t tileWidth = std::min( tileSize, width - x0 ), tileHeight = std::min( tileSize, height - y0 );
+
+			ColorAf *pixels = tile.getPixels();
+			for( int32_t y = 0; y < tileHeight; ++y ) {
+				const T *src = surface->getData( ivec2( x0, y0 + y ) );
+				for( int32_t x = 0; x < tileWidth; ++x, src += pixelInc ) {
+					ColorAf &pixel = pixels[y * tileSize + x];
+					pixel = ColorAf( toFloat( src[red] ), toFloat( src[green] ), toFloat( src[blue] ), hasAlpha ? toFloat( src[alpha] ) : 1 );
+					if( ! premultiplied ) {
+						pixel.r *= pixel.a;
+						pixel.g *= pixel.a;
+						pixel.b *= pixel.a;
+					}
+				}
+			}
+
+			tile.render( bins[t], x0, y0, tileWidth, tileHeight );
+
+			for( int32_t y = 0; y < tileHeight; ++y ) {
+				T *dst = surface->getData( ivec2( x0, y0 + y ) );
+				for( int32_t x = 0; x < tileWidth; ++x, dst += pixelInc ) {
+					ColorAf pixel = pixels[y * tileSize + x];
+					if( ! premultiplied && pixel.a > 0 ) {
+						float invAlpha = 1 / pixel.a;
+						pixel.r *= invAlpha;
+						pixel.g *= invAlpha;
+						pixel.b *= invAlpha;
+					}
+					fromFloat( pixel.r, &dst[red] );
+					fromFloat( pixel.g, &dst[green] );
+					fromFloat( pixel.b, &dst[blue] );
+					if( hasAlpha )
+						fromFloat( pixel.a, &dst[alpha] );
+				}
+			}
+		}
+	} );
+}
+
+void SvgRendererRaster::rasterize( Surface8u *surface ) const
+{
+	rasterizeImpl( surface );
+}
+
+void SvgRendererRaster::rasterize( Surface32f *surface ) const
+{
+	rasterizeImpl( surface );
+}
+
+namespace svg {
+
+Surface8u rasterize( const Doc &doc, const ivec2 &size )
+{
+	ivec2 surfaceSize = ( size.x > 0 && size.y > 0 ) ? size : doc.getSize();
+	Surface8u result( std::max( 1, surfaceSize.x ), std::max( 1, surfaceSize.y ), true );
+	for( int32_t y = 0; y < result.getHeight(); ++y )
+		memset( result.getData( ivec2( 0, y ) ), 0, result.getWidth() * result.getPixelBytes() );
+
+	mat3 transform;
+	if( doc.getWidth() > 0 && doc.getHeight() > 0 ) {
+		transform[0][0] = surfaceSize.x / (float)doc.getWidth();
+		transform[1][1] = surfaceSize.y / (float)doc.getHeight();
+	}
+	rasterize( doc, &result, transform );
+	return result;
+}
+
+void rasterize( const Doc &doc, Surface8u *surface, const mat3 &transform )
+{
+	SvgRendererRaster renderer( transform );
+	doc.render( renderer );
+	renderer.rasterize( surface );
+}
+
+void rasterize( const Doc &doc, Surface32f *surface, const mat3 &transform )
+{
+	SvgRendererRaster renderer( transform );
+	doc.render( renderer );
+	renderer.rasterize( surface );
+}
+
+} // namespace svg
+
+} // namespace cinder
@@ -0,0 +1,150 @@
+// Compares gl::TextureFont's dynamic atlas against its static one, and signed distance field glyphs against coverage. Runs headless (-DCINDER_HEADLESS_GL=egl or osmesa):
+// prints the results, saves a snapshot and quits, returning a non-zero exit code on failure.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/TextureFont.h"
+#include "cinder/ImageIo.h"
+#include "cinder/Log.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+class TextureFontAtlasTestApp : public App {
+  public:
+	void draw() final;
+
+  private:
+	Surface8u	render( const gl::TextureFontRef &textureFont, const string &str, const vec2 &baseline = vec2( 10, 100 ), const gl::TextureFont::DrawOptions &options = gl::TextureFont::DrawOptions() );
+	void		check( const string &name, bool passed );
+
+	bool		mFailed = false;
+};
+
+Surface8u TextureFontAtlasTestApp::render( const gl::TextureFontRef &textureFont, const string &str, const vec2 &baseline, const gl::TextureFont::DrawOptions &options )
+{
+	gl::clear( Color::black() );
+	gl::setMatricesWindow( getWindowSize() );
+	gl::ScopedBlendAlpha blendScp;
+	textureFont->drawString( str, baseline, options );
+	return copyWindowSurface();
+}
+
+void TextureFontAtlasTestApp::check( const string &name, bool passed )
+{
+	console() << ( passed ? "passed: " : "FAILED: " ) << name << endl;
+	mFailed = mFailed || ! passed;
+}
+
+namespace {
+
+bool equal( const Surface8u &a, const Surface8u &b )
+{
+	Surface8u::ConstIter aIt = a.getIter(), bIt = b.getIter();
+	while( aIt.line() && bIt.line() ) {
+		while( aIt.pixel() && bIt.pixel() ) {
+			if( aIt.r() != bIt.r() || aIt.g() != bIt.g() || aIt.b() != bIt.b() )
+				return false;
+		}
+	}
+	return true;
+}
+
+// mean absolute difference of the red channel, normalized to [0,1], over the pixels either image covers
+float difference( const Surface8u &a, const Surface8u &b )
+{
+	double sum = 0;
+	size_t count = 0;
+	Surface8u::ConstIter aIt = a.getIter(), bIt = b.getIter();
+	while( aIt.line() && bIt.line() ) {
+		while( aIt.pixel() && bIt.pixel() ) {
+			if( aIt.r() || bIt.r() ) {
+				sum += abs( aIt.r() - bIt.r() ) / 255.0;
+				++count;
+			}
+		}
+	}
+	return count ? float( sum / count ) : 0;
+}
+
+// fraction of the covered pixels which are only partially covered; blurrier edges score higher
+float blurriness( const Surface8u &surface )
+{
+	size_t partial = 0, covered = 0;
+	Surface8u::ConstIter it = surface.getIter();
+	while( it.line() ) {
+		while( it.pixel() ) {
+			covered += it.r() ? 1 : 0;
+			partial += ( it.r() && it.r() < 255 ) ? 1 : 0;
+		}
+	}
+	return covered ? partial / float( covered ) : 0;
+}
+
+} // anonymous namespace
+
+void TextureFontAtlasTestApp::draw()
+{
+	const Font font( "Arial", 32 );
+	const string latin = "Hello gyp Wq";
+	const string multilingual = "Grüße Ωμέγα Привет";
+
+	// a dynamic atlas places glyphs exactly where the static one does
+	auto staticFont = gl::TextureFont::create( font );
+	auto dynamicFont = gl::TextureFont::create( font, gl::TextureFont::Format().dynamicAtlas() );
+	Surface8u reference = render( staticFont, latin );
+	check( "dynamic atlas matches static atlas", equal( reference, render( dynamicFont, latin ) ) );
+
+	// glyphs outside supportedChars are rasterized on demand
+	auto dynamicAtlas = dynamicFont->getAtlas();
+	size_t numGlyphs = dynamicAtlas->getNumGlyphs();
+	Surface8u multilingualSurface = render( dynamicFont, multilingual );
+	check( "glyphs are added on demand", dynamicAtlas->getNumGlyphs() > numGlyphs );
+
+	// asynchronous rasterization produces the same pixels once finished
+	auto asyncFont = gl::TextureFont::create( font, gl::TextureFont::Format().dynamicAtlas().asyncRasterization(), "" );
+	render( asyncFont, multilingual );
+	asyncFont->getAtlas()->finish();
+	check( "asynchronous rasterization completes", asyncFont->getAtlas()->getNumPendingGlyphs() == 0 );
+	check( "asynchronous matches synchronous", equal( multilingualSurface, render( asyncFont, multilingual ) ) );
+
+	// two sizes sharing small pages, forcing the least recently used page to be recycled
+	auto sharedAtlas = gl::TextureFont::Atlas::create( gl::TextureFont::Format().textureWidth( 128 ).textureHeight( 128 ).maxTextures( 2 ) );
+	auto smallFont = gl::TextureFont::create( Font( "Arial", 24 ), gl::TextureFont::Format().atlas( sharedAtlas ), "" );
+	auto largeFont = gl::TextureFont::create( Font( "Arial", 40 ), gl::TextureFont::Format().atlas( sharedAtlas ), "" );
+	for( const string &str : { "ABCDEFGH", "IJKLMNOP", "QRSTUVWX", "YZ012345" } ) {
+		render( smallFont, "abcdefgh" );
+		render( largeFont, str );
+	}
+	check( "shared atlas stays within its textures", sharedAtlas->getTextures().size() <= 2 );
+	check( "shared atlas recycles pages", sharedAtlas->getNumEvictions() > 0 );
+	auto ownFont = gl::TextureFont::create( Font( "Arial", 40 ), gl::TextureFont::Format().dynamicAtlas(), "" );
+	check( "recycled glyphs are rasterized again", equal( render( ownFont, "ABCDEFGH" ), render( largeFont, "ABCDEFGH" ) ) );
+
+	// a single page with room for one glyph: drawing "OW" after "MW" finds the page pinned by the cached W, after the glyph which needs it
+	auto tinyAtlas = gl::TextureFont::Atlas::create( gl::TextureFont::Format().textureWidth( 48 ).textureHeight( 48 ).maxTextures( 1 ) );
+	auto tinyFont = gl::TextureFont::create( Font( "Arial", 40 ), gl::TextureFont::Format().atlas( tinyAtlas ), "" );
+	render( tinyFont, "MW" );
+	check( "glyphs are drawn when later glyphs pin every page", equal( render( ownFont, "OW" ), render( tinyFont, "OW" ) ) );
+
+	// a signed distance field font approximates coverage at its own size, and keeps its edges sharp when scaled up
+	auto sdfFont = gl::TextureFont::create( font, gl::TextureFont::Format().signedDistanceField() );
+	check( "signed distance field atlas is built", sdfFont->isSignedDistanceField() && ! staticFont->isSignedDistanceField() );
+	float sdfDifference = difference( reference, render( sdfFont, latin ) );
+	const auto scaled = gl::TextureFont::DrawOptions().scale( 4 );
+	float sdfBlurriness = blurriness( render( sdfFont, "Wag", vec2( 10, 150 ), scaled ) );
+	float coverageBlurriness = blurriness( render( staticFont, "Wag", vec2( 10, 150 ), scaled ) );
+	console() << "signed distance field: difference " << sdfDifference << ", blurriness at 4x " << sdfBlurriness << " (coverage " << coverageBlurriness << ")" << endl;
+	check( "signed distance field matches coverage", sdfDifference < 0.1f );
+	check( "signed distance field stays sharp when scaled", sdfBlurriness < coverageBlurriness * 0.5f );
+
+	writeImage( getAppPath() / "texturefont-atlas-snapshot.png", multilingualSurface );
+	console() << ( mFailed ? "TextureFontAtlasTest failed" : "TextureFontAtlasTest passed" ) << endl;
+	if( mFailed )
+		exit( 1 );
+	quit();
+}
+
+CINDER_APP( TextureFontAtlasTestApp, RendererGl, []( App::Settings *settings ) { settings->setWindowSize( 400, 200 ); } )
@@ -4,6 +4,8 @@
 #include "cinder/app/App.h"
 #include "cinder/FileWatcher.h"
 
+#include <fstream>
+
 using namespace std;
 using namespace ci;
 
@@ -35,6 +37,14 @@ void updateFileWatcher( FileWatcher& watcher, double timeoutSeconds, std::functi
 	}
 }
 
+// writes \a text to \a file, with a write time 1 second after \a reference's
+void writeFile( const fs::path &file, const string &text, const fs::path &reference )
+{
+	auto referenceTime = fs::last_write_time( reference );
+	ofstream( file.string() ) << text;
+	fs::last_write_time( file, referenceTime + 1s );
+}
+
 TEST_CASE( "FileWatcher" )
 {
 	SECTION( "shared instance" )
@@ -146,4 +156,73 @@ TEST_CASE( "FileWatcher" )
 		REQUIRE( watcher.getNumWatches() == 0 );
 		REQUIRE( watcher.getNumWatchedFiles() == 0 );
 	}
+
+	SECTION( "backends" )
+	{
+		FileWatcher watcher;
+		watcher.setConnectToAppUpdateEnabled( false );
+		REQUIRE( watcher.getBackend() == FileWatcher::BACKEND_AUTO );
+
+		int numCallbacksFired = 0;
+		watcher.watch( WATCH_FILE, FileWatcher::Options().callOnWatch( false ), [&numCallbacksFired]( const WatchEvent &event ) {
+			numCallbacksFired += 1;
+		} );
+#if defined( CINDER_LINUX )
+		REQUIRE( watcher.getActiveBackend() == FileWatcher::BACKEND_NATIVE );
+#endif
+
+		watcher.setBackend( FileWatcher::BACKEND_POLLING );
+		REQUIRE( watcher.getActiveBackend() == FileWatcher::BACKEND_POLLING );
+
+		updateFileWriteTime( WATCH_FILE );
+		updateFileWatcher( watcher, 5, [&numCallbacksFired]( FileWatcher &watcher ) { return numCallbacksFired == 1; } );
+		REQUIRE( numCallbacksFired == 1 );
+		REQUIRE( watcher.getNumWatches() == 1 );
+	}
+
+	SECTION( "bursts of modifications" )
+	{
+		const fs::path folder = fs::temp_directory_path() / "cinder_file_watcher_test";
+		fs::remove_all( folder );
+		fs::create_directories( folder );
+		const vector<fs::path> files = { folder / "a.txt", folder / "b.txt", folder / "c.txt" };
+		for( const auto &file : files )
+			ofstream( file.string() ) << "initial";
+
+		FileWatcher watcher;
+		watcher.setConnectToAppUpdateEnabled( false );
+		// long enough that the writes below land in one burst, even on a loaded machine
+		watcher.setDebounceInterval( 0.2 );
+
+		vector<WatchEvent> events;
+		watcher.watch( files, FileWatcher::Options().callOnWatch( false ), [&events]( const WatchEvent &event ) {
+			events.push_back( event );
+		} );
+
+		for( const auto &file : files )
+			writeFile( file, "modified", file );
+		updateFileWatcher( watcher, 5, [&events]( FileWatcher &watcher ) { return ! events.empty() && events.front().getNumFiles() == 3; } );
+		REQUIRE( ! events.empty() );
+		if( watcher.getActiveBackend() == FileWatcher::BACKEND_NATIVE ) {
+			REQUIRE( events.size() == 1 );
+			REQUIRE( events.front().getNumFiles() == 3 );
+		}
+
+		// editors often save by renaming a new file over the old one
+		events.clear();
+		const fs::path temporary = folder / "b.txt.tmp";
+		writeFile( temporary, "saved", files[1] );
+		fs::rename( temporary, files[1] );
+		updateFileWatcher( watcher, 5, [&events]( FileWatcher &watcher ) { return ! events.empty(); } );
+		REQUIRE( events.size() == 1 );
+		REQUIRE( events.front().getFiles() == vector<fs::path>( { files[1] } ) );
+
+		// other files in the directory are ignored
+		events.clear();
+		ofstream( ( folder / "other.txt" ).string() ) << "other";
+		updateFileWatcher( watcher, 0.5, []( FileWatcher &watcher ) { return false; } );
+		REQUIRE( events.empty() );
+
+		fs::remove_all( folder );
+	}
 }
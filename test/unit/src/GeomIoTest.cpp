@@ -0,0 +1,178 @@
+#include "cinder/GeomIo.h"
+#include "cinder/TriMesh.h"
+
+#include "catch.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// A user subclass which adds a parameter of its own, and counts how often it is generated
+class OffsetSphere : public geom::Sphere {
+  public:
+	OffsetSphere( float offset, shared_ptr<int> numLoads )
+		: mOffset( offset ), mNumLoads( numLoads )
+	{}
+
+	void loadInto( geom::Target *target, const geom::AttribSet &requestedAttribs ) const override
+	{
+		++*mNumLoads;
+		TriMesh mesh( geom::Sphere( *this ), TriMesh::Format().positions() );
+		vector<vec3> positions( mesh.getPositions<3>(), mesh.getPositions<3>() + mesh.getNumVertices() );
+		for( auto &position : positions )
+			position.x += mOffset;
+		target->copyAttrib( geom::POSITION, 3, 0, value_ptr( positions[0] ), positions.size() );
+		target->copyIndices( geom::TRIANGLES, mesh.getIndices().data(), mesh.getNumIndices(), 4 );
+	}
+	OffsetSphere*	clone() const override { return new OffsetSphere( *this ); }
+
+	float				mOffset;
+	shared_ptr<int>		mNumLoads;
+};
+
+// Doubles every position, writing in place over the previous storage
+class DoublePositions : public geom::Modifier {
+  public:
+	Modifier*	clone() const override { return new DoublePositions; }
+
+	void process( geom::SourceModsContext *ctx, const geom::AttribSet &requestedAttribs ) const override
+	{
+		ctx->processUpstream( requestedAttribs );
+		const size_t numVertices = ctx->getNumVertices();
+		unique_ptr<float[]> previous;
+		float *data = ctx->reallocAttrib( geom::POSITION, 3, numVertices, &previous );
+		for( size_t i = 0; i < numVertices * 3; ++i )
+			data[i] = previous[i] * 2;
+	}
+};
+
+// Widens positions to 4 dimensions, with w = 1
+class HomogeneousPositions : public geom::Modifier {
+  public:
+	Modifier*	clone() const override { return new HomogeneousPositions; }
+	uint8_t		getAttribDims( geom::Attrib attr, uint8_t upstreamDims ) const override { return attr == geom::POSITION ? 4 : upstreamDims; }
+
+	void process( geom::SourceModsContext *ctx, const geom::AttribSet &requestedAttribs ) const override
+	{
+		ctx->processUpstream( requestedAttribs );
+		const size_t numVertices = ctx->getNumVertices();
+		unique_ptr<float[]> previous;
+		float *data = ctx->reallocAttrib( geom::POSITION, 4, numVertices, &previous );
+		for( size_t i = 0; i < numVertices; ++i )
+			*reinterpret_cast<vec4*>( data + i * 4 ) = vec4( *reinterpret_cast<const vec3*>( previous.get() + i * 3 ), 1 );
+	}
+};
+
+} // anonymous namespace
+
+TEST_CASE("SourceCache")
+{
+	auto cache = geom::SourceCache::get();
+	cache->clear();
+	const size_t maxBytes = cache->getMaxBytes();
+
+	auto makeMesh = []( const geom::Source &source, const TriMesh::Format &format = TriMesh::Format().positions().normals() ) {
+		return TriMesh( source >> geom::Translate( 1, 2, 3 ), format );
+	};
+
+	SECTION("identical parameters replay the cached result")
+	{
+		TriMesh first = makeMesh( geom::Sphere().subdivisions( 24 ) );
+		REQUIRE( cache->getNumEntries() == 1 );
+		REQUIRE( cache->getNumBytes() > 0 );
+		TriMesh second = makeMesh( geom::Sphere().subdivisions( 24 ) );
+		REQUIRE( cache->getNumEntries() == 1 );
+		REQUIRE( second.getPositions<3>()[7] == first.getPositions<3>()[7] );
+		REQUIRE( second.getIndices() == first.getIndices() );
+	}
+
+	SECTION("different parameters or attributes miss")
+	{
+		TriMesh first = makeMesh( geom::Sphere().subdivisions( 24 ) );
+		TriMesh larger = makeMesh( geom::Sphere().subdivisions( 24 ).radius( 2 ) );
+		REQUIRE( cache->getNumEntries() == 2 );
+		REQUIRE( larger.getPositions<3>()[7] != first.getPositions<3>()[7] );
+		makeMesh( geom::Sphere().subdivisions( 24 ), TriMesh::Format().positions() );
+		REQUIRE( cache->getNumEntries() == 3 );
+		makeMesh( geom::Torus() );
+		makeMesh( geom::Helix() );
+		REQUIRE( cache->getNumEntries() == 5 );
+	}
+
+	SECTION("subclasses are not cached")
+	{
+		auto numLoads = make_shared<int>( 0 );
+		TriMesh first = makeMesh( OffsetSphere( 5, numLoads ), TriMesh::Format().positions() );
+		TriMesh second = makeMesh( OffsetSphere( 10, numLoads ), TriMesh::Format().positions() );
+		REQUIRE( *numLoads == 2 );
+		REQUIRE( cache->getNumEntries() == 0 );
+		REQUIRE( second.getPositions<3>()[0].x == Approx( first.getPositions<3>()[0].x + 5 ) );
+	}
+
+	SECTION("least recently used entries are evicted")
+	{
+		makeMesh( geom::Sphere().subdivisions( 24 ) );
+		const size_t entryBytes = cache->getNumBytes();
+		cache->setMaxBytes( entryBytes * 2 + entryBytes / 2 );
+		makeMesh( geom::Sphere().subdivisions( 24 ).radius( 2 ) );
+		makeMesh( geom::Sphere().subdivisions( 24 ) ); // refreshes the first entry
+		makeMesh( geom::Sphere().subdivisions( 24 ).radius( 3 ) );
+		REQUIRE( cache->getNumEntries() == 2 );
+		REQUIRE( cache->getNumBytes() <= cache->getMaxBytes() );
+		makeMesh( geom::Sphere().subdivisions( 24 ) );
+		REQUIRE( cache->getNumEntries() == 2 );
+		makeMesh( geom::Sphere().subdivisions( 24 ).radius( 2 ) );
+		REQUIRE( cache->getNumEntries() == 2 );
+		REQUIRE( cache->getNumBytes() <= cache->getMaxBytes() );
+	}
+
+	SECTION("disabling the cache clears it")
+	{
+		makeMesh( geom::Sphere().subdivisions( 24 ) );
+		cache->setEnabled( false );
+		REQUIRE( cache->getNumEntries() == 0 );
+		makeMesh( geom::Sphere().subdivisions( 24 ) );
+		REQUIRE( cache->getNumEntries() == 0 );
+		REQUIRE( cache->getNumBytes() == 0 );
+		cache->setEnabled( true );
+	}
+
+	cache->setMaxBytes( maxBytes );
+	cache->clear();
+}
+
+TEST_CASE("SourceModsContext")
+{
+	SECTION("reallocAttrib() hands back the previous storage")
+	{
+		TriMesh reference( geom::Cube(), TriMesh::Format().positions() );
+		TriMesh doubled( geom::Cube() >> DoublePositions() >> DoublePositions(), TriMesh::Format().positions() );
+		REQUIRE( doubled.getNumVertices() == reference.getNumVertices() );
+		for( size_t i = 0; i < reference.getNumVertices(); ++i )
+			REQUIRE( doubled.getPositions<3>()[i] == reference.getPositions<3>()[i] * 4.0f );
+	}
+
+	SECTION("reallocAttrib() can change dimensions")
+	{
+		TriMesh reference( geom::Cube(), TriMesh::Format().positions() );
+		TriMesh homogeneous( geom::Cube() >> DoublePositions() >> HomogeneousPositions(), TriMesh::Format().positions( 4 ) );
+		REQUIRE( homogeneous.getNumVertices() == reference.getNumVertices() );
+		for( size_t i = 0; i < reference.getNumVertices(); ++i )
+			REQUIRE( homogeneous.getPositions<4>()[i] == vec4( reference.getPositions<3>()[i] * 2.0f, 1 ) );
+	}
+
+	SECTION("parallel modifiers match their serial results")
+	{
+		// enough vertices to be split across threads
+		auto sphere = geom::Sphere().subdivisions( 200 );
+		TriMesh reference( sphere, TriMesh::Format().positions() );
+		TriMesh translated( sphere >> geom::Translate( 1, 2, 3 ) >> geom::Translate( -1, -2, -3 ), TriMesh::Format().positions() );
+		REQUIRE( reference.getNumVertices() > 16384 );
+		for( size_t i = 0; i < reference.getNumVertices(); ++i )
+			REQUIRE( glm::all( glm::epsilonEqual( translated.getPositions<3>()[i], reference.getPositions<3>()[i], 1e-5f ) ) );
+	}
+}
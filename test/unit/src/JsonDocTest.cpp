@@ -0,0 +1,229 @@
+#include "cinder/JsonDoc.h"
+#include "cinder/Json.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+#include "RandomJson.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+void requireEqual( const Json &expected, const JsonDoc::Value &value )
+{
+	switch( expected.type() ) {
+		case Json::value_t::null: REQUIRE( value.isNull() ); break;
+		case Json::value_t::boolean: REQUIRE( value.getBool() == expected.get<bool>() ); break;
+		case Json::value_t::number_integer: REQUIRE( value.getInt() == expected.get<int64_t>() ); break;
+		case Json::value_t::number_unsigned: REQUIRE( value.getUint() == expected.get<uint64_t>() ); break;
+		case Json::value_t::number_float: REQUIRE( value.getDouble() == expected.get<double>() ); break;
+		case Json::value_t::string: REQUIRE( value.getString() == expected.get<string>() ); break;
+		case Json::value_t::array: {
+			REQUIRE( value.isArray() );
+			REQUIRE( value.getNumChildren() == expected.size() );
+			size_t i = 0;
+			for( auto child : value )
+				requireEqual( expected[i++], child );
+			break;
+		}
+		case Json::value_t::object: {
+			REQUIRE( value.isObject() );
+			REQUIRE( value.getNumChildren() == expected.size() );
+			for( auto it = expected.begin(); it != expected.end(); ++it ) {
+				JsonDoc::Value child = value.findChild( it.key() );
+				REQUIRE( child.isValid() );
+				requireEqual( it.value(), child );
+			}
+			for( auto child : value )
+				REQUIRE( expected.count( JsonDoc( "\"" + child.getKey().str() + "\"" ).getRoot().getString() ) == 1 );
+			break;
+		}
+		default:
+			FAIL( "unexpected type" );
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE("JsonDoc")
+{
+	SECTION("values and types")
+	{
+		JsonDoc doc( R"( { "null": null, "t": true, "f": false, "int": -42, "big": 18446744073709551615, "float": 2.5e-3,
+			"str": "text", "arr": [ 1, [], {}, "x" ], "obj": { "a": { "b": [ 10, 20, 30 ] } } } )" );
+		auto root = doc.getRoot();
+		REQUIRE( root.isObject() );
+		REQUIRE( root.getNumChildren() == 9 );
+		REQUIRE( doc.getNumValues() == 19 );
+		REQUIRE( root["null"].isNull() );
+		REQUIRE( root["t"].getBool() );
+		REQUIRE_FALSE( root["f"].getValue<bool>() );
+		REQUIRE( root["int"].getInt() == -42 );
+		REQUIRE( root["int"].getValue<int8_t>() == -42 );
+		REQUIRE( root["int"].getDouble() == -42.0 );
+		REQUIRE( root["big"].getUint() == 18446744073709551615ULL );
+		REQUIRE( root["float"].getValue<float>() == 2.5e-3f );
+		REQUIRE( root["float"].getRaw() == "2.5e-3" );
+		REQUIRE( root["str"].getString() == "text" );
+		REQUIRE( root["str"].getKey() == "str" );
+		REQUIRE( root["arr"].getNumChildren() == 4 );
+		REQUIRE( root["arr"][1].isArray() );
+		REQUIRE( root["arr"][1].getNumChildren() == 0 );
+		REQUIRE( root["arr"][1].begin() == root["arr"][1].end() );
+		REQUIRE( root["arr"][2].isObject() );
+		REQUIRE( root["arr"][3].getValue<string>() == "x" );
+		REQUIRE( root["arr"].end() - root["arr"].begin() == 4 );
+		REQUIRE( root.getValueForKey<int>( "obj.a.b.2" ) == 30 );
+		REQUIRE( root.getChild( "obj/a/b/0", '/' ).getInt() == 10 );
+		REQUIRE( root.hasChild( "obj.a.b" ) );
+		REQUIRE_FALSE( root.hasChild( "obj.a.c" ) );
+		REQUIRE_FALSE( root.hasChild( "obj.a.b.3" ) );
+		REQUIRE_FALSE( root.findChild( "missing" ).isValid() );
+
+		vector<string> keys;
+		for( auto child : root )
+			keys.push_back( child.getKey().str() );
+		REQUIRE( keys == vector<string>( { "null", "t", "f", "int", "big", "float", "str", "arr", "obj" } ) );
+	}
+
+	SECTION("conversion errors")
+	{
+		JsonDoc doc( R"( [ "a", 1.5, 300, -1, 9223372036854775808, {} ] )" );
+		auto root = doc.getRoot();
+		REQUIRE_THROWS_AS( root[0].getInt(), JsonDoc::ExcNonConvertible );
+		REQUIRE_THROWS_AS( root[1].getInt(), JsonDoc::ExcNonConvertible );
+		REQUIRE_THROWS_AS( root[2].getValue<uint8_t>(), JsonDoc::ExcNonConvertible );
+		REQUIRE_THROWS_AS( root[3].getUint(), JsonDoc::ExcNonConvertible );
+		REQUIRE_THROWS_AS( root[4].getInt(), JsonDoc::ExcNonConvertible );
+		REQUIRE( root[4].getUint() == 9223372036854775808ULL );
+		REQUIRE_THROWS_AS( root[5].getString(), JsonDoc::ExcNonConvertible );
+		REQUIRE_THROWS_AS( root[6], JsonDoc::ExcChildNotFound );
+		REQUIRE_THROWS_AS( root["key"], JsonDoc::ExcChildNotFound );
+		REQUIRE_THROWS_AS( root.getChild( "5.x" ), JsonDoc::ExcChildNotFound );
+		REQUIRE( root[2].getString() == "300" );
+	}
+
+	SECTION("escapes")
+	{
+		JsonDoc doc( R"( { "a\"b": "line\nbreak \\ \/ é 😀 \"q\"", "plain": "x" } )" );
+		auto root = doc.getRoot();
+		auto value = root["a\"b"];
+		REQUIRE( value.getKey() == R"(a\"b)" );
+		REQUIRE( value.hasEscapes() );
+		REQUIRE( value.getString() == "line\nbreak \\ / \xC3\xA9 \xF0\x9F\x98\x80 \"q\"" );
+		REQUIRE_FALSE( root["plain"].hasEscapes() );
+
+		REQUIRE_THROWS_AS( JsonDoc( R"( "\x" )" ).getRoot().getString(), JsonDoc::ExcParseError );
+		REQUIRE_THROWS_AS( JsonDoc( R"( "\ud83d" )" ).getRoot().getString(), JsonDoc::ExcParseError );
+	}
+
+	SECTION("strings and escapes spanning blocks")
+	{
+		// vary the alignment of quotes and backslash runs relative to the 64 byte blocks the scanner classifies
+		for( size_t padding = 0; padding < 130; ++padding ) {
+			const string value = string( padding % 70, 'x' ) + "\\\\\\\"\\\\";
+			const string json = string( padding, ' ' ) + "[\"" + value + "\", \"" + value + "{]\", " + to_string( padding ) + "]";
+			JsonDoc doc( json );
+			auto root = doc.getRoot();
+			REQUIRE( root.getNumChildren() == 3 );
+			REQUIRE( root[0].getString() == string( padding % 70, 'x' ) + "\\\"\\" );
+			REQUIRE( root[1].getString() == string( padding % 70, 'x' ) + "\\\"\\{]" );
+			REQUIRE( root[2].getUint() == padding );
+		}
+	}
+
+	SECTION("large objects are hashed")
+	{
+		Json expected = Json::object();
+		for( int i = 0; i < 1000; ++i )
+			expected["member" + to_string( i )] = i;
+		expected["esc\"aped"] = -1;
+		JsonDoc doc( expected.dump() );
+		auto root = doc.getRoot();
+		for( int i = 0; i < 1000; ++i )
+			REQUIRE( root["member" + to_string( i )].getInt() == i );
+		REQUIRE( root["esc\"aped"].getInt() == -1 );
+		REQUIRE_FALSE( root.findChild( "member1000" ).isValid() );
+	}
+
+	SECTION("parse errors")
+	{
+		const char *invalid[] = { "", "   ", "[", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{1:2}", "{\"a\":1,}", "[tru]", "[truex]", "[-]", "[01]",
+			"[1.]", "[1e]", "[.5]", "\"abc", "[\"abc]", "[1]]", "{} {}", "[nul]", "[1,,2]", "{\"a\":1 \"b\":2}", "]" };
+		for( const char *json : invalid ) {
+			INFO( json );
+			REQUIRE_THROWS_AS( JsonDoc( json ), JsonDoc::ExcParseError );
+		}
+
+		try {
+			JsonDoc( "{\n  \"a\": [ 1,\n  2, ] }" );
+			FAIL( "expected an exception" );
+		}
+		catch( const JsonDoc::ExcParseError &exc ) {
+			REQUIRE( exc.getOffset() == 19 );
+			REQUIRE( string( exc.what() ).find( "line 3, column 6" ) != string::npos );
+		}
+
+		// scalars are valid documents
+		REQUIRE( JsonDoc( "42" ).getRoot().getInt() == 42 );
+		REQUIRE( JsonDoc( " \"s\" " ).getRoot().getString() == "s" );
+		REQUIRE( JsonDoc( "\xEF\xBB\xBF[true]" ).getRoot()[0].getBool() );
+	}
+
+	SECTION("random documents match nlohmann::json")
+	{
+		Rand rand( 7 );
+		for( int i = 0; i < 50; ++i ) {
+			Json expected = makeRandomJson( rand );
+			const string dumped = expected.dump( rand.nextBool() ? 2 : -1 );
+			INFO( dumped );
+			JsonDoc doc( dumped );
+			requireEqual( expected, doc.getRoot() );
+		}
+	}
+}
+
+TEST_CASE("JsonDoc benchmark", "[.][benchmark]")
+{
+	Rand rand( 1 );
+	Json records = Json::array();
+	for( int i = 0; i < 200000; ++i ) {
+		records.push_back( { { "id", i }, { "name", "record " + to_string( i ) }, { "position", { rand.nextFloat(), rand.nextFloat(), rand.nextFloat() } },
+			{ "enabled", rand.nextBool() }, { "tags", { "alpha", "beta\"quoted\"", "gamma" } } } );
+	}
+	const string source = records.dump( 1 );
+
+	auto time = [&]( const char *name, const function<double()> &fn ) {
+		auto start = chrono::steady_clock::now();
+		double sum = fn();
+		const double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+		cout << name << ": " << seconds * 1000 << " ms, " << source.size() / seconds / ( 1024 * 1024 ) << " MB/s (checksum " << sum << ")" << endl;
+	};
+
+	time( "nlohmann::json parse", [&] {
+		Json json = Json::parse( source );
+		return (double)json.size();
+	} );
+	time( "nlohmann::json parse and read", [&] {
+		Json json = Json::parse( source );
+		double sum = 0;
+		for( const auto &record : json )
+			sum += record["position"][0].get<double>() + record["id"].get<int>();
+		return sum;
+	} );
+	time( "JsonDoc parse", [&] {
+		JsonDoc doc( source );
+		return (double)doc.getRoot().getNumChildren();
+	} );
+	time( "JsonDoc parse and read", [&] {
+		JsonDoc doc( source );
+		double sum = 0;
+		for( auto record : doc.getRoot() )
+			sum += record["position"][0].getDouble() + record["id"].getInt();
+		return sum;
+	} );
+}
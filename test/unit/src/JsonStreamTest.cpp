@@ -0,0 +1,314 @@
+#include "cinder/JsonStream.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+#include "RandomJson.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+string writeToString( const function<void( JsonWriter& )> &fn, int indent = -1, bool multipleValues = false, size_t bufferSize = 65536 )
+{
+	auto stream = OStreamMem::create();
+	{
+		JsonWriter writer( stream, indent, multipleValues, bufferSize );
+		fn( writer );
+	}
+	return string( (const char*)stream->getBuffer(), (size_t)stream->tell() );
+}
+
+vector<JsonReader::Event> readEvents( const string &json, bool multipleValues = false )
+{
+	JsonReader reader( IStreamMem::create( json.data(), json.size() ), multipleValues, 64 );
+	vector<JsonReader::Event> result;
+	while( reader.next() != JsonReader::END_DOCUMENT )
+		result.push_back( reader.getEvent() );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("JsonWriter")
+{
+	SECTION("values")
+	{
+		string json = writeToString( []( JsonWriter &writer ) {
+			writer.beginObject().key( "null" ).value( nullptr ).key( "bool" ).value( true ).key( "int" ).value( -42 ).key( "min" ).value( numeric_limits<int64_t>::min() )
+				.key( "max" ).value( numeric_limits<uint64_t>::max() ).key( "double" ).value( 0.1 ).key( "whole" ).value( 2.0f ).key( "nan" ).value( NAN )
+				.key( "string" ).value( "a\"b\\c\n\x01\xC3\xA9" ).key( "array" ).beginArray().value( 1 ).beginArray().endArray().beginObject().endObject().endArray()
+				.key( "raw" ).rawValue( "[1,2]" ).endObject();
+		} );
+		REQUIRE( json == "{\"null\":null,\"bool\":true,\"int\":-42,\"min\":-9223372036854775808,\"max\":18446744073709551615,\"double\":0.1,\"whole\":2.0,"
+			"\"nan\":null,\"string\":\"a\\\"b\\\\c\\n\\u0001\xC3\xA9\",\"array\":[1,[],{}],\"raw\":[1,2]}" );
+	}
+
+	SECTION("indentation matches nlohmann::json")
+	{
+		Json expected = { { "a", { 1, 2, Json::object(), Json::array() } }, { "b", { { "c", "d" } } } };
+		REQUIRE( writeToString( [&]( JsonWriter &writer ) { writer.value( expected ); }, 4 ) == expected.dump( 4 ) );
+		REQUIRE( writeToString( [&]( JsonWriter &writer ) { writer.value( expected ); } ) == expected.dump() );
+	}
+
+	SECTION("random documents round-trip through nlohmann::json")
+	{
+		Rand rand( 3 );
+		for( int i = 0; i < 50; ++i ) {
+			Json expected = makeRandomJson( rand );
+			// a tiny buffer flushes often and writes long strings directly
+			string json = writeToString( [&]( JsonWriter &writer ) { writer.value( expected ); }, rand.nextBool() ? 2 : -1, false, 16 );
+			REQUIRE( Json::parse( json ) == expected );
+		}
+	}
+
+	SECTION("escapes and long strings at every buffer boundary")
+	{
+		const string text = "\"\\\n\x01\xC3\xA9\xF0\x9F\x98\x80" + string( 40, 'x' ) + "\t";
+		const Json expected = { { "key\"", text }, { "n", -1234567890123 }, { "d", 1.5e-300 } };
+		for( size_t bufferSize = 1; bufferSize <= 32; ++bufferSize ) {
+			INFO( bufferSize );
+			string json = writeToString( [&]( JsonWriter &writer ) {
+				// in nlohmann::json's sorted key order
+				writer.beginObject().key( "d" ).value( 1.5e-300 ).key( "key\"" ).value( text ).key( "n" ).value( -1234567890123 ).endObject();
+			}, -1, false, bufferSize );
+			REQUIRE( json == expected.dump() );
+		}
+	}
+
+	SECTION("invalid sequences throw")
+	{
+		auto stream = OStreamMem::create();
+		JsonWriter writer( stream );
+		REQUIRE_THROWS_AS( writer.key( "a" ), JsonWriterExc );
+		REQUIRE_THROWS_AS( writer.endArray(), JsonWriterExc );
+		writer.beginObject();
+		REQUIRE_THROWS_AS( writer.value( 1 ), JsonWriterExc );
+		REQUIRE_THROWS_AS( writer.endArray(), JsonWriterExc );
+		writer.key( "a" );
+		REQUIRE_THROWS_AS( writer.key( "b" ), JsonWriterExc );
+		REQUIRE_THROWS_AS( writer.endObject(), JsonWriterExc );
+		writer.value( 1 ).endObject();
+		REQUIRE( writer.getDepth() == 0 );
+		REQUIRE_THROWS_AS( writer.value( 2 ), JsonWriterExc );
+	}
+
+	SECTION("multiple values are written one per line")
+	{
+		string json = writeToString( []( JsonWriter &writer ) {
+			for( int i = 0; i < 3; ++i )
+				writer.beginObject().key( "i" ).value( i ).endObject();
+		}, -1, true );
+		REQUIRE( json == "{\"i\":0}\n{\"i\":1}\n{\"i\":2}\n" );
+	}
+}
+
+TEST_CASE("JsonReader")
+{
+	typedef JsonReader R;
+
+	SECTION("events")
+	{
+		REQUIRE( readEvents( R"( { "a": [ 1, "s", true, null, {} ], "b": -2.5e3 } )" ) == vector<R::Event>( { R::BEGIN_OBJECT, R::KEY, R::BEGIN_ARRAY, R::NUMBER,
+			R::STRING, R::BOOL, R::NULL_VALUE, R::BEGIN_OBJECT, R::END_OBJECT, R::END_ARRAY, R::KEY, R::NUMBER, R::END_OBJECT } ) );
+		REQUIRE( readEvents( "42" ) == vector<R::Event>( { R::NUMBER } ) );
+		REQUIRE( readEvents( "\xEF\xBB\xBF[]" ) == vector<R::Event>( { R::BEGIN_ARRAY, R::END_ARRAY } ) );
+		REQUIRE( readEvents( "1 \"a\"\n[]\n", true ) == vector<R::Event>( { R::NUMBER, R::STRING, R::BEGIN_ARRAY, R::END_ARRAY } ) );
+		REQUIRE( readEvents( "", true ).empty() );
+	}
+
+	SECTION("values")
+	{
+		const string json = R"( { "key\"": "line\nbreak", "int": -7, "big": 18446744073709551615, "float": 0.25, "t": true } )";
+		JsonReader reader( IStreamMem::create( json.data(), json.size() ) );
+		REQUIRE( reader.next() == R::BEGIN_OBJECT );
+		REQUIRE( reader.getDepth() == 1 );
+		REQUIRE( reader.next() == R::KEY );
+		REQUIRE( reader.getString() == "key\"" );
+		REQUIRE( reader.getOffset() == 3 );
+		REQUIRE( reader.next() == R::STRING );
+		REQUIRE( reader.getString() == "line\nbreak" );
+		REQUIRE_THROWS_AS( reader.getInt(), JsonDoc::ExcNonConvertible );
+		reader.next();
+		REQUIRE( reader.next() == R::NUMBER );
+		REQUIRE( reader.getInt() == -7 );
+		REQUIRE_THROWS_AS( reader.getUint(), JsonDoc::ExcNonConvertible );
+		reader.next();
+		reader.next();
+		REQUIRE( reader.getUint() == 18446744073709551615ULL );
+		reader.next();
+		reader.next();
+		REQUIRE( reader.getDouble() == 0.25 );
+		reader.next();
+		reader.next();
+		REQUIRE( reader.getBool() );
+		REQUIRE( reader.next() == R::END_OBJECT );
+		REQUIRE( reader.next() == R::END_DOCUMENT );
+		REQUIRE( reader.next() == R::END_DOCUMENT );
+	}
+
+	SECTION("skipping and reading values")
+	{
+		const string json = R"( { "skip": { "a": [ 1, { "b": 2 } ] }, "read": { "c": [ 3, "d" ] }, "last": 4 } )";
+		JsonReader reader( IStreamMem::create( json.data(), json.size() ) );
+		reader.next();
+		reader.next();
+		reader.skipValue();
+		REQUIRE( reader.getEvent() == R::END_OBJECT );
+		REQUIRE( reader.next() == R::KEY );
+		REQUIRE( reader.readValue() == Json( { { "c", { 3, "d" } } } ) );
+		REQUIRE( reader.next() == R::KEY );
+		REQUIRE( reader.getString() == "last" );
+	}
+
+	SECTION("random documents match nlohmann::json")
+	{
+		Rand rand( 5 );
+		for( int i = 0; i < 50; ++i ) {
+			Json expected = makeRandomJson( rand );
+			const string json = expected.dump( rand.nextBool() ? 2 : -1 );
+			INFO( json );
+			// the smallest buffer, so that tokens cross buffer boundaries and long ones grow it
+			JsonReader reader( IStreamMem::create( json.data(), json.size() ), false, 1 );
+			reader.next();
+			REQUIRE( reader.readValue() == expected );
+			REQUIRE( reader.next() == R::END_DOCUMENT );
+		}
+	}
+
+	SECTION("tokens and escapes split across buffer fills")
+	{
+		const string json = "[\"\\u00e9\\ud83d\\ude00\\\"\\\\\\n\",true,false,null,-1234567890123,1.5e-300,18446744073709551615,{\"k\\u0022\":[]}]";
+		const Json expected = Json::parse( json );
+		// every buffer size moves each token boundary to a different offset within a fill
+		for( size_t bufferSize = 1; bufferSize <= json.size(); ++bufferSize ) {
+			INFO( bufferSize );
+			JsonReader reader( IStreamMem::create( json.data(), json.size() ), false, bufferSize );
+			reader.next();
+			REQUIRE( reader.readValue() == expected );
+			REQUIRE( reader.next() == R::END_DOCUMENT );
+		}
+	}
+
+	SECTION("parse errors")
+	{
+		const char *invalid[] = { "", "[", "[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{1:2}", "{\"a\":1,}", "[tru]", "[truex]", "[-]", "[01]", "[1.]",
+			"\"abc", "[1]]", "{} {}", "[1,,2]", "]", "[\"\\x\"]" };
+		for( const char *json : invalid ) {
+			INFO( json );
+			REQUIRE_THROWS_AS( readEvents( json ), JsonDoc::ExcParseError );
+		}
+
+		try {
+			readEvents( "[1, 2, }" );
+			FAIL( "expected an exception" );
+		}
+		catch( const JsonDoc::ExcParseError &exc ) {
+			REQUIRE( exc.getOffset() == 7 );
+		}
+	}
+}
+
+TEST_CASE("NdjsonReader")
+{
+	SECTION("records round-trip through JsonWriter")
+	{
+		const int numRecords = 2000;
+		auto stream = OStreamMem::create();
+		{
+			JsonWriter writer( DataTargetStream::createRef( stream ), -1, true );
+			for( int i = 0; i < numRecords; ++i )
+				writer.beginObject().key( "id" ).value( i ).key( "name" ).value( "record\n" + to_string( i ) ).endObject();
+		}
+		// blank lines and CRLF line endings are accepted
+		const string ndjson = "\r\n" + string( (const char*)stream->getBuffer(), (size_t)stream->tell() ) + "\n  \n";
+
+		NdjsonReader reader( DataSourceBuffer::create( make_shared<Buffer>( (void*)ndjson.data(), ndjson.size() ) ), 16 );
+		for( int i = 0; i < numRecords; ++i ) {
+			JsonDocRef record = reader.readNext();
+			REQUIRE( record );
+			REQUIRE( record->getRoot()["id"].getInt() == i );
+			REQUIRE( record->getRoot()["name"].getString() == "record\n" + to_string( i ) );
+		}
+		REQUIRE_FALSE( reader.readNext() );
+		REQUIRE_FALSE( reader.readNext() );
+	}
+
+	SECTION("errors report their line")
+	{
+		const string ndjson = "{\"a\":1}\n{\"a\":2}\n{\"a\":}\n{\"a\":4}\n";
+		NdjsonReader reader( IStreamMem::create( ndjson.data(), ndjson.size() ) );
+		REQUIRE( reader.readNext()->getRoot()["a"].getInt() == 1 );
+		REQUIRE( reader.readNext()->getRoot()["a"].getInt() == 2 );
+		try {
+			reader.readNext();
+			FAIL( "expected an exception" );
+		}
+		catch( const JsonDoc::ExcParseError &exc ) {
+			REQUIRE( string( exc.what() ).find( "line 3" ) != string::npos );
+			REQUIRE( exc.getOffset() == 21 );
+		}
+		REQUIRE_FALSE( reader.readNext() );
+	}
+
+	SECTION("destruction before reading every record")
+	{
+		string ndjson;
+		for( int i = 0; i < 1000; ++i )
+			ndjson += "[" + to_string( i ) + "]\n";
+		NdjsonReader reader( IStreamMem::create( ndjson.data(), ndjson.size() ), 4 );
+		REQUIRE( reader.readNext()->getRoot()[0].getInt() == 0 );
+	}
+}
+
+TEST_CASE("JsonStream benchmark", "[.][benchmark]")
+{
+	const fs::path path = fs::temp_directory_path() / "cinder_json_stream_benchmark.ndjson";
+	const int numRecords = 1000000;
+
+	auto time = [&]( const char *name, const function<double()> &fn ) {
+		auto start = chrono::steady_clock::now();
+		double sum = fn();
+		const double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+		cout << name << ": " << seconds * 1000 << " ms, " << fs::file_size( path ) / seconds / ( 1024 * 1024 ) << " MB/s (checksum " << sum << ")" << endl;
+	};
+
+	time( "JsonWriter NDJSON", [&] {
+		JsonWriter writer( writeFile( path ), -1, true );
+		for( int i = 0; i < numRecords; ++i ) {
+			writer.beginObject().key( "id" ).value( i ).key( "name" ).value( "record " + to_string( i ) ).key( "position" ).beginArray()
+				.value( i * 0.25 ).value( i * 0.5 ).endArray().key( "enabled" ).value( i % 2 == 0 ).endObject();
+		}
+		return (double)numRecords;
+	} );
+	time( "nlohmann::json dump per record", [&] {
+		auto stream = writeFile( path )->getStream();
+		for( int i = 0; i < numRecords; ++i ) {
+			Json record = { { "id", i }, { "name", "record " + to_string( i ) }, { "position", { i * 0.25, i * 0.5 } }, { "enabled", i % 2 == 0 } };
+			const string line = record.dump() + "\n";
+			stream->writeData( line.data(), line.size() );
+		}
+		return (double)numRecords;
+	} );
+	time( "JsonReader events", [&] {
+		JsonReader reader( loadFile( path ), true );
+		double sum = 0;
+		while( reader.next() != JsonReader::END_DOCUMENT ) {
+			if( reader.getEvent() == JsonReader::NUMBER )
+				sum += reader.getDouble();
+		}
+		return sum;
+	} );
+	time( "NdjsonReader records", [&] {
+		NdjsonReader reader( loadFile( path ) );
+		double sum = 0;
+		while( JsonDocRef record = reader.readNext() )
+			sum += record->getRoot()["id"].getDouble() + record->getRoot()["position"][0].getDouble() + record->getRoot()["position"][1].getDouble();
+		return sum;
+	} );
+
+	fs::remove( path );
+}
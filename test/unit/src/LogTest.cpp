@@ -0,0 +1,312 @@
+#include "cinder/Log.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Records everything written to it
+class LoggerCapture : public log::Logger {
+  public:
+	struct Record {
+		log::Level	mLevel;
+		string		mText;
+	};
+
+	void write( const log::Metadata &meta, const string &text ) override
+	{
+		lock_guard<mutex> lock( mMutex );
+		mRecords.push_back( { meta.mLevel, text } );
+	}
+
+	vector<Record> getRecords()
+	{
+		lock_guard<mutex> lock( mMutex );
+		return mRecords;
+	}
+
+	vector<string> getTexts( log::Level level )
+	{
+		vector<string> result;
+		for( const auto &record : getRecords() ) {
+			if( record.mLevel == level )
+				result.push_back( record.mText );
+		}
+		return result;
+	}
+
+  private:
+	mutex			mMutex;
+	vector<Record>	mRecords;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Log")
+{
+	auto capture = make_shared<LoggerCapture>();
+	log::manager()->resetLogger( capture );
+
+	SECTION("synchronous records are written before returning")
+	{
+		REQUIRE_FALSE( log::manager()->isAsync() );
+		CI_LOG_I( "value " << 42 );
+		CI_LOG_DEFERRED_I( "value ", 43, " ", 1.5f, " ", string( "text" ) );
+		REQUIRE( capture->getTexts( log::LEVEL_INFO ) == vector<string>( { "value 42", "value 43 1.5 text" } ) );
+	}
+
+	SECTION("asynchronous records keep their order within a thread")
+	{
+		const uint64_t numDropped = log::manager()->getNumDropped();
+		log::manager()->setAsync( true, 1024 * 1024 );
+		REQUIRE( log::manager()->isAsync() );
+
+		const int numThreads = 4, numRecords = 1000;
+		vector<thread> threads;
+		for( int t = 0; t < numThreads; ++t ) {
+			threads.emplace_back( [t] {
+				for( int i = 0; i < numRecords; ++i ) {
+					if( i & 1 )
+						CI_LOG_DEFERRED_I( t, " ", i );
+					else
+						CI_LOG_I( t << " " << i );
+				}
+			} );
+		}
+		for( auto &t : threads )
+			t.join();
+		log::manager()->flush();
+
+		vector<int> next( numThreads, 0 );
+		for( const auto &text : capture->getTexts( log::LEVEL_INFO ) ) {
+			int t, i;
+			istringstream( text ) >> t >> i;
+			REQUIRE( i == next[t] );
+			++next[t];
+		}
+		REQUIRE( next == vector<int>( numThreads, numRecords ) );
+		REQUIRE( log::manager()->getNumDropped() == numDropped );
+
+		log::manager()->setAsync( false );
+		REQUIRE_FALSE( log::manager()->isAsync() );
+	}
+
+	SECTION("disabling asynchronous logging writes pending records")
+	{
+		log::manager()->setAsync( true );
+		for( int i = 0; i < 100; ++i )
+			CI_LOG_DEFERRED_W( "record ", i );
+		log::manager()->setAsync( false );
+		REQUIRE( capture->getTexts( log::LEVEL_WARNING ).size() == 100 );
+		REQUIRE( capture->getTexts( log::LEVEL_WARNING ).back() == "record 99" );
+	}
+
+	SECTION("mutable C strings and string views are copied")
+	{
+		log::manager()->setAsync( true );
+		char buffer[16];
+		strcpy( buffer, "stack" );
+		char *str = buffer;
+		CI_LOG_DEFERRED_I( "pointer ", str );
+#if __cplusplus >= 201703L
+		CI_LOG_DEFERRED_I( "view ", string_view( buffer, 3 ) );
+#endif
+		strcpy( buffer, "overwritten" );
+		log::manager()->setAsync( false );
+
+		auto texts = capture->getTexts( log::LEVEL_INFO );
+		REQUIRE( texts.front() == "pointer stack" );
+#if __cplusplus >= 201703L
+		REQUIRE( texts.back() == "view sta" );
+#endif
+	}
+
+	SECTION("fatal records are written before returning")
+	{
+		log::manager()->setAsync( true );
+		CI_LOG_I( "first" );
+		CI_LOG_F( "second" );
+		auto records = capture->getRecords();
+		REQUIRE( records.size() == 2 );
+		REQUIRE( records[0].mText == "first" );
+		REQUIRE( records[1].mText == "second" );
+		log::manager()->setAsync( false );
+	}
+
+	SECTION("records which do not fit are dropped and counted")
+	{
+		const uint64_t numDropped = log::manager()->getNumDropped();
+		log::manager()->setAsync( true, 512 );
+
+		const int numRecords = 1000;
+		const string text( 100, 'x' );
+		for( int i = 0; i < numRecords; ++i )
+			CI_LOG_I( text );
+		log::manager()->setAsync( false );
+
+		const uint64_t dropped = log::manager()->getNumDropped() - numDropped;
+		REQUIRE( dropped > 0 );
+		REQUIRE( capture->getTexts( log::LEVEL_INFO ).size() + dropped == numRecords );
+		// the drop is reported as a warning
+		REQUIRE( capture->getTexts( log::LEVEL_WARNING ).size() >= 1 );
+	}
+
+	log::manager()->restoreToDefault();
+}
+
+TEST_CASE("LoggerBinary")
+{
+	const fs::path folder = fs::temp_directory_path() / "cinder_log_binary_test";
+	fs::remove_all( folder );
+
+	auto capture = make_shared<LoggerCapture>();
+	vector<fs::path> changedPaths;
+	auto binary = make_shared<log::LoggerBinary>( folder, "test.cilog", true, [&]( const fs::path &path ) { changedPaths.push_back( path ); } );
+	log::manager()->resetLogger( capture );
+	log::manager()->addLogger( binary );
+
+	auto logRecords = [] {
+		for( int i = 0; i < 20; ++i ) {
+			CI_LOG_I( "text " << i << " " << i * 0.25f );
+			CI_LOG_DEFERRED_W( "args ", i, " ", -i, " ", (uint8_t)'a', " ", i * 0.25f, " ", 1e100, " ", (uint64_t)1 << 63, " ", i % 2 == 0, " ", "literal", " ", string( "string" ) );
+		}
+	};
+
+	auto readRecords = [&] {
+		vector<log::LoggerBinary::Record> result;
+		log::LoggerBinary::Reader reader( folder / "test.cilog" );
+		log::LoggerBinary::Record record;
+		while( reader.readNext( &record ) )
+			result.push_back( record );
+		return result;
+	};
+
+	SECTION("records decode to the text other loggers receive")
+	{
+		logRecords();
+		log::manager()->setAsync( true );
+		logRecords();
+		log::manager()->setAsync( false );
+		log::manager()->resetLogger( capture );
+		binary.reset();
+
+		auto expected = capture->getRecords();
+		auto records = readRecords();
+		REQUIRE( changedPaths == vector<fs::path>( { folder / "test.cilog" } ) );
+		REQUIRE( records.size() == expected.size() );
+		for( size_t i = 0; i < records.size(); ++i ) {
+			REQUIRE( records[i].mLevel == expected[i].mLevel );
+			REQUIRE( records[i].mText == expected[i].mText );
+			REQUIRE( records[i].mLocation.getFunctionName() == records[0].mLocation.getFunctionName() );
+			REQUIRE( records[i].mThreadId == std::hash<std::thread::id>()( this_thread::get_id() ) );
+			REQUIRE( records[i].mTimestamp >= records[0].mTimestamp );
+		}
+		REQUIRE( records[1].mText == "args 0 0 a 0 1e+100 9223372036854775808 1 literal string" );
+	}
+
+	SECTION("appended records redefine their locations")
+	{
+		logRecords();
+		log::manager()->resetLogger( capture );
+		binary.reset();
+
+		binary = make_shared<log::LoggerBinary>( folder, "test.cilog" );
+		log::manager()->addLogger( binary );
+		CI_LOG_E( "appended" );
+		log::manager()->resetLogger( capture );
+		binary.reset();
+
+		auto records = readRecords();
+		REQUIRE( records.size() == 41 );
+		REQUIRE( records.back().mText == "appended" );
+		REQUIRE( records.back().mLevel == log::LEVEL_ERROR );
+		REQUIRE( records.back().mLocation.getLineNumber() != records.front().mLocation.getLineNumber() );
+	}
+
+	SECTION("a truncated record ends the file")
+	{
+		logRecords();
+		log::manager()->resetLogger( capture );
+		binary.reset();
+
+		const fs::path path = folder / "test.cilog";
+		fs::resize_file( path, fs::file_size( path ) - 3 );
+		REQUIRE( readRecords().size() == 39 );
+	}
+
+	SECTION("other files are rejected")
+	{
+		log::manager()->resetLogger( capture );
+		binary.reset();
+		fs::create_directories( folder );
+		ofstream( ( folder / "test.cilog" ).string() ) << "|info   | some text" << endl;
+		REQUIRE_THROWS_AS( log::LoggerBinary::Reader( folder / "test.cilog" ), log::LogBinaryExc );
+	}
+
+	log::manager()->restoreToDefault();
+	fs::remove_all( folder );
+}
+
+TEST_CASE("Log benchmark", "[.][benchmark]")
+{
+	const fs::path path = fs::temp_directory_path() / "cinder_log_benchmark.log";
+	log::manager()->resetLogger( make_shared<log::LoggerFile>( path, false ) );
+
+	const int numRecords = 200000;
+	vector<double> latencies( numRecords );
+
+	auto report = [&]( const char *name ) {
+		sort( latencies.begin(), latencies.end() );
+		double mean = 0;
+		for( double latency : latencies )
+			mean += latency;
+		mean /= numRecords;
+		cout << name << ": mean " << mean << " ns, median " << latencies[numRecords / 2] << " ns, p99 " << latencies[numRecords * 99 / 100]
+			<< " ns, max " << latencies.back() << " ns" << endl;
+	};
+
+	auto measure = [&]( const function<void( int )> &logFn ) {
+		for( int i = 0; i < numRecords; ++i ) {
+			auto start = chrono::steady_clock::now();
+			logFn( i );
+			latencies[i] = (double)chrono::duration_cast<chrono::nanoseconds>( chrono::steady_clock::now() - start ).count();
+		}
+	};
+
+	measure( []( int i ) { CI_LOG_I( "frame " << i << " took " << i * 0.5f << " ms" ); } );
+	report( "synchronous" );
+
+	const uint64_t numDropped = log::manager()->getNumDropped();
+	log::manager()->setAsync( true, 4 * 1024 * 1024 );
+	measure( []( int i ) { CI_LOG_I( "frame " << i << " took " << i * 0.5f << " ms" ); } );
+	log::manager()->flush();
+	report( "asynchronous" );
+
+	measure( []( int i ) { CI_LOG_DEFERRED_I( "frame ", i, " took ", i * 0.5f, " ms" ); } );
+	log::manager()->setAsync( false );
+	report( "asynchronous deferred" );
+	cout << "dropped " << log::manager()->getNumDropped() - numDropped << " records" << endl;
+
+	const fs::path folder = fs::temp_directory_path() / "cinder_log_benchmark";
+	log::manager()->resetLogger( make_shared<log::LoggerBinary>( folder, "benchmark.cilog", false ) );
+	measure( []( int i ) { CI_LOG_I( "frame " << i << " took " << i * 0.5f << " ms" ); } );
+	report( "binary" );
+	measure( []( int i ) { CI_LOG_DEFERRED_I( "frame ", i, " took ", i * 0.5f, " ms" ); } );
+	report( "binary deferred" );
+	log::manager()->resetLogger( make_shared<log::LoggerFile>( path, false ) );
+	cout << "binary file: " << fs::file_size( folder / "benchmark.cilog" ) << " bytes, text file: " << fs::file_size( path ) << " bytes" << endl;
+	fs::remove_all( folder );
+
+	log::manager()->restoreToDefault();
+	fs::remove( path );
+}
@@ -1,5 +1,6 @@
 #include "cinder/app/App.h"
 #include "cinder/Path2d.h"
+#include "cinder/PathFlattener.h"
 #include "cinder/Rand.h"
 
 #include "catch.hpp"
@@ -170,6 +171,95 @@ TEST_CASE("Path2d")
 		REQUIRE( glm::distance( p.getPosition( t ), vec2( 50, 50 ) ) == Approx( 0 ).epsilon( 0.001 ) );
 	}
 	
+	SECTION("Path2dCalcCache")
+	{
+		Path2d p;
+		p.moveTo( 50, 50 ); p.lineTo( 150, 50 ); p.curveTo( 200, 50, 250, 120, 180, 200 ); p.quadTo( 100, 250, 50, 150 ); p.close();
+		Path2dCalcCache cache( p );
+		REQUIRE( cache.getLength() == Approx( p.calcLength() ).epsilon( 0.0001 ) );
+		REQUIRE( cache.getSegmentLength( 0 ) == Approx( 100 ) );
+
+		// positions by distance must agree with the iterative solve on the Path2d itself
+		for( float d : { 0.0f, 25.0f, 100.0f, 123.4f, 200.0f, 310.0f, cache.getLength() * 0.9f } ) {
+			vec2 expected = p.getPosition( p.calcTimeForDistance( d ) );
+			REQUIRE( glm::distance( cache.getPositionAtDistance( d ), expected ) == Approx( 0 ).margin( 0.01 ) );
+			REQUIRE( glm::distance( cache.getPosition( cache.calcTimeForDistance( d ) ), expected ) == Approx( 0 ).margin( 0.01 ) );
+		}
+
+		// the sub-path up to a distance has that length
+		float t = cache.calcNormalizedTime( 0.4f );
+		REQUIRE( p.getSubPath( 0, t ).calcLength() == Approx( cache.getLength() * 0.4f ).epsilon( 0.001 ) );
+
+		// wrapping and clamping
+		REQUIRE( glm::distance( cache.getPositionAtDistance( -10, true ), cache.getPositionAtDistance( cache.getLength() - 10 ) ) == Approx( 0 ).margin( 0.01 ) );
+		REQUIRE( glm::distance( cache.getPositionAtDistance( cache.getLength() + 25, true ), vec2( 75, 50 ) ) == Approx( 0 ).margin( 0.01 ) );
+		REQUIRE( glm::distance( cache.getPositionAtDistance( -10 ), vec2( 50, 50 ) ) == Approx( 0 ).margin( 0.01 ) );
+
+		// batch sampling matches individual queries
+		vector<float> distances;
+		for( int i = 0; i < 10000; ++i )
+			distances.push_back( i * 0.1f );
+		vector<vec2> positions( distances.size() ), tangents( distances.size() );
+		cache.calcPositionsAtDistances( distances.data(), distances.size(), positions.data(), tangents.data(), true );
+		for( size_t i = 0; i < distances.size(); i += 97 ) {
+			REQUIRE( positions[i] == cache.getPositionAtDistance( distances[i], true ) );
+			REQUIRE( tangents[i] == cache.getTangentAtDistance( distances[i], true ) );
+		}
+	}
+
+	SECTION("PathFlattener")
+	{
+		// chords of a flattened circle stay within tolerance of the curve
+		for( float tolerance : { 1.0f, 0.25f, 0.01f } ) {
+			Path2d circle = Path2d::circle( vec2( 0 ), 100 );
+			circle.close();
+			vector<vec2> points( PathFlattener::calcNumPoints( circle, tolerance ) );
+			REQUIRE( PathFlattener::flatten( circle, tolerance, points.data() ) == points.size() );
+			REQUIRE( points.front() != points.back() );
+			for( size_t i = 0; i < points.size(); ++i ) {
+				vec2 mid = ( points[i] + points[( i + 1 ) % points.size()] ) * 0.5f;
+				REQUIRE( length( points[i] ) == Approx( 100 ).margin( 0.05 ) );
+				REQUIRE( length( mid ) >= 100 - tolerance - 0.05f );
+			}
+		}
+
+		// a finer tolerance gives more points, straight lines are never subdivided
+		Path2d p;
+		p.moveTo( 0, 0 ); p.lineTo( 100, 0 ); p.quadTo( 150, 0, 150, 50 ); p.curveTo( 150, 100, 0, 100, 0, 50 );
+		REQUIRE( PathFlattener::calcNumPoints( p, 0.01f ) > PathFlattener::calcNumPoints( p, 1.0f ) );
+		REQUIRE( PathFlattener::calcNumPoints( Path2d::rectangle( 0, 0, 10, 10 ), 0.01f ) == 4 );
+
+		// a closed contour that returns to its start writes no more points than it counts
+		Path2d triangle;
+		triangle.moveTo( 0, 0 ); triangle.lineTo( 10, 0 ); triangle.quadTo( 10, 10, 0, 0 ); triangle.close();
+		vector<vec2> trianglePoints( PathFlattener::calcNumPoints( triangle, 0.01f ) + 1, vec2( -1 ) );
+		REQUIRE( PathFlattener::flatten( triangle, 0.01f, trianglePoints.data() ) == trianglePoints.size() - 1 );
+		REQUIRE( trianglePoints.back() == vec2( -1 ) );
+
+		// batches of contours match flattening each on its own, and reuse memory
+		Shape2d shape;
+		shape.moveTo( 0, 0 ); shape.curveTo( 50, -50, 100, 50, 150, 0 ); shape.close();
+		shape.moveTo( 10, 10 ); shape.quadTo( 20, 40, 30, 10 );
+		PathFlattener flattener( 0.1f );
+		flattener.flatten( shape );
+		flattener.flatten( p );
+		REQUIRE( flattener.getNumContours() == 3 );
+		REQUIRE( flattener.isContourClosed( 0 ) );
+		REQUIRE( ! flattener.isContourClosed( 1 ) );
+		for( size_t c = 0; c < 2; ++c ) {
+			vector<vec2> expected( PathFlattener::calcNumPoints( shape.getContour( c ), 0.1f ) );
+			PathFlattener::flatten( shape.getContour( c ), 0.1f, expected.data() );
+			REQUIRE( vector<vec2>( flattener.getContourPoints( c ), flattener.getContourPoints( c ) + flattener.getContourNumPoints( c ) ) == expected );
+		}
+		REQUIRE( flattener.getContourEnds().back() == flattener.getPoints().size() );
+
+		const vec2 *data = flattener.getPoints().data();
+		flattener.clear();
+		flattener.flatten( shape );
+		REQUIRE( flattener.getNumContours() == 2 );
+		REQUIRE( flattener.getPoints().data() == data );
+	}
+
 	SECTION("translate")
 	{
 		Path2d p;
@@ -1,5 +1,6 @@
 #include "cinder/app/App.h"
 #include "cinder/PolyLine.h"
+#include "cinder/Shape2d.h"
 
 #include "catch.hpp"
 
@@ -8,6 +9,24 @@ using namespace ci;
 using namespace ci::app;
 using namespace std;
 
+namespace {
+
+PolyLine2f makeRect( float x0, float y0, float x1, float y1 )
+{
+	return PolyLine2f( { vec2( x0, y0 ), vec2( x1, y0 ), vec2( x1, y1 ), vec2( x0, y1 ) }, true );
+}
+
+// sums the signed areas, so holes subtract
+double calcSignedArea( const vector<PolyLine2f> &polygons )
+{
+	double result = 0;
+	for( const auto &polygon : polygons )
+		result += polygon.calcArea() * ( polygon.isCounterclockwise() ? 1 : -1 );
+	return result;
+}
+
+} // anonymous namespace
+
 TEST_CASE("PolyLine2f")
 {
 	SECTION("reverse")
@@ -178,5 +197,79 @@ TEST_CASE("PolyLine2f")
 
 		CHECK( poly.calcCentroid() == vec2( 0.5, 0.5 ) );
 	}
-}
 
+	SECTION("boolean")
+	{
+		vector<PolyLine2f> a = { makeRect( 0, 0, 2, 2 ) }, b = { makeRect( 1, 1, 3, 3 ) };
+		CHECK( calcSignedArea( PolyLine2f::calcUnion( a, b ) ) == Approx( 7 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcIntersection( a, b ) ) == Approx( 1 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcDifference( a, b ) ) == Approx( 3 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcXor( a, b ) ) == Approx( 6 ) );
+		CHECK( PolyLine2f::calcIntersection( a, { makeRect( 5, 5, 6, 6 ) } ).empty() );
+
+		// shared edges merge, and the collinear vertices they leave are removed
+		auto merged = PolyLine2f::calcUnion( { makeRect( 0, 0, 1, 1 ) }, { makeRect( 1, 0, 2, 1 ) } );
+		REQUIRE( merged.size() == 1 );
+		CHECK( merged[0].size() == 4 );
+		CHECK( merged[0].isClosed() );
+
+		// holes come out clockwise
+		auto holed = PolyLine2f::calcDifference( { makeRect( 0, 0, 10, 10 ) }, { makeRect( 2, 2, 4, 4 ) } );
+		REQUIRE( holed.size() == 2 );
+		CHECK( holed[0].isCounterclockwise() != holed[1].isCounterclockwise() );
+		CHECK( calcSignedArea( holed ) == Approx( 96 ) );
+
+		// a self-intersecting pentagram under both fill rules
+		PolyLine2f star;
+		for( int i = 0; i < 5; ++i )
+			star.push_back( vec2( cos( i * 4 * M_PI / 5 ), sin( i * 4 * M_PI / 5 ) ) * 10.0f );
+		CHECK( PolyLine2f::calcUnion( { star } ).size() == 1 );
+		CHECK( PolyLine2f::calcUnion( { star }, PolyLine2f::FILL_EVEN_ODD ).size() == 5 );
+
+		// the batch variant matches individual calls
+		vector<vector<PolyLine2f>> subjects = { a, b, { makeRect( -1, -1, 0.5f, 0.5f ) } };
+		auto batch = PolyLine2f::calcBoolean( PolyLine2f::BOOLEAN_INTERSECTION, subjects, { makeRect( 0, 0, 1.5f, 1.5f ) } );
+		REQUIRE( batch.size() == 3 );
+		CHECK( calcSignedArea( batch[0] ) == Approx( 2.25 ) );
+		CHECK( calcSignedArea( batch[1] ) == Approx( 0.25 ) );
+		CHECK( calcSignedArea( batch[2] ) == Approx( 0.25 ) );
+	}
+
+	SECTION("calcOffset")
+	{
+		vector<PolyLine2f> square = { makeRect( 0, 0, 10, 10 ) };
+		CHECK( calcSignedArea( PolyLine2f::calcOffset( square, 1, PolyLine2f::JOIN_MITER ) ) == Approx( 144 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcOffset( square, 1, PolyLine2f::JOIN_ROUND, 2, 0.001 ) ) == Approx( 140 + M_PI ).epsilon( 0.001 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcOffset( square, -1, PolyLine2f::JOIN_ROUND ) ) == Approx( 64 ) );
+		CHECK( PolyLine2f::calcOffset( square, -6 ).empty() );
+
+		// an L shape grows around its concave corner and shrinks away from it
+		vector<PolyLine2f> l = { PolyLine2f( { vec2( 0, 0 ), vec2( 10, 0 ), vec2( 10, 10 ), vec2( 5, 10 ), vec2( 5, 5 ), vec2( 0, 5 ) }, true ) };
+		CHECK( calcSignedArea( PolyLine2f::calcOffset( l, 1, PolyLine2f::JOIN_MITER ) ) == Approx( 119 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcOffset( l, -1, PolyLine2f::JOIN_MITER ) ) == Approx( 39 ) );
+
+		// clockwise input keeps its orientation
+		auto clockwise = PolyLine2f::calcOffset( { square[0].reversed() }, 1, PolyLine2f::JOIN_MITER );
+		REQUIRE( clockwise.size() == 1 );
+		CHECK( clockwise[0].isClockwise() );
+		CHECK( clockwise[0].calcArea() == Approx( 144 ) );
+	}
+
+	SECTION("Shape2d")
+	{
+		Shape2d circle, square;
+		circle.appendContour( Path2d::circle( vec2( 0 ), 10 ) );
+		square.appendContour( Path2d::rectangle( 0, 0, 20, 20 ) );
+
+		// tighter tolerances converge on the true curve
+		const double coarse = calcSignedArea( PolyLine2f::calcUnion( circle, PolyLine2f::FILL_NONZERO, 1.0f ) );
+		const double fine = calcSignedArea( PolyLine2f::calcUnion( circle, PolyLine2f::FILL_NONZERO, 0.001f ) );
+		CHECK( fine == Approx( 100 * M_PI ).epsilon( 0.001 ) );
+		CHECK( coarse < fine );
+
+		CHECK( calcSignedArea( PolyLine2f::calcIntersection( circle, square, PolyLine2f::FILL_NONZERO, 0.001f ) ) == Approx( 25 * M_PI ).epsilon( 0.001 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcUnion( circle, square, PolyLine2f::FILL_NONZERO, 0.001f ) ) == Approx( 400 + 75 * M_PI ).epsilon( 0.001 ) );
+		CHECK( calcSignedArea( PolyLine2f::calcDifference( square, circle, PolyLine2f::FILL_NONZERO, 0.001f ) ) == Approx( 400 - 25 * M_PI ).epsilon( 0.001 ) );
+		CHECK( std::abs( calcSignedArea( PolyLine2f::calcOffset( circle, 1, PolyLine2f::JOIN_ROUND, 2, 0.001, 0.001f ) ) ) == Approx( 121 * M_PI ).epsilon( 0.001 ) );
+	}
+}
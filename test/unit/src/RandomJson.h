@@ -0,0 +1,42 @@
+#pragma once
+
+#include "cinder/Json.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+#include <string>
+
+//! Returns a random JSON value, nested at most a few levels below \a depth. Strings mix escapes, multi-byte UTF-8 and runs long enough to cross
+//! the buffers of the streaming readers and writers, and numbers cover large unsigned integers and doubles with large and small exponents.
+inline ci::Json makeRandomJson( ci::Rand &rand, int depth = 0 )
+{
+	switch( rand.nextInt( depth > 3 ? 6 : 8 ) ) {
+		case 0: return nullptr;
+		case 1: return rand.nextBool();
+		case 2: return rand.nextInt( -1000000, 1000000 );
+		case 3: return (uint64_t)rand.nextUint() << 32 | rand.nextUint();
+		case 4: return rand.nextFloat( -1e6f, 1e6f ) * std::pow( 10.0, rand.nextInt( -30, 30 ) );
+		case 5: {
+			const char *pieces[] = { "a", "b", " ", "\"", "\\", "/", "\n", "\t", "\x01", "\xC3\xA9", "\xF0\x9F\x98\x80", "long text which crosses buffer boundaries " };
+			std::string s;
+			const int length = rand.nextInt( 40 );
+			for( int i = 0; i < length; ++i )
+				s += pieces[rand.nextInt( sizeof( pieces ) / sizeof( pieces[0] ) )];
+			return s;
+		}
+		case 6: {
+			ci::Json result = ci::Json::array();
+			const int numChildren = rand.nextInt( 20 );
+			for( int i = 0; i < numChildren; ++i )
+				result.push_back( makeRandomJson( rand, depth + 1 ) );
+			return result;
+		}
+		default: {
+			ci::Json result = ci::Json::object();
+			const int numChildren = rand.nextInt( 30 );
+			for( int i = 0; i < numChildren; ++i )
+				result["key" + std::to_string( rand.nextInt( 100 ) ) + ( rand.nextBool() ? "\"\\" : "" )] = makeRandomJson( rand, depth + 1 );
+			return result;
+		}
+	}
+}
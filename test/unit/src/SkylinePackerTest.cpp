@@ -0,0 +1,69 @@
+#include "cinder/SkylinePacker.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+bool overlaps( const Area &a, const Area &b )
+{
+	return a.x1 < b.x2 && b.x1 < a.x2 && a.y1 < b.y2 && b.y1 < a.y2;
+}
+
+} // anonymous namespace
+
+TEST_CASE("SkylinePacker")
+{
+	SECTION("rectangles never overlap or leave the bounds")
+	{
+		Rand rand( 77 );
+		SkylinePacker packer( ivec2( 256, 200 ) );
+		vector<Area> placed;
+		int64_t area = 0;
+		for( int i = 0; i < 2000; ++i ) {
+			ivec2 size( rand.nextInt( 1, 40 ), rand.nextInt( 1, 40 ) );
+			Area result = packer.insert( size );
+			if( result.getWidth() == 0 )
+				continue;
+			REQUIRE( result.getSize() == size );
+			REQUIRE( result.x1 >= 0 );
+			REQUIRE( result.y1 >= 0 );
+			REQUIRE( result.x2 <= 256 );
+			REQUIRE( result.y2 <= 200 );
+			for( const auto &other : placed )
+				REQUIRE( ! overlaps( result, other ) );
+			placed.push_back( result );
+			area += result.calcArea();
+		}
+		REQUIRE( packer.getOccupancy() == Approx( area / ( 256.0 * 200.0 ) ) );
+		REQUIRE( packer.getOccupancy() > 0.7f );
+	}
+
+	SECTION("equal rectangles fill rows exactly")
+	{
+		SkylinePacker packer( ivec2( 64, 64 ) );
+		for( int i = 0; i < 16; ++i ) {
+			Area result = packer.insert( ivec2( 16 ) );
+			REQUIRE( result == Area( ( i % 4 ) * 16, ( i / 4 ) * 16, ( i % 4 ) * 16 + 16, ( i / 4 ) * 16 + 16 ) );
+		}
+		REQUIRE( packer.getOccupancy() == Approx( 1 ) );
+		REQUIRE( packer.insert( ivec2( 1 ) ).getWidth() == 0 );
+	}
+
+	SECTION("clear and oversized")
+	{
+		SkylinePacker packer( ivec2( 32, 32 ) );
+		REQUIRE( packer.insert( ivec2( 33, 1 ) ).getWidth() == 0 );
+		REQUIRE( packer.insert( ivec2( 0, 5 ) ).getWidth() == 0 );
+		REQUIRE( packer.insert( ivec2( 32, 20 ) ).getWidth() == 32 );
+		REQUIRE( packer.insert( ivec2( 10, 13 ) ).getWidth() == 0 );
+		packer.clear();
+		REQUIRE( packer.getOccupancy() == 0 );
+		REQUIRE( packer.insert( ivec2( 10, 13 ) ) == Area( 0, 0, 10, 13 ) );
+	}
+}
@@ -0,0 +1,179 @@
+#include "cinder/svg/Svg.h"
+#include "cinder/svg/SvgRaster.h"
+#include "cinder/DataSource.h"
+#include "cinder/ip/Fill.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+svg::DocRef loadSvg( string source, const svg::Doc::ParseOptions &options = svg::Doc::ParseOptions() )
+{
+	auto buffer = make_shared<Buffer>( source.size() );
+	memcpy( buffer->getData(), source.data(), source.size() );
+	return svg::Doc::create( DataSourceBuffer::create( buffer ), fs::path(), options );
+}
+
+const char *sSpatialSvg = R"svg(<svg xmlns="http://www.w3.org/2000/svg" width="200" height="200">
+	<clipPath id="leftHalf"><rect x="0" y="120" width="50" height="50"/></clipPath>
+	<rect id="back" x="0" y="0" width="100" height="100"/>
+	<g id="moved" transform="translate(150,0)">
+		<circle id="circle" cx="20" cy="20" r="10"/>
+	</g>
+	<rect id="hidden" x="10" y="10" width="20" height="20" visibility="hidden"/>
+	<g style="display:none"><rect id="notDisplayed" x="40" y="40" width="10" height="10"/></g>
+	<rect id="clipped" x="0" y="120" width="100" height="50" clip-path="url(#leftHalf)"/>
+</svg>)svg";
+
+const char *sRasterSvg = R"svg(<svg xmlns="http://www.w3.org/2000/svg" width="100" height="100">
+	<defs><linearGradient id="ramp" gradientUnits="userSpaceOnUse" x1="0" y1="0" x2="100" y2="0">
+		<stop offset="0" stop-color="#000"/><stop offset="1" stop-color="#fff"/>
+	</linearGradient></defs>
+	<rect x="10.5" y="10" width="20" height="20" fill="#f00"/>
+	<path d="M40,10 h40 v40 h-40 z M50,20 v20 h20 v-20 z" fill="#0f0" fill-rule="evenodd"/>
+	<path d="M40,60 h40 v30 h-40 z M50,70 h20 v10 h-20 z" fill="#0f0"/>
+	<line x1="5" y1="50" x2="35" y2="50" stroke="#00f" stroke-width="4"/>
+	<rect x="0" y="95" width="100" height="5" fill="url(#ramp)"/>
+	<g opacity="0.5"><rect x="5" y="60" width="10" height="10" fill="#fff"/><rect x="10" y="60" width="10" height="10" fill="#fff"/></g>
+</svg>)svg";
+
+const char *sParseSvg = R"svg(<svg xmlns="http://www.w3.org/2000/svg" width="100" height="100">
+	<path id="numbers" d="M1e1,.5-.5.5L-1.5e-1 2E+1,3.,0.25.75 20ZM0 0h1e-2v12345678901234567890"/>
+	<polygon id="points" points="1,2 3e0 4 -5-6 7"/>
+	<circle id="circle" cx="5px" cy="6" r="7.5"/>
+</svg>)svg";
+
+string idOf( const svg::Node *node )
+{
+	return node ? node->getId() : string( "null" );
+}
+
+} // anonymous namespace
+
+TEST_CASE("Svg")
+{
+	SECTION("spatial queries")
+	{
+		svg::DocRef doc = loadSvg( sSpatialSvg );
+		REQUIRE( doc->findClipPath() == nullptr );
+		REQUIRE( doc->find<svg::Rect>( "clipped" )->findClipPath() != nullptr );
+
+		CHECK( idOf( doc->findInnermostNode( vec2( 50, 50 ) ) ) == "back" );
+		CHECK( idOf( doc->findInnermostNode( vec2( 170, 20 ) ) ) == "circle" );
+		CHECK( idOf( doc->findInnermostNode( vec2( 165, 35 ) ) ) == "null" );	// inside the circle's bounds only
+		CHECK( idOf( doc->findInnermostNode( vec2( 15, 15 ) ) ) == "back" );	// "hidden" is skipped
+		CHECK( idOf( doc->findInnermostNode( vec2( 45, 45 ) ) ) == "back" );	// as is "notDisplayed"
+		CHECK( idOf( doc->findInnermostNode( vec2( 25, 140 ) ) ) == "clipped" );
+		CHECK( idOf( doc->findInnermostNode( vec2( 75, 140 ) ) ) == "null" );	// clipped away
+
+		auto inRect = doc->findNodesInRect( Rectf( 140, 0, 200, 50 ) );
+		REQUIRE( inRect.size() == 1 );
+		CHECK( inRect[0]->getId() == "circle" );
+		auto all = doc->findNodesInRect( Rectf( 0, 0, 200, 200 ) );
+		REQUIRE( all.size() == 3 );
+		CHECK( all[0]->getId() == "back" );
+		CHECK( all[1]->getId() == "circle" );
+		CHECK( all[2]->getId() == "clipped" );
+		CHECK( doc->findNodesInRect( Rectf( 60, 130, 90, 160 ) ).empty() );
+
+		float distance = -1;
+		CHECK( idOf( doc->findNearestNode( vec2( 170, 45 ), 100, &distance ) ) == "circle" );
+		CHECK( distance == Approx( 15 ) );
+		CHECK( idOf( doc->findNearestNode( vec2( 75, 140 ), 100, &distance ) ) == "clipped" );
+		CHECK( distance == Approx( 25 ) );
+		CHECK( idOf( doc->findNearestNode( vec2( 50, 50 ), 100, &distance ) ) == "back" );
+		CHECK( distance == 0 );
+		CHECK( doc->findNearestNode( vec2( 170, 45 ), 10 ) == nullptr );
+
+		// changing a transform rebuilds the index
+		mat3 transform;
+		transform[2] = vec3( 150, 50, 1 );
+		doc->find<svg::Group>( "moved" )->setTransform( transform );
+		CHECK( idOf( doc->findInnermostNode( vec2( 170, 70 ) ) ) == "circle" );
+		CHECK( idOf( doc->findInnermostNode( vec2( 170, 20 ) ) ) == "null" );
+	}
+
+	SECTION("rasterize")
+	{
+		svg::DocRef doc = loadSvg( sRasterSvg );
+		Surface8u surface = svg::rasterize( *doc );
+		REQUIRE( surface.getSize() == ivec2( 100 ) );
+
+		CHECK( surface.getPixel( ivec2( 20, 20 ) ) == ColorA8u( 255, 0, 0, 255 ) );
+		CHECK( surface.getPixel( ivec2( 5, 5 ) ).a == 0 );
+		// the rect's left edge runs through the middle of column 10
+		CHECK( surface.getPixel( ivec2( 10, 20 ) ).a == Approx( 128 ).margin( 1 ) );
+		CHECK( surface.getPixel( ivec2( 30, 20 ) ).a == Approx( 128 ).margin( 1 ) );
+
+		// evenodd leaves the inner square a hole, nonzero fills it as both contours wind the same way
+		CHECK( surface.getPixel( ivec2( 45, 15 ) ).g == 255 );
+		CHECK( surface.getPixel( ivec2( 60, 30 ) ).a == 0 );
+		CHECK( surface.getPixel( ivec2( 60, 75 ) ) == ColorA8u( 0, 255, 0, 255 ) );
+
+		// a 4 pixel wide stroke with butt caps
+		CHECK( surface.getPixel( ivec2( 20, 48 ) ) == ColorA8u( 0, 0, 255, 255 ) );
+		CHECK( surface.getPixel( ivec2( 20, 51 ) ) == ColorA8u( 0, 0, 255, 255 ) );
+		CHECK( surface.getPixel( ivec2( 20, 52 ) ).a == 0 );
+		CHECK( surface.getPixel( ivec2( 4, 50 ) ).a == 0 );
+		CHECK( surface.getPixel( ivec2( 35, 50 ) ).a == 0 );
+
+		CHECK( surface.getPixel( ivec2( 50, 97 ) ).r == Approx( 128 ).margin( 2 ) );
+		CHECK( surface.getPixel( ivec2( 99, 97 ) ).r > 250 );
+
+		// the group is composited as a whole, so its overlapping children don't accumulate opacity
+		CHECK( surface.getPixel( ivec2( 7, 65 ) ).a == Approx( 128 ).margin( 1 ) );
+		CHECK( surface.getPixel( ivec2( 12, 65 ) ).a == Approx( 128 ).margin( 1 ) );
+		CHECK( surface.getPixel( ivec2( 12, 65 ) ).r == 255 );
+
+		// tiling doesn't change the result
+		Surface32f surface32( 100, 100, true );
+		ip::fill( &surface32, ColorAf( 0, 0, 0, 0 ) );
+		SvgRendererRaster renderer;
+		renderer.setTileSize( 16 );
+		doc->render( renderer );
+		renderer.rasterize( &surface32 );
+		for( ivec2 p : { ivec2( 10, 20 ), ivec2( 20, 51 ), ivec2( 50, 97 ), ivec2( 12, 65 ) } ) {
+			ColorAf expected( surface.getPixel( p ) ), actual = surface32.getPixel( p );
+			CHECK( actual.r == Approx( expected.r ).margin( 0.01 ) );
+			CHECK( actual.a == Approx( expected.a ).margin( 0.01 ) );
+		}
+	}
+
+	SECTION("parsing")
+	{
+		for( bool lazy : { false, true } ) {
+			svg::DocRef doc = loadSvg( sParseSvg, svg::Doc::ParseOptions().lazyPaths( lazy ) );
+			REQUIRE( doc->getParseOptions().getLazyPaths() == lazy );
+
+			const Shape2d &shape = doc->find<svg::Path>( "numbers" )->getShape2d();
+			REQUIRE( shape.getNumContours() == 2 );
+			const vector<vec2> &points = shape.getContour( 0 ).getPoints();
+			REQUIRE( points.size() == 5 );
+			CHECK( points[0] == vec2( 10, 0.5f ) );
+			CHECK( points[1] == vec2( -0.5f, 0.5f ) );
+			CHECK( points[2] == vec2( -0.15f, 20 ) );
+			CHECK( points[3] == vec2( 3, 0.25f ) );
+			CHECK( points[4] == vec2( 0.75f, 20 ) );
+			CHECK( shape.getContour( 1 ).getPoints().back() == vec2( 0.01f, 12345678901234567890.0f ) );
+
+			// an odd coordinate ends the list
+			const vector<vec2> &polygon = doc->find<svg::Polygon>( "points" )->getPolyLine().getPoints();
+			REQUIRE( polygon.size() == 3 );
+			CHECK( polygon[1] == vec2( 3, 4 ) );
+			CHECK( polygon[2] == vec2( -5, -6 ) );
+
+			const svg::Circle *circle = doc->find<svg::Circle>( "circle" );
+			CHECK( circle->getCenter() == vec2( 5, 6 ) );
+			CHECK( circle->getRadius() == 7.5f );
+		}
+
+		// malformed path data throws while loading, unless parsing is deferred to first use
+		const char *malformedSvg = R"svg(<svg><path id="malformed" d="M0,0 L10,10 L#"/></svg>)svg";
+		REQUIRE_THROWS_AS( loadSvg( malformedSvg ), svg::FloatParseExc );
+		svg::DocRef doc = loadSvg( malformedSvg, svg::Doc::ParseOptions().lazyPaths() );
+		CHECK( doc->find<svg::Path>( "malformed" )->getShape2d().empty() );
+	}
+}
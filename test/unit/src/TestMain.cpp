@@ -6,6 +6,9 @@
 ///
 /// These unit tests are useful for non-visual testing of Cinder.
 ///
+/// Benchmarks are tagged "[.][benchmark]", which hides them from a
+/// default run. Run them with "UnitTests [benchmark]".
+///
 
 
 #define CATCH_CONFIG_MAIN
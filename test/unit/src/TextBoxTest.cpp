@@ -0,0 +1,56 @@
+#include "cinder/Text.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace std;
+
+#if defined( CINDER_LINUX )
+
+TEST_CASE("TextBox layout cache")
+{
+	const Font font = Font::getDefault();
+	const string text = "The quick brown fox jumps over the lazy dog.\nGr\xC3\xBC\xC3\x9F" "e \xCE\xA9\xCE\xBC\xCE\xAD\xCE\xB3\xCE\xB1 and a supercalifragilisticexpialidocious word   with  spaces.";
+
+	SECTION("cached layouts match fresh ones")
+	{
+		TextBox first;
+		first.font( font ).size( 120, TextBox::GROW ).text( text );
+		auto glyphs = first.measureGlyphs();
+		vec2 size = first.measure();
+
+		TextBox second = first;
+		second.setColor( ColorA( 1, 0, 0, 1 ) );
+		REQUIRE( second.measureGlyphs() == glyphs );
+
+		TextBox::clearLayoutCache();
+		TextBox fresh;
+		fresh.font( font ).size( 120, TextBox::GROW ).text( text );
+		REQUIRE( fresh.measureGlyphs() == glyphs );
+		REQUIRE( fresh.measure() == size );
+	}
+
+	SECTION("appended text lays out like the whole text")
+	{
+		for( int width : { 0, 60, 200 } ) {
+			TextBox appended;
+			appended.font( font ).size( width, TextBox::GROW );
+			for( size_t pos = 0; pos < text.size(); ) {
+				size_t length = 1 + pos % 5;
+				while( pos + length < text.size() && ( text[pos + length] & 0xC0 ) == 0x80 )
+					++length;
+				appended.appendText( text.substr( pos, length ) );
+				pos += length;
+				auto glyphs = appended.measureGlyphs();
+
+				TextBox::clearLayoutCache();
+				TextBox whole;
+				whole.font( font ).size( width, TextBox::GROW ).text( appended.getText() );
+				REQUIRE( whole.measureGlyphs() == glyphs );
+				REQUIRE( whole.measure() == appended.measure() );
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "cinder/Thread.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+TEST_CASE("parallelFor")
+{
+	SECTION("every index is visited exactly once")
+	{
+		const size_t begin = 17, end = 100000;
+		vector<atomic<int>> visits( end );
+		for( auto &v : visits )
+			v = 0;
+		// Catch assertions aren't thread-safe, so the workers only record what they see
+		atomic<size_t> numCalls( 0 ), numEmptyRanges( 0 );
+		parallelFor( begin, end, 1000, [&]( size_t rangeBegin, size_t rangeEnd ) {
+			if( rangeBegin >= rangeEnd )
+				++numEmptyRanges;
+			++numCalls;
+			for( size_t i = rangeBegin; i < rangeEnd; ++i )
+				++visits[i];
+		} );
+
+		REQUIRE( numEmptyRanges == 0 );
+		for( size_t i = 0; i < end; ++i )
+			REQUIRE( visits[i] == ( i < begin ? 0 : 1 ) );
+		if( getNumParallelThreads() > 1 )
+			REQUIRE( numCalls > 1 );
+	}
+
+	SECTION("small and empty ranges run serially on the calling thread")
+	{
+		const auto callingThread = this_thread::get_id();
+		int numCalls = 0;
+		parallelFor( 10, 25, 8, [&]( size_t rangeBegin, size_t rangeEnd ) {
+			REQUIRE( this_thread::get_id() == callingThread );
+			REQUIRE( rangeBegin == 10 );
+			REQUIRE( rangeEnd == 25 );
+			++numCalls;
+		} );
+		parallelFor( 5, 5, 1, [&]( size_t, size_t ) { ++numCalls; } );
+		REQUIRE( numCalls == 1 );
+	}
+
+	SECTION("exceptions are rethrown on the calling thread")
+	{
+		REQUIRE_THROWS_AS( parallelFor( 0, 100000, 100, []( size_t rangeBegin, size_t rangeEnd ) {
+			if( rangeBegin <= 50000 && 50000 < rangeEnd )
+				throw runtime_error( "failed" );
+		} ), runtime_error );
+	}
+
+	SECTION("nested calls complete")
+	{
+		atomic<size_t> sum( 0 );
+		parallelFor( 0, 64, 1, [&]( size_t outerBegin, size_t outerEnd ) {
+			for( size_t o = outerBegin; o < outerEnd; ++o ) {
+				parallelFor( 0, 1000, 100, [&]( size_t rangeBegin, size_t rangeEnd ) {
+					sum += rangeEnd - rangeBegin;
+				} );
+			}
+		} );
+		REQUIRE( sum == 64 * 1000 );
+	}
+}
@@ -0,0 +1,321 @@
+#include "cinder/Timeline.h"
+#include "cinder/Color.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include "catch.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+TEST_CASE("Timeline")
+{
+	TimelineRef timeline = Timeline::create();
+
+	SECTION("tweens update between their start and end")
+	{
+		Anim<float> value( 0 );
+		vector<string> calls;
+		timeline->apply( &value, 10.0f, 2.0f ).delay( 1 )
+			.startFn( [&] { calls.push_back( "start" ); } )
+			.finishFn( [&] { calls.push_back( "finish" ); } );
+
+		timeline->stepTo( 0.5f );
+		REQUIRE( value() == 0 );
+		REQUIRE( calls.empty() );
+		timeline->stepTo( 2 );
+		REQUIRE( value() == Approx( 5 ) );
+		REQUIRE( calls == vector<string>( { "start" } ) );
+		REQUIRE_FALSE( value.isComplete() );
+		timeline->stepTo( 3.5f );
+		REQUIRE( value() == 10 );
+		REQUIRE( calls == vector<string>( { "start", "finish" } ) );
+		REQUIRE( value.isComplete() );
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION("start time changes after insertion")
+	{
+		Anim<float> value( 0 );
+		TweenRef<float> tween = timeline->apply( &value, 1.0f, 1.0f ).startTime( 5 );
+		timeline->stepTo( 1 );
+		REQUIRE( value() == 0 );
+		tween->setStartTime( 0.5f );
+		timeline->stepTo( 1 );
+		REQUIRE( value() == Approx( 0.5f ) );
+		tween->setStartTime( 3 );
+		timeline->stepTo( 2 );
+		REQUIRE( value() == Approx( 0.5f ) );
+		timeline->stepTo( 3.25f );
+		REQUIRE( value() == Approx( 0.25f ) );
+	}
+
+	SECTION("tweens appended from a finish function update in the same step")
+	{
+		Anim<float> value( 0 );
+		timeline->apply( &value, 1.0f, 1.0f ).finishFn( [&] { timeline->appendTo( &value, 3.0f, 1.0f ).startTime( 1 ); } );
+		timeline->stepTo( 1.5f );
+		REQUIRE( value() == Approx( 2 ) );
+		REQUIRE( timeline->getNumItems() == 1 );
+		timeline->stepTo( 2 );
+		REQUIRE( value() == 3 );
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION("later items on the same target take precedence")
+	{
+		Anim<float> value( 0 );
+		timeline->appendTo( &value, 0.0f, 10.0f, 1.0f ).startTime( 0 ).autoRemove( false );
+		timeline->appendTo( &value, 0.0f, 20.0f, 1.0f ).startTime( 0.5f ).autoRemove( false );
+		timeline->appendTo( &value, 0.0f, 30.0f, 1.0f ).startTime( 0.25f ).autoRemove( false );
+		timeline->stepTo( 0.75f );
+		REQUIRE( value() == Approx( 15 ) );
+		timeline->stepTo( 2 );
+		REQUIRE( value() == 30 );
+		REQUIRE( timeline->getNumItems() == 3 );
+	}
+
+	SECTION("removal")
+	{
+		Anim<float> a( 0 ), b( 0 );
+		timeline->apply( &a, 1.0f, 1.0f );
+		TweenRef<float> tween = timeline->apply( &b, 1.0f, 1.0f ).delay( 10 );
+		timeline->appendTo( &b, 2.0f, 1.0f );
+		REQUIRE( timeline->getNumItems() == 3 );
+		a.stop();
+		timeline->stepTo( 0.5f );
+		REQUIRE( a() == 0 );
+		REQUIRE( timeline->getNumItems() == 2 );
+		tween->removeSelf();
+		timeline->stepTo( 0.6f );
+		REQUIRE( timeline->getNumItems() == 1 );
+		REQUIRE( timeline->findEndTimeOf( b.ptr() ) == Approx( 12 ) );
+		{
+			Anim<float> c( 0 );
+			timeline->apply( &c, 1.0f, 1.0f );
+			REQUIRE( timeline->getNumItems() == 2 );
+		}
+		timeline->stepTo( 0.7f );
+		REQUIRE( timeline->getNumItems() == 1 );
+		timeline->clear();
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION("items kept after clear() outlive the Timeline")
+	{
+		float value = 0;
+		TimelineRef other = Timeline::create();
+		TweenRef<float> tween = other->applyPtr( &value, 1.0f, 1.0f );
+		CueRef cue = other->add( [] {}, 0.5f );
+		other->clear();
+		REQUIRE( tween->getParent() == nullptr );
+		REQUIRE( cue->getParent() == nullptr );
+		other.reset();
+
+		tween->setEaseFn( EaseInQuad() );
+		tween->setLoop( true );
+		tween->removeSelf();
+		cue->removeSelf();
+	}
+
+	SECTION("stepping backwards")
+	{
+		Anim<float> value( 0 );
+		vector<string> calls;
+		timeline->apply( &value, 0.0f, 10.0f, 1.0f ).delay( 1 ).autoRemove( false )
+			.reverseStartFn( [&] { calls.push_back( "reverseStart" ); } )
+			.reverseFinishFn( [&] { calls.push_back( "reverseFinish" ); } );
+		timeline->stepTo( 3 );
+		REQUIRE( value() == 10 );
+		timeline->stepTo( 1.5f );
+		REQUIRE( value() == Approx( 5 ) );
+		REQUIRE( calls == vector<string>( { "reverseFinish" } ) );
+		timeline->stepTo( 0.5f );
+		REQUIRE( value() == 0 );
+		REQUIRE( calls == vector<string>( { "reverseFinish", "reverseStart" } ) );
+		timeline->stepTo( 1.25f );
+		REQUIRE( value() == Approx( 2.5f ) );
+	}
+
+	SECTION("loops, cues and nested timelines")
+	{
+		Anim<float> looped( 0 ), nested( 0 );
+		int numCues = 0;
+		timeline->apply( &looped, 0.0f, 1.0f, 1.0f ).loop();
+		timeline->add( [&] { ++numCues; }, 0.5f );
+		TimelineRef child = Timeline::create();
+		child->setInfinite( false );
+		child->apply( &nested, 0.0f, 4.0f, 2.0f );
+		timeline->insert( child, 1 );
+
+		timeline->stepTo( 0.25f );
+		REQUIRE( numCues == 0 );
+		timeline->stepTo( 1.75f );
+		REQUIRE( looped() == Approx( 0.75f ) );
+		REQUIRE( numCues == 1 );
+		REQUIRE( nested() == Approx( 1.5f ) );
+		timeline->stepTo( 5 );
+		REQUIRE( nested() == 4 );
+		REQUIRE( numCues == 1 );
+		REQUIRE( timeline->getNumItems() == 1 );
+	}
+
+	SECTION("changes to running tweens")
+	{
+		Anim<float> eased( 0 ), updated( 0 ), looped( 0 );
+		Anim<vec3> shared( vec3( 0 ) );
+		Anim<ColorA> color( ColorA( 0, 0, 0, 0 ) );
+		TweenRef<float> easedTween = timeline->apply( &eased, 1.0f, 1.0f );
+		TweenRef<float> updatedTween = timeline->apply( &updated, 1.0f, 1.0f );
+		TweenRef<float> loopedTween = timeline->apply( &looped, 1.0f, 1.0f );
+		timeline->apply( &shared, vec3( 1, 2, 3 ), 1.0f );
+		timeline->apply( &color, ColorA( 1, 1, 1, 1 ), 2.0f, EaseInQuad() );
+		int numUpdates = 0;
+		timeline->stepTo( 0.1f );
+		timeline->stepTo( 0.2f );
+
+		easedTween->setEaseFn( EaseInQuad() );
+		updatedTween->setUpdateFn( [&] { ++numUpdates; } );
+		loopedTween->setLoop();
+		loopedTween->setDuration( 0.5f );
+		timeline->appendTo( &shared, vec3( 0 ), vec3( 10 ), 1.0f ).startTime( 0.2f );
+		timeline->stepTo( 0.4f );
+		REQUIRE( eased() == Approx( 0.16f ) );
+		REQUIRE( numUpdates == 1 );
+		REQUIRE( distance( shared(), vec3( 2 ) ) < 1e-5f );
+		REQUIRE( color().a == Approx( 0.04f ) );
+		timeline->stepTo( 0.7f );
+		REQUIRE( looped() == Approx( 0.4f ) );
+		REQUIRE( numUpdates == 2 );
+
+		Anim<ColorA> moved( std::move( color ) );
+		Anim<float> copied( eased );
+		timeline->stepTo( 0.8f );
+		REQUIRE( moved().a == Approx( 0.16f ) );
+		REQUIRE( copied() == Approx( 0.64f ) );
+		REQUIRE( eased() == Approx( 0.64f ) );
+		REQUIRE( timeline->getNumItems() == 7 );
+
+		// stepping backwards after a reset restarts from the current value
+		timeline->reset( true );
+		timeline->stepTo( 0.5f );
+		REQUIRE( eased() == Approx( 0.25f ) );
+		timeline->stepTo( 0.6f );
+		REQUIRE( eased() == Approx( 0.25f + 0.75f * 0.36f ) );
+	}
+
+	SECTION("tweens grouped by easing function")
+	{
+		vector<EaseFn> eases = { EaseOutQuad(), easeOutQuad, EaseInOutCubic(), EaseOutBack(), []( float t ) { return t * t; }, EaseOutInCirc() };
+		vector<Anim<vec2>> values( 60 );
+		for( size_t i = 0; i < values.size(); ++i )
+			timeline->apply( &values[i], vec2( 0 ), vec2( 1, 2 ), 1.0f + i * 0.01f, eases[i % eases.size()] );
+
+		for( float t = 0.1f; t < 2; t += 0.2f ) {
+			timeline->stepTo( t );
+			for( size_t i = 0; i < values.size(); ++i ) {
+				float expected = eases[i % eases.size()]( math<float>::min( t / ( 1.0f + i * 0.01f ), 1 ) );
+				REQUIRE( values[i]().x == Approx( expected ).margin( 1e-5f ) );
+				REQUIRE( values[i]().y == Approx( expected * 2 ).margin( 1e-5f ) );
+			}
+		}
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION("many tweens with scattered start times")
+	{
+		Rand rand( 1234 );
+		const int numTweens = 2000;
+		vector<Anim<float>> values( numTweens );
+		vector<float> startTimes( numTweens ), durations( numTweens );
+		for( int i = 0; i < numTweens; ++i ) {
+			startTimes[i] = rand.nextFloat( 10 );
+			durations[i] = rand.nextFloat( 0.1f, 2 );
+			// Anim's default constructor leaves the value uninitialized, and it is read before each tween starts
+			values[i] = 0.0f;
+			timeline->apply( &values[i], 0.0f, 1.0f, durations[i] ).startTime( startTimes[i] );
+		}
+
+		for( float t = 0; t < 13; t += 0.25f ) {
+			timeline->stepTo( t );
+			size_t numRemaining = 0;
+			for( int i = 0; i < numTweens; ++i ) {
+				float expected = math<float>::clamp( ( t - startTimes[i] ) / durations[i], 0, 1 );
+				REQUIRE( values[i]() == Approx( expected ).margin( 1e-5f ) );
+				if( t < startTimes[i] + durations[i] )
+					++numRemaining;
+			}
+			REQUIRE( timeline->getNumItems() == numRemaining );
+		}
+	}
+}
+
+TEST_CASE("Easing batch")
+{
+	vector<float> times;
+	for( int i = 0; i <= 1000; ++i )
+		times.push_back( i / 1000.0f );
+	times.push_back( 0.4999f );
+
+	auto requireMatches = [&]( const EaseFn &ease, EaseBatchFn batchFn ) {
+		vector<float> results( times.size() );
+		batchFn( times.data(), results.data(), times.size() );
+		for( size_t i = 0; i < times.size(); ++i )
+			REQUIRE( results[i] == Approx( ease( times[i] ) ).margin( 1e-6f ) );
+		// the leftover values of an odd count take the scalar path
+		batchFn( times.data(), results.data(), 7 );
+		REQUIRE( results[6] == Approx( ease( times[6] ) ).margin( 1e-6f ) );
+	};
+
+	SECTION("stateless easing functions have batch equivalents")
+	{
+		vector<EaseFn> eases = { EaseNone(), EaseInQuad(), EaseOutQuad(), EaseInOutQuad(), EaseOutInQuad(), EaseInCubic(), EaseOutCubic(), EaseInOutCubic(),
+			EaseOutInCubic(), EaseInQuart(), EaseOutQuart(), EaseInOutQuart(), EaseOutInQuart(), EaseInQuint(), EaseOutQuint(), EaseInOutQuint(), EaseOutInQuint(),
+			EaseInSine(), EaseOutSine(), EaseInOutSine(), EaseOutInSine(), EaseInExpo(), EaseOutExpo(), EaseInOutExpo(), EaseOutInExpo(), EaseInCirc(),
+			EaseOutCirc(), EaseInOutCirc(), EaseOutInCirc(), easeInOutQuad, easeOutInCubic, easeInCirc };
+		for( const auto &ease : eases ) {
+			EaseBatchFn batchFn = findEaseBatchFn( ease );
+			REQUIRE( batchFn );
+			requireMatches( ease, batchFn );
+		}
+		REQUIRE( findEaseBatchFn( easeInOutQuad ) == findEaseBatchFn( EaseInOutQuad() ) );
+	}
+
+	SECTION("other easing functions have none")
+	{
+		REQUIRE_FALSE( findEaseBatchFn( EaseOutBack() ) );
+		REQUIRE_FALSE( findEaseBatchFn( []( float t ) { return t; } ) );
+		REQUIRE_FALSE( findEaseBatchFn( EaseFn() ) );
+		requireMatches( EaseInOutBack( 2 ), []( const float *t, float *result, size_t count ) { easeBatch( EaseInOutBack( 2 ), t, result, count ); } );
+	}
+}
+
+TEST_CASE("Timeline benchmark", "[.][benchmark]")
+{
+	const int numTweens = 100000, numFrames = 200;
+
+	auto run = [&]( const char *name, float maxDelay, float maxDuration ) {
+		TimelineRef timeline = Timeline::create();
+		vector<Anim<vec2>> values( numTweens );
+		Rand rand( 1234 );
+
+		Timer timer( true );
+		for( auto &value : values )
+			timeline->apply( &value, vec2( rand.nextFloat(), rand.nextFloat() ), rand.nextFloat( 0.1f, maxDuration ), EaseOutQuad() ).delay( rand.nextFloat( maxDelay ) );
+		double applySeconds = timer.getSeconds();
+
+		timer.start();
+		for( int frame = 0; frame < numFrames; ++frame )
+			timeline->step( 1 / 60.0f );
+		cout << name << ": apply " << applySeconds * 1000 << " ms, step " << timer.getSeconds() * 1000 / numFrames << " ms/frame, "
+			<< timeline->getNumItems() << " items left" << endl;
+	};
+
+	run( "all active", 0, 1000 );
+	run( "mostly pending", 1000, 1 );
+	run( "staggered", 3, 1 );
+}
@@ -0,0 +1,196 @@
+#include "cinder/app/App.h"
+#include "cinder/TriMesh.h"
+#include "cinder/GeomIo.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+namespace {
+
+// returns each triangle's vertex positions, rotated so that the smallest comes first, in sorted order
+vector<array<vec3, 3>> sortedTriangles( const TriMesh &mesh )
+{
+	auto less = []( const vec3 &a, const vec3 &b ) { return a.x != b.x ? a.x < b.x : ( a.y != b.y ? a.y < b.y : a.z < b.z ); };
+	vector<array<vec3, 3>> result;
+	for( size_t t = 0; t < mesh.getNumTriangles(); ++t ) {
+		array<vec3, 3> tri;
+		mesh.getTriangleVertices( t, &tri[0], &tri[1], &tri[2] );
+		while( less( tri[1], tri[0] ) || less( tri[2], tri[0] ) )
+			rotate( tri.begin(), tri.begin() + 1, tri.end() );
+		result.push_back( tri );
+	}
+	sort( result.begin(), result.end(), [&less]( const array<vec3, 3> &a, const array<vec3, 3> &b ) {
+		return lexicographical_compare( a.begin(), a.end(), b.begin(), b.end(), less );
+	} );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("TriMesh")
+{
+	SECTION("extract")
+	{
+		TriMesh mesh = TriMesh( geom::Cube() );
+		vector<uint32_t> indices( mesh.getIndices().begin() + 6, mesh.getIndices().begin() + 12 );
+		TriMesh face = mesh.extract( indices );
+
+		REQUIRE( face.getNumTriangles() == 2 );
+		REQUIRE( face.getNumVertices() == 4 );
+		REQUIRE( face.hasNormals() );
+		for( size_t i = 0; i < indices.size(); ++i )
+			CHECK( face.getPositions<3>()[face.getIndices()[i]] == mesh.getPositions<3>()[indices[i]] );
+	}
+
+	SECTION("simplified")
+	{
+		TriMesh mesh( geom::Icosphere().subdivisions( 4 ) );
+		float error = -1;
+		TriMesh simple = mesh.simplified( 0.25f, TriMesh::SimplifyOptions(), &error );
+
+		CHECK( simple.getNumTriangles() <= mesh.getNumTriangles() / 4 );
+		CHECK( simple.getNumTriangles() > mesh.getNumTriangles() / 8 );
+		CHECK( error > 0 );
+		CHECK( error < 0.05f );
+		// every remaining vertex still lies on the unit sphere
+		for( size_t i = 0; i < simple.getNumVertices(); ++i )
+			CHECK( length( simple.getPositions<3>()[i] ) == Approx( 1.0f ).epsilon( 0.01f ) );
+	}
+
+	SECTION("simplified maxError")
+	{
+		TriMesh mesh( geom::Icosphere().subdivisions( 4 ) );
+		float error = -1;
+		TriMesh simple = mesh.simplified( 0.0f, TriMesh::SimplifyOptions().maxError( 0.01f ), &error );
+
+		CHECK( simple.getNumTriangles() < mesh.getNumTriangles() );
+		CHECK( simple.getNumTriangles() > 0 );
+		CHECK( error <= 0.01f );
+	}
+
+	SECTION("simplified lockBorder")
+	{
+		TriMesh mesh( geom::Plane().subdivisions( ivec2( 20 ) ), TriMesh::Format().positions() );
+		TriMesh simple = mesh.simplified( 0.1f, TriMesh::SimplifyOptions().lockBorder() );
+
+		// the 80 border vertices remain
+		AxisAlignedBox bounds = mesh.calcBoundingBox();
+		size_t numBorder = 0;
+		for( size_t i = 0; i < simple.getNumVertices(); ++i ) {
+			vec3 p = simple.getPositions<3>()[i];
+			if( p.x == bounds.getMin().x || p.x == bounds.getMax().x || p.z == bounds.getMin().z || p.z == bounds.getMax().z )
+				++numBorder;
+		}
+		CHECK( numBorder == 80 );
+	}
+
+	SECTION("calcLods")
+	{
+		TriMesh mesh( geom::Icosphere().subdivisions( 4 ) );
+		auto lods = mesh.calcLods( { 0.125f, 0.5f, 0.25f }, TriMesh::SimplifyOptions().clusterSize( 256 ) );
+
+		REQUIRE( lods.size() == 3 );
+		CHECK( lods[1].mMesh->getNumTriangles() > lods[2].mMesh->getNumTriangles() );
+		CHECK( lods[2].mMesh->getNumTriangles() > lods[0].mMesh->getNumTriangles() );
+		CHECK( lods[1].mError <= lods[2].mError );
+		CHECK( lods[2].mError <= lods[0].mError );
+		CHECK( lods[0].mMesh->getNumTriangles() <= mesh.getNumTriangles() / 8 );
+
+		// clusters run in parallel, but the result must not depend on their timing
+		for( int i = 0; i < 4; ++i ) {
+			auto repeated = mesh.calcLods( { 0.125f, 0.5f, 0.25f }, TriMesh::SimplifyOptions().clusterSize( 256 ) );
+			for( size_t l = 0; l < lods.size(); ++l )
+				REQUIRE( repeated[l].mMesh->getIndices() == lods[l].mMesh->getIndices() );
+		}
+	}
+
+	SECTION("calcVertexCacheStats")
+	{
+		TriMesh mesh = TriMesh( geom::Cube() );
+		auto stats = mesh.calcVertexCacheStats( 16 );
+		// every vertex of the cube fits in the cache, so each is transformed exactly once
+		CHECK( stats.mNumTransformed == mesh.getNumVertices() );
+		CHECK( stats.mAtvr == Approx( 1.0f ) );
+		CHECK( stats.mAcmr == Approx( 24.0f / 12.0f ) );
+	}
+
+	SECTION("optimizeVertexCache")
+	{
+		TriMesh mesh( geom::Teapot().subdivisions( 8 ) );
+		auto &indices = mesh.getIndices();
+		Rand rand( 1 );
+		for( size_t t = indices.size() / 3 - 1; t > 0; --t )
+			swap_ranges( indices.begin() + t * 3, indices.begin() + t * 3 + 3, indices.begin() + rand.nextUint( uint32_t( t + 1 ) ) * 3 );
+		const auto triangles = sortedTriangles( mesh );
+		const float acmr = mesh.calcVertexCacheStats().mAcmr;
+
+		TriMesh cacheOptimized = mesh;
+		cacheOptimized.optimizeVertexCache();
+		CHECK( cacheOptimized.calcVertexCacheStats().mAcmr < acmr * 0.5f );
+		CHECK( sortedTriangles( cacheOptimized ) == triangles );
+
+		TriMesh overdrawOptimized = mesh;
+		overdrawOptimized.optimizeOverdraw();
+		CHECK( overdrawOptimized.calcVertexCacheStats().mAcmr < acmr * 0.5f );
+		CHECK( sortedTriangles( overdrawOptimized ) == triangles );
+	}
+
+	SECTION("optimizeVertexFetch")
+	{
+		TriMesh mesh( geom::Sphere().subdivisions( 12 ) );
+		auto &indices = mesh.getIndices();
+		reverse( indices.begin(), indices.end() );
+		const auto triangles = sortedTriangles( mesh );
+
+		mesh.optimizeVertexFetch();
+		CHECK( sortedTriangles( mesh ) == triangles );
+		uint32_t maxIndex = 0;
+		for( uint32_t index : mesh.getIndices() ) {
+			CHECK( index <= maxIndex + 1 );
+			maxIndex = std::max( maxIndex, index );
+		}
+	}
+
+	SECTION("recalculateNormals")
+	{
+		TriMesh sphere( geom::Sphere().subdivisions( 32 ) );
+		const vector<vec3> reference = sphere.getNormals();
+		sphere.recalculateNormals( true, true );
+		// pole vertices lie on degenerate triangles only
+		for( size_t i = 33; i < reference.size() - 33; ++i )
+			CHECK( dot( sphere.getNormals()[i], reference[i] ) > 0.999f );
+
+		// a cube sharing its 8 corner vertices between faces
+		TriMesh cube( TriMesh::Format().positions( 3 ) );
+		for( int i = 0; i < 8; ++i )
+			cube.appendPosition( vec3( i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 ) );
+		const uint32_t quads[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+		for( const auto &q : quads ) {
+			cube.appendTriangle( q[0], q[1], q[2] );
+			cube.appendTriangle( q[0], q[2], q[3] );
+		}
+
+		TriMesh smooth = cube;
+		smooth.recalculateNormals( TriMesh::NormalWeighting::ANGLE, float( M_PI ) );
+		REQUIRE( smooth.getNumVertices() == 8 );
+		for( size_t i = 0; i < 8; ++i )
+			CHECK( dot( smooth.getNormals()[i], normalize( smooth.getPositions<3>()[i] ) ) == Approx( 1.0f ) );
+
+		TriMesh creased = cube;
+		creased.recalculateNormals( TriMesh::NormalWeighting::ANGLE, toRadians( 30.0f ) );
+		REQUIRE( creased.getNumVertices() == 24 );
+		for( size_t t = 0; t < creased.getNumTriangles(); ++t ) {
+			vec3 a, b, c, na, nb, nc;
+			creased.getTriangleVertices( t, &a, &b, &c );
+			creased.getTriangleNormals( t, &na, &nb, &nc );
+			vec3 faceNormal = normalize( cross( b - a, c - a ) );
+			CHECK( dot( na, faceNormal ) == Approx( 1.0f ) );
+			CHECK( dot( nb, faceNormal ) == Approx( 1.0f ) );
+			CHECK( dot( nc, faceNormal ) == Approx( 1.0f ) );
+		}
+	}
+}
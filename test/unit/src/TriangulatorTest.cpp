@@ -0,0 +1,186 @@
+#include "cinder/Triangulate.h"
+#include "cinder/Path2d.h"
+#include "cinder/Shape2d.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include "catch.hpp"
+
+#include <iostream>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+float calcTriangulatedArea( const TriMesh &mesh )
+{
+	const vec2 *positions = mesh.getPositions<2>();
+	const auto &indices = mesh.getIndices();
+	float result = 0;
+	for( size_t i = 0; i + 2 < indices.size(); i += 3 ) {
+		vec2 a = positions[indices[i]], b = positions[indices[i + 1]], c = positions[indices[i + 2]];
+		result += math<float>::abs( ( b.x - a.x ) * ( c.y - a.y ) - ( c.x - a.x ) * ( b.y - a.y ) ) * 0.5f;
+	}
+	return result;
+}
+
+PolyLine2f makeRect( const Rectf &r, bool clockwise = false )
+{
+	PolyLine2f result( { r.getUpperLeft(), r.getUpperRight(), r.getLowerRight(), r.getLowerLeft() } );
+	if( clockwise )
+		result.reverse();
+	return result;
+}
+
+// A glyph-like shape: a curved outline with a counter, similar to an 'O' or 'D'
+Shape2d makeGlyph( vec2 offset, float size )
+{
+	Shape2d result;
+	result.moveTo( offset + vec2( 0, 0 ) );
+	result.lineTo( offset + vec2( size * 0.5f, 0 ) );
+	result.curveTo( offset + vec2( size * 1.1f, 0 ), offset + vec2( size * 1.1f, size ), offset + vec2( size * 0.5f, size ) );
+	result.lineTo( offset + vec2( 0, size ) );
+	result.close();
+	result.moveTo( offset + vec2( size * 0.2f, size * 0.2f ) );
+	result.lineTo( offset + vec2( size * 0.2f, size * 0.8f ) );
+	result.lineTo( offset + vec2( size * 0.5f, size * 0.8f ) );
+	result.curveTo( offset + vec2( size * 0.85f, size * 0.8f ), offset + vec2( size * 0.85f, size * 0.2f ), offset + vec2( size * 0.5f, size * 0.2f ) );
+	result.close();
+	return result;
+}
+
+// An SVG-like shape: a single contour with many vertices and concavities
+PolyLine2f makeStar( vec2 center, float radius, int numPoints )
+{
+	PolyLine2f result;
+	for( int i = 0; i < numPoints * 2; ++i ) {
+		float r = ( i & 1 ) ? radius * 0.45f : radius;
+		float theta = i * (float)M_PI / numPoints;
+		result.push_back( center + vec2( cos( theta ), sin( theta ) ) * r );
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Triangulator")
+{
+	for( auto backend : { Triangulator::BACKEND_LIBTESS, Triangulator::BACKEND_EARCUT } ) {
+		DYNAMIC_SECTION( "square with hole, backend " << backend )
+		{
+			Triangulator tri;
+			tri.addPolyLine( makeRect( Rectf( 0, 0, 10, 10 ) ) );
+			tri.addPolyLine( makeRect( Rectf( 2, 2, 4, 4 ), true ) );
+			TriMesh mesh = tri.calcMesh( Triangulator::WINDING_ODD, backend );
+			REQUIRE( calcTriangulatedArea( mesh ) == Approx( 96 ) );
+		}
+
+		DYNAMIC_SECTION( "nested islands, backend " << backend )
+		{
+			// outer square, hole, island inside the hole, plus a disjoint square
+			Triangulator tri;
+			tri.addPolyLine( makeRect( Rectf( 0, 0, 10, 10 ) ) );
+			tri.addPolyLine( makeRect( Rectf( 1, 1, 9, 9 ) ) );
+			tri.addPolyLine( makeRect( Rectf( 3, 3, 5, 5 ) ) );
+			tri.addPolyLine( makeRect( Rectf( 20, 0, 21, 1 ) ) );
+			TriMesh mesh = tri.calcMesh( Triangulator::WINDING_ODD, backend );
+			REQUIRE( calcTriangulatedArea( mesh ) == Approx( 100 - 64 + 4 + 1 ) );
+		}
+
+		DYNAMIC_SECTION( "nonzero winding of nested contours, backend " << backend )
+		{
+			// an inner contour with the same orientation as the outer one has winding number 2, and is only a hole under WINDING_ODD
+			for( bool clockwise : { false, true } ) {
+				for( auto winding : { Triangulator::WINDING_ODD, Triangulator::WINDING_NONZERO } ) {
+					Triangulator tri, reference;
+					for( Triangulator *t : { &tri, &reference } ) {
+						t->addPolyLine( makeRect( Rectf( 0, 0, 10, 10 ) ) );
+						t->addPolyLine( makeRect( Rectf( 2, 2, 8, 8 ), clockwise ) );
+						t->addPolyLine( makeRect( Rectf( 4, 4, 6, 6 ), ! clockwise ) );
+					}
+					const float area = calcTriangulatedArea( tri.calcMesh( winding, backend ) );
+					REQUIRE( area == Approx( calcTriangulatedArea( reference.calcMesh( winding, Triangulator::BACKEND_LIBTESS ) ) ) );
+					REQUIRE( area == Approx( ( winding == Triangulator::WINDING_NONZERO && ! clockwise ) ? 100 : 100 - 36 + 4 ) );
+				}
+			}
+		}
+
+		DYNAMIC_SECTION( "curved glyph, backend " << backend )
+		{
+			Shape2d glyph = makeGlyph( vec2( 0 ), 100 );
+			Triangulator tri( glyph, 4.0f );
+			TriMesh mesh = tri.calcMesh( Triangulator::WINDING_NONZERO, backend );
+			REQUIRE( mesh.getNumTriangles() > 0 );
+			Triangulator reference( glyph, 4.0f );
+			REQUIRE( calcTriangulatedArea( mesh ) == Approx( calcTriangulatedArea( reference.calcMesh() ) ).epsilon( 0.001 ) );
+		}
+
+		DYNAMIC_SECTION( "clear and reuse, backend " << backend )
+		{
+			Triangulator tri;
+			tri.addPolyLine( makeStar( vec2( 0 ), 10, 7 ) );
+			TriMesh first = tri.calcMesh( Triangulator::WINDING_ODD, backend );
+			tri.clear();
+			tri.addPolyLine( makeRect( Rectf( 0, 0, 2, 3 ) ) );
+			TriMesh second = tri.calcMesh( Triangulator::WINDING_ODD, backend );
+			REQUIRE( first.getNumTriangles() == 12 );
+			REQUIRE( second.getNumTriangles() == 2 );
+			REQUIRE( second.getNumVertices() == 4 );
+			REQUIRE( calcTriangulatedArea( second ) == Approx( 6 ) );
+		}
+
+		DYNAMIC_SECTION( "contours are consumed, backend " << backend )
+		{
+			Triangulator tri;
+			tri.addPolyLine( makeRect( Rectf( 0, 0, 10, 10 ) ) );
+			REQUIRE( calcTriangulatedArea( tri.calcMesh( Triangulator::WINDING_ODD, backend ) ) == Approx( 100 ) );
+			tri.addPolyLine( makeRect( Rectf( 20, 0, 22, 3 ) ) );
+			TriMesh second = tri.calcMesh( Triangulator::WINDING_ODD, backend );
+			REQUIRE( second.getNumVertices() == 4 );
+			REQUIRE( calcTriangulatedArea( second ) == Approx( 6 ) );
+			REQUIRE( tri.calcMesh( Triangulator::WINDING_ODD, backend ).getNumTriangles() == 0 );
+		}
+	}
+
+	SECTION("degenerate input")
+	{
+		Triangulator tri;
+		tri.addPolyLine( PolyLine2f( { vec2( 0 ), vec2( 1, 0 ) } ) );
+		REQUIRE( tri.calcMesh( Triangulator::WINDING_ODD, Triangulator::BACKEND_EARCUT ).getNumTriangles() == 0 );
+	}
+}
+
+TEST_CASE("Triangulator benchmark", "[.][benchmark]")
+{
+	Rand rand( 1234 );
+	vector<Shape2d> glyphs;
+	for( int i = 0; i < 500; ++i )
+		glyphs.push_back( makeGlyph( vec2( rand.nextFloat( 1000 ), rand.nextFloat( 1000 ) ), rand.nextFloat( 10, 40 ) ) );
+	vector<PolyLine2f> stars;
+	for( int i = 0; i < 200; ++i )
+		stars.push_back( makeStar( vec2( rand.nextFloat( 1000 ), rand.nextFloat( 1000 ) ), rand.nextFloat( 5, 50 ), rand.nextInt( 5, 200 ) ) );
+
+	for( auto backend : { Triangulator::BACKEND_LIBTESS, Triangulator::BACKEND_EARCUT } ) {
+		const char *name = ( backend == Triangulator::BACKEND_LIBTESS ) ? "libtess2" : "earcut";
+		Triangulator tri;
+		size_t numTriangles = 0;
+
+		Timer timer( true );
+		for( const auto &glyph : glyphs ) {
+			tri.clear();
+			tri.addShape( glyph );
+			numTriangles += tri.calcMesh( Triangulator::WINDING_NONZERO, backend ).getNumTriangles();
+		}
+		cout << name << " glyphs: " << timer.getSeconds() * 1000 << " ms (" << numTriangles << " triangles)" << endl;
+
+		numTriangles = 0;
+		timer.start();
+		for( const auto &star : stars ) {
+			tri.clear();
+			tri.addPolyLine( star );
+			numTriangles += tri.calcMesh( Triangulator::WINDING_ODD, backend ).getNumTriangles();
+		}
+		cout << name << " polygons: " << timer.getSeconds() * 1000 << " ms (" << numTriangles << " triangles)" << endl;
+	}
+}
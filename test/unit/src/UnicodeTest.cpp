@@ -4,8 +4,12 @@
 #include "cinder/Utilities.h"
 #include "cinder/app/Platform.h"
 #include "cinder/app/App.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
 #include "catch.hpp"
+#include "utf8cpp/checked.h"
 
+#include <iostream>
 #include <string>
 
 using namespace ci;
@@ -24,6 +28,25 @@ TYPE loadStringFromFile( const DataSourceRef &dataSource )
 	return TYPE( static_cast<const T*>( padded.getData() ) );
 }
 
+namespace {
+
+// Random text drawn from ASCII, accented Latin, Cyrillic, CJK or emoji, weighted towards ASCII; 'script' restricts it to one of the first four
+u32string makeText( Rand *rand, size_t numChars, int script = -1 )
+{
+	const char32_t ranges[][2] = { { 0x20, 0x7E }, { 0xC0, 0x17F }, { 0x410, 0x44F }, { 0x4E00, 0x9FFF }, { 0x1F600, 0x1F64F } };
+	u32string result;
+	for( size_t i = 0; i < numChars; ++i ) {
+		int r = script;
+		if( r < 0 ) {
+			r = rand->nextInt( 8 );
+			r = ( r < 4 ) ? 0 : r - 4;
+		}
+		result.push_back( ranges[r][0] + rand->nextUint( ranges[r][1] - ranges[r][0] + 1 ) );
+	}
+	return result;
+}
+
+} // anonymous namespace
 
 TEST_CASE("Unicode")
 {
@@ -46,4 +69,93 @@ TEST_CASE("Unicode")
 		REQUIRE( u32 == toUtf32( u16 ) );
 	}
 
+	SECTION("Transcoding matches utf8cpp for mixed scripts")
+	{
+		Rand rand( 1234 );
+		for( int i = 0; i < 200; ++i ) {
+			u32string u32 = makeText( &rand, rand.nextInt( 1, 300 ) );
+			string u8;
+			utf8::utf32to8( u32.begin(), u32.end(), back_inserter( u8 ) );
+			u16string u16;
+			utf8::utf8to16( u8.begin(), u8.end(), back_inserter( u16 ) );
+
+			REQUIRE( toUtf32( u8 ) == u32 );
+			REQUIRE( toUtf16( u8 ) == u16 );
+			REQUIRE( toUtf8( u16 ) == u8 );
+			REQUIRE( toUtf8( u32 ) == u8 );
+			REQUIRE( isValidUtf8( u8 ) );
+			REQUIRE( stringLengthUtf8( u8.c_str(), u8.size() ) == u32.size() );
+			size_t half = u32.size() / 2;
+			REQUIRE( advanceCharUtf8( u8.c_str(), half, u8.size() ) == toUtf8( u32.substr( 0, half ) ).size() );
+		}
+	}
+
+	SECTION("Malformed text is rejected like utf8cpp")
+	{
+		Rand rand( 5678 );
+		const char *fragments[] = { "abc", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE2\x82", "\xFF", "0123456789abcdef" };
+		for( int i = 0; i < 500; ++i ) {
+			string u8;
+			for( int f = rand.nextInt( 1, 8 ); f > 0; --f )
+				u8 += fragments[rand.nextInt( sizeof( fragments ) / sizeof( fragments[0] ) )];
+
+			bool valid = utf8::is_valid( u8.begin(), u8.end() );
+			REQUIRE( isValidUtf8( u8 ) == valid );
+			if( valid ) {
+				u16string u16;
+				utf8::utf8to16( u8.begin(), u8.end(), back_inserter( u16 ) );
+				REQUIRE( toUtf16( u8 ) == u16 );
+			}
+			else {
+				REQUIRE_THROWS_AS( toUtf16( u8 ), utf8::exception );
+				REQUIRE_THROWS_AS( toUtf32( u8 ), utf8::exception );
+			}
+
+			// stringLengthUtf8() counts the characters nextCharUtf8() steps over, malformed or not
+			size_t length = 0, byte = 0;
+			while( nextCharUtf8( u8.c_str(), &byte, u8.size() ) != 0xFFFF )
+				++length;
+			REQUIRE( stringLengthUtf8( u8.c_str(), u8.size() ) == length );
+		}
+
+		REQUIRE_THROWS_AS( toUtf8( u16string( 1, (char16_t)0xD800 ) + u"abcdefghij" ), utf8::exception );
+		REQUIRE_THROWS_AS( toUtf8( u32string( 9, U'a' ) + (char32_t)0x110000 ), utf8::exception );
+	}
+}
+
+TEST_CASE("Unicode benchmark", "[.][benchmark]")
+{
+	Rand rand( 1234 );
+	const size_t numChars = 1 << 20;
+	const pair<const char*, u32string> corpora[] = {
+		{ "ascii", makeText( &rand, numChars, 0 ) },
+		{ "latin", makeText( &rand, numChars, 1 ) },
+		{ "cyrillic", makeText( &rand, numChars, 2 ) },
+		{ "cjk", makeText( &rand, numChars, 3 ) },
+		{ "mixed", makeText( &rand, numChars ) }
+	};
+
+	for( const auto &corpus : corpora ) {
+		string u8 = toUtf8( corpus.second );
+		u16string u16 = toUtf16( u8 );
+		double gigabytes = u8.size() / 1.0e9;
+		auto measure = [&]( const char *name, const std::function<size_t()> &fn ) {
+			size_t check = 0;
+			Timer timer( true );
+			for( int i = 0; i < 10; ++i )
+				check += fn();
+			cout << corpus.first << " " << name << ": " << gigabytes * 10 / timer.getSeconds() << " GB/s (" << check << ")" << endl;
+		};
+
+		measure( "utf8cpp utf8to16", [&] { u16string r; utf8::utf8to16( u8.begin(), u8.end(), back_inserter( r ) ); return r.size(); } );
+		measure( "toUtf16", [&] { return toUtf16( u8 ).size(); } );
+		measure( "utf8cpp utf8to32", [&] { u32string r; utf8::utf8to32( u8.begin(), u8.end(), back_inserter( r ) ); return r.size(); } );
+		measure( "toUtf32", [&] { return toUtf32( u8 ).size(); } );
+		measure( "utf8cpp utf16to8", [&] { string r; utf8::utf16to8( u16.begin(), u16.end(), back_inserter( r ) ); return r.size(); } );
+		measure( "toUtf8", [&] { return toUtf8( u16 ).size(); } );
+		measure( "utf8cpp is_valid", [&] { return (size_t)utf8::is_valid( u8.begin(), u8.end() ); } );
+		measure( "isValidUtf8", [&] { return (size_t)isValidUtf8( u8 ); } );
+		measure( "nextCharUtf8 loop", [&] { size_t n = 0, byte = 0; while( nextCharUtf8( u8.c_str(), &byte, u8.size() ) != 0xFFFF ) ++n; return n; } );
+		measure( "stringLengthUtf8", [&] { return stringLengthUtf8( u8.c_str(), u8.size() ); } );
+	}
 }
@@ -0,0 +1,219 @@
+#include "cinder/XmlDoc.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+const char *sXml = R"xml(<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE config>
+<config version="2">
+	<!-- a comment -->
+	<window width="640" height="480" title="&lt;main&gt;">Main window</window>
+	<Window width="320"/>
+	<plugins>
+		<plugin name="first"><path>one/two</path></plugin>
+		<plugin name="second"><path>three</path></plugin>
+	</plugins>
+	<script>before<![CDATA[ <raw> ]]>after</script>
+</config>)xml";
+
+string makeRandomXml( Rand &rand, int depth, int *numElements )
+{
+	const char *tags[] = { "a", "B", "b", "item", "Item", "node" };
+	string result = "<" + string( tags[rand.nextInt( 6 )] ) + " id=\"" + to_string( ( *numElements )++ ) + "\"";
+	const int numAttrs = rand.nextInt( depth == 1 ? 40 : 4 );
+	for( int i = 0; i < numAttrs; ++i )
+		result += " attr" + to_string( i ) + "=\"" + to_string( rand.nextInt( 1000 ) ) + "\"";
+	result += ">";
+	if( rand.nextBool() )
+		result += "text" + to_string( rand.nextInt( 100 ) );
+	const int numChildren = ( depth > 3 ) ? 0 : rand.nextInt( depth == 1 ? 60 : 6 );
+	for( int i = 0; i < numChildren; ++i ) {
+		const int kind = rand.nextInt( 10 );
+		if( kind == 0 )
+			result += "<![CDATA[cdata" + to_string( i ) + "]]>";
+		else if( kind == 1 )
+			result += "<!--comment-->";
+		else
+			result += makeRandomXml( rand, depth + 1, numElements );
+	}
+	return result + "</" + result.substr( 1, result.find_first_of( " >" ) - 1 ) + ">";
+}
+
+void requireEqual( const XmlTree &expected, const XmlDoc::Node &node )
+{
+	REQUIRE( node.getNodeType() == expected.getNodeType() );
+	REQUIRE( node.getTag() == expected.getTag() );
+	REQUIRE( node.getValue() == expected.getValue() );
+
+	auto attrIt = expected.getAttributes().begin();
+	for( const XmlDoc::Attr &attr : node.getAttributes() ) {
+		REQUIRE( attrIt != expected.getAttributes().end() );
+		REQUIRE( attr.getName() == attrIt->getName() );
+		REQUIRE( attr.getValue() == attrIt->getValue() );
+		REQUIRE( node.getAttribute( attrIt->getName() ).getValue() == expected.getAttribute( attrIt->getName() ).getValue() );
+		++attrIt;
+	}
+	REQUIRE( attrIt == expected.getAttributes().end() );
+
+	XmlTree::ConstIter childIt = expected.begin();
+	for( const XmlDoc::Node &child : node ) {
+		REQUIRE( ( childIt != expected.end() ) );
+		requireEqual( *childIt, child );
+		// lookups by tag find the first child with a matching tag, either way
+		REQUIRE( node.getChild( child.getTag() ) == node.findChild( childIt->getTag() ) );
+		REQUIRE( node.getChild( child.getTag() ).getAttributeValue<string>( "id", "" ) == expected.getChild( childIt->getTag() ).getAttributeValue<string>( "id", "" ) );
+		REQUIRE( node.getChild( child.getTag(), true ).getAttributeValue<string>( "id", "" ) == expected.getChild( childIt->getTag(), true ).getAttributeValue<string>( "id", "" ) );
+		++childIt;
+	}
+	REQUIRE( ( childIt == expected.end() ) );
+}
+
+} // anonymous namespace
+
+TEST_CASE("XmlDoc")
+{
+	SECTION("nodes and attributes refer into the source")
+	{
+		XmlDoc doc( sXml );
+		XmlDoc::Node config = doc.getChild( "config" );
+		REQUIRE( config.isElement() );
+		REQUIRE( config.getAttributeValue<int>( "version" ) == 2 );
+		REQUIRE( config.getAttributeValue<int>( "missing", 7 ) == 7 );
+		REQUIRE( doc.getRoot().isDocument() );
+		REQUIRE( doc.getRoot().getDocType() == "config" );
+
+		XmlDoc::Node window = config / "window";
+		REQUIRE( window.getValue() == "Main window" );
+		REQUIRE( window["title"] == "<main>" );
+		REQUIRE( window.getAttribute( "width" ).getValue<int>() == 640 );
+		REQUIRE( window["missing"].empty() );
+		REQUIRE_FALSE( window.hasAttribute( "Width" ) );
+		REQUIRE( window.getParent() == config );
+		REQUIRE( window.getPath() == "/config/window" );
+
+		REQUIRE( config.getChild( "plugins/plugin/path" ).getValue() == "one/two" );
+		REQUIRE( config.getChild( "/plugins/plugin/path" ) == config.getChild( "plugins/plugin/path" ) );
+		REQUIRE( config.getChild( "WINDOW" ) == window );
+		REQUIRE( config.getChild( "Window", true )["width"] == "320" );
+		REQUIRE_FALSE( config.hasChild( "plugins/missing" ) );
+		REQUIRE_FALSE( config.findChild( "WINDOW", true ).isValid() );
+
+		vector<string> names;
+		for( XmlDoc::Iter pluginIt = config.getChild( "plugins" ).begin( "plugin" ); pluginIt != config.end(); ++pluginIt )
+			names.push_back( pluginIt->getAttributeValue<string>( "name" ) );
+		REQUIRE( names == vector<string>( { "first", "second" } ) );
+	}
+
+	SECTION("parse options match XmlTree")
+	{
+		const XmlTree::ParseOptions options[] = { XmlTree::ParseOptions(), XmlTree::ParseOptions().parseComments().collapseCData( false ).ignoreDataChildren( false ),
+			XmlTree::ParseOptions().ignoreDataChildren( false ), XmlTree::ParseOptions().collapseCData( false ) };
+		for( const auto &option : options ) {
+			requireEqual( XmlTree( string( sXml ), option ), XmlDoc( sXml, option ).getRoot() );
+			REQUIRE( XmlDoc( sXml, option ).getChild( "config/script" ).getValue() == XmlTree( string( sXml ), option ).getChild( "config/script" ).getValue() );
+		}
+		REQUIRE( XmlDoc( sXml ).getChild( "config/script" ).getValue() == "before <raw> " );
+	}
+
+	SECTION("random documents match XmlTree")
+	{
+		Rand rand( 1 );
+		for( int i = 0; i < 20; ++i ) {
+			int numElements = 0;
+			const string source = makeRandomXml( rand, 1, &numElements );
+			const auto options = XmlTree::ParseOptions().collapseCData( rand.nextBool() ).parseComments( rand.nextBool() ).ignoreDataChildren( rand.nextBool() );
+			requireEqual( XmlTree( source, options ), XmlDoc( source, options ).getRoot() );
+		}
+	}
+
+	SECTION("many children and attributes are indexed")
+	{
+		string source = "<root";
+		for( int i = 0; i < 100; ++i )
+			source += " a" + to_string( i ) + "=\"" + to_string( i ) + "\"";
+		source += ">";
+		for( int i = 0; i < 100; ++i )
+			source += "<child" + to_string( i % 50 ) + " index=\"" + to_string( i ) + "\"/><Child" + to_string( i % 50 ) + " index=\"upper\"/>";
+		source += "</root>";
+
+		XmlDoc doc( source );
+		XmlDoc::Node root = doc.getChild( "root" );
+		for( int i = 0; i < 100; ++i ) {
+			REQUIRE( root.getAttributeValue<int>( "a" + to_string( i ) ) == i );
+			REQUIRE( root.getChild( "child" + to_string( i % 50 ) ).getAttributeValue<int>( "index" ) == i % 50 );
+			REQUIRE( root.getChild( "Child" + to_string( i % 50 ), true )["index"] == "upper" );
+		}
+		REQUIRE_FALSE( root.hasAttribute( "a100" ) );
+		REQUIRE_FALSE( root.hasChild( "child50" ) );
+	}
+
+	SECTION("errors")
+	{
+		REQUIRE_THROWS_AS( XmlDoc( sXml ).getChild( "config/missing" ), XmlDoc::ExcChildNotFound );
+		REQUIRE_THROWS_AS( XmlDoc( sXml ).getChild( "config" ).getAttribute( "missing" ), XmlDoc::ExcAttrNotFound );
+		try {
+			XmlDoc( "<a><b></a>" );
+			FAIL( "no exception" );
+		}
+		catch( const XmlDoc::ExcParseError &exc ) {
+			REQUIRE( exc.getOffset() == 10 );
+		}
+	}
+}
+
+TEST_CASE("XmlDoc benchmark", "[.][benchmark]")
+{
+	Rand rand( 1 );
+	string source = "<svg width=\"1000\" height=\"1000\">\n";
+	for( int i = 0; i < 200000; ++i ) {
+		source += "\t<g id=\"group" + to_string( i ) + "\" transform=\"translate(" + to_string( rand.nextInt( 1000 ) ) + "," + to_string( rand.nextInt( 1000 ) ) + ")\">"
+			+ "<rect x=\"" + to_string( rand.nextFloat() ) + "\" y=\"1\" width=\"10\" height=\"20\" fill=\"#ff0000\"/><title>group " + to_string( i ) + "</title></g>\n";
+	}
+	source += "<defs count=\"1\"/></svg>";
+
+	auto time = [&]( const char *name, const function<double()> &fn ) {
+		auto start = chrono::steady_clock::now();
+		double sum = fn();
+		const double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+		cout << name << ": " << seconds * 1000 << " ms, " << source.size() / seconds / ( 1024 * 1024 ) << " MB/s (checksum " << sum << ")" << endl;
+	};
+
+	time( "XmlTree parse and read", [&] {
+		XmlTree tree( source );
+		double sum = 0;
+		for( XmlTree::ConstIter groupIt = tree.begin( "svg/g" ); groupIt != tree.end(); ++groupIt )
+			sum += groupIt->getChild( "rect" ).getAttributeValue<float>( "x" ) + groupIt->getChild( "title" ).getValue().size();
+		return sum;
+	} );
+	time( "XmlDoc parse and read", [&] {
+		XmlDoc doc( source );
+		double sum = 0;
+		const XmlDoc::Node svg = doc.getChild( "svg" );
+		for( XmlDoc::Iter groupIt = svg.begin( "g" ); groupIt != svg.end(); ++groupIt )
+			sum += groupIt->getChild( "rect" ).getAttributeValue<float>( "x" ) + groupIt->getChild( "title" ).getValue().size();
+		return sum;
+	} );
+	// the last child of a large element
+	const XmlTree tree( source );
+	const XmlDoc doc( source );
+	time( "XmlTree lookups", [&] {
+		double sum = 0;
+		for( int i = 0; i < 100; ++i )
+			sum += tree.getChild( "svg/defs" ).getAttributeValue<int>( "count" );
+		return sum;
+	} );
+	time( "XmlDoc lookups", [&] {
+		double sum = 0;
+		for( int i = 0; i < 100; ++i )
+			sum += doc.getChild( "svg/defs" ).getAttributeValue<int>( "count" );
+		return sum;
+	} );
+}
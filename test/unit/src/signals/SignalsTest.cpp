@@ -3,11 +3,16 @@
 #include "cinder/Cinder.h"
 #include "cinder/Utilities.h"
 #include "cinder/Signals.h"
+#include "cinder/Timer.h"
 #include "cinder/app/Event.h"
+#include "cinder/app/MouseEvent.h"
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 using namespace ci;
@@ -624,4 +629,312 @@ TEST_CASE( "signals/Signals" )
 		}
 	}
 
+	SECTION( "Slot storage" )
+	{
+		SECTION( "Slots connected during an emission are called by it when they follow the current slot." )
+		{
+			Signal<void ()> signal;
+			string calls;
+			vector<ScopedConnection> connections;
+			signal.connect( [&] {
+				calls += "a";
+				if( connections.empty() ) {
+					connections.push_back( signal.connect( [&] { calls += "b"; } ) );
+					connections.push_back( signal.connect( -1, [&] { calls += "c"; } ) );
+				}
+			} );
+			signal.connect( [&] { calls += "d"; } );
+
+			signal.emit();
+			REQUIRE( calls == "adbc" );
+			REQUIRE( signal.getNumSlots() == 4 );
+
+			calls.clear();
+			signal.emit();
+			REQUIRE( calls == "adbc" );
+		}
+
+		SECTION( "Slots connected during an emission before the current slot are first called by the next emission." )
+		{
+			Signal<void ()> signal;
+			int count = 0;
+			vector<ScopedConnection> connections;
+			signal.connect( [&] { connections.push_back( signal.connect( 1, [&] { ++count; } ) ); } );
+			REQUIRE( signal.getNumSlots() == 1 );
+
+			signal.emit();
+			REQUIRE( count == 0 );
+			REQUIRE( signal.getNumSlots() == 2 );
+
+			signal.emit();
+			REQUIRE( count == 1 );
+			REQUIRE( signal.getNumSlots() == 3 );
+
+			connections.clear();
+			REQUIRE( signal.getNumSlots() == 1 );
+		}
+
+		SECTION( "Slots connected and disconnected within the same emission are never called." )
+		{
+			Signal<void ()> signal;
+			int count = 0;
+			signal.connect( [&] {
+				auto connection = signal.connect( [&] { ++count; } );
+				REQUIRE( connection.disconnect() );
+			} );
+			signal.emit();
+			signal.emit();
+			REQUIRE( count == 0 );
+			REQUIRE( signal.getNumSlots() == 1 );
+		}
+
+		SECTION( "Recursive emissions call every connected slot." )
+		{
+			Signal<void ( int )> signal;
+			string calls;
+			signal.connect( [&]( int depth ) {
+				calls += "a" + to_string( depth );
+				if( depth == 0 )
+					signal.emit( 1 );
+			} );
+			Connection connection;
+			connection = signal.connect( [&]( int depth ) {
+				calls += "b" + to_string( depth );
+				if( depth == 1 )
+					connection.disconnect();
+			} );
+			signal.emit( 0 );
+			REQUIRE( calls == "a0a1b1" );
+			REQUIRE( signal.getNumSlots() == 1 );
+		}
+
+		SECTION( "Connections made by recursive emissions keep every emission's position." )
+		{
+			Signal<void ( int )> signal;
+			string calls;
+			vector<ScopedConnection> connections;
+			signal.connect( [&]( int depth ) {
+				calls += "a" + to_string( depth );
+				if( depth == 0 )
+					signal.emit( 1 );
+				else if( connections.empty() ) {
+					connections.push_back( signal.connect( 1, [&]( int d ) { calls += "h" + to_string( d ); } ) );
+					connections.push_back( signal.connect( [&]( int d ) { calls += "b" + to_string( d ); } ) );
+				}
+			} );
+			signal.emit( 0 );
+			REQUIRE( calls == "a0a1b1b0" );
+		}
+
+		SECTION( "Large and move-only callables are supported." )
+		{
+			Signal<int ()> signal;
+			array<int, 64> values;
+			values.fill( 1 );
+			unique_ptr<int> two( new int( 2 ) );
+			signal.connect( [values] { return values[63]; } );
+			signal.connect( -1, [two = std::move( two )] { return *two; } );
+			REQUIRE( signal.emit() == 2 );
+		}
+
+		SECTION( "Empty callbacks are not connected." )
+		{
+			Signal<void ()> signal;
+			auto connection = signal.connect( std::function<void ()>() );
+			REQUIRE_FALSE( connection.isConnected() );
+			REQUIRE( signal.getNumSlots() == 0 );
+			signal.emit();
+		}
+	}
+
 } // Signals
+
+TEST_CASE( "signals/ConcurrentSignal" )
+{
+	SECTION( "Priorities, collectors and connections behave as with Signal" )
+	{
+		ConcurrentSignal<int (), CollectorVector<int>> signal;
+		auto c1 = signal.connect( [] { return 1; } );
+		signal.connect( -1, [] { return 2; } );
+		signal.connect( 1, [] { return 3; } );
+		auto c4 = signal.connect( [] { return 4; } );
+		REQUIRE( signal.emit() == vector<int>( { 3, 1, 4, 2 } ) );
+		REQUIRE( signal.getNumSlots() == 4 );
+
+		c4.disable();
+		REQUIRE( signal.emit() == vector<int>( { 3, 1, 2 } ) );
+		c4.enable();
+		REQUIRE( c1.disconnect() );
+		REQUIRE_FALSE( c1.disconnect() );
+		REQUIRE( signal.emit() == vector<int>( { 3, 4, 2 } ) );
+		REQUIRE( signal.getNumSlots() == 3 );
+	}
+
+	SECTION( "Connections can be disconnected within a signal callback." )
+	{
+		ConcurrentSignal<void ()> signal;
+		int count = 0;
+		Connection connection;
+		connection = signal.connect( [&] { ++count; connection.disconnect(); } );
+		signal.connect( [&] { ++count; } );
+		signal.emit();
+		signal.emit();
+		REQUIRE( count == 3 );
+	}
+
+	SECTION( "Emission, connection and disconnection may run on several threads at once" )
+	{
+		ConcurrentSignal<void ( int )> signal;
+		atomic<int> sum( 0 );
+		signal.connect( [&]( int value ) { sum += value; } );
+
+		atomic<bool> done( false );
+		vector<thread> emitters;
+		for( int t = 0; t < 3; ++t ) {
+			emitters.emplace_back( [&] {
+				for( int i = 0; i < 20000; ++i )
+					signal.emit( 1 );
+			} );
+		}
+		thread connector( [&] {
+			while( ! done ) {
+				ScopedConnection connection = signal.connect( 1, []( int ) {} );
+				std::this_thread::yield();
+			}
+		} );
+
+		for( auto &emitter : emitters )
+			emitter.join();
+		done = true;
+		connector.join();
+
+		REQUIRE( sum == 60000 );
+		REQUIRE( signal.getNumSlots() == 1 );
+	}
+
+	SECTION( "Deferred emissions happen in signals::emitDeferred()" )
+	{
+		ConcurrentSignal<void ( const string & )> signal;
+		vector<string> received;
+		thread::id emittingThread;
+		signal.connect( [&]( const string &value ) {
+			received.push_back( value );
+			emittingThread = this_thread::get_id();
+		} );
+
+		thread producer( [&] {
+			signal.emitDeferred( "a" );
+			signal.emitDeferred( "b" );
+		} );
+		producer.join();
+		REQUIRE( received.empty() );
+
+		REQUIRE( signals::emitDeferred() == 2 );
+		REQUIRE( received == vector<string>( { "a", "b" } ) );
+		REQUIRE( emittingThread == this_thread::get_id() );
+		REQUIRE( signals::emitDeferred() == 0 );
+
+		{
+			ConcurrentSignal<void ()> destroyed;
+			destroyed.connect( [] { REQUIRE( false ); } );
+			destroyed.emitDeferred();
+		}
+		REQUIRE( signals::emitDeferred() == 0 );
+	}
+}
+
+TEST_CASE( "signals/Signal benchmark", "[.][benchmark]" )
+{
+	const int numEmits = 1000000;
+	int sum = 0;
+
+	for( int numSlots : { 1, 8, 64 } ) {
+		Signal<void ( int )> signal;
+		ScopedConnection disabled = signal.connect( -1, [&]( int value ) { sum -= value; } );
+		disabled.disable();
+		for( int i = 0; i < numSlots; ++i ) {
+			// a capture the size of a typical member function binding
+			signal.connect( i % 4, [&sum, i]( int value ) { sum += value + i; } );
+		}
+
+		Timer timer( true );
+		for( int i = 0; i < numEmits; ++i )
+			signal.emit( i );
+		cout << numSlots << " slots: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+	}
+
+	app::MouseEvent event;
+	Signal<void ( app::MouseEvent & ), app::CollectorEvent<app::MouseEvent>> eventSignal;
+	for( int i = 0; i < 8; ++i )
+		eventSignal.connect( [&sum]( app::MouseEvent &event ) { sum += event.getX(); } );
+	Timer timer( true );
+	for( int i = 0; i < numEmits; ++i ) {
+		app::CollectorEvent<app::MouseEvent> collector( &event );
+		eventSignal.emit( collector, event );
+	}
+	cout << "8 mouse event slots: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+
+	timer.start();
+	for( int i = 0; i < numEmits; ++i ) {
+		Signal<void ( int )> signal;
+		ScopedConnection connection = signal.connect( [&sum]( int value ) { sum += value; } );
+		signal.emit( i );
+	}
+	cout << "construct, connect, emit and disconnect: " << timer.getSeconds() * 1e9 / numEmits << " ns" << endl;
+	cout << "(checksum " << sum << ")" << endl;
+}
+
+TEST_CASE( "signals/ConcurrentSignal benchmark", "[.][benchmark]" )
+{
+	const int numSlots = 8, numEmits = 1000000;
+	// per thread, as the callbacks are emitted on several threads
+	auto callback = []( int value ) {
+		static thread_local volatile int sSink = 0;
+		sSink = sSink + value;
+	};
+
+	Signal<void ( int )> signal;
+	ConcurrentSignal<void ( int )> concurrentSignal;
+	for( int i = 0; i < numSlots; ++i ) {
+		signal.connect( callback );
+		concurrentSignal.connect( callback );
+	}
+
+	Timer timer( true );
+	for( int i = 0; i < numEmits; ++i )
+		signal.emit( i );
+	cout << "Signal: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+
+	timer.start();
+	for( int i = 0; i < numEmits; ++i )
+		concurrentSignal.emit( i );
+	cout << "ConcurrentSignal: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+
+	// emitting on four threads while another one connects and disconnects
+	atomic<bool> done( false );
+	thread connector( [&] {
+		while( ! done ) {
+			ScopedConnection connection = concurrentSignal.connect( callback );
+			std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+		}
+	} );
+	timer.start();
+	vector<thread> emitters;
+	for( int t = 0; t < 4; ++t ) {
+		emitters.emplace_back( [&] {
+			for( int i = 0; i < numEmits / 4; ++i )
+				concurrentSignal.emit( i );
+		} );
+	}
+	for( auto &emitter : emitters )
+		emitter.join();
+	cout << "ConcurrentSignal, 4 threads with concurrent connections: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+	done = true;
+	connector.join();
+
+	timer.start();
+	for( int i = 0; i < numEmits; ++i )
+		concurrentSignal.emitDeferred( i );
+	signals::emitDeferred();
+	cout << "ConcurrentSignal deferred: " << timer.getSeconds() * 1e9 / numEmits << " ns/emit" << endl;
+}
@@ -0,0 +1,188 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+ All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Decodes and filters log files written by ci::log::LoggerBinary, printing them in the format of LoggerFile.
+//
+// usage: LogDecoder [options] <file or folder>...
+// Folders, such as those written by a rotating LoggerBinary, are decoded file by file from oldest to newest.
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <time.h>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+struct Filter {
+	log::Level	mMinLevel = log::LEVEL_VERBOSE;
+	bool		mThreadSet = false;
+	uint64_t	mThreadId = 0;
+	string		mLocation, mText;
+
+	bool matches( const log::LoggerBinary::Record &record ) const
+	{
+		if( record.mLevel < mMinLevel )
+			return false;
+		if( mThreadSet && record.mThreadId != mThreadId )
+			return false;
+		if( ! mLocation.empty() && record.mLocation.getFunctionName().find( mLocation ) == string::npos && record.mLocation.getFileName().find( mLocation ) == string::npos )
+			return false;
+		if( ! mText.empty() && record.mText.find( mText ) == string::npos )
+			return false;
+
+		return true;
+	}
+};
+
+void printUsage()
+{
+	cerr << "usage: LogDecoder [options] <file or folder>..." << endl
+		<< "  --level <level>      only print records at or above level: verbose, debug, info, warning, error or fatal" << endl
+		<< "  --thread <id>        only print records logged by the thread with hexadecimal id" << endl
+		<< "  --location <text>    only print records whose function or file name contains text" << endl
+		<< "  --grep <text>        only print records whose message contains text" << endl;
+}
+
+bool parseLevel( const string &name, log::Level *result )
+{
+	const char *names[] = { "verbose", "debug", "info", "warning", "error", "fatal" };
+	for( int level = log::LEVEL_VERBOSE; level <= log::LEVEL_FATAL; ++level ) {
+		if( name == names[level] ) {
+			*result = static_cast<log::Level>( level );
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// output format is YYYY-MM-DD.HH:mm:ss.uuuuuu
+void printTimestamp( ostream &os, const chrono::system_clock::time_point &timestamp )
+{
+	time_t seconds = chrono::system_clock::to_time_t( timestamp );
+	struct tm *local = localtime( &seconds );
+	char result[100];
+	strftime( result, sizeof( result ), "%Y-%m-%d.%X", local );
+
+	auto micros = chrono::duration_cast<chrono::microseconds>( timestamp.time_since_epoch() ).count() % 1000000;
+	if( micros < 0 )
+		micros += 1000000;
+	os << result << "." << setfill( '0' ) << setw( 6 ) << micros << setfill( ' ' );
+}
+
+// returns false if 'path' could not be decoded
+bool decode( const fs::path &path, const Filter &filter )
+{
+	try {
+		log::LoggerBinary::Reader reader( path );
+		log::LoggerBinary::Record record;
+		while( reader.readNext( &record ) ) {
+			if( ! filter.matches( record ) )
+				continue;
+
+			cout << record.mLevel << " ";
+			printTimestamp( cout, record.mTimestamp );
+			cout << " [" << hex << record.mThreadId << dec << "] " << record.mLocation << " " << record.mText << "\n";
+		}
+		return true;
+	}
+	catch( const log::LogBinaryExc &exc ) {
+		cerr << "LogDecoder: " << exc.what() << endl;
+		return false;
+	}
+}
+
+} // anonymous namespace
+
+int main( int argc, char *argv[] )
+{
+	Filter filter;
+	vector<fs::path> paths;
+
+	for( int i = 1; i < argc; ++i ) {
+		const string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if( arg == "--level" && hasValue ) {
+			if( ! parseLevel( argv[++i], &filter.mMinLevel ) ) {
+				cerr << "LogDecoder: unknown level \"" << argv[i] << "\"" << endl;
+				return 2;
+			}
+		}
+		else if( arg == "--thread" && hasValue ) {
+			char *end;
+			filter.mThreadId = strtoull( argv[++i], &end, 16 );
+			filter.mThreadSet = true;
+			if( *end != '\0' ) {
+				cerr << "LogDecoder: invalid thread id \"" << argv[i] << "\"" << endl;
+				return 2;
+			}
+		}
+		else if( arg == "--location" && hasValue )
+			filter.mLocation = argv[++i];
+		else if( arg == "--grep" && hasValue )
+			filter.mText = argv[++i];
+		else if( arg == "--help" || arg == "-h" ) {
+			printUsage();
+			return 0;
+		}
+		else if( arg.compare( 0, 2, "--" ) == 0 ) {
+			cerr << "LogDecoder: unknown option \"" << arg << "\"" << endl;
+			printUsage();
+			return 2;
+		}
+		else
+			paths.push_back( arg );
+	}
+
+	if( paths.empty() ) {
+		printUsage();
+		return 2;
+	}
+
+	bool success = true;
+	for( const auto &path : paths ) {
+		if( fs::is_directory( path ) ) {
+			vector<fs::path> files;
+			for( const auto &entry : fs::directory_iterator( path ) ) {
+				if( fs::is_regular_file( entry.path() ) )
+					files.push_back( entry.path() );
+			}
+			sort( files.begin(), files.end(), []( const fs::path &a, const fs::path &b ) {
+				return fs::last_write_time( a ) < fs::last_write_time( b );
+			} );
+			for( const auto &file : files )
+				success = decode( file, filter ) && success;
+		}
+		else
+			success = decode( path, filter ) && success;
+	}
+
+	return success ? 0 : 1;
+}